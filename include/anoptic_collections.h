@@ -8,17 +8,350 @@
  * @brief Lock-free collections interface for the Anoptic Engine.
  */
 
+// Three queues over fixed-size POD elements, picked by topology:
+//   AnoSpscRing   bounded, one producer and one consumer, wait-free both ends
+//   AnoMpmcRing   bounded, any producers and consumers, one CAS per op (Vyukov, sequence per slot)
+//   AnoMsQueue    unbounded, any producers and consumers (Michael & Scott), nodes reclaimed through
+//                 hazard pointers
+//   AnoStripeQueue bounded, any producers and consumers, batched: one atomic per cache-line stripe of
+//                 elements, not per element
+// Bounded rings never allocate after init and report full/empty instead of waiting. The caller decides:
+// drop, spin, or back off. The unbounded queue allocates one node per push.
+//
+// Cursors sit on separate ANO_THREAD_LINE regions to avoid false sharing. A member carries
+// _Alignas(ANO_THREAD_LINE) so the whole struct inherits it. A HEAP owner must request that alignment
+// (e.g. mi_heap_malloc_aligned) for the separation to hold.
+
 // include guard
 #ifndef ANOPTIC_COLLECTIONS_H
 #define ANOPTIC_COLLECTIONS_H
 
-/*
-*
-*
-*
-*
-*
-*
-*/
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "anoptic_memory.h" // ANO_THREAD_LINE, mi_heap_t
+
+
+/* Bounded SPSC ring */
+
+// Single-producer/single-consumer bounded ring. Lock-free and wait-free both ends, capacity a power of
+// two so index wrap is a mask. The producer owns `tail`, the consumer owns `head`. Each reads the
+// other with acquire and publishes its own with release.
+typedef struct AnoSpscRing
+{
+    _Alignas(ANO_THREAD_LINE) _Atomic uint32_t tail; // producer-owned cursor: next index to write
+    _Alignas(ANO_THREAD_LINE) _Atomic uint32_t head; // consumer-owned cursor: next index to read
+    _Alignas(ANO_THREAD_LINE) uint32_t mask;         // capacity - 1 (immutable after init)
+    uint32_t                          stride;       // element size in bytes
+    uint8_t                          *buffer;       // capacity * stride bytes
+} AnoSpscRing;
+
+// in:  ring, heap, capacity_pow2 (rounded up to a power of two, >= 2), stride (> 0)
+// out: true on success; false on bad args or allocation failure
+bool ano_spsc_init(AnoSpscRing *ring, mi_heap_t *heap, uint32_t capacity_pow2, uint32_t stride);
+
+// Releases the ring buffer. Does not release the backing heap.
+void ano_spsc_destroy(AnoSpscRing *ring);
+
+// PRODUCER only. Copies `stride` bytes from `elem` into the ring.
+// out: false if the ring is full (caller decides: drop, spin, or grow upstream).
+static inline bool ano_spsc_push(AnoSpscRing *ring, const void *elem)
+{
+    uint32_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    uint32_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+    if ((tail - head) > ring->mask) // (tail - head) == capacity means full
+        return false;
+    uint8_t *slot = ring->buffer + (size_t)(tail & ring->mask) * ring->stride;
+    for (uint32_t i = 0; i < ring->stride; ++i)
+        slot[i] = ((const uint8_t *)elem)[i];
+    atomic_store_explicit(&ring->tail, tail + 1u, memory_order_release);
+    return true;
+}
+
+// CONSUMER only. Copies the next element into `out` (>= stride bytes).
+// out: false if the ring is empty.
+static inline bool ano_spsc_pop(AnoSpscRing *ring, void *out)
+{
+    uint32_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    uint32_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+    if (head == tail) // empty
+        return false;
+    const uint8_t *slot = ring->buffer + (size_t)(head & ring->mask) * ring->stride;
+    for (uint32_t i = 0; i < ring->stride; ++i)
+        ((uint8_t *)out)[i] = slot[i];
+    atomic_store_explicit(&ring->head, head + 1u, memory_order_release);
+    return true;
+}
+
+
+/* Bounded MPMC ring */
+
+// Dmitry Vyukov's bounded MPMC queue. Every cell carries a sequence word next to its element: a cell is
+// free for the producer at position p when seq == p, and full for the consumer when seq == p + 1. A
+// producer claims p with one CAS on `tail`, writes, then publishes seq = p + 1 with release. The
+// consumer's CAS on `head` and its seq = p + capacity hand the cell to the next lap. Producers and
+// consumers only contend among themselves, never with each other, and a stalled thread blocks only its
+// own cell. Lock-free, not wait-free: a CAS can lose and retry.
+typedef struct AnoMpmcRing
+{
+    _Alignas(ANO_THREAD_LINE) _Atomic uint64_t tail; // producers' claim cursor
+    _Alignas(ANO_THREAD_LINE) _Atomic uint64_t head; // consumers' claim cursor
+    _Alignas(ANO_THREAD_LINE) uint64_t mask;         // capacity - 1 (immutable after init)
+    uint32_t                          stride;       // element size in bytes
+    uint32_t                          cellStride;   // sequence word + element, 8-byte rounded
+    uint8_t                          *cells;        // capacity * cellStride bytes
+} AnoMpmcRing;
+
+// in:  ring, heap, capacity_pow2 (rounded up to a power of two, >= 2), stride (> 0)
+// out: true on success; false on bad args or allocation failure
+bool ano_mpmc_init(AnoMpmcRing *ring, mi_heap_t *heap, uint32_t capacity_pow2, uint32_t stride);
+
+// Releases the cells. No thread may be inside push or pop.
+void ano_mpmc_destroy(AnoMpmcRing *ring);
+
+// Sequence word of the cell for position `pos`, the element follows it.
+static inline _Atomic uint64_t *ano_mpmc_cell_(const AnoMpmcRing *ring, uint64_t pos)
+{
+    return (_Atomic uint64_t *)(ring->cells + (size_t)(pos & ring->mask) * ring->cellStride);
+}
+
+// Any thread. Copies `stride` bytes from `elem` into the ring.
+// out: false if the ring is full.
+static inline bool ano_mpmc_push(AnoMpmcRing *ring, const void *elem)
+{
+    uint64_t pos = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    _Atomic uint64_t *cell;
+    for (;;) {
+        cell = ano_mpmc_cell_(ring, pos);
+        uint64_t seq = atomic_load_explicit(cell, memory_order_acquire);
+        int64_t  dif = (int64_t)(seq - pos);
+        if (dif == 0) {
+            if (atomic_compare_exchange_weak_explicit(&ring->tail, &pos, pos + 1u,
+                                                      memory_order_relaxed, memory_order_relaxed))
+                break;      // pos is ours. A failed CAS reloaded pos.
+        } else if (dif < 0) {
+            return false;   // the cell still holds last lap's element: full
+        } else {
+            pos = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+        }
+    }
+    memcpy((uint8_t *)cell + sizeof(uint64_t), elem, ring->stride);
+    atomic_store_explicit(cell, pos + 1u, memory_order_release);
+    return true;
+}
+
+// Any thread. Copies the next element into `out` (>= stride bytes).
+// out: false if the ring is empty.
+static inline bool ano_mpmc_pop(AnoMpmcRing *ring, void *out)
+{
+    uint64_t pos = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    _Atomic uint64_t *cell;
+    for (;;) {
+        cell = ano_mpmc_cell_(ring, pos);
+        uint64_t seq = atomic_load_explicit(cell, memory_order_acquire);
+        int64_t  dif = (int64_t)(seq - (pos + 1u));
+        if (dif == 0) {
+            if (atomic_compare_exchange_weak_explicit(&ring->head, &pos, pos + 1u,
+                                                      memory_order_relaxed, memory_order_relaxed))
+                break;
+        } else if (dif < 0) {
+            return false;   // not yet written this lap: empty
+        } else {
+            pos = atomic_load_explicit(&ring->head, memory_order_relaxed);
+        }
+    }
+    memcpy(out, (const uint8_t *)cell + sizeof(uint64_t), ring->stride);
+    atomic_store_explicit(cell, pos + ring->mask + 1u, memory_order_release);
+    return true;
+}
+
+
+/* Unbounded MPMC queue (Michael & Scott) */
+
+// A linked list with a dummy head: producers CAS the last node's next, then swing `tail`. Consumers CAS
+// `head` forward and read the element out of the node that becomes the new dummy. Either side helps a
+// lagging `tail` along, so no thread waits on another. A popped dummy is retired, not freed: it is freed
+// once no thread's hazard pointer names it. Each thread that touches a queue holds one hazard record
+// (two pointers), claimed on first use and returned when the thread exits.
+//
+// Nodes come from mi_malloc, so push and pop are safe from any thread. Prefer a bounded ring on hot
+// paths: a push here is an allocation.
+typedef struct AnoMsqNode AnoMsqNode;
+
+typedef struct AnoMsQueue
+{
+    _Alignas(ANO_THREAD_LINE) AnoMsqNode *_Atomic head; // the dummy, consumers' end
+    _Alignas(ANO_THREAD_LINE) AnoMsqNode *_Atomic tail; // last or next-to-last node, producers' end
+    _Alignas(ANO_THREAD_LINE) uint32_t stride;          // element size in bytes
+} AnoMsQueue;
+
+// in:  queue, stride (> 0)
+// out: true on success; false on bad args or allocation failure
+bool ano_msq_init(AnoMsQueue *queue, uint32_t stride);
+
+// Frees every node still queued. No thread may be inside push or pop. Retired nodes go with the next
+// reclamation pass, or ano_msq_reclaim.
+void ano_msq_destroy(AnoMsQueue *queue);
+
+// Any thread. Copies `stride` bytes from `elem` into a new node.
+// out: false only if the node, or the calling thread's hazard record on its first call, could not be
+//      allocated.
+bool ano_msq_push(AnoMsQueue *queue, const void *elem);
+
+// Any thread. Copies the oldest element into `out` (>= stride bytes).
+// out: false if the queue is empty, or the calling thread's hazard record could not be set up.
+bool ano_msq_pop(AnoMsQueue *queue, void *out);
+
+// Frees the retired nodes no hazard pointer protects: the calling thread's, and those exited threads left
+// behind. For a quiet point (level unload, shutdown, a test's leak check), never needed for correctness.
+void ano_msq_reclaim(void);
+
+
+/* Cache-line-striped batch queue */
+
+// A bounded ring of stripes, each one or more whole cache lines: an 8-byte commit word, then as many
+// elements as fit. The stripe, not the element, is the unit of ownership transfer. A producer claims the
+// next stripe with one fetch_add on `tail`, fills it with plain stores, and publishes it with one release
+// store of the commit word. Consumers take whole committed stripes in ring order, one CAS on `head` each,
+// copy them out, and hand the stripe to the next lap. The atomics per element fall by the stripe's
+// element count (7 uint64_t in a 64-byte stripe, 15 in 128).
+//
+// Commit word for the stripe at position p: (p << 8) while free for p's producer, (p << 8) | 0x80 | count
+// once committed, ((p + stripes) << 8) after a consumer releases it. Hence <= 127 elements per stripe.
+//
+// Producers write through an AnoStripeWriter, one per producing thread (its own stack or TLS). Order is
+// per stripe: a consumer stops at the first uncommitted stripe, so a writer's open stripe holds back the
+// stripes claimed after it until it fills or is flushed. Writers flush at the end of each batch (a tick's
+// events). A stalled writer never blocks another producer, only consumers past its stripe. Elements from
+// one writer come out in push order. There is no order across writers.
+typedef struct AnoStripeQueue
+{
+    _Alignas(ANO_THREAD_LINE) _Atomic uint64_t tail; // producers' stripe claim cursor (fetch_add)
+    _Alignas(ANO_THREAD_LINE) _Atomic uint64_t head; // consumers' stripe cursor (CAS)
+    _Alignas(ANO_THREAD_LINE) uint64_t mask;         // stripes - 1 (immutable after init)
+    uint32_t                          stride;       // element size in bytes
+    uint32_t                          stripeBytes;  // commit word + elements, whole cache lines
+    uint32_t                          perStripe;    // elements per stripe, 1..127
+    uint8_t                          *stripes;      // (mask + 1) * stripeBytes, cache-line aligned
+} AnoStripeQueue;
+
+// A producer's claim on one stripe. Zero-initialize with ano_stripe_writer, one per producing thread.
+typedef struct AnoStripeWriter
+{
+    AnoStripeQueue *queue;
+    uint8_t        *stripe;     // claimed stripe, NULL when none held
+    uint64_t        pos;        // its position
+    uint32_t        count;      // elements written so far
+    bool            ready;      // the last lap's consumer has released it
+} AnoStripeWriter;
+
+#define ANO_STRIPE_COMMIT_ 0x80u
+#define ANO_STRIPE_COUNT_  0x7Fu
+
+// in:  queue, heap, stripes_pow2 (rounded up to a power of two, >= 2), stride (> 0),
+//      stripe_bytes (0 for ANO_CACHE_LINE, else rounded up to whole cache lines)
+// out: true on success; false on bad args, a stride that leaves no room or more than 127 elements per
+//      stripe, or allocation failure
+bool ano_stripe_init(AnoStripeQueue *queue, mi_heap_t *heap, uint32_t stripes_pow2, uint32_t stride,
+                     uint32_t stripe_bytes);
+
+// Releases the stripes. No thread may be inside a writer or pop, every writer flushed or abandoned.
+void ano_stripe_destroy(AnoStripeQueue *queue);
+
+static inline AnoStripeWriter ano_stripe_writer(AnoStripeQueue *queue)
+{
+    return (AnoStripeWriter){ .queue = queue };
+}
+
+// The commit word heads its stripe.
+static inline _Atomic uint64_t *ano_stripe_word_(uint8_t *stripe)
+{
+    return (_Atomic uint64_t *)stripe;
+}
+
+// Claims the next stripe if the writer holds none, and checks the claimed one is free for this lap.
+static inline bool ano_stripe_ready_(AnoStripeWriter *w)
+{
+    AnoStripeQueue *q = w->queue;
+    if (!w->stripe) {
+        w->pos    = atomic_fetch_add_explicit(&q->tail, 1u, memory_order_relaxed);
+        w->stripe = q->stripes + (size_t)(w->pos & q->mask) * q->stripeBytes;
+        w->count  = 0u;
+        w->ready  = false;
+    }
+    if (!w->ready) {
+        // The claim is kept either way: a full ring is retried on the same stripe.
+        if (atomic_load_explicit(ano_stripe_word_(w->stripe), memory_order_acquire) != w->pos << 8)
+            return false;
+        w->ready = true;
+    }
+    return true;
+}
+
+static inline void ano_stripe_commit_(AnoStripeWriter *w)
+{
+    atomic_store_explicit(ano_stripe_word_(w->stripe),
+                          (w->pos << 8) | ANO_STRIPE_COMMIT_ | w->count, memory_order_release);
+    w->stripe = NULL;
+}
+
+// WRITER's thread only. Copies `stride` bytes from `elem` into the writer's stripe, publishing the
+// stripe once full. Plain stores, no atomics, except on the first element of a stripe (the claim).
+// out: false if the ring is full: the claimed stripe still holds the last lap's elements.
+static inline bool ano_stripe_push(AnoStripeWriter *w, const void *elem)
+{
+    if (!ano_stripe_ready_(w))
+        return false;
+    AnoStripeQueue *q = w->queue;
+    memcpy(w->stripe + sizeof(uint64_t) + (size_t)w->count * q->stride, elem, q->stride);
+    if (++w->count == q->perStripe)
+        ano_stripe_commit_(w);
+    return true;
+}
+
+// WRITER's thread only. Publishes the partly filled stripe, if any. A claimed stripe with nothing in it
+// is published empty, consumers step over it.
+// out: false if the ring is full and the claimed stripe is not yet free: call again.
+static inline bool ano_stripe_flush(AnoStripeWriter *w)
+{
+    if (!w->stripe)
+        return true;
+    if (!ano_stripe_ready_(w))
+        return false;
+    ano_stripe_commit_(w);
+    return true;
+}
+
+// Any thread. Takes the oldest committed stripe and copies its elements into `out`, which must hold
+// perStripe elements.
+// out: number of elements copied, 0 if the stripe at the head is not yet committed (empty, or a writer
+//      still filling it).
+static inline uint32_t ano_stripe_pop(AnoStripeQueue *queue, void *out)
+{
+    uint64_t pos = atomic_load_explicit(&queue->head, memory_order_relaxed);
+    for (;;) {
+        uint8_t *stripe = queue->stripes + (size_t)(pos & queue->mask) * queue->stripeBytes;
+        _Atomic uint64_t *word = ano_stripe_word_(stripe);
+        uint64_t commit = atomic_load_explicit(word, memory_order_acquire);
+        int64_t  dif    = (int64_t)((commit >> 8) - pos);
+        if (dif == 0 && (commit & ANO_STRIPE_COMMIT_)) {
+            if (atomic_compare_exchange_weak_explicit(&queue->head, &pos, pos + 1u,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                uint32_t count = (uint32_t)(commit & ANO_STRIPE_COUNT_);
+                memcpy(out, stripe + sizeof(uint64_t), (size_t)count * queue->stride);
+                atomic_store_explicit(word, (pos + queue->mask + 1u) << 8, memory_order_release);
+                if (count)
+                    return count;
+                pos++;      // an empty flush: step over it
+            }
+        } else if (dif <= 0) {
+            return 0u;      // not committed this lap: empty, or a writer is still filling it
+        } else {
+            pos = atomic_load_explicit(&queue->head, memory_order_relaxed);
+        }
+    }
+}
 
-#endif // ANOPTIC_COLLECTIONS_H
\ No newline at end of file
+#endif // ANOPTIC_COLLECTIONS_H
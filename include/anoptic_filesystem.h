@@ -90,4 +90,80 @@ int ano_fs_sync(ano_file *file);
 // Input: open handle. Output: 0 on success, -1 on error -- the handle is freed regardless.
 int ano_fs_close(ano_file *file);
 
+// Replace `to` with `from` in one step (rename / MoveFileEx). Writers build a file beside its
+// final name and swap it in, so a reader never sees it half-written.
+// Input: NUL-terminated paths on the same volume. Output: 0 on success, -1 on error.
+int ano_fs_replace(const char *from, const char *to);
+
+
+// Read-only whole-file mapping: pages fault in from the page cache on first touch, and nothing
+// is copied. Keep the file unmodified while mapped (replace it with ano_fs_replace instead).
+
+// Map all of `path` read-only. Output: the page-aligned base and its byte count in *size,
+// or NULL on failure (missing or empty file, map error).
+const void *ano_fs_map_read(const char *path, size_t *size);
+
+// Release a mapping from ano_fs_map_read. Output: 0 on success, -1 on error.
+int ano_fs_unmap(const void *base, size_t size);
+
+
+// Derived-data cache: cooked blobs stored by content key, by default under "<userpath>/Cache".
+// A key hashes everything that determines a product -- the producing tool and its version, the
+// source bytes, the processing parameters -- so an entry never goes stale: changed inputs are a
+// different key, and the old entry ages out. Entries are immutable, written atomically,
+// checksummed, and mapped read-only on a hit. The directory is byte-capped and evicted least
+// recently used first, a hit counting as a use. Thread-safe. Every failure is a miss: the caller
+// falls back to doing the work. Off until ano_fs_cache_configure names a root.
+
+#define ANO_FS_CACHE_DEFAULT_LIMIT ((uint64_t)2 << 30)   // 2 GiB
+
+// A 128-bit content key. Build with ano_fs_cache_key_begin, then fold in every input.
+typedef struct {
+    uint64_t lo, hi;
+} ano_fs_cache_key;
+
+// Point the cache at `root` (NULL: "<userpath>/Cache"), creating it if absent, and cap it at
+// limitBytes (0: ANO_FS_CACHE_DEFAULT_LIMIT). Evicts down to the cap at once.
+// Output: 0, or -1 (cache off) if the directory cannot be resolved or created.
+int ano_fs_cache_configure(const char *root, uint64_t limitBytes);
+
+// Start a key for one product of `tool` at `version`. Bump version whenever the tool's output
+// for the same inputs changes: that is what retires old entries.
+ano_fs_cache_key ano_fs_cache_key_begin(const char *tool, uint32_t version);
+
+// Fold `size` bytes into the key. Lengths count: ("ab", "c") and ("a", "bc") differ.
+void ano_fs_cache_key_add(ano_fs_cache_key *key, const void *data, size_t size);
+
+// A hit: `data` is the stored payload, 64-byte aligned, read-only, valid until release.
+typedef struct {
+    const void *data;
+    size_t      size;
+    const void *map;       // the entry's mapping, for ano_fs_cache_release
+    size_t      mapSize;
+} ano_fs_cache_blob;
+
+// Look `key` up. A hit maps and verifies the entry (header, length, payload checksum) and marks
+// it used. Output: true with *blob filled, false (blob zeroed) on a miss or a damaged entry.
+bool ano_fs_cache_get(const ano_fs_cache_key *key, ano_fs_cache_blob *blob);
+
+// Unmap a hit and zero it. A zeroed blob is a no-op.
+void ano_fs_cache_release(ano_fs_cache_blob *blob);
+
+// Store `size` bytes under `key`, replacing any entry, then evict past the cap.
+// Output: 0, or -1 (nothing stored) if the cache is off, the write fails or size exceeds the cap.
+int ano_fs_cache_put(const ano_fs_cache_key *key, const void *data, size_t size);
+
+// Streaming form of ano_fs_cache_put for payloads produced in pieces. Opaque handle.
+typedef struct ano_fs_cache_writer ano_fs_cache_writer;
+
+// Output: a writer for `key`, or NULL if the cache is off or the entry cannot be created.
+ano_fs_cache_writer *ano_fs_cache_put_begin(const ano_fs_cache_key *key);
+
+// Append to the payload. Output: 0, or -1 on error (the writer stays open; end it uncommitted).
+int ano_fs_cache_put_write(ano_fs_cache_writer *writer, const void *data, size_t size);
+
+// Finish and free the writer. commit publishes the entry, false discards it.
+// Output: 0 once published (or discarded), -1 if publishing failed.
+int ano_fs_cache_put_end(ano_fs_cache_writer *writer, bool commit);
+
 #endif //ANOPTICENGINE_ANOPTIC_FILEPATH_H
@@ -0,0 +1,101 @@
+/* SPDX-FileCopyrightText: 2026 Anoptic Game Engine Authors
+ *
+ * SPDX-License-Identifier: LGPL-3.0 */
+/*  == Anoptic Game Engine v0.0000001 == */
+
+/**
+ * @file anoptic_jobs.h
+ * @brief Work-stealing job system for the Anoptic Engine.
+ */
+
+// A fixed pool of worker threads, one per core by default, each pinned to its core and spawned through
+// ano_thread_create (so each arms its crash stack). Every worker owns a Chase-Lev deque: it pushes and
+// pops its own end, LIFO, and idle workers steal the oldest job from the other end of a random victim.
+// Threads outside the pool (main, logic) submit through one shared MPMC injection ring.
+//
+// Dependencies are counters. A submit adds its job count to an AnoJobCounter, each finished job takes
+// one off, and ano_jobs_wait returns once it reads zero. A waiter never sleeps while there is work: it
+// runs queued jobs (its own first, then stolen ones) until its counter drains. A job may submit and wait
+// on children, so a dependency chain is a job that waits on its inputs' counter before it runs its own
+// body. There are no fibers. A job that waits keeps its stack until the children finish.
+//
+// Jobs must not block on anything but a counter: a mutex held across a wait or a blocking read stalls a
+// worker, and with it part of the pool.
+
+// include guard
+#ifndef ANOPTIC_JOBS_H
+#define ANOPTIC_JOBS_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+
+/* Types */
+
+typedef void (*ano_job_fn)(void *arg);
+
+// One job: fn(arg). Copied in at submit, so a batch can live on the caller's stack.
+typedef struct AnoJobDecl
+{
+    ano_job_fn fn;
+    void      *arg;
+} AnoJobDecl;
+
+// Jobs still pending against it. Zero-initialize, one per batch or dependency edge. Must outlive every
+// job submitted against it, so wait on it before it leaves scope.
+typedef struct AnoJobCounter
+{
+    _Atomic int64_t pending;
+} AnoJobCounter;
+
+// ano_parallel_for body: process indices [begin, end).
+typedef void (*ano_range_fn)(void *ctx, size_t begin, size_t end);
+
+
+/* Lifecycle Functions */
+
+// Start the pool. workers: 0 for one per core minus one (the submitting thread helps while it waits),
+// at least 1. pin: bind worker i to core (i + 1) % cores, best effort. Returns 0 on success, -1 on
+// failure or when already running.
+int ano_jobs_init(uint32_t workers, bool pin);
+
+// Stop and join the workers. Every counter must already have drained: jobs still queued are dropped.
+// Call from the thread that called init.
+// Returns 0, or -1 when not running.
+int ano_jobs_cleanup(void);
+
+// Scope-bound teardown, ANO_LOG_SCOPE_ATTR-style (anoptic_log.h).
+void ano_jobs_scope_release(const int *initStatus);
+#define ANO_JOBS_SCOPE_ATTR __attribute__((__cleanup__(ano_jobs_scope_release)))
+
+// Workers in the running pool, 0 when stopped.
+uint32_t ano_jobs_worker_count(void);
+
+// This thread's worker index, or -1 outside the pool.
+int ano_jobs_worker_index(void);
+
+
+/* Submission and Waiting */
+
+// Any thread. Queue `count` jobs, adding count to `counter` first (NULL: nobody waits, fire and
+// forget). With the pool stopped, or with no room left in a full deque or ring, a job runs inline.
+void ano_jobs_run(const AnoJobDecl *jobs, uint32_t count, AnoJobCounter *counter);
+
+// Any thread, jobs included. Returns once counter reads zero, running queued jobs meanwhile.
+void ano_jobs_wait(AnoJobCounter *counter);
+
+// True once every job submitted against counter has finished. Never blocks.
+static inline bool ano_jobs_done(AnoJobCounter *counter)
+{
+    return atomic_load_explicit(&counter->pending, memory_order_acquire) == 0;
+}
+
+// Any thread, jobs included. Runs body over [0, count) across the pool and returns when all of it is
+// done. Chunking adapts: a range splits its upper half off for thieves only while its thread's queue is
+// nearly empty, and otherwise runs `grain` indices at a time, so busy pools get few large chunks and
+// idle ones many. grain: the smallest chunk worth a job, 0 for count / (64 * threads).
+void ano_parallel_for(size_t count, size_t grain, ano_range_fn body, void *ctx);
+
+#endif // ANOPTIC_JOBS_H
@@ -17,6 +17,9 @@
 #define ANOPTIC_LOG_H
 
 #include <stdarg.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
 
 
 /* Types */
@@ -37,6 +40,56 @@ typedef enum {
     ANO_NOW  = 1 << 2,              // synchronous: drain, write, fsync on this thread
 } ano_logroute_t;
 
+// Producer topology, latched by ano_log_init.
+typedef enum {
+    ANO_LOG_SHARED = 0,             // one MPSC ring, a CAS on its tail per record (the default)
+    ANO_LOG_LANES,                  // one SPSC lane per producer thread, merged by timestamp at drain
+} ano_logmode_t;
+
+// What a buffered record does when its ring is full, per level.
+typedef enum {
+    ANO_LOG_BLOCK = 0,              // wait for the drainer to make room, never lost (the default)
+    ANO_LOG_DROP,                   // drop it and count it, a summary line follows at the next drain
+    ANO_LOG_SPILL,                  // overflow into the larger spill ring, wait only when that fills too
+} ano_logoverflow_t;
+
+// Session file encoding, latched by ano_log_init.
+typedef enum {
+    ANO_LOG_TEXT = 0,               // rendered lines in <stamp>_ano.log (the default)
+    ANO_LOG_BINARY,                 // raw capture blobs in <stamp>_ano.alog, tools/anolog_decode renders them
+} ano_logformat_t;
+
+
+// Per-call-site state for the gated macros below, one static instance per site. Zero-initialized.
+typedef struct {
+    _Atomic uint64_t count;         // calls seen (every_n), or nonzero once fired (once)
+    _Atomic uint64_t next;          // rate limit: theoretical arrival time, ano_timestamp_raw ns
+} ano_logsite_t;
+
+
+// Structured field value types (ano_log_kv).
+typedef enum {
+    ANO_KV_U64 = 1,
+    ANO_KV_F64,
+    ANO_KV_STR,                     // bytes copied into the record: an anostr_t through ANO_KV_S
+    ANO_KV_SID,                     // an anostr_sid, rendered as 16 hex digits
+} ano_kvtype_t;
+
+// One typed field. key MUST be a string literal: records store it by pointer, like printFormat.
+typedef struct {
+    const char  *key;
+    ano_kvtype_t type;
+    union {
+        uint64_t u64;
+        double   f64;
+        struct { const char *ptr; uint32_t len; } str;
+        uint64_t sid;
+    };
+} ano_logfield_t;
+
+// Fields per structured record. Extra fields are ignored.
+#define ANO_LOG_KV_MAX 32u
+
 
 /* Lifecycle Functions */
 
@@ -50,6 +103,7 @@ void ano_log_scope_release(const int *initStatus);
 
 /* Entry Points */
 
+// Return 0 buffered or written, 1 a full ring made the call wait, 2 dropped by ANO_LOG_DROP.
 int ano_log_write(ano_loglevel_t level, ano_logroute_t route,
                   const char* sourceFile, int lineNumber,   
                   /* printFormat MUST be a string literal. */
@@ -61,15 +115,45 @@ int ano_log_vwrite(ano_loglevel_t level, ano_logroute_t route,
                    const char* printFormat, va_list args) __attribute__((format(printf, 5, 0)));
 
 
+// Structured record: an event name (a string literal) and typed fields. Buffered like a deferred capture,
+// rendered at drain as "event key=value ...", and appended to the event's column file when
+// ano_log_set_columns is on. Return as ano_log_write.
+int ano_log_kv(ano_loglevel_t level, ano_logroute_t route, const char* event,
+               const ano_logfield_t *fields, uint32_t count);
+
+// Call-site gates for the sampled macros. True when the site should log this call. every: the 1st,
+// n+1th, 2n+1th... call. once: the first call only. rate: at most perSec a second, bursting to perSec.
+// An over-budget call only reads the site (rate) or bumps one counter (every), and touches no ring.
+bool ano_log_gate_every(ano_logsite_t *site, uint32_t n);
+bool ano_log_gate_once(ano_logsite_t *site);
+bool ano_log_gate_rate(ano_logsite_t *site, uint32_t perSec);
+
+
 /* Configuration Functions */
 
-// Open dir/<session-stamp>_ano.log as the output file (the stamp: ano_fs_session_stamp).
+// Pick the producer topology for the next ano_log_init. Lanes keep the per-record cost flat as the
+// logging thread count grows, at one lane of memory per thread. Returns 0, or -1 while initialized.
+int ano_log_set_mode(ano_logmode_t mode);
+
+// Pick the session file encoding for the next ano_log_init. Binary skips rendering on the drain thread
+// for records bound only for the file. The terminal always gets text. Returns 0, or -1 while initialized.
+int ano_log_set_format(ano_logformat_t format);
+
+// Export structured records for the next ano_log_init: each event gets dir/<stamp>_<event>_kv.csv, one
+// column per key plus ts_ns, its header fixed by the event's first record. Returns 0, or -1 while initialized.
+int ano_log_set_columns(bool on);
+
+// Open dir/<session-stamp>_ano.log (_ano.alog when binary) as the output file (the stamp:
+// ano_fs_session_stamp).
 // Returns 0 on success, -1 keeps the previous file.
 int ano_log_output_dir(const char* directoryPath);
 
 // Runtime severity gate.
 void ano_log_set_level(ano_loglevel_t min);
 
+// Set a level's full-ring policy. ERROR and FATAL refuse ANO_LOG_DROP. Returns 0, or -1 when rejected.
+int ano_log_set_overflow(ano_loglevel_t level, ano_logoverflow_t policy);
+
 // Replace a level's default route. Must name a sink. Out-of-range levels are ignored.
 void ano_log_set_route(ano_loglevel_t level, ano_logroute_t route);
 
@@ -88,6 +172,32 @@ void ano_log_flush(void);
 #define ano_olog(level, ...)                ano_log_write((level), 0, __FILE_NAME__, __LINE__, __VA_ARGS__)
 #define ano_rolog(level, route, ...)        ano_log_write((level), (route), __FILE_NAME__, __LINE__, __VA_ARGS__)
 
+// Structured: ano_log_fields(ANO_INFO, "frame", ANO_KV_U("n", n), ANO_KV_F("ms", ms)). Field makers take
+// a literal key. ANO_KV_S takes an anostr_t (include anoptic_strings.h) and copies its bytes.
+#define ANO_KV_U(k, v)   ((ano_logfield_t){ .key = (k), .type = ANO_KV_U64, .u64 = (uint64_t)(v) })
+#define ANO_KV_F(k, v)   ((ano_logfield_t){ .key = (k), .type = ANO_KV_F64, .f64 = (double)(v) })
+#define ANO_KV_SID(k, v) ((ano_logfield_t){ .key = (k), .type = ANO_KV_SID, .sid = (uint64_t)(v) })
+#define ANO_KV_S(k, s)   ((ano_logfield_t){ .key = (k), .type = ANO_KV_STR,                          \
+                          .str = { anostr_bytes((const anostr_t[]){ (s) }), (uint32_t)anostr_len((s)) } })
+#define ano_log_fields(level, event, ...)                                                           \
+    ano_log_kv((level), 0, (event), (const ano_logfield_t[]){ __VA_ARGS__ },                        \
+               (uint32_t)(sizeof((const ano_logfield_t[]){ __VA_ARGS__ }) / sizeof(ano_logfield_t)))
+
+// Sampled: each expansion owns a static ano_logsite_t, so a call in a hot loop past its budget skips
+// formatting and the ring. Statements, no return value.
+// _every_n  : every nth call from this site, starting with the first.
+// _once     : the first call from this site, for the life of the process.
+// _ratelimit: at most perSec calls a second from this site.
+#define ano_log_every_n(level, n, ...)                                                              \
+    do { static ano_logsite_t ano_site_;                                                            \
+         if (ano_log_gate_every(&ano_site_, (n))) ano_log_write((level), 0, NULL, 0, __VA_ARGS__); } while (0)
+#define ano_log_once(level, ...)                                                                    \
+    do { static ano_logsite_t ano_site_;                                                            \
+         if (ano_log_gate_once(&ano_site_)) ano_log_write((level), 0, NULL, 0, __VA_ARGS__); } while (0)
+#define ano_log_ratelimit(level, perSec, ...)                                                       \
+    do { static ano_logsite_t ano_site_;                                                            \
+         if (ano_log_gate_rate(&ano_site_, (perSec))) ano_log_write((level), 0, NULL, 0, __VA_ARGS__); } while (0)
+
 #ifdef DEBUG_BUILD
 #define ano_debug_log(level, ...)           ano_log_write((level), 0, NULL, 0, __VA_ARGS__)
 #define ano_debug_rlog(level, route, ...)   ano_log_write((level), (route), NULL, 0, __VA_ARGS__)
@@ -41,7 +41,8 @@
 // The record file is per-session -- <gamedir>/logs/<session-stamp>_CRASH.log, the stamp shared with
 // the logger's own file (ano_fs_session_stamp) -- resolved once here, never inside a handler.
 // Stage 4 announces how many *_CRASH.log files are left over ("n crash logs detected"), then prunes
-// both *_CRASH.log and *_ano.log to the newest 4 each, never touching the live session's files.
+// *_CRASH.log, *_ano.log, *_ano.alog, *_trace.json and *_trace.ring to the newest 4 each and *_kv.csv
+// to the newest 8, never touching the live session's files.
 // Output: 0 on success, -1 if a hook failed to install (the engine flies on, crash-naked).
 int ano_log_crash_init(void);
 
@@ -57,4 +58,41 @@ int ano_log_crash_thread_arm(void);
 // Release what ano_log_crash_thread_arm reserved, just before the thread exits. Safe to call unarmed.
 void ano_log_crash_thread_disarm(void);
 
+
+/* Crash Trace (DEBUG_TRACE) */
+
+// The flight recorder. ano_trace records go into a fixed-size ring that IS a file,
+// <gamedir>/logs/<session-stamp>_trace.ring, mapped shared and never zeroed. Nothing has to run at fault
+// time for them to survive: the pages belong to the kernel the moment they are written, so a SIGKILL,
+// an OOM-kill or a wedged hail mary still leaves the last records on disk. The oldest are overwritten,
+// a record never waits. tools/anotrace_dump.c prints the file in order.
+// Records are deferred captures (ano_log's format subset), costing about one deferred log enqueue.
+
+// Per-call-site state for ano_trace: the site's format id in the current file. Zero-initialized.
+typedef struct {
+    _Atomic uint64_t id;            // session generation << 32 | format id
+} ano_tracesite_t;
+
+// Create and map this session's trace file. Returns 0, or -1 if it could not be created or mapped.
+int ano_trace_init(void);
+
+// Mark the file cleanly closed, flush and unmap it. Threads still tracing must be joined first.
+// Returns 0, or -1 when not initialized.
+int ano_trace_cleanup(void);
+
+// Scope-bound teardown, ANO_LOG_SCOPE_ATTR-style (anoptic_log.h).
+void ano_trace_scope_release(const int *initStatus);
+#define ANO_TRACE_SCOPE_ATTR __attribute__((__cleanup__(ano_trace_scope_release)))
+
+// Record one entry. fmt MUST be a string literal. Returns 0, or -1 when not initialized.
+int ano_trace_write(ano_tracesite_t *site, const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+
+// This session's trace file, or NULL while not initialized.
+const char *ano_trace_path(void);
+
+#define ano_trace(...) do {                         \
+        static ano_tracesite_t ano_trace_site_;     \
+        ano_trace_write(&ano_trace_site_, __VA_ARGS__); \
+    } while (0)
+
 #endif // ANOPTIC_LOG_CRASH_H
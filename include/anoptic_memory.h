@@ -5,7 +5,9 @@
 #ifndef ANOPTICENGINE_ANOPTIC_MEMORY_H
 #define ANOPTICENGINE_ANOPTIC_MEMORY_H
 
+#include <stdatomic.h>
 #include <stddef.h> // for size_t
+#include <stdint.h> // uintptr_t for the arena bump
 #include <stdlib.h> // before mimalloc-override.h: MinGW declares _msize/_aligned_msize
 #include <mimalloc.h>
 #if !defined(__APPLE__)
@@ -15,6 +17,7 @@
 #if defined(__linux__) || defined(__APPLE__)
 #include <alloca.h>
 #endif
+#include "anoptic_threads.h" // pool refill lock
 
 // Hardware interference sizes. Compile-time constants: _Alignas and struct layout need a
 // constant, not a runtime cache query. ANO_CACHE_LINE is the true coherency line — the grain for
@@ -67,4 +70,295 @@ void* ano_aligned_malloc(size_t size, size_t alignment);
  */
 void ano_aligned_free(void* ptr);
 
+
+/* Bump arenas (frame / scratch tier) */
+
+// A linear allocator over one reserved virtual range. Init reserves address space only. Pages are
+// committed in ANO_ARENA_COMMIT steps as the bump pointer crosses them, and stay committed across
+// rewinds and resets, so a steady-state frame makes no system calls. Allocation is a pointer bump,
+// free is a rewind to a mark, reset is a rewind to zero. Nothing is freed one block at a time.
+//
+// One owner thread per arena, no locks. Pointers die with the rewind that passes them. ASan builds
+// poison everything past the bump pointer, so a use after rewind or reset faults. Debug builds also fill
+// rewound bytes with 0xDD.
+typedef struct ano_arena_t
+{
+    unsigned char *base;        // reserved range, aligned to `step`
+    size_t         reserved;    // bytes of address space
+    size_t         committed;   // bytes from base backed by memory
+    size_t         used;        // bump offset
+    size_t         peak;        // high-water `used` since init
+    size_t         step;        // commit granularity: ANO_ARENA_COMMIT, or the huge page size
+    uint32_t       flags;       // ANO_ARENA_* options asked for at init
+    uint32_t       pages;       // ANO_ARENA_PAGES_*: the smallest page kind backing any commit so far
+    int            node;        // NUMA node the range prefers, -1 when unbound
+} ano_arena_t;
+
+#define ANO_ARENA_COMMIT        ((size_t)64 << 10)  // commit step
+#define ANO_SCRATCH_RESERVE     ((size_t)256 << 20) // per ambient scratch arena
+
+// ano_arena_init_ex options, for large long-lived regions (the logger ring, intern tables, mesh
+// buffers). Every one is best effort: what the OS refuses falls back to normal pages on any node, and
+// `pages` / `node` record what the arena actually got.
+#define ANO_ARENA_HUGE          0x1u    // 2 MiB pages: explicit (hugetlb), else transparent
+#define ANO_ARENA_HUGE_1G       0x2u    // 1 GiB pages for reservations of at least 1 GiB, else as HUGE
+#define ANO_ARENA_NUMA_LOCAL    0x4u    // prefer the NUMA node of the thread calling init
+
+// `pages` values, weakest first.
+#define ANO_ARENA_PAGES_NONE    0u      // nothing committed yet
+#define ANO_ARENA_PAGES_SMALL   1u      // base pages (4 KiB, 16 KiB on Apple Silicon)
+#define ANO_ARENA_PAGES_THP     2u      // base pages advised for transparent huge pages (Linux)
+#define ANO_ARENA_PAGES_2M      3u      // explicit 2 MiB pages (hugetlb, Windows large pages)
+#define ANO_ARENA_PAGES_1G      4u      // explicit 1 GiB pages
+
+#if defined(__SANITIZE_ADDRESS__)
+#define ANO_ARENA_ASAN 1
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define ANO_ARENA_ASAN 1
+#endif
+#endif
+#ifdef ANO_ARENA_ASAN
+#include <sanitizer/asan_interface.h>
+#define ano_arena_unpoison_(p, n) ASAN_UNPOISON_MEMORY_REGION((p), (n))
+#else
+#define ano_arena_unpoison_(p, n) ((void)(p), (void)(n))
+#endif
+
+// in:  arena, reserve (bytes of address space, rounded up to ANO_ARENA_COMMIT)
+// out: 0 on success, -1 when the range cannot be reserved
+int ano_arena_init(ano_arena_t *arena, size_t reserve);
+
+// ano_arena_init with ANO_ARENA_* options. Huge arenas round the reservation and every commit up to the
+// huge page size. On Windows, large pages cannot be reserved without being committed, so a large-page
+// arena commits its whole reservation at init. That needs SeLockMemoryPrivilege; without it the arena
+// falls back to normal pages.
+int ano_arena_init_ex(ano_arena_t *arena, size_t reserve, uint32_t flags);
+
+// Returns the whole range to the OS.
+void ano_arena_destroy(ano_arena_t *arena);
+
+// Commit path of ano_arena_alloc. Not for direct use.
+void *ano_arena_alloc_slow_(ano_arena_t *arena, size_t size, size_t align);
+
+// `size` bytes aligned to `align` (a power of two), uninitialized. NULL only when the reservation is
+// exhausted or the OS refuses the commit.
+static inline void *ano_arena_alloc(ano_arena_t *arena, size_t size, size_t align)
+{
+    uintptr_t base = (uintptr_t)arena->base;
+    size_t    off  = (size_t)(((base + arena->used + (align - 1u)) & ~(uintptr_t)(align - 1u)) - base);
+    if (off > arena->committed || size > arena->committed - off)
+        return ano_arena_alloc_slow_(arena, size, align);
+    arena->used = off + size;
+    ano_arena_unpoison_(arena->base + off, size);
+    return arena->base + off;
+}
+
+// Zero-filled ano_arena_alloc.
+void *ano_arena_zalloc(ano_arena_t *arena, size_t size, size_t align);
+
+// n elements of type T, uninitialized.
+#define ano_arena_new(arena, T, n) ((T *)ano_arena_alloc((arena), sizeof(T) * (size_t)(n), _Alignof(T)))
+
+// The bump offset, for a later ano_arena_rewind.
+static inline size_t ano_arena_mark(const ano_arena_t *arena)
+{
+    return arena->used;
+}
+
+// Free everything allocated since `mark`. Rewinding forward is ignored.
+void ano_arena_rewind(ano_arena_t *arena, size_t mark);
+
+// Free everything, O(1): the frame boundary. Commit is kept.
+void ano_arena_reset(ano_arena_t *arena);
+
+// Give committed pages past max(used, keep) back to the OS, after a spike.
+void ano_arena_trim(ano_arena_t *arena, size_t keep);
+
+// A mark that rewinds itself at scope exit.
+// Usage: ano_arena_scope_t s ANO_ARENA_SCOPE_ATTR = ano_arena_scope(arena);
+typedef struct ano_arena_scope_t
+{
+    ano_arena_t *arena;
+    size_t       mark;
+} ano_arena_scope_t;
+
+// A NULL arena (a failed ano_scratch) makes an inert scope.
+static inline ano_arena_scope_t ano_arena_scope(ano_arena_t *arena)
+{
+    return (ano_arena_scope_t){ arena, arena ? arena->used : 0u };
+}
+
+void ano_arena_scope_release(ano_arena_scope_t *scope);
+#define ANO_ARENA_SCOPE_ATTR __attribute__((__cleanup__(ano_arena_scope_release)))
+
+// The calling thread's ambient scratch arena, reserved on first use and released at thread exit. Each
+// thread has two. Pass the arena a caller handed you (NULL if none) as `conflict` and you get the other
+// one, so scratch work never rewinds over the caller's results. Take it with a scope, so it rewinds on
+// return. NULL if the reservation fails.
+// Usage: ano_arena_scope_t s ANO_ARENA_SCOPE_ATTR = ano_arena_scope(ano_scratch(out));
+ano_arena_t *ano_scratch(const ano_arena_t *conflict);
+
+
+/* Object pools (fixed-size tier) */
+
+// Fixed-size objects carved from slab pages, for hot types allocated and freed at high rates (render
+// commands, quarantine records, glyph blocks). A free object's first word links it into a free list,
+// so the pool keeps no side tables. Each thread parks frees in its own magazine and allocates from it
+// first, with no atomics and no lock. A magazine that fills spills half its objects onto the pool's
+// shared stack with one CAS, and one that runs dry refills a batch under the pool's lock, from that
+// stack or from fresh slab space. An object may be freed on any thread, not only the one that took it.
+//
+// Slab pages are never returned before ano_pool_destroy. ANO_POOL_THREADS threads get a magazine at
+// once; a thread past that goes straight to the shared stack and the lock. A magazine outlives its
+// thread: the next thread to take the slot inherits the objects parked in it.
+#define ANO_POOL_PAGE       ((size_t)64 << 10)  // slab page size, or one object when larger
+#define ANO_POOL_MAG        64u                 // magazine capacity, objects
+#define ANO_POOL_THREADS    64u                 // magazine slots per pool
+
+typedef struct ano_pool_mag_t ano_pool_mag_t;
+
+typedef struct ano_pool_t
+{
+    _Alignas(ANO_THREAD_LINE) void *_Atomic remote; // spilled and slotless frees, CAS-pushed
+    _Atomic size_t      remoteCount;
+    _Alignas(ANO_THREAD_LINE) anothread_mutex_t lock;   // refill: the fields below
+    void               *central;        // free list drained from `remote`
+    size_t              centralCount;
+    void               *pages;          // slab chain, linked through each page's first word
+    unsigned char      *bump, *bumpEnd; // uncarved space in the newest page
+    size_t              pageCount;
+    size_t              carved;         // objects ever cut from slabs
+    size_t              stride;         // object size, rounded up to its alignment
+    size_t              align;
+    size_t              perPage;
+    ano_pool_mag_t     *mags;           // ANO_POOL_THREADS slots
+} ano_pool_t;
+
+// Occupancy snapshot. Counts read from other threads' magazines race with them, so under load the
+// split between live and cached is approximate. capacity is exact.
+typedef struct ano_pool_stats_t
+{
+    size_t stride;      // bytes per object
+    size_t pages;       // slab pages held
+    size_t capacity;    // objects the pages hold
+    size_t live;        // allocated, not yet freed
+    size_t cached;      // free, parked in thread magazines
+    size_t free;        // free in the shared lists or not yet carved
+} ano_pool_stats_t;
+
+// in:  pool, size and align (a power of two) of the object
+// out: 0 on success, -1 on bad arguments or allocation failure
+int ano_pool_init(ano_pool_t *pool, size_t size, size_t align);
+
+// Pool of objects of type T.
+#define ano_pool_init_type(pool, T) ano_pool_init((pool), sizeof(T), _Alignof(T))
+
+// Frees every slab page. Every object dies with it, and no thread may be inside the pool.
+void ano_pool_destroy(ano_pool_t *pool);
+
+// One uninitialized object, NULL when out of memory.
+void *ano_pool_alloc(ano_pool_t *pool);
+
+// Any thread. NULL is ignored.
+void ano_pool_free(ano_pool_t *pool, void *obj);
+
+// Hand this thread's magazine for `pool` back to the shared stack, e.g. before a thread parks for long.
+void ano_pool_flush(ano_pool_t *pool);
+
+void ano_pool_stats(ano_pool_t *pool, ano_pool_stats_t *out);
+
+/* Memory accounting (tagged allocation) */
+
+// A tag names the owner of a set of allocations: one per subsystem ("log", "text", "mesh"). Allocations
+// made through the ano_t* calls below count against their tag: live and peak bytes (mimalloc usable
+// sizes), and allocation and free counts. A tag may be bound to a mi_heap_t, and then allocates from it.
+// Unbound tags allocate from the default heap. A subsystem that owns a heap binds a tag to it and routes
+// every allocation on that heap through the tag, so the tag's live bytes are the heap's; blocks a library
+// placed on the heap for it (ano_tadopt) count too.
+//
+// Tags have static storage duration and register themselves on first use. Counting is a few relaxed
+// atomics per call. A block must be freed through the tag that allocated it, or the counts drift (the
+// memory itself is still freed correctly: mi_free finds the heap from the block).
+typedef struct ano_mem_tag_t
+{
+    _Alignas(ANO_THREAD_LINE) const char *name;
+    mi_heap_t               *heap;          // NULL: the default heap. Set with ano_mem_tag_bind
+    _Atomic int64_t          live;          // bytes
+    _Atomic int64_t          peak;
+    _Atomic uint64_t         allocs;
+    _Atomic uint64_t         frees;
+    _Atomic int64_t          heapLive;      // the part of live on the bound heap, for ano_mem_tag_release
+    _Atomic uint64_t         heapBlocks;
+    atomic_bool              registered;
+    struct ano_mem_tag_t    *next;          // registry chain
+} ano_mem_tag_t;
+
+// Usage: static ano_mem_tag_t g_logMem = ANO_MEM_TAG("log");
+#define ANO_MEM_TAG(tagName) { .name = (tagName) }
+
+// Route the tag's allocations to `heap` (NULL: the default heap). Live counts carry across the rebind:
+// blocks on the old binding stay live until freed through the tag. Not concurrent with the tag's calls.
+void ano_mem_tag_bind(ano_mem_tag_t *tag, mi_heap_t *heap);
+
+// The bound heap was destroyed (mi_heap_destroy frees its blocks wholesale): count every block the tag
+// has live on it as freed, and unbind. Several tags bound to one heap each release after the destroy.
+void ano_mem_tag_release(ano_mem_tag_t *tag);
+
+// Counting allocation. `site` is the call site ("file.c:123"), recorded when sampling picks the call.
+// Use the macros, which fill it in.
+void *ano_tmalloc_(ano_mem_tag_t *tag, size_t size, const char *site);
+void *ano_tzalloc_(ano_mem_tag_t *tag, size_t size, const char *site);
+void *ano_tcalloc_(ano_mem_tag_t *tag, size_t count, size_t size, const char *site);
+void *ano_trealloc_(ano_mem_tag_t *tag, void *ptr, size_t size, const char *site);
+void  ano_tfree(ano_mem_tag_t *tag, void *ptr);
+
+// Count a live block allocated elsewhere (a library filling the tag's bound heap) as the tag's own, as if
+// ano_tmalloc had returned it. Free it through the tag, or with the heap and ano_mem_tag_release. NULL is
+// ignored.
+void  ano_tadopt_(ano_mem_tag_t *tag, void *ptr, const char *site);
+
+#define ANO_MEM_STR_(x) #x
+#define ANO_MEM_SITE_(line) __FILE__ ":" ANO_MEM_STR_(line)
+#define ano_tmalloc(tag, size)         ano_tmalloc_((tag), (size), ANO_MEM_SITE_(__LINE__))
+#define ano_tzalloc(tag, size)         ano_tzalloc_((tag), (size), ANO_MEM_SITE_(__LINE__))
+#define ano_tcalloc(tag, count, size)  ano_tcalloc_((tag), (count), (size), ANO_MEM_SITE_(__LINE__))
+#define ano_trealloc(tag, ptr, size)   ano_trealloc_((tag), (ptr), (size), ANO_MEM_SITE_(__LINE__))
+#define ano_tadopt(tag, ptr)           ano_tadopt_((tag), (ptr), ANO_MEM_SITE_(__LINE__))
+
+// Allocation-site sampling: about one call per `bytes` allocated on each thread records its site, so
+// the histogram weighs sites by bytes, not calls. Each thread starts its countdown at a random point in the
+// period, so first allocations are not oversampled. 0 (the default) turns it off. ANO_MEM_SITES distinct
+// sites are kept; later ones are counted as lost.
+#define ANO_MEM_SITES 256u
+void ano_memory_sample_every(size_t bytes);
+
+typedef struct ano_mem_report_t
+{
+    const char *name;
+    int64_t     live;       // bytes
+    int64_t     peak;
+    uint64_t    allocs;
+    uint64_t    frees;
+} ano_mem_report_t;
+
+typedef struct ano_mem_site_t
+{
+    const char *tag;        // tag name
+    const char *site;       // "file.c:123"
+    uint64_t    samples;
+    uint64_t    bytes;      // sum of the sampled allocations' sizes
+} ano_mem_site_t;
+
+// Snapshot of every registered tag, in registration order, into out[0..cap). Returns the tag count,
+// which may exceed cap. Any thread.
+size_t ano_memory_report(ano_mem_report_t *out, size_t cap);
+
+// Snapshot of the sampled sites, heaviest first. Returns the site count, which may exceed cap.
+size_t ano_memory_sites(ano_mem_site_t *out, size_t cap);
+
+// The report as text, one line per call of `line`: a row per tag, then the heaviest sampled sites.
+// Hand it a function that logs each line to dump the report through the logger.
+void ano_memory_report_emit(void (*line)(void *ctx, const char *text), void *ctx);
+
 #endif //ANOPTICENGINE_ANOPTIC_MEMORY_H
\ No newline at end of file
@@ -0,0 +1,79 @@
+/* SPDX-FileCopyrightText: 2026 Anoptic Game Engine Authors
+ *
+ * SPDX-License-Identifier: LGPL-3.0 */
+/*  == Anoptic Game Engine v0.0000001 == */
+
+// Scoped CPU profiler, the throughput sibling of the logger. Each thread pushes begin/end events stamped
+// with ano_timestamp_ticks into its own SPSC buffer (the logger's lane skeleton, fixed 16-byte slots). A
+// flusher thread converts them to Chrome trace JSON in <logpath>/<stamp>_trace.json, which
+// chrome://tracing, ui.perfetto.dev and speedscope open directly.
+//
+//   ANO_PROFILE_SCOPE("ui.tile_build");          begin now, end when the enclosing block exits
+//   ano_profile_span("log.drain", t0);           one complete event from t0 to now, after the fact
+//
+// An event is one clock read, one thread-local load and two plain stores. It never blocks: a full
+// buffer drops the scope (and everything nested in it) and counts it. Before ano_profile_init and
+// after ano_profile_cleanup every call is a no-op. Build with -DANOPTIC_PROFILER=OFF to compile the
+// macros out entirely.
+//
+// Names MUST be string literals: events store them by pointer and the flusher reads them later.
+
+#ifndef ANOPTIC_PROFILER_H
+#define ANOPTIC_PROFILER_H
+
+#include <stdint.h>
+
+
+/* Lifecycle Functions */
+
+// Startup and Shutdown. Both return 0 on success. Init opens the trace file and starts the flusher.
+// Cleanup flushes everything, closes the file and frees the buffers, so every profiled thread other
+// than the caller must be joined or parked first.
+int ano_profile_init(void);
+int ano_profile_cleanup(void);
+
+// Scope-bound teardown, ANO_LOG_SCOPE_ATTR-style (anoptic_log.h).
+void ano_profile_scope_release(const int *initStatus);
+#define ANO_PROFILE_SCOPE_ATTR __attribute__((__cleanup__(ano_profile_scope_release)))
+
+
+/* Entry Points */
+
+// Open and close a scope on the calling thread. Pairs nest. An end with no open scope is ignored.
+void ano_profile_begin(const char *name);
+void ano_profile_end(void);
+
+// One complete event from t0 (an ano_timestamp_ticks value) to now. For work only worth recording once
+// it turns out nonempty. Nested scopes already recorded on this thread stay correct.
+void ano_profile_span(const char *name, uint64_t t0);
+
+// Label the calling thread's track, e.g. "logic". name MUST be a string literal.
+void ano_profile_thread_name(const char *name);
+
+// Convert everything buffered so far, on the calling thread, and write it out. Returns events written.
+uint64_t ano_profile_flush(void);
+
+// Scopes and spans dropped to full buffers since init. A dropped scope's nested scopes go uncounted.
+uint64_t ano_profile_dropped(void);
+
+// This session's trace file, or NULL while not initialized.
+const char *ano_profile_path(void);
+
+
+/* Scope Macro */
+
+// Cleanup target for ANO_PROFILE_SCOPE.
+void ano_profile_scope_end(const char *const *scope);
+
+#define ANO_PROFILE_CAT_(a, b) a##b
+#define ANO_PROFILE_CAT(a, b)  ANO_PROFILE_CAT_(a, b)
+
+#ifndef ANO_PROFILE_OFF
+#define ANO_PROFILE_SCOPE(name)                                                               \
+    const char *ANO_PROFILE_CAT(ano_prof_scope_, __LINE__)                                    \
+        __attribute__((__cleanup__(ano_profile_scope_end), __unused__)) = (ano_profile_begin(name), (name))
+#else
+#define ANO_PROFILE_SCOPE(name) ((void)0)
+#endif
+
+#endif // ANOPTIC_PROFILER_H
@@ -34,6 +34,7 @@ It is the bridge betwixt engine <===> renderer.
 #include <anoptic_math.h> // mat4, Vector4
 #include <anoptic_text.h> // AnoFontBake, AnoGlyphInstance (logic-side text shaping)
 #include <anoptic_ui.h>   // AnoUiPrim/Clip/Paint/Stop + builder (logic-side UI layout)
+#include <anoptic_memory.h> // ano_mem_tag_t
 
 // ---------------------------------------------------------------------------
 // Renderer lifecycle (render world; runs on the main thread)
@@ -427,6 +428,10 @@ typedef struct RenderCommand
 // single tick is O(1) ring messages and never approaches the ceiling in the first place.
 bool ano_render_submit(AnoRenderBridge *bridge, const RenderCommand *cmd);
 
+// Accounting tag ("bridge") for the render-owned blocks below and in RCMD_TEXT_SET / RCMD_UI_SET:
+// the producer allocates them through it, and the render side frees them through it.
+extern ano_mem_tag_t ano_render_block_mem;
+
 // Bulk producer endpoints. Each copies the batch into one render-owned block (released
 // render-side after the change has reached every frame in flight), so the caller's arrays
 // need only live until the call returns. Same backpressure contract as ano_render_submit:
@@ -224,6 +224,24 @@ static inline anostr_split_t anostr_split(anostr_t s, anostr_t sep)
 // Writes the next piece and returns true; false once exhausted (piece untouched).
 bool anostr_split_next(anostr_split_t *it, anostr_t *piece);
 
+// ---------------------------------------------------------------------------------------------
+// SIMD tiers. anostr_find (and with it split and replace_all), anostr_rune_count and anostr_utf8_valid
+// run on the widest kernels the CPU has, picked once at first use. Every tier returns exactly what the
+// scalar one does; the fuzzers hold them to it.
+typedef enum anostr_simd_t {
+    ANOSTR_SIMD_SCALAR,
+    ANOSTR_SIMD_SSE2,       // x86-64 baseline
+    ANOSTR_SIMD_AVX2,       // x86, when the CPU reports it
+    ANOSTR_SIMD_NEON,       // AArch64 baseline
+} anostr_simd_t;
+
+// The tier in use.
+anostr_simd_t anostr_simd(void);
+
+// Switch tiers, for tests and benchmarks. A tier this build or CPU lacks leaves the current one in
+// place. Returns the tier now in use. Safe while other threads run: every tier answers the same.
+anostr_simd_t anostr_simd_force(anostr_simd_t tier);
+
 // ---------------------------------------------------------------------------------------------
 // Interning: dedupe + i    nteger identity.
 // One canonical copy of each distinct string lives in the table's heap; a symbol is a dense u32 (0 .. count-1) you compare and switch on. 
@@ -258,6 +276,57 @@ anostr_t anostr_dedupe(anostr_intern_t *t, anostr_t s);
 // Distinct strings interned so far; symbols are dense 0 .. count-1.
 size_t anostr_intern_count(const anostr_intern_t *t);
 
+// Snapshot: the table as one flat, relocatable file (offsets only) for the next boot to map
+// instead of interning everything again. Carries every symbol's collation key too
+// (anostr_sym_collate_key), so a mapped table sorts without walking the collation tables.
+// Written beside `path`, then swapped in whole. 0, or -1 on I/O or allocation failure.
+int anostr_intern_save(anostr_intern_t *t, const char *path);
+
+// A table over a saved file, mapped read-only: no hashing or copying, pages fault in as used.
+// Symbols 0 .. count-1 are the saved ones, same numbers; new strings intern into a writable
+// overlay allocated from heap. Long canonical values point into the mapping.
+// NULL if the file is missing, malformed or written with another string hash (intern from
+// scratch then). A file from other collation tables maps without its keys; they rebuild.
+anostr_intern_t *anostr_intern_map(mi_heap_t *heap, const char *path);
+
+// The one teardown call: releases a mapped table's file. The table, and every value it handed
+// out of the file, is dead after -- call it just before the heap goes. No-op on plain tables.
+void anostr_intern_unmap(anostr_intern_t *t);
+
+// ---------------------------------------------------------------------------------------------
+// Concurrent interning: the same contract as anostr_intern_t, for any number of threads at once.
+// Sharded by hash; each shard owns a bump arena (canonical bytes, slot tables) and a mutex that only
+// inserts take. Lookups never lock: slot tables are published with a release store, and a table
+// replaced by growth stays readable until the whole table is destroyed.
+// Symbols are dense u32 ids from one counter shared by every shard. A symbol is visible to the
+// thread that interned it and to any thread it hands the symbol to.
+// Not mi_heap-backed: a mimalloc heap belongs to its creating thread, so this one owns its memory
+// and has a destroy function.
+typedef struct anostr_intern_mt_t anostr_intern_mt_t;
+
+// shardReserve: address space per shard (canonical bytes plus slot tables), 0 for 64 MiB. It is
+// reserved up front and committed on use. NULL on failure.
+anostr_intern_mt_t *anostr_intern_mt_make(size_t shardReserve);
+
+// Frees the table and every canonical value. No other thread may still be using it.
+void anostr_intern_mt_destroy(anostr_intern_mt_t *t);
+
+// Any thread. anostr_intern's contract; ANOSTR_SYM_NONE on allocation failure or a full shard.
+anostr_sym anostr_intern_mt(anostr_intern_mt_t *t, anostr_t s);
+
+// Any thread, never locks. ANOSTR_SYM_NONE if s was never interned (or is mid-insert elsewhere).
+anostr_sym anostr_intern_mt_find(const anostr_intern_mt_t *t, anostr_t s);
+
+// Any thread. The canonical value, valid until destroy; empty for an unknown symbol, including one
+// another thread has claimed but not finished inserting.
+anostr_t anostr_sym_str_mt(const anostr_intern_mt_t *t, anostr_sym sym);
+
+// Any thread. anostr_dedupe's contract.
+anostr_t anostr_dedupe_mt(anostr_intern_mt_t *t, anostr_t s);
+
+// Symbols handed out so far. Inserts racing the call may not have published theirs yet.
+size_t anostr_intern_mt_count(const anostr_intern_mt_t *t);
+
 // ---------------------------------------------------------------------------------------------
 // Compile-time string ids: a literal hashed at build time to an integer constant expression.
 // No runtime hashing, no stored string -- nothing reaches the binary but the number.
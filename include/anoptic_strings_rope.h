@@ -0,0 +1,80 @@
+/* SPDX-FileCopyrightText: 2026 Anoptic Game Engine Authors
+ *
+ * SPDX-License-Identifier: LGPL-3.0 */
+/*  == Anoptic Game Engine v0.0000001 == */
+
+// Extension to the Anoptic String API: the rope, an editable text buffer for documents too big
+// to rebuild per edit (console scrollback, log viewer, chat history).
+//
+// A rope is a balanced tree of pieces, each piece an anostr_t. Inserted bytes are copied once
+// into the rope's own append-only blocks; anostr_rope_insert_ref borrows instead. Every edit
+// splits at most two pieces and rebalances one path, so insert and delete are O(log n) in the
+// piece count and copy only the inserted text, never the document.
+// Each subtree carries its byte, rune and newline counts, so rune and line lookups are
+// O(log n) too. Reading is by chunks: borrowed anostr_t pieces, in order, no copying.
+//
+// Positions are byte offsets. An offset inside a multi-byte rune snaps back to that rune's start.
+// Rune counts assume valid UTF-8 (anostr_rune_count's contract).
+// Threading: single owner, like the heap underneath.
+
+#ifndef ANOPTICENGINE_ANOPTIC_STRINGS_ROPE_H
+#define ANOPTICENGINE_ANOPTIC_STRINGS_ROPE_H
+
+#include "anoptic_strings_utf.h"
+
+typedef struct anostr_rope_t anostr_rope_t;
+
+// An empty rope allocating from heap (which must outlive it). NULL on allocation failure.
+anostr_rope_t *anostr_rope_make(mi_heap_t *heap);
+
+// Free the rope, its tree and its blocks. Chunks read from it die with it. NULL is a no-op.
+void anostr_rope_destroy(anostr_rope_t *r);
+
+// Byte length, rune count, and line count ('\n' count plus one: an empty rope is one line).
+size_t anostr_rope_len(const anostr_rope_t *r);
+size_t anostr_rope_runes(const anostr_rope_t *r);
+size_t anostr_rope_lines(const anostr_rope_t *r);
+
+// Insert s's bytes at byte offset `at` (clamped to the length), copying them into the rope.
+// Consecutive inserts that continue each other (typing) extend one piece instead of adding more.
+// 0, or -1 on allocation failure with the rope unchanged.
+int anostr_rope_insert(anostr_rope_t *r, size_t at, anostr_t s);
+
+// anostr_rope_insert without the copy: the pieces borrow s's bytes, which must outlive the rope.
+// For loading a document already in memory.
+int anostr_rope_insert_ref(anostr_rope_t *r, size_t at, anostr_t s);
+
+// anostr_rope_insert at the end.
+int anostr_rope_append(anostr_rope_t *r, anostr_t s);
+
+// Remove bytes [from, to), both clamped to the length. 0, or -1 on allocation failure with the
+// rope unchanged.
+int anostr_rope_delete(anostr_rope_t *r, size_t from, size_t to);
+
+// Byte offset of the rune with index `rune`. The length when rune >= anostr_rope_runes.
+size_t anostr_rope_rune_offset(const anostr_rope_t *r, size_t rune);
+
+// Byte offset where line `line` starts (0-based). ANOSTR_NPOS when line >= anostr_rope_lines.
+size_t anostr_rope_line_offset(const anostr_rope_t *r, size_t line);
+
+// anostr_rune_next over the rope: decode at *i, advance past it. Same malformed and past-end
+// contract; a rune may span pieces.
+anorune_t anostr_rope_rune_next(const anostr_rope_t *r, size_t *i);
+
+// Bytes [from, to) as one value. Borrows (no copy) when the range lies inside one piece, valid
+// until the rope's next edit; else one copy into heap. Empty string on allocation failure.
+anostr_t anostr_rope_slice(mi_heap_t *heap, const anostr_rope_t *r, size_t from, size_t to);
+
+// Chunk iterator over bytes [from, to): borrowed pieces, in order, every one non-empty.
+// Chunks stay valid until the rope's next edit.
+//     anostr_rope_iter_t it = anostr_rope_chunks(r, 0, anostr_rope_len(r));
+//     for (anostr_t c; anostr_rope_next_chunk(&it, &c); ) { ... }
+typedef struct anostr_rope_iter_t {
+    const anostr_rope_t *rope;
+    size_t               at, end;
+} anostr_rope_iter_t;
+
+anostr_rope_iter_t anostr_rope_chunks(const anostr_rope_t *r, size_t from, size_t to);
+bool anostr_rope_next_chunk(anostr_rope_iter_t *it, anostr_t *chunk);
+
+#endif //ANOPTICENGINE_ANOPTIC_STRINGS_ROPE_H
@@ -131,12 +131,32 @@ void anostr_sort(anostr_t *items, size_t count);
 // Sort structs by name without shuffling 16-byte values, gather through order instead.
 void anostr_sort_idx(const anostr_t *items, size_t count, uint32_t *order);
 
+// anostr_sort / anostr_sort_idx split across threads, for sets in the hundreds of thousands and up.
+// Same result, element for element. threads: 0 runs on the job pool (anoptic_jobs.h), the calling
+// thread helping; otherwise on that many threads of its own, the calling thread one of them.
+// Small sets, a stopped pool and threads == 1 sort on the calling thread alone.
+void anostr_sort_mt(anostr_t *items, size_t count, uint32_t threads);
+void anostr_sort_idx_mt(const anostr_t *items, size_t count, uint32_t *order, uint32_t threads);
+
 // Sort interned symbols by their strings' collation order, in place. Stable.
-// Prefix keys cache per symbol in the table.
-// Mutates the cache (same one-owner-thread rule as anostr_intern).
+// Full keys (anostr_sym_collate_key) are kept per symbol in the table, so a symbol's strings
+// walk the collation tables once, ever; re-sorts compare key bytes only.
+// Mutates the table's key store (same one-owner-thread rule as anostr_intern).
 // Out-of-range symbols sort as the empty string, matching anostr_sym_str.
 void anostr_sym_sort(anostr_intern_t *t, anostr_sym *syms, size_t count);
 
+// The symbol's kept full key, byte-identical to anostr_collate_key of its string.
+// Built on first use (or on intern, see below) and valid as long as the table's heap.
+// Out-of-range symbols get the empty string's key. Empty string on allocation failure.
+anostr_t anostr_sym_collate_key(anostr_intern_t *t, anostr_sym sym);
+
+// anostr_collate of two symbols' strings, by comparing their kept keys.
+int anostr_sym_collate(anostr_intern_t *t, anostr_sym a, anostr_sym b);
+
+// Key every symbol now and each new one as it is interned: the collation cost moves to load
+// time. 0, or -1 on allocation failure (the missing keys then build at first use).
+int anostr_intern_eager_keys(anostr_intern_t *t);
+
 // Base-letter equality: case- and accent-insensitive. eq_base("Ålesund", "alesund").
 bool anostr_eq_base(anostr_t a, anostr_t b);
 
@@ -19,6 +19,7 @@
 
 #include "anoptic_memory.h"
 #include "anoptic_strings.h"
+#include "anoptic_strings_rope.h"
 
 // ---------------------------------------------------------------------------------------------
 // Module lifecycle.
@@ -163,6 +164,18 @@ void ano_text_measure_runs(const AnoFontBake *bake, anostr_t text,
                            const AnoTextRun *runs, uint32_t runCount,
                            float *width, float *height);
 
+// ano_text_shape over rope bytes [from, to) (clamped to the rope), read chunk by chunk
+// without flattening. Positions are bit-identical to ano_text_shape of the same bytes as one
+// string: kerning and runes carry across piece boundaries. Same returns and penOut.
+uint32_t ano_text_shape_rope(const AnoFontBake *bake, const anostr_rope_t *rope,
+                             size_t from, size_t to,
+                             float sizePx, const float origin[2], const float color[4],
+                             AnoGlyphInstance *out, uint32_t cap, float *penOut);
+
+// ano_text_measure over rope bytes [from, to).
+void ano_text_measure_rope(const AnoFontBake *bake, const anostr_rope_t *rope,
+                           size_t from, size_t to, float sizePx, float *width, float *height);
+
 // ---------------------------------------------------------------------------------------------
 // String-literal face macros wrapping anostr_lit, length folded at compile time.
 
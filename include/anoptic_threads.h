@@ -80,6 +80,16 @@ int ano_thread_detach(anothread_t thread);
 
 anothread_t ano_thread_self(void);
 
+// Give up the rest of the time slice. For retry loops on a full or empty lock-free queue.
+int ano_thread_yield(void);
+
+// Logical cores this process may run on: the affinity mask on Linux, else the online count. Never 0.
+unsigned int ano_thread_core_count(void);
+
+// Pin the calling thread to one logical core, indexed as ano_thread_core_count counts them.
+// Returns 0, or an errno (ENOTSUP on macOS, which only takes affinity hints).
+int ano_thread_pin_self(unsigned int core);
+
 
 /* Mutexes */
 
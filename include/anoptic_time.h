@@ -18,11 +18,16 @@
 uint64_t ano_timestamp_raw();
 
 /// \brief Raw monotonic hardware counter, no unit conversion -- the cheapest possible timestamp.
-/// \note Units are the platform timebase (mach ticks / QPC counts / ns on Linux), so only deltas are
-///       meaningful and only after ano_ticks_to_ns. Use to timestamp a hot path and defer the
-///       division to a colder one.
+/// \note Units are the platform timebase (mach ticks / invariant-TSC cycles on x86-64 where usable,
+///       else QPC counts or ns on Linux), so only deltas are meaningful and only after
+///       ano_ticks_to_ns. Use to timestamp a hot path and defer the division to a colder one.
 uint64_t ano_timestamp_ticks();
 
+/// \brief ano_timestamp_ticks, read in program order: not before earlier loads, and no later load
+///        issues before it. Costs fences; for a watermark compared against stamps other threads
+///        publish, not for per-event stamps.
+uint64_t ano_timestamp_ticks_ordered();
+
 /// \brief Convert a raw counter value or delta from ano_timestamp_ticks to nanoseconds.
 uint64_t ano_ticks_to_ns(uint64_t ticks);
 
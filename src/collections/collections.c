@@ -0,0 +1,439 @@
+/* SPDX-FileCopyrightText: 2026 Anoptic Game Engine Authors
+ *
+ * SPDX-License-Identifier: LGPL-3.0 */
+/*  == Anoptic Game Engine v0.0000001 == */
+
+// Cold halves of the lock-free collections (anoptic_collections.h): ring storage, and the whole
+// Michael & Scott queue with its hazard-pointer reclamation. The ring hot paths are inline in the header.
+//
+// Hazard pointers (Michael 2004). Each thread that touches a queue owns one record: two published
+// pointers and a private list of retired nodes. A thread protects a node by publishing it, then checking
+// that the shared pointer it came from still names it, so the node was reachable after publication. A
+// popped node is retired. Once a thread's list reaches twice the published pointers plus a floor, it
+// frees every retired node that no record names. Records live on one grow-only list. A record is
+// returned at thread exit (a thread key destructor), keeping its leftover retired nodes for the next
+// owner or ano_msq_reclaim.
+
+#include <anoptic_collections.h>
+#include <anoptic_threads.h>
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <mimalloc.h>
+
+struct AnoMsqNode
+{
+    AnoMsqNode *_Atomic next;
+    uint8_t             data[];   // stride bytes
+};
+
+// Smallest power of two >= v, floor of 2. Returns 0 on overflow (v > 2^31).
+static uint32_t next_pow2_u32(uint32_t v)
+{
+    if (v < 2u) return 2u;
+    v--;
+    v |= v >> 1; v |= v >> 2; v |= v >> 4; v |= v >> 8; v |= v >> 16;
+    return v + 1u; // wraps to 0 if v was > 2^31
+}
+
+
+/* SPSC ring */
+
+bool ano_spsc_init(AnoSpscRing *ring, mi_heap_t *heap, uint32_t capacity_pow2, uint32_t stride)
+{
+    if (!ring || !heap || stride == 0u) return false;
+
+    uint32_t cap = next_pow2_u32(capacity_pow2);
+    if (cap == 0u) return false;                       // capacity overflow
+    if ((size_t)cap > SIZE_MAX / stride) return false; // cap*stride overflow
+
+    uint8_t *buffer = mi_heap_calloc(heap, cap, stride);
+    if (!buffer) return false;
+
+    atomic_init(&ring->tail, 0u);
+    atomic_init(&ring->head, 0u);
+    ring->mask   = cap - 1u;
+    ring->stride = stride;
+    ring->buffer = buffer;
+    return true;
+}
+
+void ano_spsc_destroy(AnoSpscRing *ring)
+{
+    if (!ring) return;
+    if (ring->buffer) {
+        mi_free(ring->buffer);
+        ring->buffer = NULL;
+    }
+    ring->mask   = 0u;
+    ring->stride = 0u;
+    atomic_store_explicit(&ring->head, 0u, memory_order_relaxed);
+    atomic_store_explicit(&ring->tail, 0u, memory_order_relaxed);
+}
+
+
+/* MPMC ring */
+
+bool ano_mpmc_init(AnoMpmcRing *ring, mi_heap_t *heap, uint32_t capacity_pow2, uint32_t stride)
+{
+    if (!ring || !heap || stride == 0u || stride > UINT32_MAX - 2u * sizeof(uint64_t)) return false;
+
+    uint32_t cap  = next_pow2_u32(capacity_pow2);
+    uint32_t cell = (uint32_t)((sizeof(uint64_t) + stride + 7u) & ~(size_t)7u);
+    if (cap == 0u) return false;
+    if ((size_t)cap > SIZE_MAX / cell) return false;
+
+    uint8_t *cells = mi_heap_malloc_aligned(heap, (size_t)cap * cell, ANO_CACHE_LINE);
+    if (!cells) return false;
+    // Cell i starts free for position i, lap 0.
+    for (uint32_t i = 0; i < cap; i++)
+        atomic_init((_Atomic uint64_t *)(cells + (size_t)i * cell), (uint64_t)i);
+
+    atomic_init(&ring->tail, 0u);
+    atomic_init(&ring->head, 0u);
+    ring->mask       = cap - 1u;
+    ring->stride     = stride;
+    ring->cellStride = cell;
+    ring->cells      = cells;
+    return true;
+}
+
+void ano_mpmc_destroy(AnoMpmcRing *ring)
+{
+    if (!ring) return;
+    if (ring->cells) {
+        mi_free(ring->cells);
+        ring->cells = NULL;
+    }
+    ring->mask       = 0u;
+    ring->stride     = 0u;
+    ring->cellStride = 0u;
+    atomic_store_explicit(&ring->head, 0u, memory_order_relaxed);
+    atomic_store_explicit(&ring->tail, 0u, memory_order_relaxed);
+}
+
+bool ano_stripe_init(AnoStripeQueue *queue, mi_heap_t *heap, uint32_t stripes_pow2, uint32_t stride,
+                     uint32_t stripe_bytes)
+{
+    if (!queue || !heap || stride == 0u || stripe_bytes > (1u << 20)) return false;
+
+    uint32_t bytes = stripe_bytes ? (stripe_bytes + ANO_CACHE_LINE - 1u) & ~(uint32_t)(ANO_CACHE_LINE - 1u)
+                                  : ANO_CACHE_LINE;
+    if (stride > bytes - sizeof(uint64_t)) return false;
+    uint32_t per = (uint32_t)((bytes - sizeof(uint64_t)) / stride);
+    if (per > ANO_STRIPE_COUNT_) return false;
+
+    uint32_t cap = next_pow2_u32(stripes_pow2);
+    if (cap == 0u) return false;
+    if ((size_t)cap > SIZE_MAX / bytes) return false;
+
+    uint8_t *stripes = mi_heap_malloc_aligned(heap, (size_t)cap * bytes, ANO_THREAD_LINE);
+    if (!stripes) return false;
+    // Stripe i starts free for position i, lap 0.
+    for (uint32_t i = 0; i < cap; i++)
+        atomic_init((_Atomic uint64_t *)(stripes + (size_t)i * bytes), (uint64_t)i << 8);
+
+    atomic_init(&queue->tail, 0u);
+    atomic_init(&queue->head, 0u);
+    queue->mask        = cap - 1u;
+    queue->stride      = stride;
+    queue->stripeBytes = bytes;
+    queue->perStripe   = per;
+    queue->stripes     = stripes;
+    return true;
+}
+
+void ano_stripe_destroy(AnoStripeQueue *queue)
+{
+    if (!queue) return;
+    if (queue->stripes) {
+        mi_free(queue->stripes);
+        queue->stripes = NULL;
+    }
+    queue->mask        = 0u;
+    queue->stride      = 0u;
+    queue->stripeBytes = 0u;
+    queue->perStripe   = 0u;
+    atomic_store_explicit(&queue->head, 0u, memory_order_relaxed);
+    atomic_store_explicit(&queue->tail, 0u, memory_order_relaxed);
+}
+
+
+/* Hazard pointers */
+
+#define HP_SLOTS        2u      // M&S needs two: the node read from, the node read next
+#define HP_RETIRE_FLOOR 64u     // scan threshold floor, amortizes a scan over many retires
+
+typedef struct hp_rec
+{
+    _Alignas(ANO_THREAD_LINE) void *_Atomic hp[HP_SLOTS];
+    atomic_bool    active;      // owned by a live thread (or a reclaim pass)
+    struct hp_rec *next;        // list link, immutable once published
+    void         **retired;     // owner only
+    uint32_t       nRetired, capRetired;
+} hp_rec;
+
+static hp_rec *_Atomic     g_hpList;
+static _Atomic uint32_t    g_hpRecs;
+static _Thread_local hp_rec *t_hp;
+static anothread_key_t     g_hpKey;
+static atomic_int          g_hpKeyState;   // 0 none (or creation failed: retried), 1 creating, 2 ready
+
+static int hp_cmp(const void *a, const void *b)
+{
+    uintptr_t x = *(const uintptr_t *)a, y = *(const uintptr_t *)b;
+    return x < y ? -1 : x > y;
+}
+
+// Free every retired node of `r` that no record publishes. r's owner only.
+static void hp_scan(hp_rec *r)
+{
+    if (r->nRetired == 0)
+        return;
+    // Pairs with the protectors' seq_cst publish: a pointer published before this fence is seen below,
+    // and one published after it fails its validation, because the node is already unlinked.
+    atomic_thread_fence(memory_order_seq_cst);
+
+    uintptr_t  local[64];
+    uint32_t   cap = atomic_load_explicit(&g_hpRecs, memory_order_acquire) * HP_SLOTS;
+    uintptr_t *hot = cap <= 64u ? local : mi_malloc((size_t)cap * sizeof *hot);
+    if (hot == NULL)
+        return;     // retry at the next threshold
+    uint32_t n = 0;
+    for (hp_rec *q = atomic_load_explicit(&g_hpList, memory_order_acquire); q != NULL && n < cap; q = q->next)
+        for (uint32_t i = 0; i < HP_SLOTS && n < cap; i++) {
+            void *p = atomic_load_explicit(&q->hp[i], memory_order_acquire);
+            if (p != NULL)
+                hot[n++] = (uintptr_t)p;
+        }
+    qsort(hot, n, sizeof *hot, hp_cmp);
+
+    uint32_t kept = 0;
+    for (uint32_t i = 0; i < r->nRetired; i++) {
+        uintptr_t p = (uintptr_t)r->retired[i];
+        if (n != 0 && bsearch(&p, hot, n, sizeof *hot, hp_cmp) != NULL)
+            r->retired[kept++] = r->retired[i];
+        else
+            mi_free(r->retired[i]);
+    }
+    r->nRetired = kept;
+    if (hot != local)
+        mi_free(hot);
+}
+
+// Thread key destructor: hand the record back. Leftover retired nodes stay with it.
+static void hp_release(void *arg)
+{
+    hp_rec *r = arg;
+    for (uint32_t i = 0; i < HP_SLOTS; i++)
+        atomic_store_explicit(&r->hp[i], NULL, memory_order_release);
+    hp_scan(r);
+    atomic_store_explicit(&r->active, false, memory_order_release);
+}
+
+// Creates the exit key once. False if it cannot be: no record may be claimed then, since nothing would
+// hand it back at thread exit. The state drops back to 0 so a later call retries.
+static bool hp_key_once(void)
+{
+    int state = atomic_load_explicit(&g_hpKeyState, memory_order_acquire);
+    while (state != 2) {
+        int none = 0;
+        if (atomic_compare_exchange_strong_explicit(&g_hpKeyState, &none, 1, memory_order_acq_rel,
+                                                    memory_order_acquire)) {
+            state = ano_thread_key_create(&g_hpKey, hp_release) == 0 ? 2 : 0;
+            atomic_store_explicit(&g_hpKeyState, state, memory_order_release);
+            return state == 2;
+        }
+        while ((state = atomic_load_explicit(&g_hpKeyState, memory_order_acquire)) == 1)
+            ano_thread_yield();
+        if (state == 0)
+            return false;   // the creator failed
+    }
+    return true;
+}
+
+// The calling thread's record, claimed on first use. NULL if the exit key or a new record cannot be had.
+static hp_rec *hp_acquire(void)
+{
+    if (t_hp != NULL)
+        return t_hp;
+    if (!hp_key_once())
+        return NULL;
+
+    hp_rec *r = NULL;
+    for (hp_rec *q = atomic_load_explicit(&g_hpList, memory_order_acquire); q != NULL; q = q->next) {
+        bool idle = false;
+        if (atomic_compare_exchange_strong_explicit(&q->active, &idle, true, memory_order_acq_rel,
+                                                    memory_order_relaxed)) {
+            r = q;
+            break;
+        }
+    }
+    if (r == NULL) {
+        r = mi_zalloc_aligned(sizeof *r, ANO_THREAD_LINE);
+        if (r == NULL)
+            return NULL;
+        atomic_init(&r->active, true);
+        atomic_fetch_add_explicit(&g_hpRecs, 1, memory_order_release);
+        hp_rec *head = atomic_load_explicit(&g_hpList, memory_order_relaxed);
+        do {
+            r->next = head;
+        } while (!atomic_compare_exchange_weak_explicit(&g_hpList, &head, r, memory_order_release,
+                                                        memory_order_relaxed));
+    }
+    ano_thread_setspecific(g_hpKey, r);
+    t_hp = r;
+    return r;
+}
+
+// Publish *src in slot `slot` and return it once it is known to still be there.
+static AnoMsqNode *hp_protect(hp_rec *r, uint32_t slot, AnoMsqNode *_Atomic *src)
+{
+    AnoMsqNode *p = atomic_load_explicit(src, memory_order_acquire);
+    for (;;) {
+        atomic_store_explicit(&r->hp[slot], p, memory_order_seq_cst);
+        AnoMsqNode *again = atomic_load_explicit(src, memory_order_seq_cst);
+        if (again == p)
+            return p;
+        p = again;
+    }
+}
+
+static void hp_clear(hp_rec *r)
+{
+    atomic_store_explicit(&r->hp[0], NULL, memory_order_release);
+    atomic_store_explicit(&r->hp[1], NULL, memory_order_release);
+}
+
+static void hp_retire(hp_rec *r, void *node)
+{
+    if (r->nRetired == r->capRetired) {
+        uint32_t ncap = r->capRetired ? r->capRetired * 2u : HP_RETIRE_FLOOR;
+        void **nr = mi_realloc(r->retired, (size_t)ncap * sizeof *nr);
+        if (nr == NULL) {
+            hp_scan(r);                             // make room in place
+            if (r->nRetired == r->capRetired)
+                return;                             // out of memory and all hot: leak the node
+        } else {
+            r->retired    = nr;
+            r->capRetired = ncap;
+        }
+    }
+    r->retired[r->nRetired++] = node;
+    uint32_t threshold = 2u * HP_SLOTS * atomic_load_explicit(&g_hpRecs, memory_order_relaxed) + HP_RETIRE_FLOOR;
+    if (r->nRetired >= threshold)
+        hp_scan(r);
+}
+
+
+/* Michael & Scott queue */
+
+bool ano_msq_init(AnoMsQueue *queue, uint32_t stride)
+{
+    if (!queue || stride == 0u || stride > UINT32_MAX - sizeof(AnoMsqNode)) return false;
+    AnoMsqNode *dummy = mi_malloc(sizeof(AnoMsqNode) + stride);
+    if (!dummy) return false;
+    atomic_init(&dummy->next, NULL);
+    atomic_init(&queue->head, dummy);
+    atomic_init(&queue->tail, dummy);
+    queue->stride = stride;
+    return true;
+}
+
+void ano_msq_destroy(AnoMsQueue *queue)
+{
+    if (!queue) return;
+    AnoMsqNode *n = atomic_load_explicit(&queue->head, memory_order_acquire);
+    while (n != NULL) {
+        AnoMsqNode *next = atomic_load_explicit(&n->next, memory_order_relaxed);
+        mi_free(n);
+        n = next;
+    }
+    atomic_store_explicit(&queue->head, NULL, memory_order_relaxed);
+    atomic_store_explicit(&queue->tail, NULL, memory_order_relaxed);
+    queue->stride = 0u;
+}
+
+bool ano_msq_push(AnoMsQueue *queue, const void *elem)
+{
+    hp_rec *r = hp_acquire();
+    AnoMsqNode *node = r != NULL ? mi_malloc(sizeof(AnoMsqNode) + queue->stride) : NULL;
+    if (node == NULL)
+        return false;
+    atomic_init(&node->next, NULL);
+    memcpy(node->data, elem, queue->stride);
+
+    for (;;) {
+        AnoMsqNode *tail = hp_protect(r, 0, &queue->tail);
+        AnoMsqNode *next = atomic_load_explicit(&tail->next, memory_order_acquire);
+        if (tail != atomic_load_explicit(&queue->tail, memory_order_acquire))
+            continue;
+        if (next != NULL) {     // tail lags: help it along, then retry
+            atomic_compare_exchange_weak_explicit(&queue->tail, &tail, next, memory_order_release,
+                                                  memory_order_relaxed);
+            continue;
+        }
+        AnoMsqNode *none = NULL;
+        if (atomic_compare_exchange_weak_explicit(&tail->next, &none, node, memory_order_release,
+                                                  memory_order_relaxed)) {
+            // Linked. Swinging tail may fail, someone already helped.
+            atomic_compare_exchange_strong_explicit(&queue->tail, &tail, node, memory_order_release,
+                                                    memory_order_relaxed);
+            break;
+        }
+    }
+    atomic_store_explicit(&r->hp[0], NULL, memory_order_release);
+    return true;
+}
+
+bool ano_msq_pop(AnoMsQueue *queue, void *out)
+{
+    hp_rec *r = hp_acquire();
+    if (r == NULL)
+        return false;
+
+    for (;;) {
+        AnoMsqNode *head = hp_protect(r, 0, &queue->head);
+        AnoMsqNode *tail = atomic_load_explicit(&queue->tail, memory_order_acquire);
+        AnoMsqNode *next = atomic_load_explicit(&head->next, memory_order_acquire);
+        atomic_store_explicit(&r->hp[1], next, memory_order_seq_cst);
+        // head still the dummy means next is still linked behind it, so next was not retired before
+        // hp[1] went up: it is only retired once head moves past it, which needs head to move first.
+        if (head != atomic_load_explicit(&queue->head, memory_order_seq_cst))
+            continue;
+        if (next == NULL) {
+            hp_clear(r);
+            return false;
+        }
+        if (head == tail) {     // tail lags behind a linked node: help it along
+            atomic_compare_exchange_weak_explicit(&queue->tail, &tail, next, memory_order_release,
+                                                  memory_order_relaxed);
+            continue;
+        }
+        if (atomic_compare_exchange_weak_explicit(&queue->head, &head, next, memory_order_acq_rel,
+                                                  memory_order_relaxed)) {
+            // next is the new dummy. hp[1] keeps it alive while its element is copied out.
+            memcpy(out, next->data, queue->stride);
+            hp_clear(r);
+            hp_retire(r, head);
+            return true;
+        }
+    }
+}
+
+void ano_msq_reclaim(void)
+{
+    if (t_hp != NULL)
+        hp_scan(t_hp);
+    // Exited threads' records: claim each idle one for the length of a scan.
+    for (hp_rec *q = atomic_load_explicit(&g_hpList, memory_order_acquire); q != NULL; q = q->next) {
+        bool idle = false;
+        if (q != t_hp && atomic_compare_exchange_strong_explicit(&q->active, &idle, true,
+                                                                 memory_order_acq_rel, memory_order_relaxed)) {
+            hp_scan(q);
+            atomic_store_explicit(&q->active, false, memory_order_release);
+        }
+    }
+}
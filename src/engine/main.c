@@ -12,9 +12,11 @@
 #include <string.h>
 #include <math.h>
 #include "anoptic_time.h"
+#include "anoptic_jobs.h"
 #include "anoptic_threads.h"
 #include "anoptic_filesystem.h"
 #include "anoptic_log_crash.h"   // anoptic_log.h + crash blackbox
+#include "anoptic_profiler.h"
 
 #ifndef HEADLESS_BUILD
 // Renderer contract + GLFW, graphical engine only.
@@ -246,17 +248,20 @@ static void ui_label(AnoUiBuilder* b, const AnoFontBake* bake, anostr_t text, fl
 	ano_ui_glyphs(b, lo, hi, first, n, white, ANO_UI_REF_NONE, 0);
 }
 
-// Builds + submits the menu block (or clears it). false == ring full, retry next tick.
-static bool submit_menu(AnoRenderBridge* bridge, const AnoFontBake* bake, const MenuLayout* m,
-                        bool visible, int hovered, uint32_t optionsCount)
+// Builds + submits the menu block (or clears it). Builder tables come from the tick's frame arena.
+// false == ring full (or frame arena exhausted), retry next tick.
+static bool submit_menu(AnoRenderBridge* bridge, ano_arena_t* frame, const AnoFontBake* bake,
+                        const MenuLayout* m, bool visible, int hovered, uint32_t optionsCount)
 {
 	if (!visible)
 		return ano_render_ui_clear(bridge, HUD_UI_MENU);
-	AnoUiPrim prims[24];
-	AnoUiPaint paints[2];
-	AnoUiStop stops[4];
-	uint32_t curves[128];
-	AnoGlyphInstance glyphs[HUD_UI_GCAP];
+	AnoUiPrim* prims = ano_arena_new(frame, AnoUiPrim, 24);
+	AnoUiPaint* paints = ano_arena_new(frame, AnoUiPaint, 2);
+	AnoUiStop* stops = ano_arena_new(frame, AnoUiStop, 4);
+	uint32_t* curves = ano_arena_new(frame, uint32_t, 128);
+	AnoGlyphInstance* glyphs = ano_arena_new(frame, AnoGlyphInstance, HUD_UI_GCAP);
+	if (!prims || !paints || !stops || !curves || !glyphs)
+		return false;
 	uint32_t gcount = 0;
 	AnoUiBuilder b;
 	ano_ui_builder_init(&b, prims, 24, NULL, 0, paints, 2, stops, 4);
@@ -320,10 +325,12 @@ static bool submit_menu(AnoRenderBridge* bridge, const AnoFontBake* bake, const
 }
 
 // Persistent status bar, bottom-left. Resubmitted when the logical viewport changes.
-static bool submit_bar(AnoRenderBridge* bridge, const AnoFontBake* bake, float vpH)
+static bool submit_bar(AnoRenderBridge* bridge, ano_arena_t* frame, const AnoFontBake* bake, float vpH)
 {
-	AnoUiPrim prims[8];
-	AnoGlyphInstance glyphs[HUD_UI_GCAP];
+	AnoUiPrim* prims = ano_arena_new(frame, AnoUiPrim, 8);
+	AnoGlyphInstance* glyphs = ano_arena_new(frame, AnoGlyphInstance, HUD_UI_GCAP);
+	if (!prims || !glyphs)
+		return false;
 	uint32_t gcount = 0;
 	AnoUiBuilder b;
 	ano_ui_builder_init(&b, prims, 8, NULL, 0, NULL, 0, NULL, 0);
@@ -346,10 +353,12 @@ static bool submit_bar(AnoRenderBridge* bridge, const AnoFontBake* bake, float v
 void* anoLogicThreadMain(void* arg)
 {
 	(void)arg;
+	ano_profile_thread_name("logic");
 	AnoRenderBridge* bridge = anoRenderBridge();
 
 	// Compose the scene (logic owns it now): geometry + scene lights + candle lights, emitted through the bridge.
 	spawn_scene(bridge);
+	ano_trace("logic: scene spawned");
 
 	// One-time HUD blocks (below the renderer's own profiling OSD), backpressure-retried.
 	const AnoFontBake* bake = anoRenderTextBake();
@@ -416,8 +425,16 @@ void* anoLogicThreadMain(void* arg)
 	float    vpW = 0.0f, vpH = 0.0f; // last-known logical viewport (RenderSnapshot)
 	float    barVpH = 0.0f;          // logical height the bar was last laid out for
 
+	// Per-tick assembly memory (UI builder tables, shaping buffers), reset at the top of every tick.
+	// What crosses to the renderer is copied into bridge-owned blocks, so nothing here outlives the tick.
+	ano_arena_t frame;
+	if (ano_arena_init(&frame, (size_t)64 << 20) != 0)
+		ano_log(ANO_ERROR, "Logic: frame arena reservation failed; HUD blocks will not build.");
+
 	while (!atomic_load(&g_logicShouldStop))
 	{
+		ano_profile_begin("logic.tick");
+		ano_arena_reset(&frame);
 		uint64_t now = ano_timestamp_us();
 
 		// Drain the render -> logic back-channel: input, picking, slot retirement (audit 4.11).
@@ -483,7 +500,7 @@ void* anoLogicThreadMain(void* arg)
 			case REVENT_SLOT_RETIRED:   break; // ECS id recycling lands with the real producer
 			case REVENT_BATCH_CONSUMED: break; // borrowed-batch ack, unused by this stand-in
 			case REVENT_CAPACITY:
-				ano_log(ANO_WARN, "Producer: back-channel saturated; some input samples were dropped.");
+				ano_log_ratelimit(ANO_WARN, 1, "Producer: back-channel saturated; some input samples were dropped.");
 				break;
 			}
 		}
@@ -532,7 +549,7 @@ void* anoLogicThreadMain(void* arg)
 		if (menuDirty && vpW > 0.0f) {
 			MenuLayout ml;
 			menu_layout(vpW, vpH, &ml);
-			if (submit_menu(bridge, bake, &ml, menuVisible, menuHovered, optionsCount))
+			if (submit_menu(bridge, &frame, bake, &ml, menuVisible, menuHovered, optionsCount))
 				menuDirty = false;
 		}
 
@@ -551,7 +568,7 @@ void* anoLogicThreadMain(void* arg)
 			}
 			// Status bar: resubmitted when the logical viewport height moves, retried per tick.
 			if ((!barSubmitted || barVpH != vpH) && vpH > 0.0f) {
-				barSubmitted = submit_bar(bridge, bake, vpH);
+				barSubmitted = submit_bar(bridge, &frame, bake, vpH);
 				if (barSubmitted)
 					barVpH = vpH;
 			}
@@ -566,17 +583,29 @@ void* anoLogicThreadMain(void* arg)
 					if (len > 0) {
 						const float camOrg[2] = { 24.0f, 210.0f };
 						const float mint[4] = { 0.45f, 0.95f, 0.6f, 1.0f };
-						uint32_t n = ano_text_shape(bake, anostr_view(cam, (size_t)len),
-						                            20.0f, camOrg, mint, hud, HUD_TEXT_CAP, NULL);
-						(void)hud_text_submit(bridge, HUD_TEXT_CAM, hud, n);
+						AnoGlyphInstance* inst = ano_arena_new(&frame, AnoGlyphInstance, HUD_TEXT_CAP);
+						if (inst != NULL) {
+							uint32_t n = ano_text_shape(bake, anostr_view(cam, (size_t)len),
+							                            20.0f, camOrg, mint, inst, HUD_TEXT_CAP, NULL);
+							(void)hud_text_submit(bridge, HUD_TEXT_CAM, inst, n);
+						}
 					}
 				}
 			}
 		}
+		ano_profile_end();
 		ano_sleep(2000); // ~2 ms logic tick
 	}
+	ano_arena_destroy(&frame);
 	return NULL;
 }
+
+// ano_memory_report_emit sink: the shutdown memory table, one log line per row.
+static void log_memory_line(void* ctx, const char* text)
+{
+	(void)ctx;
+	ano_log(ANO_INFO, "%s", text);
+}
 #endif // !HEADLESS_BUILD
 
 // Main function
@@ -597,10 +626,16 @@ int main()
     mi_option_enable(mi_option_show_errors);
     mi_option_enable(mi_option_show_stats);
     mi_option_enable(mi_option_verbose);
+    ano_memory_sample_every(256u << 10);  // one allocation-site sample per 256 KiB, per thread
     ano_debug_rlog(ANO_INFO, ANO_TERM | ANO_NOW, "Running in debug mode!");
 
     #endif
 
+    // ANO_PROFILE=1 records a Chrome trace of the session into the log directory. Declared before the
+    // logger so it is torn down after it: the log drainer is profiled and must be joined first.
+    bool wantProfile = getenv("ANO_PROFILE") != NULL;
+    int profAlive ANO_PROFILE_SCOPE_ATTR = wantProfile ? ano_profile_init() : -1;
+
     // Singleton logger for the whole of main (device selection, renderer init, the frame loop).
     // Cleans itself on scope exit.
     int logAlive ANO_LOG_SCOPE_ATTR = ano_log_init();
@@ -609,10 +644,39 @@ int main()
         return EXIT_FAILURE;
     }
 
+    // Frame threads never wait on a full ring for chatter: INFO drops (counted in the log), WARN spills
+    // to the larger second ring. ERROR and FATAL keep the blocking default and are never lost.
+    ano_log_set_overflow(ANO_INFO, ANO_LOG_DROP);
+    ano_log_set_overflow(ANO_WARN, ANO_LOG_SPILL);
+
+    if (wantProfile && profAlive != 0)
+        ano_log(ANO_WARN, "Profiler failed to start; no trace this session.");
+    else if (wantProfile)
+        ano_log(ANO_INFO, "Profiling into %s.", ano_profile_path());
+
     // Blackbox arms right after the logger: a fatal signal writes the CRASH log, then hail-mary flushes.
     if (ano_log_crash_init() != 0)
         ano_log(ANO_WARN, "Blackbox failed to arm; a crash will leave no CRASH log.");
 
+    // Flight recorder: milestones land in <logpath>/<stamp>_trace.ring and outlive even a SIGKILL.
+    // Torn down before the logger, after the logic thread is joined.
+    int traceAlive ANO_TRACE_SCOPE_ATTR = ano_trace_init();
+    if (traceAlive != 0)
+        ano_log(ANO_WARN, "Crash trace failed to map; no flight record this session.");
+
+    // Job pool: one pinned worker per core but one. Torn down after the logic thread is joined, before
+    // the trace and the logger, which jobs may still write to.
+    int jobsAlive ANO_JOBS_SCOPE_ATTR = ano_jobs_init(0, true);
+    if (jobsAlive != 0)
+        ano_log(ANO_WARN, "Job pool failed to start; jobs run inline on their submitter.");
+    else
+        ano_log(ANO_INFO, "Job pool up: %u workers.", ano_jobs_worker_count());
+
+    // Derived-data cache: cooked meshes, font bakes and decoded textures persist across runs
+    // under <userpath>/Cache, so an unchanged asset is processed once.
+    if (ano_fs_cache_configure(NULL, ANO_FS_CACHE_DEFAULT_LIMIT) != 0)
+        ano_log(ANO_WARN, "Derived-data cache unavailable; assets are processed on every load.");
+
     // Warn when the initial thread's stack budget (the environment's) is under ANO_THREAD_STACK_SIZE.
     size_t mainStack = ano_thread_main_stack();
     if (mainStack != 0 && mainStack < ANO_THREAD_STACK_SIZE)
@@ -630,6 +694,7 @@ int main()
         ano_log(ANO_FATAL, "Vulkan initialization failed.");
         return -1;
     }
+    ano_trace("main: vulkan up");
 
     // Logic/ECS master spun onto its own thread as the sole render-command producer.
     anothread_t logicThread;
@@ -642,18 +707,25 @@ int main()
 
     // Render loop (main thread): pump window events, then draw.
     // The logic thread feeds discrete ECS->render transitions concurrently.
+    ano_profile_thread_name("render");
     while (!anoShouldClose())
     {
         glfwPollEvents();
+        ano_profile_begin("render.frame");
         drawFrame();
+        ano_profile_end();
     }
 
     // Window closed: stop the producer FIRST and join it.
     // No submit can then race the bridge destruction in unInitVulkan().
+    ano_trace("main: window closed, joining logic");
     atomic_store(&g_logicShouldStop, true);
     ano_thread_join(logicThread, NULL);
 
     unInitVulkan();
+
+    // Per-subsystem live/peak bytes (and, in debug, the heaviest allocation sites) while the logger is up.
+    ano_memory_report_emit(log_memory_line, NULL);
 #else
     // Headless engine: no renderer. Console / server entry point.
     ano_rlog(ANO_INFO, ANO_TERM, "Anoptic Engine — headless console mode.");
@@ -0,0 +1,478 @@
+/* SPDX-FileCopyrightText: 2026 Anoptic Game Engine Authors
+ *
+ * SPDX-License-Identifier: LGPL-3.0 */
+/*  == Anoptic Game Engine v0.0000001 == */
+
+// Platform-agnostic derived-data cache over the file primitives. Contract in the public header.
+//
+// One file per entry, "<root>/<key as 32 hex digits>.anoc":
+//
+//     header  64 B   magic, format version, endian tag, the key
+//     payload        the caller's bytes, at offset 64 so a page-aligned map hands them out aligned
+//     trailer 32 B   payload size, payload checksum, end magic
+//
+// Writers stream into "<name>.<serial>.tmp" and rename over the entry, so readers see either the
+// old entry or the new one whole. There is no fsync: an entry torn by power loss fails its
+// checksum on the next get and is dropped, which is just a miss. The trailer carries the size and
+// checksum because the append-only writer cannot seek back to the header.
+//
+// LRU: an entry's last-write time is its last use (a hit touches it). Eviction lists the
+// directory, sorts by that stamp, and removes the oldest down to 7/8 of the cap, so a cache at
+// its limit does not rescan on every put. A temporary counts toward the total but is only evicted
+// once it is older than any live writer should be (CACHE_TMP_AGE_NS): a younger one may belong to a
+// writer in another thread or process that is about to rename it into place.
+
+#include "anoptic_filesystem.h"
+#include "filesystem/filesystem_internal.h"
+
+#include <anoptic_threads.h>
+#include <anoptic_time.h>
+
+#include <assert.h>    // static_assert
+#include <stdatomic.h>
+#include <stdio.h>     // snprintf, remove
+#include <stdlib.h>    // qsort
+#include <string.h>
+#include <mimalloc.h>
+
+#define CACHE_VERSION 1u
+#define CACHE_ENDIAN  0x01020304u
+#define CACHE_EXT     ".anoc"
+#define CACHE_TMP_AGE_NS (3600ull * 1000000000ull)   // a .tmp untouched this long is a crashed writer's
+
+typedef struct {
+    char     magic[8];     // "ANOCACHE"
+    uint32_t version;
+    uint32_t endian;
+    uint64_t keyLo, keyHi;
+    uint64_t reserved[4];
+} cache_header_t;
+
+typedef struct {
+    uint64_t payloadSize;
+    uint64_t payloadHash;
+    char     magic[8];     // "ANOCEND\0"
+    uint64_t reserved;
+} cache_trailer_t;
+
+static_assert(sizeof(cache_header_t) == 64, "the payload starts 64-byte aligned");
+static_assert(sizeof(cache_trailer_t) == 32, "fixed trailer");
+
+static const char k_headMagic[8] = { 'A', 'N', 'O', 'C', 'A', 'C', 'H', 'E' };
+static const char k_tailMagic[8] = { 'A', 'N', 'O', 'C', 'E', 'N', 'D', '\0' };
+
+// Cache state. g_root[0] == '\0' is off. g_used is the directory's byte total as of the last scan
+// plus puts since; it only decides when to rescan, the scan itself is exact.
+static anothread_mutex_t g_cacheLock = PTHREAD_MUTEX_INITIALIZER;
+static char              g_root[MAXPATH];
+static uint64_t          g_limit = ANO_FS_CACHE_DEFAULT_LIMIT;
+static uint64_t          g_used;
+static bool              g_usedKnown;
+static _Atomic uint64_t  g_tmpSerial;
+
+
+/* Hashing: four 64-bit lanes over 32-byte stripes, streamable. Keys take 128 bits of the final
+ * state, checksums 64. Not cryptographic: keys only have to be collision-free across one user's
+ * assets. */
+
+#define H_P1 0x9E3779B185EBCA87ull
+#define H_P2 0xC2B2AE3D27D4EB4Full
+#define H_P3 0x165667B19E3779F9ull
+#define H_P4 0x85EBCA77C2B2AE63ull
+#define H_P5 0x27D4EB2F165667C5ull
+
+typedef struct {
+    uint64_t lane[4];
+    uint64_t total;
+    uint8_t  buf[32];
+    uint32_t fill;
+} cache_hasher;
+
+static inline uint64_t rotl64(uint64_t x, int r)
+{
+    return (x << r) | (x >> (64 - r));
+}
+
+static inline uint64_t hash_round(uint64_t h, uint64_t w)
+{
+    return rotl64(h + w * H_P2, 31) * H_P1;
+}
+
+static inline uint64_t avalanche(uint64_t h)
+{
+    h ^= h >> 33;
+    h *= H_P2;
+    h ^= h >> 29;
+    h *= H_P3;
+    h ^= h >> 32;
+    return h;
+}
+
+static void hasher_init(cache_hasher *hs, uint64_t seedLo, uint64_t seedHi)
+{
+    hs->lane[0] = seedLo + H_P1 + H_P2;
+    hs->lane[1] = seedHi + H_P2;
+    hs->lane[2] = seedLo ^ H_P4;
+    hs->lane[3] = seedHi - H_P1;
+    hs->total = 0;
+    hs->fill = 0;
+}
+
+static inline void hasher_stripe(uint64_t lane[4], const uint8_t *p)
+{
+    for (int i = 0; i < 4; i++) {
+        uint64_t w;
+        memcpy(&w, p + 8 * i, 8);
+        lane[i] = hash_round(lane[i], w);
+    }
+}
+
+static void hasher_feed(cache_hasher *hs, const void *data, size_t size)
+{
+    const uint8_t *p = data;
+    hs->total += size;
+    if (hs->fill > 0) {
+        size_t take = 32u - hs->fill < size ? 32u - hs->fill : size;
+        memcpy(hs->buf + hs->fill, p, take);
+        hs->fill += (uint32_t)take;
+        p += take;
+        size -= take;
+        if (hs->fill < 32u)
+            return;
+        hasher_stripe(hs->lane, hs->buf);
+        hs->fill = 0;
+    }
+    for (; size >= 32u; p += 32, size -= 32u)
+        hasher_stripe(hs->lane, p);
+    memcpy(hs->buf, p, size);
+    hs->fill = (uint32_t)size;
+}
+
+static void hasher_final(const cache_hasher *hs, uint64_t *lo, uint64_t *hi)
+{
+    uint64_t l[4] = { hs->lane[0], hs->lane[1], hs->lane[2], hs->lane[3] };
+    uint32_t i = 0;
+    for (; i + 8u <= hs->fill; i += 8u) {
+        uint64_t w;
+        memcpy(&w, hs->buf + i, 8);
+        l[i / 8u] = hash_round(l[i / 8u], w);
+    }
+    uint64_t tail = 0;
+    memcpy(&tail, hs->buf + i, hs->fill - i);
+    l[3] = hash_round(l[3], tail ^ ((uint64_t)(hs->fill - i) << 56));
+
+    uint64_t a = rotl64(l[0], 1) + rotl64(l[1], 7) + rotl64(l[2], 12) + rotl64(l[3], 18);
+    uint64_t b = (l[0] ^ rotl64(l[2], 29)) + (l[1] ^ rotl64(l[3], 47)) * H_P5;
+    *lo = avalanche(a ^ hs->total * H_P4);
+    *hi = avalanche(b + hs->total + H_P3);
+}
+
+ano_fs_cache_key ano_fs_cache_key_begin(const char *tool, uint32_t version)
+{
+    ano_fs_cache_key key = { .lo = H_P5, .hi = H_P3 };
+    if (tool != NULL)
+        ano_fs_cache_key_add(&key, tool, strlen(tool));
+    ano_fs_cache_key_add(&key, &version, sizeof version);
+    return key;
+}
+
+void ano_fs_cache_key_add(ano_fs_cache_key *key, const void *data, size_t size)
+{
+    cache_hasher hs;
+    hasher_init(&hs, key->lo, key->hi);
+    hasher_feed(&hs, data, size);
+    hasher_final(&hs, &key->lo, &key->hi);
+}
+
+
+/* Paths. */
+
+// "<root>/<32 hex><suffix>" from a snapshot of the root. false when the cache is off or it does not fit.
+static bool entry_path(const ano_fs_cache_key *key, const char *suffix, char *out, size_t cap)
+{
+    char root[MAXPATH];
+    ano_mutex_lock(&g_cacheLock);
+    memcpy(root, g_root, sizeof root);
+    ano_mutex_unlock(&g_cacheLock);
+    if (root[0] == '\0')
+        return false;
+    int n = snprintf(out, cap, "%s/%016llx%016llx%s", root, (unsigned long long)key->hi,
+                     (unsigned long long)key->lo, suffix);
+    return n > 0 && (size_t)n < cap;
+}
+
+static bool has_suffix(const char *name, const char *suffix)
+{
+    size_t n = strlen(name), s = strlen(suffix);
+    return n >= s && memcmp(name + n - s, suffix, s) == 0;
+}
+
+
+/* Eviction. Caller holds g_cacheLock. */
+
+typedef struct {
+    char     name[64];
+    uint64_t size;
+    uint64_t stamp;
+} cache_file;
+
+typedef struct {
+    cache_file *v;
+    size_t      count, cap;
+    uint64_t    total;
+    uint64_t    tmpCutoff;  // temporaries stamped after this may still be in flight
+} cache_scan;
+
+// fs_dir_fn: collects our entries and abandoned temporaries, counts in-flight temporaries without
+// making them evictable, ignores anything else in the directory.
+static void scan_one(void *ctx, const char *name, uint64_t size, uint64_t stamp)
+{
+    cache_scan *s = ctx;
+    bool tmp = has_suffix(name, ".tmp");
+    if (strlen(name) >= sizeof s->v[0].name || !(has_suffix(name, CACHE_EXT) || tmp))
+        return;
+    s->total += size;
+    if (tmp && stamp > s->tmpCutoff)
+        return;
+    if (s->count == s->cap) {
+        size_t cap = s->cap ? s->cap * 2u : 256u;
+        cache_file *v = mi_realloc(s->v, cap * sizeof *v);
+        if (v == NULL)
+            return;  // counted, just not evictable this pass
+        s->v = v;
+        s->cap = cap;
+    }
+    cache_file *f = &s->v[s->count++];
+    strcpy(f->name, name);
+    f->size = size;
+    f->stamp = stamp;
+}
+
+static int by_stamp(const void *a, const void *b)
+{
+    uint64_t x = ((const cache_file *)a)->stamp, y = ((const cache_file *)b)->stamp;
+    return (x > y) - (x < y);
+}
+
+static void trim_locked(void)
+{
+    uint64_t now = fs_stamp_now();
+    cache_scan s = { .tmpCutoff = now > CACHE_TMP_AGE_NS ? now - CACHE_TMP_AGE_NS : 0 };
+    if (fs_list_dir(g_root, scan_one, &s) != 0) {
+        mi_free(s.v);
+        return;
+    }
+    uint64_t target = g_limit - g_limit / 8u;
+    if (s.total > g_limit) {
+        qsort(s.v, s.count, sizeof *s.v, by_stamp);
+        char path[MAXPATH * 2];
+        for (size_t i = 0; i < s.count && s.total > target; i++) {
+            if (snprintf(path, sizeof path, "%s/%s", g_root, s.v[i].name) < (int)sizeof path
+                && remove(path) == 0)
+                s.total -= s.v[i].size;
+        }
+    }
+    mi_free(s.v);
+    g_used = s.total;
+    g_usedKnown = true;
+}
+
+// A new entry of `bytes` landed: rescan once the running total crosses the cap.
+static void account(uint64_t bytes)
+{
+    ano_mutex_lock(&g_cacheLock);
+    if (g_root[0] != '\0') {
+        g_used += bytes;
+        if (!g_usedKnown || g_used > g_limit)
+            trim_locked();
+    }
+    ano_mutex_unlock(&g_cacheLock);
+}
+
+int ano_fs_cache_configure(const char *root, uint64_t limitBytes)
+{
+    char dir[MAXPATH];
+    if (root == NULL) {
+        ano_fspath user = ano_fs_userpath();
+        if (user.length == 0 || snprintf(dir, sizeof dir, "%s/Cache", user.str) >= (int)sizeof dir)
+            dir[0] = '\0';
+    } else if (snprintf(dir, sizeof dir, "%s", root) >= (int)sizeof dir) {
+        dir[0] = '\0';
+    }
+    bool ok = dir[0] != '\0' && fs_mkdir(dir) == 0;
+
+    ano_mutex_lock(&g_cacheLock);
+    if (ok)
+        memcpy(g_root, dir, sizeof g_root);
+    else
+        g_root[0] = '\0';
+    g_limit = limitBytes ? limitBytes : ANO_FS_CACHE_DEFAULT_LIMIT;
+    g_used = 0;
+    g_usedKnown = false;
+    if (ok)
+        trim_locked();
+    ano_mutex_unlock(&g_cacheLock);
+    return ok ? 0 : -1;
+}
+
+
+/* Lookup. */
+
+static uint64_t payload_hash(const ano_fs_cache_key *key, const void *data, size_t size)
+{
+    cache_hasher hs;
+    uint64_t lo, hi;
+    hasher_init(&hs, key->lo, key->hi);
+    hasher_feed(&hs, data, size);
+    hasher_final(&hs, &lo, &hi);
+    return lo;
+}
+
+static bool entry_ok(const ano_fs_cache_key *key, const uint8_t *map, size_t size)
+{
+    if (size < sizeof(cache_header_t) + sizeof(cache_trailer_t))
+        return false;
+    cache_header_t h;
+    cache_trailer_t t;
+    memcpy(&h, map, sizeof h);
+    memcpy(&t, map + size - sizeof t, sizeof t);
+    size_t payload = size - sizeof h - sizeof t;
+    return memcmp(h.magic, k_headMagic, sizeof h.magic) == 0 && h.version == CACHE_VERSION
+        && h.endian == CACHE_ENDIAN && h.keyLo == key->lo && h.keyHi == key->hi
+        && memcmp(t.magic, k_tailMagic, sizeof t.magic) == 0 && t.payloadSize == payload
+        && t.payloadHash == payload_hash(key, map + sizeof h, payload);
+}
+
+bool ano_fs_cache_get(const ano_fs_cache_key *key, ano_fs_cache_blob *blob)
+{
+    if (blob == NULL)
+        return false;
+    memset(blob, 0, sizeof *blob);
+    char path[MAXPATH + 48];
+    if (key == NULL || !entry_path(key, CACHE_EXT, path, sizeof path))
+        return false;
+
+    size_t size = 0;
+    const uint8_t *map = ano_fs_map_read(path, &size);
+    if (map == NULL)
+        return false;
+    if (!entry_ok(key, map, size)) {
+        ano_fs_unmap(map, size);
+        remove(path);  // damaged (torn write, bad sector): drop it so the next put rewrites it
+        return false;
+    }
+    fs_touch(path);  // the LRU clock; a failed touch only ages the entry early
+
+    blob->data = map + sizeof(cache_header_t);
+    blob->size = size - sizeof(cache_header_t) - sizeof(cache_trailer_t);
+    blob->map = map;
+    blob->mapSize = size;
+    return true;
+}
+
+void ano_fs_cache_release(ano_fs_cache_blob *blob)
+{
+    if (blob == NULL || blob->map == NULL)
+        return;
+    ano_fs_unmap(blob->map, blob->mapSize);
+    memset(blob, 0, sizeof *blob);
+}
+
+
+/* Store. */
+
+struct ano_fs_cache_writer {
+    ano_file        *file;
+    ano_fs_cache_key key;
+    cache_hasher     hash;
+    uint64_t         size;
+    bool             failed;
+    char             tmp[MAXPATH + 48];
+    char             path[MAXPATH + 48];
+};
+
+ano_fs_cache_writer *ano_fs_cache_put_begin(const ano_fs_cache_key *key)
+{
+    if (key == NULL)
+        return NULL;
+    ano_fs_cache_writer *w = mi_malloc(sizeof *w);
+    if (w == NULL)
+        return NULL;
+    // Temporaries are unique per writer: same-key writers in two threads or processes never share one.
+    char suffix[48];
+    uint64_t serial = atomic_fetch_add_explicit(&g_tmpSerial, 1, memory_order_relaxed);
+    snprintf(suffix, sizeof suffix, ".%08llx%08llx.tmp",
+             (unsigned long long)(ano_timestamp_ticks() & 0xFFFFFFFFu), (unsigned long long)(serial & 0xFFFFFFFFu));
+    if (!entry_path(key, CACHE_EXT, w->path, sizeof w->path) || !entry_path(key, suffix, w->tmp, sizeof w->tmp)) {
+        mi_free(w);
+        return NULL;
+    }
+    w->file = ano_fs_open_trunc(w->tmp);
+    if (w->file == NULL) {
+        mi_free(w);
+        return NULL;
+    }
+    w->key = *key;
+    w->size = 0;
+    hasher_init(&w->hash, key->lo, key->hi);
+
+    cache_header_t h = { .version = CACHE_VERSION, .endian = CACHE_ENDIAN, .keyLo = key->lo, .keyHi = key->hi };
+    memcpy(h.magic, k_headMagic, sizeof h.magic);
+    w->failed = ano_fs_write(w->file, &h, sizeof h) != 0;
+    return w;
+}
+
+int ano_fs_cache_put_write(ano_fs_cache_writer *writer, const void *data, size_t size)
+{
+    if (writer == NULL || writer->failed)
+        return -1;
+    if (size == 0)
+        return 0;
+    if (data == NULL || ano_fs_write(writer->file, data, size) != 0) {
+        writer->failed = true;
+        return -1;
+    }
+    hasher_feed(&writer->hash, data, size);
+    writer->size += size;
+    return 0;
+}
+
+int ano_fs_cache_put_end(ano_fs_cache_writer *writer, bool commit)
+{
+    if (writer == NULL)
+        return -1;
+    bool ok = commit && !writer->failed;
+    uint64_t bytes = sizeof(cache_header_t) + writer->size + sizeof(cache_trailer_t);
+    if (ok) {
+        uint64_t lo, hi;
+        hasher_final(&writer->hash, &lo, &hi);
+        cache_trailer_t t = { .payloadSize = writer->size, .payloadHash = lo };
+        memcpy(t.magic, k_tailMagic, sizeof t.magic);
+        ok = ano_fs_write(writer->file, &t, sizeof t) == 0;
+    }
+    if (ano_fs_close(writer->file) != 0)
+        ok = false;
+
+    if (ok) {
+        ano_mutex_lock(&g_cacheLock);
+        ok = bytes <= g_limit;  // an entry over the cap would only evict everything, itself included
+        ano_mutex_unlock(&g_cacheLock);
+    }
+    if (ok && ano_fs_replace(writer->tmp, writer->path) != 0)
+        ok = false;
+    if (!ok)
+        remove(writer->tmp);
+    else
+        account(bytes);
+    mi_free(writer);
+    return ok || !commit ? 0 : -1;
+}
+
+int ano_fs_cache_put(const ano_fs_cache_key *key, const void *data, size_t size)
+{
+    ano_fs_cache_writer *w = ano_fs_cache_put_begin(key);
+    if (w == NULL)
+        return -1;
+    int rc = ano_fs_cache_put_write(w, data, size);
+    return ano_fs_cache_put_end(w, rc == 0) == 0 && rc == 0 ? 0 : -1;
+}
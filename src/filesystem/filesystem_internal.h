@@ -3,13 +3,30 @@
  * SPDX-License-Identifier: LGPL-3.0 */
 /*  == Anoptic Game Engine v0.0000001 == */
 
-// Private module header: per-platform primitives for the common TU (filesystem.c).
+// Private module header: per-platform primitives for the common TUs (filesystem.c, filesystem_cache.c).
 
 #ifndef FILESYSTEM_INTERNAL_H
 #define FILESYSTEM_INTERNAL_H
 
+#include <stdint.h>
+
 // Create `path` as a directory if absent (mkdir / _mkdir). Parents must already exist.
 // Output: 0 when the directory exists afterward, -1 on failure.
 int fs_mkdir(const char *path);
 
+// One regular file of a directory listing: its name (no directory), byte size, and last-write
+// time in nanoseconds since the Unix epoch, on the clock fs_stamp_now reads.
+typedef void (*fs_dir_fn)(void *ctx, const char *name, uint64_t size, uint64_t stamp);
+
+// Call fn for every regular file directly inside `dir` (no recursion, no "." or "..").
+// Output: 0 once the whole directory was walked, -1 if it could not be opened.
+int fs_list_dir(const char *dir, fs_dir_fn fn, void *ctx);
+
+// Output: the current wall-clock time in fs_list_dir's stamp units.
+uint64_t fs_stamp_now(void);
+
+// Set `path`'s last-write time to now (utimensat / SetFileTime). The cache's LRU clock.
+// Output: 0 on success, -1 on error.
+int fs_touch(const char *path);
+
 #endif // FILESYSTEM_INTERNAL_H
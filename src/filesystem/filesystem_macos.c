@@ -10,12 +10,15 @@
 
 #include <mach-o/dyld.h>   // _NSGetExecutablePath
 #include <unistd.h>        // chdir, write, fsync, close
-#include <stdio.h>         // snprintf
+#include <stdio.h>         // snprintf, rename
 #include <stdlib.h>        // realpath, getenv
 #include <string.h>        // strlen, memcpy
 #include <limits.h>        // PATH_MAX
 #include <fcntl.h>         // open, O_*
-#include <sys/stat.h>      // mkdir
+#include <sys/stat.h>      // mkdir, fstat, stat, utimensat
+#include <dirent.h>        // opendir, readdir
+#include <sys/mman.h>      // mmap, munmap
+#include <time.h>          // clock_gettime
 #include <errno.h>         // errno, EINTR, EEXIST
 #include <mimalloc.h>
 
@@ -85,6 +88,43 @@ int fs_mkdir(const char *path)
     return (mkdir(path, 0755) == 0 || errno == EEXIST) ? 0 : -1;
 }
 
+// Output: 0 once the walk completes, -1 if `dir` cannot be opened. Entries that vanish between
+// readdir and stat (a concurrent eviction) are skipped.
+int fs_list_dir(const char *dir, fs_dir_fn fn, void *ctx)
+{
+    DIR *d = opendir(dir);
+    if (d == NULL)
+        return -1;
+    char path[MAXPATH * 2];
+    struct dirent *e;
+    while ((e = readdir(d)) != NULL) {
+        if (e->d_name[0] == '.' && (e->d_name[1] == '\0' || (e->d_name[1] == '.' && e->d_name[2] == '\0')))
+            continue;
+        struct stat st;
+        if (snprintf(path, sizeof path, "%s/%s", dir, e->d_name) >= (int)sizeof path
+            || stat(path, &st) != 0 || !S_ISREG(st.st_mode))
+            continue;
+        uint64_t stamp = (uint64_t)st.st_mtimespec.tv_sec * 1000000000u + (uint64_t)st.st_mtimespec.tv_nsec;
+        fn(ctx, e->d_name, (uint64_t)st.st_size, stamp);
+    }
+    closedir(d);
+    return 0;
+}
+
+// Output: CLOCK_REALTIME in nanoseconds, the clock st_mtimespec stamps are on.
+uint64_t fs_stamp_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+// Output: 0 on success, -1 on error. NULL times == now, at the filesystem's resolution.
+int fs_touch(const char *path)
+{
+    return utimensat(AT_FDCWD, path, NULL, 0) == 0 ? 0 : -1;
+}
+
 
 /* Append-only file sink (POSIX). The opaque handle wraps a single file descriptor. */
 
@@ -169,4 +209,43 @@ int ano_fs_close(ano_file *file)
     return rc;
 }
 
+
+/* Replace and read-only mapping. */
+
+// Output: 0 on success, -1 on error. rename(2) is atomic over an existing `to`.
+int ano_fs_replace(const char *from, const char *to)
+{
+    if (from == NULL || to == NULL)
+        return -1;
+    return rename(from, to) == 0 ? 0 : -1;
+}
+
+// Output: mapped base, or NULL on failure. The descriptor closes at once; the mapping holds the file.
+const void *ano_fs_map_read(const char *path, size_t *size)
+{
+    if (path == NULL || size == NULL)
+        return NULL;
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return NULL;
+    struct stat st;
+    void *base = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && st.st_size > 0)
+        base = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED)
+        return NULL;
+    *size = (size_t)st.st_size;
+    return base;
+}
+
+// Output: 0 on success, -1 on error.
+int ano_fs_unmap(const void *base, size_t size)
+{
+    if (base == NULL)
+        return -1;
+    return munmap((void *)base, size) == 0 ? 0 : -1;
+}
+
 #endif // __APPLE__
@@ -13,7 +13,7 @@
 #include <string.h>       // memcpy
 #include <direct.h>       // _chdir, _mkdir
 #include <errno.h>        // errno, EEXIST
-#include <windows.h>      // CreateFileA, WriteFile, FlushFileBuffers, CloseHandle
+#include <windows.h>      // CreateFileA, WriteFile, FlushFileBuffers, CloseHandle, MapViewOfFile, FindFirstFileA
 #include <libloaderapi.h>
 #include <mimalloc.h>
 
@@ -76,6 +76,55 @@ int fs_mkdir(const char *path)
     return (_mkdir(path) == 0 || errno == EEXIST) ? 0 : -1;
 }
 
+// FILETIME (100 ns ticks since 1601) to nanoseconds since the Unix epoch.
+static uint64_t stamp_from_filetime(FILETIME ft)
+{
+    uint64_t t = (uint64_t)ft.dwHighDateTime << 32 | ft.dwLowDateTime;
+    return t > 116444736000000000ull ? (t - 116444736000000000ull) * 100u : 0;
+}
+
+// Output: 0 once the walk completes, -1 if `dir` cannot be opened.
+int fs_list_dir(const char *dir, fs_dir_fn fn, void *ctx)
+{
+    char pattern[MAXPATH + 4];
+    if (snprintf(pattern, sizeof pattern, "%s\\*", dir) >= (int)sizeof pattern)
+        return -1;
+    WIN32_FIND_DATAA fd;
+    HANDLE find = FindFirstFileA(pattern, &fd);
+    if (find == INVALID_HANDLE_VALUE)
+        return -1;
+    do {
+        if (fd.dwFileAttributes & (FILE_ATTRIBUTE_DIRECTORY | FILE_ATTRIBUTE_DEVICE))
+            continue;
+        uint64_t size = (uint64_t)fd.nFileSizeHigh << 32 | fd.nFileSizeLow;
+        fn(ctx, fd.cFileName, size, stamp_from_filetime(fd.ftLastWriteTime));
+    } while (FindNextFileA(find, &fd));
+    FindClose(find);
+    return 0;
+}
+
+// Output: the system time on the clock FindFirstFileA's write times are on.
+uint64_t fs_stamp_now(void)
+{
+    FILETIME now;
+    GetSystemTimeAsFileTime(&now);
+    return stamp_from_filetime(now);
+}
+
+// Output: 0 on success, -1 on error.
+int fs_touch(const char *path)
+{
+    HANDLE handle = CreateFileA(path, FILE_WRITE_ATTRIBUTES, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                                NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (handle == INVALID_HANDLE_VALUE)
+        return -1;
+    FILETIME now;
+    GetSystemTimeAsFileTime(&now);
+    BOOL ok = SetFileTime(handle, NULL, NULL, &now);
+    CloseHandle(handle);
+    return ok ? 0 : -1;
+}
+
 
 /* Append-only file sink (Win32). The opaque handle wraps a single file HANDLE. */
 
@@ -157,4 +206,50 @@ int ano_fs_close(ano_file *file)
     return rc;
 }
 
+
+/* Replace and read-only mapping. */
+
+// Output: 0 on success, -1 on error. Fails while `to` is mapped or open without FILE_SHARE_DELETE.
+int ano_fs_replace(const char *from, const char *to)
+{
+    if (from == NULL || to == NULL)
+        return -1;
+    return MoveFileExA(from, to, MOVEFILE_REPLACE_EXISTING) ? 0 : -1;
+}
+
+// Output: mapped base, or NULL on failure. The view keeps the section alive, so both handles
+// close at once and UnmapViewOfFile alone releases it.
+const void *ano_fs_map_read(const char *path, size_t *size)
+{
+    if (path == NULL || size == NULL)
+        return NULL;
+
+    HANDLE handle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, NULL,
+                                OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (handle == INVALID_HANDLE_VALUE)
+        return NULL;
+    LARGE_INTEGER bytes;
+    HANDLE mapping = NULL;
+    if (GetFileSizeEx(handle, &bytes) && bytes.QuadPart > 0)
+        mapping = CreateFileMappingA(handle, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(handle);
+    if (mapping == NULL)
+        return NULL;
+    const void *base = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (base == NULL)
+        return NULL;
+    *size = (size_t)bytes.QuadPart;
+    return base;
+}
+
+// Output: 0 on success, -1 on error.
+int ano_fs_unmap(const void *base, size_t size)
+{
+    (void)size;
+    if (base == NULL)
+        return -1;
+    return UnmapViewOfFile(base) ? 0 : -1;
+}
+
 #endif // _WIN32
\ No newline at end of file
@@ -0,0 +1,446 @@
+/* SPDX-FileCopyrightText: 2026 Anoptic Game Engine Authors
+ *
+ * SPDX-License-Identifier: LGPL-3.0 */
+/*  == Anoptic Game Engine v0.0000001 == */
+
+// Work-stealing job pool (anoptic_jobs.h).
+//
+// Deques are Chase-Lev (fixed capacity, Le et al. 2013 orderings): the owner pushes and takes at
+// `bottom`, thieves CAS `top`. A job is five words stored as relaxed atomics, so a thief that reads a
+// slot the owner is refilling a lap later races on nothing: its CAS on `top` fails and it drops the torn
+// copy. Non-pool threads submit to one AnoMpmcRing.
+//
+// Idle workers scan (own deque, injection ring, every other deque from a random start), yield for a
+// while, then sleep on a condition variable. Wakeups go through an epoch: a submitter bumps it after
+// queueing and signals only if someone sleeps, a worker samples it before its scan and sleeps only if
+// it has not moved. Both sides are seq_cst, so either the submitter sees the sleeper or the sleeper sees
+// the new epoch.
+
+#include <anoptic_jobs.h>
+#include <anoptic_collections.h>
+#include <anoptic_memory.h>
+#include <anoptic_profiler.h>
+#include <anoptic_threads.h>
+
+#include <stdint.h>
+#include <string.h>
+
+#include <mimalloc.h>
+
+#define DEQUE_CAP   4096u   // jobs per worker deque, a power of two
+#define INJECT_CAP  4096u   // jobs in the shared ring for non-pool threads
+#define MAX_WORKERS 256u
+#define IDLE_SCANS  64u     // empty scans before a worker sleeps
+#define SPLIT_BELOW 2       // parallel_for splits while its queue holds fewer jobs than this
+
+// A queued job. fn == NULL marks a parallel_for range: arg is its pfor_t, [begin, end) the indices.
+typedef struct job_t
+{
+    ano_job_fn     fn;
+    void          *arg;
+    AnoJobCounter *counter;
+    size_t         begin, end;
+} job_t;
+
+#define JOB_WORDS (sizeof(job_t) / sizeof(uintptr_t))
+_Static_assert(sizeof(job_t) == JOB_WORDS * sizeof(uintptr_t), "job_t must pack into slot words");
+
+typedef struct slot_t
+{
+    _Atomic uintptr_t w[JOB_WORDS];
+} slot_t;
+
+typedef struct deque_t
+{
+    _Alignas(ANO_THREAD_LINE) _Atomic int64_t top;    // thieves' end
+    _Alignas(ANO_THREAD_LINE) _Atomic int64_t bottom; // owner's end
+    _Alignas(ANO_THREAD_LINE) slot_t *slots;          // DEQUE_CAP
+} deque_t;
+
+typedef struct worker_t
+{
+    deque_t     deque;
+    anothread_t thread;
+    uint32_t    index;
+    bool        spawned;
+} worker_t;
+
+typedef struct pfor_t
+{
+    ano_range_fn body;
+    void        *ctx;
+    size_t       grain;
+} pfor_t;
+
+static _Atomic bool       g_running;
+static _Atomic bool       g_stop;
+static worker_t          *g_workers;      // immutable while running
+static uint32_t           g_workerCount;
+static bool               g_pin;
+static unsigned int       g_cores;
+static AnoMpmcRing        g_inject;
+static mi_heap_t         *g_heap;
+
+static anothread_mutex_t  g_sleepLock;
+static anothread_cond_t   g_sleepCond;
+static _Atomic uint32_t   g_sleepers;
+static _Atomic uint64_t   g_epoch;
+
+static _Thread_local int      t_worker = -1;
+static _Thread_local uint32_t t_rng;
+
+
+/* Chase-Lev deque */
+
+static inline void slot_write(slot_t *s, const job_t *job)
+{
+    uintptr_t w[JOB_WORDS];
+    memcpy(w, job, sizeof w);
+    for (size_t i = 0; i < JOB_WORDS; i++)
+        atomic_store_explicit(&s->w[i], w[i], memory_order_relaxed);
+}
+
+static inline void slot_read(slot_t *s, job_t *job)
+{
+    uintptr_t w[JOB_WORDS];
+    for (size_t i = 0; i < JOB_WORDS; i++)
+        w[i] = atomic_load_explicit(&s->w[i], memory_order_relaxed);
+    memcpy(job, w, sizeof w);
+}
+
+// OWNER only.
+static bool deque_push(deque_t *d, const job_t *job)
+{
+    int64_t b = atomic_load_explicit(&d->bottom, memory_order_relaxed);
+    int64_t t = atomic_load_explicit(&d->top, memory_order_acquire);
+    if (b - t >= (int64_t)DEQUE_CAP)
+        return false;
+    slot_write(&d->slots[(uint64_t)b & (DEQUE_CAP - 1u)], job);
+    atomic_store_explicit(&d->bottom, b + 1, memory_order_release);
+    return true;
+}
+
+// OWNER only. Newest first.
+static bool deque_take(deque_t *d, job_t *job)
+{
+    int64_t b = atomic_load_explicit(&d->bottom, memory_order_relaxed) - 1;
+    atomic_store_explicit(&d->bottom, b, memory_order_seq_cst);
+    int64_t t = atomic_load_explicit(&d->top, memory_order_seq_cst);
+    if (t > b) {
+        atomic_store_explicit(&d->bottom, b + 1, memory_order_relaxed);
+        return false;
+    }
+    slot_read(&d->slots[(uint64_t)b & (DEQUE_CAP - 1u)], job);
+    if (t == b) {
+        // The last job: race the thieves for it.
+        bool won = atomic_compare_exchange_strong_explicit(&d->top, &t, t + 1,
+                                                           memory_order_seq_cst, memory_order_relaxed);
+        atomic_store_explicit(&d->bottom, b + 1, memory_order_relaxed);
+        return won;
+    }
+    return true;
+}
+
+// Any thread. Oldest first. False when empty or when another thread won the race.
+static bool deque_steal(deque_t *d, job_t *job)
+{
+    int64_t t = atomic_load_explicit(&d->top, memory_order_seq_cst);
+    int64_t b = atomic_load_explicit(&d->bottom, memory_order_seq_cst);
+    if (t >= b)
+        return false;
+    slot_read(&d->slots[(uint64_t)t & (DEQUE_CAP - 1u)], job);
+    return atomic_compare_exchange_strong_explicit(&d->top, &t, t + 1,
+                                                   memory_order_seq_cst, memory_order_relaxed);
+}
+
+
+/* Scheduling */
+
+static inline uint32_t rng_next(void)
+{
+    uint32_t x = t_rng ? t_rng : (uint32_t)(uintptr_t)&t_rng | 1u;
+    x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+    return t_rng = x;
+}
+
+// Wake sleepers after queueing n jobs.
+static void wake(uint32_t n)
+{
+    atomic_fetch_add_explicit(&g_epoch, 1u, memory_order_seq_cst);
+    if (atomic_load_explicit(&g_sleepers, memory_order_seq_cst) == 0u)
+        return;
+    ano_mutex_lock(&g_sleepLock);
+    if (n > 1u) ano_thread_cond_broadcast(&g_sleepCond);
+    else        ano_thread_cond_signal(&g_sleepCond);
+    ano_mutex_unlock(&g_sleepLock);
+}
+
+// Queue on this thread's deque, or the injection ring off the pool. No wake.
+static bool job_push(const job_t *job)
+{
+    if (t_worker >= 0)
+        return deque_push(&g_workers[t_worker].deque, job);
+    return ano_mpmc_push(&g_inject, job);
+}
+
+// Jobs queued where this thread pushes. Approximate off the owner's thread.
+static int64_t local_backlog(void)
+{
+    if (t_worker >= 0) {
+        deque_t *d = &g_workers[t_worker].deque;
+        return atomic_load_explicit(&d->bottom, memory_order_relaxed)
+             - atomic_load_explicit(&d->top, memory_order_relaxed);
+    }
+    return (int64_t)(atomic_load_explicit(&g_inject.tail, memory_order_relaxed)
+                   - atomic_load_explicit(&g_inject.head, memory_order_relaxed));
+}
+
+static bool job_find(job_t *job)
+{
+    if (t_worker >= 0 && deque_take(&g_workers[t_worker].deque, job))
+        return true;
+    if (ano_mpmc_pop(&g_inject, job))
+        return true;
+    uint32_t n = g_workerCount, start = rng_next() % n;
+    for (uint32_t i = 0; i < n; i++) {
+        uint32_t v = (start + i) % n;
+        if ((int)v != t_worker && deque_steal(&g_workers[v].deque, job))
+            return true;
+    }
+    return false;
+}
+
+static void pfor_range(const pfor_t *pf, size_t begin, size_t end, AnoJobCounter *counter);
+
+static void job_exec(const job_t *job)
+{
+    if (job->fn)
+        job->fn(job->arg);
+    else
+        pfor_range(job->arg, job->begin, job->end, job->counter);
+    if (job->counter)
+        atomic_fetch_sub_explicit(&job->counter->pending, 1, memory_order_acq_rel);
+}
+
+static void *worker_main(void *p)
+{
+    worker_t *w = p;
+    t_worker = (int)w->index;
+    t_rng    = (w->index + 1u) * 2654435761u;
+    if (g_pin)
+        (void)ano_thread_pin_self((w->index + 1u) % g_cores);  // best effort
+    ano_profile_thread_name("job worker");
+
+    job_t job;
+    uint32_t idle = 0;
+    while (!atomic_load_explicit(&g_stop, memory_order_acquire)) {
+        uint64_t epoch = atomic_load_explicit(&g_epoch, memory_order_seq_cst);
+        if (job_find(&job)) {
+            job_exec(&job);
+            idle = 0;
+            continue;
+        }
+        if (++idle < IDLE_SCANS) {
+            ano_thread_yield();
+            continue;
+        }
+        ano_mutex_lock(&g_sleepLock);
+        atomic_fetch_add_explicit(&g_sleepers, 1u, memory_order_seq_cst);
+        if (atomic_load_explicit(&g_epoch, memory_order_seq_cst) == epoch &&
+            !atomic_load_explicit(&g_stop, memory_order_acquire))
+            ano_thread_cond_wait(&g_sleepCond, &g_sleepLock);
+        atomic_fetch_sub_explicit(&g_sleepers, 1u, memory_order_relaxed);
+        ano_mutex_unlock(&g_sleepLock);
+        idle = 0;
+    }
+    return NULL;
+}
+
+
+/* Lifecycle */
+
+// Stop and join whatever was spawned, free everything. Init's rollback and cleanup's body.
+static void pool_teardown(void)
+{
+    atomic_store_explicit(&g_stop, true, memory_order_seq_cst);
+    ano_mutex_lock(&g_sleepLock);
+    ano_thread_cond_broadcast(&g_sleepCond);
+    ano_mutex_unlock(&g_sleepLock);
+    for (uint32_t i = 0; i < g_workerCount; i++)
+        if (g_workers[i].spawned)
+            ano_thread_join(g_workers[i].thread, NULL);
+
+    for (uint32_t i = 0; i < g_workerCount; i++)
+        mi_free(g_workers[i].deque.slots);
+    mi_free(g_workers);
+    ano_mpmc_destroy(&g_inject);
+    mi_heap_destroy(g_heap);
+    ano_thread_cond_destroy(&g_sleepCond);
+    ano_mutex_destroy(&g_sleepLock);
+    g_workers     = NULL;
+    g_workerCount = 0;
+    g_heap        = NULL;
+}
+
+int ano_jobs_init(uint32_t workers, bool pin)
+{
+    if (atomic_load_explicit(&g_running, memory_order_acquire))
+        return -1;
+
+    g_cores = ano_thread_core_count();
+    if (workers == 0)
+        workers = g_cores > 1u ? g_cores - 1u : 1u;
+    if (workers > MAX_WORKERS)
+        workers = MAX_WORKERS;
+    g_pin = pin;
+
+    g_heap = mi_heap_new();
+    if (g_heap == NULL)
+        return -1;
+    if (!ano_mpmc_init(&g_inject, g_heap, INJECT_CAP, sizeof(job_t))) {
+        mi_heap_destroy(g_heap);
+        return -1;
+    }
+    g_workers = mi_heap_zalloc_aligned(g_heap, workers * sizeof *g_workers, ANO_THREAD_LINE);
+    if (g_workers == NULL) {
+        ano_mpmc_destroy(&g_inject);
+        mi_heap_destroy(g_heap);
+        return -1;
+    }
+    if (ano_mutex_init(&g_sleepLock, NULL) != 0) {
+        ano_mpmc_destroy(&g_inject);
+        mi_heap_destroy(g_heap);
+        return -1;
+    }
+    if (ano_thread_cond_init(&g_sleepCond, NULL) != 0) {
+        ano_mutex_destroy(&g_sleepLock);
+        ano_mpmc_destroy(&g_inject);
+        mi_heap_destroy(g_heap);
+        return -1;
+    }
+    atomic_store_explicit(&g_stop, false, memory_order_relaxed);
+    atomic_store_explicit(&g_sleepers, 0u, memory_order_relaxed);
+    g_workerCount = workers;
+
+    for (uint32_t i = 0; i < workers; i++) {
+        g_workers[i].index       = i;
+        g_workers[i].deque.slots = mi_heap_zalloc_aligned(g_heap, DEQUE_CAP * sizeof(slot_t), ANO_CACHE_LINE);
+        if (g_workers[i].deque.slots == NULL) {
+            pool_teardown();
+            return -1;
+        }
+    }
+    // Spawned through ano_thread_create: each worker arms its crash stack.
+    for (uint32_t i = 0; i < workers; i++) {
+        if (ano_thread_create(&g_workers[i].thread, NULL, worker_main, &g_workers[i]) != 0) {
+            pool_teardown();
+            return -1;
+        }
+        g_workers[i].spawned = true;
+    }
+    atomic_store_explicit(&g_running, true, memory_order_release);
+    return 0;
+}
+
+int ano_jobs_cleanup(void)
+{
+    if (!atomic_exchange_explicit(&g_running, false, memory_order_acq_rel))
+        return -1;
+    pool_teardown();
+    return 0;
+}
+
+void ano_jobs_scope_release(const int *initStatus)
+{
+    if (initStatus != NULL && *initStatus == 0)
+        ano_jobs_cleanup();
+}
+
+uint32_t ano_jobs_worker_count(void)
+{
+    return atomic_load_explicit(&g_running, memory_order_acquire) ? g_workerCount : 0u;
+}
+
+int ano_jobs_worker_index(void)
+{
+    return t_worker;
+}
+
+
+/* Submission and Waiting */
+
+void ano_jobs_run(const AnoJobDecl *jobs, uint32_t count, AnoJobCounter *counter)
+{
+    if (count == 0)
+        return;
+    if (counter)
+        atomic_fetch_add_explicit(&counter->pending, count, memory_order_relaxed);
+    bool running = atomic_load_explicit(&g_running, memory_order_acquire);
+    uint32_t queued = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        job_t job = { .fn = jobs[i].fn, .arg = jobs[i].arg, .counter = counter };
+        if (running && job_push(&job))
+            queued++;
+        else
+            job_exec(&job);     // stopped, or full: no room beats no progress
+    }
+    if (queued)
+        wake(queued);
+}
+
+void ano_jobs_wait(AnoJobCounter *counter)
+{
+    job_t job;
+    while (!ano_jobs_done(counter)) {
+        if (atomic_load_explicit(&g_running, memory_order_acquire) && job_find(&job))
+            job_exec(&job);
+        else
+            ano_thread_yield();
+    }
+}
+
+
+/* Parallel For */
+
+// Lazy binary splitting: hand the upper half to thieves only while this thread's queue is nearly
+// empty, else work through the range `grain` at a time and look again. Both halves and the tail stay
+// >= grain, so no chunk is smaller unless the whole range is.
+static void pfor_range(const pfor_t *pf, size_t begin, size_t end, AnoJobCounter *counter)
+{
+    while (end - begin >= 2 * pf->grain) {
+        if (local_backlog() < SPLIT_BELOW) {
+            size_t mid = begin + (end - begin) / 2;
+            job_t  half = { .fn = NULL, .arg = (void *)pf, .counter = counter, .begin = mid, .end = end };
+            atomic_fetch_add_explicit(&counter->pending, 1, memory_order_relaxed);
+            if (job_push(&half)) {
+                wake(1);
+                end = mid;
+                continue;
+            }
+            atomic_fetch_sub_explicit(&counter->pending, 1, memory_order_relaxed);
+        }
+        pf->body(pf->ctx, begin, begin + pf->grain);
+        begin += pf->grain;
+    }
+    if (begin < end)
+        pf->body(pf->ctx, begin, end);
+}
+
+void ano_parallel_for(size_t count, size_t grain, ano_range_fn body, void *ctx)
+{
+    if (count == 0)
+        return;
+    uint32_t threads = ano_jobs_worker_count() + 1u;
+    if (grain == 0) {
+        grain = count / (64u * (size_t)threads);
+        if (grain == 0) grain = 1;
+    }
+    if (threads == 1u || count / 2 < grain) {
+        body(ctx, 0, count);
+        return;
+    }
+    pfor_t pf = { .body = body, .ctx = ctx, .grain = grain };
+    AnoJobCounter counter = { 0 };
+    pfor_range(&pf, 0, count, &counter);
+    ano_jobs_wait(&counter);
+}
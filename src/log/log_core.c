@@ -8,12 +8,22 @@
 // ring continuously. ano_log_flush drains inline for callers needing records on disk now. NOW records
 // (FATAL by default) write straight through. Sink bits ride each record's tag for per-record routing.
 // Console output flushes at the end of every drain pass and immediate write.
-// A full ring makes the producer wait for room, never dropping. Stop all producers before ano_log_cleanup.
+// A full ring makes the producer wait for room by default. Per level it may instead drop the record (counted,
+// reported at the next drain) or spill into a larger second ring. Stop all producers before ano_log_cleanup.
+// Lanes mode swaps the shared reserve for one SPSC lane per producer thread (plain-store reserve), and the
+// drainer k-way merges the lanes by raw tick timestamp up to a per-pass watermark. Binary format writes
+// capture blobs raw with a per-file string table (log_format.h), rendering only console echoes.
+// Structured records (ano_log_kv) ride the ring as a typed key/value blob, rendered at drain like a
+// capture, and optionally feed one CSV per event (log_kv.c).
 
 #include "log/log_ring.h"
+#include "log/log_format.h"
+#include "log/log_kv.h"
+#include "threads/thread_lanes.h"
 
 #include <anoptic_threads.h>
 #include <anoptic_filesystem.h>
+#include <anoptic_profiler.h>
 #include <anoptic_time.h>
 
 #include <mimalloc.h>
@@ -36,9 +46,7 @@
 
 /* Internal state. Only the ring is producer-shared, the rest is cold. */
 
-// Level names padded to 5.
-static const char   logPad[4][8] = {"INFO ", "WARN ", "ERROR", "FATAL"};
-
+ano_mem_tag_t g_logMem = ANO_MEM_TAG("log");
 static log_ring_t   g_ring;         // the shared MPSC ring (producers: tail, consumer: head)
 static atomic_bool  g_initialized;  // NOW-path liveness (cold path only)
 // Severity gate and liveness in one relaxed load on enqueue. INT_MAX until init and at cleanup.
@@ -73,6 +81,44 @@ static anothread_cond_t  g_wakeCv;
 static atomic_bool       g_drainerParked;
 #define DRAIN_PARK_US     1000u     // park cap: worst-case emission delay on a lost wakeup
 
+// Lanes mode, latched at init from g_mode. Lanes live in a thread_lanes_t (threads/thread_lanes.h, shared
+// with the profiler): allocated on a thread's first record, published to the drainer by the release bump
+// of its count, adopted by a later thread once retired and drained. The gate bumps its gen per session, so
+// a thread-local lane from an earlier one is never reused. Threads past ANO_LOG_LANES_MAX keep t_lane NULL
+// and share g_ring, which the merge treats as one more source.
+static _Atomic int        g_mode = ANO_LOG_SHARED;
+static bool               g_lanesOn;
+static void              *g_laneSlots[ANO_LOG_LANES_MAX];
+static thread_lanes_t     g_lanes = { .slots = g_laneSlots, .cap = ANO_LOG_LANES_MAX };
+static _Thread_local log_lane_t *t_lane;
+static _Thread_local uint32_t    t_laneGen;
+
+// Overflow policy per level (ano_log_set_overflow), read by a producer that finds its ring full. DROP
+// counts into g_dropped, which the drainer swaps to zero and reports at the end of its next pass. SPILL
+// reserves in g_spill and raises SPILL_ACTIVE in its tail. While the bit is up every record, any level or
+// lane, follows into g_spill, so nothing logged after a spilled record lands in a ring that drains ahead
+// of it. The drainer drops the bit once g_spill runs empty (spill_settle).
+static _Atomic uint8_t    g_overflow[4];        // ANO_LOG_BLOCK
+static _Atomic uint64_t   g_dropped[4];
+static log_ring_t         g_spill;
+static ano_arena_t        g_ringArena;          // backs g_ring and g_spill: huge pages, the init thread's node
+#define SPILL_ACTIVE      (1ull << 63)          // in g_spill.tail only, above any reachable position
+
+// Binary format, latched at init from g_format. g_strTab maps a format-string or source-file pointer to
+// its id in the current file (ids from 1, UINT32_MAX for a format too long to table). Drainer-private,
+// reset with each head. Heads are written under g_drainMtx, so a pass never straddles two files.
+typedef struct { const char *s; uint32_t id; } log_strent_t;
+static _Atomic int        g_format = ANO_LOG_TEXT;
+static bool               g_binOn;
+static log_strent_t      *g_strTab;
+static uint32_t           g_strCap, g_strCount, g_strIds;  // slots, slots used, ids issued
+#define STRTAB_INIT       1024u     // initial slots, a power of two, doubles at half load
+
+// Column export (ano_log_set_columns), latched at init. The files belong to log_kv.c, driven under
+// g_drainMtx.
+static atomic_bool        g_columns;
+static bool               g_kvOn;
+
 // Full-ring producer backoff: spin between head rechecks doubles MIN->MAX, snapping to MIN when head
 // advances. FULL_STALL_LIMIT frozen-head rechecks declares the consumer wedged, a catastrophic fallback.
 #define FULL_BACKOFF_MIN_NS 64u
@@ -91,8 +137,10 @@ static uint64_t     g_anchorTicks;
 static uint64_t     g_anchorUnixNs;
 
 // Drainer-private, touched only under g_drainMtx. g_scratch gathers a seam-straddling record. g_batch
-// holds a whole drain pass for one write. g_drainHMS caches "HH:MM:SS" per second.
+// holds a whole drain pass for one write. g_drainHMS caches "HH:MM:SS" per second. g_render holds a
+// binary pass's console echo or a capture that must go out as text.
 static char         g_scratch[ANO_LOG_MSG_MAX];
+static char         g_render[ANO_LOG_MSG_MAX];
 static char        *g_batch;
 static size_t       g_batchCap;
 static uint64_t     g_drainSec;
@@ -101,30 +149,6 @@ static bool         g_drainHMSValid;
 
 /* Formatting (eager, on the producer) */
 
-// Decimal of v at p, advance. No printf machinery.
-static inline char *put_u32(char *p, uint32_t v)
-{
-    char tmp[10];
-    int i = 0;
-    do { tmp[i++] = (char)('0' + v % 10); v /= 10; } while (v);
-    while (i) *p++ = tmp[--i];
-    return p;
-}
-
-static const char digLo[] = "0123456789abcdef";
-static const char digUp[] = "0123456789ABCDEF";
-
-// Unsigned v in base (8/10/16) via digits, into [p,end). NULL if it would overrun.
-static char *put_base(char *p, char *end, unsigned long long v, unsigned base, const char *digits)
-{
-    char tmp[24];
-    int  i = 0;
-    do { tmp[i++] = digits[v % base]; v /= base; } while (v);
-    if (p + i > end) return NULL;
-    while (i) *p++ = tmp[--i];
-    return p;
-}
-
 // Hand-rolled formatter for the flagless common conversions (d i u x X o c s, l/ll/z/t/h length mods).
 // Returns bytes written, or -1 to fall back to vsnprintf for anything else (flags, width, precision,
 // floats, %p, unknown, overrun). Matches printf byte-for-byte for what it accepts.
@@ -217,7 +241,7 @@ static int format_line(char *out, int cap, ano_loglevel_t level,
 // precision as an int, then the value (int/long/long long, unsigned forms, double, char, void*, or a
 // NUL-terminated string copy). Returns blob length, or -1 to bail to eager for %n, a long-double 'L', or
 // a wide %lc/%ls. Stores raw values only, the actual formatting happens at drain.
-static int capture_deferred(char *out, int cap, const char *file, int line, const char *fmt, va_list ap)
+int log_capture_deferred(char *out, int cap, const char *file, int line, const char *fmt, va_list ap)
 {
     char *p = out, *end = out + cap;
     memcpy(p, &file, sizeof file); p += sizeof file;
@@ -279,117 +303,36 @@ static int capture_deferred(char *out, int cap, const char *file, int line, cons
     return (int)(p - out);
 }
 
-// Render a capture blob at drain: prefix (level/file/line) then the message. Re-parses fmt, rebuilds each
-// conversion's spec with any '*' resolved from the captured ints, and lets snprintf do the actual format
-// from the captured value. Byte-for-byte printf for everything capture_deferred accepts. Returns bytes.
-static int format_deferred(char *out, int cap, ano_loglevel_t level, const char *blob)
+// Structured capture: the KV blob (log_format.h) for up to ANO_LOG_KV_MAX fields. A string longer than the
+// room left is cut to fit, and a field that cannot fit at all ends the record there. Returns blob length.
+static int capture_kv(char *out, int cap, const char *event, const ano_logfield_t *fields, uint32_t count)
 {
-    const char *b = blob;
-    const char *file; memcpy(&file, b, sizeof file); b += sizeof file;
-    int line = 0;
-    if (file != NULL) { memcpy(&line, b, sizeof line); b += sizeof line; }
-    const char *fmt;  memcpy(&fmt,  b, sizeof fmt);  b += sizeof fmt;
-
     char *p = out, *end = out + cap;
-    memcpy(p, (unsigned)level <= ANO_FATAL ? logPad[level] : "?????", 5); p += 5;
-    *p++ = ' ';
-    if (file != NULL) {
-        size_t fl = strnlen(file, 256); memcpy(p, file, fl); p += fl;
-        *p++ = ':';
-        p = put_u32(p, (uint32_t)(line < 0 ? 0 : line));
-        *p++ = ':'; *p++ = ' '; *p++ = ' ';
-    }
-
-    for (const char *f = fmt; *f; ++f) {
-        if (*f != '%') { if (p < end) *p++ = *f; continue; }
-        ++f;
-        if (*f == '%') { if (p < end) *p++ = '%'; continue; }
-        // Fast plain path: % [l|ll|z|t|j](d i u o x X c s), no flags/width/precision/h. Hand-rolled, no
-        // spec build, no libc.
-        {
-            const char *g = f;
-            int plng = 0;
-            while (*g == 'l') { ++plng; ++g; }
-            if (*g == 'z' || *g == 't' || *g == 'j') { plng = 2; ++g; }
-            char pc = *g;
-            if ((pc=='d'||pc=='i'||pc=='u'||pc=='o'||pc=='x'||pc=='X'||pc=='c'||pc=='s') && end - p > 1) {
-                if (pc == 'd' || pc == 'i') {
-                    long long v;
-                    if (plng >= 1) { memcpy(&v, b, 8); b += 8; } else { int iv; memcpy(&iv, b, 4); b += 4; v = iv; }
-                    if (v < 0 && p < end) *p++ = '-';
-                    unsigned long long m = v < 0 ? 0ull - (unsigned long long)v : (unsigned long long)v;
-                    char *q = put_base(p, end, m, 10, digLo); if (q) p = q;
-                } else if (pc == 'c') {
-                    int iv; memcpy(&iv, b, 4); b += 4; if (p < end) *p++ = (char)iv;
-                } else if (pc == 's') {
-                    uint16_t sl; memcpy(&sl, b, 2); b += 2;
-                    if (p + sl <= end) { memcpy(p, b, sl); p += sl; } b += (size_t)sl + 1;
-                } else {
-                    unsigned long long v;
-                    if (plng >= 1) { memcpy(&v, b, 8); b += 8; } else { unsigned uv; memcpy(&uv, b, 4); b += 4; v = uv; }
-                    unsigned base = pc == 'o' ? 8u : pc == 'u' ? 10u : 16u;
-                    char *q = put_base(p, end, v, base, pc == 'X' ? digUp : digLo); if (q) p = q;
-                }
-                f = g;
-                continue;
-            }
-        }
-
-        // Fancy: flags/width/precision/'*'/h/float/%p. Rebuild the spec with '*' resolved, then snprintf.
-        char spec[48];
-        int  si = 0;
-        spec[si++] = '%';
-#define SPEC_PUT(ch) do { if (si < (int)sizeof spec - 2) spec[si++] = (ch); } while (0)
-        while (*f=='-'||*f=='+'||*f==' '||*f=='#'||*f=='0') SPEC_PUT(*f++);
-        if (*f == '*') {                                                             // width from arg
-            int w; memcpy(&w, b, 4); b += 4; ++f;
-            if (w < 0) { SPEC_PUT('-'); w = -w; }                                     // negative = left justify
-            if (w != 0) { char *sp = put_u32(spec + si, (uint32_t)w); si = (int)(sp - spec); }  // 0 = no width
-        } else while (*f >= '0' && *f <= '9') SPEC_PUT(*f++);
-        if (*f == '.') {                                                            // precision
-            ++f;
-            if (*f == '*') {
-                int pr; memcpy(&pr, b, 4); b += 4; ++f;
-                if (pr >= 0) { SPEC_PUT('.'); char *sp = put_u32(spec + si, (uint32_t)pr); si = (int)(sp - spec); }
-            } else { SPEC_PUT('.'); while (*f >= '0' && *f <= '9') SPEC_PUT(*f++); }
-        }
-        int lng = 0;
-        while (*f == 'l') { ++lng; SPEC_PUT(*f++); }
-        if (*f == 'z' || *f == 't' || *f == 'j') { lng = 2; SPEC_PUT(*f++); }
-        while (*f == 'h') SPEC_PUT(*f++);
-        char c = *f; SPEC_PUT(c); spec[si] = '\0';
-#undef SPEC_PUT
-        int rem = (int)(end - p);
-        if (rem <= 1) break;
-
-        int wrote = 0;
-// GCC diagnostic spelling, honored by both gcc and clang.
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wformat-nonliteral"
-        switch (c) {
-        case 'd': case 'i':
-            if (lng >= 2)      { long long v; memcpy(&v, b, 8); b += 8; wrote = snprintf(p, (size_t)rem, spec, v); }
-            else if (lng == 1) { long long v; memcpy(&v, b, 8); b += 8; wrote = snprintf(p, (size_t)rem, spec, (long)v); }
-            else               { int v; memcpy(&v, b, 4); b += 4;       wrote = snprintf(p, (size_t)rem, spec, v); }
-            break;
-        case 'u': case 'o': case 'x': case 'X':
-            if (lng >= 2)      { unsigned long long v; memcpy(&v, b, 8); b += 8; wrote = snprintf(p, (size_t)rem, spec, v); }
-            else if (lng == 1) { unsigned long long v; memcpy(&v, b, 8); b += 8; wrote = snprintf(p, (size_t)rem, spec, (unsigned long)v); }
-            else               { unsigned v; memcpy(&v, b, 4); b += 4;          wrote = snprintf(p, (size_t)rem, spec, v); }
+    if (count > ANO_LOG_KV_MAX) count = ANO_LOG_KV_MAX;
+    memcpy(p, &event, sizeof event); p += sizeof event;
+    char *countAt = p++;
+    uint8_t n = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        const ano_logfield_t *f = &fields[i];
+        if (f->key == NULL || f->type < ANO_KV_U64 || f->type > ANO_KV_SID)
+            continue;
+        size_t need = sizeof f->key + 1 + (f->type == ANO_KV_STR ? 2 : 8);
+        if ((size_t)(end - p) < need)
             break;
-        case 'e': case 'E': case 'f': case 'F': case 'g': case 'G': case 'a': case 'A':
-            { double v; memcpy(&v, b, 8); b += 8; wrote = snprintf(p, (size_t)rem, spec, v); } break;
-        case 'c': { int v; memcpy(&v, b, 4); b += 4; wrote = snprintf(p, (size_t)rem, spec, v); } break;
-        case 'p': { void *v; memcpy(&v, b, 8); b += 8; wrote = snprintf(p, (size_t)rem, spec, v); } break;
-        case 's': { uint16_t sl; memcpy(&sl, b, 2); b += 2; const char *s = b; b += (size_t)sl + 1;
-                    wrote = snprintf(p, (size_t)rem, spec, s); } break;
-        default: break;
+        memcpy(p, &f->key, sizeof f->key); p += sizeof f->key;
+        *p++ = (char)f->type;
+        if (f->type == ANO_KV_STR) {
+            size_t room = (size_t)(end - p) - 2, sl = f->str.ptr != NULL ? f->str.len : 0;
+            uint16_t sl16 = (uint16_t)(sl < room ? sl : room);
+            memcpy(p, &sl16, 2); p += 2;
+            if (sl16) memcpy(p, f->str.ptr, sl16);
+            p += sl16;
+        } else {
+            memcpy(p, &f->u64, 8); p += 8;  // f64 and sid share the word
         }
-#pragma GCC diagnostic pop
-        if (wrote < 0) wrote = 0;
-        if (wrote > rem - 1) wrote = rem - 1;   // snprintf truncated to rem-1 chars plus its NUL
-        p += wrote;
+        n++;
     }
+    *countAt = (char)n;
     return (int)(p - out);
 }
 
@@ -426,12 +369,13 @@ static int render_walltime(char *out, uint64_t ticks)
 
 /* Output file (under g_outFileMtx) */
 
-// Open <dir>/<session-stamp>_ano.log, NULL on failure. The stamp is process-wide.
+// Open <dir>/<session-stamp>_ano.log (_ano.alog when binary), NULL on failure. The stamp is process-wide.
 // fresh truncates (the init open owns the file from byte zero), otherwise appends (redirects).
 static ano_file *open_log(const char *dir, bool fresh)
 {
     char path[MAXPATH];
-    int n = snprintf(path, sizeof path, "%s/%s" ANO_LOG_FILESUFFIX, dir, ano_fs_session_stamp());
+    int n = snprintf(path, sizeof path, "%s/%s%s", dir, ano_fs_session_stamp(),
+                     g_binOn ? ANO_LOG_BINSUFFIX : ANO_LOG_FILESUFFIX);
     if (n <= 0 || n >= (int)sizeof path)
         return NULL;
     return fresh ? ano_fs_open_trunc(path) : ano_fs_open_append(path);
@@ -447,6 +391,33 @@ static void persist_console(const void *data, size_t len) { fwrite(data, 1, len,
 static void sync_file(void) { ano_fs_sync(g_outFile); }
 static void sync_none(void) { }
 
+// Start a binary file (or a redirect appending to one): write the head, forget every string id. Caller
+// holds g_drainMtx, or runs before the drainer exists.
+static void bin_head(ano_file *f)
+{
+    int64_t  now = ano_timestamp_unix();
+    ano_datetime t = ano_localtime(now);
+    int32_t  off = (int32_t)((t.hour * 3600 + t.minute * 60 + t.second) - (now % 86400 + 86400) % 86400);
+    uint64_t calTicks = 1000000000ull, calNs = ano_ticks_to_ns(calTicks);
+    uint32_t msgMax = ANO_LOG_MSG_MAX;
+    uint8_t  ver = ANO_LOGBIN_VERSION;
+
+    char h[ANO_LOGBIN_HEAD_BYTES], *p = h;
+    *p++ = ANO_LOGBIN_HEAD;
+    p = logbin_put(p, ANO_LOGBIN_MAGIC, 7);
+    p = logbin_put(p, &ver, 1);
+    p = logbin_put(p, &g_anchorTicks, 8);
+    p = logbin_put(p, &g_anchorUnixNs, 8);
+    p = logbin_put(p, &calTicks, 8);
+    p = logbin_put(p, &calNs, 8);
+    p = logbin_put(p, &off, 4);
+    (void)logbin_put(p, &msgMax, 4);
+    ano_fs_write(f, h, sizeof h);
+
+    memset(g_strTab, 0, (size_t)g_strCap * sizeof *g_strTab);
+    g_strCount = g_strIds = 0;
+}
+
 // Bind the writer set to the current output file (or the console when none). Caller holds g_outFileMtx.
 static void select_output(void)
 {
@@ -530,7 +501,17 @@ static void emit_one(ano_loglevel_t level, uint64_t raw_ts, const char *text, ui
     bool echoed = toCon && (g_haveFile || !toFile);     // no file: persist already hits the console
     if (echoed)
         echo_console(level, out, text, len);
-    if (toFile) {
+    if (toFile && g_binOn && g_haveFile) {              // binary file: the finished text as a 'T' record
+        char bin[ANO_LOGBIN_TEXT_BYTES + ANO_LOG_MSG_MAX], *q = bin;
+        uint8_t lv = (uint8_t)level;
+        *q++ = ANO_LOGBIN_TEXT;
+        q = logbin_put(q, &lv, 1);
+        q = logbin_put(q, &raw_ts, 8);
+        q = logbin_put(q, &len, 2);
+        q = logbin_put(q, text, len);
+        g_persist(bin, (size_t)(q - bin));
+        if (sync) g_syncOut();
+    } else if (toFile) {
         g_persist(out, (size_t)p);
         if (sync) g_syncOut();
         if (!g_haveFile) fflush(stdout);    // persist fell back to the console
@@ -543,68 +524,400 @@ static void emit_one(ano_loglevel_t level, uint64_t raw_ts, const char *text, ui
 
 /* The consumer: one single-active drain pass, run by the owned drain thread */
 
-// Drain every committed record up to the tail bound into one batch write. Returns lines reclaimed.
-static uint64_t drain_and_emit(void)
+// One pass's batch fill, plus the console streams echoed to (flushed once at pass end). bin picks the
+// binary encoding, recMax the most one record can append.
+typedef struct {
+    size_t blen, recMax;
+    bool   bin;
+    bool   conOut, conErr;
+} drain_pass_t;
+
+// Batch room for one record. Text: the time prefix, the line, a newline. Binary: a capture head and
+// blob, plus first-sight definitions of its format string and source file.
+#define TEXT_REC_MAX (8u + 1u + ANO_LOG_MSG_MAX + 1u)
+#define BIN_REC_MAX  (ANO_LOGBIN_CAPTURE_BYTES + ANO_LOG_MSG_MAX \
+                      + 2u * ANO_LOGBIN_STRING_BYTES + ANO_LOG_MSG_MAX + 256u)
+
+// The committed record whose head line is `h`, or false at a gap: free, reserved-but-unpublished, or a
+// stale prior-lap tag. The tag acquire is the record's linearization point.
+static inline bool peek_record(const log_ring_t *r, uint64_t h, log_word_t *v)
 {
-    // head is drainer-private, the tail load a relaxed count bound. Each record linearizes at its own
-    // `tag` acquire below, reclaim at the head release-store at the end.
-    uint64_t h0  = atomic_load_explicit(&g_ring.head, memory_order_relaxed); // drainer-private
-    uint64_t h   = h0;
-    uint64_t cap = atomic_load_explicit(&g_ring.tail, memory_order_relaxed); // reserved frontier, a count bound
-    size_t   blen = 0;
-    bool     conOut = false, conErr = false;    // console streams echoed to, flushed once at pass end
-
-    for (;;) {  // bounded walk: stops at the tail bound or the first uncommitted gap
-        if (h == cap)
-            break;  // caught up to tail
-        log_marker_t *m = log_marker_at(&g_ring, h);
-        log_word_t v = { .w = atomic_load_explicit(&m->tag, memory_order_acquire) };
-        if (!(v.flags & ANO_LOG_COMMITTED) || v.cycle != log_cycle(&g_ring, h))
-            break;  // gap: free, reserved-but-unpublished, or a stale prior-lap tag. Resume here next pass
-        uint64_t need = log_span(v.len);
-        const char *body = log_gather(&g_ring, h, v.len, g_scratch);   // <= 2 memcpys
-
-        uint64_t sec = wall_second(m->timestamp);   // deferred ticks->wall conversion
-        if (!g_drainHMSValid || sec != g_drainSec) {   // civil-time conversion once per second
-            render_hms(g_drainHMS, sec);
-            g_drainSec = sec;
-            g_drainHMSValid = true;
+    log_marker_t *m = log_marker_at(r, h);
+    v->w = atomic_load_explicit(&m->tag, memory_order_acquire);
+    return (v->flags & ANO_LOG_COMMITTED) && v->cycle == log_cycle(r, h);
+}
+
+// The cached "HH:MM:SS" for a record's raw ticks.
+static const char *drain_hms(uint64_t ticks)
+{
+    uint64_t sec = wall_second(ticks);          // deferred ticks->wall conversion
+    if (!g_drainHMSValid || sec != g_drainSec) {   // civil-time conversion once per second
+        render_hms(g_drainHMS, sec);
+        g_drainSec = sec;
+        g_drainHMSValid = true;
+    }
+    return g_drainHMS;
+}
+
+// The id of s in the current binary file, appending its 'S' definition to the batch on first sight. 0
+// for NULL. A source file is clipped to the 256 bytes the prefix prints. A format string over
+// ANO_LOG_MSG_MAX, or a table that cannot grow, yields UINT32_MAX: the record goes out as text.
+static inline uint32_t strtab_slot(const char *s, uint32_t mask)
+{
+    return (uint32_t)(((uint64_t)(uintptr_t)s * 0x9E3779B97F4A7C15ull) >> 40) & mask;  // Fibonacci hash
+}
+
+static uint32_t bin_string(drain_pass_t *dp, const char *s, bool isFile)
+{
+    if (s == NULL)
+        return 0;
+    for (;;) {
+        uint32_t mask = g_strCap - 1;
+        uint32_t i = strtab_slot(s, mask);
+        while (g_strTab[i].s != NULL) {     // linear probe, literals are never freed
+            if (g_strTab[i].s == s)
+                return g_strTab[i].id;
+            i = (i + 1) & mask;
         }
-        size_t recStart = blen;
-        memcpy(g_batch + blen, g_drainHMS, 8); blen += 8;
-        g_batch[blen++] = ' ';
-        size_t bodyStart = blen;
-        if (v.flags & ANO_LOG_DEFERRED) {   // render the capture blob now, else copy finished text
-            size_t room = g_batchCap - blen;
-            int dcap = room > ANO_LOG_MSG_MAX ? (int)ANO_LOG_MSG_MAX : (int)room;   // clamp the line like eager
-            blen += (size_t)format_deferred(g_batch + blen, dcap, (ano_loglevel_t)v.level, body);
+        if ((g_strCount + 1) * 2 <= g_strCap) {
+            size_t len = strnlen(s, isFile ? 256u : ANO_LOG_MSG_MAX + 1u);
+            uint32_t id = !isFile && len > ANO_LOG_MSG_MAX ? UINT32_MAX : ++g_strIds;
+            g_strTab[i] = (log_strent_t){ s, id };
+            g_strCount++;
+            if (id != UINT32_MAX) {
+                uint16_t l16 = (uint16_t)len;
+                char *p = g_batch + dp->blen;
+                *p++ = ANO_LOGBIN_STRING;
+                p = logbin_put(p, &id, 4);
+                p = logbin_put(p, &l16, 2);
+                p = logbin_put(p, s, len);
+                dp->blen = (size_t)(p - g_batch);
+            }
+            return id;
+        }
+        // Half full: double and rehash, then probe again.
+        uint32_t ncap = g_strCap * 2;
+        log_strent_t *nt = ano_tcalloc(&g_logMem, ncap, sizeof *nt);
+        if (nt == NULL)
+            return UINT32_MAX;
+        for (uint32_t k = 0; k < g_strCap; k++) {
+            if (g_strTab[k].s == NULL)
+                continue;
+            uint32_t j = strtab_slot(g_strTab[k].s, ncap - 1);
+            while (nt[j].s != NULL)
+                j = (j + 1) & (ncap - 1);
+            nt[j] = g_strTab[k];
         }
-        else {
-            memcpy(g_batch + blen, body, v.len); blen += v.len;
+        ano_tfree(&g_logMem, g_strTab);
+        g_strTab = nt;
+        g_strCap = ncap;
+    }
+}
+
+// Binary encoding of one record: a capture goes out raw behind a 'D' head, its fmt and file pointers
+// swapped for string ids, finished text as a 'T'. Only a console echo or a KV record renders.
+static void batch_binary(drain_pass_t *dp, uint64_t ts, log_word_t v, const char *body)
+{
+    ano_loglevel_t level = (ano_loglevel_t)v.level;
+    bool deferred = (v.flags & ANO_LOG_DEFERRED) != 0;
+    bool kv       = (v.flags & ANO_LOG_KV) != 0;
+    const char *text = body;
+    uint16_t    tlen = v.len;
+    if (deferred && ((v.flags & ANO_LOG_TOCON) || (kv && (v.flags & ANO_LOG_TOFILE)))) {  // KV: text only
+        tlen = (uint16_t)format_blob(g_render, (int)ANO_LOG_MSG_MAX, level, kv, body);
+        text = g_render;
+    }
+    if (v.flags & ANO_LOG_TOCON) {
+        ano_mutex_lock(&g_outFileMtx);
+        echo_console(level, drain_hms(ts), text, tlen);
+        ano_mutex_unlock(&g_outFileMtx);
+        if (level >= ANO_ERROR) dp->conErr = true; else dp->conOut = true;
+    }
+    if (!(v.flags & ANO_LOG_TOFILE))
+        return;
+
+    uint8_t lv = v.level;
+    if (deferred && !kv) {
+        const char *b = body;
+        const char *file; memcpy(&file, b, sizeof file); b += sizeof file;
+        int32_t line = 0;
+        if (file != NULL) { memcpy(&line, b, sizeof line); b += sizeof line; }
+        const char *fmt;  memcpy(&fmt,  b, sizeof fmt);  b += sizeof fmt;
+        uint32_t fileId = bin_string(dp, file, true);
+        uint32_t fmtId  = bin_string(dp, fmt, false);
+        if (fileId != UINT32_MAX && fmtId != UINT32_MAX) {
+            uint16_t argLen = (uint16_t)(v.len - (uint16_t)(b - body));
+            char *p = g_batch + dp->blen;
+            *p++ = ANO_LOGBIN_CAPTURE;
+            p = logbin_put(p, &lv, 1);
+            p = logbin_put(p, &ts, 8);
+            p = logbin_put(p, &fmtId, 4);
+            p = logbin_put(p, &fileId, 4);
+            p = logbin_put(p, &line, 4);
+            p = logbin_put(p, &argLen, 2);
+            p = logbin_put(p, b, argLen);
+            dp->blen = (size_t)(p - g_batch);
+            return;
         }
-        if (v.flags & ANO_LOG_TOCON) {      // echo the just-rendered bytes, under the sink lock
-            ano_mutex_lock(&g_outFileMtx);
-            echo_console((ano_loglevel_t)v.level, g_drainHMS, g_batch + bodyStart, blen - bodyStart);
-            ano_mutex_unlock(&g_outFileMtx);
-            if ((ano_loglevel_t)v.level >= ANO_ERROR) conErr = true; else conOut = true;
+        if (text == body) {             // untabled format: render it after all
+            tlen = (uint16_t)format_deferred(g_render, (int)ANO_LOG_MSG_MAX, level, body);
+            text = g_render;
         }
-        if (v.flags & ANO_LOG_TOFILE)
-            g_batch[blen++] = '\n';
-        else
-            blen = recStart;                // terminal-only, drop it from the file batch
-        h += need;
+    }
+    char *p = g_batch + dp->blen;
+    *p++ = ANO_LOGBIN_TEXT;
+    p = logbin_put(p, &lv, 1);
+    p = logbin_put(p, &ts, 8);
+    p = logbin_put(p, &tlen, 2);
+    p = logbin_put(p, text, tlen);
+    dp->blen = (size_t)(p - g_batch);
+}
+
+// Append one record to the pass batch: the cached "HH:MM:SS " prefix, then the finished text (or the
+// capture blob rendered now), echoed to the terminal when its sink bit asks. A pass can outgrow the batch
+// (several rings merged, binary string definitions): write it out mid-pass. The heads advance only at
+// the end, so nothing is reclaimed before it is written.
+static void batch_entry(drain_pass_t *dp, uint64_t ts, log_word_t v, const char *body)
+{
+    if (g_batchCap - dp->blen < dp->recMax) {
+        write_batch(g_batch, dp->blen);
+        dp->blen = 0;
+    }
+    if ((v.flags & ANO_LOG_KV) && g_kvOn)
+        logkv_row(g_anchorUnixNs + ano_ticks_to_ns(ts - g_anchorTicks), body);
+    if (dp->bin) {
+        batch_binary(dp, ts, v, body);
+        return;
+    }
+
+    drain_hms(ts);
+    size_t blen = dp->blen;
+    size_t recStart = blen;
+    memcpy(g_batch + blen, g_drainHMS, 8); blen += 8;
+    g_batch[blen++] = ' ';
+    size_t bodyStart = blen;
+    if (v.flags & ANO_LOG_DEFERRED) {   // render the capture blob now, else copy finished text
+        size_t room = g_batchCap - blen;
+        int dcap = room > ANO_LOG_MSG_MAX ? (int)ANO_LOG_MSG_MAX : (int)room;   // clamp the line like eager
+        blen += (size_t)format_blob(g_batch + blen, dcap, (ano_loglevel_t)v.level,
+                                    (v.flags & ANO_LOG_KV) != 0, body);
+    }
+    else {
+        memcpy(g_batch + blen, body, v.len); blen += v.len;
+    }
+    if (v.flags & ANO_LOG_TOCON) {      // echo the just-rendered bytes, under the sink lock
+        ano_mutex_lock(&g_outFileMtx);
+        echo_console((ano_loglevel_t)v.level, g_drainHMS, g_batch + bodyStart, blen - bodyStart);
+        ano_mutex_unlock(&g_outFileMtx);
+        if ((ano_loglevel_t)v.level >= ANO_ERROR) dp->conErr = true; else dp->conOut = true;
+    }
+    if (v.flags & ANO_LOG_TOFILE)
+        g_batch[blen++] = '\n';
+    else
+        blen = recStart;                // terminal-only, drop it from the file batch
+    dp->blen = blen;
+}
+
+// Batch the committed record whose head line is `h`.
+static inline void batch_record(drain_pass_t *dp, const log_ring_t *r, uint64_t h, log_word_t v)
+{
+    const char *body = log_gather(r, h, v.len, g_scratch);     // <= 2 memcpys
+    batch_entry(dp, log_marker_at(r, h)->timestamp, v, body);
+}
+
+// One WARN line per level that dropped records since the last pass, routed as a WARN by default.
+static void batch_dropped(drain_pass_t *dp)
+{
+    for (int l = ANO_INFO; l <= ANO_FATAL; l++) {
+        if (atomic_load_explicit(&g_dropped[l], memory_order_relaxed) == 0)
+            continue;
+        unsigned long long n = atomic_exchange_explicit(&g_dropped[l], 0, memory_order_relaxed);
+        static const char *const name[4] = { "INFO", "WARN", "ERROR", "FATAL" };
+        char text[96];
+        int len = snprintf(text, sizeof text, "%.5s logger: %llu %s records dropped, ring full",
+                           logPad[ANO_WARN], n, name[l]);
+        uint8_t sinks = atomic_load_explicit(&g_routeDefault[ANO_WARN], memory_order_relaxed) & ANO_BOTH;
+        log_word_t v = { .len = (uint16_t)len, .level = ANO_WARN,
+                         .flags = (uint8_t)(ANO_LOG_COMMITTED | (sinks << 2)) };
+        batch_entry(dp, ano_timestamp_ticks(), v, text);
+    }
+}
+
+// Walk one MPSC ring in claim order from its head to the tail bound, stopping at the first gap or a stamp
+// at or past `mark`. Stores the head. Returns lines reclaimed, *done true when the walk reached the bound.
+static uint64_t drain_claimed(drain_pass_t *dp, log_ring_t *r, uint64_t mark, bool *done)
+{
+    // head is drainer-private, the tail load a relaxed count bound. Each record linearizes at its own
+    // `tag` acquire, reclaim at the head release-store at the end.
+    uint64_t h0  = atomic_load_explicit(&r->head, memory_order_relaxed); // drainer-private
+    uint64_t h   = h0;
+    uint64_t cap = atomic_load_explicit(&r->tail, memory_order_relaxed) & ~SPILL_ACTIVE; // a count bound
+    log_word_t v;
+    while (h != cap && peek_record(r, h, &v)                             // stops at the bound or a gap
+           && log_marker_at(r, h)->timestamp < mark) {
+        batch_record(dp, r, h, v);
+        h += log_span(v.len);
     }
 
     // No zeroing: a reused slot carries last lap's tag until republished, rejected by the cycle check
     // above. Reclaim is just the head advance.
-    atomic_store_explicit(&g_ring.head, h, memory_order_release);   // frees [h0,h) for reuse
-
-    write_batch(g_batch, blen); // one syscall for the whole pass
-    if (conOut) fflush(stdout); // flush echoes at pass end
-    if (conErr) fflush(stderr);
+    atomic_store_explicit(&r->head, h, memory_order_release);   // frees [h0,h) for reuse
+    *done = h == cap;
     return h - h0;
 }
 
+// Drop SPILL_ACTIVE once the spill ring is empty. A CAS against the empty tail: a producer that reserved
+// since keeps the bit up.
+static void spill_settle(void)
+{
+    uint64_t t = atomic_load_explicit(&g_spill.tail, memory_order_relaxed);
+    if (t == (atomic_load_explicit(&g_spill.head, memory_order_relaxed) | SPILL_ACTIVE))
+        atomic_compare_exchange_strong_explicit(&g_spill.tail, &t, t & ~SPILL_ACTIVE,
+                                                memory_order_relaxed, memory_order_relaxed);
+}
+
+// Shared mode: the ring in claim order, then the spill ring behind it. A record that happened-after a
+// spilled one is itself spilled, so ring-then-spill keeps order. The spill ring drains only when the ring
+// walk reached its bound, and only below a watermark read before that bound: a spilled record stamped
+// under it cannot follow a ring record this pass missed. Returns lines reclaimed.
+static uint64_t drain_shared(drain_pass_t *dp)
+{
+    bool spill = atomic_load_explicit(&g_spill.tail, memory_order_relaxed)
+              != atomic_load_explicit(&g_spill.head, memory_order_relaxed);
+    uint64_t mark = spill ? ano_timestamp_ticks_ordered() : 0;   // ordered: see drain_lanes
+    bool done;
+    uint64_t n = drain_claimed(dp, &g_ring, UINT64_MAX, &done);
+    if (spill && done)
+        n += drain_claimed(dp, &g_spill, mark, &done);
+    spill_settle();
+    return n;
+}
+
+// One merge source: a ring, its drain cursor and bound, and the peeked head record.
+typedef struct {
+    log_ring_t *r;
+    uint64_t    h0, h, cap;
+    uint64_t    ts;     // head record's raw ticks, the merge key
+    log_word_t  v;
+} merge_src_t;
+
+// Drainer-private merge state, sized for every lane plus the shared and spill rings. Touched only under
+// g_drainMtx.
+static merge_src_t g_src[ANO_LOG_LANES_MAX + 2];
+static uint16_t    g_heap[ANO_LOG_LANES_MAX + 2];
+
+// Peek a source's head record into its merge key. False at its bound, a gap, or a stamp at or past the
+// pass watermark.
+static inline bool merge_peek(merge_src_t *s, uint64_t mark)
+{
+    if (s->h == s->cap || !peek_record(s->r, s->h, &s->v))
+        return false;
+    s->ts = log_marker_at(s->r, s->h)->timestamp;   // plain memory, visible through the tag acquire
+    return s->ts < mark;
+}
+
+// Min-heap of source indices keyed (ts, index). The index tiebreak keeps equal stamps deterministic.
+static inline bool merge_less(uint16_t a, uint16_t b)
+{
+    return g_src[a].ts < g_src[b].ts || (g_src[a].ts == g_src[b].ts && a < b);
+}
+
+static void merge_sift_down(uint32_t n, uint32_t i)
+{
+    for (;;) {
+        uint32_t l = 2 * i + 1, m = i;
+        if (l < n && merge_less(g_heap[l], g_heap[m]))         m = l;
+        if (l + 1 < n && merge_less(g_heap[l + 1], g_heap[m])) m = l + 1;
+        if (m == i) return;
+        uint16_t t = g_heap[i]; g_heap[i] = g_heap[m]; g_heap[m] = t;
+        i = m;
+    }
+}
+
+// Lanes mode: k-way merge of every lane plus the shared and spill rings by raw tick timestamp. Each lane is
+// in stamp order (one producer), the MPSC rings in claim order; a thread stays in g_spill while it is
+// active, so its own records never straddle a spill record stuck behind a later stamp. The watermark is
+// read before any bound: a record stamped under it was published before its producer's later records, so
+// once a ring's bound is read everything that happened-before a merged record is already in this pass or
+// drained earlier. Records stamped at or past the mark wait for the next pass. Returns lines reclaimed.
+static uint64_t drain_lanes(drain_pass_t *dp)
+{
+    // The watermark needs the ordered read. A bare rdtsc may retire after the relaxed tail loads below,
+    // and a producer that stamps and publishes in between would sit under the mark yet past this pass's
+    // bound, to be emitted next pass behind records stamped after it. Producers keep the bare read.
+    uint64_t mark = ano_timestamp_ticks_ordered();
+    uint32_t nl   = g_lanesOn ? thread_lanes_count(&g_lanes) : 0;
+    uint32_t ns   = 0, nh = 0;
+    for (uint32_t i = 0; i <= nl + 1; i++) {
+        log_ring_t *r = i == 0 ? &g_ring : i == 1 ? &g_spill : &((log_lane_t *)g_laneSlots[i - 2])->ring;
+        merge_src_t *s = &g_src[ns];
+        s->r   = r;
+        s->h0  = s->h = atomic_load_explicit(&r->head, memory_order_relaxed);   // drainer-private
+        s->cap = atomic_load_explicit(&r->tail, memory_order_relaxed) & ~SPILL_ACTIVE;  // count bound
+        if (merge_peek(s, mark))
+            g_heap[nh++] = (uint16_t)ns;
+        ns++;
+    }
+    for (uint32_t i = nh / 2; i-- > 0; )
+        merge_sift_down(nh, i);
+
+    while (nh > 0) {
+        merge_src_t *s = &g_src[g_heap[0]];
+        batch_record(dp, s->r, s->h, s->v);
+        s->h += log_span(s->v.len);
+        if (!merge_peek(s, mark))
+            g_heap[0] = g_heap[--nh];   // source exhausted for this pass
+        merge_sift_down(nh, 0);
+    }
+
+    uint64_t lines = 0;
+    for (uint32_t i = 0; i < ns; i++) {
+        if (g_src[i].h != g_src[i].h0)
+            atomic_store_explicit(&g_src[i].r->head, g_src[i].h, memory_order_release);
+        lines += g_src[i].h - g_src[i].h0;
+    }
+    spill_settle();
+    return lines;
+}
+
+// Drain every committed record up to the bounds into one batch write. Returns lines reclaimed. Binary
+// only with a file open: the console fallback stays text. The file cannot change under g_drainMtx.
+static uint64_t drain_and_emit(void)
+{
+    drain_pass_t dp = { 0 };
+    dp.bin    = g_binOn && g_haveFile;
+    dp.recMax = dp.bin ? BIN_REC_MAX : TEXT_REC_MAX;
+    uint64_t n = g_lanesOn ? drain_lanes(&dp) : drain_shared(&dp);
+    batch_dropped(&dp);
+    write_batch(g_batch, dp.blen); // one syscall for the whole pass
+    if (g_kvOn) logkv_flush();     // and one per event file touched
+    if (dp.conOut) fflush(stdout); // flush echoes at pass end
+    if (dp.conErr) fflush(stderr);
+    return n;
+}
+
+// True while any ring holds a reserved line the drainer has not reclaimed. seq_cst tail loads pair with
+// the parked-flag store in drainer_park.
+static bool log_pending(void)
+{
+    if (atomic_load_explicit(&g_ring.tail, memory_order_seq_cst)
+        != atomic_load_explicit(&g_ring.head, memory_order_relaxed))
+        return true;
+    if ((atomic_load_explicit(&g_spill.tail, memory_order_seq_cst) & ~SPILL_ACTIVE)
+        != atomic_load_explicit(&g_spill.head, memory_order_relaxed))
+        return true;
+    if (!g_lanesOn)
+        return false;
+    uint32_t nl = thread_lanes_count(&g_lanes);
+    for (uint32_t i = 0; i < nl; i++) {
+        log_ring_t *r = &((log_lane_t *)g_laneSlots[i])->ring;
+        if (atomic_load_explicit(&r->tail, memory_order_seq_cst)
+            != atomic_load_explicit(&r->head, memory_order_relaxed))
+            return true;
+    }
+    return false;
+}
+
 // One drain pass, serialized so exactly one thread drains at a time. The owned thread runs it in a loop.
 // ano_log_flush runs it inline for a synchronous guarantee.
 static uint64_t drain(void)
@@ -629,9 +942,7 @@ static void drainer_park(void)
 {
     ano_mutex_lock(&g_wakeMtx);
     atomic_store_explicit(&g_drainerParked, true, memory_order_seq_cst);
-    uint64_t t = atomic_load_explicit(&g_ring.tail, memory_order_seq_cst);
-    uint64_t h = atomic_load_explicit(&g_ring.head, memory_order_relaxed);  // drainer-private
-    if (t == h && atomic_load_explicit(&g_drainRun, memory_order_relaxed)) {
+    if (!log_pending() && atomic_load_explicit(&g_drainRun, memory_order_relaxed)) {
         struct timespec ts;
         timespec_get(&ts, TIME_UTC);    // CLOCK_REALTIME base, what cond_timedwait expects
         uint64_t ns = (uint64_t)ts.tv_nsec + (uint64_t)DRAIN_PARK_US * 1000u;
@@ -648,45 +959,132 @@ static void drainer_park(void)
 static void *drainer_main(void *arg)
 {
     (void)arg;
+    ano_profile_thread_name("log drainer");
     while (atomic_load_explicit(&g_drainRun, memory_order_relaxed)) {
+        uint64_t t0 = ano_timestamp_ticks();
         if (drain() == 0)
             drainer_park();     // empty pass: park until woken, else stay hot and loop
+        else
+            ano_profile_span("log.drain", t0);  // recorded after the fact, so idle passes cost nothing
     }
     return NULL;
 }
 
 
-/* The two paths behind ano_log_vwrite. Sink resolution already happened. */
+/* Lanes: per-thread SPSC rings, acquired lazily on a thread's first buffered record */
 
-// The buffered path: capture or eagerly format on the calling thread, publish to the ring. The
-// drainer routes by the sink bits riding the tag.
-__attribute__((format(printf, 5, 0)))
-static int log_buffered(ano_loglevel_t level, uint8_t sinks, const char *file, int line,
-                        const char *fmt, va_list args)
+// A fresh zeroed lane, or NULL when out of memory.
+static void *lane_new(void)
 {
-    uint64_t ts = ano_timestamp_ticks();   // stamp at the call site, bare counter, convert at drain
+    log_lane_t *l = ano_aligned_malloc(sizeof *l, ANO_THREAD_LINE);
+    if (l == NULL)
+        return NULL;
+    memset(l, 0, sizeof *l);
+    l->ring.mask  = ANO_LOG_LANE_LINES - 1;
+    l->ring.shift = (uint32_t)__builtin_ctzll(ANO_LOG_LANE_LINES);
+    l->ring.buf   = ano_aligned_malloc(ANO_LOG_LANE_BYTES, ANO_LOG_LANE_BYTES < 4096u ? ANO_LOG_LANE_BYTES : 4096u);
+    if (l->ring.buf == NULL) {
+        ano_aligned_free(l);
+        return NULL;
+    }
+    memset(l->ring.buf, 0, ANO_LOG_LANE_BYTES);
+    return l;
+}
 
-    char blob[ANO_LOG_MSG_MAX]; // capture blob (deferred) or finished line (eager fallback), off-ring
-    va_list ap; va_copy(ap, args);
-    va_list apc; va_copy(apc, args);
-    int n = capture_deferred(blob, (int)ANO_LOG_MSG_MAX, file, line, fmt, ap);  // defer formatting to drain
-    bool deferred = (n >= 0);
-    if (!deferred)                                                              // fancy conversion: format now
-        n = format_line(blob, (int)ANO_LOG_MSG_MAX, level, file, line, fmt, apc);
-    va_end(apc); va_end(ap);
-    uint16_t len  = (uint16_t)n;
+static void lane_free(void *p)
+{
+    log_lane_t *l = p;
+    ano_aligned_free(l->ring.buf);
+    ano_aligned_free(l);
+}
+
+// A retired lane is adoptable once the drainer has caught up with its last record.
+static bool lane_drained(void *p)
+{
+    log_lane_t *l = p;
+    return atomic_load_explicit(&l->ring.head, memory_order_acquire)
+           == atomic_load_explicit(&l->ring.tail, memory_order_relaxed);
+}
+
+// The calling thread's lane for this session. NULL (cached) when the table is full or allocation fails,
+// and the thread shares g_ring.
+static log_lane_t *lane_acquire(void)
+{
+    if (t_laneGen == atomic_load_explicit(&g_lanes.gen, memory_order_relaxed))
+        return t_lane;
+    return t_lane = thread_lanes_acquire(&g_lanes, &t_laneGen);
+}
+
+
+// Lanes-mode setup at init: the table starts empty, threads append on their first record. Opening the
+// gate orphans every thread-local lane from an earlier session. 0 on success.
+static int lanes_open(void)
+{
+    g_lanes.liveOffset = offsetof(log_lane_t, live);
+    g_lanes.make       = lane_new;
+    g_lanes.drained    = lane_drained;
+    if (thread_lanes_open(&g_lanes) != 0)
+        return -1;
+    thread_lanes_gate(&g_lanes, true);
+    return 0;
+}
+
+// Lanes-mode teardown, after the final drain.
+static void lanes_close(void)
+{
+    thread_lanes_gate(&g_lanes, false);
+    thread_lanes_close(&g_lanes, lane_free);
+}
+
+
+/* The two paths behind ano_log_vwrite. Sink resolution already happened. */
+
+// Publish one record of len bytes stamped ts to the ring (or the thread's lane): finished text, or a blob
+// when kind holds ANO_LOG_DEFERRED (| ANO_LOG_KV for a structured one). The drainer routes by the sink
+// bits riding the tag.
+static int log_publish(ano_loglevel_t level, uint8_t sinks, uint64_t ts, const char *blob, uint16_t len,
+                       uint8_t kind)
+{
     uint64_t need = log_span(len);
 
     // An "entry" is a marker (tag + timestamp) plus inline text, laid into the ring's reserved cache
-    // lines below. The ring is the storage.
-    uint64_t cap = log_lines(&g_ring);
-    uint64_t pos = atomic_load_explicit(&g_ring.tail, memory_order_relaxed);
+    // lines below. The ring is the storage. A lane has one producer, so its tail is ours alone.
+    unsigned    lvl  = (unsigned)level <= ANO_FATAL ? (unsigned)level : (unsigned)ANO_FATAL;
+    log_lane_t *lane = g_lanesOn ? lane_acquire() : NULL;
+    log_ring_t *r    = lane != NULL ? &lane->ring : &g_ring;
+    uint64_t raw = atomic_load_explicit(&g_spill.tail, memory_order_relaxed);
+    if (raw & SPILL_ACTIVE) {   // a spill is live: follow it, so nothing overtakes a spilled record
+        r    = &g_spill;
+        lane = NULL;
+    }
+    else {
+        raw = atomic_load_explicit(&r->tail, memory_order_relaxed);
+    }
+    uint64_t cap = log_lines(r);
+    uint64_t pos = raw & ~SPILL_ACTIVE;     // raw keeps the bit for the CAS on g_spill
     uint64_t lastHead = 0;
     uint64_t backoff = FULL_BACKOFF_MIN_NS;
     uint32_t stall = 0;
     bool waited = false;
     for (;;) {
-        uint64_t hd = atomic_load_explicit(&g_ring.head, memory_order_acquire); // full and reuse-safety
+        uint64_t hd = atomic_load_explicit(&r->head, memory_order_acquire);     // full and reuse-safety
+        if ((pos + need) - hd > cap) {  // ring full: the level's policy first
+            uint8_t pol = atomic_load_explicit(&g_overflow[lvl], memory_order_relaxed);
+            if (pol == ANO_LOG_DROP) {  // drop newest: one counter bump, no wait
+                atomic_fetch_add_explicit(&g_dropped[lvl], 1, memory_order_relaxed);
+                if (atomic_load_explicit(&g_drainerParked, memory_order_seq_cst))
+                    wake_drainer();
+                return 2;
+            }
+            if (pol == ANO_LOG_SPILL && r != &g_spill) {    // reserve in the spill ring, MPSC like the shared one
+                r    = &g_spill;
+                lane = NULL;
+                cap  = log_lines(r);
+                raw  = atomic_load_explicit(&r->tail, memory_order_relaxed);
+                pos  = raw & ~SPILL_ACTIVE;
+                continue;
+            }
+        }
         if ((pos + need) - hd > cap) {   // would alias undrained: ring full
             // Back off and let the owned consumer free space, self-throttling to the drain rate. While
             // head advances this is plain backpressure. On a stall (a producer died mid-publish, leaving
@@ -696,9 +1094,9 @@ static int log_buffered(ano_loglevel_t level, uint8_t sinks, const char *file, i
             if (hd != lastHead) { lastHead = hd; stall = 0; backoff = FULL_BACKOFF_MIN_NS; }
             else if (++stall > FULL_STALL_LIMIT) {
                 bool toFile = (sinks & ANO_FILE) != 0, toCon = (sinks & ANO_TERM) != 0;
-                if (deferred) {   // render the capture blob to text for the direct write
+                if (kind & ANO_LOG_DEFERRED) {  // render the blob to text for the direct write
                     char txt[ANO_LOG_MSG_MAX];
-                    int tn = format_deferred(txt, (int)sizeof txt, level, blob);
+                    int tn = format_blob(txt, (int)sizeof txt, level, (kind & ANO_LOG_KV) != 0, blob);
                     emit_one(level, ts, txt, (uint16_t)tn, toFile, toCon, false);
                 } else {
                     emit_one(level, ts, blob, len, toFile, toCon, false);   // cold escape: the call-site ticks
@@ -710,23 +1108,28 @@ static int log_buffered(ano_loglevel_t level, uint8_t sinks, const char *file, i
                 wake_drainer();
             ano_busywait(backoff);  // escalating, off the consumer's cache line between rechecks
             if (backoff < FULL_BACKOFF_MAX_NS) backoff <<= 1;
-            pos = atomic_load_explicit(&g_ring.tail, memory_order_relaxed);     // re-snapshot, retry
+            raw = atomic_load_explicit(&r->tail, memory_order_relaxed);         // re-snapshot, retry
+            pos = raw & ~SPILL_ACTIVE;
             continue;
         }
-        if (atomic_compare_exchange_weak_explicit(&g_ring.tail, &pos, pos + need,
+        if (lane != NULL) {     // sole producer: a plain store claims the lines, no CAS
+            atomic_store_explicit(&r->tail, pos + need, memory_order_relaxed);
+            break;
+        }
+        uint64_t next = (pos + need) | (r == &g_spill ? SPILL_ACTIVE : 0);     // a spill raises the bit
+        if (atomic_compare_exchange_weak_explicit(&r->tail, &raw, next,
                 memory_order_relaxed, memory_order_relaxed))
             break;  // own lines [pos, pos+need)
-        // CAS failed: pos reloaded with the current tail, retry.
+        pos = raw & ~SPILL_ACTIVE;  // CAS failed: raw reloaded with the current tail, retry
     }
 
-    log_marker_t *m = log_marker_at(&g_ring, pos);
+    log_marker_t *m = log_marker_at(r, pos);
     m->timestamp = ts;  // plain store, ordered by the release below
-    log_write_body(&g_ring, pos, blob, len);    // <= 2 memcpys
+    log_write_body(r, pos, blob, len);          // <= 2 memcpys
     // Sink bits ride the tag: ANO_FILE/ANO_TERM (1|2) shift onto ANO_LOG_TOFILE/TOCON (4|8).
     log_word_t v = { .len = len, .level = (uint8_t)level,
-                     .flags = (uint8_t)(ANO_LOG_COMMITTED | (deferred ? ANO_LOG_DEFERRED : 0)
-                                        | ((sinks & ANO_BOTH) << 2)),
-                     .cycle = log_cycle(&g_ring, pos) };
+                     .flags = (uint8_t)(ANO_LOG_COMMITTED | kind | ((sinks & ANO_BOTH) << 2)),
+                     .cycle = log_cycle(r, pos) };
     atomic_store_explicit(&m->tag, v.w, memory_order_release);  // publish: one gate, whole record
 
     // Empty->nonempty wake: one relaxed-cost load when the drainer is awake (the common case under
@@ -736,37 +1139,74 @@ static int log_buffered(ano_loglevel_t level, uint8_t sinks, const char *file, i
     return waited ? 1 : 0;   // 1: the ring was full, waited for the consumer to make room
 }
 
-// The NOW path: format eagerly, drain for order, write through with an fsync. Bypasses the ring
-// without consuming it, and skips the severity gate.
+// The buffered path: capture or eagerly format on the calling thread, then publish.
 __attribute__((format(printf, 5, 0)))
-static int log_now(ano_loglevel_t level, uint8_t sinks, const char *file, int line,
-                   const char *fmt, va_list args)
+static int log_buffered(ano_loglevel_t level, uint8_t sinks, const char *file, int line,
+                        const char *fmt, va_list args)
 {
-    char blob[ANO_LOG_MSG_MAX];
+    uint64_t ts = ano_timestamp_ticks();   // stamp at the call site, bare counter, convert at drain
+
+    char blob[ANO_LOG_MSG_MAX]; // capture blob (deferred) or finished line (eager fallback), off-ring
     va_list ap; va_copy(ap, args);
-    int n = format_line(blob, (int)ANO_LOG_MSG_MAX, level, file, line, fmt, ap);
-    va_end(ap);
+    va_list apc; va_copy(apc, args);
+    int n = log_capture_deferred(blob, (int)ANO_LOG_MSG_MAX, file, line, fmt, ap);  // defer formatting to drain
+    bool deferred = (n >= 0);
+    if (!deferred)                                                              // fancy conversion: format now
+        n = format_line(blob, (int)ANO_LOG_MSG_MAX, level, file, line, fmt, apc);
+    va_end(apc); va_end(ap);
+    return log_publish(level, sinks, ts, blob, (uint16_t)n, deferred ? ANO_LOG_DEFERRED : 0);
+}
 
+// The NOW write-through for an already rendered line: drain for order, then write with an fsync.
+// kvBlob (nullable) is a structured record's capture, whose column row goes out behind the drain.
+static int log_now_emit(ano_loglevel_t level, uint8_t sinks, const char *text, int n, const char *kvBlob)
+{
     if (!atomic_load_explicit(&g_initialized, memory_order_relaxed)) {
-        fprintf(stderr, "%.*s\n", n, blob); // pre-init: stderr only, no anchor yet
+        fprintf(stderr, "%.*s\n", n, text); // pre-init: stderr only, no anchor yet
         return 0;
     }
     drain();    // flush buffered records first to keep order
-    emit_one(level, ano_timestamp_ticks(), blob, (uint16_t)n,
-             (sinks & ANO_FILE) != 0, (sinks & ANO_TERM) != 0, /*sync*/true);
+    uint64_t ts = ano_timestamp_ticks();
+    if (kvBlob != NULL && g_kvOn) {
+        ano_mutex_lock(&g_drainMtx);
+        logkv_row(g_anchorUnixNs + ano_ticks_to_ns(ts - g_anchorTicks), kvBlob);
+        logkv_flush();
+        ano_mutex_unlock(&g_drainMtx);
+    }
+    emit_one(level, ts, text, (uint16_t)n, (sinks & ANO_FILE) != 0, (sinks & ANO_TERM) != 0, /*sync*/true);
     return 0;
 }
 
+// The NOW path: format eagerly, then write through. Bypasses the ring without consuming it, and
+// skips the severity gate.
+__attribute__((format(printf, 5, 0)))
+static int log_now(ano_loglevel_t level, uint8_t sinks, const char *file, int line,
+                   const char *fmt, va_list args)
+{
+    char blob[ANO_LOG_MSG_MAX];
+    va_list ap; va_copy(ap, args);
+    int n = format_line(blob, (int)ANO_LOG_MSG_MAX, level, file, line, fmt, ap);
+    va_end(ap);
+    return log_now_emit(level, sinks, blob, n, NULL);
+}
+
+// A call's sinks: the route as given, or the level's default when it names no sink (NOW composes).
+static unsigned log_route(ano_loglevel_t level, ano_logroute_t route)
+{
+    unsigned lvlIdx = (unsigned)level <= ANO_FATAL ? (unsigned)level : (unsigned)ANO_FATAL;
+    unsigned r      = (unsigned)route;
+    if ((r & ANO_BOTH) == 0)
+        r |= atomic_load_explicit(&g_routeDefault[lvlIdx], memory_order_relaxed);
+    return r;
+}
+
 
 /* Public interface */
 
 int ano_log_vwrite(ano_loglevel_t level, ano_logroute_t route,
                    const char *file, int line, const char *fmt, va_list args)
 {
-    unsigned lvlIdx = (unsigned)level <= ANO_FATAL ? (unsigned)level : (unsigned)ANO_FATAL;
-    unsigned r      = (unsigned)route;
-    if ((r & ANO_BOTH) == 0)  // no sink named, inherit the level's default (NOW composes)
-        r |= atomic_load_explicit(&g_routeDefault[lvlIdx], memory_order_relaxed);
+    unsigned r = log_route(level, route);
     if (r & ANO_NOW)
         return log_now(level, (uint8_t)r, file, line, fmt, args);
     if ((int)level < atomic_load_explicit(&g_minLevel, memory_order_relaxed))
@@ -783,6 +1223,96 @@ int ano_log_write(ano_loglevel_t level, ano_logroute_t route,
     return rc;
 }
 
+int ano_log_kv(ano_loglevel_t level, ano_logroute_t route, const char *event,
+               const ano_logfield_t *fields, uint32_t count)
+{
+    if (event == NULL || (fields == NULL && count > 0))
+        return 0;
+    unsigned r = log_route(level, route);
+    if (!(r & ANO_NOW) && (int)level < atomic_load_explicit(&g_minLevel, memory_order_relaxed))
+        return 0;
+
+    uint64_t ts = ano_timestamp_ticks();
+    char blob[ANO_LOG_MSG_MAX];
+    int n = capture_kv(blob, (int)ANO_LOG_MSG_MAX, event, fields, count);
+    if (!(r & ANO_NOW))
+        return log_publish(level, (uint8_t)r, ts, blob, (uint16_t)n, ANO_LOG_DEFERRED | ANO_LOG_KV);
+
+    // NOW: rendered here, then log_now's write-through with the column row.
+    char text[ANO_LOG_MSG_MAX];
+    int tn = format_kv(text, (int)sizeof text, level, blob);
+    return log_now_emit(level, (uint8_t)r, text, tn, blob);
+}
+
+bool ano_log_gate_every(ano_logsite_t *site, uint32_t n)
+{
+    if (n <= 1)
+        return true;
+    return atomic_fetch_add_explicit(&site->count, 1, memory_order_relaxed) % n == 0;
+}
+
+bool ano_log_gate_once(ano_logsite_t *site)
+{
+    // The load keeps a fired site read-only: every later call stays a shared-line hit, no RMW.
+    return atomic_load_explicit(&site->count, memory_order_relaxed) == 0
+        && atomic_exchange_explicit(&site->count, 1, memory_order_relaxed) == 0;
+}
+
+bool ano_log_gate_rate(ano_logsite_t *site, uint32_t perSec)
+{
+    // GCRA: `next` is when the site's budget would be spent if every admitted call were spaced evenly,
+    // one step apart. A call is admitted while that is less than one second ahead of now, so a quiet
+    // site bursts perSec calls, then settles to one per step. Refusal is one load and a compare.
+    if (perSec == 0)
+        return false;
+    const uint64_t second = 1000000000ull;
+    uint64_t step = second / perSec;
+    uint64_t now  = ano_timestamp_raw();
+    uint64_t next = atomic_load_explicit(&site->next, memory_order_relaxed);
+    for (;;) {
+        uint64_t base = next > now ? next : now;
+        if (base - now > second - step)
+            return false;   // over budget
+        if (atomic_compare_exchange_weak_explicit(&site->next, &next, base + step,
+                memory_order_relaxed, memory_order_relaxed))
+            return true;
+        // CAS failed: next reloaded, retry.
+    }
+}
+
+int ano_log_set_mode(ano_logmode_t mode)
+{
+    if ((unsigned)mode > ANO_LOG_LANES || atomic_load_explicit(&g_initialized, memory_order_relaxed))
+        return -1;  // the topology is latched for the life of a session
+    atomic_store_explicit(&g_mode, (int)mode, memory_order_relaxed);
+    return 0;
+}
+
+int ano_log_set_overflow(ano_loglevel_t level, ano_logoverflow_t policy)
+{
+    if ((unsigned)level > ANO_FATAL || (unsigned)policy > ANO_LOG_SPILL
+        || (policy == ANO_LOG_DROP && level >= ANO_ERROR))
+        return -1;  // ERROR and FATAL are never dropped
+    atomic_store_explicit(&g_overflow[level], (uint8_t)policy, memory_order_relaxed);
+    return 0;
+}
+
+int ano_log_set_columns(bool on)
+{
+    if (atomic_load_explicit(&g_initialized, memory_order_relaxed))
+        return -1;
+    atomic_store_explicit(&g_columns, on, memory_order_relaxed);
+    return 0;
+}
+
+int ano_log_set_format(ano_logformat_t format)
+{
+    if ((unsigned)format > ANO_LOG_BINARY || atomic_load_explicit(&g_initialized, memory_order_relaxed))
+        return -1;  // one encoding per session
+    atomic_store_explicit(&g_format, (int)format, memory_order_relaxed);
+    return 0;
+}
+
 void ano_log_set_route(ano_loglevel_t level, ano_logroute_t route)
 {
     if ((unsigned)level > ANO_FATAL || (route & ANO_BOTH) == 0)
@@ -800,14 +1330,23 @@ int ano_log_output_dir(const char *directoryPath)
     if (newOut == NULL)
         return -1;  // open failed, keep current output file
 
+    // Swap between drain passes: a pass (and a binary file's string ids) never spans two files.
+    ano_mutex_lock(&g_drainMtx);
     ano_mutex_lock(&g_outFileMtx);
     if (g_outFile != NULL) {
         ano_fs_sync(g_outFile);
         ano_fs_close(g_outFile);
     }
+    if (g_binOn)
+        bin_head(newOut);
     g_outFile = newOut;
     select_output();    // rebind the writer set to the new file
     ano_mutex_unlock(&g_outFileMtx);
+    if (g_kvOn) {       // the column files follow the log
+        logkv_close();
+        logkv_open(directoryPath);
+    }
+    ano_mutex_unlock(&g_drainMtx);
     return 0;
 }
 
@@ -840,24 +1379,42 @@ int ano_log_init(void)
     }
     atomic_store_explicit(&g_drainerParked, false, memory_order_relaxed);
 
-    g_ring.mask  = ANO_LOG_RING_LINES - 1;
-    g_ring.shift = (uint32_t)__builtin_ctzll(ANO_LOG_RING_LINES);   // log2(N) for the lap counter
-    g_ring.buf   = ano_aligned_malloc(ANO_LOG_RING_BYTES, ANO_LOG_RING_ALIGN);
-    if (g_ring.buf == NULL) {
+    // Both rings share one arena. Every enqueue touches the shared ring, so it asks for huge pages
+    // (fewer TLB entries for the hottest buffer in the engine) on the node of the thread starting the
+    // logger. Falls back to normal pages, see ano_arena_init_ex.
+    size_t ringReserve = ANO_LOG_SPILL_BYTES + ANO_LOG_SPILL_ALIGN + ANO_LOG_RING_BYTES + ANO_LOG_RING_ALIGN;
+    if (ano_arena_init_ex(&g_ringArena, ringReserve, ANO_ARENA_HUGE | ANO_ARENA_NUMA_LOCAL) != 0) {
+        ano_thread_cond_destroy(&g_wakeCv); ano_mutex_destroy(&g_wakeMtx);
+        ano_mutex_destroy(&g_drainMtx); ano_mutex_destroy(&g_outFileMtx);
+        return -1;
+    }
+    // Spill first: the larger alignment goes where the arena base already provides it.
+    g_spill.buf = ano_arena_zalloc(&g_ringArena, ANO_LOG_SPILL_BYTES, ANO_LOG_SPILL_ALIGN);
+    g_ring.buf  = ano_arena_zalloc(&g_ringArena, ANO_LOG_RING_BYTES, ANO_LOG_RING_ALIGN);
+    if (g_ring.buf == NULL || g_spill.buf == NULL) {
+        ano_arena_destroy(&g_ringArena); g_ring.buf = NULL; g_spill.buf = NULL;
         ano_thread_cond_destroy(&g_wakeCv); ano_mutex_destroy(&g_wakeMtx);
         ano_mutex_destroy(&g_drainMtx); ano_mutex_destroy(&g_outFileMtx);
         return -1;
     }
-    memset(g_ring.buf, 0, ANO_LOG_RING_BYTES);
+    g_ring.mask  = ANO_LOG_RING_LINES - 1;
+    g_ring.shift = (uint32_t)__builtin_ctzll(ANO_LOG_RING_LINES);   // log2(N) for the lap counter
     atomic_store(&g_ring.tail, 0);
     atomic_store(&g_ring.head, 0);
 
+    g_spill.mask  = ANO_LOG_SPILL_LINES - 1;
+    g_spill.shift = (uint32_t)__builtin_ctzll(ANO_LOG_SPILL_LINES);
+    atomic_store(&g_spill.tail, 0);
+    atomic_store(&g_spill.head, 0);
+    for (int l = ANO_INFO; l <= ANO_FATAL; l++)
+        atomic_store_explicit(&g_dropped[l], 0, memory_order_relaxed);
+
     // Batch upper bound: all drained text (<= N*ANO_CL) plus a <= 16-byte prefix per record for at
     // most N records.
     g_batchCap = (size_t)ANO_LOG_RING_LINES * ANO_CL + (size_t)ANO_LOG_RING_LINES * 16 + 256;
-    g_batch = mi_malloc(g_batchCap);
+    g_batch = ano_tmalloc(&g_logMem, g_batchCap);
     if (g_batch == NULL) {
-        ano_aligned_free(g_ring.buf);
+        ano_arena_destroy(&g_ringArena); g_ring.buf = NULL; g_spill.buf = NULL;
         ano_thread_cond_destroy(&g_wakeCv); ano_mutex_destroy(&g_wakeMtx);
         ano_mutex_destroy(&g_drainMtx); ano_mutex_destroy(&g_outFileMtx);
         return -1;
@@ -865,6 +1422,17 @@ int ano_log_init(void)
     g_drainHMSValid = false;
     g_outFile = NULL;
 
+    // A string table that cannot be allocated degrades to text rather than failing init.
+    g_binOn = false;
+    if (atomic_load_explicit(&g_format, memory_order_relaxed) == ANO_LOG_BINARY
+        && (g_strTab = ano_tcalloc(&g_logMem, STRTAB_INIT, sizeof *g_strTab)) != NULL) {
+        g_strCap = STRTAB_INIT;
+        g_binOn  = true;
+    }
+
+    // A lanes setup failure degrades to the shared ring rather than failing init.
+    g_lanesOn = atomic_load_explicit(&g_mode, memory_order_relaxed) == ANO_LOG_LANES && lanes_open() == 0;
+
     console_color_init();   // decide ANSI capability before any echo
 
     g_anchorTicks  = ano_timestamp_ticks();
@@ -874,7 +1442,11 @@ int ano_log_init(void)
     ano_fspath dir = ano_fs_logpath();
     if (dir.length > 0)
         g_outFile = open_log(dir.str, true);
+    if (g_binOn && g_outFile != NULL)
+        bin_head(g_outFile);
     select_output();    // bind g_persist/g_syncOut/g_haveFile to the chosen output
+    g_kvOn = atomic_load_explicit(&g_columns, memory_order_relaxed) && dir.length > 0
+             && logkv_open(dir.str) == 0;
 
     atomic_store_explicit(&g_initialized, true, memory_order_release);
 
@@ -883,8 +1455,11 @@ int ano_log_init(void)
     if (ano_thread_create(&g_drainThread, NULL, drainer_main, NULL) != 0) {
         atomic_store_explicit(&g_drainRun, false, memory_order_relaxed);
         atomic_store_explicit(&g_initialized, false, memory_order_release);
-        ano_aligned_free(g_ring.buf); g_ring.buf = NULL;
-        mi_free(g_batch);             g_batch = NULL;
+        if (g_lanesOn) { lanes_close(); g_lanesOn = false; }
+        ano_arena_destroy(&g_ringArena); g_ring.buf = NULL; g_spill.buf = NULL;
+        ano_tfree(&g_logMem, g_batch);  g_batch = NULL;
+        ano_tfree(&g_logMem, g_strTab); g_strTab = NULL; g_binOn = false;
+        logkv_reset();                  g_kvOn = false;
         ano_thread_cond_destroy(&g_wakeCv); ano_mutex_destroy(&g_wakeMtx);
         ano_mutex_destroy(&g_drainMtx); ano_mutex_destroy(&g_outFileMtx);
         return -1;
@@ -917,6 +1492,8 @@ int ano_log_cleanup(void)
     ano_thread_join(g_drainThread, NULL);
 
     drain();    // one final drain, no producers remain by contract
+    logkv_reset();
+    g_kvOn = false;
 
     ano_mutex_lock(&g_outFileMtx);
     if (g_outFile != NULL) {
@@ -926,8 +1503,10 @@ int ano_log_cleanup(void)
     }
     ano_mutex_unlock(&g_outFileMtx);
 
-    ano_aligned_free(g_ring.buf); g_ring.buf = NULL;
-    mi_free(g_batch);             g_batch = NULL;
+    if (g_lanesOn) { lanes_close(); g_lanesOn = false; }
+    ano_arena_destroy(&g_ringArena); g_ring.buf = NULL; g_spill.buf = NULL;
+    ano_tfree(&g_logMem, g_batch);  g_batch = NULL;
+    ano_tfree(&g_logMem, g_strTab); g_strTab = NULL; g_binOn = false;
     ano_thread_cond_destroy(&g_wakeCv);
     ano_mutex_destroy(&g_wakeMtx);
     ano_mutex_destroy(&g_drainMtx);
@@ -11,6 +11,9 @@
 #include <anoptic_log.h>
 #include <anoptic_memory.h>   // ANO_CACHE_LINE
 
+// Accounting tag ("log") for the logger's heap buffers: drain batch, string table, kv events.
+extern ano_mem_tag_t g_logMem;
+
 // A stored line plus the wall-clock prefix total 4096 bytes. ANO_LOG_MSG_MAX is the stored cap.
 // ANO_LOG_TIME_RESV is the prefix budget. A max-size entry spans ceil((16 + MSG_MAX) / ANO_CL) <= 64 lines.
 #define ANO_LOG_TIME_RESV 16u                          // budget for the "HH:MM:SS " prefix
@@ -31,7 +34,36 @@
 _Static_assert((ANO_LOG_RING_BYTES & (ANO_LOG_RING_BYTES - 1)) == 0, "ring bytes must be a power of two");
 _Static_assert(ANO_LOG_RING_LINES >= 64, "ring must hold at least one max-size entry (64 lines)");
 
+// Lanes mode (ano_log_set_mode): one SPSC ring per producer thread, each ANO_LOG_LANE_BYTES, a power
+// of two. At most ANO_LOG_LANES_MAX lanes are live. Threads past the cap share the MPSC ring.
+// Override with: -DANO_LOG_LANE_BYTES (4 KiB to 2 MiB).
+#ifndef ANO_LOG_LANE_BYTES
+#define ANO_LOG_LANE_BYTES (64u * 1024u)
+#endif
+#define ANO_LOG_LANE_LINES (ANO_LOG_LANE_BYTES / ANO_CACHE_LINE)
+#define ANO_LOG_LANES_MAX  256u
+
+_Static_assert((ANO_LOG_LANE_BYTES & (ANO_LOG_LANE_BYTES - 1)) == 0, "lane bytes must be a power of two");
+_Static_assert(ANO_LOG_LANE_LINES >= 64, "lane must hold at least one max-size entry (64 lines)");
+
+// Spill ring (ANO_LOG_SPILL overflow policy): one more MPSC ring of the same layout, larger than the
+// shared one, that a spilling level's records overflow into when their ring is full.
+// Override with: -DANO_LOG_SPILL_BYTES (a power of two, at least ANO_LOG_RING_BYTES).
+#ifndef ANO_LOG_SPILL_BYTES
+#define ANO_LOG_SPILL_BYTES (4u * ANO_LOG_RING_BYTES)
+#endif
+#define ANO_LOG_SPILL_LINES (ANO_LOG_SPILL_BYTES / ANO_CACHE_LINE)
+#define ANO_LOG_SPILL_ALIGN (ANO_LOG_SPILL_BYTES < (2u << 20) ? ANO_LOG_SPILL_BYTES : (2u << 20))
+
+_Static_assert((ANO_LOG_SPILL_BYTES & (ANO_LOG_SPILL_BYTES - 1)) == 0, "spill bytes must be a power of two");
+_Static_assert(ANO_LOG_SPILL_BYTES >= ANO_LOG_RING_BYTES, "the spill ring is at least the shared ring");
+
 // One log file per session: "<stamp>" ANO_LOG_FILESUFFIX, the stamp from ano_fs_session_stamp().
 #define ANO_LOG_FILESUFFIX "_ano.log"
+#define ANO_LOG_BINSUFFIX  "_ano.alog"     // ANO_LOG_BINARY sessions, see log_format.h
+
+// Deferred capture (log_core.c), shared with the crash trace (log_trace.c): fmt's args into a blob that
+// format_deferred (log_format.h) renders later. Layout and limits at the definition.
+int log_capture_deferred(char *out, int cap, const char *file, int line, const char *fmt, va_list ap);
 
 #endif //ANOPTICENGINE_LOG_CORE_H
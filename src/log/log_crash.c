@@ -26,6 +26,10 @@ static void investigate_previous_flight(const char *dir)
     const char *stamp = ano_fs_session_stamp();
     bb_prune_suffix(dir, "_CRASH.log", BB_KEEP_LOGS, stamp);
     bb_prune_suffix(dir, "_ano.log",   BB_KEEP_LOGS, stamp);
+    bb_prune_suffix(dir, "_ano.alog",  BB_KEEP_LOGS, stamp);
+    bb_prune_suffix(dir, "_kv.csv",    8, stamp);   // one per event, so more than a session's worth
+    bb_prune_suffix(dir, "_trace.json", BB_KEEP_LOGS, stamp);
+    bb_prune_suffix(dir, "_trace.ring", BB_KEEP_LOGS, stamp);
 }
 
 int ano_log_crash_init(void)
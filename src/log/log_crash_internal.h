@@ -45,6 +45,15 @@ static inline void bb_top_insert(bb_prune_t top[], int cap, int *n, unsigned lon
     if (*n < cap) (*n)++;
 }
 
+// Crash trace file, per-platform: create `path` as `bytes` of zeros and map it shared read-write. Calm time only. Output: the mapping, NULL on failure.
+void *bb_trace_map(const char *path, size_t bytes);
+
+// Write the mapping back to its file and unmap it. Calm time only.
+void bb_trace_unmap(void *base, size_t bytes);
+
+// Stage 2 hook, common: stamp `code` into the live trace file's head. One store, async-signal-safe, a no-op with no trace.
+void bb_trace_fault(int code);
+
 // Per-thread Stage 1, per-platform: arm/release the calling thread's crash stack (see ano_log_crash_thread_arm). Output: 0 on success, -1 if the OS refused.
 int  bb_thread_arm(void);
 void bb_thread_disarm(void);
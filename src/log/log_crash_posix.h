@@ -18,6 +18,7 @@
 #include <stdatomic.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <time.h>
 #include <unistd.h>
@@ -184,6 +185,9 @@ static void bb_handler(int sig, siginfo_t *info, void *uctx)
         sigaction(bb_hooked[i].sig, &dfl, NULL);
     }
 
+    // The trace ring needs nothing at fault time, its pages are already the kernel's. Just say why it stops.
+    bb_trace_fault(sig);
+
     const char *name = "unhooked signal";
     for (size_t i = 0; i < BB_NHOOKED; i++)
         if (bb_hooked[i].sig == sig) { name = bb_hooked[i].name; break; }
@@ -318,6 +322,24 @@ int bb_install(void)
     return rc;
 }
 
+// Contract in log_crash_internal.h. ftruncate extends with zeros, so the fresh ring holds no live tag.
+void *bb_trace_map(const char *path, size_t bytes)
+{
+    int fd = open(path, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0)
+        return NULL;
+    void *base = ftruncate(fd, (off_t)bytes) == 0
+               ? mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+    close(fd);  // the mapping holds the file
+    return base == MAP_FAILED ? NULL : base;
+}
+
+void bb_trace_unmap(void *base, size_t bytes)
+{
+    msync(base, bytes, MS_SYNC);
+    munmap(base, bytes);
+}
+
 // sigaltstack state is thread-local: bb_install covers only the installing (main) thread. Every other thread arms here at spawn and releases at exit. Idempotent per thread.
 static _Thread_local char *bb_threadAltStack;
 
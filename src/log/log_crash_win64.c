@@ -98,6 +98,9 @@ static void bb_record_and_flush(const EXCEPTION_POINTERS *xp, const char *signam
 {
     SetEvent(bb_deadmanEvent);
 
+    // The trace ring needs nothing at fault time, its pages are already the kernel's. Just say why it stops.
+    bb_trace_fault(xp != NULL ? (int)xp->ExceptionRecord->ExceptionCode : -1);
+
     // Stage 2: the flight record. FILE_APPEND_DATA: never destroys a previous record.
     HANDLE h = CreateFileA(bb_crashPath, FILE_APPEND_DATA, FILE_SHARE_READ, NULL,
                            OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
@@ -194,6 +197,27 @@ static void bb_on_signal(int sig)
     raise(sig);     // default disposition: the CRT's own exit for this signal
 }
 
+// Contract in log_crash_internal.h. The file handle closes once the view holds the section.
+void *bb_trace_map(const char *path, size_t bytes)
+{
+    HANDLE f = CreateFileA(path, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, NULL, CREATE_ALWAYS,
+                           FILE_ATTRIBUTE_NORMAL, NULL);
+    if (f == INVALID_HANDLE_VALUE)
+        return NULL;
+    HANDLE m = CreateFileMappingA(f, NULL, PAGE_READWRITE, (DWORD)((uint64_t)bytes >> 32), (DWORD)bytes, NULL);
+    void *base = m != NULL ? MapViewOfFile(m, FILE_MAP_WRITE, 0, 0, bytes) : NULL;
+    if (m != NULL)
+        CloseHandle(m);
+    CloseHandle(f);
+    return base;
+}
+
+void bb_trace_unmap(void *base, size_t bytes)
+{
+    FlushViewOfFile(base, bytes);
+    UnmapViewOfFile(base);
+}
+
 // Stage 4 scan, calm time only. The suffix recheck guards against 8.3 short-name pattern hits.
 // Contract in log_crash_internal.h.
 int bb_scan_suffix(const char *dir, const char *suffix, char *newest)
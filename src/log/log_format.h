@@ -0,0 +1,282 @@
+/* SPDX-FileCopyrightText: 2023 Anoptic Game Engine Authors
+ *
+ * SPDX-License-Identifier: LGPL-3.0 */
+/*  == Anoptic Game Engine v0.0000001 == */
+
+// Drain-side rendering of a deferred capture blob or a structured (KV) blob, and the binary session-file layout. Shared by the
+// logger (log_core.c) and the offline decoder (tools/anolog_decode.c), so both render the same bytes.
+// Depends only on libc and anoptic_log.h.
+
+#ifndef ANOPTICENGINE_LOG_FORMAT_H
+#define ANOPTICENGINE_LOG_FORMAT_H
+
+#include <anoptic_log.h>
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+
+/* Binary session file (ano_log_set_format(ANO_LOG_BINARY)) */
+
+// A stream of packed records, each led by one kind byte. Host byte order and pointer width: decode on
+// the writer's architecture. Fields are unaligned, read and written with memcpy.
+//   'H' head    : "ANOLOGB" version:u8 anchorTicks:u64 anchorUnixNs:u64 calTicks:u64 calNs:u64
+//                 utcOffset:i32 msgMax:u32
+//   'S' string  : id:u32 len:u16 bytes                  a format string or source file, once per file
+//   'D' capture : level:u8 ticks:u64 fmt:u32 file:u32 line:i32 argLen:u16 args    file 0 = none
+//   'T' text    : level:u8 ticks:u64 len:u16 bytes      finished text (eager fallback, NOW, wedge escape)
+// A head opens every file and repeats when a redirect appends to one, resetting the string ids. A
+// capture's args are the blob's typed values verbatim, so the decoder rebuilds the blob around its own
+// copies of the strings and renders it with format_deferred. calNs = ano_ticks_to_ns(calTicks) carries
+// the tick rate, utcOffset the local-time offset at open (seconds, DST changes mid-file are not tracked).
+#define ANO_LOGBIN_MAGIC      "ANOLOGB"
+#define ANO_LOGBIN_VERSION    1u
+
+enum {
+    ANO_LOGBIN_HEAD    = 'H',
+    ANO_LOGBIN_STRING  = 'S',
+    ANO_LOGBIN_CAPTURE = 'D',
+    ANO_LOGBIN_TEXT    = 'T',
+};
+
+#define ANO_LOGBIN_HEAD_BYTES    (1u + 7u + 1u + 4u * 8u + 4u + 4u)
+#define ANO_LOGBIN_STRING_BYTES  (1u + 4u + 2u)
+#define ANO_LOGBIN_CAPTURE_BYTES (1u + 1u + 8u + 4u + 4u + 4u + 2u)
+#define ANO_LOGBIN_TEXT_BYTES    (1u + 1u + 8u + 2u)
+
+// Append n bytes of v at p, advance.
+static inline char *logbin_put(char *p, const void *v, size_t n)
+{
+    memcpy(p, v, n);
+    return p + n;
+}
+
+
+/* Rendering */
+
+// Level names padded to 5.
+static const char   logPad[4][8] = {"INFO ", "WARN ", "ERROR", "FATAL"};
+
+// Decimal of v at p, advance. No printf machinery.
+static inline char *put_u32(char *p, uint32_t v)
+{
+    char tmp[10];
+    int i = 0;
+    do { tmp[i++] = (char)('0' + v % 10); v /= 10; } while (v);
+    while (i) *p++ = tmp[--i];
+    return p;
+}
+
+static const char digLo[] = "0123456789abcdef";
+static const char digUp[] = "0123456789ABCDEF";
+
+// Unsigned v in base (8/10/16) via digits, into [p,end). NULL if it would overrun.
+static char *put_base(char *p, char *end, unsigned long long v, unsigned base, const char *digits)
+{
+    char tmp[24];
+    int  i = 0;
+    do { tmp[i++] = digits[v % base]; v /= base; } while (v);
+    if (p + i > end) return NULL;
+    while (i) *p++ = tmp[--i];
+    return p;
+}
+
+// Render a capture blob at drain: prefix (level/file/line) then the message. Re-parses fmt, rebuilds each
+// conversion's spec with any '*' resolved from the captured ints, and lets snprintf do the actual format
+// from the captured value. Byte-for-byte printf for everything log_capture_deferred accepts. Returns bytes.
+static int format_deferred(char *out, int cap, ano_loglevel_t level, const char *blob)
+{
+    const char *b = blob;
+    const char *file; memcpy(&file, b, sizeof file); b += sizeof file;
+    int line = 0;
+    if (file != NULL) { memcpy(&line, b, sizeof line); b += sizeof line; }
+    const char *fmt;  memcpy(&fmt,  b, sizeof fmt);  b += sizeof fmt;
+
+    char *p = out, *end = out + cap;
+    memcpy(p, (unsigned)level <= ANO_FATAL ? logPad[level] : "?????", 5); p += 5;
+    *p++ = ' ';
+    if (file != NULL) {
+        size_t fl = strnlen(file, 256); memcpy(p, file, fl); p += fl;
+        *p++ = ':';
+        p = put_u32(p, (uint32_t)(line < 0 ? 0 : line));
+        *p++ = ':'; *p++ = ' '; *p++ = ' ';
+    }
+
+    for (const char *f = fmt; *f; ++f) {
+        if (*f != '%') { if (p < end) *p++ = *f; continue; }
+        ++f;
+        if (*f == '%') { if (p < end) *p++ = '%'; continue; }
+        // Fast plain path: % [l|ll|z|t|j](d i u o x X c s), no flags/width/precision/h. Hand-rolled, no
+        // spec build, no libc.
+        {
+            const char *g = f;
+            int plng = 0;
+            while (*g == 'l') { ++plng; ++g; }
+            if (*g == 'z' || *g == 't' || *g == 'j') { plng = 2; ++g; }
+            char pc = *g;
+            if ((pc=='d'||pc=='i'||pc=='u'||pc=='o'||pc=='x'||pc=='X'||pc=='c'||pc=='s') && end - p > 1) {
+                if (pc == 'd' || pc == 'i') {
+                    long long v;
+                    if (plng >= 1) { memcpy(&v, b, 8); b += 8; } else { int iv; memcpy(&iv, b, 4); b += 4; v = iv; }
+                    if (v < 0 && p < end) *p++ = '-';
+                    unsigned long long m = v < 0 ? 0ull - (unsigned long long)v : (unsigned long long)v;
+                    char *q = put_base(p, end, m, 10, digLo); if (q) p = q;
+                } else if (pc == 'c') {
+                    int iv; memcpy(&iv, b, 4); b += 4; if (p < end) *p++ = (char)iv;
+                } else if (pc == 's') {
+                    uint16_t sl; memcpy(&sl, b, 2); b += 2;
+                    if (p + sl <= end) { memcpy(p, b, sl); p += sl; } b += (size_t)sl + 1;
+                } else {
+                    unsigned long long v;
+                    if (plng >= 1) { memcpy(&v, b, 8); b += 8; } else { unsigned uv; memcpy(&uv, b, 4); b += 4; v = uv; }
+                    unsigned base = pc == 'o' ? 8u : pc == 'u' ? 10u : 16u;
+                    char *q = put_base(p, end, v, base, pc == 'X' ? digUp : digLo); if (q) p = q;
+                }
+                f = g;
+                continue;
+            }
+        }
+
+        // Fancy: flags/width/precision/'*'/h/float/%p. Rebuild the spec with '*' resolved, then snprintf.
+        char spec[48];
+        int  si = 0;
+        spec[si++] = '%';
+#define SPEC_PUT(ch) do { if (si < (int)sizeof spec - 2) spec[si++] = (ch); } while (0)
+        while (*f=='-'||*f=='+'||*f==' '||*f=='#'||*f=='0') SPEC_PUT(*f++);
+        if (*f == '*') {                                                             // width from arg
+            int w; memcpy(&w, b, 4); b += 4; ++f;
+            if (w < 0) { SPEC_PUT('-'); w = -w; }                                     // negative = left justify
+            if (w != 0) { char *sp = put_u32(spec + si, (uint32_t)w); si = (int)(sp - spec); }  // 0 = no width
+        } else while (*f >= '0' && *f <= '9') SPEC_PUT(*f++);
+        if (*f == '.') {                                                            // precision
+            ++f;
+            if (*f == '*') {
+                int pr; memcpy(&pr, b, 4); b += 4; ++f;
+                if (pr >= 0) { SPEC_PUT('.'); char *sp = put_u32(spec + si, (uint32_t)pr); si = (int)(sp - spec); }
+            } else { SPEC_PUT('.'); while (*f >= '0' && *f <= '9') SPEC_PUT(*f++); }
+        }
+        int lng = 0;
+        while (*f == 'l') { ++lng; SPEC_PUT(*f++); }
+        if (*f == 'z' || *f == 't' || *f == 'j') { lng = 2; SPEC_PUT(*f++); }
+        while (*f == 'h') SPEC_PUT(*f++);
+        char c = *f; SPEC_PUT(c); spec[si] = '\0';
+#undef SPEC_PUT
+        int rem = (int)(end - p);
+        if (rem <= 1) break;
+
+        int wrote = 0;
+// GCC diagnostic spelling, honored by both gcc and clang.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wformat-nonliteral"
+        switch (c) {
+        case 'd': case 'i':
+            if (lng >= 2)      { long long v; memcpy(&v, b, 8); b += 8; wrote = snprintf(p, (size_t)rem, spec, v); }
+            else if (lng == 1) { long long v; memcpy(&v, b, 8); b += 8; wrote = snprintf(p, (size_t)rem, spec, (long)v); }
+            else               { int v; memcpy(&v, b, 4); b += 4;       wrote = snprintf(p, (size_t)rem, spec, v); }
+            break;
+        case 'u': case 'o': case 'x': case 'X':
+            if (lng >= 2)      { unsigned long long v; memcpy(&v, b, 8); b += 8; wrote = snprintf(p, (size_t)rem, spec, v); }
+            else if (lng == 1) { unsigned long long v; memcpy(&v, b, 8); b += 8; wrote = snprintf(p, (size_t)rem, spec, (unsigned long)v); }
+            else               { unsigned v; memcpy(&v, b, 4); b += 4;          wrote = snprintf(p, (size_t)rem, spec, v); }
+            break;
+        case 'e': case 'E': case 'f': case 'F': case 'g': case 'G': case 'a': case 'A':
+            { double v; memcpy(&v, b, 8); b += 8; wrote = snprintf(p, (size_t)rem, spec, v); } break;
+        case 'c': { int v; memcpy(&v, b, 4); b += 4; wrote = snprintf(p, (size_t)rem, spec, v); } break;
+        case 'p': { void *v; memcpy(&v, b, 8); b += 8; wrote = snprintf(p, (size_t)rem, spec, v); } break;
+        case 's': { uint16_t sl; memcpy(&sl, b, 2); b += 2; const char *s = b; b += (size_t)sl + 1;
+                    wrote = snprintf(p, (size_t)rem, spec, s); } break;
+        default: break;
+        }
+#pragma GCC diagnostic pop
+        if (wrote < 0) wrote = 0;
+        if (wrote > rem - 1) wrote = rem - 1;   // snprintf truncated to rem-1 chars plus its NUL
+        p += wrote;
+    }
+    return (int)(p - out);
+}
+
+
+/* Structured records (ano_log_kv) */
+
+// Blob: [const char *event][count:u8] then per field [const char *key][type:u8][value]. A U64, F64 or SID
+// value is 8 bytes, a STR is len:u16 then the bytes, unterminated. event and keys are string literals
+// stored as pointers, like a capture's fmt. Rides the ring flagged ANO_LOG_DEFERRED | ANO_LOG_KV.
+
+// One field of a KV blob, decoded. str points into the blob.
+typedef struct {
+    const char *key;
+    uint8_t     type;
+    uint16_t    len;
+    const char *str;
+    union { uint64_t u64; double f64; };
+} logkv_field_t;
+
+// Decode the field at *b and advance past it.
+static inline void logkv_next(const char **b, logkv_field_t *f)
+{
+    const char *p = *b;
+    memcpy(&f->key, p, sizeof f->key); p += sizeof f->key;
+    f->type = (uint8_t)*p++;
+    if (f->type == ANO_KV_STR) {
+        memcpy(&f->len, p, 2); p += 2;
+        f->str = p; p += f->len;
+    } else {
+        memcpy(&f->u64, p, 8); p += 8;
+    }
+    *b = p;
+}
+
+// Render one field's value (no key) into [p,end). Returns the new p, clamped at end.
+static inline char *logkv_value(char *p, char *end, const logkv_field_t *f, bool exact)
+{
+    int rem = (int)(end - p);
+    if (rem <= 1) return p;
+    int wrote = 0;
+    switch (f->type) {
+    case ANO_KV_U64: { char *q = put_base(p, end, f->u64, 10, digLo); return q ? q : p; }
+    case ANO_KV_F64: wrote = snprintf(p, (size_t)rem, exact ? "%.17g" : "%g", f->f64); break;
+    case ANO_KV_SID: wrote = snprintf(p, (size_t)rem, "%016llx", (unsigned long long)f->u64); break;
+    case ANO_KV_STR: wrote = f->len < rem ? f->len : rem - 1; memcpy(p, f->str, (size_t)wrote); break;
+    default: break;
+    }
+    if (wrote < 0) wrote = 0;
+    if (wrote > rem - 1) wrote = rem - 1;
+    return p + wrote;
+}
+
+// Render a KV blob at drain: prefix, the event, then " key=value" per field. Returns bytes.
+static inline int format_kv(char *out, int cap, ano_loglevel_t level, const char *blob)
+{
+    const char *b = blob;
+    const char *event; memcpy(&event, b, sizeof event); b += sizeof event;
+    uint8_t count = (uint8_t)*b++;
+
+    char *p = out, *end = out + cap;
+    memcpy(p, (unsigned)level <= ANO_FATAL ? logPad[level] : "?????", 5); p += 5;
+    *p++ = ' ';
+    size_t el = strnlen(event, 256);
+    if (el > (size_t)(end - p)) el = (size_t)(end - p);
+    memcpy(p, event, el); p += el;
+    for (uint8_t i = 0; i < count; i++) {
+        logkv_field_t f;
+        logkv_next(&b, &f);
+        size_t kl = strnlen(f.key, 256);
+        if ((size_t)(end - p) < kl + 3) break;
+        *p++ = ' ';
+        memcpy(p, f.key, kl); p += kl;
+        *p++ = '=';
+        p = logkv_value(p, end, &f, false);
+    }
+    return (int)(p - out);
+}
+
+// Render either blob kind: a KV record or a printf capture.
+static inline int format_blob(char *out, int cap, ano_loglevel_t level, bool kv, const char *blob)
+{
+    return kv ? format_kv(out, cap, level, blob) : format_deferred(out, cap, level, blob);
+}
+
+#endif //ANOPTICENGINE_LOG_FORMAT_H
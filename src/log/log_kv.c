@@ -0,0 +1,217 @@
+/* SPDX-FileCopyrightText: 2026 Anoptic Game Engine Authors
+ *
+ * SPDX-License-Identifier: LGPL-3.0 */
+/*  == Anoptic Game Engine v0.0000001 == */
+
+// Column export for structured records. Each event's first record fixes its columns and opens
+// <dir>/<stamp>_<event>_kv.csv with a "ts_ns,key,..." header. Every later record of the event appends one
+// row, rendered into a per-event buffer that goes out in one write per drain pass. ts_ns is Unix time in
+// nanoseconds, so rows from several events join on it. Values are plain CSV: U64 decimal, F64 round-trip
+// %.17g, SID 16 hex digits, STR quoted when it holds a comma, quote or line break.
+
+#include "log/log_kv.h"
+#include "log/log_core.h"
+#include "log/log_format.h"
+
+#include <anoptic_filesystem.h>
+
+#include <mimalloc.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#define KV_EVENTS   64u             // events exported per session, later ones stay text-only
+#define KV_DIRS     8u              // directories remembered per session for the header-once rule
+#define KV_NAME     64u             // event name bytes kept for the file name
+#define KV_BUF      (32u * 1024u)   // per-event row buffer
+// Worst-case row: the stamp, every separator, 24 bytes per number, and a blob's worth of string bytes
+// with every one a doubled quote.
+#define KV_ROW_MAX  (24u + ANO_LOG_KV_MAX * 26u + 2u * ANO_LOG_MSG_MAX + 8u)
+
+_Static_assert(KV_BUF >= KV_ROW_MAX, "a row buffer holds at least one worst-case row");
+
+typedef struct {
+    const char *event;                      // the first record's literal
+    char        name[KV_NAME];              // file-name safe copy
+    uint8_t     count;
+    uint8_t     dirs;                       // bit i: this session wrote the header into g_dirs[i]
+    uint8_t     type[ANO_LOG_KV_MAX];
+    const char *key[ANO_LOG_KV_MAX];
+    ano_file   *f;
+    char       *buf;
+    size_t      blen;
+} kv_event_t;
+
+static kv_event_t g_ev[KV_EVENTS];
+static uint32_t   g_evCount;
+static char       g_dirs[KV_DIRS][MAXPATH];
+static uint32_t   g_dirCount;
+static uint32_t   g_dir = KV_DIRS;          // index of the bound directory, KV_DIRS when untracked
+static char       g_curDir[MAXPATH];
+static bool       g_bound;
+
+// Two literals name the same thing: one pointer, or equal text from another translation unit.
+static inline bool same_str(const char *a, const char *b)
+{
+    return a == b || strcmp(a, b) == 0;
+}
+
+int logkv_open(const char *dir)
+{
+    g_bound = false;
+    if (dir == NULL)
+        return 0;
+    size_t n = strlen(dir);
+    if (n >= MAXPATH)
+        return -1;
+    memcpy(g_curDir, dir, n + 1);
+    g_dir = KV_DIRS;
+    for (uint32_t i = 0; i < g_dirCount && g_dir == KV_DIRS; i++)
+        if (strcmp(g_dirs[i], dir) == 0) g_dir = i;
+    if (g_dir == KV_DIRS && g_dirCount < KV_DIRS) {
+        memcpy(g_dirs[g_dirCount], dir, n + 1);
+        g_dir = g_dirCount++;
+    }
+    g_bound = true;
+    return 0;
+}
+
+// Look up the blob's event, registering it (and its columns) on first sight. NULL when the table is full.
+static kv_event_t *event_for(const char *event, const char *fields, uint8_t count)
+{
+    for (uint32_t i = 0; i < g_evCount; i++)
+        if (same_str(g_ev[i].event, event)) return &g_ev[i];
+    if (g_evCount == KV_EVENTS)
+        return NULL;
+    char *buf = ano_tmalloc(&g_logMem, KV_BUF);
+    if (buf == NULL)
+        return NULL;
+    kv_event_t *e = &g_ev[g_evCount++];
+    memset(e, 0, sizeof *e);
+    e->event = event;
+    e->buf   = buf;
+    size_t k = 0;
+    for (const char *s = event; *s && k < KV_NAME - 1; s++, k++) {
+        char c = *s;
+        bool ok = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' || c == '-';
+        e->name[k] = ok ? c : '_';
+    }
+    e->count = count;
+    const char *b = fields;
+    for (uint8_t i = 0; i < count; i++) {
+        logkv_field_t f;
+        logkv_next(&b, &f);
+        e->key[i]  = f.key;
+        e->type[i] = f.type;
+    }
+    return e;
+}
+
+// Open the event's file in the bound directory. The first open there this session truncates and writes
+// the header, a reopen after a redirect back appends. Past KV_DIRS directories, append with a header.
+static bool event_open(kv_event_t *e)
+{
+    char path[MAXPATH];
+    int n = snprintf(path, sizeof path, "%s/%s_%s_kv.csv", g_curDir, ano_fs_session_stamp(), e->name);
+    if (n <= 0 || n >= (int)sizeof path)
+        return false;
+    bool tracked = g_dir < KV_DIRS;
+    bool fresh   = !tracked || !(e->dirs & (1u << g_dir));
+    e->f = tracked && fresh ? ano_fs_open_trunc(path) : ano_fs_open_append(path);
+    if (e->f == NULL)
+        return false;
+    if (fresh) {
+        char *p = e->buf + e->blen;
+        memcpy(p, "ts_ns", 5); p += 5;
+        for (uint8_t i = 0; i < e->count; i++) {
+            size_t kl = strnlen(e->key[i], 128);
+            *p++ = ',';
+            memcpy(p, e->key[i], kl); p += kl;
+        }
+        *p++ = '\n';
+        e->blen = (size_t)(p - e->buf);
+        if (tracked) e->dirs |= (uint8_t)(1u << g_dir);
+    }
+    return true;
+}
+
+static void event_write(kv_event_t *e)
+{
+    if (e->blen > 0 && e->f != NULL)
+        ano_fs_write(e->f, e->buf, e->blen);
+    e->blen = 0;
+}
+
+void logkv_row(uint64_t unixNs, const char *blob)
+{
+    if (!g_bound)
+        return;
+    const char *b = blob;
+    const char *event; memcpy(&event, b, sizeof event); b += sizeof event;
+    uint8_t count = (uint8_t)*b++;
+    kv_event_t *e = event_for(event, b, count);
+    if (e == NULL || e->count != count)
+        return;
+    // Schema check first: a partial row must never reach the buffer.
+    const char *v = b;
+    for (uint8_t i = 0; i < count; i++) {
+        logkv_field_t f;
+        logkv_next(&v, &f);
+        if (f.type != e->type[i] || !same_str(f.key, e->key[i]))
+            return;
+    }
+    if (e->f == NULL && !event_open(e))
+        return;
+    if (KV_BUF - e->blen < KV_ROW_MAX)
+        event_write(e);
+
+    char *p = e->buf + e->blen, *end = e->buf + KV_BUF;
+    p = put_base(p, end, unixNs, 10, digLo);
+    for (uint8_t i = 0; i < count; i++) {
+        logkv_field_t f;
+        logkv_next(&b, &f);
+        *p++ = ',';
+        if (f.type == ANO_KV_STR && (memchr(f.str, ',', f.len) || memchr(f.str, '"', f.len)
+                                     || memchr(f.str, '\n', f.len) || memchr(f.str, '\r', f.len))) {
+            *p++ = '"';
+            for (uint16_t j = 0; j < f.len; j++) {
+                if (f.str[j] == '"') *p++ = '"';
+                *p++ = f.str[j];
+            }
+            *p++ = '"';
+        } else {
+            p = logkv_value(p, end, &f, true);
+        }
+    }
+    *p++ = '\n';
+    e->blen = (size_t)(p - e->buf);
+}
+
+void logkv_flush(void)
+{
+    for (uint32_t i = 0; i < g_evCount; i++)
+        event_write(&g_ev[i]);
+}
+
+void logkv_close(void)
+{
+    logkv_flush();
+    for (uint32_t i = 0; i < g_evCount; i++) {
+        if (g_ev[i].f != NULL) {
+            ano_fs_close(g_ev[i].f);
+            g_ev[i].f = NULL;
+        }
+    }
+    g_bound = false;
+}
+
+void logkv_reset(void)
+{
+    logkv_close();
+    for (uint32_t i = 0; i < g_evCount; i++)
+        ano_tfree(&g_logMem, g_ev[i].buf);
+    memset(g_ev, 0, sizeof g_ev);
+    g_evCount  = 0;
+    g_dirCount = 0;
+    g_dir      = KV_DIRS;
+}
@@ -0,0 +1,32 @@
+/* SPDX-FileCopyrightText: 2026 Anoptic Game Engine Authors
+ *
+ * SPDX-License-Identifier: LGPL-3.0 */
+/*  == Anoptic Game Engine v0.0000001 == */
+
+// Column export for structured records (ano_log_set_columns), fed by the drainer (log_core.c). One CSV
+// per event and session: ts_ns then one column per key, in the order of the event's first record. Every
+// call runs under g_drainMtx, or before the drainer exists and after it is joined.
+
+#ifndef ANOPTICENGINE_LOG_KV_H
+#define ANOPTICENGINE_LOG_KV_H
+
+#include <stdint.h>
+
+// Bind the export to dir. Files open on each event's first row. NULL unbinds. Returns 0, -1 if too long.
+int  logkv_open(const char *dir);
+
+// Append one row for a KV blob (log_format.h layout), stamped unixNs. A record whose keys or types differ
+// from its event's first record is skipped: the columns stay rectangular.
+void logkv_row(uint64_t unixNs, const char *blob);
+
+// Write every buffered row out. The drainer calls it once per pass.
+void logkv_flush(void);
+
+// Flush, close every event file, and unbind. The header memory is kept: a later open into a directory
+// this session already wrote appends below the existing header.
+void logkv_close(void);
+
+// Free everything, forget every directory. Session end.
+void logkv_reset(void);
+
+#endif //ANOPTICENGINE_LOG_KV_H
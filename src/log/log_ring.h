@@ -9,8 +9,9 @@
 // copies the line in, and publishes with one release store of `tag`. The consumer walks claim order,
 // emits, and frees the range with one `head` store. A slot is live iff its tag is committed and carries
 // the current lap (`cycle`), so reuse needs no zeroing. Only `tag` is synchronized. Timestamp and text
-// ride its release/acquire as plain memory.
-// Migrates to anoptic_collections.h at the lock-free port.
+// ride its release/acquire as plain memory. Lanes mode gives each producer thread its own ring of the
+// same layout (log_lane_t), so the reserve drops to a plain store.
+// Not an anoptic_collections.h queue: records are variable-length line runs, not fixed-size elements.
 
 #ifndef ANOPTICENGINE_LOG_RING_H
 #define ANOPTICENGINE_LOG_RING_H
@@ -19,6 +20,7 @@
 
 #include <anoptic_memory.h>          // ANO_CACHE_LINE / ANO_THREAD_LINE
 #include <stdatomic.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <string.h>
 
@@ -33,6 +35,7 @@ enum {
     ANO_LOG_DEFERRED  = 1 << 1, // body is a deferred-format capture blob, not finished text (§9 proto)
     ANO_LOG_TOFILE    = 1 << 2, // sink: batched to the output file at drain
     ANO_LOG_TOCON     = 1 << 3, // sink: echoed to the terminal at drain
+    ANO_LOG_KV        = 1 << 4, // with DEFERRED: the blob is a structured key/value capture (ano_log_kv)
 };
 
 // An entry's head line begins with this 16-byte marker. The rest of the head line and every
@@ -70,6 +73,15 @@ typedef struct {
     char        *buf;   // N*ANO_CL bytes, cache-line aligned
 } log_ring_t;
 
+// A producer lane: a log_ring_t with exactly one producer (the owning thread) and the one consumer.
+// Same lines, marker, and lap tags as the shared ring. Only the reserve differs: the owner bumps `tail`
+// with a plain store, no CAS. `live` drops at thread exit so a drained lane can be adopted by the next
+// thread instead of growing the lane table.
+typedef struct {
+    log_ring_t   ring;
+    _Atomic bool live;  // an owning thread holds it. Release on retire, acquire on adopt.
+} log_lane_t;
+
 // The lap a monotonic line position belongs to, low 32 bits. A committed tag carries its own lap. The
 // drainer compares against this so a reclaimed slot's old tag never reads as live without zeroing.
 static inline uint32_t log_cycle(const log_ring_t *r, uint64_t pos) { return (uint32_t)(pos >> r->shift); }
@@ -0,0 +1,196 @@
+/* SPDX-FileCopyrightText: 2026 Anoptic Game Engine Authors
+ *
+ * SPDX-License-Identifier: LGPL-3.0 */
+/*  == Anoptic Game Engine v0.0000001 == */
+
+// Crash trace ring writer (anoptic_log_crash.h). The logger's ring with the opposite durability policy:
+// the lines live in a shared file mapping (log_trace.h), producers overwrite the oldest instead of
+// waiting, and nothing ever drains or zeroes them. A record is the logger's deferred capture with the
+// format pointer swapped for an id into the file's own format table, so a reader in another process
+// can render it. The per-platform mapping lives with the crash hooks.
+
+#include <anoptic_log_crash.h>
+#include <anoptic_filesystem.h>
+#include <anoptic_time.h>
+
+#include "log/log_core.h"
+#include "log/log_ring.h"
+#include "log/log_trace.h"
+#include "log/log_crash_internal.h"
+
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <process.h>
+#define trace_pid() _getpid()
+#else
+#include <unistd.h>
+#define trace_pid() getpid()
+#endif
+
+// Ring capacity in BYTES, a power of two. Override with -DANO_TRACE_RING_BYTES (64 KiB and up).
+#ifndef ANO_TRACE_RING_BYTES
+#define ANO_TRACE_RING_BYTES (1024u * 1024u)
+#endif
+#define ANO_TRACE_STR_BYTES  (64u * 1024u)  // format table, page-granular
+
+_Static_assert((ANO_TRACE_RING_BYTES & (ANO_TRACE_RING_BYTES - 1)) == 0, "trace ring bytes must be a power of two");
+_Static_assert(ANO_TRACE_RING_BYTES / ANO_CACHE_LINE >= 64, "trace ring holds a few max-size records");
+_Static_assert(ANOTRACE_COMMITTED == ANO_LOG_COMMITTED && ANOTRACE_DEFERRED == ANO_LOG_DEFERRED,
+               "trace flags are the ring's");
+_Static_assert(sizeof(anotrace_word_t) == sizeof(log_word_t) && ANOTRACE_MARKER == ANO_LOG_HDR,
+               "trace tag and marker are the ring's");
+_Static_assert(ANOTRACE_BODY_MAX <= ANO_LOG_MSG_MAX, "a trace body fits a log capture");
+
+#define TRACE_FILE_BYTES ((size_t)ANOTRACE_HEAD_BYTES + ANO_TRACE_STR_BYTES + ANO_TRACE_RING_BYTES)
+
+static anotrace_head_t *_Atomic g_th;      // the mapped head, NULL when off. The fault hook reads it.
+static log_ring_t        g_tr;             // view over the mapped lines: mask, shift, buf. Cursors unused.
+static char             *g_tstr;           // format table
+static atomic_bool       g_trOn;
+static _Atomic uint32_t  g_trGen;          // bumps per init, so a site's id from an earlier file misses
+static _Atomic uint32_t  g_trTids;
+static _Thread_local uint32_t t_trTid;
+static char              g_trPath[MAXPATH];
+
+
+// The site's format id in the current file, interned on the site's first record this session. Two
+// threads racing a site's first record each copy the format. Harmless, one id wins the site. 0 when the
+// table is full: the record keeps its args and renders without a format.
+static uint32_t trace_format(ano_tracesite_t *site, const char *fmt, uint32_t gen)
+{
+    uint64_t s = atomic_load_explicit(&site->id, memory_order_acquire);
+    if ((uint32_t)(s >> 32) == gen)
+        return (uint32_t)s;
+    size_t   n    = strnlen(fmt, ANOTRACE_BODY_MAX);
+    uint32_t need = (uint32_t)(2u + n + 1u);
+    uint32_t off  = atomic_fetch_add_explicit(&g_th->strUsed, need, memory_order_relaxed);
+    uint32_t id   = 0;
+    if (off <= ANO_TRACE_STR_BYTES - need) {
+        uint16_t n16 = (uint16_t)n;
+        memcpy(g_tstr + off, &n16, 2);
+        memcpy(g_tstr + off + 2, fmt, n);
+        g_tstr[off + 2 + n] = '\0';
+        id = off + 1;
+    }
+    atomic_store_explicit(&site->id, (uint64_t)gen << 32 | id, memory_order_release);
+    return id;
+}
+
+int ano_trace_write(ano_tracesite_t *site, const char *fmt, ...)
+{
+    if (!atomic_load_explicit(&g_trOn, memory_order_acquire))
+        return -1;
+    uint64_t ts  = ano_timestamp_ticks();
+    uint32_t gen = atomic_load_explicit(&g_trGen, memory_order_relaxed);
+    if (t_trTid == 0)
+        t_trTid = atomic_fetch_add_explicit(&g_trTids, 1, memory_order_relaxed) + 1;
+
+    // Body: tid, then the capture with its file and format pointers dropped for the format id. A format
+    // the capture refuses (%n, long double, wide) is rendered here instead, like the logger's eager path.
+    char cap[ANOTRACE_BODY_MAX + 2 * sizeof(void *)];
+    char body[ANOTRACE_BODY_MAX];
+    memcpy(body, &t_trTid, 4);
+    uint8_t flags = ANOTRACE_COMMITTED;
+    uint16_t len;
+    va_list ap;
+    va_start(ap, fmt);
+    int n = log_capture_deferred(cap, (int)sizeof cap, NULL, 0, fmt, ap);
+    va_end(ap);
+    int args = n - (int)(2 * sizeof(void *));
+    if (n >= 0 && args <= (int)(ANOTRACE_BODY_MAX - 8)) {
+        uint32_t id = trace_format(site, fmt, gen);
+        memcpy(body + 4, &id, 4);
+        memcpy(body + 8, cap + 2 * sizeof(void *), (size_t)args);
+        len    = (uint16_t)(8 + args);
+        flags |= ANOTRACE_DEFERRED;
+    } else {
+        va_start(ap, fmt);
+        int w = vsnprintf(body + 4, ANOTRACE_BODY_MAX - 4, fmt, ap);
+        va_end(ap);
+        if (w < 0) w = 0;
+        if (w > (int)ANOTRACE_BODY_MAX - 5) w = (int)ANOTRACE_BODY_MAX - 5;
+        len = (uint16_t)(4 + w);
+    }
+
+    // Reserve by overwriting: the oldest lines go, nobody waits. The tag is stored last, with release, so
+    // a reader that sees this lap's committed tag sees the whole body.
+    uint64_t pos = atomic_fetch_add_explicit(&g_th->tail, anotrace_span(ANO_CL, len), memory_order_relaxed);
+    log_marker_t *m = log_marker_at(&g_tr, pos);
+    atomic_store_explicit(&m->tag, 0, memory_order_relaxed);   // a torn overwrite never reads as live
+    m->timestamp = ts;
+    log_write_body(&g_tr, pos, body, len);
+    anotrace_word_t v = { .len = len, .tag = ANOTRACE_TAG, .flags = flags, .cycle = log_cycle(&g_tr, pos) };
+    atomic_store_explicit(&m->tag, v.w, memory_order_release);
+    return 0;
+}
+
+void bb_trace_fault(int code)
+{
+    anotrace_head_t *h = atomic_load_explicit(&g_th, memory_order_acquire);
+    if (h != NULL)
+        atomic_store_explicit(&h->fault, (int32_t)code, memory_order_relaxed);
+}
+
+int ano_trace_init(void)
+{
+    if (atomic_load_explicit(&g_trOn, memory_order_relaxed))
+        return -1;
+    ano_fspath dir = ano_fs_logpath();
+    if (dir.length == 0)
+        return -1;
+    int pn = snprintf(g_trPath, sizeof g_trPath, "%s/%s%s", dir.str, ano_fs_session_stamp(), ANOTRACE_SUFFIX);
+    if (pn <= 0 || pn >= (int)sizeof g_trPath)
+        return -1;
+    char *base = bb_trace_map(g_trPath, TRACE_FILE_BYTES);
+    if (base == NULL)
+        return -1;
+
+    anotrace_head_t *h = (anotrace_head_t *)base;
+    memcpy(h->magic, ANOTRACE_MAGIC, sizeof h->magic);
+    h->version      = ANOTRACE_VERSION;
+    h->lineBytes    = ANO_CL;
+    h->lines        = ANO_TRACE_RING_BYTES / ANO_CL;
+    h->strBytes     = ANO_TRACE_STR_BYTES;
+    h->anchorTicks  = ano_timestamp_ticks();
+    h->anchorUnixNs = (uint64_t)ano_timestamp_unix() * 1000000000ull;
+    h->calTicks     = 1000000000ull;
+    h->calNs        = ano_ticks_to_ns(h->calTicks);
+    h->pid          = (int32_t)trace_pid();
+    atomic_store_explicit(&h->state, ANOTRACE_LIVE, memory_order_relaxed);
+
+    g_tstr       = base + ANOTRACE_HEAD_BYTES;
+    g_tr.buf     = g_tstr + ANO_TRACE_STR_BYTES;
+    g_tr.mask    = h->lines - 1;
+    g_tr.shift   = (uint32_t)__builtin_ctzll(h->lines);
+    atomic_fetch_add_explicit(&g_trGen, 1, memory_order_relaxed);
+    atomic_store_explicit(&g_th, h, memory_order_release);
+    atomic_store_explicit(&g_trOn, true, memory_order_release);
+    return 0;
+}
+
+int ano_trace_cleanup(void)
+{
+    if (!atomic_exchange_explicit(&g_trOn, false, memory_order_acq_rel))
+        return -1;
+    anotrace_head_t *h = atomic_exchange_explicit(&g_th, NULL, memory_order_acq_rel);
+    atomic_store_explicit(&h->state, ANOTRACE_CLOSED, memory_order_release);
+    bb_trace_unmap(h, TRACE_FILE_BYTES);
+    g_tr.buf = NULL;
+    g_tstr   = NULL;
+    return 0;
+}
+
+void ano_trace_scope_release(const int *initStatus)
+{
+    if (initStatus != NULL && *initStatus == 0)
+        ano_trace_cleanup();
+}
+
+const char *ano_trace_path(void)
+{
+    return atomic_load_explicit(&g_trOn, memory_order_acquire) ? g_trPath : NULL;
+}
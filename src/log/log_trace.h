@@ -0,0 +1,77 @@
+/* SPDX-FileCopyrightText: 2026 Anoptic Game Engine Authors
+ *
+ * SPDX-License-Identifier: LGPL-3.0 */
+/*  == Anoptic Game Engine v0.0000001 == */
+
+// On-disk layout of the crash trace ring (<stamp>_trace.ring, anoptic_log_crash.h), shared by the writer
+// (log_trace.c) and the offline reader (tools/anotrace_dump.c). Depends only on libc.
+//
+// The file is the ring: mapped shared, never zeroed, so whatever the process last wrote is in the page
+// cache the moment it dies, SIGKILL and OOM-kill included. Three regions, host byte order:
+//   [0, 4096)                 anotrace_head_t
+//   [4096, +strBytes)         format table: [len:u16][bytes][NUL] entries, a site's id is its offset + 1
+//   [4096 + strBytes, ...)    `lines` lines of `lineBytes`, the log_ring.h layout: a record's head line
+//                             starts with the 16-byte marker (tag, raw ticks), the body follows and
+//                             wraps seam-aware at the buffer end. Tag: len, ANOTRACE_TAG, flags, lap.
+// Body: [tid:u32] then, deferred, [fmt id:u32][capture args as log_format.h], else finished text.
+// Producers never wait and never read: the reserve is one fetch-add on `tail`, and the oldest records
+// are overwritten. The reader walks [tail - lines, tail) and keeps each head line whose tag carries
+// this layout's byte, the committed bit and the lap of its own position.
+
+#ifndef ANOPTICENGINE_LOG_TRACE_H
+#define ANOPTICENGINE_LOG_TRACE_H
+
+#include <stdatomic.h>
+#include <stdint.h>
+
+#define ANOTRACE_MAGIC      "ANOTRACE"
+#define ANOTRACE_VERSION    1u
+#define ANOTRACE_HEAD_BYTES 4096u
+#define ANOTRACE_SUFFIX     "_trace.ring"
+
+#define ANOTRACE_TAG        0xA7u           // the tag's level byte, never a loglevel
+#define ANOTRACE_COMMITTED  (1u << 0)       // == ANO_LOG_COMMITTED
+#define ANOTRACE_DEFERRED   (1u << 1)       // == ANO_LOG_DEFERRED
+#define ANOTRACE_BODY_MAX   1024u           // body cap, so a record spans at most 17 lines
+
+enum { ANOTRACE_LIVE = 1, ANOTRACE_CLOSED = 2 };
+
+typedef struct {
+    char             magic[8];              // ANOTRACE_MAGIC, no NUL
+    uint32_t         version;
+    uint32_t         lineBytes;             // the writer's ANO_CACHE_LINE
+    uint64_t         lines;                 // ring capacity, a power of two
+    uint32_t         strBytes;              // format table capacity
+    _Atomic uint32_t state;                 // ANOTRACE_LIVE until a clean ano_trace_cleanup
+    uint64_t         anchorTicks;           // ano_timestamp_ticks at init
+    uint64_t         anchorUnixNs;          // Unix time at init
+    uint64_t         calTicks, calNs;       // tick rate: calNs == ano_ticks_to_ns(calTicks)
+    int32_t          pid;
+    _Atomic int32_t  fault;                 // fatal signal or exception code the blackbox caught, 0 none
+    _Atomic uint32_t strUsed;               // format table bump cursor, may run past strBytes
+    uint32_t         reserved;
+    _Alignas(128) _Atomic uint64_t tail;    // reserve cursor, in lines, monotonic
+} anotrace_head_t;
+_Static_assert(sizeof(anotrace_head_t) <= ANOTRACE_HEAD_BYTES, "head fits its page");
+
+// The commit word, the log_word_t view (log_ring.h).
+typedef union {
+    struct {
+        uint16_t len;                       // body bytes
+        uint8_t  tag;                       // ANOTRACE_TAG
+        uint8_t  flags;                     // ANOTRACE_COMMITTED, ANOTRACE_DEFERRED
+        uint32_t cycle;                     // lap of the head line's position
+    };
+    uint64_t w;
+} anotrace_word_t;
+_Static_assert(sizeof(anotrace_word_t) == 8, "commit word is 8 bytes");
+
+#define ANOTRACE_MARKER 16u                 // tag + raw ticks
+
+// Lines a record with a `len`-byte body spans.
+static inline uint64_t anotrace_span(uint64_t lineBytes, uint16_t len)
+{
+    return (ANOTRACE_MARKER + (uint64_t)len + lineBytes - 1) / lineBytes;
+}
+
+#endif //ANOPTICENGINE_LOG_TRACE_H
@@ -0,0 +1,312 @@
+/* SPDX-FileCopyrightText: 2026 Anoptic Game Engine Authors
+ *
+ * SPDX-License-Identifier: LGPL-3.0 */
+/*  == Anoptic Game Engine v0.0000001 == */
+
+// Memory accounting (anoptic_memory.h): the tag registry, the counting allocation calls, and the sampled
+// allocation-site table. Everything here is lock-free: tags and sites are only ever added, never removed.
+
+#include <anoptic_memory.h>
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static ano_mem_tag_t *_Atomic g_tags;          // newest first
+static _Atomic size_t         g_sampleEvery;
+static _Thread_local int64_t  t_untilSample;   // bytes left before this thread samples again
+static _Thread_local bool     t_sampleSeeded;
+
+typedef struct {
+    const char *_Atomic  site;          // key: the call site's string literal, unique per site
+    const char *_Atomic  tag;
+    _Atomic uint64_t     samples;
+    _Atomic uint64_t     bytes;
+} site_slot_t;
+
+static site_slot_t       g_sites[ANO_MEM_SITES];
+static _Atomic uint64_t  g_sitesLost;
+
+
+/* Registry */
+
+static void tag_register(ano_mem_tag_t *tag)
+{
+    if (atomic_load_explicit(&tag->registered, memory_order_relaxed)
+        || atomic_exchange_explicit(&tag->registered, true, memory_order_relaxed))
+        return;
+    ano_mem_tag_t *head = atomic_load_explicit(&g_tags, memory_order_relaxed);
+    do {
+        tag->next = head;
+    } while (!atomic_compare_exchange_weak_explicit(&g_tags, &head, tag, memory_order_release,
+                                                    memory_order_relaxed));
+}
+
+void ano_mem_tag_bind(ano_mem_tag_t *tag, mi_heap_t *heap)
+{
+    tag_register(tag);
+    if (heap == tag->heap)
+        return;
+    // heapLive follows the binding: what was on the old heap is freed block by block from here on.
+    atomic_store_explicit(&tag->heapLive, 0, memory_order_relaxed);
+    atomic_store_explicit(&tag->heapBlocks, 0u, memory_order_relaxed);
+    tag->heap = heap;
+}
+
+void ano_mem_tag_release(ano_mem_tag_t *tag)
+{
+    tag_register(tag);
+    int64_t  bytes  = atomic_exchange_explicit(&tag->heapLive, 0, memory_order_relaxed);
+    uint64_t blocks = atomic_exchange_explicit(&tag->heapBlocks, 0u, memory_order_relaxed);
+    atomic_fetch_sub_explicit(&tag->live, bytes, memory_order_relaxed);
+    atomic_fetch_add_explicit(&tag->frees, blocks, memory_order_relaxed);
+    tag->heap = NULL;
+}
+
+
+/* Sampling */
+
+static void site_record(const ano_mem_tag_t *tag, const char *site, size_t size)
+{
+    // Site strings are literals, so the pointer is the key. Linear probe from its hash.
+    uint32_t h = (uint32_t)(((uintptr_t)site * 0x9E3779B97F4A7C15ull) >> 40);
+    for (uint32_t i = 0; i < ANO_MEM_SITES; i++) {
+        site_slot_t *s   = &g_sites[(h + i) & (ANO_MEM_SITES - 1u)];
+        const char  *key = atomic_load_explicit(&s->site, memory_order_acquire);
+        if (key == NULL) {
+            if (atomic_compare_exchange_strong_explicit(&s->site, &key, site, memory_order_acq_rel,
+                                                        memory_order_acquire))
+                atomic_store_explicit(&s->tag, tag->name, memory_order_release);
+        }
+        if (key == NULL || key == site) {
+            atomic_fetch_add_explicit(&s->samples, 1u, memory_order_relaxed);
+            atomic_fetch_add_explicit(&s->bytes, size, memory_order_relaxed);
+            return;
+        }
+    }
+    atomic_fetch_add_explicit(&g_sitesLost, 1u, memory_order_relaxed);
+}
+
+void ano_memory_sample_every(size_t bytes)
+{
+    atomic_store_explicit(&g_sampleEvery, bytes, memory_order_relaxed);
+}
+
+// A thread's first countdown: a point in [1, every] from the address of its TLS block, so a new thread
+// neither samples its first allocation nor runs in phase with threads started beside it.
+static int64_t sample_phase(size_t every)
+{
+    uint64_t x = (uint64_t)(uintptr_t)&t_untilSample * 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    x ^= x >> 31;
+    return (int64_t)(x % every) + 1;
+}
+
+// Per allocation: a thread-local countdown, so the off and not-yet cases cost no shared writes.
+static inline void maybe_sample(const ano_mem_tag_t *tag, const char *site, size_t size)
+{
+    size_t every = atomic_load_explicit(&g_sampleEvery, memory_order_relaxed);
+    if (every == 0)
+        return;
+    if (!t_sampleSeeded) {
+        t_sampleSeeded = true;
+        t_untilSample  = sample_phase(every);
+    }
+    t_untilSample -= (int64_t)size;
+    if (t_untilSample > 0)
+        return;
+    t_untilSample = (int64_t)every;
+    site_record(tag, site, size);
+}
+
+
+/* Counting allocation */
+
+static inline void add_live(ano_mem_tag_t *tag, int64_t bytes)
+{
+    int64_t live = atomic_fetch_add_explicit(&tag->live, bytes, memory_order_relaxed) + bytes;
+    int64_t peak = atomic_load_explicit(&tag->peak, memory_order_relaxed);
+    while (live > peak
+           && !atomic_compare_exchange_weak_explicit(&tag->peak, &peak, live, memory_order_relaxed,
+                                                     memory_order_relaxed))
+        ;
+}
+
+// Whether p sits on the tag's bound heap, so its bytes are part of heapLive.
+static inline bool on_bound_heap(ano_mem_tag_t *tag, const void *p)
+{
+    return tag->heap != NULL && mi_heap_contains_block(tag->heap, p);
+}
+
+static inline void count_alloc(ano_mem_tag_t *tag, void *p, const char *site, size_t asked)
+{
+    tag_register(tag);
+    int64_t bytes = (int64_t)mi_usable_size(p);
+    add_live(tag, bytes);
+    atomic_fetch_add_explicit(&tag->allocs, 1u, memory_order_relaxed);
+    if (on_bound_heap(tag, p)) {
+        atomic_fetch_add_explicit(&tag->heapLive, bytes, memory_order_relaxed);
+        atomic_fetch_add_explicit(&tag->heapBlocks, 1u, memory_order_relaxed);
+    }
+    maybe_sample(tag, site, asked);
+}
+
+static inline void count_free(ano_mem_tag_t *tag, void *p)
+{
+    int64_t bytes = (int64_t)mi_usable_size(p);
+    atomic_fetch_sub_explicit(&tag->live, bytes, memory_order_relaxed);
+    atomic_fetch_add_explicit(&tag->frees, 1u, memory_order_relaxed);
+    if (on_bound_heap(tag, p)) {
+        atomic_fetch_sub_explicit(&tag->heapLive, bytes, memory_order_relaxed);
+        atomic_fetch_sub_explicit(&tag->heapBlocks, 1u, memory_order_relaxed);
+    }
+}
+
+void *ano_tmalloc_(ano_mem_tag_t *tag, size_t size, const char *site)
+{
+    void *p = tag->heap ? mi_heap_malloc(tag->heap, size) : mi_malloc(size);
+    if (p != NULL)
+        count_alloc(tag, p, site, size);
+    return p;
+}
+
+void *ano_tzalloc_(ano_mem_tag_t *tag, size_t size, const char *site)
+{
+    void *p = tag->heap ? mi_heap_zalloc(tag->heap, size) : mi_zalloc(size);
+    if (p != NULL)
+        count_alloc(tag, p, site, size);
+    return p;
+}
+
+void *ano_tcalloc_(ano_mem_tag_t *tag, size_t count, size_t size, const char *site)
+{
+    void *p = tag->heap ? mi_heap_calloc(tag->heap, count, size) : mi_calloc(count, size);
+    if (p != NULL)
+        count_alloc(tag, p, site, count * size);
+    return p;
+}
+
+// A move counts as one free and one allocation, an in-place resize as neither: only live moves.
+void *ano_trealloc_(ano_mem_tag_t *tag, void *ptr, size_t size, const char *site)
+{
+    if (ptr == NULL)
+        return ano_tmalloc_(tag, size, site);
+    int64_t before = (int64_t)mi_usable_size(ptr);
+    bool    onHeap = on_bound_heap(tag, ptr);
+    void *p = tag->heap ? mi_heap_realloc(tag->heap, ptr, size) : mi_realloc(ptr, size);
+    if (p == NULL)
+        return NULL;    // ptr untouched, or freed by a zero-size realloc
+    if (p != ptr) {
+        atomic_fetch_sub_explicit(&tag->live, before, memory_order_relaxed);
+        atomic_fetch_add_explicit(&tag->frees, 1u, memory_order_relaxed);
+        if (onHeap) {
+            atomic_fetch_sub_explicit(&tag->heapLive, before, memory_order_relaxed);
+            atomic_fetch_sub_explicit(&tag->heapBlocks, 1u, memory_order_relaxed);
+        }
+        count_alloc(tag, p, site, size);
+    } else {
+        int64_t delta = (int64_t)mi_usable_size(p) - before;
+        add_live(tag, delta);
+        if (onHeap)
+            atomic_fetch_add_explicit(&tag->heapLive, delta, memory_order_relaxed);
+    }
+    return p;
+}
+
+void ano_tadopt_(ano_mem_tag_t *tag, void *ptr, const char *site)
+{
+    if (ptr != NULL)
+        count_alloc(tag, ptr, site, mi_usable_size(ptr));
+}
+
+void ano_tfree(ano_mem_tag_t *tag, void *ptr)
+{
+    if (ptr == NULL)
+        return;
+    count_free(tag, ptr);
+    mi_free(ptr);
+}
+
+
+/* Reports */
+
+size_t ano_memory_report(ano_mem_report_t *out, size_t cap)
+{
+    // The chain is newest first: count, then fill from the back for registration order.
+    size_t n = 0;
+    for (ano_mem_tag_t *t = atomic_load_explicit(&g_tags, memory_order_acquire); t != NULL; t = t->next)
+        n++;
+    size_t i = n;
+    for (ano_mem_tag_t *t = atomic_load_explicit(&g_tags, memory_order_acquire); t != NULL && i > 0;
+         t = t->next) {
+        if (--i >= cap)
+            continue;
+        out[i] = (ano_mem_report_t){
+            .name   = t->name,
+            .live   = atomic_load_explicit(&t->live, memory_order_relaxed),
+            .peak   = atomic_load_explicit(&t->peak, memory_order_relaxed),
+            .allocs = atomic_load_explicit(&t->allocs, memory_order_relaxed),
+            .frees  = atomic_load_explicit(&t->frees, memory_order_relaxed),
+        };
+    }
+    return n;
+}
+
+static int site_heavier(const void *a, const void *b)
+{
+    const ano_mem_site_t *x = a, *y = b;
+    return x->bytes < y->bytes ? 1 : x->bytes > y->bytes ? -1 : 0;
+}
+
+size_t ano_memory_sites(ano_mem_site_t *out, size_t cap)
+{
+    ano_mem_site_t all[ANO_MEM_SITES];
+    size_t n = 0;
+    for (uint32_t i = 0; i < ANO_MEM_SITES; i++) {
+        const char *site = atomic_load_explicit(&g_sites[i].site, memory_order_acquire);
+        if (site == NULL)
+            continue;
+        const char *tag = atomic_load_explicit(&g_sites[i].tag, memory_order_acquire);
+        all[n++] = (ano_mem_site_t){
+            .tag     = tag != NULL ? tag : "?",     // inserter between its two stores
+            .site    = site,
+            .samples = atomic_load_explicit(&g_sites[i].samples, memory_order_relaxed),
+            .bytes   = atomic_load_explicit(&g_sites[i].bytes, memory_order_relaxed),
+        };
+    }
+    qsort(all, n, sizeof *all, site_heavier);
+    memcpy(out, all, (n < cap ? n : cap) * sizeof *out);
+    return n;
+}
+
+#define EMIT_TAGS  64u
+#define EMIT_SITES 16u
+
+void ano_memory_report_emit(void (*line)(void *ctx, const char *text), void *ctx)
+{
+    ano_mem_report_t tags[EMIT_TAGS];
+    char buf[192];
+    size_t n = ano_memory_report(tags, EMIT_TAGS);
+    line(ctx, "memory: tag            live KiB    peak KiB       allocs        frees");
+    for (size_t i = 0; i < n && i < EMIT_TAGS; i++) {
+        snprintf(buf, sizeof buf, "memory: %-12s %11.1f %11.1f %12llu %12llu", tags[i].name,
+                 (double)tags[i].live / 1024.0, (double)tags[i].peak / 1024.0,
+                 (unsigned long long)tags[i].allocs, (unsigned long long)tags[i].frees);
+        line(ctx, buf);
+    }
+    if (atomic_load_explicit(&g_sampleEvery, memory_order_relaxed) == 0)
+        return;
+    ano_mem_site_t sites[EMIT_SITES];
+    size_t s = ano_memory_sites(sites, EMIT_SITES);
+    snprintf(buf, sizeof buf, "memory: sampled sites (%zu, %llu lost), heaviest first:", s,
+             (unsigned long long)atomic_load_explicit(&g_sitesLost, memory_order_relaxed));
+    line(ctx, buf);
+    for (size_t i = 0; i < s && i < EMIT_SITES; i++) {
+        snprintf(buf, sizeof buf, "memory:   %-12s %-40s %8llu samples %11.1f KiB", sites[i].tag,
+                 sites[i].site, (unsigned long long)sites[i].samples, (double)sites[i].bytes / 1024.0);
+        line(ctx, buf);
+    }
+}
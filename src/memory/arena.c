@@ -0,0 +1,352 @@
+/* SPDX-FileCopyrightText: 2026 Anoptic Game Engine Authors
+ *
+ * SPDX-License-Identifier: LGPL-3.0 */
+/*  == Anoptic Game Engine v0.0000001 == */
+
+// Bump arenas (anoptic_memory.h): the virtual-memory half (with the huge-page and NUMA options) and the
+// thread's ambient scratch pair. The bump itself is inline in the header.
+
+#include <anoptic_memory.h>
+#include <anoptic_threads.h>
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <string.h>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+#if defined(__linux__)
+#include <sys/syscall.h>
+#include <unistd.h>
+#ifndef MAP_HUGE_SHIFT
+#define MAP_HUGE_SHIFT 26
+#endif
+#define MPOL_PREFERRED_ 1   // <linux/mempolicy.h>, without dragging in libnuma
+#endif
+
+#ifdef ANO_ARENA_ASAN
+#define arena_poison(p, n) ASAN_POISON_MEMORY_REGION((p), (n))
+#else
+#define arena_poison(p, n) ((void)(p), (void)(n))
+#endif
+
+#define HUGE_2M ((size_t)2 << 20)
+#define HUGE_1G ((size_t)1 << 30)
+
+
+/* Virtual memory */
+
+// `bytes` of address space aligned to `align`, a power of two. Over-reserve and cut the slop when the
+// OS's own granularity (64 KiB at most) is not enough.
+static void *vm_reserve(size_t bytes, size_t align)
+{
+#if defined(_WIN32)
+    (void)align;    // huge steps never reach here on Windows: see init_large
+    return VirtualAlloc(NULL, bytes, MEM_RESERVE, PAGE_NOACCESS);
+#else
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#ifdef MAP_NORESERVE
+    flags |= MAP_NORESERVE;
+#endif
+    size_t slop = align > ANO_ARENA_COMMIT ? align : 0u;
+    unsigned char *p = mmap(NULL, bytes + slop, PROT_NONE, flags, -1, 0);
+    if (p == MAP_FAILED)
+        return NULL;
+    if (slop != 0) {
+        unsigned char *at = (unsigned char *)(((uintptr_t)p + align - 1u) & ~(uintptr_t)(align - 1u));
+        if (at > p)
+            munmap(p, (size_t)(at - p));
+        if (at + bytes < p + bytes + slop)
+            munmap(at + bytes, (size_t)(p + bytes + slop - (at + bytes)));
+        p = at;
+    }
+    return p;
+#endif
+}
+
+// Back to reserved-only: the pages go to the OS, the addresses stay ours.
+static void vm_decommit(void *at, size_t bytes)
+{
+#if defined(_WIN32)
+    VirtualFree(at, bytes, MEM_DECOMMIT);
+#else
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED;
+#ifdef MAP_NORESERVE
+    flags |= MAP_NORESERVE;
+#endif
+    (void)mmap(at, bytes, PROT_NONE, flags, -1, 0);
+#endif
+}
+
+#if defined(__linux__)
+// Explicit huge pages over part of the reservation. Fails when the hugetlb pool is short, which on most
+// desktops it is until an admin sizes it (vm.nr_hugepages).
+static bool vm_commit_hugetlb(void *at, size_t bytes, int shift)
+{
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED | MAP_HUGETLB | (shift << MAP_HUGE_SHIFT);
+    if (mmap(at, bytes, PROT_READ | PROT_WRITE, flags, -1, 0) != MAP_FAILED)
+        return true;
+    vm_decommit(at, bytes);     // keep the range reserved whatever the failed map left behind
+    return false;
+}
+#endif
+
+// Back [at, at + bytes) with memory. Returns the ANO_ARENA_PAGES_* kind it got, or PAGES_NONE on
+// failure.
+static uint32_t vm_commit(const ano_arena_t *arena, void *at, size_t bytes)
+{
+    uint32_t kind = ANO_ARENA_PAGES_SMALL;
+#if defined(_WIN32)
+    if (VirtualAlloc(at, bytes, MEM_COMMIT, PAGE_READWRITE) == NULL)
+        return ANO_ARENA_PAGES_NONE;
+#else
+#if defined(__linux__)
+    if (arena->step == HUGE_1G && vm_commit_hugetlb(at, bytes, 30))
+        kind = ANO_ARENA_PAGES_1G;
+    else if (arena->step >= HUGE_2M && vm_commit_hugetlb(at, bytes, 21))
+        kind = ANO_ARENA_PAGES_2M;
+    else
+#endif
+    if (mprotect(at, bytes, PROT_READ | PROT_WRITE) != 0)
+        return ANO_ARENA_PAGES_NONE;
+#if defined(__linux__)
+    if (kind == ANO_ARENA_PAGES_SMALL && arena->step >= HUGE_2M && madvise(at, bytes, MADV_HUGEPAGE) == 0)
+        kind = ANO_ARENA_PAGES_THP;
+    // Preferred, not bound: a full node spills to the others instead of failing the fault. Set before
+    // first touch, which is where placement happens.
+    if (arena->node >= 0) {
+        unsigned long mask = 1ul << arena->node;
+        (void)syscall(SYS_mbind, at, bytes, MPOL_PREFERRED_, &mask, sizeof mask * 8u + 1u, 0u);
+    }
+#endif
+#endif
+    return kind;
+}
+
+static void vm_release(void *base, size_t bytes)
+{
+#if defined(_WIN32)
+    (void)bytes;
+    VirtualFree(base, 0, MEM_RELEASE);
+#else
+    munmap(base, bytes);
+#endif
+}
+
+// NUMA node of the CPU this thread is running on, -1 when unknown.
+static int current_node(void)
+{
+#if defined(__linux__)
+    unsigned cpu = 0, node = 0;
+    if (syscall(SYS_getcpu, &cpu, &node, NULL) != 0 || node >= sizeof(unsigned long) * 8u)
+        return -1;
+    return (int)node;
+#elif defined(_WIN32)
+    PROCESSOR_NUMBER pn;
+    USHORT node;
+    GetCurrentProcessorNumberEx(&pn);
+    return GetNumaProcessorNodeEx(&pn, &node) ? (int)node : -1;
+#else
+    return -1;  // macOS: one memory domain
+#endif
+}
+
+static inline size_t round_step(size_t n, size_t step)
+{
+    return (n + step - 1u) & ~(step - 1u);
+}
+
+
+/* Arena */
+
+#if defined(_WIN32)
+// Large pages cannot be reserved uncommitted: take the whole range now. 0 on success.
+static int init_large(ano_arena_t *arena, size_t reserve)
+{
+    size_t large = GetLargePageMinimum();
+    if (large == 0 || reserve > SIZE_MAX - large)
+        return -1;
+    reserve = round_step(reserve, large);
+    DWORD type = MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES;
+    void *p = arena->node >= 0
+            ? VirtualAllocExNuma(GetCurrentProcess(), NULL, reserve, type, PAGE_READWRITE, (DWORD)arena->node)
+            : VirtualAlloc(NULL, reserve, type, PAGE_READWRITE);
+    if (p == NULL)
+        return -1;
+    arena->base      = p;
+    arena->reserved  = reserve;
+    arena->committed = reserve;
+    arena->step      = large;
+    arena->pages     = ANO_ARENA_PAGES_2M;
+    arena_poison(p, reserve);
+    return 0;
+}
+#endif
+
+int ano_arena_init(ano_arena_t *arena, size_t reserve)
+{
+    return ano_arena_init_ex(arena, reserve, 0u);
+}
+
+int ano_arena_init_ex(ano_arena_t *arena, size_t reserve, uint32_t flags)
+{
+    *arena = (ano_arena_t){ .flags = flags, .node = -1, .step = ANO_ARENA_COMMIT };
+    if (reserve == 0 || reserve > SIZE_MAX / 2u)
+        return -1;
+    if (flags & ANO_ARENA_NUMA_LOCAL)
+        arena->node = current_node();
+#if defined(_WIN32)
+    if ((flags & (ANO_ARENA_HUGE | ANO_ARENA_HUGE_1G)) && init_large(arena, reserve) == 0)
+        return 0;
+    unsigned char *base = arena->node >= 0
+                        ? VirtualAllocExNuma(GetCurrentProcess(), NULL, round_step(reserve, arena->step),
+                                             MEM_RESERVE, PAGE_NOACCESS, (DWORD)arena->node)
+                        : NULL;
+#else
+#if defined(__linux__)
+    if (flags & (ANO_ARENA_HUGE | ANO_ARENA_HUGE_1G))
+        arena->step = (flags & ANO_ARENA_HUGE_1G) && reserve >= HUGE_1G ? HUGE_1G : HUGE_2M;
+#endif
+    unsigned char *base = NULL;
+#endif
+    reserve = round_step(reserve, arena->step);
+    if (base == NULL)
+        base = vm_reserve(reserve, arena->step);
+    if (base == NULL)
+        return -1;
+    arena->base     = base;
+    arena->reserved = reserve;
+    return 0;
+}
+
+void ano_arena_destroy(ano_arena_t *arena)
+{
+    if (arena->base != NULL) {
+        // Clean shadow for whoever maps these addresses next. Trim already cleaned past `committed`.
+        ano_arena_unpoison_(arena->base, arena->committed);
+        vm_release(arena->base, arena->reserved);
+    }
+    *arena = (ano_arena_t){ .node = -1 };
+}
+
+void *ano_arena_alloc_slow_(ano_arena_t *arena, size_t size, size_t align)
+{
+    if (arena->base == NULL)
+        return NULL;
+    uintptr_t base = (uintptr_t)arena->base;
+    size_t    off  = (size_t)(((base + arena->used + (align - 1u)) & ~(uintptr_t)(align - 1u)) - base);
+    if (off > arena->reserved || size > arena->reserved - off)
+        return NULL;
+    size_t need = off + size;
+    if (need > arena->committed) {
+        size_t to = round_step(need, arena->step);
+        if (to > arena->reserved)
+            to = arena->reserved;
+        uint32_t kind = vm_commit(arena, arena->base + arena->committed, to - arena->committed);
+        if (kind == ANO_ARENA_PAGES_NONE)
+            return NULL;
+        if (arena->pages == ANO_ARENA_PAGES_NONE || kind < arena->pages)
+            arena->pages = kind;
+        arena_poison(arena->base + arena->committed, to - arena->committed);
+        arena->committed = to;
+    }
+    arena->used = need;
+    ano_arena_unpoison_(arena->base + off, size);
+    return arena->base + off;
+}
+
+void *ano_arena_zalloc(ano_arena_t *arena, size_t size, size_t align)
+{
+    void *p = ano_arena_alloc(arena, size, align);
+    if (p != NULL)
+        memset(p, 0, size);
+    return p;
+}
+
+void ano_arena_rewind(ano_arena_t *arena, size_t mark)
+{
+    if (mark >= arena->used)
+        return;
+    if (arena->used > arena->peak)
+        arena->peak = arena->used;
+#ifdef DEBUG_BUILD
+    ano_arena_unpoison_(arena->base + mark, arena->used - mark);   // alignment gaps are poisoned
+    memset(arena->base + mark, 0xDD, arena->used - mark);
+#endif
+    arena_poison(arena->base + mark, arena->used - mark);
+    arena->used = mark;
+}
+
+void ano_arena_reset(ano_arena_t *arena)
+{
+    ano_arena_rewind(arena, 0);
+}
+
+void ano_arena_trim(ano_arena_t *arena, size_t keep)
+{
+#if defined(_WIN32)
+    if (arena->pages >= ANO_ARENA_PAGES_2M)
+        return;     // large pages stay committed until release
+#endif
+    if (keep < arena->used)
+        keep = arena->used;
+    keep = round_step(keep, arena->step);
+    if (keep >= arena->committed)
+        return;
+    ano_arena_unpoison_(arena->base + keep, arena->committed - keep);
+    vm_decommit(arena->base + keep, arena->committed - keep);
+    arena->committed = keep;
+}
+
+void ano_arena_scope_release(ano_arena_scope_t *scope)
+{
+    if (scope->arena != NULL)
+        ano_arena_rewind(scope->arena, scope->mark);
+}
+
+
+/* Ambient scratch */
+
+static _Thread_local ano_arena_t t_scratch[2];
+static anothread_key_t           g_scratchKey;
+static atomic_int                g_scratchKeyState;   // 0 none, 1 creating, 2 ready
+
+// Thread key destructor: unmap the exiting thread's pair.
+static void scratch_release(void *arg)
+{
+    ano_arena_t *pair = arg;
+    ano_arena_destroy(&pair[0]);
+    ano_arena_destroy(&pair[1]);
+}
+
+static void scratch_key_once(void)
+{
+    int state = atomic_load_explicit(&g_scratchKeyState, memory_order_acquire);
+    if (state == 2)
+        return;
+    int none = 0;
+    if (atomic_compare_exchange_strong_explicit(&g_scratchKeyState, &none, 1, memory_order_acq_rel,
+                                                memory_order_acquire)) {
+        ano_thread_key_create(&g_scratchKey, scratch_release);
+        atomic_store_explicit(&g_scratchKeyState, 2, memory_order_release);
+    } else {
+        while (atomic_load_explicit(&g_scratchKeyState, memory_order_acquire) != 2)
+            ano_thread_yield();
+    }
+}
+
+ano_arena_t *ano_scratch(const ano_arena_t *conflict)
+{
+    ano_arena_t *s = conflict == &t_scratch[0] ? &t_scratch[1] : &t_scratch[0];
+    if (s->base == NULL) {
+        if (ano_arena_init(s, ANO_SCRATCH_RESERVE) != 0)
+            return NULL;
+        scratch_key_once();
+        ano_thread_setspecific(g_scratchKey, t_scratch);
+    }
+    return s;
+}
@@ -0,0 +1,308 @@
+/* SPDX-FileCopyrightText: 2026 Anoptic Game Engine Authors
+ *
+ * SPDX-License-Identifier: LGPL-3.0 */
+/*  == Anoptic Game Engine v0.0000001 == */
+
+// Fixed-size object pools (anoptic_memory.h). Three tiers, fastest first: the calling thread's
+// magazine (plain loads and stores), the pool's remote stack (one CAS per spill, one exchange per
+// drain), and the locked refill that drains that stack or carves fresh slab space.
+
+#include <anoptic_memory.h>
+#include <anoptic_threads.h>
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <string.h>
+
+#ifdef ANO_ARENA_ASAN
+#define pool_poison(p, n) ASAN_POISON_MEMORY_REGION((p), (n))
+#else
+#define pool_poison(p, n) ((void)(p), (void)(n))
+#endif
+
+static_assert(ANO_POOL_THREADS == 64u, "slot mask is one uint64_t");
+
+#define BATCH (ANO_POOL_MAG / 2u)   // objects per refill and per spill
+
+struct ano_pool_mag_t
+{
+    _Alignas(ANO_THREAD_LINE) void *head;
+    _Atomic uint32_t count;          // owner stores, stats read
+};
+
+static inline void *next_of(void *obj)
+{
+    return *(void **)obj;
+}
+
+static inline void set_next(void *obj, void *next)
+{
+    *(void **)obj = next;
+}
+
+
+/* Thread slots */
+
+// A thread's magazine slot is the same index in every pool. Slots go back at thread exit, and the
+// magazines keep their objects for the slot's next owner: the release/acquire on the mask hands them
+// over.
+static _Atomic uint64_t     g_slotMask;
+static _Thread_local int    t_slot;              // slot + 1, 0 without one
+static anothread_key_t      g_slotKey;
+static atomic_int           g_slotKeyState;      // 0 none, 1 creating, 2 ready
+
+static void slot_release(void *arg)
+{
+    int slot = (int)(intptr_t)arg - 1;
+    t_slot = 0;
+    atomic_fetch_and_explicit(&g_slotMask, ~((uint64_t)1 << slot), memory_order_release);
+}
+
+static void slot_key_once(void)
+{
+    int state = atomic_load_explicit(&g_slotKeyState, memory_order_acquire);
+    if (state == 2)
+        return;
+    int none = 0;
+    if (atomic_compare_exchange_strong_explicit(&g_slotKeyState, &none, 1, memory_order_acq_rel,
+                                                memory_order_acquire)) {
+        ano_thread_key_create(&g_slotKey, slot_release);
+        atomic_store_explicit(&g_slotKeyState, 2, memory_order_release);
+    } else {
+        while (atomic_load_explicit(&g_slotKeyState, memory_order_acquire) != 2)
+            ano_thread_yield();
+    }
+}
+
+// The calling thread's slot, claimed on first use. -1 while all are taken.
+static int pool_slot(void)
+{
+    if (t_slot > 0)
+        return t_slot - 1;
+    uint64_t mask = atomic_load_explicit(&g_slotMask, memory_order_relaxed);
+    while (mask != UINT64_MAX) {
+        int bit = __builtin_ctzll(~mask);
+        if (atomic_compare_exchange_weak_explicit(&g_slotMask, &mask, mask | ((uint64_t)1 << bit),
+                                                  memory_order_acquire, memory_order_relaxed)) {
+            slot_key_once();
+            ano_thread_setspecific(g_slotKey, (void *)(intptr_t)(bit + 1));
+            t_slot = bit + 1;
+            return bit;
+        }
+    }
+    return -1;
+}
+
+
+/* Shared tiers */
+
+// Lock-free: any thread, any time.
+static void push_remote(ano_pool_t *pool, void *first, void *last, size_t n)
+{
+    // Count first, so a drain racing this push never takes remoteCount below zero.
+    atomic_fetch_add_explicit(&pool->remoteCount, n, memory_order_relaxed);
+    void *head = atomic_load_explicit(&pool->remote, memory_order_relaxed);
+    do {
+        set_next(last, head);
+    } while (!atomic_compare_exchange_weak_explicit(&pool->remote, &head, first, memory_order_release,
+                                                    memory_order_relaxed));
+}
+
+static bool new_page(ano_pool_t *pool)
+{
+    size_t first = (sizeof(void *) + pool->align - 1u) & ~(pool->align - 1u);
+    size_t bytes = first + pool->perPage * pool->stride;
+    size_t pageAlign = pool->align > ANO_CACHE_LINE ? pool->align : ANO_CACHE_LINE;
+    unsigned char *page = mi_malloc_aligned(bytes, pageAlign);
+    if (page == NULL)
+        return false;
+    set_next(page, pool->pages);
+    pool->pages   = page;
+    pool->bump    = page + first;
+    pool->bumpEnd = page + bytes;
+    pool->pageCount++;
+    return true;
+}
+
+// Under the lock. Up to `want` objects as a chain, from the central list (drained from the remote
+// stack when empty) and then from slab space. Returns the count, 0 when out of memory.
+static uint32_t take_locked(ano_pool_t *pool, uint32_t want, void **chain)
+{
+    if (pool->central == NULL) {
+        void *list = atomic_exchange_explicit(&pool->remote, NULL, memory_order_acquire);
+        size_t n = 0;
+        for (void *o = list; o != NULL; o = next_of(o))
+            n++;
+        atomic_fetch_sub_explicit(&pool->remoteCount, n, memory_order_relaxed);
+        pool->central      = list;
+        pool->centralCount = n;
+    }
+    void    *head = NULL;
+    uint32_t got  = 0;
+    while (got < want && pool->central != NULL) {
+        void *o = pool->central;
+        pool->central = next_of(o);
+        set_next(o, head);
+        head = o;
+        got++;
+    }
+    pool->centralCount -= got;
+    while (got < want) {
+        if (pool->bump == pool->bumpEnd && !new_page(pool))
+            break;
+        void *o = pool->bump;
+        pool->bump += pool->stride;
+        pool->carved++;
+        set_next(o, head);
+        head = o;
+        got++;
+    }
+    *chain = head;
+    return got;
+}
+
+
+/* Pool */
+
+int ano_pool_init(ano_pool_t *pool, size_t size, size_t align)
+{
+    memset(pool, 0, sizeof *pool);
+    if (size == 0 || align == 0 || (align & (align - 1u)) != 0 || size > SIZE_MAX / 2u)
+        return -1;
+    if (align < _Alignof(void *))
+        align = _Alignof(void *);
+    if (size < sizeof(void *))
+        size = sizeof(void *);
+    pool->align  = align;
+    pool->stride = (size + align - 1u) & ~(align - 1u);
+    size_t first = (sizeof(void *) + align - 1u) & ~(align - 1u);
+    pool->perPage = first + pool->stride <= ANO_POOL_PAGE ? (ANO_POOL_PAGE - first) / pool->stride : 1u;
+    pool->mags = mi_zalloc_aligned(ANO_POOL_THREADS * sizeof(ano_pool_mag_t), ANO_THREAD_LINE);
+    if (pool->mags == NULL)
+        return -1;
+    if (ano_mutex_init(&pool->lock, NULL) != 0) {
+        mi_free(pool->mags);
+        pool->mags = NULL;
+        return -1;
+    }
+    return 0;
+}
+
+void ano_pool_destroy(ano_pool_t *pool)
+{
+    if (pool->mags == NULL)
+        return;
+    size_t first = (sizeof(void *) + pool->align - 1u) & ~(pool->align - 1u);
+    for (void *page = pool->pages; page != NULL;) {
+        void *next = next_of(page);
+        ano_arena_unpoison_(page, first + pool->perPage * pool->stride);
+        mi_free(page);
+        page = next;
+    }
+    mi_free(pool->mags);
+    ano_mutex_destroy(&pool->lock);
+    memset(pool, 0, sizeof *pool);
+}
+
+void *ano_pool_alloc(ano_pool_t *pool)
+{
+    void *obj;
+    int   slot = pool_slot();
+    if (slot >= 0) {
+        ano_pool_mag_t *m = &pool->mags[slot];
+        obj = m->head;
+        if (obj != NULL) {
+            m->head = next_of(obj);
+            atomic_store_explicit(&m->count, atomic_load_explicit(&m->count, memory_order_relaxed) - 1u,
+                                  memory_order_relaxed);
+        } else {
+            ano_mutex_lock(&pool->lock);
+            uint32_t got = take_locked(pool, BATCH, &obj);
+            ano_mutex_unlock(&pool->lock);
+            if (got == 0)
+                return NULL;
+            m->head = next_of(obj);
+            atomic_store_explicit(&m->count, got - 1u, memory_order_relaxed);
+        }
+    } else {
+        ano_mutex_lock(&pool->lock);
+        uint32_t got = take_locked(pool, 1u, &obj);
+        ano_mutex_unlock(&pool->lock);
+        if (got == 0)
+            return NULL;
+    }
+    ano_arena_unpoison_(obj, pool->stride);
+    return obj;
+}
+
+void ano_pool_free(ano_pool_t *pool, void *obj)
+{
+    if (obj == NULL)
+        return;
+    pool_poison((unsigned char *)obj + sizeof(void *), pool->stride - sizeof(void *));
+    int slot = pool_slot();
+    if (slot < 0) {
+        push_remote(pool, obj, obj, 1u);
+        return;
+    }
+    ano_pool_mag_t *m = &pool->mags[slot];
+    uint32_t count = atomic_load_explicit(&m->count, memory_order_relaxed);
+    if (count == ANO_POOL_MAG) {
+        // Keep the newer (warmer) half, spill the older one.
+        void *cut = m->head;
+        for (uint32_t i = 1; i < ANO_POOL_MAG - BATCH; i++)
+            cut = next_of(cut);
+        void *first = next_of(cut), *last = first;
+        while (next_of(last) != NULL)
+            last = next_of(last);
+        set_next(cut, NULL);
+        push_remote(pool, first, last, BATCH);
+        count -= BATCH;
+    }
+    set_next(obj, m->head);
+    m->head = obj;
+    atomic_store_explicit(&m->count, count + 1u, memory_order_relaxed);
+}
+
+void ano_pool_flush(ano_pool_t *pool)
+{
+    int slot = pool_slot();
+    if (slot < 0)
+        return;
+    ano_pool_mag_t *m = &pool->mags[slot];
+    uint32_t count = atomic_load_explicit(&m->count, memory_order_relaxed);
+    if (count == 0)
+        return;
+    void *last = m->head;
+    while (next_of(last) != NULL)
+        last = next_of(last);
+    push_remote(pool, m->head, last, count);
+    m->head = NULL;
+    atomic_store_explicit(&m->count, 0u, memory_order_relaxed);
+}
+
+void ano_pool_stats(ano_pool_t *pool, ano_pool_stats_t *out)
+{
+    size_t cached = 0;
+    for (uint32_t i = 0; i < ANO_POOL_THREADS; i++)
+        cached += atomic_load_explicit(&pool->mags[i].count, memory_order_relaxed);
+    ano_mutex_lock(&pool->lock);
+    size_t pages    = pool->pageCount;
+    size_t capacity = pages * pool->perPage;
+    size_t carved   = pool->carved;
+    size_t central  = pool->centralCount;
+    ano_mutex_unlock(&pool->lock);
+    size_t remote = atomic_load_explicit(&pool->remoteCount, memory_order_relaxed);
+    size_t idle   = central + remote + cached;
+    size_t live   = carved > idle ? carved - idle : 0u;
+    if (cached > capacity - live)
+        cached = capacity - live;   // a magazine count read mid-update
+    *out = (ano_pool_stats_t){
+        .stride   = pool->stride,
+        .pages    = pages,
+        .capacity = capacity,
+        .live     = live,
+        .cached   = cached,
+        .free     = capacity - live - cached,
+    };
+}
@@ -0,0 +1,653 @@
+/* SPDX-FileCopyrightText: 2026 Anoptic Game Engine Authors
+ *
+ * SPDX-License-Identifier: LGPL-3.0 */
+/*  == Anoptic Game Engine v0.0000001 == */
+
+// Mesh cooking and the .anomesh file.
+//
+// File layout, native byte order, every section at an offset from the file start:
+//   header (64 B) | chainStart u32[chainCount + 1] | pad to 16 | level records (64 B each)
+//   | per level: vertices, pad to 16, metadata, pad to 16
+// chainStart[i] is chain i's first level record; chain i holds records [chainStart[i], chainStart[i + 1]).
+// A level's vertices and metadata are the bytes ano_mesh_level_t points at, ready for staging.
+
+#include "mesh/ano_meshcook.h"
+#include "anoptic_filesystem.h"
+#include "anoptic_jobs.h"
+#include "anoptic_memory.h"
+#include <string.h>
+#include <stdio.h>
+#include <math.h>
+
+// Cooked levels and their scratch, counted under "meshcook" (anoptic_memory.h).
+static ano_mem_tag_t g_cookMem = ANO_MEM_TAG("meshcook");
+#define cook_alloc(size) ano_tmalloc(&g_cookMem, (size))
+#define cook_free(ptr)   ano_tfree(&g_cookMem, (ptr))
+
+#define FILE_VERSION 1u
+#define FILE_ENDIAN  0x01020304u
+#define FILE_ALIGN   16u
+
+typedef struct {
+    char     magic[7];      // "ANOMESH"
+    uint8_t  version;
+    uint32_t endian;        // FILE_ENDIAN as written: a foreign byte order reads differently
+    uint32_t chainCount;
+    uint32_t levelCount;
+    uint32_t vertexStride;  // sizeof(ano_cook_vertex_t)
+    uint16_t maxVertices;   // meshlet limits the levels were built with
+    uint16_t maxTriangles;
+    uint32_t layoutId;      // sizeof(ano_meshlet_t) | sizeof(ano_meshlet_bounds_gpu_t) << 16
+    uint64_t sourceHash;
+    uint64_t configHash;
+    uint64_t fileSize;
+    uint64_t reserved;
+} mesh_header_t;
+
+static_assert(sizeof(mesh_header_t) == 64, "the header is the first 64 bytes of the file");
+
+typedef struct {
+    uint64_t vertexAt;      // file offsets, FILE_ALIGN-aligned
+    uint64_t metadataAt;
+    uint32_t vertexCount;
+    uint32_t metadataSize;
+    uint32_t meshletCount;
+    uint32_t uniqueVerticesOffset;
+    uint32_t trianglesOffset;
+    uint32_t boundsOffset;
+    uint32_t classicIndexOffset;
+    uint32_t classicIndexCount;
+    float    sphere[4];
+} level_record_t;
+
+static_assert(sizeof(level_record_t) == 64, "level records are 64 bytes");
+
+static uint32_t layout_id(void)
+{
+    return (uint32_t)sizeof(ano_meshlet_t) | (uint32_t)sizeof(ano_meshlet_bounds_gpu_t) << 16;
+}
+
+static uint64_t align_up(uint64_t v)
+{
+    return (v + FILE_ALIGN - 1u) & ~(uint64_t)(FILE_ALIGN - 1u);
+}
+
+// ---------------------------------------------------------------------------------------------
+// Hashing.
+
+#define HASH_P1 0x9E3779B185EBCA87ull
+#define HASH_P2 0xC2B2AE3D27D4EB4Full
+#define HASH_P3 0x165667B19E3779F9ull
+
+static inline uint64_t hash_round(uint64_t acc, uint64_t in)
+{
+    acc += in * HASH_P2;
+    acc = (acc << 31) | (acc >> 33);
+    return acc * HASH_P1;
+}
+
+uint64_t ano_mesh_hash_bytes(const void* data, size_t size, uint64_t seed)
+{
+    const uint8_t* p = (const uint8_t*)data;
+    uint64_t h = seed ^ ((uint64_t)size * HASH_P3);
+    size_t i = 0;
+    for (; i + 8u <= size; i += 8u) {
+        uint64_t w;
+        memcpy(&w, p + i, 8);
+        h = hash_round(h, w);
+    }
+    uint64_t tail = 0;
+    if (i < size)
+        memcpy(&tail, p + i, size - i);
+    h = hash_round(h, tail ^ ((uint64_t)(size - i) << 56));
+    h ^= h >> 33;
+    h *= HASH_P2;
+    h ^= h >> 29;
+    h *= HASH_P3;
+    h ^= h >> 32;
+    return h;
+}
+
+uint64_t ano_lod_config_hash(const AnoLodConfig* config)
+{
+    // Normalize to what ano_mesh_cook_chain reads, so configs that cook the same hash the same.
+    AnoLodConfig c;
+    memset(&c, 0, sizeof c);
+    c.lodCount = config ? config->lodCount : 1u;
+    if (c.lodCount < 1u) c.lodCount = 1u;
+    if (c.lodCount > ANO_MAX_LOD) c.lodCount = ANO_MAX_LOD;
+    if (config && c.lodCount > 1u) {
+        memcpy(c.ratios, config->ratios, c.lodCount * sizeof(float));
+        c.ratios[0] = 1.0f;     // level 0 is the source whatever ratios[0] says
+        c.targetError = config->targetError;
+        c.edgeLenFactor = config->edgeLenFactor;
+        c.normalWeight = config->normalWeight;
+        c.uvWeight = config->uvWeight;
+    }
+    // The cook version rides along, so a sibling .anomesh from an older cooker fails its config check.
+    uint32_t limits[3] = { ANO_MESHLET_MAX_VERTICES, ANO_MESHLET_MAX_TRIANGLES, ANO_MESH_COOK_VERSION };
+    return ano_mesh_hash_bytes(&c, sizeof c, ano_mesh_hash_bytes(limits, sizeof limits, 0));
+}
+
+// ---------------------------------------------------------------------------------------------
+// Cooking.
+
+// A sensible default LOD chain: ratios 1, 1/2, 1/4, ... (each level ~half the source triangles) and
+// a 5%-of-extent error budget. lodCount is clamped to [1, ANO_MAX_LOD].
+AnoLodConfig ano_lod_config_default(uint32_t lodCount)
+{
+    AnoLodConfig c;
+    memset(&c, 0, sizeof c);
+    if (lodCount < 1u) lodCount = 1u;
+    if (lodCount > ANO_MAX_LOD) lodCount = ANO_MAX_LOD;
+    c.lodCount = lodCount;
+    c.targetError = 0.05f;
+    c.edgeLenFactor = ANO_SIMPLIFY_EDGE_FACTOR_DEFAULT;  // guard the in-plane courtyard-bridge case
+    c.normalWeight = 0.5f;  // a unit-normal turn of 0.1 (~6deg) costs 5% of extent
+    c.uvWeight = 1.0f;      // a uv slip of 0.05 costs 5% of extent
+    float ratio = 1.0f;
+    for (uint32_t i = 0; i < ANO_MAX_LOD; ++i) {
+        c.ratios[i] = ratio;  // level 0 == 1.0 (full mesh)
+        ratio *= 0.5f;
+    }
+    return c;
+}
+
+// Builds level `level` of chain into one owned block: vertices, then the metadata block in index
+// buffer layout. False (chain untouched) if the meshlet build yields nothing, a block would pass
+// the pool's u32 offsets, or an allocation fails.
+static bool cook_level(ano_mesh_chain_t* chain, uint32_t level,
+                       const ano_cook_vertex_t* vertices, uint32_t vertexCount,
+                       const uint32_t* indices, uint32_t indexCount)
+{
+    size_t maxMeshlets = ano_build_meshlets_bound(indexCount, ANO_MESHLET_MAX_VERTICES, ANO_MESHLET_MAX_TRIANGLES);
+    if (maxMeshlets == 0 || vertexCount == 0)
+        return false;
+
+    ano_meshlet_t* meshlets = cook_alloc(maxMeshlets * sizeof(ano_meshlet_t));
+    uint32_t* meshletVertices = cook_alloc(maxMeshlets * ANO_MESHLET_MAX_VERTICES * sizeof(uint32_t));
+    uint8_t* meshletTriangles = cook_alloc(maxMeshlets * ANO_MESHLET_MAX_TRIANGLES * 3u);
+    size_t meshletCount = 0;
+    if (meshlets && meshletVertices && meshletTriangles)
+        meshletCount = ano_build_meshlets(meshlets, meshletVertices, meshletTriangles, indices, indexCount,
+                                          ANO_MESHLET_MAX_VERTICES, ANO_MESHLET_MAX_TRIANGLES);
+
+    uint8_t* block = NULL;
+    uint64_t vertexSize = (uint64_t)vertexCount * sizeof(ano_cook_vertex_t);
+    uint64_t meshletsSize = 0, uniqueSize = 0, trianglesSize = 0, boundsSize = 0, metadataSize = 0;
+    size_t localCount = 0;
+    if (meshletCount > 0) {
+        const ano_meshlet_t* last = &meshlets[meshletCount - 1];
+        localCount = last->triangle_offset + (size_t)last->triangle_count * 3u;
+        meshletsSize = meshletCount * sizeof(ano_meshlet_t);
+        uniqueSize = ((uint64_t)last->vertex_offset + last->vertex_count) * sizeof(uint32_t);
+        trianglesSize = ((uint64_t)localCount + 3u) & ~(uint64_t)3u;
+        boundsSize = meshletCount * sizeof(ano_meshlet_bounds_gpu_t);
+        metadataSize = meshletsSize + uniqueSize + trianglesSize + boundsSize + (uint64_t)indexCount * sizeof(uint32_t);
+        if (metadataSize <= UINT32_MAX && vertexSize <= UINT32_MAX)
+            block = cook_alloc((size_t)(vertexSize + metadataSize));
+    }
+    if (block == NULL) {
+        cook_free(meshlets);
+        cook_free(meshletVertices);
+        cook_free(meshletTriangles);
+        return false;
+    }
+
+    memcpy(block, vertices, (size_t)vertexSize);
+    uint8_t* meta = block + vertexSize;
+    uint64_t at = 0;
+    memcpy(meta + at, meshlets, (size_t)meshletsSize);
+    at += meshletsSize;
+    memcpy(meta + at, meshletVertices, (size_t)uniqueSize);
+    at += uniqueSize;
+    memcpy(meta + at, meshletTriangles, localCount);
+    memset(meta + at + localCount, 0, (size_t)(trianglesSize - localCount));
+    at += trianglesSize;
+    for (size_t m = 0; m < meshletCount; ++m) {
+        ano_meshlet_bounds_gpu_t b = ano_compute_meshlet_bounds(
+            meshletVertices + meshlets[m].vertex_offset, meshletTriangles + meshlets[m].triangle_offset,
+            meshlets[m].triangle_count, (const float*)vertices, vertexCount, sizeof(ano_cook_vertex_t));
+        memcpy(meta + at + m * sizeof b, &b, sizeof b);
+    }
+    at += boundsSize;
+    memcpy(meta + at, indices, (size_t)indexCount * sizeof(uint32_t));
+
+    ano_mesh_level_t* lvl = &chain->levels[level];
+    *lvl = (ano_mesh_level_t){
+        .vertices = (const ano_cook_vertex_t*)block,
+        .metadata = meta,
+        .vertex_count = vertexCount,
+        .metadata_size = (uint32_t)metadataSize,
+        .meshlet_count = (uint32_t)meshletCount,
+        .unique_vertices_offset = (uint32_t)meshletsSize,
+        .triangles_offset = (uint32_t)(meshletsSize + uniqueSize),
+        .bounds_offset = (uint32_t)(meshletsSize + uniqueSize + trianglesSize),
+        .classic_index_offset = (uint32_t)(meshletsSize + uniqueSize + trianglesSize + boundsSize),
+        .classic_index_count = indexCount,
+    };
+    chain->owned[level] = block;
+
+    // Bounding sphere: AABB center, radius to the farthest vertex.
+    float lo[3], hi[3];
+    for (int k = 0; k < 3; ++k)
+        lo[k] = hi[k] = vertices[0].position[k];
+    for (uint32_t i = 1; i < vertexCount; ++i) {
+        for (int k = 0; k < 3; ++k) {
+            float p = vertices[i].position[k];
+            if (p < lo[k]) lo[k] = p;
+            if (p > hi[k]) hi[k] = p;
+        }
+    }
+    for (int k = 0; k < 3; ++k)
+        lvl->sphere[k] = (lo[k] + hi[k]) * 0.5f;
+    float maxDistSq = 0.0f;
+    for (uint32_t i = 0; i < vertexCount; ++i) {
+        float dx = vertices[i].position[0] - lvl->sphere[0];
+        float dy = vertices[i].position[1] - lvl->sphere[1];
+        float dz = vertices[i].position[2] - lvl->sphere[2];
+        float distSq = dx*dx + dy*dy + dz*dz;
+        if (distSq > maxDistSq) maxDistSq = distSq;
+    }
+    lvl->sphere[3] = sqrtf(maxDistSq);
+
+    cook_free(meshlets);
+    cook_free(meshletVertices);
+    cook_free(meshletTriangles);
+    return true;
+}
+
+// Gather the vertices referenced by `indices` into a dense prefix of outVerts, rewriting `indices`
+// in place to address that prefix (mesh-local, 0-based). Lets a decimated LOD level store only the
+// vertices it actually uses instead of a full copy of the source array. outVerts must hold at least
+// srcVertexCount entries (worst case == every vertex still referenced); remap is one u32 per source
+// vertex. Returns the compacted vertex count (<= srcVertexCount), or 0 if the remap allocation fails
+// (the caller then keeps the full array, indices untouched). Precondition: every index < srcVertexCount
+// (ano_simplify emits only a valid subset of the source vertices).
+static uint32_t compact_level(const ano_cook_vertex_t* srcVerts, uint32_t srcVertexCount,
+                              uint32_t* indices, uint32_t indexCount, ano_cook_vertex_t* outVerts)
+{
+    uint32_t* remap = cook_alloc((size_t)srcVertexCount * sizeof(uint32_t));
+    if (!remap) return 0;
+    memset(remap, 0xFF, (size_t)srcVertexCount * sizeof(uint32_t)); // 0xFFFFFFFF == unassigned
+
+    uint32_t next = 0;
+    for (uint32_t i = 0; i < indexCount; ++i) {
+        uint32_t old = indices[i];
+        if (remap[old] == 0xFFFFFFFFu) {
+            remap[old] = next;
+            outVerts[next] = srcVerts[old];
+            next++;
+        }
+        indices[i] = remap[old];
+    }
+    cook_free(remap);
+    return next;
+}
+
+// One level of a chain being cooked, run as its own job: every level reads only the source, so
+// they are independent and the chain's levels cook concurrently.
+typedef struct {
+    ano_mesh_chain_t*        chain;
+    const ano_cook_vertex_t* vertices;
+    const uint32_t*          indices;
+    const AnoLodConfig*      config;
+    uint32_t                 vertexCount;
+    uint32_t                 indexCount;
+    uint32_t                 level;
+    bool                     ok;
+} level_job_t;
+
+static_assert(offsetof(ano_cook_vertex_t, tex_coord) == offsetof(ano_cook_vertex_t, normal) + 3 * sizeof(float),
+              "the simplifier reads normal and uv as one attribute run");
+
+static void cook_level_job(void* arg)
+{
+    level_job_t* job = arg;
+    if (job->level == 0) {
+        job->ok = cook_level(job->chain, 0, job->vertices, job->vertexCount, job->indices, job->indexCount);
+        return;
+    }
+
+    // Scratch of its own, so levels never share:
+    //  - simplified: ano_simplify writes a subset but its destination must hold the full source count.
+    //  - compacted:  the vertex subset the level references; worst case == the full count.
+    const AnoLodConfig* config = job->config;
+    uint32_t* simplified = cook_alloc((size_t)job->indexCount * sizeof(uint32_t));
+    ano_cook_vertex_t* compacted = cook_alloc((size_t)job->vertexCount * sizeof(ano_cook_vertex_t));
+    job->ok = false;
+    if (simplified) {
+        float ratio = config->ratios[job->level];
+        if (ratio <= 0.0f || ratio > 1.0f) ratio = 1.0f;
+        uint32_t targetIdx = (uint32_t)((float)job->indexCount * ratio);
+        targetIdx -= targetIdx % 3u;
+        if (targetIdx < 3u) targetIdx = 3u;
+        // Pass order, the faster of the two (anotest_meshoptimizer --bench), scratch from this worker's
+        // ambient arena (the simplifier rewinds it). The normal and uv follow the position in the
+        // vertex, so they are one attribute run of five floats.
+        const float weights[5] = { config->normalWeight, config->normalWeight, config->normalWeight,
+                                   config->uvWeight, config->uvWeight };
+        size_t got = ano_simplify_with_attributes(simplified, job->indices, job->indexCount,
+                                                  job->vertices[0].position, job->vertexCount,
+                                                  sizeof(ano_cook_vertex_t), job->vertices[0].normal,
+                                                  sizeof(ano_cook_vertex_t), weights,
+                                                  (config->normalWeight != 0.0f || config->uvWeight != 0.0f) ? 5 : 0,
+                                                  targetIdx,
+                                                  config->targetError, config->edgeLenFactor,
+                                                  ANO_SIMPLIFY_DETERMINISTIC,
+                                                  ano_scratch(NULL), NULL);
+        if (got >= 3u) {  // otherwise the simplifier produced nothing usable: the chain ends before here
+            ano_optimize_vertex_cache(simplified, simplified, got, job->vertexCount);
+            const ano_cook_vertex_t* lvlVertices = job->vertices;
+            uint32_t lvlVertexCount = job->vertexCount;
+            // Compact to just the referenced vertices (remaps `simplified` in place). On alloc failure
+            // (cc==0) keep the full array with the unmodified indices — correct, just not space-optimal.
+            if (compacted) {
+                uint32_t cc = compact_level(job->vertices, job->vertexCount, simplified, (uint32_t)got, compacted);
+                if (cc > 0u) { lvlVertices = compacted; lvlVertexCount = cc; }
+            }
+            job->ok = cook_level(job->chain, job->level, lvlVertices, lvlVertexCount, simplified, (uint32_t)got);
+        }
+    }
+    cook_free(simplified);
+    cook_free(compacted);
+}
+
+uint32_t ano_mesh_cook_chain(ano_mesh_chain_t* chain, const ano_cook_vertex_t* vertices, uint32_t vertex_count,
+                             const uint32_t* indices, uint32_t index_count, const AnoLodConfig* config)
+{
+    memset(chain, 0, sizeof *chain);
+    uint32_t want = config ? config->lodCount : 1u;
+    if (want < 1u) want = 1u;
+    if (want > ANO_MAX_LOD) want = ANO_MAX_LOD;
+
+    // Every level is a job on the pool (anoptic_jobs.h), each simplifying the source to its own
+    // target; with the pool stopped they run inline, one after another. Output does not depend on
+    // which: a level writes only its own slot.
+    level_job_t jobs[ANO_MAX_LOD];
+    AnoJobDecl decls[ANO_MAX_LOD];
+    for (uint32_t lvl = 0; lvl < want; ++lvl) {
+        jobs[lvl] = (level_job_t){
+            .chain = chain, .vertices = vertices, .indices = indices, .config = config,
+            .vertexCount = vertex_count, .indexCount = index_count, .level = lvl,
+        };
+        decls[lvl] = (AnoJobDecl){ cook_level_job, &jobs[lvl] };
+    }
+    AnoJobCounter counter = {0};
+    ano_jobs_run(decls, want, &counter);
+    ano_jobs_wait(&counter);
+
+    // The chain ends at the first level that failed; anything cooked past it is dropped.
+    while (chain->level_count < want && jobs[chain->level_count].ok)
+        chain->level_count++;
+    for (uint32_t lvl = chain->level_count; lvl < want; ++lvl) {
+        cook_free(chain->owned[lvl]);
+        chain->owned[lvl] = NULL;
+        memset(&chain->levels[lvl], 0, sizeof chain->levels[lvl]);
+    }
+    return chain->level_count;
+}
+
+void ano_mesh_chain_free(ano_mesh_chain_t* chain)
+{
+    if (chain == NULL)
+        return;
+    for (uint32_t i = 0; i < ANO_MAX_LOD; ++i)
+        cook_free(chain->owned[i]);
+    memset(chain, 0, sizeof *chain);
+}
+
+// ---------------------------------------------------------------------------------------------
+// The .anomesh file.
+
+static uint64_t records_at(uint32_t chainCount)
+{
+    return align_up(sizeof(mesh_header_t) + ((uint64_t)chainCount + 1u) * sizeof(uint32_t));
+}
+
+// Where an encoded .anomesh goes: a file for ano_mesh_file_save, a cache writer for ano_mesh_file_put_cache.
+typedef bool (*mesh_sink_fn)(void* ctx, const void* bytes, size_t size);
+
+static bool file_sink(void* ctx, const void* bytes, size_t size)
+{
+    return ano_fs_write(ctx, bytes, size) == 0;
+}
+
+static bool cache_sink(void* ctx, const void* bytes, size_t size)
+{
+    return ano_fs_cache_put_write(ctx, bytes, size) == 0;
+}
+
+static bool write_padded(mesh_sink_fn sink, void* ctx, const void* bytes, uint64_t size)
+{
+    static const uint8_t zeros[FILE_ALIGN];
+    uint64_t pad = align_up(size) - size;
+    return sink(ctx, bytes, (size_t)size) && (pad == 0 || sink(ctx, zeros, (size_t)pad));
+}
+
+// Encodes chains as one .anomesh into sink: header and tables as one buffer, the level blocks
+// straight from the chains.
+static bool mesh_file_emit(mesh_sink_fn sink, void* ctx, const ano_mesh_chain_t* chains, uint32_t chain_count,
+                           uint64_t source_hash, uint64_t config_hash)
+{
+    uint64_t levelCount = 0;
+    for (uint32_t c = 0; c < chain_count; ++c)
+        levelCount += chains[c].level_count > ANO_MAX_LOD ? ANO_MAX_LOD : chains[c].level_count;
+    if (levelCount > UINT32_MAX)
+        return false;
+
+    uint64_t recordsAt = records_at(chain_count);
+    uint64_t tableSize = recordsAt + levelCount * sizeof(level_record_t);
+    uint8_t* table = tableSize <= SIZE_MAX ? cook_alloc((size_t)tableSize) : NULL;
+    if (table == NULL)
+        return false;
+    memset(table, 0, (size_t)tableSize);
+
+    uint32_t* chainStart = (uint32_t*)(table + sizeof(mesh_header_t));
+    level_record_t* records = (level_record_t*)(table + recordsAt);
+    uint64_t at = tableSize;
+    uint32_t r = 0;
+    for (uint32_t c = 0; c < chain_count; ++c) {
+        chainStart[c] = r;
+        uint32_t n = chains[c].level_count > ANO_MAX_LOD ? ANO_MAX_LOD : chains[c].level_count;
+        for (uint32_t l = 0; l < n; ++l, ++r) {
+            const ano_mesh_level_t* lvl = &chains[c].levels[l];
+            records[r] = (level_record_t){
+                .vertexAt = at,
+                .metadataAt = at + align_up((uint64_t)lvl->vertex_count * sizeof(ano_cook_vertex_t)),
+                .vertexCount = lvl->vertex_count, .metadataSize = lvl->metadata_size,
+                .meshletCount = lvl->meshlet_count, .uniqueVerticesOffset = lvl->unique_vertices_offset,
+                .trianglesOffset = lvl->triangles_offset, .boundsOffset = lvl->bounds_offset,
+                .classicIndexOffset = lvl->classic_index_offset, .classicIndexCount = lvl->classic_index_count,
+            };
+            memcpy(records[r].sphere, lvl->sphere, sizeof lvl->sphere);
+            at = records[r].metadataAt + align_up(lvl->metadata_size);
+        }
+    }
+    chainStart[chain_count] = r;
+
+    mesh_header_t hdr = {
+        .magic = { 'A', 'N', 'O', 'M', 'E', 'S', 'H' }, .version = FILE_VERSION, .endian = FILE_ENDIAN,
+        .chainCount = chain_count, .levelCount = (uint32_t)levelCount,
+        .vertexStride = sizeof(ano_cook_vertex_t),
+        .maxVertices = ANO_MESHLET_MAX_VERTICES, .maxTriangles = ANO_MESHLET_MAX_TRIANGLES,
+        .layoutId = layout_id(), .sourceHash = source_hash, .configHash = config_hash, .fileSize = at,
+    };
+    memcpy(table, &hdr, sizeof hdr);
+
+    bool ok = sink(ctx, table, (size_t)tableSize);
+    for (uint32_t c = 0; ok && c < chain_count; ++c) {
+        uint32_t n = chains[c].level_count > ANO_MAX_LOD ? ANO_MAX_LOD : chains[c].level_count;
+        for (uint32_t l = 0; ok && l < n; ++l) {
+            const ano_mesh_level_t* lvl = &chains[c].levels[l];
+            ok = write_padded(sink, ctx, lvl->vertices, (uint64_t)lvl->vertex_count * sizeof(ano_cook_vertex_t)) &&
+                 write_padded(sink, ctx, lvl->metadata, lvl->metadata_size);
+        }
+    }
+    cook_free(table);
+    return ok;
+}
+
+int ano_mesh_file_save(const char* path, const ano_mesh_chain_t* chains, uint32_t chain_count,
+                       uint64_t source_hash, uint64_t config_hash)
+{
+    if (path == NULL || (chains == NULL && chain_count > 0))
+        return -1;
+    char tmp[MAXPATH + 8];
+    if (snprintf(tmp, sizeof tmp, "%s.tmp", path) >= (int)sizeof tmp)
+        return -1;
+
+    ano_file* f = ano_fs_open_trunc(tmp);
+    bool ok = f != NULL && mesh_file_emit(file_sink, f, chains, chain_count, source_hash, config_hash);
+    if (f != NULL) {
+        if (ok && ano_fs_sync(f) != 0)
+            ok = false;
+        if (ano_fs_close(f) != 0)
+            ok = false;
+    }
+    if (ok && ano_fs_replace(tmp, path) != 0)
+        ok = false;
+    if (!ok)
+        remove(tmp);
+    return ok ? 0 : -1;
+}
+
+int ano_mesh_file_put_cache(const ano_fs_cache_key* key, const ano_mesh_chain_t* chains, uint32_t chain_count,
+                            uint64_t source_hash, uint64_t config_hash)
+{
+    if (chains == NULL && chain_count > 0)
+        return -1;
+    ano_fs_cache_writer* w = ano_fs_cache_put_begin(key);
+    if (w == NULL)
+        return -1;
+    bool ok = mesh_file_emit(cache_sink, w, chains, chain_count, source_hash, config_hash);
+    return ano_fs_cache_put_end(w, ok) == 0 && ok ? 0 : -1;
+}
+
+// One level record against the mapping: the blocks lie inside the file, the metadata sections
+// tile the block in order, and every index a draw or the mesh shader follows stays in range.
+static bool level_ok(const level_record_t* r, const uint8_t* map, uint64_t size)
+{
+    if (r->vertexCount == 0 || r->meshletCount == 0 || r->classicIndexCount % 3u != 0 ||
+        r->vertexAt % FILE_ALIGN != 0 || r->metadataAt % FILE_ALIGN != 0 ||
+        r->vertexAt > size || (uint64_t)r->vertexCount * sizeof(ano_cook_vertex_t) > size - r->vertexAt ||
+        r->metadataAt > size || r->metadataSize > size - r->metadataAt)
+        return false;
+
+    uint64_t uniqueAt = (uint64_t)r->meshletCount * sizeof(ano_meshlet_t);
+    uint64_t classicAt = (uint64_t)r->boundsOffset + (uint64_t)r->meshletCount * sizeof(ano_meshlet_bounds_gpu_t);
+    if (r->uniqueVerticesOffset != uniqueAt || r->trianglesOffset < r->uniqueVerticesOffset ||
+        r->trianglesOffset % 4u != 0 || r->boundsOffset < r->trianglesOffset || r->boundsOffset % 4u != 0 ||
+        r->classicIndexOffset != classicAt ||
+        r->metadataSize != classicAt + (uint64_t)r->classicIndexCount * sizeof(uint32_t))
+        return false;
+
+    const uint8_t* meta = map + r->metadataAt;
+    const ano_meshlet_t* meshlets = (const ano_meshlet_t*)meta;
+    const uint32_t* unique = (const uint32_t*)(meta + r->uniqueVerticesOffset);
+    const uint8_t* triangles = meta + r->trianglesOffset;
+    const uint32_t* classic = (const uint32_t*)(meta + r->classicIndexOffset);
+    uint64_t uniqueCount = (r->trianglesOffset - r->uniqueVerticesOffset) / sizeof(uint32_t);
+    uint64_t triangleBytes = r->boundsOffset - r->trianglesOffset;
+
+    for (uint64_t i = 0; i < uniqueCount; ++i)
+        if (unique[i] >= r->vertexCount)
+            return false;
+    for (uint32_t m = 0; m < r->meshletCount; ++m) {
+        ano_meshlet_t ml = meshlets[m];
+        if (ml.vertex_count > ANO_MESHLET_MAX_VERTICES || ml.triangle_count > ANO_MESHLET_MAX_TRIANGLES ||
+            (uint64_t)ml.vertex_offset + ml.vertex_count > uniqueCount ||
+            (uint64_t)ml.triangle_offset + (uint64_t)ml.triangle_count * 3u > triangleBytes)
+            return false;
+        for (uint32_t t = 0; t < ml.triangle_count * 3u; ++t)
+            if (triangles[ml.triangle_offset + t] >= ml.vertex_count)
+                return false;
+    }
+    for (uint32_t i = 0; i < r->classicIndexCount; ++i)
+        if (classic[i] >= r->vertexCount)
+            return false;
+    return true;
+}
+
+bool ano_mesh_file_view(ano_mesh_file_t* file, const void* data, size_t size)
+{
+    memset(file, 0, sizeof *file);
+    const uint8_t* map = (const uint8_t*)data;
+    mesh_header_t hdr;
+    if (map == NULL || size < sizeof hdr || (uintptr_t)map % FILE_ALIGN != 0)
+        return false;
+    memcpy(&hdr, map, sizeof hdr);
+    if (memcmp(hdr.magic, "ANOMESH", 7) != 0 || hdr.version != FILE_VERSION || hdr.endian != FILE_ENDIAN ||
+        hdr.vertexStride != sizeof(ano_cook_vertex_t) || hdr.layoutId != layout_id() ||
+        hdr.maxVertices != ANO_MESHLET_MAX_VERTICES || hdr.maxTriangles != ANO_MESHLET_MAX_TRIANGLES ||
+        hdr.fileSize != size)
+        return false;
+    uint64_t recordsAt = records_at(hdr.chainCount);
+    if (recordsAt + (uint64_t)hdr.levelCount * sizeof(level_record_t) > size)
+        return false;
+
+    // Chain starts begin at 0, never step back, take at most ANO_MAX_LOD levels each and end at levelCount.
+    const uint32_t* chainStart = (const uint32_t*)(map + sizeof(mesh_header_t));
+    if (chainStart[0] != 0 || chainStart[hdr.chainCount] != hdr.levelCount)
+        return false;
+    for (uint32_t c = 0; c < hdr.chainCount; ++c)
+        if (chainStart[c + 1] < chainStart[c] || chainStart[c + 1] - chainStart[c] > ANO_MAX_LOD)
+            return false;
+    const level_record_t* records = (const level_record_t*)(map + recordsAt);
+    for (uint32_t r = 0; r < hdr.levelCount; ++r)
+        if (!level_ok(&records[r], map, size))
+            return false;
+
+    *file = (ano_mesh_file_t){
+        .map = map, .size = size, .chain_count = hdr.chainCount,
+        .source_hash = hdr.sourceHash, .config_hash = hdr.configHash,
+    };
+    return true;
+}
+
+bool ano_mesh_file_map(ano_mesh_file_t* file, const char* path)
+{
+    memset(file, 0, sizeof *file);
+    size_t size = 0;
+    const void* map = path ? ano_fs_map_read(path, &size) : NULL;
+    if (map == NULL)
+        return false;
+    if (!ano_mesh_file_view(file, map, size)) {
+        ano_fs_unmap(map, size);
+        return false;
+    }
+    file->mapped = true;
+    return true;
+}
+
+bool ano_mesh_file_chain(const ano_mesh_file_t* file, uint32_t index, ano_mesh_chain_t* chain)
+{
+    memset(chain, 0, sizeof *chain);
+    if (file == NULL || file->map == NULL || index >= file->chain_count)
+        return false;
+    const uint32_t* chainStart = (const uint32_t*)(file->map + sizeof(mesh_header_t));
+    const level_record_t* records = (const level_record_t*)(file->map + records_at(file->chain_count));
+    for (uint32_t r = chainStart[index]; r < chainStart[index + 1]; ++r) {
+        const level_record_t* rec = &records[r];
+        ano_mesh_level_t* lvl = &chain->levels[chain->level_count++];
+        *lvl = (ano_mesh_level_t){
+            .vertices = (const ano_cook_vertex_t*)(file->map + rec->vertexAt),
+            .metadata = file->map + rec->metadataAt,
+            .vertex_count = rec->vertexCount, .metadata_size = rec->metadataSize,
+            .meshlet_count = rec->meshletCount, .unique_vertices_offset = rec->uniqueVerticesOffset,
+            .triangles_offset = rec->trianglesOffset, .bounds_offset = rec->boundsOffset,
+            .classic_index_offset = rec->classicIndexOffset, .classic_index_count = rec->classicIndexCount,
+        };
+        memcpy(lvl->sphere, rec->sphere, sizeof lvl->sphere);
+    }
+    return true;
+}
+
+void ano_mesh_file_unmap(ano_mesh_file_t* file)
+{
+    if (file == NULL)
+        return;
+    if (file->mapped && file->map != NULL)
+        ano_fs_unmap(file->map, file->size);
+    memset(file, 0, sizeof *file);
+}
@@ -0,0 +1,183 @@
+/* SPDX-FileCopyrightText: 2026 Anoptic Game Engine Authors
+ *
+ * SPDX-License-Identifier: LGPL-3.0 */
+/*  == Anoptic Game Engine v0.0000001 == */
+
+#ifndef ANO_MESHCOOK_H
+#define ANO_MESHCOOK_H
+
+/* Mesh cooking: everything between a source triangle list and the bytes the geometry pool uploads
+ * (LOD chain, vertex-cache order, meshlets, meshlet bounds, bounding sphere), GPU-free so it runs
+ * at load time or offline in anomesh_cook. A cooked chain saves as a versioned .anomesh file that
+ * maps back read-only, so loading a cooked mesh is a map and two memcpys per level to staging. */
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "anoptic_filesystem.h"
+#include "mesh/ano_meshoptimizer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ANO_MAX_LOD 8u
+
+// Version of what ano_mesh_cook_chain produces, folded into derived-data cache keys. Bump it with
+// any change to the simplifier, vertex-cache order, meshlet builder or bounds that alters output.
+#define ANO_MESH_COOK_VERSION 4u
+
+// Default LOD levels glTF uploads request. 4 == LOD chains on engine-wide: level 0 full detail plus
+// three decimated levels (ratios 1, 1/2, 1/4, 1/8). Set to 1 for a single full-detail mesh with no
+// decimation; the clamp is ANO_MAX_LOD.
+#define ANO_DEFAULT_LOD_COUNT 4u
+
+// Meshlet limits every cooked level is built with (flat.mesh's output limits).
+#define ANO_MESHLET_MAX_VERTICES  64u
+#define ANO_MESHLET_MAX_TRIANGLES 126u
+
+// LOD chain production config (review 4.9 step 2). lodCount levels are emitted as a contiguous run
+// of mesh indices: level 0 is the full mesh, level i is the source decimated to ratios[i] of the
+// source index count under targetError. ratios[0] is conventionally 1.0 (level 0 == full).
+typedef struct AnoLodConfig
+{
+    uint32_t lodCount;             // levels to emit (>=1, clamped to ANO_MAX_LOD)
+    float    ratios[ANO_MAX_LOD];  // per-level target index fraction of the source (level 0 == 1.0)
+    float    targetError;          // ano_simplify relative error budget (fraction of bbox extent)
+    float    edgeLenFactor;        // in-plane growth cap: max resulting edge in source mean-edge lengths
+                                   // (ano_simplify_arena); 0 disables the guard (A/B baseline)
+    float    normalWeight;         // attribute weights (ano_simplify_with_attributes) for the normal and
+    float    uvWeight;             // the uv; both 0 simplifies on geometry alone
+} AnoLodConfig;
+
+// A sensible default chain: ratios 1, 1/2, 1/4, ..., a 5%-of-extent error budget, and normals and uvs
+// weighted so seams hold and shading drift counts against that budget.
+AnoLodConfig ano_lod_config_default(uint32_t lodCount);
+
+/**
+ * Identity of a config for cooked-file freshness: equal configs hash equal, under the same
+ * ANO_MESH_COOK_VERSION. NULL hashes as the single-level chain.
+ */
+uint64_t ano_lod_config_hash(const AnoLodConfig* config);
+
+/**
+ * Seeded 64-bit hash of a byte range, eight bytes a step. Chain calls through seed to hash
+ * several ranges as one. Not cryptographic; used for source identity.
+ */
+uint64_t ano_mesh_hash_bytes(const void* data, size_t size, uint64_t seed);
+
+/* The geometry pool's vertex, byte for byte (vulkan_backend Vertex, checked there). */
+typedef struct {
+    float position[3];
+    float normal[3];
+    float tex_coord[2];
+} ano_cook_vertex_t;
+
+static_assert(sizeof(ano_cook_vertex_t) == 32, "cooked vertices are the pool's 32-byte Vertex");
+
+/**
+ * One cooked mesh level: its vertices, and the metadata block the index buffer stores for it,
+ *     meshlets | meshlet vertices u32 | local triangles u8, zero-padded to 4 | bounds | classic u32 indices
+ * The *_offset fields are byte offsets into metadata. sphere is the level's bounding sphere
+ * (AABB center, farthest vertex), xyz then radius.
+ */
+typedef struct {
+    const ano_cook_vertex_t* vertices;
+    const uint8_t*           metadata;
+    uint32_t vertex_count;
+    uint32_t metadata_size;
+    uint32_t meshlet_count;
+    uint32_t unique_vertices_offset;
+    uint32_t triangles_offset;
+    uint32_t bounds_offset;
+    uint32_t classic_index_offset;
+    uint32_t classic_index_count;
+    float    sphere[4];
+} ano_mesh_level_t;
+
+/* A cooked LOD chain. owned[i] backs level i when cooked in memory; all NULL for a view into a
+ * mapped .anomesh. level_count 0 is an empty chain (a skipped primitive). */
+typedef struct {
+    uint32_t         level_count;
+    ano_mesh_level_t levels[ANO_MAX_LOD];
+    void*            owned[ANO_MAX_LOD];
+} ano_mesh_chain_t;
+
+/**
+ * Cooks a source mesh into a LOD chain. Level 0 is the source as given; level i is the SOURCE
+ * decimated (ano_simplify_with_attributes in pass order over the vertex normal and uv, so error never
+ * compounds across levels) to
+ * config->ratios[i] of the index count, re-ordered by ano_optimize_vertex_cache and compacted to the
+ * vertices it references.
+ * Every level then gets its meshlets, meshlet bounds and bounding sphere.
+ *
+ * Levels cook concurrently as jobs on the pool (anoptic_jobs.h) and the call returns once all are
+ * done; with the pool stopped they run inline. The result is the same either way. Reentrant: any
+ * thread or job may cook its own chain alongside others.
+ *
+ * config NULL cooks level 0 alone. Every index must be < vertex_count.
+ * Returns the level count produced: the chain truncates where the simplifier stalls, and is empty
+ * (0) if level 0 cannot be built. Release with ano_mesh_chain_free either way.
+ */
+uint32_t ano_mesh_cook_chain(ano_mesh_chain_t* chain, const ano_cook_vertex_t* vertices, uint32_t vertex_count,
+                             const uint32_t* indices, uint32_t index_count, const AnoLodConfig* config);
+
+/**
+ * Frees a cooked chain's levels and empties it. A mapped view only empties.
+ */
+void ano_mesh_chain_free(ano_mesh_chain_t* chain);
+
+/**
+ * Writes chains[0..chain_count) as one .anomesh file, atomically (a temporary, then a rename over
+ * path). source_hash and config_hash are stored for the loader to compare. 0, or -1 on failure.
+ */
+int ano_mesh_file_save(const char* path, const ano_mesh_chain_t* chains, uint32_t chain_count,
+                       uint64_t source_hash, uint64_t config_hash);
+
+/**
+ * ano_mesh_file_save into the derived-data cache under key (anoptic_filesystem.h): the entry's
+ * payload is the .anomesh image, which ano_mesh_file_view reads back from a hit in place.
+ * 0, or -1 if the cache is off or the entry cannot be written.
+ */
+int ano_mesh_file_put_cache(const ano_fs_cache_key* key, const ano_mesh_chain_t* chains, uint32_t chain_count,
+                            uint64_t source_hash, uint64_t config_hash);
+
+/* A mapped, validated .anomesh. */
+typedef struct {
+    const uint8_t* map;
+    size_t         size;
+    uint32_t       chain_count;
+    uint64_t       source_hash;
+    uint64_t       config_hash;
+    bool           mapped;      // map came from ano_mesh_file_map, not ano_mesh_file_view
+} ano_mesh_file_t;
+
+/**
+ * Maps path read-only and validates everything an upload trusts: the header, every section bound,
+ * each level's block layout, and every meshlet and classic index against its vertex count.
+ * False (nothing mapped) if missing or malformed.
+ */
+bool ano_mesh_file_map(ano_mesh_file_t* file, const char* path);
+
+/**
+ * ano_mesh_file_map over bytes already in memory; they must outlive the file. Unmapping it is a no-op.
+ */
+bool ano_mesh_file_view(ano_mesh_file_t* file, const void* data, size_t size);
+
+/**
+ * Chain index of the file as a view into the mapping (valid until unmap). False if out of range.
+ */
+bool ano_mesh_file_chain(const ano_mesh_file_t* file, uint32_t index, ano_mesh_chain_t* chain);
+
+/**
+ * Unmaps a file from ano_mesh_file_map and empties it.
+ */
+void ano_mesh_file_unmap(ano_mesh_file_t* file);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ANO_MESHCOOK_H
@@ -0,0 +1,298 @@
+/* SPDX-FileCopyrightText: 2026 Anoptic Game Engine Authors
+ *
+ * SPDX-License-Identifier: LGPL-3.0 */
+/*  == Anoptic Game Engine v0.0000001 == */
+
+// glTF primitives into cooked chains. The one cgltf implementation in the engine lives here, so the
+// headless cook tool and the renderer's loader share it.
+
+#include "mesh/ano_meshcook_gltf.h"
+#include "anoptic_jobs.h"
+#include "anoptic_log.h"
+#include "anoptic_memory.h"
+#include <string.h>
+#include <stddef.h>
+
+#define CGLTF_IMPLEMENTATION
+#include <cgltf.h>
+
+// Extracted primitives and cook bookkeeping, counted under "meshcook.gltf" (anoptic_memory.h).
+static ano_mem_tag_t g_gltfCookMem = ANO_MEM_TAG("meshcook.gltf");
+#define gltf_alloc(size) ano_tmalloc(&g_gltfCookMem, (size))
+#define gltf_free(ptr)   ano_tfree(&g_gltfCookMem, (ptr))
+
+// The accessor's first element in a loaded buffer, if `count` elements of elemSize bytes at its
+// stride fit inside its view; NULL for sparse, unloaded or short accessors (cgltf reads those).
+static const uint8_t* accessor_bytes(const cgltf_accessor* a, size_t elemSize, size_t count)
+{
+    const cgltf_buffer_view* view = a->buffer_view;
+    if (a->is_sparse || view == NULL || count == 0 || a->stride < elemSize)
+        return NULL;
+    const uint8_t* base = view->data ? (const uint8_t*)view->data
+                        : view->buffer->data ? (const uint8_t*)view->buffer->data + view->offset : NULL;
+    if (base == NULL || a->offset + (count - 1) * a->stride + elemSize > view->size)
+        return NULL;
+    return base + a->offset;
+}
+
+// Up to `comps` floats per element of a into the field at byte offset `field` of each vertex.
+static bool read_attribute(const cgltf_accessor* a, ano_cook_vertex_t* vertices, uint32_t count,
+                           size_t field, size_t comps)
+{
+    size_t have = cgltf_num_components(a->type);
+    size_t n = have < comps ? have : comps;
+    if (a->count < count)
+        count = (uint32_t)a->count;
+    const uint8_t* src = a->component_type == cgltf_component_type_r_32f && !a->normalized
+                       ? accessor_bytes(a, have * sizeof(float), count) : NULL;
+    if (src) {
+        for (uint32_t v = 0; v < count; ++v)
+            memcpy((uint8_t*)&vertices[v] + field, src + (size_t)v * a->stride, n * sizeof(float));
+        return true;
+    }
+
+    float* unpacked = gltf_alloc((size_t)count * have * sizeof(float) + 1u);
+    if (unpacked == NULL)
+        return false;
+    cgltf_accessor_unpack_floats(a, unpacked, (cgltf_size)count * have);
+    for (uint32_t v = 0; v < count; ++v)
+        memcpy((uint8_t*)&vertices[v] + field, unpacked + (size_t)v * have, n * sizeof(float));
+    gltf_free(unpacked);
+    return true;
+}
+
+static void read_indices(const cgltf_accessor* a, uint32_t* indices, uint32_t count)
+{
+    size_t size = a->component_type == cgltf_component_type_r_8u  ? 1u
+                : a->component_type == cgltf_component_type_r_16u ? 2u
+                : a->component_type == cgltf_component_type_r_32u ? 4u : 0u;
+    const uint8_t* src = size ? accessor_bytes(a, size, count) : NULL;
+    if (src == NULL) {
+        for (uint32_t i = 0; i < count; ++i)
+            indices[i] = (uint32_t)cgltf_accessor_read_index(a, i);
+        return;
+    }
+    for (uint32_t i = 0; i < count; ++i) {
+        const uint8_t* p = src + (size_t)i * a->stride;
+        if (size == 1u) {
+            indices[i] = *p;
+        } else if (size == 2u) {
+            uint16_t v;
+            memcpy(&v, p, 2);
+            indices[i] = v;
+        } else {
+            memcpy(&indices[i], p, 4);
+        }
+    }
+}
+
+bool ano_mesh_gltf_extract(const cgltf_primitive* prim,
+                           ano_cook_vertex_t** vertices, uint32_t* vertex_count,
+                           uint32_t** indices, uint32_t* index_count)
+{
+    *vertices = NULL;
+    *indices = NULL;
+    *vertex_count = 0;
+    *index_count = 0;
+
+    const cgltf_accessor* posAccessor = NULL;
+    const cgltf_accessor* normAccessor = NULL;
+    const cgltf_accessor* texAccessor = NULL;
+    for (size_t a = 0; a < prim->attributes_count; ++a) {
+        const cgltf_attribute* attr = &prim->attributes[a];
+        if (attr->type == cgltf_attribute_type_position) {
+            posAccessor = attr->data;
+        } else if (attr->type == cgltf_attribute_type_normal) {
+            normAccessor = attr->data;
+        } else if (attr->type == cgltf_attribute_type_texcoord && attr->index == 0) {
+            texAccessor = attr->data;
+        }
+    }
+    if (!posAccessor || !prim->indices || posAccessor->count == 0 ||
+        posAccessor->count > UINT32_MAX || prim->indices->count > UINT32_MAX)
+        return false;
+
+    uint32_t vc = (uint32_t)posAccessor->count;
+    uint32_t ic = (uint32_t)prim->indices->count;
+    ano_cook_vertex_t* verts = gltf_alloc((size_t)vc * sizeof(ano_cook_vertex_t));
+    uint32_t* idx = gltf_alloc((size_t)ic * sizeof(uint32_t) + 1u);
+    bool ok = verts != NULL && idx != NULL;
+    if (ok) {
+        memset(verts, 0, (size_t)vc * sizeof(ano_cook_vertex_t));
+        if (!normAccessor) {
+            for (uint32_t v = 0; v < vc; ++v)
+                verts[v].normal[1] = 1.0f;
+        }
+        ok = read_attribute(posAccessor, verts, vc, offsetof(ano_cook_vertex_t, position), 3) &&
+             (!normAccessor || read_attribute(normAccessor, verts, vc, offsetof(ano_cook_vertex_t, normal), 3)) &&
+             (!texAccessor || read_attribute(texAccessor, verts, vc, offsetof(ano_cook_vertex_t, tex_coord), 2));
+    }
+    if (ok) {
+        read_indices(prim->indices, idx, ic);
+        for (uint32_t i = 0; i < ic && ok; ++i)
+            ok = idx[i] < vc;
+        if (!ok)
+            ano_log(ANO_WARN, "glTF primitive index out of range; primitive skipped");
+    }
+    if (!ok) {
+        ano_mesh_gltf_release(verts, idx);
+        return false;
+    }
+    *vertices = verts;
+    *indices = idx;
+    *vertex_count = vc;
+    *index_count = ic;
+    return true;
+}
+
+void ano_mesh_gltf_release(ano_cook_vertex_t* vertices, uint32_t* indices)
+{
+    gltf_free(vertices);
+    gltf_free(indices);
+}
+
+// One primitive to extract and cook, run as its own job.
+typedef struct {
+    const cgltf_primitive* prim;
+    const AnoLodConfig*    config;
+    ano_mesh_chain_t*      chain;
+    size_t                 mesh;
+    size_t                 index;
+} primitive_job_t;
+
+static void cook_primitive_job(void* arg)
+{
+    primitive_job_t* job = arg;
+    ano_cook_vertex_t* vertices;
+    uint32_t* indices;
+    uint32_t vertexCount, indexCount;
+    if (!ano_mesh_gltf_extract(job->prim, &vertices, &vertexCount, &indices, &indexCount)) {
+        ano_log(ANO_WARN, "glTF mesh %zu primitive %zu: no usable positions or indices; cooked empty",
+                job->mesh, job->index);
+        return;
+    }
+    ano_mesh_cook_chain(job->chain, vertices, vertexCount, indices, indexCount, job->config);
+    ano_mesh_gltf_release(vertices, indices);
+}
+
+void ano_mesh_gltf_cook_chains(const cgltf_data* data, const AnoLodConfig* config, ano_mesh_chain_t* chains)
+{
+    uint32_t count = ano_mesh_gltf_primitive_count(data);
+    memset(chains, 0, (size_t)count * sizeof(ano_mesh_chain_t));
+    primitive_job_t* jobs = gltf_alloc((size_t)count * sizeof(primitive_job_t) + 1u);
+    AnoJobDecl* decls = gltf_alloc((size_t)count * sizeof(AnoJobDecl) + 1u);
+
+    uint32_t c = 0;
+    for (size_t m = 0; m < data->meshes_count; ++m) {
+        for (size_t p = 0; p < data->meshes[m].primitives_count && c < count; ++p, ++c) {
+            primitive_job_t job = { &data->meshes[m].primitives[p], config, &chains[c], m, p };
+            if (jobs && decls) {
+                jobs[c] = job;
+                decls[c] = (AnoJobDecl){ cook_primitive_job, &jobs[c] };
+            } else {
+                cook_primitive_job(&job);  // no memory for the batch: one at a time, levels still parallel
+            }
+        }
+    }
+    if (jobs && decls) {
+        AnoJobCounter counter = {0};
+        ano_jobs_run(decls, count, &counter);
+        ano_jobs_wait(&counter);
+    }
+    gltf_free(jobs);
+    gltf_free(decls);
+}
+
+uint64_t ano_mesh_gltf_source_hash(const cgltf_data* data)
+{
+    uint64_t h = ano_mesh_hash_bytes(data->json, data->json_size, 0);
+    if (data->bin)
+        h = ano_mesh_hash_bytes(data->bin, data->bin_size, h);
+    for (size_t b = 0; b < data->buffers_count; ++b) {
+        const cgltf_buffer* buffer = &data->buffers[b];
+        if (buffer->data && buffer->data != data->bin)
+            h = ano_mesh_hash_bytes(buffer->data, buffer->size, h);
+    }
+    return h;
+}
+
+ano_fs_cache_key ano_mesh_gltf_cache_key(const cgltf_data* data, const AnoLodConfig* config)
+{
+    ano_fs_cache_key key = ano_fs_cache_key_begin("anomesh", ANO_MESH_COOK_VERSION);
+    ano_fs_cache_key_add(&key, data->json, data->json_size);
+    if (data->bin)
+        ano_fs_cache_key_add(&key, data->bin, data->bin_size);
+    for (size_t b = 0; b < data->buffers_count; ++b) {
+        const cgltf_buffer* buffer = &data->buffers[b];
+        if (buffer->data && buffer->data != data->bin)
+            ano_fs_cache_key_add(&key, buffer->data, buffer->size);
+    }
+    uint64_t configHash = ano_lod_config_hash(config);
+    ano_fs_cache_key_add(&key, &configHash, sizeof configHash);
+    return key;
+}
+
+uint32_t ano_mesh_gltf_primitive_count(const cgltf_data* data)
+{
+    uint64_t count = 0;
+    for (size_t m = 0; m < data->meshes_count; ++m)
+        count += data->meshes[m].primitives_count;
+    return count > UINT32_MAX ? UINT32_MAX : (uint32_t)count;
+}
+
+bool ano_mesh_gltf_open_cooked(ano_mesh_file_t* file, const char* cooked_path,
+                               const cgltf_data* data, const AnoLodConfig* config)
+{
+    if (!ano_mesh_file_map(file, cooked_path))
+        return false;
+    if (file->chain_count == ano_mesh_gltf_primitive_count(data) &&
+        file->config_hash == ano_lod_config_hash(config) &&
+        file->source_hash == ano_mesh_gltf_source_hash(data))
+        return true;
+    ano_mesh_file_unmap(file);
+    return false;
+}
+
+bool ano_mesh_gltf_open_cached(ano_mesh_file_t* file, ano_fs_cache_blob* blob,
+                               const ano_fs_cache_key* key, const cgltf_data* data)
+{
+    if (!ano_fs_cache_get(key, blob))
+        return false;
+    if (ano_mesh_file_view(file, blob->data, blob->size) && file->chain_count == ano_mesh_gltf_primitive_count(data))
+        return true;
+    ano_mesh_file_unmap(file);
+    ano_fs_cache_release(blob);
+    return false;
+}
+
+int ano_mesh_cook_gltf(const char* gltf_path, const char* out_path, const AnoLodConfig* config)
+{
+    cgltf_options options = {0};
+    cgltf_data* data = NULL;
+    if (cgltf_parse_file(&options, gltf_path, &data) != cgltf_result_success) {
+        ano_log(ANO_ERROR, "Failed to parse glTF file: %s", gltf_path);
+        return -1;
+    }
+    if (cgltf_load_buffers(&options, data, gltf_path) != cgltf_result_success) {
+        ano_log(ANO_ERROR, "Failed to load glTF buffers for: %s", gltf_path);
+        cgltf_free(data);
+        return -1;
+    }
+
+    uint32_t count = ano_mesh_gltf_primitive_count(data);
+    ano_mesh_chain_t* chains = gltf_alloc((size_t)count * sizeof(ano_mesh_chain_t) + 1u);
+    if (chains == NULL) {
+        cgltf_free(data);
+        return -1;
+    }
+    ano_mesh_gltf_cook_chains(data, config, chains);
+
+    int rc = ano_mesh_file_save(out_path, chains, count, ano_mesh_gltf_source_hash(data), ano_lod_config_hash(config));
+    if (rc != 0)
+        ano_log(ANO_ERROR, "Failed to write cooked mesh file: %s", out_path);
+    for (uint32_t i = 0; i < count; ++i)
+        ano_mesh_chain_free(&chains[i]);
+    gltf_free(chains);
+    cgltf_free(data);
+    return rc;
+}
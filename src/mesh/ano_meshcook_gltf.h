@@ -0,0 +1,88 @@
+/* SPDX-FileCopyrightText: 2026 Anoptic Game Engine Authors
+ *
+ * SPDX-License-Identifier: LGPL-3.0 */
+/*  == Anoptic Game Engine v0.0000001 == */
+
+#ifndef ANO_MESHCOOK_GLTF_H
+#define ANO_MESHCOOK_GLTF_H
+
+/* glTF front end of mesh cooking: primitive extraction, source identity, and whole-file cooks.
+ * Cooked glTF geometry lives beside its source as "<source>.anomesh", one chain per primitive in
+ * mesh-then-primitive order; a primitive without positions or indices gets an empty chain. */
+
+#include <cgltf.h>
+
+#include "mesh/ano_meshcook.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Reads a primitive's positions, normals (default +Y), first texcoord set and indices as the pool's
+ * vertices and u32 triangle-list indices. Tightly typed accessors (float attributes, u8/u16/u32
+ * indices) copy straight out of the buffer; anything else goes through cgltf's unpacking.
+ * Buffers must be loaded. On success *vertices and *indices are owned by the caller
+ * (ano_mesh_gltf_release). False if the primitive lacks positions or indices, an index is out of
+ * range, or an allocation fails.
+ */
+bool ano_mesh_gltf_extract(const cgltf_primitive* prim,
+                           ano_cook_vertex_t** vertices, uint32_t* vertex_count,
+                           uint32_t** indices, uint32_t* index_count);
+
+/**
+ * Frees ano_mesh_gltf_extract's arrays.
+ */
+void ano_mesh_gltf_release(ano_cook_vertex_t* vertices, uint32_t* indices);
+
+/**
+ * Cooks every primitive of data into chains[0..ano_mesh_gltf_primitive_count), mesh-then-primitive
+ * order, with config. Each primitive is extracted and cooked as a job on the pool (anoptic_jobs.h),
+ * its levels fanning out below it, and the call returns once all are done. A primitive that cannot
+ * be extracted gets an empty chain (logged). Release each chain with ano_mesh_chain_free.
+ */
+void ano_mesh_gltf_cook_chains(const cgltf_data* data, const AnoLodConfig* config, ano_mesh_chain_t* chains);
+
+/**
+ * Source identity of a parsed glTF with loaded buffers: its JSON, its GLB binary chunk and every
+ * external buffer, hashed in order.
+ */
+uint64_t ano_mesh_gltf_source_hash(const cgltf_data* data);
+
+/**
+ * Total primitive count over all meshes: the chain count of the glTF's .anomesh.
+ */
+uint32_t ano_mesh_gltf_primitive_count(const cgltf_data* data);
+
+/**
+ * Maps cooked_path and keeps it only if it was cooked from exactly this source with this config.
+ * False (nothing mapped) if missing, malformed or stale.
+ */
+bool ano_mesh_gltf_open_cooked(ano_mesh_file_t* file, const char* cooked_path,
+                               const cgltf_data* data, const AnoLodConfig* config);
+
+/**
+ * Derived-data cache key of the glTF's cooked geometry: ANO_MESH_COOK_VERSION, the same source bytes
+ * ano_mesh_gltf_source_hash covers, and the config's identity (ano_lod_config_hash).
+ */
+ano_fs_cache_key ano_mesh_gltf_cache_key(const cgltf_data* data, const AnoLodConfig* config);
+
+/**
+ * Looks key up in the derived-data cache and views the hit as a .anomesh with one chain per
+ * primitive of data. On success file views into *blob: ano_mesh_file_unmap, then
+ * ano_fs_cache_release, when done. False (nothing held) on a miss or a malformed entry.
+ */
+bool ano_mesh_gltf_open_cached(ano_mesh_file_t* file, ano_fs_cache_blob* blob,
+                               const ano_fs_cache_key* key, const cgltf_data* data);
+
+/**
+ * Parses gltf_path, cooks every primitive with config and writes the chains to out_path.
+ * 0, or -1 (logged) if the source cannot be read or the file cannot be written.
+ */
+int ano_mesh_cook_gltf(const char* gltf_path, const char* out_path, const AnoLodConfig* config);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ANO_MESHCOOK_GLTF_H
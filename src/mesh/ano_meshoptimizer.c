@@ -1,4 +1,5 @@
 #include "ano_meshoptimizer.h"
+#include "anoptic_memory.h"
 #include <string.h>
 #include <math.h>
 #include <float.h>
@@ -8,6 +9,11 @@
 #define K_CACHE_SIZE_MAX 16
 #define K_VALENCE_MAX 8
 
+// Scratch for the optimizer and the simplifier, counted under "mesh" (anoptic_memory.h).
+static ano_mem_tag_t g_meshMem = ANO_MEM_TAG("mesh");
+#define mesh_alloc(size) ano_tmalloc(&g_meshMem, (size))
+#define mesh_free(ptr)   ano_tfree(&g_meshMem, (ptr))
+
 typedef struct {
     float cache[1 + K_CACHE_SIZE_MAX];
     float live[1 + K_VALENCE_MAX];
@@ -108,7 +114,7 @@ void ano_optimize_vertex_cache(uint32_t* destination, const uint32_t* indices, s
 
     // Support in-place optimization
     if (destination == indices) {
-        indices_copy = (uint32_t*)malloc(index_count * sizeof(uint32_t));
+        indices_copy = (uint32_t*)mesh_alloc(index_count * sizeof(uint32_t));
         if (!indices_copy) {
             return;
         }
@@ -128,9 +134,9 @@ void ano_optimize_vertex_cache(uint32_t* destination, const uint32_t* indices, s
     size_t triangle_scores_offset = align_up(vertex_scores_offset + vertex_count * sizeof(float), 16);
     size_t total_memory_size = align_up(triangle_scores_offset + face_count * sizeof(float), 16);
 
-    void* scratch = malloc(total_memory_size);
+    void* scratch = mesh_alloc(total_memory_size);
     if (!scratch) {
-        free(indices_copy);
+        mesh_free(indices_copy);
         return;
     }
 
@@ -269,8 +275,8 @@ void ano_optimize_vertex_cache(uint32_t* destination, const uint32_t* indices, s
     assert(input_cursor == face_count);
     assert(output_triangle == face_count);
 
-    free(scratch);
-    free(indices_copy);
+    mesh_free(scratch);
+    mesh_free(indices_copy);
 }
 
 size_t ano_build_meshlets(ano_meshlet_t* meshlets, uint32_t* meshlet_vertices, uint8_t* meshlet_triangles, 
@@ -533,7 +539,8 @@ ano_meshlet_bounds_gpu_t ano_compute_meshlet_bounds(const uint32_t* meshlet_vert
 // it never invents a vertex position — so every LOD level is the same vertex buffer plus a shorter
 // decimated index buffer. Coincident positions are welded so uv/normal seam-split vertices collapse
 // as one topological point; open boundary vertices are restricted to a polyline so silhouettes do
-// not erode. Geometry-only: attributes are not folded into the quadric (a later refinement).
+// not erode. With attributes, each wedge (source vertex) also carries an attribute quadric, and a
+// collapsing wedge lands on the survivor's wedge nearest it in attribute space.
 // ---------------------------------------------------------------------------
 
 // 11-float symmetric error quadric. error(v) = vT A v + 2 bT v + c, with all terms pre-weighted; w
@@ -549,6 +556,8 @@ typedef struct {
 // A scored, directed collapse: snap vertex v onto vertex t, costing `cost` (normalized squared dist).
 typedef struct { float cost; uint32_t v; uint32_t t; } ano_collapse_t;
 
+#define ANO_NIL 0xFFFFFFFFu
+
 static const float ANO_BORDER_WEIGHT = 10.0f;  // border constraint quadric weight (vs ~unit face area)
 static const size_t ANO_SIMPLIFY_MAX_PASSES = 1000u;
 static const float ANO_SIMPLIFY_AREA_EPS2 = 1e-24f;    // (2*area)^2 drop threshold; matches the |cross|<1e-12
@@ -592,6 +601,47 @@ static inline float ano_quadric_error(const ano_quadric_t* q, const float* p) {
     return q->w > 1e-12f ? r / q->w : r;
 }
 
+// Attribute quadrics (Hoppe's memory-efficient form). Over each face the weighted attributes are fit
+// as a linear field s(p) = g.p + d in the face plane; moving a wedge to p with attributes s costs
+// area * |g.p + d - s|^2 per attribute, summed over the wedge's faces. Per wedge that is a quadric in p
+// (its w the face area) plus, per attribute, area*g and area*d for the terms in s. The sum over a
+// vertex's wedges is normalized by their own area, not by the geometric weight, which border planes
+// inflate: attribute drift costs the same on an open border as inside.
+typedef struct {
+    uint32_t        count;  // attributes per vertex; 0 is geometry-only
+    const float*    attr;   // weighted attributes, count per source vertex
+    ano_quadric_t*  aq;     // per source vertex: the s-free part
+    float*          ag;     // per source vertex, per attribute: area*g.xyz, area*d
+    const uint32_t* wnext;  // next source vertex welded to the same position; ANO_NIL ends
+    uint32_t*       wmap;   // per collapsed source vertex: the wedge it merged into
+} ano_attr_quadrics_t;
+
+// j's wedge nearest wedge o in weighted attribute space; the lowest id on ties.
+static uint32_t ano_attr_match(const ano_attr_quadrics_t* A, uint32_t o, uint32_t j) {
+    if (A->wnext[j] == ANO_NIL) return j;
+    const float* ao = &A->attr[(size_t)o * A->count];
+    uint32_t best = j; float bestd = FLT_MAX;
+    for (uint32_t x = j; x != ANO_NIL; x = A->wnext[x]) {
+        const float* ax = &A->attr[(size_t)x * A->count];
+        float d = 0.0f;
+        for (uint32_t k = 0; k < A->count; ++k) d += (ao[k] - ax[k]) * (ao[k] - ax[k]);
+        if (d < bestd) { bestd = d; best = x; }
+    }
+    return best;
+}
+
+// Folds v's wedges into the j wedges they land on, recording each landing for the output mapping.
+static void ano_attr_merge(const ano_attr_quadrics_t* A, uint32_t v, uint32_t j) {
+    for (uint32_t o = v; o != ANO_NIL; o = A->wnext[o]) {
+        uint32_t x = ano_attr_match(A, o, j);
+        A->wmap[o] = x;
+        ano_quadric_add(&A->aq[x], &A->aq[o]);
+        const float* src = &A->ag[(size_t)o * A->count * 4];
+        float* dst = &A->ag[(size_t)x * A->count * 4];
+        for (uint32_t i = 0; i < A->count * 4; ++i) dst[i] += src[i];
+    }
+}
+
 // Resolve a collapse chain with path halving. collapse[i]==i means i survives.
 static uint32_t ano_resolve(uint32_t* collapse, uint32_t i) {
     while (collapse[i] != i) {
@@ -601,58 +651,29 @@ static uint32_t ano_resolve(uint32_t* collapse, uint32_t i) {
     return i;
 }
 
-// Undirected-edge open-addressing multiset over a fixed pow2 table. Key packs (lo<<32)|hi with
-// lo<hi, so it is never 0 (the empty sentinel). Used per pass to count edge uses: 1 == border,
-// 2 == manifold, >2 == complex (non-manifold).
-static void ano_edge_add(uint64_t* keys, uint32_t* cnt, size_t cap, uint32_t lo, uint32_t hi) {
-    uint64_t key = ((uint64_t)lo << 32) | (uint64_t)hi;
-    size_t mask = cap - 1;
-    size_t h = (size_t)((key * 11400714819323198485ull) >> 32) & mask;
-    for (;;) {
-        if (keys[h] == key) { cnt[h]++; return; }
-        if (keys[h] == 0)   { keys[h] = key; cnt[h] = 1; return; }
-        h = (h + 1) & mask;
+// Stable LSD radix sort of a pass's collapses by cost, a byte per pass, skipping a byte no two costs
+// differ in. Costs are finite and >= 0, so their bit patterns order as the floats do. Stable: equal
+// costs keep candidate (vertex) order, the order the merge-sort qsort this replaced produced. Returns
+// whichever of cand and tmp ends up holding the result.
+static ano_collapse_t* ano_collapse_sort(ano_collapse_t* cand, ano_collapse_t* tmp, size_t n) {
+    uint32_t hist[4][256];
+    memset(hist, 0, sizeof hist);
+    for (size_t i = 0; i < n; ++i) {
+        uint32_t b = ano_float_bits(cand[i].cost);
+        hist[0][b & 0xFFu]++; hist[1][(b >> 8) & 0xFFu]++; hist[2][(b >> 16) & 0xFFu]++; hist[3][b >> 24]++;
     }
-}
-
-static uint32_t ano_edge_get(const uint64_t* keys, const uint32_t* cnt, size_t cap, uint32_t lo, uint32_t hi) {
-    uint64_t key = ((uint64_t)lo << 32) | (uint64_t)hi;
-    size_t mask = cap - 1;
-    size_t h = (size_t)((key * 11400714819323198485ull) >> 32) & mask;
-    for (;;) {
-        uint64_t k = keys[h];
-        if (k == key) return cnt[h];
-        if (k == 0)   return 0;
-        h = (h + 1) & mask;
-    }
-}
-
-// Slot index of an edge KNOWN present (ano_count_edges inserted every working edge). Lets the pass-0
-// feature companion table (first incident face normal) key the same slot as the edge use-count.
-static size_t ano_edge_slot(const uint64_t* keys, size_t cap, uint32_t lo, uint32_t hi) {
-    uint64_t key = ((uint64_t)lo << 32) | (uint64_t)hi;
-    size_t mask = cap - 1;
-    size_t h = (size_t)((key * 11400714819323198485ull) >> 32) & mask;
-    while (keys[h] != key) h = (h + 1) & mask;
-    return h;
-}
-
-static int ano_collapse_cmp(const void* a, const void* b) {
-    float ca = ((const ano_collapse_t*)a)->cost, cb = ((const ano_collapse_t*)b)->cost;
-    return (ca < cb) ? -1 : (ca > cb) ? 1 : 0;
-}
-
-// Rebuild the undirected edge-use multiset for the current triangle list. cnt==1 border,
-// 2 manifold, >2 complex. Cleared then filled; keys/cnt sized to a pow2 >= ~2x unique edges.
-static void ano_count_edges(uint64_t* keys, uint32_t* cnt, size_t cap, const uint32_t* tri, size_t ntri) {
-    memset(keys, 0, cap * sizeof(uint64_t));
-    memset(cnt, 0, cap * sizeof(uint32_t));
-    for (size_t t = 0; t < ntri; ++t) {
-        uint32_t a = tri[t*3+0], b = tri[t*3+1], c = tri[t*3+2];
-        ano_edge_add(keys, cnt, cap, a<b?a:b, a<b?b:a);
-        ano_edge_add(keys, cnt, cap, b<c?b:c, b<c?c:b);
-        ano_edge_add(keys, cnt, cap, a<c?a:c, a<c?c:a);
+    ano_collapse_t* src = cand;
+    ano_collapse_t* dst = tmp;
+    for (uint32_t d = 0; d < 4 && n > 0; ++d) {
+        uint32_t* hd = hist[d];
+        const uint32_t shift = 8u * d;
+        if (hd[(ano_float_bits(src[0].cost) >> shift) & 0xFFu] == n) continue;
+        uint32_t sum = 0;
+        for (uint32_t i = 0; i < 256; ++i) { uint32_t c = hd[i]; hd[i] = sum; sum += c; }
+        for (size_t i = 0; i < n; ++i) dst[hd[(ano_float_bits(src[i].cost) >> shift) & 0xFFu]++] = src[i];
+        ano_collapse_t* swap = src; src = dst; dst = swap;
     }
+    return src;
 }
 
 float ano_simplify_scale(const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride) {
@@ -678,6 +699,505 @@ float ano_simplify_scale(const float* vertex_positions, size_t vertex_count, siz
 #define ANO_VK_BORDER   1u
 #define ANO_VK_LOCKED   2u
 
+// Pass order's edge-use counts: x's incident triangles (from the pass adjacency) on each of its edges,
+// into ucnt[y] under a fresh stamp. Same multiset the per-pass edge table held, without hashing every
+// edge of the mesh; working triangles are never degenerate, so every edge (x, y) is counted once per
+// triangle that holds it.
+static void ano_adj_count_ring(const triangle_adjacency_t* adj, const uint32_t* wtri, uint32_t x,
+                               uint32_t* umark, uint32_t* ucnt, uint32_t* ugen, size_t vertex_count) {
+    if (++*ugen == 0u) { memset(umark, 0, vertex_count * sizeof(uint32_t)); *ugen = 1u; }
+    const uint32_t gen = *ugen;
+    for (uint32_t a = 0; a < adj->counts[x]; ++a) {
+        const uint32_t* tri = &wtri[adj->data[adj->offsets[x] + a] * 3];
+        for (int k = 0; k < 3; ++k) {
+            uint32_t y = tri[k];
+            if (y == x) continue;
+            if (umark[y] != gen) { umark[y] = gen; ucnt[y] = 0u; }
+            ucnt[y]++;
+        }
+    }
+}
+
+#define ANO_SIMPLIFY_ALIGN 16u  // every scratch array's alignment, and the per-array slack the scratch bound budgets
+#define ANO_SIMPLIFY_LANES 16u  // candidate positions scored per quadric batch
+
+// ano_quadric_error of one quadric at n points held as SoA lanes: the per-lane arithmetic is the
+// scalar function's, in a loop the compiler vectorizes.
+static void ano_quadric_error_lanes(const ano_quadric_t* q, const float* xs, const float* ys, const float* zs,
+                                    float* out, uint32_t n) {
+    const float a00 = q->a00, a11 = q->a11, a22 = q->a22, a10 = q->a10, a20 = q->a20, a21 = q->a21;
+    const float b0 = q->b0, b1 = q->b1, b2 = q->b2, c = q->c;
+    const int weighted = q->w > 1e-12f;
+    const float w = weighted ? q->w : 1.0f;
+    for (uint32_t i = 0; i < n; ++i) {
+        float x = xs[i], y = ys[i], z = zs[i];
+        float r = a00*x*x + a11*y*y + a22*z*z
+                + 2.0f*(a10*x*y + a20*x*z + a21*y*z)
+                + 2.0f*(b0*x + b1*y + b2*z)
+                + c;
+        out[i] = fabsf(r) / w;
+    }
+}
+
+// Attribute error of snapping canonical v onto each lane's canonical target ids[i] at the lane's
+// position: each of v's wedges against the wedge of the target it would land on, as an area-weighted
+// mean squared attribute difference (>= 0), added to out. A wedge is matched once per lane, its
+// landing attributes transposed into lanes, and both its quadric and attribute terms then run across
+// the lanes like ano_quadric_error_lanes.
+static void ano_attr_error_lanes(const ano_attr_quadrics_t* A, uint32_t v, const uint32_t* ids, const float* xs,
+                                 const float* ys, const float* zs, float* out, uint32_t n) {
+    _Alignas(ANO_SIMPLIFY_ALIGN) float r[ANO_SIMPLIFY_LANES] = { 0 };
+    _Alignas(ANO_SIMPLIFY_ALIGN) float sl[ANO_SIMPLIFY_LANES];
+    const float* s[ANO_SIMPLIFY_LANES];
+    float area = 0.0f;
+    for (uint32_t o = v; o != ANO_NIL; o = A->wnext[o]) {
+        const ano_quadric_t* q = &A->aq[o];
+        const float a00 = q->a00, a11 = q->a11, a22 = q->a22, a10 = q->a10, a20 = q->a20, a21 = q->a21;
+        const float b0 = q->b0, b1 = q->b1, b2 = q->b2, c = q->c, w = q->w;
+        for (uint32_t i = 0; i < n; ++i) {
+            float x = xs[i], y = ys[i], z = zs[i];
+            r[i] += a00*x*x + a11*y*y + a22*z*z
+                  + 2.0f*(a10*x*y + a20*x*z + a21*y*z)
+                  + 2.0f*(b0*x + b1*y + b2*z)
+                  + c;
+        }
+        for (uint32_t i = 0; i < n; ++i) s[i] = &A->attr[(size_t)ano_attr_match(A, o, ids[i]) * A->count];
+        const float* g = &A->ag[(size_t)o * A->count * 4];
+        for (uint32_t k = 0; k < A->count; ++k, g += 4) {
+            const float gx = g[0], gy = g[1], gz = g[2], gd = g[3];
+            for (uint32_t i = 0; i < n; ++i) sl[i] = s[i][k];
+            for (uint32_t i = 0; i < n; ++i)
+                r[i] += w*sl[i]*sl[i] - 2.0f*sl[i]*(gx*xs[i] + gy*ys[i] + gz*zs[i] + gd);
+        }
+        area += w;
+    }
+    for (uint32_t i = 0; i < n; ++i) {
+        float e = fabsf(r[i]);
+        out[i] += area > 1e-12f ? e / area : e;
+    }
+}
+
+// Collapse costs of canonical v onto each lane's target: ano_quadric_error_lanes, plus the attribute
+// error when the call has attributes.
+static inline void ano_collapse_error_lanes(const ano_quadric_t* q, const ano_attr_quadrics_t* A, uint32_t v,
+                                            const uint32_t* ids, const float* xs, const float* ys, const float* zs,
+                                            float* out, uint32_t n) {
+    ano_quadric_error_lanes(q, xs, ys, zs, out, n);
+    if (A->count) ano_attr_error_lanes(A, v, ids, xs, ys, zs, out, n);
+}
+
+// ---------------------------------------------------------------------------
+// Heap order: one collapse at a time, cheapest first, from a priority queue that each collapse updates
+// locally. The guards are the pass order's, each evaluated against the mesh as it is at that collapse,
+// so Guard 6's per-pass locking has nothing left to do. Triangles keep their working slot for life (dead
+// ones are flagged), and every triangle corner is a node on its vertex's list; a collapse renames v's
+// corners to j and splices v's list onto j's, O(1).
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    float    key;  // cost of the vertex's queued collapse
+    uint32_t v;
+} ano_heap_entry_t;
+
+typedef struct {
+    size_t         vertex_count;
+    size_t         tris;         // live working triangles
+    size_t         target_tris;
+    const float*   npos;
+    uint32_t*      collapse;
+    ano_quadric_t* Q;
+    const ano_attr_quadrics_t* attr;
+    const uint8_t* feature;
+    uint8_t*       kind;
+    uint32_t*      wtri;
+    const float*   orig_n;       // NULL with the guards off
+    uint32_t*      linkNbr;
+    uint32_t       linkGen;
+    float          err_limit;
+    float          maxEdge2;
+    float          result_err2;
+    uint8_t*       alive;        // per working triangle
+    uint32_t*      cnext;        // per corner: next corner on the same vertex's list
+    uint32_t*      chead;        // per vertex: its corner list
+    uint32_t*      ctail;
+    ano_heap_entry_t* heap;      // binary min-heap of vertices by (key, id)
+    uint32_t*      hpos;         // heap slot of a vertex, ANO_NIL when out
+    uint32_t       hcount;
+    uint32_t*      hnb;          // its target
+    float*         skipCost;     // candidates at or before (skipCost, skipNb) were refused by a guard
+    uint32_t*      skipNb;
+    uint32_t*      stamp;        // affected-set membership, generation-stamped like linkNbr
+    uint32_t       stampGen;
+    uint32_t*      umark;        // ring-count stamp: ucnt[y] is current when umark[y] == ugen
+    uint32_t*      ucnt;         // live triangles on edge (x, y) for the vertex x last counted
+    uint32_t       ugen;
+    uint32_t*      touched;
+    uint32_t       ntouched;
+    uint8_t*       tfull;        // per touched vertex: needs a full rescore, not just the new target
+} ano_heap_simplify_t;
+
+#define ANO_FOR_CORNERS(h, x, c, t) \
+    for (uint32_t c = (h)->chead[x], t = c / 3u; c != ANO_NIL; c = (h)->cnext[c], t = c / 3u) \
+        if ((h)->alive[t])
+
+static inline int ano_heap_less(ano_heap_entry_t a, ano_heap_entry_t b) {
+    return a.key < b.key || (a.key == b.key && a.v < b.v);
+}
+
+static inline void ano_heap_place(ano_heap_simplify_t* h, uint32_t i, ano_heap_entry_t e) {
+    h->heap[i] = e; h->hpos[e.v] = i;
+}
+
+static void ano_heap_up(ano_heap_simplify_t* h, uint32_t i) {
+    ano_heap_entry_t e = h->heap[i];
+    while (i > 0) {
+        uint32_t p = (i - 1) / 2;
+        if (!ano_heap_less(e, h->heap[p])) break;
+        ano_heap_place(h, i, h->heap[p]);
+        i = p;
+    }
+    ano_heap_place(h, i, e);
+}
+
+static void ano_heap_down(ano_heap_simplify_t* h, uint32_t i) {
+    ano_heap_entry_t e = h->heap[i];
+    for (;;) {
+        uint32_t l = 2 * i + 1;
+        if (l >= h->hcount) break;
+        uint32_t m = (l + 1 < h->hcount && ano_heap_less(h->heap[l + 1], h->heap[l])) ? l + 1 : l;
+        if (!ano_heap_less(h->heap[m], e)) break;
+        ano_heap_place(h, i, h->heap[m]);
+        i = m;
+    }
+    ano_heap_place(h, i, e);
+}
+
+static void ano_heap_set(ano_heap_simplify_t* h, uint32_t v, float key) {
+    ano_heap_entry_t e = { key, v };
+    uint32_t i = h->hpos[v];
+    if (i == ANO_NIL) { ano_heap_place(h, h->hcount, e); ano_heap_up(h, h->hcount++); return; }
+    float old = h->heap[i].key;
+    h->heap[i].key = key;
+    if (key < old) ano_heap_up(h, i);
+    else ano_heap_down(h, i);
+}
+
+static void ano_heap_remove(ano_heap_simplify_t* h, uint32_t v) {
+    uint32_t i = h->hpos[v];
+    if (i == ANO_NIL) return;
+    h->hpos[v] = ANO_NIL;
+    ano_heap_entry_t last = h->heap[--h->hcount];
+    if (last.v == v) return;
+    ano_heap_place(h, i, last);
+    ano_heap_up(h, i);
+    ano_heap_down(h, h->hpos[last.v]);
+}
+
+// Counts x's live triangles on each of its edges into ucnt (1 border, 2 manifold, >2 complex) and
+// returns the stamp that marks them current.
+static uint32_t ano_heap_count_ring(ano_heap_simplify_t* h, uint32_t x) {
+    if (++h->ugen == 0u) { memset(h->umark, 0, h->vertex_count * sizeof(uint32_t)); h->ugen = 1u; }
+    const uint32_t gen = h->ugen;
+    ANO_FOR_CORNERS(h, x, c, t) {
+        for (int k = 0; k < 3; ++k) {
+            uint32_t y = h->wtri[t*3+k];
+            if (y == x) continue;
+            if (h->umark[y] != gen) { h->umark[y] = gen; h->ucnt[y] = 0u; }
+            h->ucnt[y]++;
+        }
+    }
+    return gen;
+}
+
+// The pass order's per-vertex classification, from x's live triangles alone.
+static uint8_t ano_heap_kind(ano_heap_simplify_t* h, uint32_t x) {
+    if (h->chead[x] == ANO_NIL) return ANO_VK_LOCKED;
+    ano_heap_count_ring(h, x);
+    int any = 0, border = 0;
+    ANO_FOR_CORNERS(h, x, c, t) {
+        any = 1;
+        for (int k = 0; k < 3; ++k) {
+            uint32_t y = h->wtri[t*3+k];
+            if (y == x) continue;
+            if (h->ucnt[y] > 2u) return ANO_VK_LOCKED;
+            if (h->ucnt[y] == 1u) border = 1;
+        }
+    }
+    return !any ? ANO_VK_LOCKED : border ? ANO_VK_BORDER : ANO_VK_MANIFOLD;
+}
+
+// Scores one batch of lanes (collapses of v) and keeps the least (cost, id) ordered after (sc, sn).
+static void ano_heap_pick(const ano_heap_simplify_t* h, uint32_t v, const float* xs, const float* ys,
+                          const float* zs, const uint32_t* ids, uint32_t n, float sc, uint32_t sn, float* best,
+                          uint32_t* bestnb) {
+    _Alignas(ANO_SIMPLIFY_ALIGN) float cost[ANO_SIMPLIFY_LANES];
+    ano_collapse_error_lanes(&h->Q[v], h->attr, v, ids, xs, ys, zs, cost, n);
+    for (uint32_t i = 0; i < n; ++i) {
+        float e = cost[i];
+        if ((e > sc || (e == sc && ids[i] > sn)) && (e < *best || (e == *best && ids[i] < *bestnb))) {
+            *best = e; *bestnb = ids[i];
+        }
+    }
+}
+
+// v's cheapest collapse ordered after (skipCost, skipNb), under the pass order's candidate filters.
+// Each neighbor is visited once; targets are gathered into lanes and scored against Q[v] a batch at a
+// time. False when none is left.
+static int ano_heap_candidate(ano_heap_simplify_t* h, uint32_t v, float* out_cost, uint32_t* out_nb) {
+    if (h->kind[v] == ANO_VK_LOCKED) return 0;
+    const uint32_t gen = ano_heap_count_ring(h, v);
+    _Alignas(ANO_SIMPLIFY_ALIGN) float xs[ANO_SIMPLIFY_LANES], ys[ANO_SIMPLIFY_LANES], zs[ANO_SIMPLIFY_LANES];
+    uint32_t ids[ANO_SIMPLIFY_LANES];
+    uint32_t n = 0;
+    const float sc = h->skipCost[v];
+    const uint32_t sn = h->skipNb[v];
+    const float* pv = &h->npos[v*3];
+    float best = FLT_MAX; uint32_t bestnb = ANO_NIL;
+    ANO_FOR_CORNERS(h, v, c, t) {
+        for (int k = 0; k < 3; ++k) {
+            uint32_t nb = h->wtri[t*3+k];
+            if (nb == v || h->umark[nb] != gen) continue;
+            h->umark[nb] = 0u;  // visited (0 is never a live stamp)
+            if (h->kind[v] == ANO_VK_BORDER) {
+                if (h->kind[nb] != ANO_VK_BORDER) continue;
+                if (h->ucnt[nb] != 1u) continue;
+            } else {
+                if (h->kind[nb] == ANO_VK_LOCKED) continue;
+                if (h->feature[v] && !h->feature[nb]) continue;
+            }
+            const float* pn = &h->npos[nb*3];
+            float dv[3] = { pn[0]-pv[0], pn[1]-pv[1], pn[2]-pv[2] };
+            if (dot_product(dv, dv) > h->maxEdge2) continue;
+            xs[n] = pn[0]; ys[n] = pn[1]; zs[n] = pn[2]; ids[n] = nb;
+            if (++n < ANO_SIMPLIFY_LANES) continue;
+            ano_heap_pick(h, v, xs, ys, zs, ids, n, sc, sn, &best, &bestnb);
+            n = 0;
+        }
+    }
+    if (n > 0) ano_heap_pick(h, v, xs, ys, zs, ids, n, sc, sn, &best, &bestnb);
+    if (bestnb == ANO_NIL) return 0;
+    *out_cost = best; *out_nb = bestnb;
+    return 1;
+}
+
+// Requeue v from its first candidate, or drop it when it has none.
+static void ano_heap_refresh(ano_heap_simplify_t* h, uint32_t v) {
+    h->skipCost[v] = -1.0f; h->skipNb[v] = 0u;
+    float cost; uint32_t nb;
+    if (ano_heap_candidate(h, v, &cost, &nb)) { h->hnb[v] = nb; ano_heap_set(h, v, cost); }
+    else ano_heap_remove(h, v);
+}
+
+// The pass order's link condition, tetra exclusion, flip, drift, fold and growth guards for v -> j,
+// against the current mesh.
+static int ano_heap_collapse_ok(ano_heap_simplify_t* h, uint32_t v, uint32_t j) {
+    const uint32_t* wtri = h->wtri;
+    const float* npos = h->npos;
+    if (h->maxEdge2 != FLT_MAX) {
+        if (++h->linkGen == 0u) { memset(h->linkNbr, 0, h->vertex_count * sizeof(uint32_t)); h->linkGen = 1u; }
+        uint32_t gen = h->linkGen;
+        uint32_t apex[2] = {0u, 0u}; uint32_t napex = 0;
+        ANO_FOR_CORNERS(h, j, cj, t) {
+            uint32_t c0 = wtri[t*3+0], c1 = wtri[t*3+1], c2 = wtri[t*3+2];
+            h->linkNbr[c0] = gen; h->linkNbr[c1] = gen; h->linkNbr[c2] = gen;
+            if (c0 == v || c1 == v || c2 == v) {
+                uint32_t w = (c0 != v && c0 != j) ? c0 : (c1 != v && c1 != j) ? c1 : c2;
+                if (napex < 2) apex[napex] = w;
+                napex++;
+            }
+        }
+        ANO_FOR_CORNERS(h, v, cv, t) {
+            for (int k = 0; k < 3; ++k) {
+                uint32_t w = wtri[t*3+k];
+                if (w == v || w == j || h->linkNbr[w] != gen) continue;
+                if (!(napex > 0 && w == apex[0]) && !(napex > 1 && w == apex[1])) return 0;
+            }
+        }
+        if (napex == 2) {
+            uint32_t a0 = apex[0], a1 = apex[1]; int vf = 0, jf = 0;
+            ANO_FOR_CORNERS(h, v, cv, t) {
+                const uint32_t* c = &wtri[t*3];
+                if ((c[0]==a0||c[1]==a0||c[2]==a0) && (c[0]==a1||c[1]==a1||c[2]==a1)) { vf = 1; break; }
+            }
+            if (vf) {
+                ANO_FOR_CORNERS(h, j, cj, t) {
+                    const uint32_t* c = &wtri[t*3];
+                    if ((c[0]==a0||c[1]==a0||c[2]==a0) && (c[0]==a1||c[1]==a1||c[2]==a1)) { jf = 1; break; }
+                }
+            }
+            if (vf && jf) return 0;
+        }
+    }
+
+    ANO_FOR_CORNERS(h, v, cv, t) {
+        uint32_t c0 = wtri[t*3+0], c1 = wtri[t*3+1], c2 = wtri[t*3+2];
+        if (c0 == j || c1 == j || c2 == j) continue;
+        float o0[3], o1[3], o2[3];
+        o0[0]=npos[c0*3]; o0[1]=npos[c0*3+1]; o0[2]=npos[c0*3+2];
+        o1[0]=npos[c1*3]; o1[1]=npos[c1*3+1]; o1[2]=npos[c1*3+2];
+        o2[0]=npos[c2*3]; o2[1]=npos[c2*3+1]; o2[2]=npos[c2*3+2];
+        float* mv = (c0==v) ? o0 : (c1==v) ? o1 : o2;
+        float oe1[3] = { o1[0]-o0[0], o1[1]-o0[1], o1[2]-o0[2] };
+        float oe2[3] = { o2[0]-o0[0], o2[1]-o0[1], o2[2]-o0[2] };
+        float on[3]; cross_product(oe1, oe2, on);
+        mv[0]=npos[j*3]; mv[1]=npos[j*3+1]; mv[2]=npos[j*3+2];
+        float ne1[3] = { o1[0]-o0[0], o1[1]-o0[1], o1[2]-o0[2] };
+        float ne2[3] = { o2[0]-o0[0], o2[1]-o0[1], o2[2]-o0[2] };
+        float nn[3]; cross_product(ne1, ne2, nn);
+        float nlen2 = dot_product(nn, nn);
+        if (nlen2 < 1e-20f) return 0;
+        if (h->maxEdge2 == FLT_MAX) {
+            if (dot_product(on, nn) < 0.0f) return 0;
+            continue;
+        }
+        const float* onr = &h->orig_n[t*3];
+        float dnd = onr[0]*nn[0] + onr[1]*nn[1] + onr[2]*nn[2];
+        if (dnd < 0.0f || dnd*dnd < ANO_SIMPLIFY_MAX_NORMAL_DRIFT_COS * ANO_SIMPLIFY_MAX_NORMAL_DRIFT_COS * nlen2)
+            return 0;
+        float olen2 = dot_product(on, on);
+        if (dot_product(on, nn) <= 0.25f * sqrtf(olen2 * nlen2)) return 0;
+        float ne3[3] = { o2[0]-o1[0], o2[1]-o1[1], o2[2]-o1[2] };
+        if (dot_product(ne1, ne1) > h->maxEdge2 || dot_product(ne2, ne2) > h->maxEdge2 ||
+            dot_product(ne3, ne3) > h->maxEdge2) return 0;
+    }
+    return 1;
+}
+
+static inline void ano_heap_touch(ano_heap_simplify_t* h, uint32_t x, uint8_t full) {
+    if (h->stamp[x] == h->stampGen) { h->tfull[x] |= full; return; }
+    h->stamp[x] = h->stampGen;
+    h->tfull[x] = full;
+    h->touched[h->ntouched++] = x;
+}
+
+// x's one new neighbor is j and nothing else about its candidates changed: score j alone against the
+// queued collapse. Manifold x only (a border x's filter needs the edge's use count).
+static void ano_heap_offer(ano_heap_simplify_t* h, uint32_t x, uint32_t j) {
+    if (h->kind[j] == ANO_VK_LOCKED || (h->feature[x] && !h->feature[j])) return;
+    const float* px = &h->npos[x*3];
+    const float* pj = &h->npos[j*3];
+    float dv[3] = { pj[0]-px[0], pj[1]-px[1], pj[2]-px[2] };
+    if (dot_product(dv, dv) > h->maxEdge2) return;
+    const int queued = h->hpos[x] != ANO_NIL;
+    float best = queued ? h->heap[h->hpos[x]].key : FLT_MAX;
+    uint32_t bestnb = queued ? h->hnb[x] : ANO_NIL;
+    ano_heap_pick(h, x, &pj[0], &pj[1], &pj[2], &j, 1u, h->skipCost[x], h->skipNb[x], &best, &bestnb);
+    if (bestnb == j) { h->hnb[x] = j; ano_heap_set(h, x, best); }
+}
+
+// Unlinks x's dead corners so its list stays as long as its live ring.
+static void ano_heap_prune(ano_heap_simplify_t* h, uint32_t x) {
+    uint32_t prev = ANO_NIL;
+    for (uint32_t c = h->chead[x]; c != ANO_NIL; c = h->cnext[c]) {
+        if (h->alive[c / 3u]) { prev = c; continue; }
+        if (prev == ANO_NIL) h->chead[x] = h->cnext[c];
+        else h->cnext[prev] = h->cnext[c];
+    }
+    h->ctail[x] = prev;
+}
+
+// Snap v onto j: kill the triangles on edge (v, j), rename v's other corners, hand v's list to j, then
+// reclassify and requeue the vertices whose edges changed. Positions never move, so a vertex keeps its
+// costs unless its quadric (j) or its candidate set changed. A neighbor of v that was not j's neighbor
+// just trades v for j, which keeps its edge counts and so its kind; unless v was its queued target it
+// only needs j scored. j, the common ring, and the neighbors of any vertex whose kind changed are
+// rescored in full.
+static void ano_heap_apply(ano_heap_simplify_t* h, uint32_t v, uint32_t j, float cost) {
+    h->collapse[v] = j;
+    ano_quadric_add(&h->Q[j], &h->Q[v]);
+    if (h->attr->count) ano_attr_merge(h->attr, v, j);
+    if (cost > h->result_err2) h->result_err2 = cost;
+    ano_heap_remove(h, v);
+
+    if (++h->stampGen == 0u) { memset(h->stamp, 0, h->vertex_count * sizeof(uint32_t)); h->stampGen = 1u; }
+    h->ntouched = 0;
+    const uint32_t jring = ano_heap_count_ring(h, j);  // umark[x] == jring: x was j's neighbor
+    ano_heap_touch(h, j, 1u);
+    uint32_t apex[2]; uint32_t napex = 0;
+    ANO_FOR_CORNERS(h, v, c, t) {
+        uint32_t* tri = &h->wtri[t*3];
+        for (int k = 0; k < 3; ++k) {
+            uint32_t x = tri[k];
+            if (x != v) ano_heap_touch(h, x, h->umark[x] == jring || (h->hpos[x] != ANO_NIL && h->hnb[x] == v));
+        }
+        if (tri[0] == j || tri[1] == j || tri[2] == j) {
+            h->alive[t] = 0;
+            h->tris--;
+            if (napex < 2)
+                apex[napex++] = (tri[0] != v && tri[0] != j) ? tri[0] : (tri[1] != v && tri[1] != j) ? tri[1] : tri[2];
+        } else {
+            h->wtri[c] = j;
+        }
+    }
+    if (h->chead[v] != ANO_NIL) {
+        if (h->chead[j] == ANO_NIL) h->chead[j] = h->chead[v];
+        else h->cnext[h->ctail[j]] = h->chead[v];
+        h->ctail[j] = h->ctail[v];
+        h->chead[v] = h->ctail[v] = ANO_NIL;
+    }
+    h->kind[v] = ANO_VK_LOCKED;
+    ano_heap_prune(h, j);
+    for (uint32_t i = 0; i < napex; ++i) ano_heap_prune(h, apex[i]);
+
+    // Where a kind changed, the neighbors' candidate filters read it, so they rescore too.
+    uint32_t ring = h->ntouched;
+    for (uint32_t i = 0; i < ring; ++i) {
+        uint32_t x = h->touched[i];
+        if (!h->tfull[x]) continue;
+        uint8_t k = ano_heap_kind(h, x);
+        if (k == h->kind[x]) continue;
+        h->kind[x] = k;
+        ANO_FOR_CORNERS(h, x, c, t) {
+            ano_heap_touch(h, h->wtri[t*3+0], 1u); ano_heap_touch(h, h->wtri[t*3+1], 1u);
+            ano_heap_touch(h, h->wtri[t*3+2], 1u);
+        }
+    }
+    for (uint32_t i = 0; i < h->ntouched; ++i) {
+        uint32_t x = h->touched[i];
+        if (h->tfull[x] || h->kind[x] == ANO_VK_BORDER) ano_heap_refresh(h, x);
+        else if (h->kind[x] == ANO_VK_MANIFOLD) ano_heap_offer(h, x, j);
+    }
+}
+
+// Collapse cheapest-first until the count or the error budget is met. A vertex whose queued collapse
+// a guard refuses requeues at its next candidate, and waits for a neighbor's collapse when it has none.
+static void ano_heap_run(ano_heap_simplify_t* h) {
+    for (uint32_t c = 0; c < (uint32_t)(h->tris * 3); ++c) {
+        uint32_t v = h->wtri[c];
+        h->cnext[c] = ANO_NIL;
+        if (h->chead[v] == ANO_NIL) h->chead[v] = c;
+        else h->cnext[h->ctail[v]] = c;
+        h->ctail[v] = c;
+    }
+    for (uint32_t v = 0; v < (uint32_t)h->vertex_count; ++v)
+        h->kind[v] = ano_heap_kind(h, v);
+    for (uint32_t v = 0; v < (uint32_t)h->vertex_count; ++v) {
+        h->skipCost[v] = -1.0f; h->skipNb[v] = 0u;
+        float cost; uint32_t nb;
+        if (ano_heap_candidate(h, v, &cost, &nb)) {
+            h->hnb[v] = nb;
+            ano_heap_place(h, h->hcount++, (ano_heap_entry_t){ cost, v });
+        }
+    }
+    for (uint32_t i = h->hcount / 2; i-- > 0;)
+        ano_heap_down(h, i);
+
+    while (h->tris > h->target_tris && h->hcount > 0) {
+        uint32_t v = h->heap[0].v;
+        float cost = h->heap[0].key;
+        uint32_t j = h->hnb[v];
+        if (cost > h->err_limit) break;  // heap order: nothing cheaper remains
+        if (ano_heap_collapse_ok(h, v, j)) {
+            ano_heap_apply(h, v, j, cost);
+            continue;
+        }
+        h->skipCost[v] = cost; h->skipNb[v] = j;
+        uint32_t nb;
+        if (ano_heap_candidate(h, v, &cost, &nb)) { h->hnb[v] = nb; ano_heap_set(h, v, cost); }
+        else ano_heap_remove(h, v);
+    }
+}
+
 // Guard-disabled baseline: identical behavior to the original simplifier (edge_len_factor <= 0). Kept
 // so the tests and the A/B-comparison path exercise the exact pre-guard collapse decisions.
 size_t ano_simplify(uint32_t* destination, const uint32_t* indices, size_t index_count,
@@ -692,7 +1212,70 @@ size_t ano_simplify_ex(uint32_t* destination, const uint32_t* indices, size_t in
                        const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride,
                        size_t target_index_count, float target_error, float edge_len_factor,
                        float* out_result_error) {
+    return ano_simplify_arena(destination, indices, index_count, vertex_positions, vertex_count,
+                              vertex_positions_stride, target_index_count, target_error, edge_len_factor,
+                              ANO_SIMPLIFY_DETERMINISTIC, NULL, out_result_error);
+}
+
+#define ANO_SIMPLIFY_SLOT(bytes) ((bytes) + ANO_SIMPLIFY_ALIGN)  // one array plus its worst alignment pad
+
+size_t ano_simplify_scratch_size(size_t index_count, size_t vertex_count, size_t attribute_count, uint32_t flags) {
+    size_t t = index_count / 3, ic = t * 3, v = vertex_count, m = attribute_count;
+    size_t weldCap = ano_ceil_pow2(v * 2 + 16);
+    // npos; remap, collapse, outid, umark, ucnt, linkNbr; Q; kind, feature; wtri; orig_n
+    size_t common = ANO_SIMPLIFY_SLOT(v * 3 * sizeof(float)) + 6 * ANO_SIMPLIFY_SLOT(v * sizeof(uint32_t))
+                  + ANO_SIMPLIFY_SLOT(v * sizeof(ano_quadric_t)) + 2 * ANO_SIMPLIFY_SLOT(v)
+                  + ANO_SIMPLIFY_SLOT(ic * sizeof(uint32_t)) + ANO_SIMPLIFY_SLOT(t * 3 * sizeof(float));
+    // Temporaries, rewound before the collapses: the weld table, then the pass-0 topology (adjacency
+    // counts, offsets, data; border masks; first faces).
+    size_t weld = ANO_SIMPLIFY_SLOT(weldCap * sizeof(int32_t));
+    size_t topo = 3 * ANO_SIMPLIFY_SLOT(v * sizeof(uint32_t)) + ANO_SIMPLIFY_SLOT(ic * sizeof(uint32_t))
+                + ANO_SIMPLIFY_SLOT(t);
+    size_t mode;
+    if (flags & ANO_SIMPLIFY_DETERMINISTIC) {
+        // locked; adjCounts, adjOff; adjData, wtmp; cand, candTmp; orig_n_tmp
+        mode = ANO_SIMPLIFY_SLOT(v) + 2 * ANO_SIMPLIFY_SLOT(v * sizeof(uint32_t))
+             + 2 * ANO_SIMPLIFY_SLOT(ic * sizeof(uint32_t)) + 2 * ANO_SIMPLIFY_SLOT(v * sizeof(ano_collapse_t))
+             + ANO_SIMPLIFY_SLOT(t * 3 * sizeof(float));
+    } else {
+        // heap; chead, ctail, hpos, hnb, skipNb, stamp, touched, skipCost; tfull; cnext; alive
+        mode = ANO_SIMPLIFY_SLOT(v * sizeof(ano_heap_entry_t)) + 8 * ANO_SIMPLIFY_SLOT(v * sizeof(uint32_t))
+             + ANO_SIMPLIFY_SLOT(v) + ANO_SIMPLIFY_SLOT(ic * sizeof(uint32_t)) + ANO_SIMPLIFY_SLOT(t);
+    }
+    mode += weld > topo ? weld : topo;
+    // attr; aq; ag; wnext, wmap
+    if (m > 0) {
+        mode += ANO_SIMPLIFY_SLOT(v * m * sizeof(float)) + ANO_SIMPLIFY_SLOT(v * sizeof(ano_quadric_t))
+              + ANO_SIMPLIFY_SLOT(v * m * 4 * sizeof(float)) + 2 * ANO_SIMPLIFY_SLOT(v * sizeof(uint32_t));
+    }
+    return common + mode;
+}
+
+static size_t ano_simplify_in(ano_arena_t* arena, uint32_t* destination, const uint32_t* indices, size_t tri0,
+                              const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride,
+                              const float* vertex_attributes, size_t vertex_attributes_stride,
+                              const float* attribute_weights, size_t attribute_count,
+                              size_t target_ic, float target_error, float edge_len_factor, uint32_t flags,
+                              float* out_result_error);
+
+size_t ano_simplify_arena(uint32_t* destination, const uint32_t* indices, size_t index_count,
+                          const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride,
+                          size_t target_index_count, float target_error, float edge_len_factor,
+                          uint32_t flags, struct ano_arena_t* scratch, float* out_result_error) {
+    return ano_simplify_with_attributes(destination, indices, index_count, vertex_positions, vertex_count,
+                                        vertex_positions_stride, NULL, 0, NULL, 0, target_index_count,
+                                        target_error, edge_len_factor, flags, scratch, out_result_error);
+}
+
+size_t ano_simplify_with_attributes(uint32_t* destination, const uint32_t* indices, size_t index_count,
+                                    const float* vertex_positions, size_t vertex_count,
+                                    size_t vertex_positions_stride, const float* vertex_attributes,
+                                    size_t vertex_attributes_stride, const float* attribute_weights,
+                                    size_t attribute_count, size_t target_index_count, float target_error,
+                                    float edge_len_factor, uint32_t flags, struct ano_arena_t* scratch,
+                                    float* out_result_error) {
     if (out_result_error) *out_result_error = 0.0f;
+    if (!vertex_attributes || !attribute_weights) attribute_count = 0;
 
     size_t tri0 = index_count / 3;
     size_t ic = tri0 * 3;  // floored to whole triangles
@@ -719,50 +1302,120 @@ size_t ano_simplify_ex(uint32_t* destination, const uint32_t* indices, size_t in
         return outc;
     }
 
+    // Scratch: the caller's arena, rewound on return; when it is absent or too small, a private one
+    // reserved to the bound. Neither allocates anywhere else. If no scratch can be had, the input
+    // passes through unchanged.
+    size_t outcount = SIZE_MAX;
+    if (scratch) {
+        size_t mark = ano_arena_mark(scratch);
+        outcount = ano_simplify_in(scratch, destination, indices, tri0, vertex_positions, vertex_count,
+                                   vertex_positions_stride, vertex_attributes, vertex_attributes_stride,
+                                   attribute_weights, attribute_count, target_ic, target_error, edge_len_factor,
+                                   flags, out_result_error);
+        ano_arena_rewind(scratch, mark);
+    }
+    if (outcount == SIZE_MAX) {
+        ano_arena_t own;
+        if (ano_arena_init(&own, ano_simplify_scratch_size(ic, vertex_count, attribute_count, flags)) == 0) {
+            outcount = ano_simplify_in(&own, destination, indices, tri0, vertex_positions, vertex_count,
+                                       vertex_positions_stride, vertex_attributes, vertex_attributes_stride,
+                                       attribute_weights, attribute_count, target_ic, target_error,
+                                       edge_len_factor, flags, out_result_error);
+            ano_arena_destroy(&own);
+        }
+    }
+    if (outcount == SIZE_MAX) {
+        if (destination != indices) memcpy(destination, indices, ic * sizeof(uint32_t));
+        return ic;
+    }
+    return outcount;
+}
+
+// ano_simplify_with_attributes past its early outs, all scratch from arena. SIZE_MAX when the arena
+// runs out, before anything is written to destination.
+static size_t ano_simplify_in(ano_arena_t* arena, uint32_t* destination, const uint32_t* indices, size_t tri0,
+                              const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride,
+                              const float* vertex_attributes, size_t vertex_attributes_stride,
+                              const float* attribute_weights, size_t attribute_count,
+                              size_t target_ic, float target_error, float edge_len_factor, uint32_t flags,
+                              float* out_result_error) {
+    const int heapOrder = !(flags & ANO_SIMPLIFY_DETERMINISTIC);
     float extent = ano_simplify_scale(vertex_positions, vertex_count, vertex_positions_stride);
     float invscale = extent > 0.0f ? 1.0f / extent : 1.0f;
 
-    // Single allocation sweep; on any failure, pass the input through unchanged.
-    float* npos          = (float*)malloc(vertex_count * 3 * sizeof(float));
-    uint32_t* remap      = (uint32_t*)malloc(vertex_count * sizeof(uint32_t));
-    uint32_t* collapse   = (uint32_t*)malloc(vertex_count * sizeof(uint32_t));
-    ano_quadric_t* Q     = (ano_quadric_t*)malloc(vertex_count * sizeof(ano_quadric_t));
-    uint8_t* kind        = (uint8_t*)malloc(vertex_count);
-    uint8_t* locked      = (uint8_t*)malloc(vertex_count);
-    uint32_t* outid      = (uint32_t*)malloc(vertex_count * sizeof(uint32_t));
-    uint32_t* adjCounts  = (uint32_t*)malloc(vertex_count * sizeof(uint32_t));
-    uint32_t* adjOff     = (uint32_t*)malloc(vertex_count * sizeof(uint32_t));
-    uint32_t* adjData    = (uint32_t*)malloc(ic * sizeof(uint32_t));
-    uint32_t* wtri       = (uint32_t*)malloc(ic * sizeof(uint32_t));
-    uint32_t* wtmp       = (uint32_t*)malloc(ic * sizeof(uint32_t));
-    ano_collapse_t* cand = (ano_collapse_t*)malloc(vertex_count * sizeof(ano_collapse_t));
+    // Scratch carve-up: what lives the whole call first, then what the chosen order needs, then the
+    // weld and edge tables, which are rewound once the quadrics and features are built.
+#define SCRATCH(T, n) ((T*)ano_arena_alloc(arena, (size_t)(n) * sizeof(T) + 1u, ANO_SIMPLIFY_ALIGN))
+    size_t ic = tri0 * 3;
+    int guards = edge_len_factor > 0.0f;
+    float* npos          = SCRATCH(float, vertex_count * 3);
+    uint32_t* remap      = SCRATCH(uint32_t, vertex_count);
+    uint32_t* collapse   = SCRATCH(uint32_t, vertex_count);
+    uint32_t* outid      = SCRATCH(uint32_t, vertex_count);
+    ano_quadric_t* Q     = SCRATCH(ano_quadric_t, vertex_count);
+    uint8_t* kind        = SCRATCH(uint8_t, vertex_count);
+    uint8_t* feature     = SCRATCH(uint8_t, vertex_count);   // pass-0 dihedral feature flags (read both paths)
+    uint32_t* wtri       = SCRATCH(uint32_t, ic);
+    uint32_t* umark      = SCRATCH(uint32_t, vertex_count);  // edge-use count stamp (both orders)
+    uint32_t* ucnt       = SCRATCH(uint32_t, vertex_count);
+    uint32_t* linkNbr    = guards ? SCRATCH(uint32_t, vertex_count) : NULL; // link-cond common-ring stamp
+    float* orig_n        = guards ? SCRATCH(float, tri0 * 3) : NULL;        // pass-0 face normal per wtri slot
+    if (!npos || !remap || !collapse || !outid || !Q || !kind || !feature || !wtri || !umark || !ucnt ||
+        (guards && (!linkNbr || !orig_n)))
+        return SIZE_MAX;
+
+    // Pass order.
+    uint8_t* locked = NULL; uint32_t* adjCounts = NULL; uint32_t* adjOff = NULL; uint32_t* adjData = NULL;
+    uint32_t* wtmp = NULL; ano_collapse_t* cand = NULL; ano_collapse_t* candTmp = NULL; float* orig_n_tmp = NULL;
     size_t weldCap = ano_ceil_pow2(vertex_count * 2 + 16);
-    int32_t* weld        = (int32_t*)malloc(weldCap * sizeof(int32_t));
-    size_t ecap = ano_ceil_pow2(tri0 * 4 + 16);
-    uint64_t* ekeys      = (uint64_t*)malloc(ecap * sizeof(uint64_t));
-    uint32_t* ecnt       = (uint32_t*)malloc(ecap * sizeof(uint32_t));
-    uint8_t* feature     = (uint8_t*)malloc(vertex_count);   // pass-0 dihedral feature flags (read both paths)
-    uint32_t* linkNbr = NULL;                                 // link-cond common-ring stamp (guards-on only)
-    float* orig_n     = NULL; float* orig_n_tmp = NULL;       // pass-0 face normal per wtri slot (drift ref)
-    float* efn        = NULL; uint8_t* ehas      = NULL;      // feature detection: 1st incident normal per edge
-    if (edge_len_factor > 0.0f) {
-        linkNbr    = (uint32_t*)malloc(vertex_count * sizeof(uint32_t));
-        orig_n     = (float*)malloc(tri0 * 3 * sizeof(float));
-        orig_n_tmp = (float*)malloc(tri0 * 3 * sizeof(float));
-        efn        = (float*)malloc(ecap * 3 * sizeof(float));
-        ehas       = (uint8_t*)malloc(ecap);
+    // Heap order.
+    ano_heap_simplify_t h;
+    memset(&h, 0, sizeof h);
+    if (!heapOrder) {
+        locked     = SCRATCH(uint8_t, vertex_count);
+        adjCounts  = SCRATCH(uint32_t, vertex_count);
+        adjOff     = SCRATCH(uint32_t, vertex_count);
+        adjData    = SCRATCH(uint32_t, ic);
+        wtmp       = SCRATCH(uint32_t, ic);
+        cand       = SCRATCH(ano_collapse_t, vertex_count);
+        candTmp    = SCRATCH(ano_collapse_t, vertex_count);
+        orig_n_tmp = guards ? SCRATCH(float, tri0 * 3) : NULL;
+        if (!locked || !adjCounts || !adjOff || !adjData || !wtmp || !cand || !candTmp || (guards && !orig_n_tmp))
+            return SIZE_MAX;
+    } else {
+        h.chead    = SCRATCH(uint32_t, vertex_count);
+        h.ctail    = SCRATCH(uint32_t, vertex_count);
+        h.heap     = SCRATCH(ano_heap_entry_t, vertex_count);
+        h.hpos     = SCRATCH(uint32_t, vertex_count);
+        h.hnb      = SCRATCH(uint32_t, vertex_count);
+        h.skipNb   = SCRATCH(uint32_t, vertex_count);
+        h.stamp    = SCRATCH(uint32_t, vertex_count);
+        h.touched  = SCRATCH(uint32_t, vertex_count);
+        h.tfull    = SCRATCH(uint8_t, vertex_count);
+        h.skipCost = SCRATCH(float, vertex_count);
+        h.cnext    = SCRATCH(uint32_t, ic);
+        h.alive    = SCRATCH(uint8_t, tri0);
+        if (!h.chead || !h.ctail || !h.heap || !h.hpos || !h.hnb || !h.skipNb || !h.stamp || !h.touched ||
+            !h.tfull || !h.skipCost || !h.cnext || !h.alive)
+            return SIZE_MAX;
     }
-
-    if (!npos || !remap || !collapse || !Q || !kind || !locked || !outid || !adjCounts || !adjOff ||
-        !adjData || !wtri || !wtmp || !cand || !weld || !ekeys || !ecnt || !feature ||
-        (edge_len_factor > 0.0f && (!linkNbr || !orig_n || !orig_n_tmp || !efn || !ehas))) {
-        free(npos); free(remap); free(collapse); free(Q); free(kind); free(locked); free(outid);
-        free(adjCounts); free(adjOff); free(adjData); free(wtri); free(wtmp); free(cand);
-        free(weld); free(ekeys); free(ecnt); free(feature); free(linkNbr);
-        free(orig_n); free(orig_n_tmp); free(efn); free(ehas);  // free(NULL) safe -> off path unaffected
-        if (destination != indices) memcpy(destination, indices, ic * sizeof(uint32_t));
-        return ic;
+    // Attributes.
+    ano_attr_quadrics_t attr = { .count = (uint32_t)attribute_count };
+    float* wattr = NULL; uint32_t* wnext = NULL;
+    if (attribute_count) {
+        wattr     = SCRATCH(float, vertex_count * attribute_count);
+        attr.aq   = SCRATCH(ano_quadric_t, vertex_count);
+        attr.ag   = SCRATCH(float, vertex_count * attribute_count * 4);
+        wnext     = SCRATCH(uint32_t, vertex_count);
+        attr.wmap = SCRATCH(uint32_t, vertex_count);
+        if (!wattr || !attr.aq || !attr.ag || !wnext || !attr.wmap)
+            return SIZE_MAX;
+        attr.attr = wattr; attr.wnext = wnext;
     }
+    size_t tempMark = ano_arena_mark(arena);
+    int32_t* weld = SCRATCH(int32_t, weldCap);
+    if (!weld)
+        return SIZE_MAX;
     memset(feature, 0, vertex_count);   // off path stays all-zero -> feature-slide inert
 
     // Normalize positions to a unit-extent space so quadric magnitudes stay well-conditioned;
@@ -793,7 +1446,22 @@ size_t ano_simplify_ex(uint32_t* destination, const uint32_t* indices, size_t in
         }
         collapse[v] = v;
     }
-    free(weld);
+    ano_arena_rewind(arena, tempMark);
+
+    // Wedge lists: each canonical vertex heads the source vertices welded to it, in index order. The
+    // attributes are stored pre-weighted, so every attribute distance below is already relative.
+    if (attribute_count) {
+        const char* abase = (const char*)vertex_attributes;
+        for (size_t i = 0; i < vertex_count; ++i) {
+            const float* a = (const float*)(abase + i * vertex_attributes_stride);
+            for (size_t k = 0; k < attribute_count; ++k) wattr[i*attribute_count+k] = a[k] * attribute_weights[k];
+        }
+        memset(wnext, 0xFF, vertex_count * sizeof(uint32_t));
+        for (uint32_t v = (uint32_t)vertex_count; v-- > 0;) {
+            if (remap[v] == v) continue;
+            wnext[v] = wnext[remap[v]]; wnext[remap[v]] = v;
+        }
+    }
 
     // Working triangle list in canonical (welded) space; drop triangles already degenerate post-weld.
     size_t tris = 0;
@@ -826,14 +1494,56 @@ size_t ano_simplify_ex(uint32_t* destination, const uint32_t* indices, size_t in
     // per-candidate generation stamp avoids clearing V entries each candidate. 0 stays "never stamped".
     uint32_t linkGen = 0u;
     if (edge_len_factor > 0.0f) memset(linkNbr, 0, vertex_count * sizeof(uint32_t));
+    uint32_t ugen = 0u;  // same scheme for umark/ucnt
+    memset(umark, 0, vertex_count * sizeof(uint32_t));
 
     triangle_adjacency_t adj = { adjCounts, adjOff, adjData };
 
+    // Pass-0 topology, rewound with the weld table: the welded mesh's triangles per vertex, each
+    // triangle's border edges, and per ring neighbor the first face on the edge (feature detection).
+    triangle_adjacency_t adj0 = { SCRATCH(uint32_t, vertex_count), SCRATCH(uint32_t, vertex_count),
+                                  SCRATCH(uint32_t, tris * 3) };
+    uint8_t* bmask   = SCRATCH(uint8_t, tris);                        // bit k: edge (tri[k], tri[k+1]) is open
+    uint32_t* efirst = guards ? SCRATCH(uint32_t, vertex_count) : NULL;
+    if (!adj0.counts || !adj0.offsets || !adj0.data || !bmask || (guards && !efirst))
+        return SIZE_MAX;
+#undef SCRATCH
+
     // Accumulate quadrics ONCE over the original welded mesh: area-weighted face planes plus an
     // in-plane perpendicular constraint on every original border edge (resists boundary slide).
     // Collapses MERGE quadrics into survivors, so error is always measured against the original
     // surface, not the partially-simplified one — that is what makes target_error a real budget.
-    ano_count_edges(ekeys, ecnt, ecap, wtri, tris);
+    //
+    // Edge use counts come from each vertex's ring, not from a table of every edge: a triangle edge is
+    // open when its first corner's ring holds the second corner once. With the guards, a manifold edge
+    // (two faces) whose face normals deviate past ANO_FEATURE_COS is a sharp crease and flags both
+    // endpoints; feature vertices then slide only onto other feature vertices (below). orig_n holds
+    // exactly the unit face normals here, and Guard 5 left no face too small to have one.
+    build_triangle_adjacency(&adj0, wtri, tris * 3, vertex_count);
+    memset(bmask, 0, tris);
+    for (uint32_t x = 0; x < (uint32_t)vertex_count; ++x) {
+        if (adj0.counts[x] == 0) continue;
+        ano_adj_count_ring(&adj0, wtri, x, umark, ucnt, &ugen, vertex_count);
+        const uint32_t* xt = &adj0.data[adj0.offsets[x]];
+        for (uint32_t a = 0; a < adj0.counts[x]; ++a) {
+            const uint32_t* tri = &wtri[xt[a] * 3];
+            uint32_t k = tri[0] == x ? 0u : tri[1] == x ? 1u : 2u;
+            if (ucnt[tri[(k + 1) % 3]] == 1u) bmask[xt[a]] |= (uint8_t)(1u << k);
+        }
+        if (!guards) continue;
+        for (uint32_t a = 0; a < adj0.counts[x]; ++a) {   // each manifold edge (x, y > x) once
+            const uint32_t* tri = &wtri[xt[a] * 3];
+            for (int k = 0; k < 3; ++k) {
+                uint32_t y = tri[k];
+                if (y <= x || ucnt[y] != 2u) continue;
+                if (umark[y] == ugen) { efirst[y] = xt[a]; umark[y] = 0u; continue; }  // first face seen
+                const float* n0 = &orig_n[efirst[y] * 3]; const float* n1 = &orig_n[xt[a] * 3];
+                float dd = n0[0]*n1[0] + n0[1]*n1[1] + n0[2]*n1[2];  // cos(dihedral deviation)
+                if (dd < ANO_FEATURE_COS) { feature[x] = 1; feature[y] = 1; }
+            }
+        }
+    }
+
     memset(Q, 0, vertex_count * sizeof(ano_quadric_t));
     for (size_t t = 0; t < tris; ++t) {
         uint32_t ia = wtri[t*3+0], ib = wtri[t*3+1], ic2 = wtri[t*3+2];
@@ -852,7 +1562,7 @@ size_t ano_simplify_ex(uint32_t* destination, const uint32_t* indices, size_t in
         const uint32_t tri[3] = { ia, ib, ic2 };
         for (int k = 0; k < 3; ++k) {
             uint32_t x = tri[k], y = tri[(k+1)%3], z = tri[(k+2)%3];
-            if (ano_edge_get(ekeys, ecnt, ecap, x<y?x:y, x<y?y:x) != 1) continue;
+            if (!(bmask[t] & (1u << k))) continue;
             const float* q0 = &npos[x*3]; const float* q1 = &npos[y*3]; const float* q2 = &npos[z*3];
             float ed[3] = { q1[0]-q0[0], q1[1]-q0[1], q1[2]-q0[2] };
             float el = sqrtf(dot_product(ed, ed));
@@ -871,29 +1581,42 @@ size_t ano_simplify_ex(uint32_t* destination, const uint32_t* indices, size_t in
         }
     }
 
-    // Pass-0 dihedral feature detection (guards-on only; ekeys/ecnt still hold the pass-0 edge multiset).
-    // A manifold edge (ecnt==2) whose two incident face normals deviate past ANO_FEATURE_COS is a sharp
-    // crease; flag both endpoints. Feature verts then slide only onto other feature verts (below). O(tris).
-    if (edge_len_factor > 0.0f) {
-        memset(ehas, 0, ecap);
-        for (size_t t = 0; t < tris; ++t) {
-            uint32_t ia = wtri[t*3+0], ib = wtri[t*3+1], ic2 = wtri[t*3+2];
-            const float* p0 = &npos[ia*3]; const float* p1 = &npos[ib*3]; const float* p2 = &npos[ic2*3];
+    // Attribute quadrics over the source triangles, whose corners name the wedges (the working list has
+    // only canonical ids). A face's attribute field is the linear one through its three corners, kept in
+    // the face plane: g = x*e1 + y*e2 with g.e1 and g.e2 the attribute deltas along the edges.
+    if (attribute_count) {
+        memset(attr.aq, 0, vertex_count * sizeof(ano_quadric_t));
+        memset(attr.ag, 0, vertex_count * attribute_count * 4 * sizeof(float));
+        for (size_t t = 0; t < tri0; ++t) {
+            const uint32_t o[3] = { indices[t*3+0], indices[t*3+1], indices[t*3+2] };
+            if (remap[o[0]] == remap[o[1]] || remap[o[1]] == remap[o[2]] || remap[o[0]] == remap[o[2]]) continue;
+            const float* p0 = &npos[o[0]*3]; const float* p1 = &npos[o[1]*3]; const float* p2 = &npos[o[2]*3];
             float e1[3] = { p1[0]-p0[0], p1[1]-p0[1], p1[2]-p0[2] };
             float e2[3] = { p2[0]-p0[0], p2[1]-p0[1], p2[2]-p0[2] };
             float n[3]; cross_product(e1, e2, n);
-            float len = sqrtf(dot_product(n, n)); if (len < 1e-12f) continue;
-            n[0]/=len; n[1]/=len; n[2]/=len;
-            const uint32_t tri[3] = { ia, ib, ic2 };
-            for (int k = 0; k < 3; ++k) {
-                uint32_t x = tri[k], y = tri[(k+1)%3];
-                uint32_t lo = x<y?x:y, hi = x<y?y:x;
-                if (ano_edge_get(ekeys, ecnt, ecap, lo, hi) != 2) continue;   // manifold edges only
-                size_t s = ano_edge_slot(ekeys, ecap, lo, hi);
-                if (!ehas[s]) { efn[s*3]=n[0]; efn[s*3+1]=n[1]; efn[s*3+2]=n[2]; ehas[s]=1; continue; }
-                float dd = efn[s*3]*n[0] + efn[s*3+1]*n[1] + efn[s*3+2]*n[2]; // cos(dihedral deviation)
-                if (dd < ANO_FEATURE_COS) { feature[lo] = 1; feature[hi] = 1; }
+            float len2 = dot_product(n, n);
+            if (len2 < ANO_SIMPLIFY_AREA_EPS2) continue;  // the faces the geometric pass skips
+            float area = sqrtf(len2) * 0.5f;
+            float e11 = dot_product(e1, e1), e12 = dot_product(e1, e2), e22 = dot_product(e2, e2);
+            float inv = 1.0f / len2;  // Gram determinant e11*e22 - e12^2 == |e1 x e2|^2
+            ano_quadric_t fq; memset(&fq, 0, sizeof fq);
+            fq.w = area;
+            for (size_t k = 0; k < attribute_count; ++k) {
+                float s0 = wattr[o[0]*attribute_count+k];
+                float d1 = wattr[o[1]*attribute_count+k] - s0, d2 = wattr[o[2]*attribute_count+k] - s0;
+                float x = (e22*d1 - e12*d2) * inv, y = (e11*d2 - e12*d1) * inv;
+                float g[3] = { x*e1[0] + y*e2[0], x*e1[1] + y*e2[1], x*e1[2] + y*e2[2] };
+                float d = s0 - dot_product(g, p0);
+                fq.a00 += g[0]*g[0]*area; fq.a11 += g[1]*g[1]*area; fq.a22 += g[2]*g[2]*area;
+                fq.a10 += g[0]*g[1]*area; fq.a20 += g[0]*g[2]*area; fq.a21 += g[1]*g[2]*area;
+                fq.b0 += g[0]*d*area; fq.b1 += g[1]*d*area; fq.b2 += g[2]*d*area;
+                fq.c += d*d*area;
+                for (int i = 0; i < 3; ++i) {
+                    float* gk = &attr.ag[((size_t)o[i] * attribute_count + k) * 4];
+                    gk[0] += g[0]*area; gk[1] += g[1]*area; gk[2] += g[2]*area; gk[3] += d*area;
+                }
             }
+            for (int i = 0; i < 3; ++i) ano_quadric_add(&attr.aq[o[i]], &fq);
         }
     }
 
@@ -930,214 +1653,254 @@ size_t ano_simplify_ex(uint32_t* destination, const uint32_t* indices, size_t in
         }
     }
 
-    for (size_t pass = 0; pass < ANO_SIMPLIFY_MAX_PASSES && tris > target_tris; ++pass) {
-        size_t tris_before = tris;
-
-        // Incident-triangle lists per canonical vertex (counts[v] == incident triangle count).
-        build_triangle_adjacency(&adj, wtri, tris_before * 3, vertex_count);
-
-        // Current edge-use counts -> per-vertex kind (border / locked-complex / manifold). Topology
-        // changes as the mesh simplifies, so kinds are rebuilt each pass; the quadrics are not.
-        ano_count_edges(ekeys, ecnt, ecap, wtri, tris_before);
-        for (size_t v = 0; v < vertex_count; ++v)
-            kind[v] = (adjCounts[v] == 0) ? ANO_VK_LOCKED : ANO_VK_MANIFOLD;
-        for (size_t s = 0; s < ecap; ++s) {
-            if (ekeys[s] == 0) continue;
-            uint32_t lo = (uint32_t)(ekeys[s] >> 32), hi = (uint32_t)(ekeys[s] & 0xFFFFFFFFu);
-            if (ecnt[s] == 1) {
-                if (kind[lo] != ANO_VK_LOCKED) kind[lo] = ANO_VK_BORDER;
-                if (kind[hi] != ANO_VK_LOCKED) kind[hi] = ANO_VK_BORDER;
-            } else if (ecnt[s] > 2) {
-                kind[lo] = ANO_VK_LOCKED; kind[hi] = ANO_VK_LOCKED;
-            }
-        }
-
-        // Score the cheapest legal collapse out of each vertex.
-        size_t ncand = 0;
-        for (uint32_t v = 0; v < (uint32_t)vertex_count; ++v) {
-            if (adjCounts[v] == 0 || kind[v] == ANO_VK_LOCKED) continue;
-            float best = FLT_MAX; uint32_t bestnb = v;
-            for (uint32_t a = 0; a < adjCounts[v]; ++a) {
-                uint32_t t = adjData[adjOff[v] + a];
-                for (int k = 0; k < 3; ++k) {
-                    uint32_t nb = wtri[t*3+k];
-                    if (nb == v) continue;
-                    if (kind[v] == ANO_VK_BORDER) {
-                        // Border may only slide to another border vertex along a border edge.
-                        if (kind[nb] != ANO_VK_BORDER) continue;
-                        if (ano_edge_get(ekeys, ecnt, ecap, v<nb?v:nb, v<nb?nb:v) != 1) continue;
-                    } else {
-                        if (kind[nb] == ANO_VK_LOCKED) continue;
-                        // Feature-slide (gated; feature[] all-zero when off -> inert): a sharp-dihedral
-                        // vertex snaps ONLY onto another feature vertex, so a crease/rim decimates along
-                        // its own loop, never inward. The maxEdge2 move pre-filter below bounds the jump.
-                        if (feature[v] && !feature[nb]) continue;
+    ano_arena_rewind(arena, tempMark);  // the pass-0 topology
+
+    if (heapOrder) {
+        h.vertex_count = vertex_count; h.tris = tris; h.target_tris = target_tris;
+        h.npos = npos; h.collapse = collapse; h.Q = Q; h.feature = feature; h.kind = kind; h.wtri = wtri;
+        h.orig_n = orig_n; h.linkNbr = linkNbr; h.umark = umark; h.ucnt = ucnt; h.ugen = ugen; h.attr = &attr;
+        h.err_limit = err_limit; h.maxEdge2 = maxEdge2;
+        memset(h.chead, 0xFF, vertex_count * sizeof(uint32_t));
+        memset(h.ctail, 0xFF, vertex_count * sizeof(uint32_t));
+        memset(h.hpos, 0xFF, vertex_count * sizeof(uint32_t));
+        memset(h.stamp, 0, vertex_count * sizeof(uint32_t));
+        memset(h.alive, 1, tri0);
+        ano_heap_run(&h);
+        result_err2 = h.result_err2;
+    } else {
+        for (size_t pass = 0; pass < ANO_SIMPLIFY_MAX_PASSES && tris > target_tris; ++pass) {
+            size_t tris_before = tris;
+
+            // Incident-triangle lists per canonical vertex (counts[v] == incident triangle count).
+            build_triangle_adjacency(&adj, wtri, tris_before * 3, vertex_count);
+
+            // Current edge-use counts -> per-vertex kind (border / locked-complex / manifold): locked on
+            // any edge in >2 triangles, border on any edge in one. Topology changes as the mesh
+            // simplifies, so kinds are rebuilt each pass; the quadrics are not.
+            for (uint32_t v = 0; v < (uint32_t)vertex_count; ++v) {
+                if (adjCounts[v] == 0) { kind[v] = ANO_VK_LOCKED; continue; }
+                ano_adj_count_ring(&adj, wtri, v, umark, ucnt, &ugen, vertex_count);
+                uint8_t kv = ANO_VK_MANIFOLD;
+                for (uint32_t a = 0; a < adjCounts[v] && kv != ANO_VK_LOCKED; ++a) {
+                    const uint32_t* tri = &wtri[adjData[adjOff[v] + a] * 3];
+                    for (int k = 0; k < 3; ++k) {
+                        if (tri[k] == v) continue;
+                        if (ucnt[tri[k]] > 2u) { kv = ANO_VK_LOCKED; break; }
+                        if (ucnt[tri[k]] == 1u) kv = ANO_VK_BORDER;
                     }
-                    // Pre-filter: never snap v across more than the growth cap (bounds the move length;
-                    // the resulting-triangle cap in the flip guard is the hard backstop). Inert when off.
-                    float dv[3] = { npos[nb*3]-npos[v*3], npos[nb*3+1]-npos[v*3+1], npos[nb*3+2]-npos[v*3+2] };
-                    if (dot_product(dv, dv) > maxEdge2) continue;
-                    float cost = ano_quadric_error(&Q[v], &npos[nb*3]);
-                    if (cost < best) { best = cost; bestnb = nb; }
                 }
+                kind[v] = kv;
             }
-            if (best < FLT_MAX && bestnb != v) {
-                cand[ncand].cost = best; cand[ncand].v = v; cand[ncand].t = bestnb; ncand++;
-            }
-        }
-        qsort(cand, ncand, sizeof(ano_collapse_t), ano_collapse_cmp);
-
-        // Apply collapses cheapest-first as a maximal matching (each vertex collapses at most once
-        // per pass), skipping any that would flip a triangle. Stop at the count or error budget.
-        memset(locked, 0, vertex_count);
-        size_t collapses = 0;
-        size_t rtris = tris_before;
-        for (size_t i = 0; i < ncand; ++i) {
-            if (rtris <= target_tris) break;
-            if (cand[i].cost > err_limit) break;  // sorted: nothing cheaper remains
-            uint32_t v = cand[i].v, j = cand[i].t;
-            if (locked[v] || locked[j]) continue;
-
-            // Link condition (topology guard; guards-on only, shares Guard 6's gate so pass-start
-            // adjacency is exact at commit time). v->j is manifold-safe iff the shared 1-ring of v and j
-            // is EXACTLY the <=2 apex corners of the triangles on edge (v,j). Any OTHER common neighbor w
-            // means two sheets meet only at w; welding pinches a non-manifold point (bridge; rim->cone).
-            if (maxEdge2 != FLT_MAX) {
-                if (++linkGen == 0u) { memset(linkNbr, 0, vertex_count * sizeof(uint32_t)); linkGen = 1u; }
-                uint32_t apex[2] = {0u, 0u}; uint32_t napex = 0;
-                for (uint32_t a = 0; a < adjCounts[j]; ++a) {          // stamp N(j); collect edge-(v,j) apexes
-                    uint32_t t = adjData[adjOff[j] + a];
-                    uint32_t c0 = wtri[t*3+0], c1 = wtri[t*3+1], c2 = wtri[t*3+2];
-                    linkNbr[c0] = linkGen; linkNbr[c1] = linkGen; linkNbr[c2] = linkGen;
-                    if (c0 == v || c1 == v || c2 == v) {
-                        uint32_t w = (c0 != v && c0 != j) ? c0 : (c1 != v && c1 != j) ? c1 : c2;
-                        if (napex < 2) apex[napex] = w;
-                        napex++;
-                    }
-                }
-                int link_bad = 0;
-                for (uint32_t a = 0; a < adjCounts[v] && !link_bad; ++a) {
+
+            // Score the cheapest legal collapse out of each vertex. Each neighbor is visited once (its
+            // ring-count stamp cleared on the visit), gathered into lanes and scored against Q[v] a batch
+            // at a time; the first least cost in visit order wins, as it did one edge at a time.
+            size_t ncand = 0;
+            for (uint32_t v = 0; v < (uint32_t)vertex_count; ++v) {
+                if (adjCounts[v] == 0 || kind[v] == ANO_VK_LOCKED) continue;
+                ano_adj_count_ring(&adj, wtri, v, umark, ucnt, &ugen, vertex_count);
+                _Alignas(ANO_SIMPLIFY_ALIGN) float xs[ANO_SIMPLIFY_LANES], ys[ANO_SIMPLIFY_LANES];
+                _Alignas(ANO_SIMPLIFY_ALIGN) float zs[ANO_SIMPLIFY_LANES], cost[ANO_SIMPLIFY_LANES];
+                uint32_t ids[ANO_SIMPLIFY_LANES];
+                uint32_t n = 0;
+                float best = FLT_MAX; uint32_t bestnb = v;
+                for (uint32_t a = 0; a < adjCounts[v]; ++a) {
                     uint32_t t = adjData[adjOff[v] + a];
                     for (int k = 0; k < 3; ++k) {
-                        uint32_t w = wtri[t*3+k];
-                        if (w == v || w == j) continue;
-                        if (linkNbr[w] != linkGen) continue;
-                        if (!(napex > 0 && w == apex[0]) && !(napex > 1 && w == apex[1])) { link_bad = 1; break; }
+                        uint32_t nb = wtri[t*3+k];
+                        if (nb == v || umark[nb] != ugen) continue;
+                        umark[nb] = 0u;  // visited (0 is never a live stamp)
+                        if (kind[v] == ANO_VK_BORDER) {
+                            // Border may only slide to another border vertex along a border edge.
+                            if (kind[nb] != ANO_VK_BORDER) continue;
+                            if (ucnt[nb] != 1u) continue;
+                        } else {
+                            if (kind[nb] == ANO_VK_LOCKED) continue;
+                            // Feature-slide (gated; feature[] all-zero when off -> inert): a sharp-dihedral
+                            // vertex snaps ONLY onto another feature vertex, so a crease/rim decimates along
+                            // its own loop, never inward. The maxEdge2 move pre-filter below bounds the jump.
+                            if (feature[v] && !feature[nb]) continue;
+                        }
+                        // Pre-filter: never snap v across more than the growth cap (bounds the move length;
+                        // the resulting-triangle cap in the flip guard is the hard backstop). Inert when off.
+                        float dv[3] = { npos[nb*3]-npos[v*3], npos[nb*3+1]-npos[v*3+1], npos[nb*3+2]-npos[v*3+2] };
+                        if (dot_product(dv, dv) > maxEdge2) continue;
+                        xs[n] = npos[nb*3]; ys[n] = npos[nb*3+1]; zs[n] = npos[nb*3+2]; ids[n] = nb;
+                        if (++n < ANO_SIMPLIFY_LANES) continue;
+                        ano_collapse_error_lanes(&Q[v], &attr, v, ids, xs, ys, zs, cost, n);
+                        for (uint32_t i = 0; i < n; ++i)
+                            if (cost[i] < best) { best = cost[i]; bestnb = ids[i]; }
+                        n = 0;
                     }
                 }
-                // Tetra exclusion: the vertex link above is necessary-not-sufficient. When the two apexes
-                // a0,a1 close a face on BOTH v and j, v,j,a0,a1 form a filled tetrahedron and v->j emits a
-                // doubled face (v,a0,a1)->(j,a0,a1). A v-incident tri holding both a0,a1 is exactly (v,a0,a1).
-                if (!link_bad && napex == 2) {
-                    uint32_t a0 = apex[0], a1 = apex[1]; int vf = 0, jf = 0;
-                    for (uint32_t a = 0; a < adjCounts[v]; ++a) {
-                        const uint32_t* c = &wtri[adjData[adjOff[v] + a]*3];
-                        if ((c[0]==a0||c[1]==a0||c[2]==a0) && (c[0]==a1||c[1]==a1||c[2]==a1)) { vf = 1; break; }
+                ano_collapse_error_lanes(&Q[v], &attr, v, ids, xs, ys, zs, cost, n);
+                for (uint32_t i = 0; i < n; ++i)
+                    if (cost[i] < best) { best = cost[i]; bestnb = ids[i]; }
+                if (best < FLT_MAX && bestnb != v) {
+                    cand[ncand].cost = best; cand[ncand].v = v; cand[ncand].t = bestnb; ncand++;
+                }
+            }
+            const ano_collapse_t* order = ano_collapse_sort(cand, candTmp, ncand);
+
+            // Apply collapses cheapest-first as a maximal matching (each vertex collapses at most once
+            // per pass), skipping any that would flip a triangle. Stop at the count or error budget.
+            memset(locked, 0, vertex_count);
+            size_t collapses = 0;
+            size_t rtris = tris_before;
+            for (size_t i = 0; i < ncand; ++i) {
+                if (rtris <= target_tris) break;
+                if (order[i].cost > err_limit) break;  // sorted: nothing cheaper remains
+                uint32_t v = order[i].v, j = order[i].t;
+                if (locked[v] || locked[j]) continue;
+
+                // Link condition (topology guard; guards-on only, shares Guard 6's gate so pass-start
+                // adjacency is exact at commit time). v->j is manifold-safe iff the shared 1-ring of v and j
+                // is EXACTLY the <=2 apex corners of the triangles on edge (v,j). Any OTHER common neighbor w
+                // means two sheets meet only at w; welding pinches a non-manifold point (bridge; rim->cone).
+                if (maxEdge2 != FLT_MAX) {
+                    if (++linkGen == 0u) { memset(linkNbr, 0, vertex_count * sizeof(uint32_t)); linkGen = 1u; }
+                    uint32_t apex[2] = {0u, 0u}; uint32_t napex = 0;
+                    for (uint32_t a = 0; a < adjCounts[j]; ++a) {          // stamp N(j); collect edge-(v,j) apexes
+                        uint32_t t = adjData[adjOff[j] + a];
+                        uint32_t c0 = wtri[t*3+0], c1 = wtri[t*3+1], c2 = wtri[t*3+2];
+                        linkNbr[c0] = linkGen; linkNbr[c1] = linkGen; linkNbr[c2] = linkGen;
+                        if (c0 == v || c1 == v || c2 == v) {
+                            uint32_t w = (c0 != v && c0 != j) ? c0 : (c1 != v && c1 != j) ? c1 : c2;
+                            if (napex < 2) apex[napex] = w;
+                            napex++;
+                        }
+                    }
+                    int link_bad = 0;
+                    for (uint32_t a = 0; a < adjCounts[v] && !link_bad; ++a) {
+                        uint32_t t = adjData[adjOff[v] + a];
+                        for (int k = 0; k < 3; ++k) {
+                            uint32_t w = wtri[t*3+k];
+                            if (w == v || w == j) continue;
+                            if (linkNbr[w] != linkGen) continue;
+                            if (!(napex > 0 && w == apex[0]) && !(napex > 1 && w == apex[1])) { link_bad = 1; break; }
+                        }
                     }
-                    for (uint32_t a = 0; vf && a < adjCounts[j]; ++a) {
-                        const uint32_t* c = &wtri[adjData[adjOff[j] + a]*3];
-                        if ((c[0]==a0||c[1]==a0||c[2]==a0) && (c[0]==a1||c[1]==a1||c[2]==a1)) { jf = 1; break; }
+                    // Tetra exclusion: the vertex link above is necessary-not-sufficient. When the two apexes
+                    // a0,a1 close a face on BOTH v and j, v,j,a0,a1 form a filled tetrahedron and v->j emits a
+                    // doubled face (v,a0,a1)->(j,a0,a1). A v-incident tri holding both a0,a1 is exactly (v,a0,a1).
+                    if (!link_bad && napex == 2) {
+                        uint32_t a0 = apex[0], a1 = apex[1]; int vf = 0, jf = 0;
+                        for (uint32_t a = 0; a < adjCounts[v]; ++a) {
+                            const uint32_t* c = &wtri[adjData[adjOff[v] + a]*3];
+                            if ((c[0]==a0||c[1]==a0||c[2]==a0) && (c[0]==a1||c[1]==a1||c[2]==a1)) { vf = 1; break; }
+                        }
+                        for (uint32_t a = 0; vf && a < adjCounts[j]; ++a) {
+                            const uint32_t* c = &wtri[adjData[adjOff[j] + a]*3];
+                            if ((c[0]==a0||c[1]==a0||c[2]==a0) && (c[0]==a1||c[1]==a1||c[2]==a1)) { jf = 1; break; }
+                        }
+                        if (vf && jf) link_bad = 1;
                     }
-                    if (vf && jf) link_bad = 1;
+                    if (link_bad) continue;
                 }
-                if (link_bad) continue;
-            }
 
-            // Flip guard: every incident triangle not destroyed by the collapse must keep its facing.
-            int flip = 0; uint32_t removed = 0;
-            for (uint32_t a = 0; a < adjCounts[v] && !flip; ++a) {
-                uint32_t t = adjData[adjOff[v] + a];
-                uint32_t c0 = wtri[t*3+0], c1 = wtri[t*3+1], c2 = wtri[t*3+2];
-                if (c0 == j || c1 == j || c2 == j) { removed++; continue; }
-                float o0[3], o1[3], o2[3];
-                o0[0]=npos[c0*3]; o0[1]=npos[c0*3+1]; o0[2]=npos[c0*3+2];
-                o1[0]=npos[c1*3]; o1[1]=npos[c1*3+1]; o1[2]=npos[c1*3+2];
-                o2[0]=npos[c2*3]; o2[1]=npos[c2*3+1]; o2[2]=npos[c2*3+2];
-                float* mv = (c0==v) ? o0 : (c1==v) ? o1 : o2;
-                float oe1[3] = { o1[0]-o0[0], o1[1]-o0[1], o1[2]-o0[2] };
-                float oe2[3] = { o2[0]-o0[0], o2[1]-o0[1], o2[2]-o0[2] };
-                float on[3]; cross_product(oe1, oe2, on);
-                mv[0]=npos[j*3]; mv[1]=npos[j*3+1]; mv[2]=npos[j*3+2];
-                float ne1[3] = { o1[0]-o0[0], o1[1]-o0[1], o1[2]-o0[2] };
-                float ne2[3] = { o2[0]-o0[0], o2[1]-o0[1], o2[2]-o0[2] };
-                float nn[3]; cross_product(ne1, ne2, nn);
-                float nlen2 = dot_product(nn, nn);
-                // Fold/needle + growth guard. nlen2==(2*newArea)^2, |on|==2*oldArea.
-                if (nlen2 < 1e-20f) { flip = 1; }               // exact sliver (also guards sqrtf(0))
-                else if (maxEdge2 == FLT_MAX) {                 // guards off: baseline fold-only test
-                    if (dot_product(on, nn) < 0.0f) flip = 1;
-                } else {                                        // guards on: drift + tighter fold + growth cap
-                    // Cumulative-drift guard (RC2): reject if triangle t has rotated past theta_max (60deg)
-                    // from the ORIGINAL pass-0 normal of the slot it descends from. Bounds TOTAL drift, not
-                    // one step. Squared, sign-guarded form (dnd<0 => >90deg) avoids a sqrt. In-plane planar
-                    // collapse keeps nn || orig_n -> dnd==|nn| -> dnd*dnd==nlen2 > 0.25*nlen2 -> no-op on flats.
-                    const float* onr = &orig_n[t*3];
-                    float dnd = onr[0]*nn[0] + onr[1]*nn[1] + onr[2]*nn[2];
-                    if (dnd < 0.0f || dnd*dnd <
-                            ANO_SIMPLIFY_MAX_NORMAL_DRIFT_COS * ANO_SIMPLIFY_MAX_NORMAL_DRIFT_COS * nlen2) {
-                        flip = 1; break;
+                // Flip guard: every incident triangle not destroyed by the collapse must keep its facing.
+                int flip = 0; uint32_t removed = 0;
+                for (uint32_t a = 0; a < adjCounts[v] && !flip; ++a) {
+                    uint32_t t = adjData[adjOff[v] + a];
+                    uint32_t c0 = wtri[t*3+0], c1 = wtri[t*3+1], c2 = wtri[t*3+2];
+                    if (c0 == j || c1 == j || c2 == j) { removed++; continue; }
+                    float o0[3], o1[3], o2[3];
+                    o0[0]=npos[c0*3]; o0[1]=npos[c0*3+1]; o0[2]=npos[c0*3+2];
+                    o1[0]=npos[c1*3]; o1[1]=npos[c1*3+1]; o1[2]=npos[c1*3+2];
+                    o2[0]=npos[c2*3]; o2[1]=npos[c2*3+1]; o2[2]=npos[c2*3+2];
+                    float* mv = (c0==v) ? o0 : (c1==v) ? o1 : o2;
+                    float oe1[3] = { o1[0]-o0[0], o1[1]-o0[1], o1[2]-o0[2] };
+                    float oe2[3] = { o2[0]-o0[0], o2[1]-o0[1], o2[2]-o0[2] };
+                    float on[3]; cross_product(oe1, oe2, on);
+                    mv[0]=npos[j*3]; mv[1]=npos[j*3+1]; mv[2]=npos[j*3+2];
+                    float ne1[3] = { o1[0]-o0[0], o1[1]-o0[1], o1[2]-o0[2] };
+                    float ne2[3] = { o2[0]-o0[0], o2[1]-o0[1], o2[2]-o0[2] };
+                    float nn[3]; cross_product(ne1, ne2, nn);
+                    float nlen2 = dot_product(nn, nn);
+                    // Fold/needle + growth guard. nlen2==(2*newArea)^2, |on|==2*oldArea.
+                    if (nlen2 < 1e-20f) { flip = 1; }               // exact sliver (also guards sqrtf(0))
+                    else if (maxEdge2 == FLT_MAX) {                 // guards off: baseline fold-only test
+                        if (dot_product(on, nn) < 0.0f) flip = 1;
+                    } else {                                        // guards on: drift + tighter fold + growth cap
+                        // Cumulative-drift guard (RC2): reject if triangle t has rotated past theta_max (60deg)
+                        // from the ORIGINAL pass-0 normal of the slot it descends from. Bounds TOTAL drift, not
+                        // one step. Squared, sign-guarded form (dnd<0 => >90deg) avoids a sqrt. In-plane planar
+                        // collapse keeps nn || orig_n -> dnd==|nn| -> dnd*dnd==nlen2 > 0.25*nlen2 -> no-op on flats.
+                        const float* onr = &orig_n[t*3];
+                        float dnd = onr[0]*nn[0] + onr[1]*nn[1] + onr[2]*nn[2];
+                        if (dnd < 0.0f || dnd*dnd <
+                                ANO_SIMPLIFY_MAX_NORMAL_DRIFT_COS * ANO_SIMPLIFY_MAX_NORMAL_DRIFT_COS * nlen2) {
+                            flip = 1; break;
+                        }
+                        // Guard 4: reject a >~75deg normal turn (fold/cap/spike) the sign test passes; RHS is
+                        // the geometric mean of old/new areas, so it is scale-free (meshopt hasTriangleFlip).
+                        float olen2 = dot_product(on, on);
+                        if (dot_product(on, nn) <= 0.25f * sqrtf(olen2 * nlen2)) flip = 1;
+                        else {
+                            // Growth cap (anti-bridge): reject if any resulting edge exceeds the cap. This is
+                            // the decisive in-plane guard the fold test misses (a bridge keeps its facing).
+                            // ne1=o1-o0, ne2=o2-o0 are the moved edges; ne3=o2-o1 the third.
+                            float ne3[3] = { o2[0]-o1[0], o2[1]-o1[1], o2[2]-o1[2] };
+                            if (dot_product(ne1, ne1) > maxEdge2 || dot_product(ne2, ne2) > maxEdge2 ||
+                                dot_product(ne3, ne3) > maxEdge2) flip = 1;
+                        }
                     }
-                    // Guard 4: reject a >~75deg normal turn (fold/cap/spike) the sign test passes; RHS is
-                    // the geometric mean of old/new areas, so it is scale-free (meshopt hasTriangleFlip).
-                    float olen2 = dot_product(on, on);
-                    if (dot_product(on, nn) <= 0.25f * sqrtf(olen2 * nlen2)) flip = 1;
-                    else {
-                        // Growth cap (anti-bridge): reject if any resulting edge exceeds the cap. This is
-                        // the decisive in-plane guard the fold test misses (a bridge keeps its facing).
-                        // ne1=o1-o0, ne2=o2-o0 are the moved edges; ne3=o2-o1 the third.
-                        float ne3[3] = { o2[0]-o1[0], o2[1]-o1[1], o2[2]-o1[2] };
-                        if (dot_product(ne1, ne1) > maxEdge2 || dot_product(ne2, ne2) > maxEdge2 ||
-                            dot_product(ne3, ne3) > maxEdge2) flip = 1;
+                }
+                if (flip) continue;
+
+                collapse[v] = j; locked[v] = 1; locked[j] = 1;
+                // Guard 6: with the growth cap on, lock EVERY corner of v's incident triangles (not just v/j)
+                // so no other collapse this pass moves a second corner of a triangle this one already moved.
+                // That makes the resulting-edge cap a true per-pass invariant instead of a ~3x per-collapse
+                // bound (every guard check above is then evaluated against un-mutated geometry). Inert when off.
+                if (maxEdge2 != FLT_MAX) {
+                    for (uint32_t a = 0; a < adjCounts[v]; ++a) {
+                        uint32_t t = adjData[adjOff[v] + a];
+                        locked[wtri[t*3+0]] = 1; locked[wtri[t*3+1]] = 1; locked[wtri[t*3+2]] = 1;
                     }
                 }
+                ano_quadric_add(&Q[j], &Q[v]);
+                if (attribute_count) ano_attr_merge(&attr, v, j);
+                rtris -= removed;
+                if (order[i].cost > result_err2) result_err2 = order[i].cost;
+                collapses++;
             }
-            if (flip) continue;
-
-            collapse[v] = j; locked[v] = 1; locked[j] = 1;
-            // Guard 6: with the growth cap on, lock EVERY corner of v's incident triangles (not just v/j)
-            // so no other collapse this pass moves a second corner of a triangle this one already moved.
-            // That makes the resulting-edge cap a true per-pass invariant instead of a ~3x per-collapse
-            // bound (every guard check above is then evaluated against un-mutated geometry). Inert when off.
-            if (maxEdge2 != FLT_MAX) {
-                for (uint32_t a = 0; a < adjCounts[v]; ++a) {
-                    uint32_t t = adjData[adjOff[v] + a];
-                    locked[wtri[t*3+0]] = 1; locked[wtri[t*3+1]] = 1; locked[wtri[t*3+2]] = 1;
+
+            // Rebuild the canonical triangle list through the collapse map, dropping degenerates.
+            size_t newtris = 0;
+            for (size_t t = 0; t < tris_before; ++t) {
+                uint32_t a = ano_resolve(collapse, wtri[t*3+0]);
+                uint32_t b = ano_resolve(collapse, wtri[t*3+1]);
+                uint32_t c = ano_resolve(collapse, wtri[t*3+2]);
+                if (a == b || b == c || a == c) continue;
+                wtmp[newtris*3+0] = a; wtmp[newtris*3+1] = b; wtmp[newtris*3+2] = c;
+                if (orig_n) {                       // keep orig_n[newtris] aligned with the wtmp slot (1:1 descent)
+                    orig_n_tmp[newtris*3+0] = orig_n[t*3+0];
+                    orig_n_tmp[newtris*3+1] = orig_n[t*3+1];
+                    orig_n_tmp[newtris*3+2] = orig_n[t*3+2];
                 }
+                newtris++;
             }
-            ano_quadric_add(&Q[j], &Q[v]);
-            rtris -= removed;
-            if (cand[i].cost > result_err2) result_err2 = cand[i].cost;
-            collapses++;
-        }
+            uint32_t* swap = wtri; wtri = wtmp; wtmp = swap;
+            if (orig_n) { float* ns = orig_n; orig_n = orig_n_tmp; orig_n_tmp = ns; }  // parallel swap
+            tris = newtris;
 
-        // Rebuild the canonical triangle list through the collapse map, dropping degenerates.
-        size_t newtris = 0;
-        for (size_t t = 0; t < tris_before; ++t) {
-            uint32_t a = ano_resolve(collapse, wtri[t*3+0]);
-            uint32_t b = ano_resolve(collapse, wtri[t*3+1]);
-            uint32_t c = ano_resolve(collapse, wtri[t*3+2]);
-            if (a == b || b == c || a == c) continue;
-            wtmp[newtris*3+0] = a; wtmp[newtris*3+1] = b; wtmp[newtris*3+2] = c;
-            if (orig_n) {                       // keep orig_n[newtris] aligned with the wtmp slot (1:1 descent)
-                orig_n_tmp[newtris*3+0] = orig_n[t*3+0];
-                orig_n_tmp[newtris*3+1] = orig_n[t*3+1];
-                orig_n_tmp[newtris*3+2] = orig_n[t*3+2];
-            }
-            newtris++;
+            if (collapses == 0 || tris >= tris_before) break;  // converged / no progress
         }
-        uint32_t* swap = wtri; wtri = wtmp; wtmp = swap;
-        if (orig_n) { float* ns = orig_n; orig_n = orig_n_tmp; orig_n_tmp = ns; }  // parallel swap
-        tris = newtris;
 
-        if (collapses == 0 || tris >= tris_before) break;  // converged / no progress
     }
 
     // Output mapping per ORIGINAL vertex: a vertex whose position survives keeps its own id (so seam
-    // wedges stay distinct); a vertex whose position was collapsed snaps to the survivor canonical id.
+    // wedges stay distinct); a vertex whose position was collapsed snaps to the survivor canonical id,
+    // or with attributes follows its merges to the survivor wedge it landed on, so seams stay seams.
     for (uint32_t o = 0; o < (uint32_t)vertex_count; ++o) {
         uint32_t c = remap[o];
         uint32_t r = ano_resolve(collapse, c);
-        outid[o] = (r == c) ? o : r;
+        if (r == c) { outid[o] = o; continue; }
+        if (!attribute_count) { outid[o] = r; continue; }
+        uint32_t x = o;
+        while (collapse[remap[x]] != remap[x]) x = attr.wmap[x];
+        outid[o] = x;
     }
 
     // Emit surviving source triangles. Degeneracy is tested in canonical position space so a triangle
@@ -1155,10 +1918,5 @@ size_t ano_simplify_ex(uint32_t* destination, const uint32_t* indices, size_t in
     }
 
     if (out_result_error) *out_result_error = sqrtf(result_err2) * extent;
-
-    free(npos); free(remap); free(collapse); free(Q); free(kind); free(locked); free(outid);
-    free(adjCounts); free(adjOff); free(adjData); free(wtri); free(wtmp); free(cand);
-    free(ekeys); free(ecnt); free(linkNbr); free(feature);
-    free(orig_n); free(orig_n_tmp); free(efn); free(ehas);
     return outcount;
 }
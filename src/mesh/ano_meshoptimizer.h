@@ -85,8 +85,9 @@ float ano_simplify_scale(const float* vertex_positions, size_t vertex_count, siz
  * triangles (coincident-position corners) are always dropped, so the output is a valid subset mesh
  * even when target_index_count >= index_count. Coincident positions are welded so attribute (uv/normal)
  * seams collapse topologically while surviving wedges keep their own vertices; open borders are locked
- * to a polyline so silhouettes do not erode. Geometry-only: attribute drift at collapsed seam corners
- * is accepted (attribute-aware simplification is a later refinement).
+ * to a polyline so silhouettes do not erode. Geometry-only: a collapsed seam corner takes the surviving
+ * position's first wedge, attributes and all; ano_simplify_with_attributes keeps seams and charges
+ * attribute drift.
  */
 size_t ano_simplify(uint32_t* destination, const uint32_t* indices, size_t index_count,
                     const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride,
@@ -119,13 +120,74 @@ size_t ano_simplify(uint32_t* destination, const uint32_t* indices, size_t index
  *     survive, and a face may not rotate > 60deg from its original pass-0 normal (bounds cumulative
  *     drift across a concavity) — all gated by the same edge_len_factor > 0 and reproduced exactly
  *     (A/B baseline) at edge_len_factor <= 0.
- * All other parameters and the return contract match ano_simplify.
+ * All other parameters and the return contract match ano_simplify. This is ano_simplify_arena in pass
+ * order (ANO_SIMPLIFY_DETERMINISTIC) on a private scratch arena.
  */
 size_t ano_simplify_ex(uint32_t* destination, const uint32_t* indices, size_t index_count,
                        const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride,
                        size_t target_index_count, float target_error, float edge_len_factor,
                        float* out_result_error);
 
+struct ano_arena_t;
+
+/**
+ * ano_simplify_arena flag: collapse in passes (each pass a cheapest-first maximal matching over every
+ * vertex's best collapse, then a rebuild), which is what ano_simplify and ano_simplify_ex do, bit for bit.
+ * Without it collapses come one at a time off a priority queue that each collapse updates locally.
+ */
+#define ANO_SIMPLIFY_DETERMINISTIC 0x1u
+
+/**
+ * Upper bound on the scratch ano_simplify_with_attributes (attribute_count 0: ano_simplify_arena) takes
+ * from its arena for these counts and flags, every guard included. An arena with this much room left
+ * never falls back to a private one.
+ */
+size_t ano_simplify_scratch_size(size_t index_count, size_t vertex_count, size_t attribute_count, uint32_t flags);
+
+/**
+ * ano_simplify_ex with a choice of collapse order and of where its scratch comes from.
+ *
+ * flags: ANO_SIMPLIFY_DETERMINISTIC for the pass order, bit-identical to ano_simplify_ex. 0 for heap
+ *     order: each collapse is the cheapest left, judged by every guard against the mesh as it stands
+ *     then, and only the collapsed vertex's neighborhood is rescored. A different (repeatable) result:
+ *     typically as close to the target, at no more error, but slower per call than the pass order on
+ *     large meshes (anotest_meshoptimizer --bench).
+ * scratch (nullable): every scratch array is carved from it and rewound before return, so one arena
+ *     serves a stream of calls with no allocation. NULL, or one with less than
+ *     ano_simplify_scratch_size left, reserves a private arena for the call instead.
+ * All other parameters and the return contract match ano_simplify_ex.
+ */
+size_t ano_simplify_arena(uint32_t* destination, const uint32_t* indices, size_t index_count,
+                          const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride,
+                          size_t target_index_count, float target_error, float edge_len_factor,
+                          uint32_t flags, struct ano_arena_t* scratch, float* out_result_error);
+
+/**
+ * ano_simplify_arena with attribute-aware quadrics. Each collapse is charged for the attribute drift
+ * it causes as well as for the geometric error: every face fits its attributes as a linear field, and
+ * a wedge moved onto the survivor pays the area-weighted squared difference between that field and
+ * the attributes it lands on. Seams are kept: a collapsed wedge lands on the survivor's wedge nearest
+ * it in attributes, so each side of a uv or normal seam keeps its own vertices. On a smooth surface
+ * the cheap collapses are the ones shading does not notice, so a level reaches a lower count before
+ * seams or shading break.
+ *
+ * vertex_attributes (nullable): attribute_count floats per vertex, byte stride vertex_attributes_stride
+ *     (e.g. normal xyz then uv for an interleaved vertex).
+ * attribute_weights (nullable): one per attribute. An attribute difference of 1/weight costs as much as
+ *     a position error of one ano_simplify_scale, so a weight w holds that attribute to target_error / w.
+ *     0 ignores the attribute. NULL, or attribute_count 0, is ano_simplify_arena exactly.
+ * out_result_error (nullable): the achieved combined error, position and weighted attributes, in
+ *     object units.
+ * All other parameters and the return contract match ano_simplify_arena.
+ */
+size_t ano_simplify_with_attributes(uint32_t* destination, const uint32_t* indices, size_t index_count,
+                                    const float* vertex_positions, size_t vertex_count,
+                                    size_t vertex_positions_stride, const float* vertex_attributes,
+                                    size_t vertex_attributes_stride, const float* attribute_weights,
+                                    size_t attribute_count, size_t target_index_count, float target_error,
+                                    float edge_len_factor, uint32_t flags, struct ano_arena_t* scratch,
+                                    float* out_result_error);
+
 #ifdef __cplusplus
 }
 #endif
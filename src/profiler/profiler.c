@@ -0,0 +1,438 @@
+/* SPDX-FileCopyrightText: 2026 Anoptic Game Engine Authors
+ *
+ * SPDX-License-Identifier: LGPL-3.0 */
+/*  == Anoptic Game Engine v0.0000001 == */
+
+// Scoped profiler (anoptic_profiler.h). One lane per profiled thread, the logger's lanes mode with fixed
+// 16-byte slots: the owner stores the slot then publishes with one release store of `tail`, the flusher
+// converts head..tail to JSON and frees the range with one store of `head`. The producer caches the room
+// it last saw, so the shared `head` line is read once per lap, not per event.
+//
+// A begin is accepted only when the lane has room for it, its own end, and the end of every scope
+// already open. Ends therefore always fit and the trace never holds a begin without its end. A begin
+// that does not fit drops its scope and every scope nested in it (skipFrom).
+
+#include <anoptic_profiler.h>
+#include "threads/thread_lanes.h"
+#include <anoptic_filesystem.h>
+#include <anoptic_memory.h>
+#include <anoptic_threads.h>
+#include <anoptic_time.h>
+
+#include <mimalloc.h>
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#define PROF_LANES        64u               // profiled threads per session, later ones go unrecorded
+#define PROF_LANE_EVENTS  (1u << 15)        // slots per lane: 512 KiB, ~100 ms of a very busy thread
+#define PROF_FLUSH_US     4000u             // flusher period
+#define PROF_BUF          (64u * 1024u)     // JSON staging buffer
+#define PROF_LINE_MAX     256u              // worst-case JSON line, names clipped to fit
+
+_Static_assert((PROF_LANE_EVENTS & (PROF_LANE_EVENTS - 1)) == 0, "lane size is a power of two");
+
+// Slot kinds, in the top two bits of the tick. The clock is far from 2^62 on every platform.
+#define PROF_KIND_SHIFT   62
+#define PROF_TICK_MASK    ((1ull << PROF_KIND_SHIFT) - 1)
+enum { PROF_BEGIN = 0, PROF_END = 1, PROF_SPAN = 2 };   // a SPAN slot is followed by its end tick's slot
+
+typedef struct {
+    uint64_t    tick;       // ano_timestamp_ticks | kind << PROF_KIND_SHIFT
+    const char *name;       // literal, NULL on END and on a span's second slot
+} prof_event_t;
+_Static_assert(sizeof(prof_event_t) == 16, "one event is 16 bytes");
+
+typedef struct {
+    // Producer line: the owner's cursor and private nesting state.
+    _Alignas(ANO_THREAD_LINE) _Atomic uint64_t tail;
+    uint64_t              limit;        // head + PROF_LANE_EVENTS as last read, refreshed when short
+    uint32_t              depth;        // scopes open, recorded or not
+    uint32_t              skipFrom;     // depth of the outermost dropped scope, 0 when recording
+    _Atomic uint64_t      dropped;      // scopes dropped, owner-written, read by ano_profile_dropped
+    // Flusher line.
+    _Alignas(ANO_THREAD_LINE) _Atomic uint64_t head;
+    _Atomic uint32_t      tid;          // track id, fresh per acquisition
+    _Atomic bool          live;         // false once the owner exited, then adoptable once drained
+    _Atomic(const char *) name;         // ano_profile_thread_name
+    const char           *named;        // flusher-private: label already written for `tid`
+    uint32_t              namedTid;
+    prof_event_t         *ev;
+} prof_lane_t;
+
+static _Atomic uint32_t    g_nextTid;
+static _Thread_local prof_lane_t *t_lane;
+static _Thread_local uint32_t     t_gen;          // g_lanes.gen t_lane was cached under
+
+static anothread_mutex_t   g_flushMtx;     // one flush at a time, guards the file and staging buffer
+static ano_file           *g_file;
+static char                g_path[MAXPATH];
+static char               *g_buf;
+static size_t              g_blen;
+static uint64_t            g_t0;           // session origin tick, trace time 0
+static uint64_t            g_droppedDone;  // dropped counts of lanes freed at cleanup
+
+static anothread_t         g_flushThread;
+static atomic_bool         g_flushRun;
+
+
+/* Lanes */
+
+static void *lane_new(void)
+{
+    prof_lane_t *l = ano_aligned_malloc(sizeof *l, ANO_THREAD_LINE);
+    if (l == NULL)
+        return NULL;
+    memset(l, 0, sizeof *l);
+    l->ev = ano_aligned_malloc(PROF_LANE_EVENTS * sizeof(prof_event_t), 4096u);
+    if (l->ev == NULL) {
+        ano_aligned_free(l);
+        return NULL;
+    }
+    return l;
+}
+
+static void lane_free(void *p)
+{
+    prof_lane_t *l = p;
+    ano_aligned_free(l->ev);
+    ano_aligned_free(l);
+}
+
+static bool lane_drained(void *p)
+{
+    prof_lane_t *l = p;
+    return atomic_load_explicit(&l->head, memory_order_acquire)
+           == atomic_load_explicit(&l->tail, memory_order_relaxed);
+}
+
+// Fresh nesting state and track id for each acquisition.
+static void lane_adopt(void *p)
+{
+    prof_lane_t *l = p;
+    l->limit    = atomic_load_explicit(&l->head, memory_order_relaxed) + PROF_LANE_EVENTS;
+    l->depth    = 0;
+    l->skipFrom = 0;
+    atomic_store_explicit(&l->name, NULL, memory_order_relaxed);
+    atomic_store_explicit(&l->tid, atomic_fetch_add_explicit(&g_nextTid, 1, memory_order_relaxed),
+                          memory_order_relaxed);
+}
+
+// The table's `on` is the profiler's: set by init, cleared by cleanup, both through the gate.
+static void          *g_laneSlots[PROF_LANES];
+static thread_lanes_t g_lanes = {
+    .slots = g_laneSlots, .cap = PROF_LANES, .liveOffset = offsetof(prof_lane_t, live),
+    .make = lane_new, .drained = lane_drained, .adopt = lane_adopt,
+};
+
+// The calling thread's lane for this session, NULL (cached) while the profiler is off or the table is full.
+static prof_lane_t *lane_acquire(void)
+{
+    return t_lane = thread_lanes_acquire(&g_lanes, &t_gen);
+}
+
+static inline prof_lane_t *lane_get(void)
+{
+    return t_gen == atomic_load_explicit(&g_lanes.gen, memory_order_relaxed) ? t_lane : lane_acquire();
+}
+
+// True when n more slots fit behind the ends still owed to open scopes.
+static inline bool lane_room(prof_lane_t *l, uint64_t tail, uint32_t n)
+{
+    uint64_t need = tail + l->depth + n;
+    if (need <= l->limit)
+        return true;
+    l->limit = atomic_load_explicit(&l->head, memory_order_acquire) + PROF_LANE_EVENTS;
+    return need <= l->limit;
+}
+
+static inline void lane_drop(prof_lane_t *l)
+{
+    atomic_store_explicit(&l->dropped, atomic_load_explicit(&l->dropped, memory_order_relaxed) + 1,
+                          memory_order_relaxed);
+}
+
+static inline void lane_push(prof_lane_t *l, uint64_t tail, uint64_t tick, const char *name)
+{
+    prof_event_t *e = &l->ev[tail & (PROF_LANE_EVENTS - 1)];
+    e->tick = tick;
+    e->name = name;
+}
+
+
+/* Entry points */
+
+void ano_profile_begin(const char *name)
+{
+    prof_lane_t *l = lane_get();
+    if (l == NULL)
+        return;
+    uint64_t tick = ano_timestamp_ticks();
+    l->depth++;
+    if (l->skipFrom != 0)
+        return;
+    uint64_t t = atomic_load_explicit(&l->tail, memory_order_relaxed);
+    // depth already counts this scope, so one more slot covers its begin on top of every owed end.
+    if (!lane_room(l, t, 1)) {
+        l->skipFrom = l->depth;
+        lane_drop(l);
+        return;
+    }
+    lane_push(l, t, tick & PROF_TICK_MASK, name);
+    atomic_store_explicit(&l->tail, t + 1, memory_order_release);
+}
+
+void ano_profile_end(void)
+{
+    prof_lane_t *l = lane_get();
+    if (l == NULL || l->depth == 0)
+        return;
+    uint64_t tick = ano_timestamp_ticks();
+    if (l->skipFrom != 0) {
+        if (l->skipFrom == l->depth)
+            l->skipFrom = 0;
+        l->depth--;
+        return;
+    }
+    l->depth--;
+    uint64_t t = atomic_load_explicit(&l->tail, memory_order_relaxed);
+    lane_push(l, t, (tick & PROF_TICK_MASK) | ((uint64_t)PROF_END << PROF_KIND_SHIFT), NULL);
+    atomic_store_explicit(&l->tail, t + 1, memory_order_release);
+}
+
+void ano_profile_span(const char *name, uint64_t t0)
+{
+    prof_lane_t *l = lane_get();
+    if (l == NULL || l->skipFrom != 0)
+        return;
+    uint64_t tick = ano_timestamp_ticks();
+    uint64_t t = atomic_load_explicit(&l->tail, memory_order_relaxed);
+    if (!lane_room(l, t, 2)) {
+        lane_drop(l);
+        return;
+    }
+    lane_push(l, t,     (t0 & PROF_TICK_MASK) | ((uint64_t)PROF_SPAN << PROF_KIND_SHIFT), name);
+    lane_push(l, t + 1, tick & PROF_TICK_MASK, NULL);
+    atomic_store_explicit(&l->tail, t + 2, memory_order_release);   // both slots in one publish
+}
+
+void ano_profile_scope_end(const char *const *scope)
+{
+    (void)scope;
+    ano_profile_end();
+}
+
+void ano_profile_thread_name(const char *name)
+{
+    prof_lane_t *l = lane_get();
+    if (l != NULL)
+        atomic_store_explicit(&l->name, name, memory_order_release);
+}
+
+
+/* Flusher: lanes to Chrome trace JSON */
+
+static void buf_write(void)
+{
+    if (g_blen > 0 && g_file != NULL)
+        ano_fs_write(g_file, g_buf, g_blen);
+    g_blen = 0;
+}
+
+static void buf_line(const char *fmt, ...) __attribute__((format(printf, 1, 2)));
+static void buf_line(const char *fmt, ...)
+{
+    if (PROF_BUF - g_blen < PROF_LINE_MAX)
+        buf_write();
+    va_list ap;
+    va_start(ap, fmt);
+    int n = vsnprintf(g_buf + g_blen, PROF_LINE_MAX, fmt, ap);
+    va_end(ap);
+    if (n > 0)
+        g_blen += (size_t)n < PROF_LINE_MAX ? (size_t)n : PROF_LINE_MAX - 1;
+}
+
+// Copy name into out as a JSON string body: quotes, backslashes and control bytes are escaped, and the
+// result is clipped to fit a line.
+static const char *json_name(char out[96], const char *name)
+{
+    size_t k = 0;
+    for (const char *s = name; *s && k < 90; s++) {
+        unsigned char c = (unsigned char)*s;
+        if (c == '"' || c == '\\') { out[k++] = '\\'; out[k++] = (char)c; }
+        else out[k++] = c < 0x20 ? '?' : (char)c;
+    }
+    out[k] = '\0';
+    return out;
+}
+
+// Trace time: microseconds since init with nanosecond decimals, the Chrome JSON unit.
+static uint64_t trace_ns(uint64_t tick)
+{
+    return tick > g_t0 ? ano_ticks_to_ns(tick - g_t0) : 0;
+}
+
+#define US_FMT "%llu.%03llu"
+#define US_ARG(ns) (unsigned long long)((ns) / 1000u), (unsigned long long)((ns) % 1000u)
+
+static uint64_t flush_lane(prof_lane_t *l)
+{
+    uint64_t tail = atomic_load_explicit(&l->tail, memory_order_acquire);
+    uint64_t head = atomic_load_explicit(&l->head, memory_order_relaxed);
+    if (head == tail)
+        return 0;
+    uint32_t tid = atomic_load_explicit(&l->tid, memory_order_relaxed);
+    const char *label = atomic_load_explicit(&l->name, memory_order_acquire);
+    char nb[96];
+    if (label != NULL && (label != l->named || tid != l->namedTid)) {
+        buf_line("{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}},\n",
+                 tid, json_name(nb, label));
+        l->named    = label;
+        l->namedTid = tid;
+    }
+    uint64_t n = 0;
+    for (uint64_t i = head; i < tail; i++, n++) {
+        const prof_event_t *e = &l->ev[i & (PROF_LANE_EVENTS - 1)];
+        uint32_t kind = (uint32_t)(e->tick >> PROF_KIND_SHIFT);
+        uint64_t ns   = trace_ns(e->tick & PROF_TICK_MASK);
+        if (kind == PROF_BEGIN) {
+            buf_line("{\"ph\":\"B\",\"name\":\"%s\",\"ts\":" US_FMT ",\"pid\":1,\"tid\":%u},\n",
+                     json_name(nb, e->name), US_ARG(ns), tid);
+        } else if (kind == PROF_END) {
+            buf_line("{\"ph\":\"E\",\"ts\":" US_FMT ",\"pid\":1,\"tid\":%u},\n", US_ARG(ns), tid);
+        } else {
+            const prof_event_t *x = &l->ev[++i & (PROF_LANE_EVENTS - 1)];
+            uint64_t end = trace_ns(x->tick & PROF_TICK_MASK);
+            uint64_t dur = end > ns ? end - ns : 0;
+            buf_line("{\"ph\":\"X\",\"name\":\"%s\",\"ts\":" US_FMT ",\"dur\":" US_FMT ",\"pid\":1,\"tid\":%u},\n",
+                     json_name(nb, e->name), US_ARG(ns), US_ARG(dur), tid);
+        }
+    }
+    atomic_store_explicit(&l->head, tail, memory_order_release);
+    return n;
+}
+
+uint64_t ano_profile_flush(void)
+{
+    if (!atomic_load_explicit(&g_lanes.on, memory_order_acquire))
+        return 0;
+    ano_mutex_lock(&g_flushMtx);
+    uint64_t n = 0;
+    uint32_t nl = thread_lanes_count(&g_lanes);
+    for (uint32_t i = 0; i < nl; i++)
+        n += flush_lane(g_laneSlots[i]);
+    buf_write();
+    ano_mutex_unlock(&g_flushMtx);
+    return n;
+}
+
+static void *flusher_main(void *arg)
+{
+    (void)arg;
+    while (atomic_load_explicit(&g_flushRun, memory_order_relaxed)) {
+        ano_sleep(PROF_FLUSH_US);
+        ano_profile_flush();
+    }
+    return NULL;
+}
+
+
+/* Lifecycle */
+
+int ano_profile_init(void)
+{
+    if (atomic_load_explicit(&g_lanes.on, memory_order_relaxed))
+        return -1;
+    ano_fspath dir = ano_fs_logpath();
+    if (dir.length == 0)
+        return -1;
+    int pn = snprintf(g_path, sizeof g_path, "%s/%s_trace.json", dir.str, ano_fs_session_stamp());
+    if (pn <= 0 || pn >= (int)sizeof g_path)
+        return -1;
+    if ((g_buf = mi_malloc(PROF_BUF)) == NULL)
+        return -1;
+    if (ano_mutex_init(&g_flushMtx, NULL) != 0)
+        goto fail_buf;
+    if (thread_lanes_open(&g_lanes) != 0)
+        goto fail_flush;
+    if ((g_file = ano_fs_open_trunc(g_path)) == NULL)
+        goto fail_lanes;
+
+    g_t0 = ano_timestamp_ticks();
+    g_blen = 0;
+    g_droppedDone = 0;
+    atomic_store_explicit(&g_nextTid, 1, memory_order_relaxed);
+    buf_line("[\n{\"ph\":\"M\",\"name\":\"process_name\",\"pid\":1,\"args\":{\"name\":\"anoptic\"}},\n");
+
+    thread_lanes_gate(&g_lanes, true);
+    atomic_store_explicit(&g_flushRun, true, memory_order_relaxed);
+    if (ano_thread_create(&g_flushThread, NULL, flusher_main, NULL) != 0) {
+        atomic_store_explicit(&g_flushRun, false, memory_order_relaxed);
+        ano_profile_cleanup();
+        return -1;
+    }
+    return 0;
+
+fail_lanes:
+    thread_lanes_close(&g_lanes, lane_free);
+fail_flush:
+    ano_mutex_destroy(&g_flushMtx);
+fail_buf:
+    mi_free(g_buf);
+    g_buf = NULL;
+    return -1;
+}
+
+int ano_profile_cleanup(void)
+{
+    if (!atomic_load_explicit(&g_lanes.on, memory_order_acquire))
+        return -1;
+    if (atomic_exchange_explicit(&g_flushRun, false, memory_order_relaxed))
+        ano_thread_join(g_flushThread, NULL);
+    ano_profile_flush();
+    uint64_t dropped = ano_profile_dropped();
+
+    // Stop new acquires, then orphan every cached lane before the memory goes.
+    thread_lanes_gate(&g_lanes, false);
+
+    ano_mutex_lock(&g_flushMtx);
+    // The closing element carries no trailing comma. A trace cut short by a crash lacks it and the "]",
+    // which every Chrome JSON reader accepts.
+    buf_line("{\"ph\":\"M\",\"name\":\"process_labels\",\"pid\":1,\"args\":{\"labels\":\"dropped %llu\"}}\n]\n",
+             (unsigned long long)dropped);
+    buf_write();
+    ano_fs_close(g_file);
+    g_file = NULL;
+    ano_mutex_unlock(&g_flushMtx);
+
+    thread_lanes_close(&g_lanes, lane_free);
+    g_droppedDone = dropped;
+    ano_mutex_destroy(&g_flushMtx);
+    mi_free(g_buf);
+    g_buf = NULL;
+    return 0;
+}
+
+void ano_profile_scope_release(const int *initStatus)
+{
+    if (initStatus != NULL && *initStatus == 0)
+        ano_profile_cleanup();
+}
+
+uint64_t ano_profile_dropped(void)
+{
+    if (!atomic_load_explicit(&g_lanes.on, memory_order_acquire))
+        return g_droppedDone;
+    uint64_t n = 0;
+    uint32_t nl = thread_lanes_count(&g_lanes);
+    for (uint32_t i = 0; i < nl; i++)
+        n += atomic_load_explicit(&((prof_lane_t *)g_laneSlots[i])->dropped, memory_order_relaxed);
+    return n;
+}
+
+const char *ano_profile_path(void)
+{
+    return atomic_load_explicit(&g_lanes.on, memory_order_acquire) ? g_path : NULL;
+}
@@ -5,9 +5,8 @@
 #include <string.h>
 #include <anoptic_memory.h>
 #include <anoptic_log.h>
-
-#define CGLTF_IMPLEMENTATION
-#include <cgltf.h>
+#include <anoptic_filesystem.h>
+#include "mesh/ano_meshcook_gltf.h"
 
 extern GpuAllocator stagingAllocator;
 extern RendererState rendererState;
@@ -39,10 +38,38 @@ ModelAsset* parseGltf(VulkanContext* ctx, const char* fileName)
     ModelAsset* asset = calloc(1, sizeof(ModelAsset));
     strncpy(asset->name, fileName, 63);
 
-    // 1. Upload Geometry & Map to Asset Meshes
+    // 1. Upload Geometry & Map to Asset Meshes. A fresh "<file>.anomesh" (tools/anomesh_cook.c)
+    // holds every primitive's LOD chain already cooked; next is the derived-data cache, keyed by
+    // the source bytes and LOD config. Only on a miss are the primitives cooked here, all of them
+    // at once across the job pool, and the result stored so the next load of the unchanged asset
+    // maps it instead. The uploads that follow stay on this thread, in order.
+    AnoLodConfig lodCfg = ano_lod_config_default(ANO_DEFAULT_LOD_COUNT);
+    char cookedPath[MAXPATH + 8];
+    ano_mesh_file_t cooked = {0};
+    ano_fs_cache_blob cachedBlob = {0};
+    bool haveCooked = snprintf(cookedPath, sizeof cookedPath, "%s.anomesh", fileName) < (int)sizeof cookedPath &&
+                      ano_mesh_gltf_open_cooked(&cooked, cookedPath, data, &lodCfg);
+    ano_fs_cache_key cacheKey = {0};
+    if (haveCooked) {
+        ano_debug_log(ANO_INFO, "Using cooked geometry %s", cookedPath);
+    } else {
+        cacheKey = ano_mesh_gltf_cache_key(data, &lodCfg);
+        haveCooked = ano_mesh_gltf_open_cached(&cooked, &cachedBlob, &cacheKey, data);
+        if (haveCooked)
+            ano_debug_log(ANO_INFO, "Using cached geometry for %s", fileName);
+    }
+
+    // Chains cooked here outlive their upload until they are written to the cache. NULL (no
+    // memory for the set) still cooks and uploads one primitive at a time, uncached.
+    uint32_t primitiveCount = ano_mesh_gltf_primitive_count(data);
+    ano_mesh_chain_t* freshChains = haveCooked ? NULL : calloc(primitiveCount + 1u, sizeof(ano_mesh_chain_t));
+    if (freshChains)
+        ano_mesh_gltf_cook_chains(data, &lodCfg, freshChains);
+
     asset->meshCount = data->meshes_count;
     asset->meshes = calloc(asset->meshCount, sizeof(ModelMesh));
     
+    uint32_t chainIndex = 0;
     for (size_t m = 0; m < data->meshes_count; ++m) {
         cgltf_mesh* cgMesh = &data->meshes[m];
         ModelMesh* outMesh = &asset->meshes[m];
@@ -50,71 +77,53 @@ ModelAsset* parseGltf(VulkanContext* ctx, const char* fileName)
         outMesh->primitiveCount = cgMesh->primitives_count;
         outMesh->primitives = calloc(outMesh->primitiveCount, sizeof(ModelPrimitive));
         
-        for (size_t p = 0; p < cgMesh->primitives_count; ++p) {
-            cgltf_primitive* prim = &cgMesh->primitives[p];
-            
-            // Find accessors
-            cgltf_accessor* posAccessor = NULL;
-            cgltf_accessor* normAccessor = NULL;
-            cgltf_accessor* texAccessor = NULL;
-            
-            for (size_t a = 0; a < prim->attributes_count; ++a) {
-                if (prim->attributes[a].type == cgltf_attribute_type_position) {
-                    posAccessor = prim->attributes[a].data;
-                } else if (prim->attributes[a].type == cgltf_attribute_type_normal) {
-                    normAccessor = prim->attributes[a].data;
-                } else if (prim->attributes[a].type == cgltf_attribute_type_texcoord) {
-                    texAccessor = prim->attributes[a].data;
-                }
-            }
-            
-            if (!posAccessor || !prim->indices) {
-                ano_log(ANO_WARN, "Warning: Primitive missing positions or indices. Skipping.");
-                continue;
-            }
-            
-            uint32_t vertexCount = posAccessor->count;
-            Vertex* vertices = calloc(vertexCount, sizeof(Vertex));
-            
-            for (uint32_t v = 0; v < vertexCount; ++v) {
-                cgltf_accessor_read_float(posAccessor, v, &vertices[v].position.v[0], 3);
-                if (normAccessor) {
-                    cgltf_accessor_read_float(normAccessor, v, &vertices[v].normal.v[0], 3);
-                } else {
-                    vertices[v].normal.v[0] = 0.0f;
-                    vertices[v].normal.v[1] = 1.0f;
-                    vertices[v].normal.v[2] = 0.0f;
-                }
-                if (texAccessor) {
-                    cgltf_accessor_read_float(texAccessor, v, &vertices[v].texCoord.v[0], 2);
+        for (size_t p = 0; p < cgMesh->primitives_count; ++p, ++chainIndex) {
+            ano_mesh_chain_t localChain = {0};
+            ano_mesh_chain_t* chain = freshChains && chainIndex < primitiveCount ? &freshChains[chainIndex] : &localChain;
+            if (haveCooked) {
+                ano_mesh_file_chain(&cooked, chainIndex, chain);
+            } else if (chain == &localChain) {
+                ano_cook_vertex_t* vertices;
+                uint32_t* indices;
+                uint32_t vertexCount, indexCount;
+                if (!ano_mesh_gltf_extract(&cgMesh->primitives[p], &vertices, &vertexCount, &indices, &indexCount)) {
+                    ano_log(ANO_WARN, "Warning: Primitive missing positions or indices. Skipping.");
+                    continue;
                 }
+                ano_mesh_cook_chain(chain, vertices, vertexCount, indices, indexCount, &lodCfg);
+                ano_mesh_gltf_release(vertices, indices);
             }
-            
-            uint32_t indexCount = prim->indices->count;
-            uint32_t* indices = calloc(indexCount, sizeof(uint32_t));
-            for (uint32_t i = 0; i < indexCount; ++i) {
-                indices[i] = (uint32_t)cgltf_accessor_read_index(prim->indices, i);
+            if (chain->level_count == 0) {
+                ano_mesh_chain_free(chain);
+                continue;  // cooked empty: the primitive had no usable geometry
             }
-            
+
             // Upload as an LOD chain; geometryPoolIndex is the chain base.
-            AnoLodConfig lodCfg = ano_lod_config_default(ANO_DEFAULT_LOD_COUNT);
             uint32_t lodBase = 0u, lodProduced = 0u;
-            geometry_pool_upload_chain(
+            geometry_pool_upload_cooked(
                 &rendererState.globalGeometryPool,
                 &stagingAllocator,
                 ctx->device,
                 ctx->queueFamilyIndices.transferFamily,
                 ctx->transferQueue,
-                vertices, vertexCount,
-                indices, indexCount,
-                &lodCfg, &lodBase, &lodProduced
+                chain, &lodBase, &lodProduced
             );
             outMesh->primitives[p].geometryPoolIndex = lodBase;
-            
-            free(vertices);
-            free(indices);
+            if (chain == &localChain)
+                ano_mesh_chain_free(chain);
         }
     }
+    if (freshChains) {
+        // Same source_hash as a cooked .anomesh on disk, so a cached entry extracted to a file still validates.
+        uint64_t sourceHash = ano_mesh_gltf_source_hash(data);
+        if (ano_mesh_file_put_cache(&cacheKey, freshChains, primitiveCount, sourceHash, ano_lod_config_hash(&lodCfg)) == 0)
+            ano_debug_log(ANO_INFO, "Cached cooked geometry for %s", fileName);
+        for (uint32_t c = 0; c < primitiveCount; ++c)
+            ano_mesh_chain_free(&freshChains[c]);
+        free(freshChains);
+    }
+    ano_mesh_file_unmap(&cooked);
+    ano_fs_cache_release(&cachedBlob);
 
     // Identify PBR features globally supported by the active pipelines
     PbrFeatureFlags activeFeatures = ano_vk_get_active_pipelines_supported_features(&rendererState);
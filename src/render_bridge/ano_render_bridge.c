@@ -3,11 +3,11 @@
  * SPDX-License-Identifier: LGPL-3.0 */
 /*  == Anoptic Game Engine v0.0000001 == */
 
-/* Logic<->render bridge: ring storage alloc/teardown, plus the producer
- * endpoint (ano_render_submit). The hot-path push/pop and the in-src endpoints
- * stay inlined in the private render_bridge.h, while only the cold init/destroy and
- * the public (non-inline) submit live here. Platform-agnostic and GPU-free,
- * part of anoptic_core. Public contract: include/anoptic_render.h. */
+/* Logic<->render bridge: ring setup/teardown, plus the producer endpoint
+ * (ano_render_submit). The rings themselves are AnoSpscRing (anoptic_collections.h).
+ * The in-src endpoints stay inlined in the private render_bridge.h, while only the
+ * cold init/destroy and the public (non-inline) submit live here. Platform-agnostic
+ * and GPU-free, part of anoptic_core. Public contract: include/anoptic_render.h. */
 
 #include "render_bridge.h"
 
@@ -16,50 +16,11 @@
 
 #include <anoptic_log.h>
 
+ano_mem_tag_t ano_render_block_mem = ANO_MEM_TAG("bridge");
+
 // Guard the events-ring element size (copied per push/pop, sized capacity * this). Held at 32 B.
 _Static_assert(sizeof(RenderEvent) <= 32u, "RenderEvent grew past 32 bytes; revisit the events ring");
 
-// Smallest power of two >= v, floor of 2. Returns 0 on overflow (v > 2^31).
-static uint32_t next_pow2_u32(uint32_t v)
-{
-    if (v < 2u) return 2u;
-    v--;
-    v |= v >> 1; v |= v >> 2; v |= v >> 4; v |= v >> 8; v |= v >> 16;
-    return v + 1u; // wraps to 0 if v was > 2^31
-}
-
-bool ano_spsc_init(AnoSpscRing *ring, mi_heap_t *heap, uint32_t capacity_pow2, uint32_t stride)
-{
-    if (!ring || !heap || stride == 0u) return false;
-
-    uint32_t cap = next_pow2_u32(capacity_pow2);
-    if (cap == 0u) return false;                       // capacity overflow
-    if ((size_t)cap > SIZE_MAX / stride) return false; // cap*stride overflow
-
-    uint8_t *buffer = mi_heap_calloc(heap, cap, stride);
-    if (!buffer) return false;
-
-    atomic_init(&ring->tail, 0u);
-    atomic_init(&ring->head, 0u);
-    ring->mask   = cap - 1u;
-    ring->stride = stride;
-    ring->buffer = buffer;
-    return true;
-}
-
-void ano_spsc_destroy(AnoSpscRing *ring)
-{
-    if (!ring) return;
-    if (ring->buffer) {
-        mi_free(ring->buffer);
-        ring->buffer = NULL;
-    }
-    ring->mask   = 0u;
-    ring->stride = 0u;
-    atomic_store_explicit(&ring->head, 0u, memory_order_relaxed);
-    atomic_store_explicit(&ring->tail, 0u, memory_order_relaxed);
-}
-
 bool ano_render_bridge_init(AnoRenderBridge *bridge, mi_heap_t *heap,
                             uint32_t cmd_capacity_pow2, uint32_t evt_capacity_pow2)
 {
@@ -139,7 +100,7 @@ bool ano_render_text_set(AnoRenderBridge *bridge, uint32_t text_id,
     if (count > ANO_RENDER_TEXT_MAX)
         count = ANO_RENDER_TEXT_MAX; // clamp to the region
     size_t bytes = sizeof(RenderTextBlock) + (size_t)count * sizeof(AnoGlyphInstance);
-    char *blk = mi_malloc(bytes);
+    char *blk = ano_tmalloc(&ano_render_block_mem, bytes);
     if (blk == NULL)
         return false;
     RenderTextBlock *b = (RenderTextBlock *)blk;
@@ -149,7 +110,7 @@ bool ano_render_text_set(AnoRenderBridge *bridge, uint32_t text_id,
     b->instances = inst;
     RenderCommand c = { .kind = RCMD_TEXT_SET, .text_id = text_id, .text = b, .bulk_owned = true };
     if (!ano_spsc_push(&bridge->commands, &c)) {
-        mi_free(blk);
+        ano_tfree(&ano_render_block_mem, blk);
         return false;
     }
     return true;
@@ -215,13 +176,13 @@ bool ano_render_ui_set(AnoRenderBridge *bridge, uint32_t ui_id, uint32_t layer,
         || ui->paintCount > ANO_RENDER_UI_MAX_PAINTS || ui->stopCount > ANO_RENDER_UI_MAX_STOPS
         || ui->curveCount > ANO_RENDER_UI_MAX_CURVES
         || glyphCount > ANO_RENDER_UI_MAX_GLYPHS || (glyphCount > 0u && glyphs == NULL)) {
-        ano_log(ANO_WARN, "UI bridge: ui_id %u dropped (per-block caps or bad glyph pair).", ui_id);
+        ano_log_ratelimit(ANO_WARN, 4, "UI bridge: ui_id %u dropped (per-block caps or bad glyph pair).", ui_id);
         return true;
     }
     for (uint32_t i = 0; i < ui->primCount; i++) {
         if (!ui_prim_valid(&ui->prims[i], ui->clipCount, ui->paintCount, glyphCount,
                            ui->curves, ui->curveCount)) {
-            ano_log(ANO_WARN, "UI bridge: ui_id %u dropped (prim %u invalid).", ui_id, i);
+            ano_log_ratelimit(ANO_WARN, 4, "UI bridge: ui_id %u dropped (prim %u invalid).", ui_id, i);
             return true;
         }
     }
@@ -231,7 +192,8 @@ bool ano_render_ui_set(AnoRenderBridge *bridge, uint32_t ui_id, uint32_t layer,
     size_t stopB = (size_t)ui->stopCount * sizeof(AnoUiStop);
     size_t curveB = (size_t)ui->curveCount * sizeof(uint32_t);
     size_t glyphB = (size_t)glyphCount * sizeof(AnoGlyphInstance);
-    char *blk = mi_malloc(sizeof(RenderUiBlock) + primB + clipB + paintB + stopB + curveB + glyphB);
+    char *blk = ano_tmalloc(&ano_render_block_mem,
+                            sizeof(RenderUiBlock) + primB + clipB + paintB + stopB + curveB + glyphB);
     if (blk == NULL)
         return false;
     RenderUiBlock *b = (RenderUiBlock *)blk;
@@ -265,7 +227,7 @@ bool ano_render_ui_set(AnoRenderBridge *bridge, uint32_t ui_id, uint32_t layer,
     if (glyphB) memcpy(at, glyphs, glyphB);
     RenderCommand c = { .kind = RCMD_UI_SET, .ui_id = ui_id, .ui = b, .bulk_owned = true };
     if (!ano_spsc_push(&bridge->commands, &c)) {
-        mi_free(blk);
+        ano_tfree(&ano_render_block_mem, blk);
         return false;
     }
     return true;
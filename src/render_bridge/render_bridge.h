@@ -35,6 +35,7 @@
 #include <stdatomic.h>
 #include <mimalloc.h>
 #include <anoptic_memory.h> // ANO_CACHE_LINE / ANO_THREAD_LINE
+#include <anoptic_collections.h> // AnoSpscRing
 #include <anoptic_math.h>
 #include <anoptic_render.h> // command protocol + opaque AnoRenderBridge + ano_render_submit
 
@@ -74,67 +75,6 @@ typedef struct DisplayState
     uint32_t dirty;              // RenderDirtyBits accumulated this tick
 } DisplayState;
 
-// ---------------------------------------------------------------------------
-// Bounded SPSC ring
-// ---------------------------------------------------------------------------
-
-// Single-producer/single-consumer bounded ring over fixed-size POD elements.
-// Lock-free and wait-free both ends, capacity a power of two so index wrap is a mask.
-// The producer owns `tail`, the consumer owns `head`. Each reads the other with
-// acquire and publishes its own with release.
-//
-// tail and head sit on separate ANO_THREAD_LINE regions to avoid false sharing.
-// ANO_THREAD_LINE (anoptic_memory.h) is the 128-byte isolation distance. A member
-// carries _Alignas(ANO_THREAD_LINE) so the whole struct inherits it. A HEAP owner
-// must request that alignment (e.g. mi_heap_malloc_aligned) for the separation to hold.
-//
-// Migrate to anoptic_collections.h when the generic lock-free collections land.
-typedef struct AnoSpscRing
-{
-    _Alignas(ANO_THREAD_LINE) _Atomic uint32_t tail; // producer-owned cursor: next index to write
-    _Alignas(ANO_THREAD_LINE) _Atomic uint32_t head; // consumer-owned cursor: next index to read
-    _Alignas(ANO_THREAD_LINE) uint32_t mask;         // capacity - 1 (immutable after init)
-    uint32_t                          stride;       // element size in bytes
-    uint8_t                          *buffer;       // capacity * stride bytes
-} AnoSpscRing;
-
-// in:  ring, heap, capacity_pow2 (rounded up to a power of two, >= 2), stride (> 0)
-// out: true on success; false on bad args or allocation failure
-bool ano_spsc_init(AnoSpscRing *ring, mi_heap_t *heap, uint32_t capacity_pow2, uint32_t stride);
-
-// Releases the ring buffer. Does not release the backing heap.
-void ano_spsc_destroy(AnoSpscRing *ring);
-
-// PRODUCER only. Copies `stride` bytes from `elem` into the ring.
-// out: false if the ring is full (caller decides: drop, spin, or grow upstream).
-static inline bool ano_spsc_push(AnoSpscRing *ring, const void *elem)
-{
-    uint32_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
-    uint32_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
-    if ((tail - head) > ring->mask) // (tail - head) == capacity means full
-        return false;
-    uint8_t *slot = ring->buffer + (size_t)(tail & ring->mask) * ring->stride;
-    for (uint32_t i = 0; i < ring->stride; ++i)
-        slot[i] = ((const uint8_t *)elem)[i];
-    atomic_store_explicit(&ring->tail, tail + 1u, memory_order_release);
-    return true;
-}
-
-// CONSUMER only. Copies the next element into `out` (>= stride bytes).
-// out: false if the ring is empty.
-static inline bool ano_spsc_pop(AnoSpscRing *ring, void *out)
-{
-    uint32_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
-    uint32_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
-    if (head == tail) // empty
-        return false;
-    const uint8_t *slot = ring->buffer + (size_t)(head & ring->mask) * ring->stride;
-    for (uint32_t i = 0; i < ring->stride; ++i)
-        ((uint8_t *)out)[i] = slot[i];
-    atomic_store_explicit(&ring->head, head + 1u, memory_order_release);
-    return true;
-}
-
 // ---------------------------------------------------------------------------
 // Lock-free latest-wins seqlock (epoch publication)
 // ---------------------------------------------------------------------------
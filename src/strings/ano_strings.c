@@ -11,6 +11,8 @@
 #include <stdarg.h>
 #include <stdio.h>
 
+ano_mem_tag_t g_strMem = ANO_MEM_TAG("strings");
+
 anostr_t anostr_from(mi_heap_t *heap, const void *bytes, size_t len)
 {
     if (bytes == NULL || len > UINT32_MAX)
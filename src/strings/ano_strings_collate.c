@@ -12,10 +12,14 @@
 // Sort builds a u64 collate-prefix key per string (first four primaries, ASCII via a flat
 // one-CE table), a stable LSD radix sorts the (key, index) records, key-equal runs restream
 // (streaming collate when small, full keys plus memcmp when large). Bytes read once.
+// The _mt sorts run the same steps in slices across threads, with the same result.
+// Interned symbols keep their full keys in the table, so sym_sort's ties are pure memcmp.
 
 #include <stdlib.h>
 
+#include "anoptic_jobs.h"
 #include "anoptic_strings_utf.h"
+#include "anoptic_threads.h"
 
 #include "strings/ano_collate_tables.h"
 #include "strings/ano_strings_internal.h"
@@ -206,7 +210,7 @@ static void kb_bytes(key_buf_t *kb, const void *src, size_t n)
         size_t cap = kb->cap ? kb->cap : 256;
         while (cap < kb->n + n)
             cap *= 2;
-        uint8_t *fresh = mi_realloc(kb->p, cap);
+        uint8_t *fresh = ano_trealloc(&g_strMem, kb->p, cap);
         if (fresh == NULL) {
             kb->oom = true;
             return;
@@ -252,12 +256,25 @@ anostr_t anostr_collate_key(mi_heap_t *heap, anostr_t s)
     key_buf_t kb = {0}, l2 = {0}, l3 = {0};
     collate_key_emit(&kb, &l2, &l3, s);
     anostr_t out = kb.oom ? anostr_empty() : anostr_from(heap, kb.p, kb.n);
-    mi_free(kb.p);
-    mi_free(l2.p);
-    mi_free(l3.p);
+    ano_tfree(&g_strMem, kb.p);
+    ano_tfree(&g_strMem, l2.p);
+    ano_tfree(&g_strMem, l3.p);
     return out;
 }
 
+uint64_t anostr_collate_tables_id_(void)
+{
+    // Every shipped script, an accent, case, digits and punctuation.
+    static const char probe[] = "A\xC3\xA4 z-9 \xD1\x91 \xCE\xBE \xE1\x9A\xA0 \xE3\x81\x8B \xE6\xBC\xA2";
+    key_buf_t kb = {0}, l2 = {0}, l3 = {0};
+    collate_key_emit(&kb, &l2, &l3, anostr_view(probe, sizeof probe - 1));
+    uint64_t id = kb.oom ? 0 : anostr_hash(anostr_view((const char *)kb.p, kb.n));
+    ano_tfree(&g_strMem, kb.p);
+    ano_tfree(&g_strMem, l2.p);
+    ano_tfree(&g_strMem, l3.p);
+    return id;
+}
+
 // The sort: (key, index) records, stable LSD radix, key-equal runs settled by tie handlers.
 
 typedef struct sort_rec_t {
@@ -377,7 +394,7 @@ static int tie_view_cmp_(const void *a, const void *b)
 // memcmp settles the run. False on allocation failure.
 static bool tie_bulk(sort_rec_t *r, size_t n, rec_str_fn_t str_of, const void *ctx)
 {
-    tie_view_t *views = mi_malloc(n * sizeof *views);
+    tie_view_t *views = ano_tmalloc(&g_strMem, n * sizeof *views);
     if (views == NULL)
         return false;
 
@@ -387,11 +404,11 @@ static bool tie_bulk(sort_rec_t *r, size_t n, rec_str_fn_t str_of, const void *c
         views[i].klen = kb.n;   // running end, converted to a length below
         views[i].idx = r[i].idx;
     }
-    mi_free(l2.p);
-    mi_free(l3.p);
+    ano_tfree(&g_strMem, l2.p);
+    ano_tfree(&g_strMem, l3.p);
     if (kb.oom) {
-        mi_free(kb.p);
-        mi_free(views);
+        ano_tfree(&g_strMem, kb.p);
+        ano_tfree(&g_strMem, views);
         return false;
     }
     size_t off = 0;
@@ -406,8 +423,8 @@ static bool tie_bulk(sort_rec_t *r, size_t n, rec_str_fn_t str_of, const void *c
     for (size_t i = 0; i < n; i++)
         r[i].idx = views[i].idx;    // keys equal across the run, only idx moves
 
-    mi_free(kb.p);
-    mi_free(views);
+    ano_tfree(&g_strMem, kb.p);
+    ano_tfree(&g_strMem, views);
     return true;
 }
 
@@ -452,13 +469,13 @@ static void tie_msd(sort_rec_t *r, size_t n, uint32_t skip, rec_str_fn_t str_of,
     if (n <= 48) {
         sort_recs_insertion(r, n);
     } else {
-        sort_rec_t *tmp = mi_malloc(n * sizeof *tmp);
+        sort_rec_t *tmp = ano_tmalloc(&g_strMem, n * sizeof *tmp);
         if (tmp == NULL) {
             tie_leaf(r, n, str_of, ctx);
             return;
         }
         sort_recs(r, tmp, n);
-        mi_free(tmp);
+        ano_tfree(&g_strMem, tmp);
     }
 
     for (size_t lo = 0; lo < n; ) {
@@ -538,7 +555,7 @@ void anostr_sort(anostr_t *items, size_t count)
 {
     if (items == NULL || count < 2)
         return;
-    sort_rec_t *recs = count <= UINT32_MAX ? mi_malloc(2 * count * sizeof *recs) : NULL;
+    sort_rec_t *recs = count <= UINT32_MAX ? ano_tmalloc(&g_strMem, 2 * count * sizeof *recs) : NULL;
     if (recs == NULL) {     // no scratch: correct, slower
         qsort(items, count, sizeof items[0], collate_qsort);
         return;
@@ -554,7 +571,7 @@ void anostr_sort(anostr_t *items, size_t count)
             gather[i] = items[recs[i].idx];
         memcpy(items, gather, count * sizeof items[0]);
     }
-    mi_free(recs);
+    ano_tfree(&g_strMem, recs);
 }
 
 void anostr_sort_idx(const anostr_t *items, size_t count, uint32_t *order)
@@ -566,7 +583,7 @@ void anostr_sort_idx(const anostr_t *items, size_t count, uint32_t *order)
     if (items == NULL || count < 2 || count > UINT32_MAX)
         return;
 
-    sort_rec_t *recs = mi_malloc(2 * count * sizeof *recs);
+    sort_rec_t *recs = ano_tmalloc(&g_strMem, 2 * count * sizeof *recs);
     if (recs == NULL) {
         fb_items_ = items;
         qsort(order, count, sizeof order[0], fb_order_cmp_);
@@ -578,34 +595,440 @@ void anostr_sort_idx(const anostr_t *items, size_t count, uint32_t *order)
     if (!collate_sort_core(recs, recs + count, count, rec_str_items_, items))
         for (size_t i = 0; i < count; i++)
             order[i] = recs[i].idx;
-    mi_free(recs);
+    ano_tfree(&g_strMem, recs);
+}
+
+// The parallel sort: the same stable radix and tie handling, split into fork-join rounds. Each lane
+// owns a contiguous slice of the records; a round runs every lane once and returns when all are done.
+//   keys:    prefix keys, per-lane histograms of all eight digits, and a presorted check;
+//   count:   per-lane histogram of the next digit (the first pass reuses the keys round's);
+//   scatter: each lane writes its slice past every earlier lane's share of each bucket, so the
+//            scatter stays stable;
+//   finish:  tie resolution over the key-equal runs that start in the lane's cut, then the gather
+//            (or order write) of the same cut.
+// Rounds run as pool jobs, or on a crew of the caller's own threads held between two barriers.
+
+enum {
+    SORT_MT_MIN   = 1 << 16,    // below this, one thread wins
+    SORT_MT_LANES = 64,
+};
+
+typedef struct par_sort_t par_sort_t;
+typedef void (*lane_fn_t)(par_sort_t *p, uint32_t lane);
+
+typedef struct {
+    uint32_t    hist8[8][256];  // keys round: every digit of the lane's slice
+    uint32_t    pos[256];       // the current pass: counts, then scatter offsets
+    size_t      cut;            // finish round: first record this lane settles
+    bool        unsorted;
+    uint32_t    index;
+    par_sort_t *p;
+    anothread_t thread;
+} sort_lane_t;
+
+struct par_sort_t {
+    const anostr_t     *items;
+    size_t              n;
+    uint32_t            lanes;
+    int                 digit;
+    sort_rec_t         *src, *dst;      // radix ping-pong, src holds the current order
+    anostr_t           *gather;         // anostr_sort_mt
+    uint32_t           *order;          // anostr_sort_idx_mt
+    sort_lane_t        *lane;
+    lane_fn_t           fn;
+    bool                crew;
+    _Atomic bool        go;             // crew: barriers are up
+    anothread_barrier_t start, done;
+};
+
+static inline size_t lane_lo(const par_sort_t *p, uint32_t lane)
+{
+    return (size_t)((uint64_t)p->n * lane / p->lanes);
+}
+
+static void lane_keys(par_sort_t *p, uint32_t lane)
+{
+    sort_lane_t *l = &p->lane[lane];
+    size_t lo = lane_lo(p, lane), hi = lane_lo(p, lane + 1u);
+    memset(l->hist8, 0, sizeof l->hist8);
+    bool unsorted = false;
+    anostr_t prevStr = lo > 0 ? p->items[lo - 1u] : anostr_empty();
+    uint64_t prevKey = lo > 0 ? anostr_collate_prefix(prevStr) : 0;
+    for (size_t i = lo; i < hi; i++) {
+        anostr_t s = p->items[i];
+        uint64_t k = anostr_collate_prefix(s);
+        p->src[i] = (sort_rec_t){ k, (uint32_t)i, 0 };
+        for (int d = 0; d < 8; d++)
+            l->hist8[d][(k >> (d * 8)) & 0xFFu]++;
+        if (p->order != NULL)
+            p->order[i] = (uint32_t)i;
+        if (!unsorted && i > 0)     // recs_presorted, a slice at a time
+            unsorted = prevKey > k || (prevKey == k && anostr_collate(prevStr, s) > 0);
+        prevStr = s;
+        prevKey = k;
+    }
+    l->unsorted = unsorted;
+}
+
+static void lane_count(par_sort_t *p, uint32_t lane)
+{
+    uint32_t *hist = p->lane[lane].pos;
+    size_t lo = lane_lo(p, lane), hi = lane_lo(p, lane + 1u);
+    memset(hist, 0, sizeof p->lane[lane].pos);
+    for (size_t i = lo; i < hi; i++)
+        hist[(p->src[i].key >> (p->digit * 8)) & 0xFFu]++;
+}
+
+static void lane_scatter(par_sort_t *p, uint32_t lane)
+{
+    uint32_t *pos = p->lane[lane].pos;
+    size_t lo = lane_lo(p, lane), hi = lane_lo(p, lane + 1u);
+    for (size_t i = lo; i < hi; i++)
+        p->dst[pos[(p->src[i].key >> (p->digit * 8)) & 0xFFu]++] = p->src[i];
+}
+
+static void lane_finish(par_sort_t *p, uint32_t lane)
+{
+    size_t lo = p->lane[lane].cut;
+    size_t hi = lane + 1u < p->lanes ? p->lane[lane + 1u].cut : p->n;
+    resolve_ties(p->src + lo, hi - lo, rec_str_items_, p->items);
+    if (p->order != NULL) {
+        for (size_t i = lo; i < hi; i++)
+            p->order[i] = p->src[i].idx;
+    } else {
+        for (size_t i = lo; i < hi; i++)
+            p->gather[i] = p->items[p->src[i].idx];
+    }
+}
+
+static void lane_copy(par_sort_t *p, uint32_t lane)
+{
+    size_t lo = lane_lo(p, lane), hi = lane_lo(p, lane + 1u);
+    memcpy((anostr_t *)p->items + lo, p->gather + lo, (hi - lo) * sizeof p->gather[0]);
+}
+
+static void lane_job(void *arg)
+{
+    sort_lane_t *l = arg;
+    l->p->fn(l->p, l->index);
+}
+
+static void *crew_main(void *arg)
+{
+    sort_lane_t *l = arg;
+    par_sort_t  *p = l->p;
+    while (!atomic_load_explicit(&p->go, memory_order_acquire))
+        ano_thread_yield();
+    for (;;) {
+        ano_thread_barrier_wait(&p->start);
+        lane_fn_t fn = p->fn;
+        if (fn == NULL)
+            return NULL;
+        fn(p, l->index);
+        ano_thread_barrier_wait(&p->done);
+    }
+}
+
+// Runs fn on every lane. The calling thread takes lane 0, or helps the pool while it waits.
+static void par_round(par_sort_t *p, lane_fn_t fn)
+{
+    p->fn = fn;
+    if (p->crew) {
+        ano_thread_barrier_wait(&p->start);
+        fn(p, 0);
+        ano_thread_barrier_wait(&p->done);
+        return;
+    }
+    AnoJobDecl jobs[SORT_MT_LANES];
+    for (uint32_t i = 0; i < p->lanes; i++)
+        jobs[i] = (AnoJobDecl){ lane_job, &p->lane[i] };
+    AnoJobCounter c = {0};
+    ano_jobs_run(jobs, p->lanes, &c);
+    ano_jobs_wait(&c);
+}
+
+// Spawns up to lanes - 1 threads and runs with as many as started. Barriers go up only once the
+// count is known, so the threads wait on p->go until then. False when none started.
+static bool crew_start(par_sort_t *p)
+{
+    uint32_t started = 1;
+    while (started < p->lanes
+           && ano_thread_create(&p->lane[started].thread, NULL, crew_main, &p->lane[started]) == 0)
+        started++;
+    p->lanes = started;
+    if (started < 2)
+        return false;
+    ano_thread_barrier_init(&p->start, NULL, started);
+    ano_thread_barrier_init(&p->done, NULL, started);
+    atomic_store_explicit(&p->go, true, memory_order_release);
+    return true;
+}
+
+static void crew_stop(par_sort_t *p)
+{
+    p->fn = NULL;
+    ano_thread_barrier_wait(&p->start);
+    for (uint32_t i = 1; i < p->lanes; i++)
+        ano_thread_join(p->lane[i].thread, NULL);
+    ano_thread_barrier_destroy(&p->start);
+    ano_thread_barrier_destroy(&p->done);
+}
+
+// Sorts into p->src and lands the gather or the order. The caller owns the buffers.
+static void par_sort_run(par_sort_t *p)
+{
+    par_round(p, lane_keys);
+    bool unsorted = false;
+    for (uint32_t l = 0; l < p->lanes; l++)
+        unsorted = unsorted || p->lane[l].unsorted;
+    if (!unsorted)
+        return;     // order already holds the identity, items stay put
+
+    bool first = true;
+    for (int d = 0; d < 8; d++) {
+        uint32_t b0 = (uint32_t)(p->src[0].key >> (d * 8)) & 0xFFu;
+        uint64_t shared = 0;
+        for (uint32_t l = 0; l < p->lanes; l++)
+            shared += p->lane[l].hist8[d][b0];
+        if (shared == p->n)
+            continue;   // every key shares this digit
+        p->digit = d;
+        if (first) {    // the slices are still the keys round's
+            for (uint32_t l = 0; l < p->lanes; l++)
+                memcpy(p->lane[l].pos, p->lane[l].hist8[d], sizeof p->lane[l].pos);
+            first = false;
+        } else {
+            par_round(p, lane_count);
+        }
+        // Bucket-major, lane-minor: lane l's share of bucket b follows every earlier lane's.
+        uint32_t sum = 0;
+        for (int b = 0; b < 256; b++) {
+            for (uint32_t l = 0; l < p->lanes; l++) {
+                uint32_t c = p->lane[l].pos[b];
+                p->lane[l].pos[b] = sum;
+                sum += c;
+            }
+        }
+        par_round(p, lane_scatter);
+        sort_rec_t *swap = p->src;
+        p->src = p->dst;
+        p->dst = swap;
+    }
+
+    // Cut at run starts, so one lane settles each key-equal run whole. Serial: the finish round
+    // rewrites keys inside runs, and a neighbor must not be scanning them then.
+    p->lane[0].cut = 0;
+    for (uint32_t l = 1; l < p->lanes; l++) {
+        size_t c = lane_lo(p, l);
+        if (c < p->lane[l - 1u].cut)
+            c = p->lane[l - 1u].cut;
+        while (c > 0 && c < p->n && p->src[c].key == p->src[c - 1u].key)
+            c++;
+        p->lane[l].cut = c;
+    }
+    p->gather = (anostr_t *)p->dst;     // radix scratch, now free
+    par_round(p, lane_finish);
+    if (p->order == NULL)
+        par_round(p, lane_copy);
 }
 
-// Extends the per-symbol key cache to cover every symbol. Watermark bookkeeping.
-// NULL if it cannot grow.
+// False when it cannot run (too small, one lane, no scratch, no threads): the caller sorts serially.
+static bool sort_mt(const anostr_t *items, size_t count, uint32_t *order, uint32_t threads)
+{
+    if (count < SORT_MT_MIN || count > UINT32_MAX)
+        return false;
+    uint32_t lanes = threads != 0 ? threads : ano_jobs_worker_count() + 1u;
+    if (lanes > SORT_MT_LANES)
+        lanes = SORT_MT_LANES;
+    if (lanes < 2)
+        return false;
+
+    sort_rec_t  *recs = ano_tmalloc(&g_strMem, 2 * count * sizeof *recs);
+    sort_lane_t *lane = ano_tmalloc(&g_strMem, lanes * sizeof *lane);
+    if (recs == NULL || lane == NULL) {
+        ano_tfree(&g_strMem, recs);
+        ano_tfree(&g_strMem, lane);
+        return false;
+    }
+    par_sort_t p = {
+        .items = items, .n = count, .lanes = lanes, .src = recs, .dst = recs + count,
+        .order = order, .lane = lane, .crew = threads != 0,
+    };
+    for (uint32_t i = 0; i < lanes; i++) {
+        lane[i].index = i;
+        lane[i].p     = &p;
+    }
+    bool ran = !p.crew || crew_start(&p);
+    if (ran) {
+        par_sort_run(&p);
+        if (p.crew)
+            crew_stop(&p);
+    }
+    ano_tfree(&g_strMem, lane);
+    ano_tfree(&g_strMem, recs);
+    return ran;
+}
+
+void anostr_sort_mt(anostr_t *items, size_t count, uint32_t threads)
+{
+    if (items == NULL || count < 2)
+        return;
+    if (!sort_mt(items, count, NULL, threads))
+        anostr_sort(items, count);
+}
+
+void anostr_sort_idx_mt(const anostr_t *items, size_t count, uint32_t *order, uint32_t threads)
+{
+    if (order == NULL || items == NULL || count < 2 || !sort_mt(items, count, order, threads))
+        anostr_sort_idx(items, count, order);
+}
+
+// Kept full keys, one per symbol, built by collate_key_emit on first need (or on intern, for
+// eager tables) and never again. Out-of-range symbols compare as the empty string, whose key
+// is three bare terminators.
+static const char k_empty_key[6];
+
+bool anostr_sym_keys_extend_(anostr_intern_t *t)
+{
+    if (t->fullKeyed >= t->count)
+        return true;
+    if (t->fullKeyCap < t->count) {
+        uint32_t cap = intern_sym_cap_(t);
+        anostr_t *fresh = mi_heap_realloc(t->heap, t->fullKeys, (size_t)cap * sizeof *fresh);
+        if (fresh == NULL)
+            return false;
+        t->fullKeys = fresh;
+        t->fullKeyCap = cap;
+    }
+    const intern_image_t *img = &t->base;
+    if (img->keyStart != NULL) {    // saved keys: views into the image, no walk at all
+        for (; t->fullKeyed < t->baseCount; t->fullKeyed++) {
+            uint32_t at = img->keyStart[t->fullKeyed], len = img->keyStart[t->fullKeyed + 1] - at;
+            t->fullKeys[t->fullKeyed] = len <= ANOSTR_INLINE_CAP
+                                      ? anostr_make_inline_(img->keyBytes + at, len)
+                                      : anostr_make_long_(img->keyBytes + at, len);
+        }
+    }
+    key_buf_t kb = {0}, l2 = {0}, l3 = {0};
+    for (; t->fullKeyed < t->count; t->fullKeyed++) {
+        kb.n = 0;
+        collate_key_emit(&kb, &l2, &l3, intern_str_(t, t->fullKeyed));
+        if (kb.oom)
+            break;
+        anostr_t key = anostr_from(t->heap, kb.p, kb.n);
+        if (key.len != kb.n)
+            break;
+        t->fullKeys[t->fullKeyed] = key;
+    }
+    ano_tfree(&g_strMem, kb.p);
+    ano_tfree(&g_strMem, l2.p);
+    ano_tfree(&g_strMem, l3.p);
+    return t->fullKeyed >= t->count;
+}
+
+static anostr_t kept_key(const anostr_intern_t *t, anostr_sym sym)
+{
+    return sym < t->fullKeyed ? t->fullKeys[sym] : anostr_view(k_empty_key, sizeof k_empty_key);
+}
+
+// A full key's first four primaries, zero-padded at its terminator: anostr_collate_prefix
+// without the second DUCET walk.
+static uint64_t key_prefix(anostr_t key)
+{
+    const uint8_t *k = (const uint8_t *)anostr_bytes(&key);
+    uint64_t out = 0;
+    for (uint32_t i = 0; i < 4 && 2 * i + 1 < key.len; i++) {
+        uint64_t w = (uint64_t)k[2 * i] << 8 | k[2 * i + 1];
+        if (w == 0)
+            break;
+        out |= w << (48 - 16 * i);
+    }
+    return out;
+}
+
+// Extends the per-symbol prefix cache to cover every symbol, read off kept keys where there
+// are some. Watermark bookkeeping. NULL if it cannot grow.
 static const uint64_t *sym_key_cache(anostr_intern_t *t)
 {
     if (t->collateKeyed >= t->count)
         return t->collateKeys;
     if (t->collateKeyCap < t->count) {
-        uint64_t *fresh = mi_heap_realloc(t->heap, t->collateKeys,
-                                          (size_t)t->arrCap * sizeof *fresh);
+        uint32_t cap = intern_sym_cap_(t);     // >= count, grows with the overlay
+        uint64_t *fresh = mi_heap_realloc(t->heap, t->collateKeys, (size_t)cap * sizeof *fresh);
         if (fresh == NULL)
             return NULL;
         t->collateKeys = fresh;
-        t->collateKeyCap = t->arrCap;   // strs cap >= count, grows with it
+        t->collateKeyCap = cap;
     }
     for (uint32_t sym = t->collateKeyed; sym < t->count; sym++)
-        t->collateKeys[sym] = anostr_collate_prefix(t->strs[sym]);
+        t->collateKeys[sym] = sym < t->fullKeyed ? key_prefix(t->fullKeys[sym])
+                                                 : anostr_collate_prefix(intern_str_(t, sym));
     t->collateKeyed = t->count;
     return t->collateKeys;
 }
 
+// Prefix-equal runs settled on kept keys: byte compares only, stable by input position.
+static void tie_kept(sort_rec_t *r, size_t n, const anostr_intern_t *t, const anostr_sym *syms)
+{
+    tie_view_t *views = n >= TIE_BULK_MIN ? ano_tmalloc(&g_strMem, n * sizeof *views) : NULL;
+    if (views == NULL) {
+        for (size_t i = 1; i < n; i++) {
+            sort_rec_t cur = r[i];
+            anostr_t   ck = kept_key(t, syms[cur.idx]);
+            size_t j = i;
+            while (j > 0 && anostr_compare(kept_key(t, syms[r[j - 1].idx]), ck) > 0) {
+                r[j] = r[j - 1];
+                j--;
+            }
+            r[j] = cur;
+        }
+        return;
+    }
+    for (size_t i = 0; i < n; i++) {
+        anostr_sym sym = syms[r[i].idx];
+        views[i] = (tie_view_t){
+            .key  = sym < t->fullKeyed ? (const uint8_t *)anostr_bytes(&t->fullKeys[sym])
+                                       : (const uint8_t *)k_empty_key,
+            .klen = sym < t->fullKeyed ? t->fullKeys[sym].len : sizeof k_empty_key,
+            .idx  = r[i].idx,
+        };
+    }
+    qsort(views, n, sizeof *views, tie_view_cmp_);
+    for (size_t i = 0; i < n; i++)
+        r[i].idx = views[i].idx;
+    ano_tfree(&g_strMem, views);
+}
+
+// collate_sort_core over kept keys. True if already sorted.
+static bool sym_sort_kept(sort_rec_t *recs, sort_rec_t *tmp, size_t n,
+                          const anostr_intern_t *t, const anostr_sym *syms)
+{
+    size_t i = 1;
+    while (i < n && (recs[i - 1].key < recs[i].key ||
+                     (recs[i - 1].key == recs[i].key &&
+                      anostr_compare(kept_key(t, syms[recs[i - 1].idx]),
+                                     kept_key(t, syms[recs[i].idx])) <= 0)))
+        i++;
+    if (i >= n)
+        return true;
+
+    sort_recs(recs, tmp, n);
+    for (size_t lo = 0; lo < n; ) {
+        size_t hi = lo + 1;
+        while (hi < n && recs[hi].key == recs[lo].key)
+            hi++;
+        if (hi - lo > 1)
+            tie_kept(recs + lo, hi - lo, t, syms);
+        lo = hi;
+    }
+    return false;
+}
+
 void anostr_sym_sort(anostr_intern_t *t, anostr_sym *syms, size_t count)
 {
     if (t == NULL || syms == NULL || count < 2)
         return;
-    sort_rec_t *recs = count <= UINT32_MAX ? mi_malloc(2 * count * sizeof *recs) : NULL;
+    sort_rec_t *recs = count <= UINT32_MAX ? ano_tmalloc(&g_strMem, 2 * count * sizeof *recs) : NULL;
     if (recs == NULL) {
         fb_tbl_ = t;
         qsort(syms, count, sizeof syms[0], fb_sym_cmp_);
@@ -613,23 +1036,50 @@ void anostr_sym_sort(anostr_intern_t *t, anostr_sym *syms, size_t count)
     }
     sort_rec_t *tmp = recs + count;
 
+    bool kept = anostr_sym_keys_extend_(t);    // else ties stream through DUCET as before
     const uint64_t *cache = sym_key_cache(t);
     for (size_t i = 0; i < count; i++) {
         anostr_sym sym = syms[i];
         uint64_t key = sym >= t->count ? 0      // out of range = empty string
                      : cache != NULL   ? cache[sym]
-                                       : anostr_collate_prefix(t->strs[sym]);
+                                       : anostr_collate_prefix(intern_str_(t, sym));
         recs[i] = (sort_rec_t){ key, (uint32_t)i, 0 };
     }
 
     sym_ctx_t ctx = { t, syms };
-    if (!collate_sort_core(recs, tmp, count, rec_str_syms_, &ctx)) {
+    bool sorted = kept ? sym_sort_kept(recs, tmp, count, t, syms)
+                       : collate_sort_core(recs, tmp, count, rec_str_syms_, &ctx);
+    if (!sorted) {
         anostr_sym *gather = (anostr_sym *)tmp;
         for (size_t i = 0; i < count; i++)
             gather[i] = syms[recs[i].idx];
         memcpy(syms, gather, count * sizeof syms[0]);
     }
-    mi_free(recs);
+    ano_tfree(&g_strMem, recs);
+}
+
+anostr_t anostr_sym_collate_key(anostr_intern_t *t, anostr_sym sym)
+{
+    if (t == NULL || sym >= t->count)
+        return anostr_view(k_empty_key, sizeof k_empty_key);
+    (void)anostr_sym_keys_extend_(t);
+    return sym < t->fullKeyed ? t->fullKeys[sym] : anostr_empty();
+}
+
+int anostr_sym_collate(anostr_intern_t *t, anostr_sym a, anostr_sym b)
+{
+    anostr_t ka = anostr_sym_collate_key(t, a), kb = anostr_sym_collate_key(t, b);
+    if (ka.len == 0 || kb.len == 0)     // no key (allocation failure): stream instead
+        return anostr_collate(anostr_sym_str(t, a), anostr_sym_str(t, b));
+    return anostr_compare(ka, kb);
+}
+
+int anostr_intern_eager_keys(anostr_intern_t *t)
+{
+    if (t == NULL)
+        return -1;
+    t->fullKeysEager = true;
+    return anostr_sym_keys_extend_(t) ? 0 : -1;
 }
 
 bool anostr_eq_base(anostr_t a, anostr_t b)
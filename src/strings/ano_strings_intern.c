@@ -10,6 +10,10 @@
 // symbol arrays, the canonical bytes -- allocates from the table's heap and dies with it;
 // there is deliberately no destroy function (region granularity, like the whole module).
 //
+// A table from anostr_intern_map has a second, read-only tier underneath: the saved image
+// (ano_strings_intern_image.c) holds symbols [0 .. baseCount), probed first; the arrays and
+// slots above hold only what was interned since, numbered on from there.
+//
 // Threading: single mutator, same rule as the mi_heap underneath. Readers (find/sym_str/
 // count) are safe alongside each other but need external ordering against the mutator.
 
@@ -17,7 +21,7 @@
 
 #define INTERN_INITIAL_SLOTS 64u    // power of two; grows at 70% load
 
-// struct anostr_intern_t lives in ano_strings_internal.h (shared with anostr_sym_sort's cache).
+// struct anostr_intern_t lives in ano_strings_internal.h (shared with the collation key caches).
 
 anostr_intern_t *anostr_intern_make(mi_heap_t *heap)
 {
@@ -36,13 +40,24 @@ anostr_intern_t *anostr_intern_make(mi_heap_t *heap)
     return t;
 }
 
-// The symbol holding (hash, s), or ANOSTR_SYM_NONE at the first empty slot.
+// The symbol holding (hash, s), or ANOSTR_SYM_NONE at the first empty slot. A mapped image
+// probes first: its symbols are the older ones.
 static anostr_sym probe_find(const anostr_intern_t *t, uint64_t hash, anostr_t s)
 {
+    if (t->baseCount != 0) {
+        const intern_image_t *img = &t->base;
+        uint32_t idx = (uint32_t)hash & img->slotMask;
+        while (img->slots[idx] != 0) {
+            anostr_sym sym = img->slots[idx] - 1;
+            if (img->hashes[sym] == hash && anostr_eq(intern_str_(t, sym), s))
+                return sym;
+            idx = (idx + 1) & img->slotMask;
+        }
+    }
     uint32_t idx = (uint32_t)hash & t->slotMask;
     while (t->slots[idx] != 0) {
         anostr_sym sym = t->slots[idx] - 1;
-        if (t->hashes[sym] == hash && anostr_eq(t->strs[sym], s))
+        if (t->hashes[sym - t->baseCount] == hash && anostr_eq(t->strs[sym - t->baseCount], s))
             return sym;
         idx = (idx + 1) & t->slotMask;
     }
@@ -67,8 +82,8 @@ static int grow_slots(anostr_intern_t *t)
     if (fresh == NULL)
         return -1;
     uint32_t newMask = (uint32_t)newCap - 1;
-    for (anostr_sym sym = 0; sym < t->count; sym++)
-        slot_insert(fresh, newMask, t->hashes[sym], sym);
+    for (anostr_sym sym = t->baseCount; sym < t->count; sym++)
+        slot_insert(fresh, newMask, t->hashes[sym - t->baseCount], sym);
     mi_free(t->slots);
     t->slots = fresh;
     t->slotMask = newMask;
@@ -105,9 +120,10 @@ anostr_sym anostr_intern(anostr_intern_t *t, anostr_t s)
     // Insert path. Grow first so failure leaves the table exactly as it was.
     if (t->count >= UINT32_MAX - 1)     // sym + 1 must fit a slot; NONE stays reserved
         return ANOSTR_SYM_NONE;
-    if ((uint64_t)(t->count + 1) * 10 > ((uint64_t)t->slotMask + 1) * 7 && grow_slots(t) != 0)
+    uint32_t used = t->count - t->baseCount;  // overlay symbols
+    if ((uint64_t)(used + 1) * 10 > ((uint64_t)t->slotMask + 1) * 7 && grow_slots(t) != 0)
         return ANOSTR_SYM_NONE;
-    if (t->count == t->arrCap && grow_arrays(t) != 0)
+    if (used == t->arrCap && grow_arrays(t) != 0)
         return ANOSTR_SYM_NONE;
 
     anostr_t canonical = anostr_keep(t->heap, s);
@@ -115,9 +131,11 @@ anostr_sym anostr_intern(anostr_intern_t *t, anostr_t s)
         return ANOSTR_SYM_NONE;
 
     anostr_sym sym = t->count++;
-    t->hashes[sym] = hash;
-    t->strs[sym] = canonical;
+    t->hashes[used] = hash;
+    t->strs[used] = canonical;
     slot_insert(t->slots, t->slotMask, hash, sym);
+    if (t->fullKeysEager)
+        (void)anostr_sym_keys_extend_(t);   // a failure just leaves the key for first use
     return sym;
 }
 
@@ -132,7 +150,7 @@ anostr_t anostr_sym_str(const anostr_intern_t *t, anostr_sym sym)
 {
     if (t == NULL || sym >= t->count)
         return anostr_empty();
-    return t->strs[sym];
+    return intern_str_(t, sym);
 }
 
 anostr_t anostr_dedupe(anostr_intern_t *t, anostr_t s)
@@ -140,7 +158,7 @@ anostr_t anostr_dedupe(anostr_intern_t *t, anostr_t s)
     anostr_sym sym = anostr_intern(t, s);
     if (sym == ANOSTR_SYM_NONE)
         return s;   // table unavailable: the caller's value is still perfectly usable
-    return t->strs[sym];
+    return intern_str_(t, sym);
 }
 
 size_t anostr_intern_count(const anostr_intern_t *t)
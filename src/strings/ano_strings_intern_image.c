@@ -0,0 +1,233 @@
+/* SPDX-FileCopyrightText: 2026 Anoptic Game Engine Authors
+ *
+ * SPDX-License-Identifier: LGPL-3.0 */
+/*  == Anoptic Game Engine v0.0000001 == */
+
+// Intern table snapshots: anostr_intern_save writes the whole table as one flat file, and
+// anostr_intern_map opens it as the read-only base tier of a new table (the overlay above it
+// is the ordinary writable table, see ano_strings_internal.h). Startup then costs a map and
+// one pass over the offset arrays, not a hash, probe and copy per string.
+//
+// Layout, native byte order, every section at an offset from the file start:
+//   header (64 B) | hashes u64[count] | slots u32[slotMask + 1] | strStart u32[count + 1]
+//   | keyStart u32[count + 1] (with keys) | canonical bytes | key bytes (with keys)
+// The u64 section leads so every u32 array lands aligned. Nothing in the file is a pointer.
+
+#include "strings/ano_strings_internal.h"
+
+#include <stdio.h>
+
+#include "anoptic_filesystem.h"
+
+#define IMAGE_VERSION    1u
+#define IMAGE_ENDIAN     0x01020304u
+#define IMAGE_KEYS       1u
+#define IMAGE_MIN_SLOTS  64u
+
+typedef struct {
+    char     magic[7];      // "ANOSYMS"
+    uint8_t  version;
+    uint32_t endian;        // IMAGE_ENDIAN as written: a foreign byte order reads differently
+    uint32_t count;
+    uint32_t slotMask;
+    uint32_t flags;         // IMAGE_KEYS
+    uint64_t hashId;        // anostr_hash of a fixed string: another hash function orphans the slots
+    uint64_t tablesId;      // anostr_collate_tables_id_: other collation tables orphan the keys
+    uint64_t bytesLen;
+    uint64_t keyBytesLen;
+    uint64_t fileSize;
+} image_header_t;
+
+static_assert(sizeof(image_header_t) == 64, "the header is the first 64 bytes of the file");
+
+typedef struct {
+    uint64_t hashes, slots, strStart, keyStart, bytes, keyBytes, end;
+} image_layout_t;
+
+static image_layout_t image_layout(uint32_t count, uint32_t slotMask, bool keys,
+                                   uint64_t bytesLen, uint64_t keyBytesLen)
+{
+    image_layout_t l;
+    l.hashes   = sizeof(image_header_t);
+    l.slots    = l.hashes + (uint64_t)count * 8u;
+    l.strStart = l.slots + ((uint64_t)slotMask + 1u) * 4u;
+    l.keyStart = l.strStart + ((uint64_t)count + 1u) * 4u;
+    l.bytes    = l.keyStart + (keys ? ((uint64_t)count + 1u) * 4u : 0u);
+    l.keyBytes = l.bytes + bytesLen;
+    l.end      = l.keyBytes + (keys ? keyBytesLen : 0u);
+    return l;
+}
+
+static uint64_t image_hash_id(void)
+{
+    return anostr_hash(anostr_lit("anoptic intern image"));
+}
+
+// Offsets start at 0, never step back and end at len.
+static bool offsets_ok(const uint32_t *start, uint32_t count, uint64_t len)
+{
+    if (start[0] != 0 || start[count] != len)
+        return false;
+    for (uint32_t i = 0; i < count; i++)
+        if (start[i + 1] < start[i])
+            return false;
+    return true;
+}
+
+int anostr_intern_save(anostr_intern_t *t, const char *path)
+{
+    if (t == NULL || path == NULL)
+        return -1;
+    char tmp[MAXPATH + 8];
+    if (snprintf(tmp, sizeof tmp, "%s.tmp", path) >= (int)sizeof tmp)
+        return -1;
+
+    uint64_t tablesId = anostr_collate_tables_id_();
+    bool keys = tablesId != 0 && anostr_sym_keys_extend_(t);     // else the keys rebuild after map
+    uint32_t count = t->count;
+    uint64_t bytesLen = 0, keyBytesLen = 0;
+    for (anostr_sym sym = 0; sym < count; sym++) {
+        bytesLen += anostr_len(intern_str_(t, sym));
+        keyBytesLen += keys ? t->fullKeys[sym].len : 0u;
+    }
+    if (bytesLen > UINT32_MAX || keyBytesLen > UINT32_MAX)
+        return -1;      // u32 offsets
+
+    uint64_t slotCap = IMAGE_MIN_SLOTS;
+    while (slotCap * 7u < (uint64_t)count * 10u + 10u)   // below 70% load, like the live table
+        slotCap *= 2u;
+    if (slotCap > UINT32_MAX)
+        return -1;
+    image_layout_t lay = image_layout(count, (uint32_t)(slotCap - 1u), keys, bytesLen, keyBytesLen);
+    uint8_t *image = lay.end <= SIZE_MAX ? ano_tmalloc(&g_strMem, (size_t)lay.end) : NULL;
+    if (image == NULL)
+        return -1;
+
+    image_header_t hdr = {
+        .magic = { 'A', 'N', 'O', 'S', 'Y', 'M', 'S' }, .version = IMAGE_VERSION,
+        .endian = IMAGE_ENDIAN, .count = count, .slotMask = (uint32_t)(slotCap - 1u),
+        .flags = keys ? IMAGE_KEYS : 0u, .hashId = image_hash_id(), .tablesId = tablesId,
+        .bytesLen = bytesLen, .keyBytesLen = keyBytesLen, .fileSize = lay.end,
+    };
+    memcpy(image, &hdr, sizeof hdr);
+
+    uint64_t *hashes   = (uint64_t *)(image + lay.hashes);
+    uint32_t *slots    = (uint32_t *)(image + lay.slots);
+    uint32_t *strStart = (uint32_t *)(image + lay.strStart);
+    uint32_t *keyStart = (uint32_t *)(image + lay.keyStart);
+    memset(slots, 0, (size_t)slotCap * sizeof *slots);
+    uint32_t at = 0, keyAt = 0;
+    for (anostr_sym sym = 0; sym < count; sym++) {
+        uint64_t hash = intern_hash_(t, sym);
+        hashes[sym] = hash;
+        uint32_t idx = (uint32_t)hash & hdr.slotMask;
+        while (slots[idx] != 0)
+            idx = (idx + 1u) & hdr.slotMask;
+        slots[idx] = sym + 1u;
+
+        anostr_t s = intern_str_(t, sym);
+        strStart[sym] = at;
+        memcpy(image + lay.bytes + at, anostr_bytes(&s), s.len);
+        at += s.len;
+        if (keys) {
+            keyStart[sym] = keyAt;
+            memcpy(image + lay.keyBytes + keyAt, anostr_bytes(&t->fullKeys[sym]), t->fullKeys[sym].len);
+            keyAt += t->fullKeys[sym].len;
+        }
+    }
+    strStart[count] = at;
+    if (keys)
+        keyStart[count] = keyAt;
+
+    ano_file *f = ano_fs_open_trunc(tmp);
+    int rc = f != NULL ? 0 : -1;
+    if (f != NULL) {
+        if (ano_fs_write(f, image, (size_t)lay.end) != 0 || ano_fs_sync(f) != 0)
+            rc = -1;
+        if (ano_fs_close(f) != 0)
+            rc = -1;
+    }
+    ano_tfree(&g_strMem, image);
+    if (rc == 0 && ano_fs_replace(tmp, path) != 0)
+        rc = -1;
+    if (rc != 0)
+        remove(tmp);
+    return rc;
+}
+
+// Points img at the sections of a mapped file, checking everything a lookup will trust: bounds,
+// offsets, slot values, and at least one empty slot so every probe ends. False if malformed.
+static bool image_open(intern_image_t *img, uint32_t *count, const uint8_t *map, size_t size)
+{
+    image_header_t hdr;
+    if (size < sizeof hdr)
+        return false;
+    memcpy(&hdr, map, sizeof hdr);
+    if (memcmp(hdr.magic, "ANOSYMS", 7) != 0 || hdr.version != IMAGE_VERSION ||
+        hdr.endian != IMAGE_ENDIAN || hdr.hashId != image_hash_id() || hdr.fileSize != size)
+        return false;
+    uint64_t slotCap = (uint64_t)hdr.slotMask + 1u;
+    if ((slotCap & (slotCap - 1u)) != 0 || hdr.count >= slotCap ||
+        hdr.bytesLen > UINT32_MAX || hdr.keyBytesLen > UINT32_MAX)
+        return false;
+    bool keys = (hdr.flags & IMAGE_KEYS) != 0;
+    image_layout_t lay = image_layout(hdr.count, hdr.slotMask, keys, hdr.bytesLen, hdr.keyBytesLen);
+    if (lay.end != size)
+        return false;
+
+    *img = (intern_image_t){
+        .map = map, .mapSize = size, .slotMask = hdr.slotMask,
+        .hashes   = (const uint64_t *)(map + lay.hashes),
+        .slots    = (const uint32_t *)(map + lay.slots),
+        .strStart = (const uint32_t *)(map + lay.strStart),
+        .bytes    = (const char *)(map + lay.bytes),
+    };
+    if (!offsets_ok(img->strStart, hdr.count, hdr.bytesLen))
+        return false;
+    uint64_t used = 0;
+    for (uint64_t i = 0; i < slotCap; i++) {
+        if (img->slots[i] > hdr.count)
+            return false;
+        used += img->slots[i] != 0;
+    }
+    if (used != hdr.count)
+        return false;
+
+    const uint32_t *keyStart = (const uint32_t *)(map + lay.keyStart);
+    if (keys && hdr.tablesId == anostr_collate_tables_id_() &&
+        offsets_ok(keyStart, hdr.count, hdr.keyBytesLen)) {
+        img->keyStart = keyStart;
+        img->keyBytes = (const char *)(map + lay.keyBytes);
+    }
+    *count = hdr.count;
+    return true;
+}
+
+anostr_intern_t *anostr_intern_map(mi_heap_t *heap, const char *path)
+{
+    size_t size = 0;
+    const void *map = ano_fs_map_read(path, &size);
+    if (map == NULL)
+        return NULL;
+    intern_image_t img;
+    uint32_t count = 0;
+    anostr_intern_t *t = NULL;
+    if (image_open(&img, &count, map, size))
+        t = anostr_intern_make(heap);
+    if (t == NULL) {
+        ano_fs_unmap(map, size);
+        return NULL;
+    }
+    t->base = img;
+    t->baseCount = count;
+    t->count = count;
+    return t;
+}
+
+void anostr_intern_unmap(anostr_intern_t *t)
+{
+    if (t == NULL || t->base.map == NULL)
+        return;
+    ano_fs_unmap(t->base.map, t->base.mapSize);
+    t->base = (intern_image_t){0};
+}
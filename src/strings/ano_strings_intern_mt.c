@@ -0,0 +1,273 @@
+/* SPDX-FileCopyrightText: 2026 Anoptic Game Engine Authors
+ *
+ * SPDX-License-Identifier: LGPL-3.0 */
+/*  == Anoptic Game Engine v0.0000001 == */
+
+// The concurrent interning table (anostr_intern_mt_t). Same shape as ano_strings_intern.c -- open
+// addressing over cached hashes, canonical values in dense per-symbol storage -- split three ways
+// so that threads only meet where they must:
+//   - shards, picked by the hash's top bits. Each has a mutex that only inserts take and an arena
+//     holding its canonical bytes and slot tables;
+//   - slot tables, read without locks. An insert writes its entry, then publishes the slot with a
+//     release store. Growth builds a new table under the shard lock and publishes the pointer the
+//     same way; the old table stays in the arena, so a reader still probing it sees a valid (if
+//     stale) table and at worst misses an insert it raced;
+//   - the entry directory, shared by every shard so symbols stay dense. Segments double in size and
+//     never move: segment k holds MT_SEG0 << k entries and is installed once, by CAS.
+
+#include "strings/ano_strings_internal.h"
+
+#include <stdatomic.h>
+
+#define MT_SHARD_BITS     5u
+#define MT_SHARDS         (1u << MT_SHARD_BITS)
+#define MT_INITIAL_SLOTS  64u                         // per shard; power of two, grows at 70% load
+#define MT_SEG0_BITS      8u
+#define MT_SEG0           (1u << MT_SEG0_BITS)        // entries in segment 0
+#define MT_SEGS           (33u - MT_SEG0_BITS)        // enough for every sym below ANOSTR_SYM_NONE
+#define MT_RESERVE        ((size_t)64 << 20)          // default per-shard arena
+
+typedef struct {
+    uint64_t         hash;
+    anostr_t         str;
+    _Atomic uint32_t ready;     // release-set once hash and str are written; segments start zeroed
+} mt_entry_t;
+
+typedef struct {
+    uint32_t         mask;
+    _Atomic uint32_t slots[];   // sym + 1, 0 marks empty
+} mt_slots_t;
+
+typedef struct {
+    _Alignas(ANO_THREAD_LINE) mt_slots_t *_Atomic table;   // readers' line, apart from the lock's
+    _Alignas(ANO_THREAD_LINE) anothread_mutex_t   lock;    // inserts: everything below
+    ano_arena_t                                   arena;
+    uint32_t                                      used;    // symbols in this shard
+} mt_shard_t;
+
+struct anostr_intern_mt_t {
+    mt_shard_t                                 shards[MT_SHARDS];
+    mt_entry_t *_Atomic                        segs[MT_SEGS];
+    _Alignas(ANO_THREAD_LINE) _Atomic uint32_t count;      // next symbol
+};
+
+static inline uint32_t shard_of(uint64_t hash)
+{
+    // FNV-1a's top bits are its weakest: mix before taking them. Slots use the low bits unmixed.
+    return (uint32_t)((hash * UINT64_C(0x9E3779B97F4A7C15)) >> (64u - MT_SHARD_BITS));
+}
+
+// Segment and offset of a symbol: sym + MT_SEG0 has its top bit at MT_SEG0_BITS + segment.
+static inline uint32_t seg_of(anostr_sym sym, uint64_t *offset)
+{
+    uint64_t x   = (uint64_t)sym + MT_SEG0;
+    uint32_t top = 63u - (uint32_t)__builtin_clzll(x);
+    *offset = x - ((uint64_t)1 << top);
+    return top - MT_SEG0_BITS;
+}
+
+static inline const mt_entry_t *entry_at(const anostr_intern_mt_t *t, anostr_sym sym)
+{
+    uint64_t off;
+    uint32_t seg  = seg_of(sym, &off);
+    mt_entry_t *s = atomic_load_explicit(&t->segs[seg], memory_order_acquire);
+    return s != NULL ? &s[off] : NULL;
+}
+
+// Installs the segment holding sym if no one has yet. False on allocation failure.
+static bool seg_ensure(anostr_intern_mt_t *t, anostr_sym sym)
+{
+    uint64_t off;
+    uint32_t seg = seg_of(sym, &off);
+    if (atomic_load_explicit(&t->segs[seg], memory_order_acquire) != NULL)
+        return true;
+    mt_entry_t *fresh = mi_zalloc(((size_t)MT_SEG0 << seg) * sizeof *fresh);
+    if (fresh == NULL)
+        return false;
+    mt_entry_t *none = NULL;
+    if (!atomic_compare_exchange_strong_explicit(&t->segs[seg], &none, fresh, memory_order_acq_rel,
+                                                 memory_order_acquire))
+        mi_free(fresh);     // another shard's insert got there first
+    return true;
+}
+
+static mt_slots_t *slots_new(ano_arena_t *arena, uint32_t count)
+{
+    mt_slots_t *tab = ano_arena_zalloc(arena, sizeof *tab + (size_t)count * sizeof tab->slots[0],
+                                       ANO_CACHE_LINE);
+    if (tab != NULL)
+        tab->mask = count - 1u;
+    return tab;
+}
+
+// Lock-free. The symbol holding (hash, s), or ANOSTR_SYM_NONE at the first empty slot.
+static anostr_sym probe_find(const anostr_intern_mt_t *t, const mt_slots_t *tab, uint64_t hash,
+                             anostr_t s)
+{
+    uint32_t idx = (uint32_t)hash & tab->mask;
+    for (;;) {
+        uint32_t v = atomic_load_explicit(&tab->slots[idx], memory_order_acquire);
+        if (v == 0)
+            return ANOSTR_SYM_NONE;
+        const mt_entry_t *e = entry_at(t, v - 1u);
+        if (e->hash == hash && anostr_eq(e->str, s))
+            return v - 1u;
+        idx = (idx + 1u) & tab->mask;
+    }
+}
+
+static void slot_insert(mt_slots_t *tab, uint64_t hash, anostr_sym sym, memory_order order)
+{
+    uint32_t idx = (uint32_t)hash & tab->mask;
+    while (atomic_load_explicit(&tab->slots[idx], memory_order_relaxed) != 0)
+        idx = (idx + 1u) & tab->mask;
+    atomic_store_explicit(&tab->slots[idx], sym + 1u, order);
+}
+
+// Under the shard lock. Double the slot table from the cached hashes, then publish it.
+static mt_slots_t *grow_slots(anostr_intern_mt_t *t, mt_shard_t *sh, mt_slots_t *old)
+{
+    uint64_t newCap = ((uint64_t)old->mask + 1u) * 2u;
+    if (newCap > UINT32_MAX)
+        return NULL;
+    mt_slots_t *fresh = slots_new(&sh->arena, (uint32_t)newCap);
+    if (fresh == NULL)
+        return NULL;
+    for (uint32_t i = 0; i <= old->mask; i++) {
+        uint32_t v = atomic_load_explicit(&old->slots[i], memory_order_relaxed);
+        if (v != 0)
+            slot_insert(fresh, entry_at(t, v - 1u)->hash, v - 1u, memory_order_relaxed);
+    }
+    atomic_store_explicit(&sh->table, fresh, memory_order_release);
+    return fresh;
+}
+
+// Under the shard lock. Grow first and claim the symbol last, so a failure leaves no hole.
+static anostr_sym insert_locked(anostr_intern_mt_t *t, mt_shard_t *sh, uint64_t hash, anostr_t s)
+{
+    mt_slots_t *tab = atomic_load_explicit(&sh->table, memory_order_relaxed);
+    anostr_sym sym = probe_find(t, tab, hash, s);
+    if (sym != ANOSTR_SYM_NONE)
+        return sym;     // another thread inserted it while this one waited for the lock
+    if ((uint64_t)(sh->used + 1u) * 10u > ((uint64_t)tab->mask + 1u) * 7u) {
+        tab = grow_slots(t, sh, tab);
+        if (tab == NULL)
+            return ANOSTR_SYM_NONE;
+    }
+
+    anostr_t canonical = s;
+    if (s.len > ANOSTR_INLINE_CAP) {
+        char *copy = ano_arena_alloc(&sh->arena, s.len, 1u);
+        if (copy == NULL)
+            return ANOSTR_SYM_NONE;
+        memcpy(copy, s.ptr, s.len);
+        canonical = anostr_make_long_(copy, s.len);
+    }
+
+    sym = atomic_load_explicit(&t->count, memory_order_relaxed);
+    do {
+        if (sym >= UINT32_MAX - 1u || !seg_ensure(t, sym))
+            return ANOSTR_SYM_NONE;
+    } while (!atomic_compare_exchange_weak_explicit(&t->count, &sym, sym + 1u, memory_order_relaxed,
+                                                    memory_order_relaxed));
+
+    uint64_t    off;
+    mt_entry_t *seg = atomic_load_explicit(&t->segs[seg_of(sym, &off)], memory_order_relaxed);
+    seg[off].hash = hash;
+    seg[off].str  = canonical;
+    atomic_store_explicit(&seg[off].ready, 1u, memory_order_release);   // for anostr_sym_str_mt
+    slot_insert(tab, hash, sym, memory_order_release);
+    sh->used++;
+    return sym;
+}
+
+anostr_intern_mt_t *anostr_intern_mt_make(size_t shardReserve)
+{
+    if (shardReserve == 0)
+        shardReserve = MT_RESERVE;
+    anostr_intern_mt_t *t = mi_zalloc_aligned(sizeof *t, ANO_THREAD_LINE);
+    if (t == NULL)
+        return NULL;
+    for (uint32_t i = 0; i < MT_SHARDS; i++) {
+        mt_shard_t *sh = &t->shards[i];
+        mt_slots_t *tab = NULL;
+        if (ano_arena_init(&sh->arena, shardReserve) == 0) {
+            tab = slots_new(&sh->arena, MT_INITIAL_SLOTS);
+            if (tab == NULL || ano_mutex_init(&sh->lock, NULL) != 0) {
+                ano_arena_destroy(&sh->arena);
+                tab = NULL;
+            }
+        }
+        if (tab == NULL) {
+            while (i-- > 0) {
+                ano_mutex_destroy(&t->shards[i].lock);
+                ano_arena_destroy(&t->shards[i].arena);
+            }
+            mi_free(t);
+            return NULL;
+        }
+        atomic_init(&sh->table, tab);
+    }
+    return t;
+}
+
+void anostr_intern_mt_destroy(anostr_intern_mt_t *t)
+{
+    if (t == NULL)
+        return;
+    for (uint32_t i = 0; i < MT_SHARDS; i++) {
+        ano_mutex_destroy(&t->shards[i].lock);
+        ano_arena_destroy(&t->shards[i].arena);
+    }
+    for (uint32_t i = 0; i < MT_SEGS; i++)
+        mi_free(atomic_load_explicit(&t->segs[i], memory_order_relaxed));
+    mi_free(t);
+}
+
+anostr_sym anostr_intern_mt(anostr_intern_mt_t *t, anostr_t s)
+{
+    if (t == NULL)
+        return ANOSTR_SYM_NONE;
+    uint64_t    hash = anostr_hash(s);
+    mt_shard_t *sh   = &t->shards[shard_of(hash)];
+    anostr_sym  sym  = probe_find(t, atomic_load_explicit(&sh->table, memory_order_acquire), hash, s);
+    if (sym != ANOSTR_SYM_NONE)
+        return sym;
+    ano_mutex_lock(&sh->lock);
+    sym = insert_locked(t, sh, hash, s);
+    ano_mutex_unlock(&sh->lock);
+    return sym;
+}
+
+anostr_sym anostr_intern_mt_find(const anostr_intern_mt_t *t, anostr_t s)
+{
+    if (t == NULL)
+        return ANOSTR_SYM_NONE;
+    uint64_t hash = anostr_hash(s);
+    const mt_shard_t *sh = &t->shards[shard_of(hash)];
+    return probe_find(t, atomic_load_explicit(&sh->table, memory_order_acquire), hash, s);
+}
+
+anostr_t anostr_sym_str_mt(const anostr_intern_mt_t *t, anostr_sym sym)
+{
+    // count covers symbols claimed, not yet written: only the entry's own flag says it is readable.
+    if (t == NULL || sym >= atomic_load_explicit(&t->count, memory_order_relaxed))
+        return anostr_empty();
+    const mt_entry_t *e = entry_at(t, sym);
+    if (e == NULL || !atomic_load_explicit(&e->ready, memory_order_acquire))
+        return anostr_empty();
+    return e->str;
+}
+
+anostr_t anostr_dedupe_mt(anostr_intern_mt_t *t, anostr_t s)
+{
+    anostr_sym sym = anostr_intern_mt(t, s);
+    if (sym == ANOSTR_SYM_NONE)
+        return s;
+    return entry_at(t, sym)->str;
+}
+
+size_t anostr_intern_mt_count(const anostr_intern_mt_t *t)
+{
+    return t == NULL ? 0 : atomic_load_explicit(&t->count, memory_order_relaxed);
+}
@@ -9,8 +9,14 @@
 #ifndef ANOPTIC_SRC_STRINGS_INTERNAL_H
 #define ANOPTIC_SRC_STRINGS_INTERNAL_H
 
+#include "anoptic_memory.h"
 #include "anoptic_strings.h"
 
+#include <stdatomic.h>
+
+// Internal scratch (sort records, key buffers, rune arrays), counted under "strings". Never caller bytes.
+extern ano_mem_tag_t g_strMem;
+
 // Inline value from len <= 12 bytes. Starts all-zero so I3 (0x00 padding) holds by construction.
 static inline anostr_t anostr_make_inline_(const void *bytes, size_t len)
 {
@@ -32,20 +38,99 @@ static inline anostr_t anostr_make_long_(const char *bytes, size_t len)
     return s;
 }
 
-// The interning table, shared by ano_strings_intern.c (make/intern/grow) and
-// ano_strings_collate.c (anostr_sym_sort's key cache). Single mutator, like the mi_heap.
+// Kernels behind anostr_find, anostr_rune_count and anostr_utf8_valid, one table per SIMD tier
+// (ano_strings_simd.c). find takes ndLen >= 2 and from <= len - ndLen.
+typedef struct {
+    anostr_simd_t tier;
+    size_t (*find)(const char *hay, size_t len, const char *nd, size_t ndLen, size_t from);
+    size_t (*runeCount)(const uint8_t *p, size_t len);
+    bool   (*utf8Valid)(const uint8_t *p, size_t len);
+} anostr_kernels_t;
+
+extern const anostr_kernels_t *_Atomic anostr_kernels_;
+const anostr_kernels_t *anostr_kernels_pick_(void);
+
+static inline const anostr_kernels_t *anostr_kernels(void)
+{
+    const anostr_kernels_t *k = atomic_load_explicit(&anostr_kernels_, memory_order_relaxed);
+    return k != NULL ? k : anostr_kernels_pick_();
+}
+
+// The scalar tier: the reference every other tier must match, and the tail every other tier ends on.
+size_t anostr_find_scalar_(const char *hay, size_t len, const char *nd, size_t ndLen, size_t from);
+size_t anostr_rune_count_scalar_(const uint8_t *p, size_t len);
+bool   anostr_utf8_valid_scalar_(const uint8_t *p, size_t len);
+
+// A saved table mapped read-only (anostr_intern_map, ano_strings_intern_image.c). Every
+// pointer lands inside the file; the layout is offsets only, so it maps at any address.
+typedef struct intern_image_t {
+    const void     *map;        // NULL: no image
+    size_t          mapSize;
+    const uint64_t *hashes;     // per symbol
+    const uint32_t *slots;      // sym + 1, 0 marks empty; slotMask + 1 of them
+    const uint32_t *strStart;   // count + 1 offsets into bytes
+    const char     *bytes;
+    const uint32_t *keyStart;   // count + 1 offsets into keyBytes; NULL when the file has no keys
+    const char     *keyBytes;
+    uint32_t        slotMask;
+} intern_image_t;
+
+// The interning table, shared by ano_strings_intern.c (make/intern/grow),
+// ano_strings_collate.c (the collation key caches) and ano_strings_intern_image.c
+// (save/map). Single mutator, like the mi_heap.
+// A mapped table is two tiers: symbols [0 .. baseCount) live in the image, the rest in the
+// writable arrays below (the overlay), indexed sym - baseCount. A plain table has baseCount 0.
 struct anostr_intern_t {
     mi_heap_t *heap;
-    uint32_t   count;       // interned strings, dense syms 0..count-1
-    uint32_t   slotMask;    // slot capacity minus 1
-    uint32_t  *slots;       // sym + 1, 0 marks empty
-    uint64_t  *hashes;      // per-symbol cached hash (fast probe reject)
-    anostr_t  *strs;        // canonical value per symbol
+    uint32_t   count;       // interned strings, dense syms 0..count-1 (both tiers)
+    uint32_t   slotMask;    // overlay slot capacity minus 1
+    uint32_t  *slots;       // sym + 1, 0 marks empty; overlay symbols only
+    uint64_t  *hashes;      // per-overlay-symbol cached hash (fast probe reject)
+    anostr_t  *strs;        // canonical value per overlay symbol
     uint32_t   arrCap;      // hashes/strs capacity
+    intern_image_t base;
+    uint32_t   baseCount;
     // Collation-key cache, filled lazily by anostr_sym_sort. Watermark, no per-entry flag.
+    // Indexed by symbol across both tiers.
     uint64_t  *collateKeys; // per-symbol prefix key, [0 .. collateKeyed)
     uint32_t   collateKeyed;
     uint32_t   collateKeyCap;
+    // Full collation keys (anostr_collate_key's bytes), kept per symbol: same watermark scheme,
+    // [0 .. fullKeyed). Kept values, so a key handed out stays valid as long as the heap.
+    anostr_t  *fullKeys;
+    uint32_t   fullKeyed;
+    uint32_t   fullKeyCap;
+    bool       fullKeysEager;   // anostr_intern keys each new symbol
 };
 
+// A symbol's canonical value, from whichever tier holds it. sym < count.
+static inline anostr_t intern_str_(const anostr_intern_t *t, anostr_sym sym)
+{
+    if (sym >= t->baseCount)
+        return t->strs[sym - t->baseCount];
+    uint32_t at = t->base.strStart[sym], len = t->base.strStart[sym + 1] - at;
+    return len <= ANOSTR_INLINE_CAP ? anostr_make_inline_(t->base.bytes + at, len)
+                                    : anostr_make_long_(t->base.bytes + at, len);
+}
+
+static inline uint64_t intern_hash_(const anostr_intern_t *t, anostr_sym sym)
+{
+    return sym >= t->baseCount ? t->hashes[sym - t->baseCount] : t->base.hashes[sym];
+}
+
+// Capacity the per-symbol caches size to: every symbol the overlay arrays can hold.
+static inline uint32_t intern_sym_cap_(const anostr_intern_t *t)
+{
+    uint64_t cap = (uint64_t)t->baseCount + t->arrCap;
+    return cap > UINT32_MAX ? UINT32_MAX : (uint32_t)cap;
+}
+
+// Extends the kept full keys to every symbol (ano_strings_collate.c). False on allocation
+// failure; the watermark keeps whatever was done.
+bool anostr_sym_keys_extend_(anostr_intern_t *t);
+
+// Fingerprint of the collation tables (hash of one multi-script string's full key), so saved
+// keys from other tables are refused. 0 on allocation failure.
+uint64_t anostr_collate_tables_id_(void);
+
 #endif // ANOPTIC_SRC_STRINGS_INTERNAL_H
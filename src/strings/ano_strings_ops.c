@@ -18,14 +18,23 @@ size_t anostr_find(anostr_t s, anostr_t needle, size_t from)
 
     const char *hay = anostr_bytes(&s);
     const char *nd  = anostr_bytes(&needle);
-    size_t last = s.len - needle.len;       // last viable start index
+    if (needle.len == 1) {      // libc's memchr is already vectorized
+        const char *hit = memchr(hay + from, nd[0], s.len - from);
+        return hit != NULL ? (size_t)(hit - hay) : ANOSTR_NPOS;
+    }
+    return anostr_kernels()->find(hay, s.len, nd, needle.len, from);
+}
+
+size_t anostr_find_scalar_(const char *hay, size_t len, const char *nd, size_t ndLen, size_t from)
+{
+    size_t last = len - ndLen;              // last viable start index
     for (size_t i = from; i <= last; i++) {
         // memchr skips to the next candidate first byte; the window above bounds it.
         const char *hit = memchr(hay + i, nd[0], last - i + 1);
         if (hit == NULL)
             return ANOSTR_NPOS;
         i = (size_t)(hit - hay);
-        if (memcmp(hay + i, nd, needle.len) == 0)
+        if (memcmp(hay + i, nd, ndLen) == 0)
             return i;
     }
     return ANOSTR_NPOS;
@@ -0,0 +1,529 @@
+/* SPDX-FileCopyrightText: 2026 Anoptic Game Engine Authors
+ *
+ * SPDX-License-Identifier: LGPL-3.0 */
+/*  == Anoptic Game Engine v0.0000001 == */
+
+// The rope: an implicit treap of pieces. Each node is one piece (an anostr_t) plus its subtree's
+// byte, rune and newline sums; in-order traversal is the document. Split and merge are the only
+// structural operations: insert splits at the offset and merges the new pieces in between,
+// delete splits twice and drops the middle. A split inside a piece slices it in two
+// (anostr_slice: short halves go inline, long ones borrow the same bytes).
+//
+// Copied text lives in append-only blocks. A block counts the bytes its pieces still cover and
+// is freed when that reaches zero, so a log viewer trimming its head gives memory back.
+// The piece a typed insert just ended sits at the current block's fill line; the next keystroke
+// at its end appends to the block and lengthens that piece in place, one path of sums updated.
+
+#include "strings/ano_strings_internal.h"
+
+#include "anoptic_strings_rope.h"
+
+#define ROPE_PIECE_MAX  2048u           // bytes per piece: bounds a rune walk inside one
+#define ROPE_BLOCK      (64u << 10)     // append block; inserts over a quarter get their own
+#define ROPE_SPARE_MAX  64u             // freed nodes kept for reuse
+
+typedef struct rope_block_t {
+    size_t cap, used;
+    size_t live;        // bytes of pieces still in it
+    char   bytes[];
+} rope_block_t;
+
+typedef struct rope_node_t {
+    struct rope_node_t *left, *right;
+    anostr_t            text;
+    rope_block_t       *blk;        // holds text's bytes; NULL when borrowed from the caller
+    uint32_t            prio;       // max-heap order
+    uint32_t            runes;      // this piece's
+    uint32_t            lines;      // '\n' in this piece
+    size_t              sumBytes, sumRunes, sumLines;   // this subtree's
+} rope_node_t;
+
+struct anostr_rope_t {
+    mi_heap_t    *heap;
+    rope_node_t  *root;
+    rope_node_t  *spare;        // reusable nodes, linked through left
+    uint32_t      spareCount;
+    uint32_t      seed;         // xorshift32 state for priorities
+    rope_block_t *cur;          // where copied inserts go
+    rope_node_t  *tail;         // piece the last copied insert ended, NULL after any other edit
+    size_t        tailEnd;      // its end as a rope offset
+    const char   *tailStart;    // its first byte, in cur
+};
+
+static inline size_t sum_bytes(const rope_node_t *n) { return n != NULL ? n->sumBytes : 0; }
+static inline size_t sum_runes(const rope_node_t *n) { return n != NULL ? n->sumRunes : 0; }
+static inline size_t sum_lines(const rope_node_t *n) { return n != NULL ? n->sumLines : 0; }
+
+static void pull(rope_node_t *n)
+{
+    n->sumBytes = n->text.len + sum_bytes(n->left) + sum_bytes(n->right);
+    n->sumRunes = n->runes + sum_runes(n->left) + sum_runes(n->right);
+    n->sumLines = n->lines + sum_lines(n->left) + sum_lines(n->right);
+}
+
+static uint32_t count_newlines(anostr_t s)
+{
+    const char *p = anostr_bytes(&s), *end = p + s.len;
+    uint32_t lines = 0;
+    while (p < end && (p = memchr(p, '\n', (size_t)(end - p))) != NULL) {
+        lines++;
+        p++;
+    }
+    return lines;
+}
+
+static uint32_t next_prio(anostr_rope_t *r)
+{
+    uint32_t x = r->seed;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return r->seed = x;
+}
+
+// Nodes. reserve first, so an edit that starts can always finish; take then never fails.
+
+static bool reserve(anostr_rope_t *r, size_t count)
+{
+    while (r->spareCount < count) {
+        rope_node_t *n = mi_heap_malloc(r->heap, sizeof *n);
+        if (n == NULL)
+            return false;
+        n->left = r->spare;
+        r->spare = n;
+        r->spareCount++;
+    }
+    return true;
+}
+
+static rope_node_t *take(anostr_rope_t *r, anostr_t text, rope_block_t *blk)
+{
+    rope_node_t *n = r->spare;
+    r->spare = n->left;
+    r->spareCount--;
+    *n = (rope_node_t){ .text = text, .blk = blk, .prio = next_prio(r),
+                        .runes = (uint32_t)anostr_rune_count(text), .lines = count_newlines(text) };
+    pull(n);
+    return n;
+}
+
+static void block_drop(anostr_rope_t *r, rope_block_t *b, size_t bytes)
+{
+    if (b == NULL)
+        return;
+    b->live -= bytes;
+    if (b->live == 0 && b != r->cur)
+        mi_free(b);
+}
+
+static void release(anostr_rope_t *r, rope_node_t *n)
+{
+    if (n == NULL)
+        return;
+    release(r, n->left);
+    release(r, n->right);
+    block_drop(r, n->blk, n->text.len);
+    if (r->spareCount < ROPE_SPARE_MAX) {
+        n->left = r->spare;
+        r->spare = n;
+        r->spareCount++;
+    } else {
+        mi_free(n);
+    }
+}
+
+// Room for n more bytes: the current block, a fresh current block, or a block of their own
+// for a big insert. NULL on allocation failure.
+static rope_block_t *block_for(anostr_rope_t *r, size_t n)
+{
+    rope_block_t *b = r->cur;
+    if (b != NULL && b->cap - b->used >= n)
+        return b;
+    size_t cap = n > ROPE_BLOCK / 4 ? n : ROPE_BLOCK;
+    rope_block_t *fresh = mi_heap_malloc(r->heap, sizeof *fresh + cap);
+    if (fresh == NULL)
+        return NULL;
+    *fresh = (rope_block_t){ .cap = cap };
+    if (cap == ROPE_BLOCK) {
+        if (b != NULL && b->live == 0)
+            mi_free(b);
+        r->cur = fresh;
+    }
+    return fresh;
+}
+
+// Treap structure.
+
+static rope_node_t *merge(rope_node_t *a, rope_node_t *b)
+{
+    if (a == NULL)
+        return b;
+    if (b == NULL)
+        return a;
+    if (a->prio >= b->prio) {
+        a->right = merge(a->right, b);
+        pull(a);
+        return a;
+    }
+    b->left = merge(a, b->left);
+    pull(b);
+    return b;
+}
+
+// n's first `pos` bytes into *lo, the rest into *hi. A cut inside a piece takes one node
+// (reserved by the caller) for the piece's back half.
+static void split(anostr_rope_t *r, rope_node_t *n, size_t pos, rope_node_t **lo, rope_node_t **hi)
+{
+    if (n == NULL) {
+        *lo = *hi = NULL;
+        return;
+    }
+    size_t left = sum_bytes(n->left), end = left + n->text.len;
+    if (pos <= left) {
+        split(r, n->left, pos, lo, &n->left);
+        pull(n);
+        *hi = n;
+    } else if (pos >= end) {
+        split(r, n->right, pos - end, &n->right, hi);
+        pull(n);
+        *lo = n;
+    } else {
+        size_t k = pos - left;
+        rope_node_t *back = take(r, anostr_slice(n->text, k, n->text.len), n->blk);
+        n->text = anostr_slice(n->text, 0, k);
+        n->runes -= back->runes;
+        n->lines -= back->lines;
+        back->prio = n->prio;       // above n's right subtree, as n was
+        back->right = n->right;
+        n->right = NULL;
+        pull(back);
+        pull(n);
+        *lo = n;
+        *hi = back;
+    }
+}
+
+// The node holding byte pos (< length) and the offset its piece starts at. NULL past the end.
+static const rope_node_t *piece_at(const rope_node_t *n, size_t pos, size_t *start)
+{
+    size_t base = 0;
+    while (n != NULL) {
+        size_t left = sum_bytes(n->left);
+        if (pos < left) {
+            n = n->left;
+            continue;
+        }
+        if (pos - left < n->text.len) {
+            *start = base + left;
+            return n;
+        }
+        pos -= left + n->text.len;
+        base += left + n->text.len;
+        n = n->right;
+    }
+    return NULL;
+}
+
+// pos moved back to the start of the rune it falls in (at most three continuation bytes).
+static size_t snap(const anostr_rope_t *r, size_t pos)
+{
+    size_t start;
+    const rope_node_t *n = piece_at(r->root, pos, &start);
+    if (n == NULL)
+        return pos;
+    const uint8_t *p = (const uint8_t *)anostr_bytes(&n->text);
+    size_t k = pos - start;
+    for (int back = 0; back < 3 && k > 0 && (p[k] & 0xC0u) == 0x80u; back++)
+        k--;
+    return start + k;
+}
+
+// Bytes for the next piece of p[0 .. len): all of it, or ROPE_PIECE_MAX backed off to a rune start.
+static size_t piece_cut(const char *p, size_t len)
+{
+    if (len <= ROPE_PIECE_MAX)
+        return len;
+    size_t k = ROPE_PIECE_MAX;
+    for (int back = 0; back < 3 && ((uint8_t)p[k] & 0xC0u) == 0x80u; back++)
+        k--;
+    return k;
+}
+
+// The typing path: s continues the tail piece, in the tail's block. False if it cannot.
+static bool tail_extend(anostr_rope_t *r, size_t at, anostr_t s)
+{
+    rope_node_t  *t = r->tail;
+    rope_block_t *b = r->cur;
+    size_t start;
+    if (t == NULL || at != r->tailEnd || t->blk != b || t->text.len + s.len > ROPE_PIECE_MAX ||
+        b->cap - b->used < s.len || r->tailStart + t->text.len != b->bytes + b->used ||
+        piece_at(r->root, at - 1, &start) != t)
+        return false;
+
+    memcpy(b->bytes + b->used, anostr_bytes(&s), s.len);
+    b->used += s.len;
+    b->live += s.len;
+    uint32_t runes = (uint32_t)anostr_rune_count(s), lines = count_newlines(s);
+    size_t pos = at - 1;
+    for (rope_node_t *n = r->root; ; ) {    // sums along the path to t
+        n->sumBytes += s.len;
+        n->sumRunes += runes;
+        n->sumLines += lines;
+        if (n == t)
+            break;
+        size_t left = sum_bytes(n->left);
+        if (pos < left) {
+            n = n->left;
+        } else {
+            pos -= left + n->text.len;
+            n = n->right;
+        }
+    }
+    t->text = anostr_view(r->tailStart, t->text.len + s.len);
+    t->runes += runes;
+    t->lines += lines;
+    r->tailEnd += s.len;
+    return true;
+}
+
+static int rope_insert(anostr_rope_t *r, size_t at, anostr_t s, bool copy)
+{
+    if (r == NULL)
+        return -1;
+    size_t n = anostr_len(s);
+    if (n == 0)
+        return 0;
+    size_t total = sum_bytes(r->root);
+    at = snap(r, at < total ? at : total);
+    if (copy && tail_extend(r, at, s))
+        return 0;
+
+    // Everything that can fail, before the tree changes.
+    if (!reserve(r, n / (ROPE_PIECE_MAX - 3u) + 2u))    // pieces, plus one for the split
+        return -1;
+    rope_block_t *blk = NULL;
+    const char *src = anostr_bytes(&s);
+    if (copy) {
+        blk = block_for(r, n);
+        if (blk == NULL)
+            return -1;
+        char *dst = blk->bytes + blk->used;
+        memcpy(dst, src, n);
+        blk->used += n;
+        blk->live += n;
+        src = dst;
+    }
+
+    rope_node_t *mid = NULL, *last = NULL;
+    size_t lastOff = 0;
+    for (size_t off = 0; off < n; ) {
+        size_t cut = piece_cut(src + off, n - off);
+        anostr_t piece = copy ? anostr_view(src + off, cut) : anostr_slice(s, off, off + cut);
+        last = take(r, piece, blk);
+        lastOff = off;
+        mid = merge(mid, last);
+        off += cut;
+    }
+    rope_node_t *lo, *hi;
+    split(r, r->root, at, &lo, &hi);
+    r->root = merge(merge(lo, mid), hi);
+
+    r->tail = copy && blk == r->cur ? last : NULL;
+    r->tailEnd = at + n;
+    r->tailStart = src + lastOff;
+    return 0;
+}
+
+anostr_rope_t *anostr_rope_make(mi_heap_t *heap)
+{
+    if (heap == NULL)
+        return NULL;
+    anostr_rope_t *r = mi_heap_zalloc(heap, sizeof *r);
+    if (r == NULL)
+        return NULL;
+    r->heap = heap;
+    r->seed = 0x9E3779B9u;
+    return r;
+}
+
+void anostr_rope_destroy(anostr_rope_t *r)
+{
+    if (r == NULL)
+        return;
+    release(r, r->root);
+    while (r->spare != NULL) {
+        rope_node_t *n = r->spare;
+        r->spare = n->left;
+        mi_free(n);
+    }
+    mi_free(r->cur);
+    mi_free(r);
+}
+
+size_t anostr_rope_len(const anostr_rope_t *r)
+{
+    return r != NULL ? sum_bytes(r->root) : 0;
+}
+
+size_t anostr_rope_runes(const anostr_rope_t *r)
+{
+    return r != NULL ? sum_runes(r->root) : 0;
+}
+
+size_t anostr_rope_lines(const anostr_rope_t *r)
+{
+    return r != NULL ? sum_lines(r->root) + 1u : 1u;
+}
+
+int anostr_rope_insert(anostr_rope_t *r, size_t at, anostr_t s)
+{
+    return rope_insert(r, at, s, true);
+}
+
+int anostr_rope_insert_ref(anostr_rope_t *r, size_t at, anostr_t s)
+{
+    return rope_insert(r, at, s, false);
+}
+
+int anostr_rope_append(anostr_rope_t *r, anostr_t s)
+{
+    return rope_insert(r, SIZE_MAX, s, true);
+}
+
+int anostr_rope_delete(anostr_rope_t *r, size_t from, size_t to)
+{
+    if (r == NULL)
+        return -1;
+    size_t total = sum_bytes(r->root);
+    to = snap(r, to < total ? to : total);
+    from = snap(r, from < to ? from : to);
+    if (from == to)
+        return 0;
+    if (!reserve(r, 2))
+        return -1;
+    rope_node_t *lo, *mid, *hi;
+    split(r, r->root, to, &lo, &hi);
+    split(r, lo, from, &lo, &mid);
+    release(r, mid);
+    r->root = merge(lo, hi);
+    r->tail = NULL;
+    return 0;
+}
+
+size_t anostr_rope_rune_offset(const anostr_rope_t *r, size_t rune)
+{
+    if (r == NULL)
+        return 0;
+    if (rune >= sum_runes(r->root))
+        return sum_bytes(r->root);
+    size_t base = 0;
+    for (const rope_node_t *n = r->root; n != NULL; ) {
+        if (rune < sum_runes(n->left)) {
+            n = n->left;
+            continue;
+        }
+        rune -= sum_runes(n->left);
+        base += sum_bytes(n->left);
+        if (rune < n->runes) {
+            size_t i = 0;
+            while (rune-- > 0)
+                anostr_rune_next(n->text, &i);
+            return base + i;
+        }
+        rune -= n->runes;
+        base += n->text.len;
+        n = n->right;
+    }
+    return sum_bytes(r->root);
+}
+
+size_t anostr_rope_line_offset(const anostr_rope_t *r, size_t line)
+{
+    if (line == 0)
+        return 0;
+    if (r == NULL || line > sum_lines(r->root))
+        return ANOSTR_NPOS;
+    size_t base = 0;     // looking for the line-th '\n'; the line starts after it
+    for (const rope_node_t *n = r->root; n != NULL; ) {
+        if (line <= sum_lines(n->left)) {
+            n = n->left;
+            continue;
+        }
+        line -= sum_lines(n->left);
+        base += sum_bytes(n->left);
+        if (line <= n->lines) {
+            const char *p = anostr_bytes(&n->text), *at = p - 1;
+            while (line-- > 0)
+                at = memchr(at + 1, '\n', n->text.len - (size_t)(at + 1 - p));
+            return base + (size_t)(at - p) + 1u;
+        }
+        line -= n->lines;
+        base += n->text.len;
+        n = n->right;
+    }
+    return ANOSTR_NPOS;
+}
+
+anorune_t anostr_rope_rune_next(const anostr_rope_t *r, size_t *i)
+{
+    size_t total = anostr_rope_len(r);
+    if (*i >= total) {
+        *i = total;
+        return ANORUNE_REPLACEMENT;
+    }
+    char buf[4];
+    size_t got = 0;
+    anostr_rope_iter_t it = anostr_rope_chunks(r, *i, *i + 4u);
+    for (anostr_t c; got < sizeof buf && anostr_rope_next_chunk(&it, &c); ) {
+        size_t n = c.len < sizeof buf - got ? c.len : sizeof buf - got;
+        memcpy(buf + got, anostr_bytes(&c), n);
+        got += n;
+    }
+    size_t k = 0;
+    anorune_t rune = anostr_rune_next(anostr_view(buf, got), &k);
+    *i += k;
+    return rune;
+}
+
+anostr_t anostr_rope_slice(mi_heap_t *heap, const anostr_rope_t *r, size_t from, size_t to)
+{
+    size_t total = anostr_rope_len(r);
+    to = to < total ? to : total;
+    if (from >= to)
+        return anostr_empty();
+    size_t start;
+    const rope_node_t *n = piece_at(r->root, from, &start);
+    if (to - start <= n->text.len)
+        return anostr_slice(n->text, from - start, to - start);     // one piece: borrow
+    if (to - from > UINT32_MAX)
+        return anostr_empty();
+
+    anostr_builder_t b = anostr_builder_make(heap, (uint32_t)(to - from));
+    anostr_rope_iter_t it = anostr_rope_chunks(r, from, to);
+    for (anostr_t c; anostr_rope_next_chunk(&it, &c); )
+        if (anostr_builder_append(&b, anostr_bytes(&c), c.len) != 0)
+            break;
+    anostr_t out = anostr_freeze(&b);
+    return anostr_len(out) == to - from ? out : anostr_empty();
+}
+
+anostr_rope_iter_t anostr_rope_chunks(const anostr_rope_t *r, size_t from, size_t to)
+{
+    size_t total = anostr_rope_len(r);
+    to = to < total ? to : total;
+    return (anostr_rope_iter_t){ .rope = r, .at = from < to ? from : to, .end = to };
+}
+
+bool anostr_rope_next_chunk(anostr_rope_iter_t *it, anostr_t *chunk)
+{
+    if (it == NULL || it->rope == NULL || it->at >= it->end)
+        return false;
+    size_t start;
+    const rope_node_t *n = piece_at(it->rope->root, it->at, &start);
+    if (n == NULL)
+        return false;
+    size_t stop = start + n->text.len < it->end ? start + n->text.len : it->end;
+    *chunk = anostr_slice(n->text, it->at - start, stop - start);
+    it->at = stop;
+    return true;
+}
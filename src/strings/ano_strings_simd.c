@@ -0,0 +1,389 @@
+/* SPDX-FileCopyrightText: 2026 Anoptic Game Engine Authors
+ *
+ * SPDX-License-Identifier: LGPL-3.0 */
+/*  == Anoptic Game Engine v0.0000001 == */
+
+// SIMD kernels for anostr_find, anostr_rune_count and anostr_utf8_valid, one table per tier, and the
+// runtime pick between them. Every kernel runs whole vectors and hands the remainder to the scalar
+// kernel, so the scalar tier is both the fallback and the oracle.
+//   find:       two-byte filter (Mula). Compare a vector of candidate starts against the needle's
+//               first byte and, shifted by ndLen - 1, its last byte; memcmp only where both match.
+//   rune count: count the bytes that are not continuation bytes (signed compare against 0xBF).
+//   utf8 valid: Keiser & Lemire, "Validating UTF-8 In Less Than One Instruction Per Byte" (2021).
+//               Three 16-entry lookups on the high and low nibbles of each byte pair flag every
+//               two-byte error; the shifted lead bytes two and three back say where continuations
+//               must be. AVX2 and NEON only: SSE2 has no byte shuffle, so its tier skips ASCII a
+//               vector at a time and validates the rest with the scalar decoder.
+
+#include "strings/ano_strings_internal.h"
+
+#if defined(__x86_64__) || (defined(__i386__) && defined(__SSE2__))
+#define STR_X86 1
+#include <immintrin.h>
+#define STR_AVX2 __attribute__((target("avx2")))
+#elif defined(__aarch64__)
+#define STR_NEON 1
+#include <arm_neon.h>
+#endif
+
+
+/* Keiser-Lemire tables */
+
+#if defined(STR_X86) || defined(STR_NEON)
+// Error bits of a (previous byte, byte) pair. TOO_LARGE_1000 and OVERLONG_4 share bit 6: the
+// nibbles already tell them apart.
+#define KL_TOO_SHORT      (1u << 0)   // 11______ 0_______ or 11______ 11______
+#define KL_TOO_LONG       (1u << 1)   // 0_______ 10______
+#define KL_OVERLONG_3     (1u << 2)   // 11100000 100_____
+#define KL_TOO_LARGE      (1u << 3)   // 11110100 1001____ and up
+#define KL_SURROGATE      (1u << 4)   // 11101101 101_____
+#define KL_OVERLONG_2     (1u << 5)   // 1100000_ 10______
+#define KL_TOO_LARGE_1000 (1u << 6)   // 11110101 1000____ and up
+#define KL_OVERLONG_4     (1u << 6)   // 11110000 1000____
+#define KL_TWO_CONTS      (1u << 7)   // 10______ 10______
+#define KL_CARRY          (KL_TOO_SHORT | KL_TOO_LONG | KL_TWO_CONTS)
+
+// Indexed by the previous byte's high nibble.
+#define KL_BYTE_1_HIGH                                                                              \
+    KL_TOO_LONG, KL_TOO_LONG, KL_TOO_LONG, KL_TOO_LONG,                                             \
+    KL_TOO_LONG, KL_TOO_LONG, KL_TOO_LONG, KL_TOO_LONG,                                             \
+    KL_TWO_CONTS, KL_TWO_CONTS, KL_TWO_CONTS, KL_TWO_CONTS,                                         \
+    KL_TOO_SHORT | KL_OVERLONG_2,                                                                   \
+    KL_TOO_SHORT,                                                                                   \
+    KL_TOO_SHORT | KL_OVERLONG_3 | KL_SURROGATE,                                                    \
+    KL_TOO_SHORT | KL_TOO_LARGE | KL_TOO_LARGE_1000 | KL_OVERLONG_4
+
+// Indexed by the previous byte's low nibble.
+#define KL_BYTE_1_LOW                                                                               \
+    KL_CARRY | KL_OVERLONG_3 | KL_OVERLONG_2 | KL_OVERLONG_4,                                       \
+    KL_CARRY | KL_OVERLONG_2,                                                                       \
+    KL_CARRY, KL_CARRY,                                                                             \
+    KL_CARRY | KL_TOO_LARGE,                                                                        \
+    KL_CARRY | KL_TOO_LARGE | KL_TOO_LARGE_1000, KL_CARRY | KL_TOO_LARGE | KL_TOO_LARGE_1000,       \
+    KL_CARRY | KL_TOO_LARGE | KL_TOO_LARGE_1000, KL_CARRY | KL_TOO_LARGE | KL_TOO_LARGE_1000,       \
+    KL_CARRY | KL_TOO_LARGE | KL_TOO_LARGE_1000, KL_CARRY | KL_TOO_LARGE | KL_TOO_LARGE_1000,       \
+    KL_CARRY | KL_TOO_LARGE | KL_TOO_LARGE_1000, KL_CARRY | KL_TOO_LARGE | KL_TOO_LARGE_1000,       \
+    KL_CARRY | KL_TOO_LARGE | KL_TOO_LARGE_1000 | KL_SURROGATE,                                     \
+    KL_CARRY | KL_TOO_LARGE | KL_TOO_LARGE_1000, KL_CARRY | KL_TOO_LARGE | KL_TOO_LARGE_1000
+
+// Indexed by the current byte's high nibble.
+#define KL_BYTE_2_HIGH                                                                              \
+    KL_TOO_SHORT, KL_TOO_SHORT, KL_TOO_SHORT, KL_TOO_SHORT,                                         \
+    KL_TOO_SHORT, KL_TOO_SHORT, KL_TOO_SHORT, KL_TOO_SHORT,                                         \
+    KL_TOO_LONG | KL_OVERLONG_2 | KL_TWO_CONTS | KL_OVERLONG_3 | KL_TOO_LARGE_1000 | KL_OVERLONG_4, \
+    KL_TOO_LONG | KL_OVERLONG_2 | KL_TWO_CONTS | KL_OVERLONG_3 | KL_TOO_LARGE,                      \
+    KL_TOO_LONG | KL_OVERLONG_2 | KL_TWO_CONTS | KL_SURROGATE | KL_TOO_LARGE,                       \
+    KL_TOO_LONG | KL_OVERLONG_2 | KL_TWO_CONTS | KL_SURROGATE | KL_TOO_LARGE,                       \
+    KL_TOO_SHORT, KL_TOO_SHORT, KL_TOO_SHORT, KL_TOO_SHORT
+#endif
+
+
+/* x86: SSE2 and AVX2 */
+
+#ifdef STR_X86
+static size_t find_sse2(const char *hay, size_t len, const char *nd, size_t ndLen, size_t from)
+{
+    const __m128i first = _mm_set1_epi8(nd[0]);
+    const __m128i last  = _mm_set1_epi8(nd[ndLen - 1u]);
+    size_t end = len - ndLen + 1u;      // one past the last viable start
+    size_t i   = from;
+    for (; end - i >= 16u; i += 16u) {
+        __m128i a = _mm_loadu_si128((const __m128i *)(hay + i));
+        __m128i b = _mm_loadu_si128((const __m128i *)(hay + i + ndLen - 1u));
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, first),
+                                                                  _mm_cmpeq_epi8(b, last)));
+        for (; mask != 0; mask &= mask - 1u) {
+            size_t at = i + (size_t)__builtin_ctz(mask);
+            if (memcmp(hay + at + 1u, nd + 1u, ndLen - 2u) == 0)
+                return at;
+        }
+    }
+    return anostr_find_scalar_(hay, len, nd, ndLen, i);
+}
+
+static size_t rune_count_sse2(const uint8_t *p, size_t len)
+{
+    const __m128i cont = _mm_set1_epi8(-65);   // 0xBF: signed, continuation bytes are at or below
+    size_t count = 0, i = 0;
+    for (; len - i >= 16u; i += 16u) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(p + i));
+        count += (size_t)__builtin_popcount((uint32_t)_mm_movemask_epi8(_mm_cmpgt_epi8(v, cont)));
+    }
+    return count + anostr_rune_count_scalar_(p + i, len - i);
+}
+
+// ASCII a vector at a time. A vector with a high bit set goes to the scalar decoder, together with
+// the continuation bytes right after it: cutting before a byte that can start a sequence never
+// splits a valid one, and more than three continuations in a row are invalid anyway.
+static bool utf8_valid_sse2(const uint8_t *p, size_t len)
+{
+    size_t i = 0;
+    while (len - i >= 16u) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(p + i));
+        if (_mm_movemask_epi8(v) == 0) {
+            i += 16u;
+            continue;
+        }
+        size_t j = i + 16u;
+        while (j < len && j < i + 19u && (p[j] & 0xC0u) == 0x80u)
+            j++;
+        if (!anostr_utf8_valid_scalar_(p + i, j - i))
+            return false;
+        i = j;
+    }
+    return anostr_utf8_valid_scalar_(p + i, len - i);
+}
+
+STR_AVX2 static size_t find_avx2(const char *hay, size_t len, const char *nd, size_t ndLen, size_t from)
+{
+    const __m256i first = _mm256_set1_epi8(nd[0]);
+    const __m256i last  = _mm256_set1_epi8(nd[ndLen - 1u]);
+    size_t end = len - ndLen + 1u;
+    size_t i   = from;
+    // Two vectors per test while nothing matches: a miss costs one branch per 64 bytes.
+    for (; end - i >= 64u; i += 64u) {
+        const char *h = hay + i;
+        __m256i m0 = _mm256_and_si256(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)h), first),
+                                      _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(h + ndLen - 1u)),
+                                                        last));
+        __m256i m1 = _mm256_and_si256(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(h + 32)), first),
+                                      _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(h + 31u + ndLen)),
+                                                        last));
+        __m256i any = _mm256_or_si256(m0, m1);
+        if (_mm256_testz_si256(any, any))
+            continue;
+        uint64_t mask = (uint64_t)(uint32_t)_mm256_movemask_epi8(m1) << 32
+                        | (uint32_t)_mm256_movemask_epi8(m0);
+        for (; mask != 0; mask &= mask - 1u) {
+            size_t at = i + (size_t)__builtin_ctzll(mask);
+            if (memcmp(hay + at + 1u, nd + 1u, ndLen - 2u) == 0)
+                return at;
+        }
+    }
+    for (; end - i >= 32u; i += 32u) {
+        __m256i a = _mm256_loadu_si256((const __m256i *)(hay + i));
+        __m256i b = _mm256_loadu_si256((const __m256i *)(hay + i + ndLen - 1u));
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(a, first),
+                                                                        _mm256_cmpeq_epi8(b, last)));
+        for (; mask != 0; mask &= mask - 1u) {
+            size_t at = i + (size_t)__builtin_ctz(mask);
+            if (memcmp(hay + at + 1u, nd + 1u, ndLen - 2u) == 0)
+                return at;
+        }
+    }
+    return find_sse2(hay, len, nd, ndLen, i);
+}
+
+STR_AVX2 static size_t rune_count_avx2(const uint8_t *p, size_t len)
+{
+    const __m256i cont = _mm256_set1_epi8(-65);
+    size_t count = 0, i = 0;
+    for (; len - i >= 32u; i += 32u) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(p + i));
+        count += (size_t)__builtin_popcount((uint32_t)_mm256_movemask_epi8(_mm256_cmpgt_epi8(v, cont)));
+    }
+    return count + rune_count_sse2(p + i, len - i);
+}
+
+// The last n bytes of prev followed by the first 32 - n of in.
+#define KL_PREV_AVX2(in, prev, n) \
+    _mm256_alignr_epi8((in), _mm256_permute2x128_si256((prev), (in), 0x21), 16 - (n))
+#define KL_TABLE_AVX2(...) _mm256_setr_epi8(__VA_ARGS__, __VA_ARGS__)
+
+// Error bits for one vector, given the vector before it.
+STR_AVX2 static inline __m256i kl_check_avx2(__m256i in, __m256i prev)
+{
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    __m256i prev1 = KL_PREV_AVX2(in, prev, 1);
+    __m256i b1h = _mm256_shuffle_epi8(KL_TABLE_AVX2(KL_BYTE_1_HIGH),
+                                      _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble));
+    __m256i b1l = _mm256_shuffle_epi8(KL_TABLE_AVX2(KL_BYTE_1_LOW), _mm256_and_si256(prev1, nibble));
+    __m256i b2h = _mm256_shuffle_epi8(KL_TABLE_AVX2(KL_BYTE_2_HIGH),
+                                      _mm256_and_si256(_mm256_srli_epi16(in, 4), nibble));
+    __m256i special = _mm256_and_si256(_mm256_and_si256(b1h, b1l), b2h);
+    // Bytes two after a 3/4-byte lead or three after a 4-byte lead must be continuations: exactly
+    // the TWO_CONTS bit, which xor clears where it is expected and raises where it is not.
+    __m256i third  = _mm256_subs_epu8(KL_PREV_AVX2(in, prev, 2), _mm256_set1_epi8((char)(0xE0 - 0x80)));
+    __m256i fourth = _mm256_subs_epu8(KL_PREV_AVX2(in, prev, 3), _mm256_set1_epi8((char)(0xF0 - 0x80)));
+    __m256i must23 = _mm256_and_si256(_mm256_or_si256(third, fourth), _mm256_set1_epi8((char)0x80));
+    return _mm256_xor_si256(must23, special);
+}
+
+STR_AVX2 static bool utf8_valid_avx2(const uint8_t *p, size_t len)
+{
+    // Lead bytes too close to the end of a vector to be complete in it.
+    const __m256i maxTail = _mm256_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                             -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                             (char)(0xF0 - 1), (char)(0xE0 - 1), (char)(0xC0 - 1));
+    __m256i err = _mm256_setzero_si256(), prev = err, incomplete = err;
+    size_t i = 0;
+    for (; len - i >= 32u; i += 32u) {
+        __m256i in = _mm256_loadu_si256((const __m256i *)(p + i));
+        if (_mm256_movemask_epi8(in) == 0) {
+            err = _mm256_or_si256(err, incomplete);     // ASCII cannot finish what prev started
+        } else {
+            err = _mm256_or_si256(err, kl_check_avx2(in, prev));
+            incomplete = _mm256_subs_epu8(in, maxTail);
+        }
+        prev = in;
+    }
+    if (i < len) {
+        // Zero padding is ASCII: a sequence the tail leaves open fails as TOO_SHORT.
+        uint8_t tail[32] = {0};
+        memcpy(tail, p + i, len - i);
+        err = _mm256_or_si256(err, kl_check_avx2(_mm256_loadu_si256((const __m256i *)tail), prev));
+    } else {
+        err = _mm256_or_si256(err, incomplete);
+    }
+    return _mm256_testz_si256(err, err) != 0;
+}
+#endif
+
+
+/* AArch64: NEON */
+
+#ifdef STR_NEON
+// One bit per byte lane (bit 4k + 3), from a 0x00/0xFF compare result.
+static inline uint64_t neon_mask(uint8x16_t eq)
+{
+    uint8x8_t nibbles = vshrn_n_u16(vreinterpretq_u16_u8(eq), 4);
+    return vget_lane_u64(vreinterpret_u64_u8(nibbles), 0) & UINT64_C(0x8888888888888888);
+}
+
+static size_t find_neon(const char *hay, size_t len, const char *nd, size_t ndLen, size_t from)
+{
+    const uint8x16_t first = vdupq_n_u8((uint8_t)nd[0]);
+    const uint8x16_t last  = vdupq_n_u8((uint8_t)nd[ndLen - 1u]);
+    size_t end = len - ndLen + 1u;
+    size_t i   = from;
+    for (; end - i >= 16u; i += 16u) {
+        uint8x16_t a = vld1q_u8((const uint8_t *)hay + i);
+        uint8x16_t b = vld1q_u8((const uint8_t *)hay + i + ndLen - 1u);
+        for (uint64_t mask = neon_mask(vandq_u8(vceqq_u8(a, first), vceqq_u8(b, last))); mask != 0;
+             mask &= mask - 1u) {
+            size_t at = i + (size_t)(__builtin_ctzll(mask) >> 2);
+            if (memcmp(hay + at + 1u, nd + 1u, ndLen - 2u) == 0)
+                return at;
+        }
+    }
+    return anostr_find_scalar_(hay, len, nd, ndLen, i);
+}
+
+static size_t rune_count_neon(const uint8_t *p, size_t len)
+{
+    const int8x16_t cont = vdupq_n_s8(-65);
+    size_t count = 0, i = 0;
+    for (; len - i >= 16u; i += 16u) {
+        uint8x16_t starts = vcgtq_s8(vreinterpretq_s8_u8(vld1q_u8(p + i)), cont);
+        count += vaddvq_u8(vshrq_n_u8(starts, 7));
+    }
+    return count + anostr_rune_count_scalar_(p + i, len - i);
+}
+
+static inline uint8x16_t kl_check_neon(uint8x16_t in, uint8x16_t prev)
+{
+    static const uint8_t byte1High[16] = { KL_BYTE_1_HIGH };
+    static const uint8_t byte1Low[16]  = { KL_BYTE_1_LOW };
+    static const uint8_t byte2High[16] = { KL_BYTE_2_HIGH };
+    uint8x16_t prev1 = vextq_u8(prev, in, 15);
+    uint8x16_t special = vandq_u8(vandq_u8(vqtbl1q_u8(vld1q_u8(byte1High), vshrq_n_u8(prev1, 4)),
+                                           vqtbl1q_u8(vld1q_u8(byte1Low), vandq_u8(prev1, vdupq_n_u8(0x0F)))),
+                                  vqtbl1q_u8(vld1q_u8(byte2High), vshrq_n_u8(in, 4)));
+    uint8x16_t third  = vqsubq_u8(vextq_u8(prev, in, 14), vdupq_n_u8(0xE0 - 0x80));
+    uint8x16_t fourth = vqsubq_u8(vextq_u8(prev, in, 13), vdupq_n_u8(0xF0 - 0x80));
+    uint8x16_t must23 = vandq_u8(vorrq_u8(third, fourth), vdupq_n_u8(0x80));
+    return veorq_u8(must23, special);
+}
+
+static bool utf8_valid_neon(const uint8_t *p, size_t len)
+{
+    static const uint8_t maxTailBytes[16] = { 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+                                              255, 0xF0 - 1, 0xE0 - 1, 0xC0 - 1 };
+    const uint8x16_t maxTail = vld1q_u8(maxTailBytes);
+    uint8x16_t err = vdupq_n_u8(0), prev = err, incomplete = err;
+    size_t i = 0;
+    for (; len - i >= 16u; i += 16u) {
+        uint8x16_t in = vld1q_u8(p + i);
+        if (vmaxvq_u8(in) < 0x80u) {
+            err = vorrq_u8(err, incomplete);
+        } else {
+            err = vorrq_u8(err, kl_check_neon(in, prev));
+            incomplete = vqsubq_u8(in, maxTail);
+        }
+        prev = in;
+    }
+    if (i < len) {
+        uint8_t tail[16] = {0};
+        memcpy(tail, p + i, len - i);
+        err = vorrq_u8(err, kl_check_neon(vld1q_u8(tail), prev));
+    } else {
+        err = vorrq_u8(err, incomplete);
+    }
+    return vmaxvq_u8(err) == 0;
+}
+#endif
+
+
+/* Dispatch */
+
+static const anostr_kernels_t kScalar = {
+    ANOSTR_SIMD_SCALAR, anostr_find_scalar_, anostr_rune_count_scalar_, anostr_utf8_valid_scalar_,
+};
+#ifdef STR_X86
+static const anostr_kernels_t kSse2 = { ANOSTR_SIMD_SSE2, find_sse2, rune_count_sse2, utf8_valid_sse2 };
+static const anostr_kernels_t kAvx2 = { ANOSTR_SIMD_AVX2, find_avx2, rune_count_avx2, utf8_valid_avx2 };
+#endif
+#ifdef STR_NEON
+static const anostr_kernels_t kNeon = { ANOSTR_SIMD_NEON, find_neon, rune_count_neon, utf8_valid_neon };
+#endif
+
+const anostr_kernels_t *_Atomic anostr_kernels_;
+
+// The kernels for tier, or NULL when this build or CPU lacks it.
+static const anostr_kernels_t *kernels_for(anostr_simd_t tier)
+{
+    switch (tier) {
+    case ANOSTR_SIMD_SCALAR:
+        return &kScalar;
+#ifdef STR_X86
+    case ANOSTR_SIMD_SSE2:
+        return &kSse2;
+    case ANOSTR_SIMD_AVX2:
+        return __builtin_cpu_supports("avx2") ? &kAvx2 : NULL;
+#endif
+#ifdef STR_NEON
+    case ANOSTR_SIMD_NEON:
+        return &kNeon;
+#endif
+    default:
+        return NULL;
+    }
+}
+
+// Racing first calls all pick the same table, so the store needs no ordering.
+const anostr_kernels_t *anostr_kernels_pick_(void)
+{
+    static const anostr_simd_t widest[] = { ANOSTR_SIMD_AVX2, ANOSTR_SIMD_NEON, ANOSTR_SIMD_SSE2 };
+    const anostr_kernels_t *k = &kScalar;
+    for (size_t i = 0; i < sizeof widest / sizeof widest[0] && k == &kScalar; i++) {
+        const anostr_kernels_t *candidate = kernels_for(widest[i]);
+        if (candidate != NULL)
+            k = candidate;
+    }
+    atomic_store_explicit(&anostr_kernels_, k, memory_order_relaxed);
+    return k;
+}
+
+anostr_simd_t anostr_simd(void)
+{
+    return anostr_kernels()->tier;
+}
+
+anostr_simd_t anostr_simd_force(anostr_simd_t tier)
+{
+    const anostr_kernels_t *k = kernels_for(tier);
+    if (k == NULL)
+        return anostr_simd();
+    atomic_store_explicit(&anostr_kernels_, k, memory_order_relaxed);
+    return k->tier;
+}
@@ -9,6 +9,7 @@
 
 #include "anoptic_strings_utf.h"
 
+#include "strings/ano_strings_internal.h"
 #include "strings/ano_unicode_tables.h"
 
 // Decode core.
@@ -97,20 +98,29 @@ anorune_t anostr_rune_prev(anostr_t s, size_t *i)
 
 size_t anostr_rune_count(anostr_t s)
 {
-    const uint8_t *p = (const uint8_t *)anostr_bytes(&s);
+    return anostr_kernels()->runeCount((const uint8_t *)anostr_bytes(&s), s.len);
+}
+
+bool anostr_utf8_valid(anostr_t s)
+{
+    return anostr_kernels()->utf8Valid((const uint8_t *)anostr_bytes(&s), s.len);
+}
+
+// Every byte but a continuation byte starts a rune.
+size_t anostr_rune_count_scalar_(const uint8_t *p, size_t len)
+{
     size_t count = 0;
-    for (uint32_t i = 0; i < s.len; i++)
+    for (size_t i = 0; i < len; i++)
         count += (p[i] & 0xC0u) != 0x80u;
     return count;
 }
 
-bool anostr_utf8_valid(anostr_t s)
+bool anostr_utf8_valid_scalar_(const uint8_t *p, size_t len)
 {
-    const uint8_t *p = (const uint8_t *)anostr_bytes(&s);
     size_t i = 0;
-    while (i < s.len) {
+    while (i < len) {
         anorune_t r;
-        int consumed = utf8_decode(p + i, s.len - i, &r);
+        int consumed = utf8_decode(p + i, len - i, &r);
         if (consumed == 0)
             return false;
         i += (size_t)consumed;
@@ -341,7 +351,7 @@ anostr_t anostr_rune_sort(mi_heap_t *heap, anostr_t s)
     }
 
     // At most len runes. Malformed bytes decode to U+FFFD.
-    anorune_t *runes = mi_malloc((size_t)s.len * sizeof *runes);
+    anorune_t *runes = ano_tmalloc(&g_strMem, (size_t)s.len * sizeof *runes);
     if (runes == NULL)
         return anostr_empty();
     size_t n = 0;
@@ -350,7 +360,7 @@ anostr_t anostr_rune_sort(mi_heap_t *heap, anostr_t s)
     qsort(runes, n, sizeof runes[0], rune_cmp_);
 
     anostr_t out = anostr_from_utf32(heap, runes, n);
-    mi_free(runes);
+    ano_tfree(&g_strMem, runes);
     return out;
 }
 
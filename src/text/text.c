@@ -14,6 +14,7 @@
 #include <stddef.h>
 #include <string.h>
 
+#include "anoptic_filesystem.h"
 #include "anoptic_log.h"
 #include "anoptic_memory.h"
 #include "anoptic_strings.h"
@@ -27,28 +28,30 @@
 #define ANO_TEXT_MAX_FONTS 8u
 
 static mi_heap_t           *g_textHeap;  // owns every FreeType allocation
+static ano_mem_tag_t        g_textMem = ANO_MEM_TAG("text"); // FreeType's allocations, bound to g_textHeap
 static struct FT_MemoryRec_ g_ftMemory;  // hook table handed to FT_New_Library
 static FT_Library           g_ftLibrary; // non-NULL <=> module initialized
 static FT_Face              g_faces[ANO_TEXT_MAX_FONTS]; // slot i <-> AnoFontId i+1
+static ano_fs_cache_key     g_faceSource[ANO_TEXT_MAX_FONTS]; // content key of each face's file
+static bool                 g_faceKeyed[ANO_TEXT_MAX_FONTS];  // false: unreadable, bakes uncached
 
-// FT_Alloc_Func: malloc into the module heap.
+// FT_Alloc_Func: malloc into the module heap, counted under "text".
 static void *text_ft_alloc(FT_Memory memory, long size)
 {
-    return mi_heap_malloc(memory->user, (size_t)size);
+    return ano_tmalloc(memory->user, (size_t)size);
 }
 
 // FT_Free_Func: mimalloc resolves the owning heap from the block itself.
 static void text_ft_free(FT_Memory memory, void *block)
 {
-    (void)memory;
-    mi_free(block);
+    ano_tfree(memory->user, block);
 }
 
 // FT_Realloc_Func: mimalloc tracks sizes itself, cur_size is unneeded.
 static void *text_ft_realloc(FT_Memory memory, long cur_size, long new_size, void *block)
 {
     (void)cur_size;
-    return mi_heap_realloc(memory->user, block, (size_t)new_size);
+    return ano_trealloc(memory->user, block, (size_t)new_size);
 }
 
 // Creates the module heap and a FreeType library routed through it, registers the
@@ -62,7 +65,8 @@ int ano_text_init(void)
     if (g_textHeap == NULL)
         return ENOMEM;
 
-    g_ftMemory.user    = g_textHeap;
+    ano_mem_tag_bind(&g_textMem, g_textHeap);
+    g_ftMemory.user    = &g_textMem;
     g_ftMemory.alloc   = text_ft_alloc;
     g_ftMemory.free    = text_ft_free;
     g_ftMemory.realloc = text_ft_realloc;
@@ -74,6 +78,7 @@ int ano_text_init(void)
         ano_log(ANO_ERROR, "text: FT_New_Library failed: %d (%s)", (int)err, msg ? msg : "?");
         g_ftLibrary = NULL;
         mi_heap_destroy(g_textHeap);
+        ano_mem_tag_release(&g_textMem);
         g_textHeap = NULL;
         return EIO;
     }
@@ -106,6 +111,7 @@ void ano_text_shutdown(void)
     if (g_textHeap != NULL)
     {
         mi_heap_destroy(g_textHeap);
+        ano_mem_tag_release(&g_textMem);
         g_textHeap = NULL;
     }
 }
@@ -171,6 +177,17 @@ AnoFontId ano_text_font_load(anostr_t path)
         return 0;
     }
 
+    // The face's bytes key its bakes in the derived-data cache: same file, same bake.
+    size_t fileSize = 0;
+    const void *file = ano_fs_map_read(cpath, &fileSize);
+    g_faceKeyed[slot] = file != NULL;
+    if (file != NULL)
+    {
+        g_faceSource[slot] = ano_fs_cache_key_begin("fontface", 1u);
+        ano_fs_cache_key_add(&g_faceSource[slot], file, fileSize);
+        ano_fs_unmap(file, fileSize);
+    }
+
     g_faces[slot] = face;
     ano_log(ANO_INFO, "text: loaded '%s' (%ld glyphs, upem %u)", cpath, (long)face->num_glyphs,
                  (unsigned)face->units_per_EM);
@@ -186,6 +203,15 @@ void *ano_text_face(AnoFontId font)
     return g_faces[font - 1u];
 }
 
+// Internal: the content key of a face's font file, false when invalid or unread.
+bool ano_text_face_source(AnoFontId font, ano_fs_cache_key *key)
+{
+    if (font == 0 || font > ANO_TEXT_MAX_FONTS || g_faces[font - 1u] == NULL || !g_faceKeyed[font - 1u])
+        return false;
+    *key = g_faceSource[font - 1u];
+    return true;
+}
+
 // Internal ground truth for the reference rasterizer: FreeType's own smooth AA render
 // (unhinted) copied tightly into buf. Sets pixel sizes on the face. Module thread.
 int ano_text_ref_ft_render(AnoFontId font, uint32_t codepoint, uint32_t pixelsPerEm,
@@ -504,11 +504,11 @@ static int bake_kerns(mi_heap_t *scratch, mi_heap_t *heap, const AnoGlyphEntry *
     return 0;
 }
 
-// Bake entry point, module thread. Temporaries live on a scoped scratch heap.
+// The bake proper, module thread. Temporaries live on a scoped scratch heap.
 // Only the result blobs land in the caller's heap.
 
-int ano_text_font_bake_ranges(const AnoBakeRange *ranges, uint32_t rangeCount,
-                              mi_heap_t *heap, AnoFontBake *out)
+static int bake_ranges(const AnoBakeRange *ranges, uint32_t rangeCount,
+                       mi_heap_t *heap, AnoFontBake *out)
 {
     if (ranges == NULL || rangeCount == 0 || heap == NULL || out == NULL)
         return EINVAL;
@@ -663,6 +663,162 @@ int ano_text_font_bake_ranges(const AnoBakeRange *ranges, uint32_t rangeCount,
     return 0;
 }
 
+// Derived-data cache. A bake is a pure function of its faces' bytes, the requested ranges, the
+// FreeType that decomposed the outlines and this file's code, so those make the key. Bump
+// BAKE_CACHE_VERSION with any change to the bake's output or to the blob layout below.
+//
+// Blob: BakeBlobHeader | points u32[pointCount] | glyphs[glyphCount] | ranges[rangeCount] | kerns[kernCount]
+
+#define BAKE_CACHE_VERSION 1u
+
+typedef struct BakeBlobHeader {
+    uint32_t pointCount, glyphCount, rangeCount, kernCount;
+    float    ascender, descender, lineHeight;
+    uint32_t upem;
+} BakeBlobHeader;
+
+static bool bake_cache_key(const AnoBakeRange *ranges, uint32_t rangeCount, ano_fs_cache_key *key)
+{
+    int ft[3];
+    ano_text_version(&ft[0], &ft[1], &ft[2]);
+    *key = ano_fs_cache_key_begin("fontbake", BAKE_CACHE_VERSION);
+    ano_fs_cache_key_add(key, ft, sizeof ft);
+    for (uint32_t r = 0; r < rangeCount; r++)
+    {
+        ano_fs_cache_key face;
+        if (!ano_text_face_source(ranges[r].font, &face))
+            return false;
+        uint32_t span[2] = { ranges[r].first, ranges[r].last };
+        ano_fs_cache_key_add(key, &face, sizeof face);
+        ano_fs_cache_key_add(key, span, sizeof span);
+    }
+    return true;
+}
+
+static void bake_cache_put(const ano_fs_cache_key *key, const AnoFontBake *b)
+{
+    BakeBlobHeader h = { .pointCount = b->pointCount, .glyphCount = b->glyphCount,
+                         .rangeCount = b->rangeCount, .kernCount = b->kernCount,
+                         .ascender = b->ascender, .descender = b->descender,
+                         .lineHeight = b->lineHeight, .upem = b->upem };
+    ano_fs_cache_writer *w = ano_fs_cache_put_begin(key);
+    if (w == NULL)
+        return;
+    int rc = ano_fs_cache_put_write(w, &h, sizeof h)
+          | ano_fs_cache_put_write(w, b->points, (size_t)b->pointCount * sizeof(uint32_t))
+          | ano_fs_cache_put_write(w, b->glyphs, (size_t)b->glyphCount * sizeof(AnoGlyphEntry))
+          | ano_fs_cache_put_write(w, b->ranges, (size_t)b->rangeCount * sizeof(AnoGlyphRange))
+          | ano_fs_cache_put_write(w, b->kerns, (size_t)b->kernCount * sizeof(AnoKernPair));
+    ano_fs_cache_put_end(w, rc == 0);
+}
+
+// A cached bake into the caller's heap, laid out as bake_ranges lays it out. The blob passed its
+// checksum; this checks it answers this request and that every offset the shaper and the
+// shaders follow stays in range. EIO for a blob that does not, ENOMEM.
+static int bake_from_blob(const ano_fs_cache_blob *blob, const AnoBakeRange *ranges,
+                          uint32_t rangeCount, mi_heap_t *heap, AnoFontBake *out)
+{
+    BakeBlobHeader h;
+    if (blob->size < sizeof h)
+        return EIO;
+    memcpy(&h, blob->data, sizeof h);
+    uint64_t size = sizeof h + (uint64_t)h.pointCount * sizeof(uint32_t)
+                  + (uint64_t)h.glyphCount * sizeof(AnoGlyphEntry)
+                  + (uint64_t)h.rangeCount * sizeof(AnoGlyphRange)
+                  + (uint64_t)h.kernCount * sizeof(AnoKernPair);
+    if (size != blob->size || h.rangeCount != rangeCount || h.glyphCount == 0)
+        return EIO;
+
+    const uint8_t *at = (const uint8_t *)blob->data + sizeof h;
+    const uint8_t *pointsAt = at;
+    const uint8_t *glyphsAt = pointsAt + (size_t)h.pointCount * sizeof(uint32_t);
+    const uint8_t *rangesAt = glyphsAt + (size_t)h.glyphCount * sizeof(AnoGlyphEntry);
+    const uint8_t *kernsAt  = rangesAt + (size_t)h.rangeCount * sizeof(AnoGlyphRange);
+
+    uint32_t slot = 0;
+    for (uint32_t r = 0; r < rangeCount; r++)
+    {
+        AnoGlyphRange g;
+        memcpy(&g, rangesAt + (size_t)r * sizeof g, sizeof g);
+        if (g.first != ranges[r].first || g.last != ranges[r].last || g.slotBase != slot)
+            return EIO;
+        slot += g.last - g.first + 1u;
+    }
+    if (slot != h.glyphCount)
+        return EIO;
+    for (uint32_t i = 0; i < h.glyphCount; i++)
+    {
+        AnoGlyphEntry e;
+        memcpy(&e, glyphsAt + (size_t)i * sizeof e, sizeof e);
+        if (e.pointOffset > h.pointCount
+            || (e.curveCount > 0 && (uint64_t)e.curveCount * 2u >= (uint64_t)h.pointCount - e.pointOffset))
+            return EIO;
+    }
+    for (uint32_t k = 0; k < h.kernCount; k++)
+    {
+        AnoKernPair kp;
+        memcpy(&kp, kernsAt + (size_t)k * sizeof kp, sizeof kp);
+        if ((kp.key >> 16) >= h.glyphCount || (kp.key & 0xFFFFu) >= h.glyphCount)
+            return EIO;
+    }
+
+    memset(out, 0, sizeof *out);
+    AnoGlyphEntry *glyphs = mi_heap_malloc(heap, (size_t)h.glyphCount * sizeof(AnoGlyphEntry));
+    AnoGlyphRange *map = mi_heap_malloc(heap, (size_t)rangeCount * sizeof(AnoGlyphRange));
+    uint32_t *points = h.pointCount ? mi_heap_malloc(heap, (size_t)h.pointCount * sizeof(uint32_t)) : NULL;
+    AnoKernPair *kerns = h.kernCount ? mi_heap_malloc(heap, (size_t)h.kernCount * sizeof(AnoKernPair)) : NULL;
+    if (glyphs == NULL || map == NULL || (h.pointCount && points == NULL) || (h.kernCount && kerns == NULL))
+    {
+        mi_free(glyphs);
+        mi_free(map);
+        mi_free(points);
+        mi_free(kerns);
+        return ENOMEM;
+    }
+    memcpy(glyphs, glyphsAt, (size_t)h.glyphCount * sizeof(AnoGlyphEntry));
+    memcpy(map, rangesAt, (size_t)rangeCount * sizeof(AnoGlyphRange));
+    if (points)
+        memcpy(points, pointsAt, (size_t)h.pointCount * sizeof(uint32_t));
+    if (kerns)
+        memcpy(kerns, kernsAt, (size_t)h.kernCount * sizeof(AnoKernPair));
+
+    out->points     = points;
+    out->pointCount = h.pointCount;
+    out->glyphs     = glyphs;
+    out->glyphCount = h.glyphCount;
+    out->ranges     = map;
+    out->rangeCount = rangeCount;
+    out->kerns      = kerns;
+    out->kernCount  = h.kernCount;
+    out->ascender   = h.ascender;
+    out->descender  = h.descender;
+    out->lineHeight = h.lineHeight;
+    out->upem       = h.upem;
+    return 0;
+}
+
+// Bake entry point: the derived-data cache first, the bake on a miss, whose result is stored.
+int ano_text_font_bake_ranges(const AnoBakeRange *ranges, uint32_t rangeCount,
+                              mi_heap_t *heap, AnoFontBake *out)
+{
+    ano_fs_cache_key key;
+    bool keyed = ranges != NULL && rangeCount > 0 && heap != NULL && out != NULL
+              && bake_cache_key(ranges, rangeCount, &key);
+    ano_fs_cache_blob blob;
+    if (keyed && ano_fs_cache_get(&key, &blob))
+    {
+        int rc = bake_from_blob(&blob, ranges, rangeCount, heap, out);
+        ano_fs_cache_release(&blob);
+        if (rc == 0)
+            return 0;
+        ano_log(ANO_WARN, "text: cached bake rejected (%d); baking afresh", rc);
+    }
+    int rc = bake_ranges(ranges, rangeCount, heap, out);
+    if (rc == 0 && keyed)
+        bake_cache_put(&key, out);
+    return rc;
+}
+
 int ano_text_font_bake(AnoFontId font, uint32_t firstCodepoint, uint32_t lastCodepoint,
                        mi_heap_t *heap, AnoFontBake *out)
 {
@@ -9,14 +9,20 @@
 #ifndef ANO_TEXT_INTERNAL_H
 #define ANO_TEXT_INTERNAL_H
 
+#include <stdbool.h>
 #include <stdint.h>
 
+#include "anoptic_filesystem.h"
 #include "anoptic_text.h"
 
 // Backing FT_Face for a font handle as an opaque pointer, NULL when invalid or the
 // module is down. Implemented in text.c.
 void *ano_text_face(AnoFontId font);
 
+// Content key of the font file behind a handle (ano_fs_cache_key_begin("fontface") over its
+// bytes), read at load. False when the handle is invalid or the file could not be read back.
+bool ano_text_face_source(AnoFontId font, ano_fs_cache_key *key);
+
 // Reports the FreeType version through any non-NULL pointers, all zeros before init.
 void ano_text_version(int *major, int *minor, int *patch);
 
@@ -8,10 +8,12 @@
 // AnoFontBake, callable from any thread. Ligatures, marks, and bidi are non-goals.
 
 #include "anoptic_text.h"
-#include "anoptic_strings_utf.h"
+#include "anoptic_strings_rope.h"
+#include "anoptic_profiler.h"
 #include "text/text_internal.h"
 
 #include <math.h>
+#include <string.h>
 
 uint32_t ano_text_bake_slot(const AnoFontBake *bake, uint32_t codepoint)
 {
@@ -48,88 +50,178 @@ float ano_text_kern(const AnoFontBake *bake, uint32_t leftSlot, uint32_t rightSl
                                                                 : 0.0f;
 }
 
-// The single pen walk behind shape/measure x plain/runs. Assumes validated args.
+// Pen state of one shaping walk. The flat and rope walks differ only in how they read runes.
 // One pen crosses run boundaries untouched. The pair-kern chain survives a boundary
-// iff the size is unchanged. Returns the total instance count. Optionally reports the
-// pen, the widest line, started-line count, and the last run's line step.
+// iff the size is unchanged.
+typedef struct shape_state_t {
+    const AnoFontBake *bake;
+    const AnoTextRun  *runs;
+    uint32_t           runCount, runIdx;
+    size_t             runEnd;
+    float              originX, penX, penY, maxW;
+    uint32_t           lines, needed, emitted;
+    AnoGlyphInstance  *out;
+    uint32_t           cap;
+    uint32_t           prevSlot;  // pair-kern chain, broken by newline/gap/size change
+    float              prevSize;  // the sizePx that shaped prevSlot
+} shape_state_t;
+
+static void shape_begin(shape_state_t *st, const AnoFontBake *bake,
+                        const AnoTextRun *runs, uint32_t runCount, size_t total,
+                        const float origin[2], AnoGlyphInstance *out, uint32_t cap)
+{
+    *st = (shape_state_t){
+        .bake = bake, .runs = runs, .runCount = runCount, .runEnd = runs[0].byteCount,
+        .originX = origin[0], .penX = origin[0], .penY = origin[1],
+        .lines = total > 0 ? 1u : 0u, .out = out, .cap = cap, .prevSlot = UINT32_MAX,
+    };
+}
+
+// One decoded codepoint whose lead byte sits at text offset `at`.
+static inline void shape_rune(shape_state_t *st, size_t at, anorune_t cp)
+{
+    while (at >= st->runEnd && st->runIdx + 1 < st->runCount)
+    {
+        st->runIdx++;
+        st->runEnd += st->runs[st->runIdx].byteCount;
+    }
+    const AnoFontBake *bake = st->bake;
+    const AnoTextRun *run = &st->runs[st->runIdx];
+    float sizePx = run->sizePx; // the lead byte's run styles the codepoint
+    if (cp == '\r')
+        return;
+    if (cp == '\n')
+    {
+        st->maxW = fmaxf(st->maxW, st->penX - st->originX);
+        st->penX = st->originX;
+        st->penY += bake->lineHeight * sizePx;
+        st->lines++;
+        st->prevSlot = UINT32_MAX;
+        return;
+    }
+    uint32_t slot = ano_text_bake_slot(bake, cp);
+    if (slot == ANO_TEXT_SLOT_NONE)
+    {
+        st->penX += ANO_TEXT_GAP_EM * sizePx;
+        st->prevSlot = UINT32_MAX;
+        return;
+    }
+    if (st->prevSlot != UINT32_MAX && sizePx == st->prevSize)
+        st->penX += ano_text_kern(bake, st->prevSlot, slot) * sizePx;
+    st->prevSlot = slot;
+    st->prevSize = sizePx;
+    const AnoGlyphEntry *e = &bake->glyphs[slot];
+    if (e->curveCount > 0)
+    {
+        st->needed++;
+        if (st->out != NULL && st->emitted < st->cap)
+        {
+            st->out[st->emitted++] = (AnoGlyphInstance){
+                .inv     = { 1.0f / sizePx, 0.0f, 0.0f, -1.0f / sizePx },
+                .color   = { run->color[0], run->color[1], run->color[2], run->color[3] },
+                .origin  = { st->penX, st->penY },
+                .glyphID = slot,
+                .flags   = 0,
+            };
+        }
+    }
+    st->penX += e->advance * sizePx;
+}
+
+// Returns the total instance count. Optionally reports the pen, the widest line,
+// started-line count, and the last run's line step.
+static uint32_t shape_end(shape_state_t *st, float *penOut, float *maxWOut,
+                          uint32_t *linesOut, float *endStepOut)
+{
+    st->maxW = fmaxf(st->maxW, st->penX - st->originX);
+    if (penOut != NULL)
+    {
+        penOut[0] = st->penX;
+        penOut[1] = st->penY;
+    }
+    if (maxWOut != NULL)
+        *maxWOut = st->maxW;
+    if (linesOut != NULL)
+        *linesOut = st->lines;
+    if (endStepOut != NULL)
+        *endStepOut = st->bake->lineHeight * st->runs[st->runCount - 1].sizePx;
+    return st->needed;
+}
+
+// The single pen walk behind shape/measure x plain/runs. Assumes validated args.
 static uint32_t shape_core(const AnoFontBake *bake, anostr_t text,
                            const AnoTextRun *runs, uint32_t runCount,
                            const float origin[2], AnoGlyphInstance *out, uint32_t cap,
                            float *penOut, float *maxWOut, uint32_t *linesOut,
                            float *endStepOut)
 {
+    ANO_PROFILE_SCOPE("text.shape");   // every shaping entry point, measure passes included
     size_t total = anostr_len(text);
-    float penX = origin[0], penY = origin[1];
-    float maxW = 0.0f;
-    uint32_t lines = total > 0 ? 1u : 0u;
-    uint32_t needed = 0, emitted = 0;
-    size_t runEnd = runs[0].byteCount;
-    uint32_t runIdx = 0;
-    uint32_t prevSlot = UINT32_MAX; // pair-kern chain, broken by newline/gap/size change
-    float prevSize = 0.0f;          // the sizePx that shaped prevSlot
-
+    shape_state_t st;
+    shape_begin(&st, bake, runs, runCount, total, origin, out, cap);
     for (size_t i = 0; i < total;)
     {
-        while (i >= runEnd && runIdx + 1 < runCount)
+        size_t at = i;
+        shape_rune(&st, at, anostr_rune_next(text, &i));
+    }
+    return shape_end(&st, penOut, maxWOut, linesOut, endStepOut);
+}
+
+// The same walk over rope bytes [from, to), one chunk at a time. Runes decode straight from
+// the chunk; only the last three bytes of a chunk, where a rune may run into the next one,
+// decode from a window gathered across chunks, the same (up to) four bytes the flat walk sees.
+static uint32_t shape_rope_core(const AnoFontBake *bake, const anostr_rope_t *rope,
+                                size_t from, size_t to, const AnoTextRun *run,
+                                const float origin[2], AnoGlyphInstance *out, uint32_t cap,
+                                float *penOut, float *maxWOut, uint32_t *linesOut)
+{
+    ANO_PROFILE_SCOPE("text.shape");
+    shape_state_t st;
+    shape_begin(&st, bake, run, 1, to - from, origin, out, cap);
+    anostr_rope_iter_t it = anostr_rope_chunks(rope, from, to);
+    anostr_t chunk;
+    size_t at = 0;      // text offset of chunk[i]
+    size_t i = 0;
+    bool more = anostr_rope_next_chunk(&it, &chunk);
+    while (more)
+    {
+        if (chunk.len - i >= 4)
         {
-            runIdx++;
-            runEnd += runs[runIdx].byteCount;
-        }
-        float sizePx = runs[runIdx].sizePx; // the lead byte's run styles the codepoint
-        anorune_t cp = anostr_rune_next(text, &i);
-        if (cp == '\r')
+            size_t lead = i;
+            anorune_t cp = anostr_rune_next(chunk, &i);
+            shape_rune(&st, at, cp);
+            at += i - lead;
             continue;
-        if (cp == '\n')
+        }
+        if (i == chunk.len)
         {
-            maxW = fmaxf(maxW, penX - origin[0]);
-            penX = origin[0];
-            penY += bake->lineHeight * sizePx;
-            lines++;
-            prevSlot = UINT32_MAX;
+            more = anostr_rope_next_chunk(&it, &chunk);
+            i = 0;
             continue;
         }
-        uint32_t slot = ano_text_bake_slot(bake, cp);
-        if (slot == ANO_TEXT_SLOT_NONE)
+        char window[4];
+        size_t got = chunk.len - i;
+        memcpy(window, anostr_bytes(&chunk) + i, got);
+        anostr_rope_iter_t peek = it;
+        for (anostr_t c; got < sizeof window && anostr_rope_next_chunk(&peek, &c); )
         {
-            penX += ANO_TEXT_GAP_EM * sizePx;
-            prevSlot = UINT32_MAX;
-            continue;
+            size_t n = c.len < sizeof window - got ? c.len : sizeof window - got;
+            memcpy(window + got, anostr_bytes(&c), n);
+            got += n;
         }
-        if (prevSlot != UINT32_MAX && sizePx == prevSize)
-            penX += ano_text_kern(bake, prevSlot, slot) * sizePx;
-        prevSlot = slot;
-        prevSize = sizePx;
-        const AnoGlyphEntry *e = &bake->glyphs[slot];
-        if (e->curveCount > 0)
+        size_t k = 0;
+        anorune_t cp = anostr_rune_next(anostr_view(window, got), &k);
+        shape_rune(&st, at, cp);
+        at += k;
+        while (k > chunk.len - i)     // the rune ran on into the following chunk(s)
         {
-            needed++;
-            if (out != NULL && emitted < cap)
-            {
-                out[emitted++] = (AnoGlyphInstance){
-                    .inv     = { 1.0f / sizePx, 0.0f, 0.0f, -1.0f / sizePx },
-                    .color   = { runs[runIdx].color[0], runs[runIdx].color[1],
-                                 runs[runIdx].color[2], runs[runIdx].color[3] },
-                    .origin  = { penX, penY },
-                    .glyphID = slot,
-                    .flags   = 0,
-                };
-            }
+            k -= chunk.len - i;
+            anostr_rope_next_chunk(&it, &chunk);
+            i = 0;
         }
-        penX += e->advance * sizePx;
-    }
-    maxW = fmaxf(maxW, penX - origin[0]);
-    if (penOut != NULL)
-    {
-        penOut[0] = penX;
-        penOut[1] = penY;
+        i += k;
     }
-    if (maxWOut != NULL)
-        *maxWOut = maxW;
-    if (linesOut != NULL)
-        *linesOut = lines;
-    if (endStepOut != NULL)
-        *endStepOut = bake->lineHeight * runs[runCount - 1].sizePx;
-    return needed;
+    return shape_end(&st, penOut, maxWOut, linesOut, NULL);
 }
 
 // Rejects NULL runs, an empty run list, any non-positive size, and a byteCount sum
@@ -205,3 +297,43 @@ void ano_text_measure_runs(const AnoFontBake *bake, anostr_t text,
     if (height != NULL)
         *height = h;
 }
+
+// Clamps [*from, *to) to the rope. False when the run length would not fit a u32.
+static bool rope_range(const anostr_rope_t *rope, size_t *from, size_t *to)
+{
+    size_t len = anostr_rope_len(rope);
+    *to = *to < len ? *to : len;
+    *from = *from < *to ? *from : *to;
+    return *to - *from <= UINT32_MAX;
+}
+
+uint32_t ano_text_shape_rope(const AnoFontBake *bake, const anostr_rope_t *rope,
+                             size_t from, size_t to,
+                             float sizePx, const float origin[2], const float color[4],
+                             AnoGlyphInstance *out, uint32_t cap, float *penOut)
+{
+    if (bake == NULL || rope == NULL || origin == NULL || color == NULL || sizePx <= 0.0f
+        || !rope_range(rope, &from, &to))
+        return 0;
+    AnoTextRun run = { .byteCount = (uint32_t)(to - from), .sizePx = sizePx,
+                       .color = { color[0], color[1], color[2], color[3] } };
+    return shape_rope_core(bake, rope, from, to, &run, origin, out, cap, penOut, NULL, NULL);
+}
+
+void ano_text_measure_rope(const AnoFontBake *bake, const anostr_rope_t *rope,
+                           size_t from, size_t to, float sizePx, float *width, float *height)
+{
+    float maxW = 0.0f;
+    uint32_t lines = 0;
+    if (bake != NULL && rope != NULL && sizePx > 0.0f && rope_range(rope, &from, &to)
+        && to > from)
+    {
+        AnoTextRun run = { .byteCount = (uint32_t)(to - from), .sizePx = sizePx };
+        const float zero[2] = { 0.0f, 0.0f };
+        shape_rope_core(bake, rope, from, to, &run, zero, NULL, 0, NULL, &maxW, &lines);
+    }
+    if (width != NULL)
+        *width = maxW;
+    if (height != NULL)
+        *height = (float)lines * (bake != NULL ? bake->lineHeight : 0.0f) * sizePx;
+}
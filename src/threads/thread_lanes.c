@@ -0,0 +1,83 @@
+/* SPDX-FileCopyrightText: 2026 Anoptic Game Engine Authors
+ *
+ * SPDX-License-Identifier: LGPL-3.0 */
+/*  == Anoptic Game Engine v0.0000001 == */
+
+#include "threads/thread_lanes.h"
+
+// Thread-exit destructor. The key holds the lane's `live` flag, not the lane: hand it back. Its undrained
+// records still reach the consumer, and the next thread to acquire adopts it once empty.
+static void lane_retire(void *live)
+{
+    atomic_store_explicit((atomic_bool *)live, false, memory_order_release);
+}
+
+static inline atomic_bool *lane_live(const thread_lanes_t *t, void *lane)
+{
+    return (atomic_bool *)((char *)lane + t->liveOffset);
+}
+
+int thread_lanes_open(thread_lanes_t *t)
+{
+    if (ano_mutex_init(&t->mtx, NULL) != 0)
+        return -1;
+    if (ano_thread_key_create(&t->key, lane_retire) != 0) {
+        ano_mutex_destroy(&t->mtx);
+        return -1;
+    }
+    atomic_store_explicit(&t->count, 0, memory_order_relaxed);
+    atomic_store_explicit(&t->on, false, memory_order_relaxed);
+    return 0;
+}
+
+void thread_lanes_gate(thread_lanes_t *t, bool on)
+{
+    ano_mutex_lock(&t->mtx);
+    atomic_store_explicit(&t->on, on, memory_order_relaxed);
+    atomic_fetch_add_explicit(&t->gen, 1, memory_order_release);
+    ano_mutex_unlock(&t->mtx);
+}
+
+void thread_lanes_close(thread_lanes_t *t, void (*destroy)(void *lane))
+{
+    ano_thread_key_delete(t->key);
+    uint32_t n = atomic_load_explicit(&t->count, memory_order_relaxed);
+    for (uint32_t i = 0; i < n; i++) {
+        destroy(t->slots[i]);
+        t->slots[i] = NULL;
+    }
+    atomic_store_explicit(&t->count, 0, memory_order_relaxed);
+    ano_mutex_destroy(&t->mtx);
+}
+
+void *thread_lanes_acquire(thread_lanes_t *t, uint32_t *gen)
+{
+    void *l = NULL;
+    *gen = atomic_load_explicit(&t->gen, memory_order_acquire);
+    if (!atomic_load_explicit(&t->on, memory_order_relaxed))
+        return NULL;
+
+    ano_mutex_lock(&t->mtx);
+    *gen = atomic_load_explicit(&t->gen, memory_order_relaxed);
+    if (atomic_load_explicit(&t->on, memory_order_relaxed)) {
+        uint32_t n = atomic_load_explicit(&t->count, memory_order_relaxed);
+        for (uint32_t i = 0; i < n && l == NULL; i++) {
+            void *c = t->slots[i];
+            if (!atomic_load_explicit(lane_live(t, c), memory_order_acquire)   // its last store is visible now
+                && t->drained(c))
+                l = c;
+        }
+        if (l == NULL && n < t->cap && (l = t->make()) != NULL) {
+            t->slots[n] = l;
+            atomic_store_explicit(&t->count, n + 1, memory_order_release);   // publish to the consumer
+        }
+        if (l != NULL) {
+            if (t->adopt != NULL)
+                t->adopt(l);
+            atomic_store_explicit(lane_live(t, l), true, memory_order_relaxed);
+            ano_thread_setspecific(t->key, lane_live(t, l));
+        }
+    }
+    ano_mutex_unlock(&t->mtx);
+    return l;
+}
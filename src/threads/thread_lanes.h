@@ -0,0 +1,63 @@
+/* SPDX-FileCopyrightText: 2026 Anoptic Game Engine Authors
+ *
+ * SPDX-License-Identifier: LGPL-3.0 */
+/*  == Anoptic Game Engine v0.0000001 == */
+
+// Per-thread lane table shared by the logger's lanes mode and the profiler. NOT a public interface.
+//
+// A lane is one thread's private SPSC buffer. The owner acquires it lazily on its first record, a single
+// consumer (drainer, flusher) walks slots[0..count). A lane outlives its thread: the key destructor only
+// drops the lane's `live` flag, and the next acquiring thread adopts a retired lane once the consumer has
+// emptied it. The table itself never frees lanes before close.
+//
+// Owners cache their lane in thread-locals tagged with `gen`. The gate flips `on` and bumps `gen` under
+// the mutex, so a cached lane is never used across a session boundary and a locked acquire never caches
+// a lane under a generation it does not belong to.
+
+#ifndef ANOPTIC_THREAD_LANES_H
+#define ANOPTIC_THREAD_LANES_H
+
+#include <anoptic_threads.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct {
+    // Set by the owning module before open, constant after.
+    void            **slots;                   // cap entries, module storage
+    uint32_t          cap;
+    size_t            liveOffset;              // offsetof(lane, live), an _Atomic bool
+    void           *(*make)(void);             // fresh zeroed lane, NULL when out of memory
+    bool            (*drained)(void *lane);    // consumer has emptied it, called with live seen false
+    void            (*adopt)(void *lane);      // per-acquisition reset under the mutex, may be NULL
+
+    _Atomic uint32_t  count;                   // release-published to the consumer
+    _Atomic uint32_t  gen;
+    atomic_bool       on;
+    anothread_mutex_t mtx;                     // serializes acquire, once per thread per session
+    anothread_key_t   key;                     // exit destructor retires the calling thread's lane
+} thread_lanes_t;
+
+// Mutex and key. The table starts empty and off. 0 on success, -1 with nothing left to undo.
+int  thread_lanes_open(thread_lanes_t *t);
+
+// Flip `on` and bump `gen`, orphaning every cached lane. Between open and close only.
+void thread_lanes_gate(thread_lanes_t *t, bool on);
+
+// After the gate is off and the consumer is done: deletes the key first, so no later thread exit touches
+// a freed lane, then hands every lane to destroy.
+void thread_lanes_close(thread_lanes_t *t, void (*destroy)(void *lane));
+
+// The calling thread's lane for this session, cold path. Adopts a drained retired lane, else appends a new
+// one. NULL while off, when the table is full, or out of memory. *gen receives the generation the result
+// is good for. The unlocked `on` check keeps an off table from touching the mutex, which may not exist.
+void *thread_lanes_acquire(thread_lanes_t *t, uint32_t *gen);
+
+// Consumer side: lanes published so far, readable in slots[0..count).
+static inline uint32_t thread_lanes_count(thread_lanes_t *t)
+{
+    return atomic_load_explicit(&t->count, memory_order_acquire);
+}
+
+#endif // ANOPTIC_THREAD_LANES_H
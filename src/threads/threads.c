@@ -3,10 +3,17 @@
  * SPDX-License-Identifier: LGPL-3.0 */
 /*  == Anoptic Game Engine v0.0000001 == */
 
+// _GNU_SOURCE is for cpu_set_t and pthread_setaffinity_np.
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
 #include <anoptic_threads.h>
 #include <anoptic_log_crash.h>
 #include <anoptic_memory.h>
+#include <errno.h>
 #include <pthread.h>
+#include <sched.h>
 #include <stdint.h>
 
 #if defined(_WIN32)
@@ -14,6 +21,7 @@
 #include <windows.h>    // PE header walk for ano_thread_main_stack
 #else
 #include <sys/resource.h>
+#include <unistd.h>     // sysconf for ano_thread_core_count
 #endif
 
 
@@ -99,6 +107,54 @@ anothread_t ano_thread_self(void) {
     return pthread_self();
 }
 
+int ano_thread_yield(void) {
+    return sched_yield();
+}
+
+unsigned int ano_thread_core_count(void) {
+
+#if defined(_WIN32)
+    SYSTEM_INFO si;
+    GetSystemInfo(&si);
+    return si.dwNumberOfProcessors ? (unsigned int)si.dwNumberOfProcessors : 1u;
+#else
+#if defined(__linux__)
+    cpu_set_t set;
+    if (sched_getaffinity(0, sizeof set, &set) == 0 && CPU_COUNT(&set) > 0)
+        return (unsigned int)CPU_COUNT(&set);
+#endif
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (unsigned int)n : 1u;
+#endif
+}
+
+int ano_thread_pin_self(unsigned int core) {
+
+#if defined(_WIN32)
+    if (core >= 64u)
+        return EINVAL;      // one processor group
+    return SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << core) ? 0 : EINVAL;
+#elif defined(__linux__)
+    // core indexes the allowed set, not the machine: a cpuset or taskset may leave holes.
+    cpu_set_t allowed, one;
+    if (sched_getaffinity(0, sizeof allowed, &allowed) != 0)
+        return errno;
+    CPU_ZERO(&one);
+    for (int cpu = 0, seen = 0; cpu < CPU_SETSIZE; cpu++) {
+        if (!CPU_ISSET(cpu, &allowed))
+            continue;
+        if ((unsigned int)seen++ == core) {
+            CPU_SET(cpu, &one);
+            return pthread_setaffinity_np(pthread_self(), sizeof one, &one);
+        }
+    }
+    return EINVAL;
+#else
+    (void)core;
+    return ENOTSUP;
+#endif
+}
+
 // Inputs: none.
 // Output: the initial thread's stack budget in bytes, 0 when the query fails.
 // POSIX: RLIMIT_STACK soft (SIZE_MAX when unlimited). Win64: the PE-header reserve.
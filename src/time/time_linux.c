@@ -6,15 +6,29 @@
 #if defined(__linux__)
 #include "anoptic_time.h"
 #include <unistd.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>
 #include <time.h>
 #include <errno.h>
 
+#if defined(__x86_64__)
+#define ANO_TSC_ARCH 1
+#include <cpuid.h>        // __get_cpuid
+#include <x86intrin.h>    // __rdtsc, _mm_lfence
+#endif
+
 /* Precision Timestamps */
 
-// The Linux monotonic clock already reports nanoseconds, so the counter IS the ns value.
-uint64_t ano_timestamp_ticks() {
+// The monotonic clock reports nanoseconds, but even through the vDSO it costs tens of ns a read, which a
+// per-event stamp (profiler scopes, log records) pays on every call. On x86-64 with an invariant TSC that
+// the kernel itself trusts as its clocksource, rdtsc is a register read. Same election as time_win64.c:
+// resolved once and frozen, so ano_timestamp_ticks and ano_ticks_to_ns always share one timebase.
+
+static uint64_t monotonic_ns(void) {
     struct timespec ts;
     if (clock_gettime(CLOCK_MONOTONIC, &ts) == -1) {
         perror("clock_gettime");
@@ -23,14 +37,147 @@ uint64_t ano_timestamp_ticks() {
     return (uint64_t)(ts.tv_sec * 1000000000LL) + ts.tv_nsec;
 }
 
-// Linux ticks are already nanoseconds: identity.
+#ifdef ANO_TSC_ARCH
+
+// Resolved timebase, decided once by resolve_clock and never changed.
+enum { CLOCK_UNSET = 0, CLOCK_TSC = 1, CLOCK_MONO = 2 };
+static _Atomic int      g_clockMode  = CLOCK_UNSET;
+static _Atomic int      g_clockElect = 0;    // one-time election guard for resolve_clock
+static _Atomic uint64_t cachedTscHz  = 0;    // calibrated invariant-TSC frequency (TSC mode only)
+
+// Invariant TSC (CPUID 0x80000007 EDX bit 8), and the kernel agrees: it demotes the TSC from its
+// clocksource when it sees cross-core skew or drift, which the CPUID bit alone (notably under a
+// hypervisor) does not rule out.
+static bool have_invariant_tsc(void) {
+    unsigned a, b, c, d;
+    if (!__get_cpuid(0x80000000u, &a, &b, &c, &d) || a < 0x80000007u)
+        return false;
+    __get_cpuid(0x80000007u, &a, &b, &c, &d);
+    if ((d & (1u << 8)) == 0)
+        return false;
+    char src[32] = {0};
+    FILE *f = fopen("/sys/devices/system/clocksource/clocksource0/current_clocksource", "r");
+    if (f == NULL)
+        return false;
+    bool ok = fgets(src, sizeof src, f) != NULL && strncmp(src, "tsc", 3) == 0 && (src[3] == '\n' || !src[3]);
+    fclose(f);
+    return ok;
+}
+
+// rdtsc bracketed by lfence, for calibration and ano_timestamp_ticks_ordered; the hot path uses a plain rdtsc.
+static inline uint64_t rdtsc_fenced(void) {
+    _mm_lfence();
+    uint64_t t = __rdtsc();
+    _mm_lfence();
+    return t;
+}
+
+#define ANO_TSC_CAL_US 4000u   // per-sample window, measured against ACTUAL elapsed monotonic time
+
+// One TSC-frequency measurement: elapsed TSC over elapsed monotonic ns.
+static uint64_t sample_tsc_hz(void) {
+    uint64_t n0 = monotonic_ns();
+    uint64_t t0 = rdtsc_fenced();
+    struct timespec req = { 0, ANO_TSC_CAL_US * 1000L };
+    while (nanosleep(&req, &req) == -1 && errno == EINTR) {}
+    uint64_t t1 = rdtsc_fenced();
+    uint64_t n1 = monotonic_ns();
+
+    uint64_t dn = n1 - n0;
+    uint64_t dt = t1 - t0;
+    if (n0 == UINT64_MAX || n1 == UINT64_MAX || dn == 0 || dt == 0)
+        return 0;
+    return (uint64_t)(((unsigned __int128)dt * 1000000000ull) / dn);
+}
+
+// Calibrate the TSC frequency: median of three samples rejects a one-off preemption outlier.
+static uint64_t calibrate_tsc_hz(void) {
+    uint64_t s[3];
+    for (int i = 0; i < 3; i++)
+        s[i] = sample_tsc_hz();
+    if (s[0] > s[1]) { uint64_t t = s[0]; s[0] = s[1]; s[1] = t; }
+    if (s[1] > s[2]) { uint64_t t = s[1]; s[1] = s[2]; s[2] = t; }
+    if (s[0] > s[1]) { uint64_t t = s[0]; s[0] = s[1]; s[1] = t; }
+    return s[1];
+}
+
+// Decide the timebase once. One thread wins the election and resolves; concurrent callers wait for
+// the published mode. Calibration costs ~12 ms of sleep, paid once at the first timestamp.
+static void resolve_clock(void) {
+    int expected = 0;
+    if (!atomic_compare_exchange_strong(&g_clockElect, &expected, 1)) {
+        while (atomic_load_explicit(&g_clockMode, memory_order_acquire) == CLOCK_UNSET)
+            sched_yield();
+        return;
+    }
+    int mode = CLOCK_MONO;
+    if (have_invariant_tsc()) {
+        uint64_t hz = calibrate_tsc_hz();
+        if (hz >= 100000000ull && hz <= 100000000000ull) {   // 100 MHz .. 100 GHz sanity band
+            atomic_store_explicit(&cachedTscHz, hz, memory_order_relaxed);
+            mode = CLOCK_TSC;
+        }
+    }
+
+    #ifdef DEBUG_BUILD
+    printf("\nTimebase: %s", mode == CLOCK_TSC ? "invariant TSC" : "CLOCK_MONOTONIC");
+    if (mode == CLOCK_TSC)
+        printf(" @ %llu Hz", (unsigned long long)atomic_load_explicit(&cachedTscHz, memory_order_relaxed));
+    printf("\n\n");
+    #endif
+
+    atomic_store_explicit(&g_clockMode, mode, memory_order_release);   // publishes cachedTscHz too
+}
+
+static inline int clock_mode(void) {
+    int m = atomic_load_explicit(&g_clockMode, memory_order_acquire);
+    if (m == CLOCK_UNSET) {
+        resolve_clock();
+        m = atomic_load_explicit(&g_clockMode, memory_order_acquire);
+    }
+    return m;
+}
+
+#endif // ANO_TSC_ARCH
+
+// Bare monotonic counter, no conversion. rdtsc when the TSC is usable, else CLOCK_MONOTONIC ns.
+uint64_t ano_timestamp_ticks() {
+#ifdef ANO_TSC_ARCH
+    if (clock_mode() == CLOCK_TSC)
+        return __rdtsc();
+#endif
+    return monotonic_ns();
+}
+
+// ano_timestamp_ticks fenced on both sides. A bare rdtsc may execute after later loads; lfence holds it
+// behind earlier instructions and holds later ones behind it. clock_gettime is a call the compiler cannot
+// reorder loads across, and the vDSO's own TSC read is fenced.
+uint64_t ano_timestamp_ticks_ordered() {
+#ifdef ANO_TSC_ARCH
+    if (clock_mode() == CLOCK_TSC)
+        return rdtsc_fenced();
+#endif
+    return monotonic_ns();
+}
+
+// Convert raw counts (value or delta) to nanoseconds via the resolved timebase. Identity off the TSC.
 uint64_t ano_ticks_to_ns(uint64_t ticks) {
+#ifdef ANO_TSC_ARCH
+    if (clock_mode() == CLOCK_TSC) {
+        uint64_t freq = atomic_load_explicit(&cachedTscHz, memory_order_relaxed);
+
+        // Split into two parts to scale without overflow.
+        uint64_t largePart = ticks / freq;    // Seconds
+        uint64_t smallPart = ticks % freq;    // Sub-seconds
+        return smallPart * 1000000000ULL / freq + largePart * 1000000000ULL;
+    }
+#endif
     return ticks;
 }
 
-// High resolution relative timestamps from this local machine.
+// High resolution relative timestamps from this local machine, in ns whatever the tick timebase.
 uint64_t ano_timestamp_raw() {
-    return ano_timestamp_ticks();
+    return monotonic_ns();
 }
 
 // return ano_timestamp_raw, but scaled to microseconds.
@@ -48,6 +48,23 @@ uint64_t ano_timestamp_ticks() {
     return mach_absolute_time();
 }
 
+// ano_timestamp_ticks in program order. The counter read is not a memory access, so neither a plain
+// read nor an atomic fence orders it: isb (arm64) / lfence (x86-64) on both sides does.
+uint64_t ano_timestamp_ticks_ordered() {
+#if defined(__aarch64__)
+    __asm__ __volatile__("isb" ::: "memory");
+    uint64_t t = mach_absolute_time();
+    __asm__ __volatile__("isb" ::: "memory");
+#elif defined(__x86_64__)
+    __asm__ __volatile__("lfence" ::: "memory");
+    uint64_t t = mach_absolute_time();
+    __asm__ __volatile__("lfence" ::: "memory");
+#else
+    uint64_t t = mach_absolute_time();
+#endif
+    return t;
+}
+
 // Convert raw mach ticks (value or delta) to nanoseconds, overflow-safe via the cached timebase.
 uint64_t ano_ticks_to_ns(uint64_t ticks) {
 
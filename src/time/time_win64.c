@@ -70,8 +70,9 @@ static bool have_invariant_tsc(void) {
 }
 
 // rdtsc bracketed by lfence so the read can't drift past neighbouring instructions during
-// calibration. The hot path (ano_timestamp_ticks) uses a plain rdtsc: a few instructions of skew
-// there is far below the ordering grain we care about, and the fences aren't free.
+// calibration and in ano_timestamp_ticks_ordered. The hot path (ano_timestamp_ticks) uses a plain
+// rdtsc: a few instructions of skew there is far below the ordering grain we care about, and the
+// fences aren't free.
 static inline uint64_t rdtsc_fenced(void) {
     _mm_lfence();
     uint64_t t = __rdtsc();
@@ -169,6 +170,16 @@ uint64_t ano_timestamp_ticks() {
     return (uint64_t)tmp.QuadPart;
 }
 
+// ano_timestamp_ticks fenced on both sides, so later loads cannot issue before the counter read. QPC is
+// an opaque call that serializes its own counter read.
+uint64_t ano_timestamp_ticks_ordered() {
+#ifdef ANO_TSC_ARCH
+    if (clock_mode() == CLOCK_TSC)
+        return rdtsc_fenced();
+#endif
+    return ano_timestamp_ticks();
+}
+
 // Convert raw counts (value or delta) to nanoseconds, overflow-safe via the resolved timebase.
 uint64_t ano_ticks_to_ns(uint64_t ticks) {
 
@@ -15,6 +15,7 @@
 //  - GPU binning: move this scatter to a compute pass.
 
 #include "anoptic_ui.h"
+#include "anoptic_profiler.h"
 
 #include <math.h>
 
@@ -58,6 +59,7 @@ uint32_t ano_ui_tile_build(const AnoUiScene *s, int32_t ox, int32_t oy,
                            uint32_t *entries, uint32_t entryCap,
                            uint32_t *cursor, bool *ok)
 {
+    ANO_PROFILE_SCOPE("ui.tile_build");
     uint32_t nTiles = tilesX * tilesY;
     *ok = true;
     if (nTiles + 1 > offsetsCap || tilesX == 0 || tilesY == 0)
@@ -105,7 +105,7 @@ static void free_owned_bulk(const RenderCommand* c)
     void* blk = c->kind == RCMD_BULK_UPDATE  ? (void*)c->update
               : c->kind == RCMD_BULK_DESTROY ? (void*)c->destroy
               :                                (void*)c->batch;
-    if (blk) mi_free(blk);
+    ano_tfree(&ano_render_block_mem, blk);
 }
 
 
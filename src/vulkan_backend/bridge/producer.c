@@ -65,7 +65,7 @@ bool ano_render_submit_bulk_update(AnoRenderBridge* bridge, const RenderUpdateBa
     if (fields & RFIELD_ANIM)      bytes += (size_t)count * sizeof(AnoMotionDescriptor);
     if (fields & RFIELD_MESH_MAT)  bytes += (size_t)count * sizeof(uint32_t) * 2u;
     if (fields & RFIELD_USERDATA)  bytes += (size_t)count * sizeof(AnoInstanceData);
-    char* blk = mi_malloc(bytes);
+    char* blk = ano_tmalloc(&ano_render_block_mem, bytes);
     if (!blk) return false;
     RenderUpdateBatch* b = (RenderUpdateBatch*)blk;
     *b = (RenderUpdateBatch){ .count = count, .fields = fields };
@@ -91,7 +91,7 @@ bool ano_render_submit_bulk_update(AnoRenderBridge* bridge, const RenderUpdateBa
         memcpy(cur, batch->instance_data, (size_t)count * sizeof(AnoInstanceData)); cur += (size_t)count * sizeof(AnoInstanceData);
     }
     RenderCommand cmd = { .kind = RCMD_BULK_UPDATE, .update = b, .bulk_owned = true };
-    if (!ano_render_submit(bridge, &cmd)) { mi_free(blk); return false; }
+    if (!ano_render_submit(bridge, &cmd)) { ano_tfree(&ano_render_block_mem, blk); return false; }
     return true;
 }
 
@@ -101,7 +101,7 @@ bool ano_render_submit_bulk_update(AnoRenderBridge* bridge, const RenderUpdateBa
 bool ano_render_submit_bulk_destroy(AnoRenderBridge* bridge, const uint32_t* render_ids, uint32_t count) {
     if (count == 0) return true;
     size_t bytes = sizeof(RenderDestroyBatch) + (size_t)count * sizeof(uint32_t);
-    char* blk = mi_malloc(bytes);
+    char* blk = ano_tmalloc(&ano_render_block_mem, bytes);
     if (!blk) return false;
     RenderDestroyBatch* b = (RenderDestroyBatch*)blk;
     uint32_t* ids = (uint32_t*)(blk + sizeof(RenderDestroyBatch));
@@ -109,6 +109,6 @@ bool ano_render_submit_bulk_destroy(AnoRenderBridge* bridge, const uint32_t* ren
     b->count = count;
     b->render_ids = ids;
     RenderCommand cmd = { .kind = RCMD_BULK_DESTROY, .destroy = b, .bulk_owned = true };
-    if (!ano_render_submit(bridge, &cmd)) { mi_free(blk); return false; }
+    if (!ano_render_submit(bridge, &cmd)) { ano_tfree(&ano_render_block_mem, blk); return false; }
     return true;
 }
@@ -4,6 +4,7 @@
 
 #include "vulkan_backend/geometry.h"
 #include <string.h>
+#include <stddef.h>
 #include <stdio.h>
 #include <anoptic_log.h>
 
@@ -102,74 +103,25 @@ void ano_vk_cleanup_geometry_pool(GeometryPool* pool, VkDevice device)
     pool->freeMeshIndices = NULL;
 }
 
-// Emit one mesh into a caller-reserved meshes[] slot: builds meshlets + bounds, stages, transfers,
-// and fills pool->meshes[meshIndex]. Does NOT allocate or free the slot — the caller owns slot
-// lifetime (single upload or LOD chain). Returns true on success; false if a pool or command
+// The cook output must be the pool's vertex byte for byte: levels are memcpy'd straight to staging.
+static_assert(sizeof(ano_cook_vertex_t) == sizeof(Vertex), "cooked vertex size");
+static_assert(offsetof(ano_cook_vertex_t, normal) == offsetof(Vertex, normal), "cooked normal offset");
+static_assert(offsetof(ano_cook_vertex_t, tex_coord) == offsetof(Vertex, texCoord), "cooked texcoord offset");
+
+// Emit one cooked level into a caller-reserved meshes[] slot: stages its vertices and metadata block,
+// transfers, and fills pool->meshes[meshIndex]. Does NOT allocate or free the slot — the caller owns
+// slot lifetime (single upload or LOD chain). Returns true on success; false if a pool or command
 // resource is exhausted. On failure nothing is committed: pool reservations (vertex/index byte
 // ranges) are taken only after the last can't-fail point, so a failed level leaves the pool intact.
 static bool geometry_pool_emit_level(GeometryPool* pool, GpuAllocator* alloc, VkDevice device,
                                      uint32_t transferFamily, VkQueue transferQueue,
-                                     const Vertex* vertices, uint32_t vertexCount,
-                                     const uint32_t* indices, uint32_t indexCount,
-                                     uint32_t meshIndex)
+                                     const ano_mesh_level_t* level, uint32_t meshIndex)
 {
     // Wait for any in-flight draws to complete before mutating shared device-local buffers
     vkDeviceWaitIdle(device);
 
-    // Build meshlets and calculate bounds on the host
-    size_t max_meshlets = ano_build_meshlets_bound(indexCount, 64, 126);
-    if (max_meshlets == 0) return false;
-
-    ano_meshlet_t* meshlets = (ano_meshlet_t*)malloc(max_meshlets * sizeof(ano_meshlet_t));
-    uint32_t* meshlet_vertices = (uint32_t*)malloc(max_meshlets * 64 * sizeof(uint32_t));
-    uint8_t* meshlet_triangles = (uint8_t*)malloc(max_meshlets * 126 * 3 * sizeof(uint8_t));
-    ano_meshlet_bounds_gpu_t* bounds = (ano_meshlet_bounds_gpu_t*)malloc(max_meshlets * sizeof(ano_meshlet_bounds_gpu_t));
-
-    size_t meshlet_count = ano_build_meshlets(
-        meshlets,
-        meshlet_vertices,
-        meshlet_triangles,
-        indices,
-        indexCount,
-        64,
-        126
-    );
-
-    if (meshlet_count == 0) {
-        free(meshlets);
-        free(meshlet_vertices);
-        free(meshlet_triangles);
-        free(bounds);
-        return false;
-    }
-
-    size_t unique_vertex_count = meshlets[meshlet_count - 1].vertex_offset + meshlets[meshlet_count - 1].vertex_count;
-    size_t local_indices_count = meshlets[meshlet_count - 1].triangle_offset + meshlets[meshlet_count - 1].triangle_count * 3;
-
-    for (size_t p = 0; p < meshlet_count; ++p) {
-        bounds[p] = ano_compute_meshlet_bounds(
-            meshlet_vertices + meshlets[p].vertex_offset,
-            meshlet_triangles + meshlets[p].triangle_offset,
-            meshlets[p].triangle_count,
-            (const float*)vertices,
-            vertexCount,
-            sizeof(Vertex)
-        );
-    }
-
-    VkDeviceSize meshlets_size = meshlet_count * sizeof(ano_meshlet_t);
-    VkDeviceSize unique_vertices_size = unique_vertex_count * sizeof(uint32_t);
-    VkDeviceSize local_triangles_size = (local_indices_count * sizeof(uint8_t) + 3) & ~3;
-    VkDeviceSize bounds_size = meshlet_count * sizeof(ano_meshlet_bounds_gpu_t);
-    // Plain u32 triangle-list indices for the vertex-shader fallback path. This is
-    // exactly the caller's mesh-local index array; the hardware index/vertex fetch
-    // expands it the way the mesh shader expands meshlets. 4-byte aligned, so it sits
-    // index-buffer-ready after the 16-aligned bounds block.
-    VkDeviceSize classic_indices_size = indexCount * sizeof(uint32_t);
-
-    VkDeviceSize total_metadata_size = meshlets_size + unique_vertices_size + local_triangles_size + bounds_size + classic_indices_size;
-
-    VkDeviceSize vertexSize = sizeof(Vertex) * vertexCount;
+    VkDeviceSize total_metadata_size = level->metadata_size;
+    VkDeviceSize vertexSize = sizeof(Vertex) * (VkDeviceSize)level->vertex_count;
     VkDeviceSize totalSize = vertexSize + total_metadata_size;
 
     VkBufferCreateInfo stagingInfo = {
@@ -181,10 +133,6 @@ static bool geometry_pool_emit_level(GeometryPool* pool, GpuAllocator* alloc, Vk
 
     VkBuffer stagingBuffer;
     if (vkCreateBuffer(device, &stagingInfo, NULL, &stagingBuffer) != VK_SUCCESS) {
-        free(meshlets);
-        free(meshlet_vertices);
-        free(meshlet_triangles);
-        free(bounds);
         return false;
     }
 
@@ -194,27 +142,14 @@ static bool geometry_pool_emit_level(GeometryPool* pool, GpuAllocator* alloc, Vk
     GpuAllocation stagingAlloc = gpu_alloc(alloc, memReqs, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
     if (stagingAlloc.memory == VK_NULL_HANDLE) {
         vkDestroyBuffer(device, stagingBuffer, NULL);
-        free(meshlets);
-        free(meshlet_vertices);
-        free(meshlet_triangles);
-        free(bounds);
         return false;
     }
     vkBindBufferMemory(device, stagingBuffer, stagingAlloc.memory, stagingAlloc.offset);
 
-    // Copy vertex and metadata data into the staging buffer
+    // The cooked level is already in pool layout: vertices, then the metadata block.
     char* mapped = (char*)stagingAlloc.mapped;
-    memcpy(mapped, vertices, vertexSize);
-    
-    char* meta_ptr = mapped + vertexSize;
-    memcpy(meta_ptr, meshlets, meshlets_size);
-    memcpy(meta_ptr + meshlets_size, meshlet_vertices, unique_vertices_size);
-    memcpy(meta_ptr + meshlets_size + unique_vertices_size, meshlet_triangles, local_indices_count);
-    if (local_triangles_size > local_indices_count) {
-        memset(meta_ptr + meshlets_size + unique_vertices_size + local_indices_count, 0, local_triangles_size - local_indices_count);
-    }
-    memcpy(meta_ptr + meshlets_size + unique_vertices_size + local_triangles_size, bounds, bounds_size);
-    memcpy(meta_ptr + meshlets_size + unique_vertices_size + local_triangles_size + bounds_size, indices, classic_indices_size);
+    memcpy(mapped, level->vertices, vertexSize);
+    memcpy(mapped + vertexSize, level->metadata, total_metadata_size);
 
     VkCommandPoolCreateInfo poolInfo = {
         .sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
@@ -224,10 +159,6 @@ static bool geometry_pool_emit_level(GeometryPool* pool, GpuAllocator* alloc, Vk
     VkCommandPool transientPool;
     if (vkCreateCommandPool(device, &poolInfo, NULL, &transientPool) != VK_SUCCESS) {
         vkDestroyBuffer(device, stagingBuffer, NULL);
-        free(meshlets);
-        free(meshlet_vertices);
-        free(meshlet_triangles);
-        free(bounds);
         return false;
     }
 
@@ -263,10 +194,6 @@ static bool geometry_pool_emit_level(GeometryPool* pool, GpuAllocator* alloc, Vk
                    (unsigned long long)(pool->vertexWriteOffset + vertexSize), (unsigned long long)pool->vertexCapacity);
             vkDestroyBuffer(device, stagingBuffer, NULL);
             vkDestroyCommandPool(device, transientPool, NULL);
-            free(meshlets);
-            free(meshlet_vertices);
-            free(meshlet_triangles);
-            free(bounds);
             return false; // pool exhausted
         }
         finalVertexOffset = pool->vertexWriteOffset;
@@ -287,10 +214,6 @@ static bool geometry_pool_emit_level(GeometryPool* pool, GpuAllocator* alloc, Vk
                    (unsigned long long)(pool->indexWriteOffset + total_metadata_size), (unsigned long long)pool->indexCapacity);
             vkDestroyBuffer(device, stagingBuffer, NULL);
             vkDestroyCommandPool(device, transientPool, NULL);
-            free(meshlets);
-            free(meshlet_vertices);
-            free(meshlet_triangles);
-            free(bounds);
             return false; // pool exhausted
         }
         finalIndexOffset = pool->indexWriteOffset;
@@ -350,59 +273,33 @@ static bool geometry_pool_emit_level(GeometryPool* pool, GpuAllocator* alloc, Vk
     vkFreeCommandBuffers(device, transientPool, 1, &cmd);
     vkDestroyCommandPool(device, transientPool, NULL);
 
-    // Cleanup staging buffer and host arrays
+    // Cleanup staging buffer
     vkDestroyBuffer(device, stagingBuffer, NULL);
-    free(meshlets);
-    free(meshlet_vertices);
-    free(meshlet_triangles);
-    free(bounds);
 
-    // Register the mesh into the caller-owned slot.
+    // Register the mesh into the caller-owned slot; the cooked offsets are relative to the metadata block.
     MeshRegion* mesh = &pool->meshes[meshIndex];
     mesh->vertexOffset = finalVertexOffset;
-    mesh->vertexCount = vertexCount;
+    mesh->vertexCount = level->vertex_count;
     mesh->indexOffset = finalIndexOffset;
-    mesh->indexCount = (uint32_t)total_metadata_size;
+    mesh->indexCount = level->metadata_size;
     mesh->meshletOffset = finalIndexOffset;
-    mesh->meshletCount = (uint32_t)meshlet_count;
-    mesh->uniqueVerticesOffset = finalIndexOffset + (uint32_t)meshlets_size;
-    mesh->trianglesOffset = finalIndexOffset + (uint32_t)(meshlets_size + unique_vertices_size);
-    mesh->boundsOffset = finalIndexOffset + (uint32_t)(meshlets_size + unique_vertices_size + local_triangles_size);
-    mesh->classicIndexOffset = finalIndexOffset + (uint32_t)(meshlets_size + unique_vertices_size + local_triangles_size + bounds_size);
-    mesh->classicIndexCount = indexCount;
-    mesh->lodCount = 1u; // standalone by default; geometry_pool_upload_chain overrides the base's count
-
-    // Calculate bounding sphere
-    Vector3 minBounds = vertices[0].position;
-    Vector3 maxBounds = vertices[0].position;
-    for (uint32_t i = 1; i < vertexCount; i++) {
-        if (vertices[i].position.v[0] < minBounds.v[0]) minBounds.v[0] = vertices[i].position.v[0];
-        if (vertices[i].position.v[1] < minBounds.v[1]) minBounds.v[1] = vertices[i].position.v[1];
-        if (vertices[i].position.v[2] < minBounds.v[2]) minBounds.v[2] = vertices[i].position.v[2];
-        if (vertices[i].position.v[0] > maxBounds.v[0]) maxBounds.v[0] = vertices[i].position.v[0];
-        if (vertices[i].position.v[1] > maxBounds.v[1]) maxBounds.v[1] = vertices[i].position.v[1];
-        if (vertices[i].position.v[2] > maxBounds.v[2]) maxBounds.v[2] = vertices[i].position.v[2];
-    }
-    
-    mesh->boundingSphereCenter[0] = (minBounds.v[0] + maxBounds.v[0]) * 0.5f;
-    mesh->boundingSphereCenter[1] = (minBounds.v[1] + maxBounds.v[1]) * 0.5f;
-    mesh->boundingSphereCenter[2] = (minBounds.v[2] + maxBounds.v[2]) * 0.5f;
-
-    float maxDistSq = 0.0f;
-    for (uint32_t i = 0; i < vertexCount; i++) {
-        float dx = vertices[i].position.v[0] - mesh->boundingSphereCenter[0];
-        float dy = vertices[i].position.v[1] - mesh->boundingSphereCenter[1];
-        float dz = vertices[i].position.v[2] - mesh->boundingSphereCenter[2];
-        float distSq = dx*dx + dy*dy + dz*dz;
-        if (distSq > maxDistSq) maxDistSq = distSq;
-    }
-    mesh->boundingSphereRadius = sqrtf(maxDistSq);
+    mesh->meshletCount = level->meshlet_count;
+    mesh->uniqueVerticesOffset = finalIndexOffset + level->unique_vertices_offset;
+    mesh->trianglesOffset = finalIndexOffset + level->triangles_offset;
+    mesh->boundsOffset = finalIndexOffset + level->bounds_offset;
+    mesh->classicIndexOffset = finalIndexOffset + level->classic_index_offset;
+    mesh->classicIndexCount = level->classic_index_count;
+    mesh->lodCount = 1u; // standalone by default; geometry_pool_upload_cooked overrides the base's count
+    mesh->boundingSphereCenter[0] = level->sphere[0];
+    mesh->boundingSphereCenter[1] = level->sphere[1];
+    mesh->boundingSphereCenter[2] = level->sphere[2];
+    mesh->boundingSphereRadius = level->sphere[3];
 
     return true;
 }
 
-// Acquire a single mesh slot, then emit. The slot acquisition is committed only on success — a
-// failed emit leaves meshCount/free-list untouched and returns the fallback mesh (0), matching the
+// Acquire a single mesh slot, then cook and emit. The slot acquisition is committed only on success —
+// a failed emit leaves meshCount/free-list untouched and returns the fallback mesh (0), matching the
 // legacy contract that an exhausted pool never leaks a mesh index.
 uint32_t geometry_pool_upload(GeometryPool* pool, GpuAllocator* alloc, VkDevice device,
                               uint32_t transferFamily, VkQueue transferQueue,
@@ -424,8 +321,13 @@ uint32_t geometry_pool_upload(GeometryPool* pool, GpuAllocator* alloc, VkDevice
         meshIndex = pool->meshCount;
     }
 
-    if (!geometry_pool_emit_level(pool, alloc, device, transferFamily, transferQueue,
-                                  vertices, vertexCount, indices, indexCount, meshIndex))
+    ano_mesh_chain_t chain;
+    bool emitted = ano_mesh_cook_chain(&chain, (const ano_cook_vertex_t*)vertices, vertexCount,
+                                       indices, indexCount, NULL) > 0 &&
+                   geometry_pool_emit_level(pool, alloc, device, transferFamily, transferQueue,
+                                            &chain.levels[0], meshIndex);
+    ano_mesh_chain_free(&chain);
+    if (!emitted)
         return 0; // fallback mesh; slot acquisition not committed
 
     if (recycled) pool->freeMeshIndexCount--;
@@ -433,66 +335,18 @@ uint32_t geometry_pool_upload(GeometryPool* pool, GpuAllocator* alloc, VkDevice
     return meshIndex;
 }
 
-// A sensible default LOD chain: ratios 1, 1/2, 1/4, ... (each level ~half the source triangles) and
-// a 5%-of-extent error budget. lodCount is clamped to [1, ANO_MAX_LOD].
-AnoLodConfig ano_lod_config_default(uint32_t lodCount)
-{
-    AnoLodConfig c;
-    memset(&c, 0, sizeof c);
-    if (lodCount < 1u) lodCount = 1u;
-    if (lodCount > ANO_MAX_LOD) lodCount = ANO_MAX_LOD;
-    c.lodCount = lodCount;
-    c.targetError = 0.05f;
-    c.edgeLenFactor = ANO_SIMPLIFY_EDGE_FACTOR_DEFAULT;  // guard the in-plane courtyard-bridge case
-    float ratio = 1.0f;
-    for (uint32_t i = 0; i < ANO_MAX_LOD; ++i) {
-        c.ratios[i] = ratio;  // level 0 == 1.0 (full mesh)
-        ratio *= 0.5f;
-    }
-    return c;
-}
-
-// Gather the vertices referenced by `indices` into a dense prefix of outVerts, rewriting `indices`
-// in place to address that prefix (mesh-local, 0-based). Lets a decimated LOD level store only the
-// vertices it actually uses instead of a full copy of the source array. outVerts must hold at least
-// srcVertexCount entries (worst case == every vertex still referenced); remap is one u32 per source
-// vertex. Returns the compacted vertex count (<= srcVertexCount), or 0 if the remap allocation fails
-// (the caller then keeps the full array, indices untouched). Precondition: every index < srcVertexCount
-// (ano_simplify emits only a valid subset of the source vertices), matching emit_level's own trust.
-static uint32_t geometry_compact_level(const Vertex* srcVerts, uint32_t srcVertexCount,
-                                       uint32_t* indices, uint32_t indexCount, Vertex* outVerts)
-{
-    uint32_t* remap = (uint32_t*)malloc((size_t)srcVertexCount * sizeof(uint32_t));
-    if (!remap) return 0;
-    memset(remap, 0xFF, (size_t)srcVertexCount * sizeof(uint32_t)); // 0xFFFFFFFF == unassigned
-
-    uint32_t next = 0;
-    for (uint32_t i = 0; i < indexCount; ++i) {
-        uint32_t old = indices[i];
-        if (remap[old] == 0xFFFFFFFFu) {
-            remap[old] = next;
-            outVerts[next] = srcVerts[old];
-            next++;
-        }
-        indices[i] = remap[old];
-    }
-    free(remap);
-    return next;
-}
-
-// Upload a mesh as a contiguous LOD chain (review 4.9 step 2). Level 0 is the full mesh; level i is
-// the ORIGINAL mesh decimated (ano_simplify, so error never compounds across levels) to ratios[i] of
-// the source index count, re-optimized for the meshlet layout, then vertex-subset-compacted (each
-// decimated level stores only the vertices its index buffer references, not a full copy of the source
-// array) and emitted. Cull reads the bounding sphere from the base (level 0, full array) only, so the
-// cull bound stays LOD-invariant even though decimated levels carry a tighter, never-read subset bound.
+// Upload a mesh as a contiguous LOD chain (review 4.9 step 2): cook it (ano_mesh_cook_chain — level 0
+// is the full mesh, level i the ORIGINAL mesh decimated to ratios[i], re-optimized and vertex-subset
+// compacted, the levels cooked concurrently on the job pool), then upload the cooked levels from this
+// thread. Cull reads the bounding sphere from the base (level 0, full array) only, so the cull bound
+// stays LOD-invariant even though decimated levels carry a tighter, never-read subset bound.
 //
 // vertices/vertexCount/indices/indexCount: the source (level-0) mesh.
 // config: lodCount + per-level ratios + error budget (NULL => a single full level).
 // out_lodBase/out_lodCount (nullable): the contiguous base mesh index and the count actually emitted.
 // Returns the base mesh index (== *out_lodBase), or 0 (fallback) with *out_lodCount == 0 on total
 // failure. The chain truncates (fewer levels than requested) if the simplifier stalls or a pool is
-// exhausted mid-chain; the reserved-but-unfilled tail slots are released so none is ever addressed.
+// exhausted mid-chain.
 uint32_t geometry_pool_upload_chain(GeometryPool* pool, GpuAllocator* alloc, VkDevice device,
                                     uint32_t transferFamily, VkQueue transferQueue,
                                     const Vertex* vertices, uint32_t vertexCount,
@@ -500,15 +354,28 @@ uint32_t geometry_pool_upload_chain(GeometryPool* pool, GpuAllocator* alloc, VkD
                                     const AnoLodConfig* config,
                                     uint32_t* out_lodBase, uint32_t* out_lodCount)
 {
-    uint32_t want = config ? config->lodCount : 1u;
-    if (want < 1u) want = 1u;
+    ano_mesh_chain_t chain;
+    ano_mesh_cook_chain(&chain, (const ano_cook_vertex_t*)vertices, vertexCount, indices, indexCount, config);
+    uint32_t base = geometry_pool_upload_cooked(pool, alloc, device, transferFamily, transferQueue,
+                                                &chain, out_lodBase, out_lodCount);
+    ano_mesh_chain_free(&chain);
+    return base;
+}
+
+// Emit a cooked chain into contiguous slots. The reserved-but-unfilled tail slots are released on a
+// short chain or an exhausted pool, so none is ever addressed.
+uint32_t geometry_pool_upload_cooked(GeometryPool* pool, GpuAllocator* alloc, VkDevice device,
+                                     uint32_t transferFamily, VkQueue transferQueue,
+                                     const ano_mesh_chain_t* chain,
+                                     uint32_t* out_lodBase, uint32_t* out_lodCount)
+{
+    uint32_t want = chain->level_count;
     if (want > ANO_MAX_LOD) want = ANO_MAX_LOD;
-    float targetError = config ? config->targetError : 0.0f;
 
     // The per-mesh GPU buffers are fixed at ANO_MAX_MESHES slots; never register past them (the
     // updateCullingBuffers write is bounded by meshCount). Clamp the chain to the slots that remain —
     // it already tolerates producing fewer levels than requested. No room at all -> fallback mesh 0.
-    if (pool->meshCount >= ANO_MAX_MESHES) {
+    if (want == 0u || pool->meshCount >= ANO_MAX_MESHES) {
         if (out_lodBase)  *out_lodBase = 0u;
         if (out_lodCount) *out_lodCount = 0u;
         return 0u;
@@ -527,48 +394,14 @@ uint32_t geometry_pool_upload_chain(GeometryPool* pool, GpuAllocator* alloc, VkD
     uint32_t lodBase = pool->meshCount;
     pool->meshCount += want;  // reserve; rolled back to the count actually produced below
 
-    // Per-level scratch, only needed when there is at least one decimated level:
-    //  - simplified: ano_simplify writes a subset but its destination must hold the full source count.
-    //  - compacted:  the vertex subset a decimated level references; worst case == the full count.
-    // Both reused across levels.
-    uint32_t* simplified = (want > 1u) ? (uint32_t*)malloc((size_t)indexCount * sizeof(uint32_t)) : NULL;
-    Vertex*   compacted  = (want > 1u) ? (Vertex*)malloc((size_t)vertexCount * sizeof(Vertex)) : NULL;
-
     uint32_t produced = 0;
     for (uint32_t lvl = 0; lvl < want; ++lvl) {
-        const uint32_t* lvlIndices = indices;
-        uint32_t lvlCount = indexCount;
-        const Vertex*   lvlVertices = vertices;
-        uint32_t lvlVertexCount = vertexCount;
-        if (lvl > 0 && simplified) {
-            float ratio = config->ratios[lvl];
-            if (ratio <= 0.0f || ratio > 1.0f) ratio = 1.0f;
-            uint32_t targetIdx = (uint32_t)((float)indexCount * ratio);
-            targetIdx -= targetIdx % 3u;
-            if (targetIdx < 3u) targetIdx = 3u;
-            size_t got = ano_simplify_ex(simplified, indices, indexCount,
-                                         (const float*)vertices, vertexCount, sizeof(Vertex),
-                                         targetIdx, targetError, config->edgeLenFactor, NULL);
-            if (got < 3u) break;  // simplifier produced nothing usable: truncate the chain here
-            ano_optimize_vertex_cache(simplified, simplified, got, vertexCount);
-            lvlIndices = simplified;
-            lvlCount = (uint32_t)got;
-            // Compact to just the referenced vertices (remaps `simplified` in place). On alloc failure
-            // (cc==0) keep the full array with the unmodified indices — correct, just not space-optimal.
-            if (compacted) {
-                uint32_t cc = geometry_compact_level(vertices, vertexCount, simplified, lvlCount, compacted);
-                if (cc > 0u) { lvlVertices = compacted; lvlVertexCount = cc; }
-            }
-        }
         if (!geometry_pool_emit_level(pool, alloc, device, transferFamily, transferQueue,
-                                      lvlVertices, lvlVertexCount, lvlIndices, lvlCount, lodBase + lvl))
+                                      &chain->levels[lvl], lodBase + lvl))
             break;  // pool exhausted: truncate
         produced++;
     }
 
-    free(simplified);
-    free(compacted);
-
     // Release the reserved-but-unfilled tail so the cull shader never addresses an empty slot.
     pool->meshCount = lodBase + produced;
 
@@ -8,7 +8,7 @@
 #include <vulkan/vulkan.h>
 #include "vulkan_backend/gpu_alloc.h"
 #include "vulkan_backend/vertex/vertex.h"
-#include "mesh/ano_meshoptimizer.h"
+#include "mesh/ano_meshcook.h"
 
 typedef struct MeshRegion
 {
@@ -75,8 +75,6 @@ uint32_t geometry_pool_upload(GeometryPool* pool, GpuAllocator* alloc, VkDevice
                               const Vertex* vertices, uint32_t vertexCount,
                               const uint32_t* indices, uint32_t indexCount);
 
-#define ANO_MAX_LOD 8u
-
 // Per-mesh GPU buffer capacity (MeshSSBO / MeshBoundsSSBO slots), fixed at buffer creation. The host
 // geometry pool grows its meshes[] array on demand but must never register past this, or
 // updateCullingBuffers would write past the mapped device buffers — the upload paths refuse once the
@@ -85,26 +83,6 @@ uint32_t geometry_pool_upload(GeometryPool* pool, GpuAllocator* alloc, VkDevice
 // LOD chains (ANO_DEFAULT_LOD_COUNT) this covers ~2048 distinct source meshes; ~156 B/slot of VRAM.
 #define ANO_MAX_MESHES 8192u
 
-// Default LOD levels glTF uploads request. 4 == LOD chains on engine-wide: level 0 full detail plus
-// three decimated levels (ratios 1, 1/2, 1/4, 1/8). Set to 1 for a single full-detail mesh with no
-// decimation; the clamp is ANO_MAX_LOD.
-#define ANO_DEFAULT_LOD_COUNT 4u
-
-// LOD chain production config (review 4.9 step 2). lodCount levels are emitted as a contiguous run
-// of mesh indices: level 0 is the full mesh, level i is the source decimated to ratios[i] of the
-// source index count under targetError. ratios[0] is conventionally 1.0 (level 0 == full).
-typedef struct AnoLodConfig
-{
-    uint32_t lodCount;             // levels to emit (>=1, clamped to ANO_MAX_LOD)
-    float    ratios[ANO_MAX_LOD];  // per-level target index fraction of the source (level 0 == 1.0)
-    float    targetError;          // ano_simplify relative error budget (fraction of bbox extent)
-    float    edgeLenFactor;        // in-plane growth cap: max resulting edge in source mean-edge lengths
-                                   // (ano_simplify_ex); 0 disables the guard (A/B baseline)
-} AnoLodConfig;
-
-// A sensible default chain: ratios 1, 1/2, 1/4, ... and a 5%-of-extent error budget.
-AnoLodConfig ano_lod_config_default(uint32_t lodCount);
-
 // Upload a mesh as a contiguous LOD chain. Produces config->lodCount adjacent mesh regions sharing
 // the same vertex data (level i = ano_simplify of the source to ratios[i]); returns the base mesh
 // index and writes the count actually produced to *out_lodCount (the chain truncates if a level's
@@ -117,6 +95,14 @@ uint32_t geometry_pool_upload_chain(GeometryPool* pool, GpuAllocator* alloc, VkD
                                     const AnoLodConfig* config,
                                     uint32_t* out_lodBase, uint32_t* out_lodCount);
 
+// Upload an already cooked chain (ano_mesh_cook_chain, or a view into a mapped .anomesh): each level
+// is two memcpys into staging, no meshlet or LOD work. Same slot and truncation contract as
+// geometry_pool_upload_chain; an empty chain produces nothing.
+uint32_t geometry_pool_upload_cooked(GeometryPool* pool, GpuAllocator* alloc, VkDevice device,
+                                     uint32_t transferFamily, VkQueue transferQueue,
+                                     const ano_mesh_chain_t* chain,
+                                     uint32_t* out_lodBase, uint32_t* out_lodCount);
+
 // Free a mesh region, adding its memory and index to the free lists
 void geometry_pool_free(GeometryPool* pool, uint32_t meshIndex);
 
@@ -30,6 +30,9 @@
 // Frame-data capacity: ~21k glyph instances, rewritten wholesale on text change.
 #define ANO_TEXT_FRAME_BYTES (1u << 20)
 
+// Everything the raster keeps on textHeap: the bake blobs (adopted from the bake) and the pending text.
+static ano_mem_tag_t g_textRasterMem = ANO_MEM_TAG("text.raster");
+
 // Push-constant block shared with textraster.comp (68 B, the shader may declare a
 // prefix). The ui counts stay 0 with no UI compose.
 typedef struct TextRasterPush {
@@ -206,14 +209,14 @@ void ano_vk_text_block_set(RendererState* state, uint32_t text_id, const RenderT
         return;
     if (!state->textOverlay || state->textPending == NULL)
     {
-        mi_free((void*)blk);
+        ano_tfree(&ano_render_block_mem, (void*)blk);
         return;
     }
     for (uint32_t i = 0; i < state->textBlockCount; i++)
     {
         if (state->textBlocks[i].id == text_id)
         {
-            mi_free((void*)state->textBlocks[i].blk);
+            ano_tfree(&ano_render_block_mem, (void*)state->textBlocks[i].blk);
             state->textBlocks[i].blk = blk;
             text_blocks_append(state);
             return;
@@ -223,7 +226,7 @@ void ano_vk_text_block_set(RendererState* state, uint32_t text_id, const RenderT
     {
         ano_log(ANO_WARN, "Text bridge: block registry full (%u); text_id %u dropped.",
                ANO_TEXT_MAX_BLOCKS, text_id);
-        mi_free((void*)blk);
+        ano_tfree(&ano_render_block_mem, (void*)blk);
         return;
     }
     state->textBlocks[state->textBlockCount].id = text_id;
@@ -239,7 +242,7 @@ void ano_vk_text_block_clear(RendererState* state, uint32_t text_id)
     {
         if (state->textBlocks[i].id != text_id)
             continue;
-        mi_free((void*)state->textBlocks[i].blk);
+        ano_tfree(&ano_render_block_mem, (void*)state->textBlocks[i].blk);
         for (uint32_t j = i + 1; j < state->textBlockCount; j++)
             state->textBlocks[j - 1] = state->textBlocks[j];
         state->textBlockCount--;
@@ -583,8 +586,9 @@ bool ano_vk_text_init(VulkanContext* ctx, RendererState* state)
     if (!state->textOverlay)
         return true;
 
-    // CPU side: bake blobs live on textHeap.
+    // CPU side: bake blobs live on textHeap, counted by g_textRasterMem.
     state->textHeap = mi_heap_new();
+    ano_mem_tag_bind(&g_textRasterMem, state->textHeap);
     ano_fspath game = ano_fs_gamepath();
     char fontPath[512];
     snprintf(fontPath, sizeof fontPath, "%s/%s", game.str, ANO_TEXT_FONT_REL);
@@ -628,6 +632,10 @@ bool ano_vk_text_init(VulkanContext* ctx, RendererState* state)
         state->asyncText = false;
         return true;
     }
+    ano_tadopt(&g_textRasterMem, (void*)state->textBake.points);
+    ano_tadopt(&g_textRasterMem, (void*)state->textBake.glyphs);
+    ano_tadopt(&g_textRasterMem, (void*)state->textBake.ranges);
+    ano_tadopt(&g_textRasterMem, (void*)state->textBake.kerns);
 
     // Static glyph data: staged upload to device-local, CONCURRENT-shared with compute when async.
     VkDeviceSize curveBytes = (VkDeviceSize)state->textBake.pointCount * sizeof(uint32_t);
@@ -726,7 +734,7 @@ bool ano_vk_text_init(VulkanContext* ctx, RendererState* state)
     // Pending canonical text: full frame-buffer capacity, dies with textHeap.
     // ANO_TEXT_DEMO pins the torture text, else a boot line replaced by the mirror.
     uint32_t cap = ANO_TEXT_FRAME_BYTES / (uint32_t)sizeof(AnoGlyphInstance);
-    state->textPending = mi_heap_malloc(state->textHeap, (size_t)cap * sizeof(AnoGlyphInstance));
+    state->textPending = ano_tmalloc(&g_textRasterMem, (size_t)cap * sizeof(AnoGlyphInstance));
     if (state->textPending == NULL)
     {
         ano_log(ANO_WARN, "Text overlay disabled: pending-text allocation failed.");
@@ -1115,13 +1123,15 @@ void ano_vk_text_destroy(VulkanContext* ctx, RendererState* state)
     }
     // Logic text blocks: adopted copies on the default mi heap, not textHeap.
     for (uint32_t i = 0; i < state->textBlockCount; i++)
-        mi_free((void*)state->textBlocks[i].blk);
+        ano_tfree(&ano_render_block_mem, (void*)state->textBlocks[i].blk);
     state->textBlockCount = 0;
     // CPU side: FreeType down, bake blobs die with the heap.
     ano_text_shutdown();
     if (state->textHeap != NULL)
     {
         mi_heap_destroy(state->textHeap);
+        ano_mem_tag_release(&g_textRasterMem);
+        ano_mem_tag_release(&ano_vk_ui_mem);
         state->textHeap = NULL;
     }
 }
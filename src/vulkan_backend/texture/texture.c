@@ -7,8 +7,12 @@
 
 #include "vulkan_backend/texture/texture.h" 
 
+#include <anoptic_filesystem.h>
 #include <anoptic_log.h>
 
+#include <limits.h>
+#include <string.h>
+
 extern GpuAllocator textureAllocator;
 extern GpuAllocator stagingAllocator;
 
@@ -22,6 +26,69 @@ Texture8 readTexture8bit(char* fileName)
 	return texture;
 }
 
+// Derived-data cache of decoded images, keyed by the encoded file's bytes. Decoding is the CPU cost
+// of a texture load (mips are GPU blits, see generateMipmaps), so a hit skips stb_image entirely.
+// Blob: TextureBlobHeader | RGBA8 pixels, width * height * 4 bytes.
+#define TEXTURE_CACHE_VERSION 1u
+
+typedef struct TextureBlobHeader
+{
+	uint32_t width;
+	uint32_t height;
+	uint32_t channels;	// the source's channel count, as stbi reports it
+	uint32_t reserved;
+} TextureBlobHeader;
+
+// Decoded RGBA8 pixels of fileName, from the cache when these bytes were decoded before, else
+// decoded and stored. A hit leaves the pixels in *blob's mapping (ano_fs_cache_release after the
+// staging copy); a miss leaves blob empty and the pixels stbi's (stbi_image_free).
+static Texture8 readTexture8bitCached(const char* fileName, ano_fs_cache_blob* blob)
+{
+	Texture8 texture = {};
+	memset(blob, 0, sizeof *blob);
+	size_t fileSize = 0;
+	const stbi_uc* file = ano_fs_map_read(fileName, &fileSize);
+	if (!file || fileSize > INT_MAX)
+	{
+		if (file) ano_fs_unmap(file, fileSize);
+		return texture;
+	}
+
+	ano_fs_cache_key key = ano_fs_cache_key_begin("texture.rgba8", TEXTURE_CACHE_VERSION);
+	ano_fs_cache_key_add(&key, file, fileSize);
+	if (ano_fs_cache_get(&key, blob))
+	{
+		TextureBlobHeader header = {};
+		if (blob->size >= sizeof header) memcpy(&header, blob->data, sizeof header);
+		if (header.width > 0 && header.height > 0 && header.width <= INT32_MAX && header.height <= INT32_MAX &&
+			blob->size - sizeof header == (uint64_t)header.width * header.height * 4u)
+		{
+			texture.texWidth = (int32_t)header.width;
+			texture.texHeight = (int32_t)header.height;
+			texture.texChannels = (int32_t)header.channels;
+			texture.pixels = (stbi_uc*)blob->data + sizeof header;
+			ano_fs_unmap(file, fileSize);
+			return texture;
+		}
+		ano_fs_cache_release(blob);
+	}
+
+	texture.pixels = stbi_load_from_memory(file, (int)fileSize, &texture.texWidth, &texture.texHeight, &texture.texChannels, STBI_rgb_alpha);
+	ano_fs_unmap(file, fileSize);
+	if (texture.pixels)
+	{
+		TextureBlobHeader header = { (uint32_t)texture.texWidth, (uint32_t)texture.texHeight, (uint32_t)texture.texChannels, 0 };
+		ano_fs_cache_writer* writer = ano_fs_cache_put_begin(&key);
+		if (writer)
+		{
+			bool ok = ano_fs_cache_put_write(writer, &header, sizeof header) == 0 &&
+					  ano_fs_cache_put_write(writer, texture.pixels, (size_t)texture.texWidth * texture.texHeight * 4u) == 0;
+			ano_fs_cache_put_end(writer, ok);
+		}
+	}
+	return texture;
+}
+
 uint32_t bindless_register_texture(VulkanContext* ctx, BindlessTextureArray* bta, VkImageView view, VkSampler sampler)
 {
 	if (bta->textureCount >= bta->maxTextures) {
@@ -395,7 +462,8 @@ bool createTextureImageFromPixels(VulkanContext* ctx, VkCommandBuffer cmd, VkIma
 bool createTextureImage(VulkanContext* ctx, VkCommandBuffer cmd, VkImage* textureImage, GpuAllocation* textureImageAlloc, VkImageView* textureImageView, char* fileName, bool flag16, bool srgb, VkBuffer* outStagingBuffer)
 {
 	//!TODO Add logic for 16-bit images
-	Texture8 texture = readTexture8bit(fileName);
+	ano_fs_cache_blob cached;
+	Texture8 texture = readTexture8bitCached(fileName, &cached);
 	if (!texture.pixels)
 	{
 		ano_log(ANO_ERROR, "Failed to load texture image: %s", fileName);
@@ -417,7 +485,7 @@ bool createTextureImage(VulkanContext* ctx, VkCommandBuffer cmd, VkImage* textur
 	void* data = stagingAlloc.mapped;
 	memcpy(data, texture.pixels, (size_t)(imageSize));
 
-	stbi_image_free(texture.pixels);
+	if (cached.map) ano_fs_cache_release(&cached); else stbi_image_free(texture.pixels);
 
 	if (!createImage(ctx, &textureAllocator, texture.texWidth, texture.texHeight, texture.mipLevels, VK_SAMPLE_COUNT_1_BIT, texFormat, VK_IMAGE_TILING_OPTIMAL,
 					VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, textureImage, textureImageAlloc, false))
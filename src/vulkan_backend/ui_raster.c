@@ -37,6 +37,8 @@
 #define ANO_UI_TILEENT_BYTES (ANO_UI_MAX_TILE_ENTRIES * 4u)
 #define ANO_UI_FRAME_BYTES   (ANO_UI_TILEENT_OFF + ANO_UI_TILEENT_BYTES)
 
+ano_mem_tag_t ano_vk_ui_mem = ANO_MEM_TAG("ui");
+
 static_assert((ANO_UI_CLIP_OFF % 256u) == 0 && (ANO_UI_PAINT_OFF % 256u) == 0
                   && (ANO_UI_STOP_OFF % 256u) == 0 && (ANO_UI_CURVE_OFF % 256u) == 0
                   && (ANO_UI_TILEOFF_OFF % 256u) == 0 && (ANO_UI_TILEENT_OFF % 256u) == 0,
@@ -217,16 +219,17 @@ bool ano_vk_ui_init(VulkanContext* ctx, RendererState* state)
     // Pending compose tables on the text heap (dies with it at teardown).
     if (state->uiOverlay)
     {
-        state->uiPendingPrims = mi_heap_malloc(state->textHeap, ANO_UI_PRIM_BYTES);
-        state->uiPendingClips = mi_heap_malloc(state->textHeap, ANO_UI_CLIP_BYTES);
-        state->uiPendingPaints = mi_heap_malloc(state->textHeap, ANO_UI_PAINT_BYTES);
-        state->uiPendingStops = mi_heap_malloc(state->textHeap, ANO_UI_STOP_BYTES);
-        state->uiPendingCurves = mi_heap_malloc(state->textHeap, ANO_UI_CURVE_BYTES);
-        state->uiPendingGlyphs = mi_heap_malloc(state->textHeap,
-                                                ANO_UI_MAX_GLYPHS * sizeof(AnoGlyphInstance));
-        state->uiTileCursor = mi_heap_malloc(state->textHeap, ANO_UI_TILE_OFFSET_WORDS * 4u);
-        state->uiTileScratch = mi_heap_malloc(state->textHeap,
-                                              ANO_UI_TILEOFF_BYTES + ANO_UI_TILEENT_BYTES);
+        ano_mem_tag_bind(&ano_vk_ui_mem, state->textHeap);
+        state->uiPendingPrims = ano_tmalloc(&ano_vk_ui_mem, ANO_UI_PRIM_BYTES);
+        state->uiPendingClips = ano_tmalloc(&ano_vk_ui_mem, ANO_UI_CLIP_BYTES);
+        state->uiPendingPaints = ano_tmalloc(&ano_vk_ui_mem, ANO_UI_PAINT_BYTES);
+        state->uiPendingStops = ano_tmalloc(&ano_vk_ui_mem, ANO_UI_STOP_BYTES);
+        state->uiPendingCurves = ano_tmalloc(&ano_vk_ui_mem, ANO_UI_CURVE_BYTES);
+        state->uiPendingGlyphs = ano_tmalloc(&ano_vk_ui_mem,
+                                             ANO_UI_MAX_GLYPHS * sizeof(AnoGlyphInstance));
+        state->uiTileCursor = ano_tmalloc(&ano_vk_ui_mem, ANO_UI_TILE_OFFSET_WORDS * 4u);
+        state->uiTileScratch = ano_tmalloc(&ano_vk_ui_mem,
+                                           ANO_UI_TILEOFF_BYTES + ANO_UI_TILEENT_BYTES);
         state->uiTilesEnabled = getenv("ANO_FORCE_NO_UI_TILES") == NULL;
         if (!state->uiPendingPrims || !state->uiPendingClips || !state->uiPendingPaints
             || !state->uiPendingStops || !state->uiPendingCurves || !state->uiPendingGlyphs
@@ -259,14 +262,14 @@ void ano_vk_ui_block_set(RendererState* state, uint32_t ui_id, const RenderUiBlo
         return;
     if (!state->uiOverlay || state->uiPendingPrims == NULL)
     {
-        mi_free((void*)blk);
+        ano_tfree(&ano_render_block_mem, (void*)blk);
         return;
     }
     for (uint32_t i = 0; i < state->uiBlockCount; i++)
     {
         if (state->uiBlocks[i].id == ui_id)
         {
-            mi_free((void*)state->uiBlocks[i].blk);
+            ano_tfree(&ano_render_block_mem, (void*)state->uiBlocks[i].blk);
             state->uiBlocks[i].blk = blk;
             state->uiComposeDirty = true;
             return;
@@ -276,7 +279,7 @@ void ano_vk_ui_block_set(RendererState* state, uint32_t ui_id, const RenderUiBlo
     {
         ano_log(ANO_WARN, "UI bridge: block registry full (%u); ui_id %u dropped.",
                 ANO_UI_MAX_BLOCKS, ui_id);
-        mi_free((void*)blk);
+        ano_tfree(&ano_render_block_mem, (void*)blk);
         return;
     }
     state->uiBlocks[state->uiBlockCount].id = ui_id;
@@ -300,7 +303,7 @@ void ano_vk_ui_block_clear(RendererState* state, uint32_t ui_id)
     {
         if (state->uiBlocks[i].id != ui_id)
             continue;
-        mi_free((void*)state->uiBlocks[i].blk);
+        ano_tfree(&ano_render_block_mem, (void*)state->uiBlocks[i].blk);
         for (uint32_t j = i + 1; j < state->uiBlockCount; j++)
             state->uiBlocks[j - 1] = state->uiBlocks[j];
         state->uiBlockCount--;
@@ -451,7 +454,7 @@ void ano_vk_ui_write_sets(VulkanContext* ctx, RendererState* state)
 void ano_vk_ui_destroy(VulkanContext* ctx, RendererState* state)
 {
     for (uint32_t i = 0; i < state->uiBlockCount; i++)
-        mi_free((void*)state->uiBlocks[i].blk);
+        ano_tfree(&ano_render_block_mem, (void*)state->uiBlocks[i].blk);
     state->uiBlockCount = 0;
     // Pending tables die with the text heap (torn down in ano_vk_text_destroy).
     state->uiPendingPrims = NULL;
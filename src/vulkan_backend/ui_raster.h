@@ -12,6 +12,12 @@
 
 #include "vulkan_backend/structs.h"
 
+#include <anoptic_memory.h>
+
+// The pending compose tables, on the text heap beside the text raster's own blocks. Released with it in
+// ano_vk_text_destroy.
+extern ano_mem_tag_t ano_vk_ui_mem;
+
 // One-time init on the render thread, after ano_vk_text_init. Creates the per-frame
 // table buffers. Always returns true: failure logs, clears state->uiOverlay, and the
 // set writes fall back to the text frame buffer.
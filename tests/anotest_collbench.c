@@ -0,0 +1,206 @@
+/* SPDX-FileCopyrightText: 2026 Anoptic Game Engine Authors
+ *
+ * SPDX-License-Identifier: LGPL-3.0 */
+/*  == Anoptic Game Engine v0.0000001 == */
+
+// Collections contention benchmark: the SPSC ring, the Vyukov MPMC ring, the M&S queue and the striped
+// batch queue (64- and 128-byte stripes) under 1..N producers x 1..N consumers. Per point: total
+// throughput (elements through the queue per second, first push to last pop), and per-op latency
+// percentiles for push and pop. A push that meets a full ring retries inside its own timed section, so
+// backpressure lands in the push tail. A pop that finds the queue empty is not an op and goes untimed.
+// A striped pop takes a whole stripe, so its row is per stripe, not per element. Its pushes are per
+// element, and each producer flushes its last partial stripe untimed.
+//
+// The striped queue exists for many-core hosts, where cache-line transfers between cores dominate:
+// compare its throughput against mpmc at the 4P and 8P points there. On a machine with fewer cores than
+// threads the numbers mostly measure the scheduler. Built so it cannot rot, DISABLED in CTest. Run
+// ./anotest_collbench by hand from an -O3 build. Always exits 0 and prints a table. argv[1] overrides
+// elements per producer.
+
+#include <anoptic_collections.h>
+#include <anoptic_threads.h>
+#include <anoptic_time.h>
+
+#include "templates/bench.h"
+
+#include <mimalloc.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define DEFAULT_OPS 200000      // per producer per point
+#define RING_CAP    1024u
+#define MAXT        8
+static const int POINTS[][2] = { {1, 1}, {2, 2}, {4, 4}, {8, 8}, {1, 4}, {4, 1} };
+#define NPOINTS     (int)(sizeof POINTS / sizeof POINTS[0])
+
+static int g_ops = DEFAULT_OPS;
+
+typedef enum { Q_SPSC, Q_MPMC, Q_MSQ, Q_STRIPE64, Q_STRIPE128 } qkind_t;
+static const char *const QNAME[] = { "spsc", "mpmc", "msq", "stripe64", "stripe128" };
+
+typedef struct {
+    qkind_t      kind;
+    AnoSpscRing *spsc;
+    AnoMpmcRing *mpmc;
+    AnoMsQueue  *msq;
+    AnoStripeQueue *stripe;
+    AnoStripeWriter writer;         // producer, striped queue only
+    int          count;             // producer: elements to push. consumer: unused
+    _Atomic int64_t *remaining;     // elements still to pop, shared by consumers
+    bench_lat    lat;
+} bench_arg;
+
+static inline bool q_push(bench_arg *a, const uint64_t *v)
+{
+    switch (a->kind) {
+    case Q_SPSC: return ano_spsc_push(a->spsc, v);
+    case Q_MPMC: return ano_mpmc_push(a->mpmc, v);
+    case Q_MSQ:  return ano_msq_push(a->msq, v);
+    default:     return ano_stripe_push(&a->writer, v);
+    }
+}
+
+// Elements popped: 0 or 1, or a whole stripe. `v` holds ANO_STRIPE_COUNT_ elements.
+static inline uint32_t q_pop(bench_arg *a, uint64_t *v)
+{
+    switch (a->kind) {
+    case Q_SPSC: return ano_spsc_pop(a->spsc, v);
+    case Q_MPMC: return ano_mpmc_pop(a->mpmc, v);
+    case Q_MSQ:  return ano_msq_pop(a->msq, v);
+    default:     return ano_stripe_pop(a->stripe, v);
+    }
+}
+
+static void *producer(void *p)
+{
+    bench_arg *a = p;
+    for (int i = 0; i < a->count; i++) {
+        uint64_t v = (uint64_t)i, t0 = bench_begin();
+        while (!q_push(a, &v))
+            ano_thread_yield();
+        bench_lat_add(&a->lat, bench_end(t0));
+    }
+    if (a->stripe)
+        while (!ano_stripe_flush(&a->writer))
+            ano_thread_yield();
+    return NULL;
+}
+
+static void *consumer(void *p)
+{
+    bench_arg *a = p;
+    while (atomic_load_explicit(a->remaining, memory_order_relaxed) > 0) {
+        uint64_t v[ANO_STRIPE_COUNT_], t0 = bench_begin();
+        uint32_t n = q_pop(a, v);
+        if (n == 0) {
+            ano_thread_yield();
+            continue;
+        }
+        bench_lat_add(&a->lat, bench_end(t0));
+        atomic_fetch_sub_explicit(a->remaining, n, memory_order_relaxed);
+    }
+    return NULL;
+}
+
+// Merge the per-thread slices [first, first + n) into one sample set. Slices are adjacent in buf and
+// consumers' partly filled, so compact them first.
+static bench_stats merge(bench_arg *a, int first, int n, uint64_t *base)
+{
+    size_t at = 0;
+    uint64_t lost = 0;
+    for (int i = first; i < first + n; i++) {
+        memmove(base + at, a[i].lat.ticks, a[i].lat.n * sizeof *base);
+        at   += a[i].lat.n;
+        lost += a[i].lat.lost;
+    }
+    bench_lat m;
+    bench_lat_init(&m, base, at);
+    m.n = at;
+    m.lost = lost;
+    return bench_lat_stats(&m);
+}
+
+static void run_point(qkind_t kind, int producers, int consumers, mi_heap_t *heap, uint64_t *buf)
+{
+    AnoSpscRing spsc;
+    AnoMpmcRing mpmc;
+    AnoMsQueue  msq;
+    AnoStripeQueue stripe;
+    // Stripes sized so the striped queue holds about RING_CAP elements, like the rings.
+    uint32_t stripeBytes = kind == Q_STRIPE64 ? 64u : 128u;
+    uint32_t stripes     = RING_CAP / ((stripeBytes - 8u) / (uint32_t)sizeof(uint64_t));
+    bool ok = kind == Q_SPSC ? ano_spsc_init(&spsc, heap, RING_CAP, sizeof(uint64_t))
+            : kind == Q_MPMC ? ano_mpmc_init(&mpmc, heap, RING_CAP, sizeof(uint64_t))
+            : kind == Q_MSQ  ? ano_msq_init(&msq, sizeof(uint64_t))
+            :                  ano_stripe_init(&stripe, heap, stripes, sizeof(uint64_t), stripeBytes);
+    if (!ok) {
+        printf("%s: init failed\n", QNAME[kind]);
+        return;
+    }
+
+    _Atomic int64_t remaining = (int64_t)producers * g_ops;
+    anothread_t th[2 * MAXT];
+    bench_arg   arg[2 * MAXT];
+    int total = producers + consumers;
+    // Producers get g_ops samples each, consumers split the rest of buf: a consumer can pop far more
+    // than its share.
+    size_t share = ((size_t)2 * MAXT - (size_t)producers) * (size_t)g_ops / (size_t)consumers;
+    uint64_t *slice = buf;
+    for (int i = 0; i < total; i++) {
+        size_t cap = i < producers ? (size_t)g_ops : share;
+        bool striped = kind == Q_STRIPE64 || kind == Q_STRIPE128;
+        arg[i] = (bench_arg){ .kind = kind, .spsc = &spsc, .mpmc = &mpmc, .msq = &msq,
+                              .stripe = striped ? &stripe : NULL, .writer = ano_stripe_writer(&stripe),
+                              .count = g_ops, .remaining = &remaining };
+        bench_lat_init(&arg[i].lat, slice, cap);
+        slice += cap;
+    }
+    uint64_t t0 = ano_timestamp_raw();
+    for (int i = 0; i < total; i++)
+        ano_thread_create(&th[i], NULL, i < producers ? producer : consumer, &arg[i]);
+    for (int i = 0; i < total; i++)
+        ano_thread_join(th[i], NULL);
+    uint64_t elapsed = ano_timestamp_raw() - t0;
+
+    char label[48];
+    snprintf(label, sizeof label, "%s %dP/%dC push", QNAME[kind], producers, consumers);
+    bench_lat_row(label, merge(arg, 0, producers, buf));
+    snprintf(label, sizeof label, "%s %dP/%dC pop%s", QNAME[kind], producers, consumers,
+             kind >= Q_STRIPE64 ? "/stripe" : "");
+    bench_lat_row(label, merge(arg, producers, consumers, buf));
+    printf("%-28s %9.2f Mops/s\n", "", bench_ops_per_sec((uint64_t)producers * g_ops, elapsed) / 1e6);
+
+    if (kind == Q_SPSC)      ano_spsc_destroy(&spsc);
+    else if (kind == Q_MPMC) ano_mpmc_destroy(&mpmc);
+    else if (kind == Q_MSQ) { ano_msq_destroy(&msq); ano_msq_reclaim(); }
+    else                    ano_stripe_destroy(&stripe);
+}
+
+int main(int argc, char **argv)
+{
+    if (argc > 1) {
+        int v = atoi(argv[1]);
+        if (v > 0) g_ops = v;
+    }
+    uint64_t *buf = malloc((size_t)2 * MAXT * (size_t)g_ops * sizeof *buf);
+    mi_heap_t *heap = mi_heap_new();
+    if (buf == NULL || heap == NULL) {
+        fprintf(stderr, "collbench: allocation failed\n");
+        return 0;   // benchmark, not a test: never fails the suite
+    }
+
+    printf("Anoptic collections contention benchmark -- %d elements/producer, ring capacity %u\n\n",
+           g_ops, RING_CAP);
+    bench_lat_header();
+    run_point(Q_SPSC, 1, 1, heap, buf);
+    for (int k = Q_MPMC; k <= Q_STRIPE128; k++)
+        for (int p = 0; p < NPOINTS; p++)
+            run_point((qkind_t)k, POINTS[p][0], POINTS[p][1], heap, buf);
+
+    mi_heap_delete(heap);
+    free(buf);
+    printf("\n(Throughput counts each element once, push to pop. Oversubscribed points measure the\n"
+           " scheduler as much as the queue. Numbers vary run to run; take the trend.)\n");
+    return 0;
+}
@@ -0,0 +1,331 @@
+/* SPDX-FileCopyrightText: 2026 Anoptic Game Engine Authors
+ *
+ * SPDX-License-Identifier: LGPL-3.0 */
+/*  == Anoptic Game Engine v0.0000001 == */
+
+/* Coverage for anoptic_collections.h (the SPSC ring's own coverage is anotest_render_bridge):
+ *  - single-threaded MPMC ring and M&S queue: FIFO order, full/empty edges, index wraparound,
+ *    an odd element size;
+ *  - single-threaded striped queue: stripe geometry, partial stripes and flush, full ring with the claim
+ *    kept, empty flushes stepped over, a gap at the head holding back later stripes;
+ *  - concurrent stress (TSan target), P producers x C consumers on each queue: every element is
+ *    popped exactly once, and each consumer sees each producer's elements in push order;
+ *  - hazard records: thread churn hands records back, and ano_msq_reclaim runs clean after the joins.
+ * Exit 0 == pass. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <mimalloc.h>
+#include "anoptic_collections.h"
+#include "anoptic_threads.h"
+
+_Static_assert(offsetof(AnoMpmcRing, head) - offsetof(AnoMpmcRing, tail) >= ANO_CACHE_LINE,
+               "MPMC head/tail must live on separate cache lines");
+_Static_assert(offsetof(AnoMsQueue, tail) - offsetof(AnoMsQueue, head) >= ANO_CACHE_LINE,
+               "M&S head/tail must live on separate cache lines");
+_Static_assert(offsetof(AnoStripeQueue, head) - offsetof(AnoStripeQueue, tail) >= ANO_CACHE_LINE,
+               "stripe head/tail must live on separate cache lines");
+
+static int failures = 0;
+#define CHECK(cond, msg) do { \
+    if (!(cond)) { printf("FAIL: %s (%s:%d)\n", (msg), __FILE__, __LINE__); failures++; } \
+} while (0)
+
+// 12 bytes: not a multiple of 8, so the MPMC cell rounding is exercised.
+typedef struct { uint32_t producer, seq, check; } item_t;
+static inline uint32_t check_of(uint32_t p, uint32_t s) { return (p * 2654435761u) ^ s; }
+
+static void test_mpmc_single(mi_heap_t *heap)
+{
+    AnoMpmcRing r;
+    CHECK(!ano_mpmc_init(&r, heap, 4, 0), "zero stride refused");
+    CHECK(ano_mpmc_init(&r, heap, 3, sizeof(item_t)), "init (cap 3 -> 4)");
+    CHECK(r.mask == 3u && r.cellStride == 24u, "capacity rounded, cell 8-byte rounded");
+    item_t x = {0};
+    CHECK(!ano_mpmc_pop(&r, &x), "pop empty");
+    for (uint32_t i = 0; i < 4; i++) {
+        item_t v = { 1, i, check_of(1, i) };
+        CHECK(ano_mpmc_push(&r, &v), "push to capacity");
+    }
+    item_t over = { 1, 99, 0 };
+    CHECK(!ano_mpmc_push(&r, &over), "push full rejected");
+    // Ten laps through a four-cell ring, one element in flight.
+    bool fifo = true;
+    for (uint32_t i = 0; i < 4; i++)
+        fifo &= ano_mpmc_pop(&r, &x) && x.seq == i && x.check == check_of(1, i);
+    for (uint32_t i = 0; i < 40; i++) {
+        item_t v = { 2, i, check_of(2, i) };
+        fifo &= ano_mpmc_push(&r, &v);
+        fifo &= ano_mpmc_pop(&r, &x) && x.seq == i && x.check == check_of(2, i);
+    }
+    CHECK(fifo, "FIFO through full, drain and wraparound");
+    CHECK(!ano_mpmc_pop(&r, &x), "pop empty after wrap");
+    ano_mpmc_destroy(&r);
+}
+
+static void test_msq_single(void)
+{
+    AnoMsQueue q;
+    CHECK(!ano_msq_init(&q, 0), "zero stride refused");
+    CHECK(ano_msq_init(&q, sizeof(item_t)), "init");
+    item_t x = {0};
+    CHECK(!ano_msq_pop(&q, &x), "pop empty");
+    bool fifo = true;
+    for (uint32_t i = 0; i < 1000; i++) {
+        item_t v = { 1, i, check_of(1, i) };
+        fifo &= ano_msq_push(&q, &v);
+    }
+    for (uint32_t i = 0; i < 1000; i++)
+        fifo &= ano_msq_pop(&q, &x) && x.seq == i && x.check == check_of(1, i);
+    CHECK(fifo, "FIFO, unbounded");
+    CHECK(!ano_msq_pop(&q, &x), "pop empty after drain");
+    item_t v = { 3, 3, check_of(3, 3) };
+    ano_msq_push(&q, &v);
+    ano_msq_destroy(&q);        // frees the queued node too
+    ano_msq_reclaim();
+}
+
+static void test_stripe_single(mi_heap_t *heap)
+{
+    AnoStripeQueue q;
+    CHECK(!ano_stripe_init(&q, heap, 4, 0, 0), "zero stride refused");
+    CHECK(!ano_stripe_init(&q, heap, 4, ANO_CACHE_LINE, 0), "stride leaving no room refused");
+    CHECK(!ano_stripe_init(&q, heap, 4, 1, 256), "more than 127 per stripe refused");
+    CHECK(ano_stripe_init(&q, heap, 2, sizeof(item_t), 64), "init (2 stripes)");
+    CHECK(q.stripeBytes == ANO_CACHE_LINE && q.perStripe == (ANO_CACHE_LINE - 8u) / sizeof(item_t),
+          "one cache line per stripe, commit word + elements");
+    CHECK(((uintptr_t)q.stripes & (ANO_CACHE_LINE - 1u)) == 0u, "stripes cache-line aligned");
+
+    const uint32_t per = q.perStripe;
+    item_t out[ANO_STRIPE_COUNT_];
+    AnoStripeWriter w = ano_stripe_writer(&q);
+    CHECK(ano_stripe_pop(&q, out) == 0u, "pop empty");
+    CHECK(ano_stripe_flush(&w), "flush with nothing claimed");
+
+    // A partial stripe stays invisible until flushed.
+    bool fifo = true;
+    for (uint32_t i = 0; i < 2; i++) {
+        item_t v = { 1, i, check_of(1, i) };
+        fifo &= ano_stripe_push(&w, &v);
+    }
+    CHECK(ano_stripe_pop(&q, out) == 0u, "partial stripe not yet visible");
+    CHECK(ano_stripe_flush(&w), "flush partial");
+    fifo &= ano_stripe_pop(&q, out) == 2u && out[0].seq == 0 && out[1].seq == 1 && out[1].check == check_of(1, 1);
+    CHECK(fifo, "partial stripe published by flush");
+
+    // Fill both stripes: each commits itself when full. The next push claims a stripe still holding last
+    // lap's elements and is refused, keeping the claim.
+    uint32_t seq = 0;
+    for (uint32_t i = 0; i < 2 * per; i++) {
+        item_t v = { 2, seq, check_of(2, seq) };
+        fifo &= ano_stripe_push(&w, &v);
+        seq++;
+    }
+    item_t v = { 2, seq, check_of(2, seq) };
+    CHECK(!ano_stripe_push(&w, &v), "push full rejected");
+    CHECK(!ano_stripe_flush(&w), "flush of a claimed, not yet free stripe rejected");
+    CHECK(ano_stripe_pop(&q, out) == per && out[0].seq == 0 && out[per - 1].seq == per - 1, "full stripe");
+    // Freed: the held claim goes out empty, and pop steps over it.
+    CHECK(ano_stripe_flush(&w), "flush empty claim once free");
+    CHECK(ano_stripe_pop(&q, out) == per && out[0].seq == per, "second stripe");
+    CHECK(ano_stripe_pop(&q, out) == 0u, "empty stripe stepped over, then empty");
+
+    // Out-of-order publication: a later stripe waits behind an open one.
+    AnoStripeWriter a = ano_stripe_writer(&q), b = ano_stripe_writer(&q);
+    item_t x = { 3, 0, check_of(3, 0) };
+    CHECK(ano_stripe_push(&a, &x), "writer a opens a stripe");
+    for (uint32_t i = 0; i < per; i++) {
+        item_t y = { 4, i, check_of(4, i) };
+        fifo &= ano_stripe_push(&b, &y);
+    }
+    CHECK(ano_stripe_pop(&q, out) == 0u, "committed stripe held back by the open one");
+    CHECK(ano_stripe_flush(&a), "writer a flushes");
+    CHECK(ano_stripe_pop(&q, out) == 1u && out[0].producer == 3, "open stripe first");
+    CHECK(ano_stripe_pop(&q, out) == per && out[0].producer == 4, "then the one behind it");
+    CHECK(fifo, "stripe pushes");
+    ano_stripe_destroy(&q);
+}
+
+#define PRODUCERS 4
+#define CONSUMERS 4
+#define PER_PROD  50000u
+
+typedef struct {
+    AnoMpmcRing *ring;          // one of ring / queue
+    AnoMsQueue  *queue;
+    AnoStripeQueue *stripes;
+    uint32_t     id;
+    _Atomic uint32_t *done;     // producers finished
+    uint8_t     *seen;          // PRODUCERS * PER_PROD flags, shared, each slot written once
+    _Atomic uint32_t *dupes;
+    bool         ordered;       // consumer: per-producer order held
+    uint32_t     popped;
+    item_t       batch[ANO_STRIPE_COUNT_];  // consumer: the stripe being handed out
+    uint32_t     batchAt, batchN;
+} worker_t;
+
+static void *producer_main(void *arg)
+{
+    worker_t *w = arg;
+    AnoStripeWriter sw = ano_stripe_writer(w->stripes);
+    for (uint32_t i = 0; i < PER_PROD; i++) {
+        item_t v = { w->id, i, check_of(w->id, i) };
+        if (w->ring)         while (!ano_mpmc_push(w->ring, &v)) ano_thread_yield();
+        else if (w->queue)   while (!ano_msq_push(w->queue, &v)) ano_thread_yield();
+        else {
+            while (!ano_stripe_push(&sw, &v)) ano_thread_yield();
+            // Batches of 100 end mid-stripe, so partial stripes are in the mix.
+            if (i % 100u == 99u)
+                while (!ano_stripe_flush(&sw)) ano_thread_yield();
+        }
+    }
+    if (w->stripes)
+        while (!ano_stripe_flush(&sw)) ano_thread_yield();
+    atomic_fetch_add_explicit(w->done, 1, memory_order_release);
+    return NULL;
+}
+
+// One of ring / queue / stripes, whichever the worker carries. Stripes are popped whole and handed out
+// one element at a time.
+static bool pop_any(worker_t *w, item_t *v)
+{
+    if (w->ring)  return ano_mpmc_pop(w->ring, v);
+    if (w->queue) return ano_msq_pop(w->queue, v);
+    if (w->batchAt == w->batchN) {
+        w->batchN  = ano_stripe_pop(w->stripes, w->batch);
+        w->batchAt = 0;
+        if (w->batchN == 0)
+            return false;
+    }
+    *v = w->batch[w->batchAt++];
+    return true;
+}
+
+static void *consumer_main(void *arg)
+{
+    worker_t *w = arg;
+    int64_t last[PRODUCERS];
+    for (int i = 0; i < PRODUCERS; i++) last[i] = -1;
+    w->ordered = true;
+    for (;;) {
+        item_t v;
+        if (!pop_any(w, &v)) {
+            if (atomic_load_explicit(w->done, memory_order_acquire) == PRODUCERS) {
+                if (!pop_any(w, &v))
+                    break;      // producers done and still empty: drained
+            } else {
+                ano_thread_yield();
+                continue;
+            }
+        }
+        if (v.producer >= PRODUCERS || v.seq >= PER_PROD || v.check != check_of(v.producer, v.seq)) {
+            w->ordered = false;
+            continue;
+        }
+        if ((int64_t)v.seq <= last[v.producer]) w->ordered = false;
+        last[v.producer] = v.seq;
+        uint8_t *flag = &w->seen[(size_t)v.producer * PER_PROD + v.seq];
+        if (*flag) atomic_fetch_add_explicit(w->dupes, 1, memory_order_relaxed);
+        *flag = 1;
+        w->popped++;
+    }
+    return NULL;
+}
+
+static void stress(const char *name, AnoMpmcRing *ring, AnoMsQueue *queue, AnoStripeQueue *stripes)
+{
+    _Atomic uint32_t done = 0, dupes = 0;
+    uint8_t *seen = calloc((size_t)PRODUCERS * PER_PROD, 1);
+    worker_t w[PRODUCERS + CONSUMERS];
+    anothread_t th[PRODUCERS + CONSUMERS];
+    for (uint32_t i = 0; i < PRODUCERS + CONSUMERS; i++) {
+        w[i] = (worker_t){ .ring = ring, .queue = queue, .stripes = stripes, .id = i, .done = &done,
+                           .seen = seen, .dupes = &dupes };
+        void *(*fn)(void *) = i < PRODUCERS ? producer_main : consumer_main;
+        CHECK(ano_thread_create(&th[i], NULL, fn, &w[i]) == 0, "spawn");
+    }
+    for (int i = 0; i < PRODUCERS + CONSUMERS; i++)
+        ano_thread_join(th[i], NULL);
+
+    uint64_t popped = 0;
+    bool ordered = true;
+    for (int i = PRODUCERS; i < PRODUCERS + CONSUMERS; i++) {
+        popped += w[i].popped;
+        ordered &= w[i].ordered;
+    }
+    size_t missing = 0;
+    for (size_t i = 0; i < (size_t)PRODUCERS * PER_PROD; i++)
+        missing += seen[i] == 0;
+    char msg[96];
+    snprintf(msg, sizeof msg, "%s: every element popped exactly once", name);
+    CHECK(popped == (uint64_t)PRODUCERS * PER_PROD && missing == 0 && dupes == 0, msg);
+    snprintf(msg, sizeof msg, "%s: per-producer order and payloads intact", name);
+    CHECK(ordered, msg);
+    free(seen);
+}
+
+// Short-lived threads each claim a hazard record and hand it back at exit, so later waves reuse them.
+static void *churn_main(void *arg)
+{
+    AnoMsQueue *q = arg;
+    item_t v = { 0, 0, check_of(0, 0) };
+    for (int i = 0; i < 100; i++) {
+        ano_msq_push(q, &v);
+        ano_msq_pop(q, &v);
+    }
+    return NULL;
+}
+
+static void test_churn(void)
+{
+    AnoMsQueue q;
+    CHECK(ano_msq_init(&q, sizeof(item_t)), "init");
+    for (int wave = 0; wave < 16; wave++) {
+        anothread_t th[4];
+        for (int i = 0; i < 4; i++)
+            CHECK(ano_thread_create(&th[i], NULL, churn_main, &q) == 0, "spawn");
+        for (int i = 0; i < 4; i++)
+            ano_thread_join(th[i], NULL);
+    }
+    item_t x;
+    while (ano_msq_pop(&q, &x)) { }
+    ano_msq_destroy(&q);
+    ano_msq_reclaim();
+}
+
+int main(void)
+{
+    printf("anotest_collections: MPMC ring, M&S queue, striped queue\n");
+    mi_heap_t *heap = mi_heap_new();
+
+    test_mpmc_single(heap);
+    test_msq_single();
+    test_stripe_single(heap);
+
+    AnoMpmcRing ring;
+    CHECK(ano_mpmc_init(&ring, heap, 64, sizeof(item_t)), "mpmc init (small, so it wraps and fills)");
+    stress("mpmc", &ring, NULL, NULL);
+    ano_mpmc_destroy(&ring);
+
+    AnoMsQueue queue;
+    CHECK(ano_msq_init(&queue, sizeof(item_t)), "msq init");
+    stress("msq", NULL, &queue, NULL);
+    ano_msq_destroy(&queue);
+    ano_msq_reclaim();
+
+    AnoStripeQueue stripes;
+    CHECK(ano_stripe_init(&stripes, heap, 16, sizeof(item_t), 0), "stripe init (small, so it wraps and fills)");
+    stress("stripe", NULL, NULL, &stripes);
+    ano_stripe_destroy(&stripes);
+
+    test_churn();
+
+    mi_heap_delete(heap);
+    if (failures) {
+        printf("anotest_collections: %d FAILURE(S)\n", failures);
+        return 1;
+    }
+    printf("anotest_collections: all passed\n");
+    return 0;
+}
@@ -3,14 +3,22 @@
  * SPDX-License-Identifier: LGPL-3.0 */
 /*  == Anoptic Game Engine v0.0000001 == */
 
-/* Coverage for anoptic_filesystem.h -- the ano_fspath value type and the append-only file API:
+/* Coverage for anoptic_filesystem.h -- the ano_fspath value type, the append-only file API
+ * and read-only mapping:
  *   - ano_fs_gamepath: resolved, NUL-terminated at length, no trailing separator, and usable
  *     (ano_fs_chdir_gamepath succeeds against it);
  *   - ano_fs_userpath: resolved to <user-data root>/ANO_GAME_NAME (Factorio convention), the
  *     directory exists after the call, and a file can be created inside it (removed after);
  *   - ano_file: open-append/write/sync/close round-trip in the test's scratch dir, with
  *     scratch_count_lines as the oracle (N writes in, N lines out) and append-not-truncate
- *     verified across a close/reopen.
+ *     verified across a close/reopen;
+ *   - ano_fs_replace / ano_fs_map_read: replace swaps in the new file and retires the old name,
+ *     the mapping reads the exact bytes, empty and missing files refuse to map;
+ *   - ano_fs_cache_*: keys separate tool, version, content and chunking; off until configured;
+ *     put/get round-trip with a 64-byte-aligned payload, streamed puts equal one-shot puts, an
+ *     uncommitted writer publishes nothing, a damaged entry misses and is dropped, an entry over
+ *     the cap is refused, and eviction past the cap removes the least recently USED entries
+ *     (a hit refreshes an old one), all in a scratch cache dir.
  * The userpath check touches the real per-user directory (the one the engine itself uses);
  * it only adds and removes one probe file there and never deletes the directory.
  * Exit 0 == pass; failures print what broke. */
@@ -19,6 +27,7 @@
 #include <string.h>
 
 #include "anoptic_filesystem.h"
+#include "anoptic_time.h"
 #include "templates/scratch.h"
 
 static int failures = 0;
@@ -131,12 +140,164 @@ static void test_append_file_api(void)
     scratch_remove_dir(dir);
 }
 
+static void test_map_replace(void)
+{
+    ano_fspath base = ano_fs_gamepath();
+    char dir[512], from[512], to[512];
+    int nd = snprintf(dir, sizeof dir, "%s/anotest_filesystem_scratch", base.str);
+    int nf = snprintf(from, sizeof from, "%s/map.new", dir);
+    int nt = snprintf(to, sizeof to, "%s/map.bin", dir);
+    if (nd < 0 || nf < 0 || nt < 0 ||
+        (size_t)nd >= sizeof dir || (size_t)nf >= sizeof from || (size_t)nt >= sizeof to) {
+        CHECK(0, "scratch paths fit their buffers");
+        return;
+    }
+    scratch_make_dir(dir);
+
+    static const char old[] = "old contents", fresh[] = "mapped, read-only, page-aligned";
+    ano_file *f = ano_fs_open_trunc(to);
+    CHECK(f != NULL && ano_fs_write(f, old, sizeof old - 1) == 0 && ano_fs_close(f) == 0, "write old");
+    f = ano_fs_open_trunc(from);
+    CHECK(f != NULL && ano_fs_write(f, fresh, sizeof fresh - 1) == 0 && ano_fs_close(f) == 0, "write new");
+
+    CHECK(ano_fs_replace(from, to) == 0, "replace over an existing file");
+    size_t size = 0;
+    const void *map = ano_fs_map_read(from, &size);
+    CHECK(map == NULL, "the source name is gone after replace");
+    map = ano_fs_map_read(to, &size);
+    CHECK(map != NULL, "map the replaced file");
+    if (map != NULL) {
+        CHECK(size == sizeof fresh - 1 && memcmp(map, fresh, size) == 0, "mapping holds the new bytes");
+        CHECK(ano_fs_unmap(map, size) == 0, "unmap");
+    }
+
+    f = ano_fs_open_trunc(from);
+    CHECK(f != NULL && ano_fs_close(f) == 0, "create an empty file");
+    CHECK(ano_fs_map_read(from, &size) == NULL, "an empty file does not map");
+    CHECK(ano_fs_map_read(NULL, &size) == NULL && ano_fs_map_read(to, NULL) == NULL, "NULL refused (map)");
+    CHECK(ano_fs_unmap(NULL, 0) == -1, "NULL refused (unmap)");
+    CHECK(ano_fs_replace(NULL, to) == -1, "NULL refused (replace)");
+
+    remove(from);
+    remove(to);
+    scratch_remove_dir(dir);
+}
+
+// "<dir>/<key>.anoc", the entry name the cache stores a key under.
+static void cache_entry(char *out, size_t cap, const char *dir, const ano_fs_cache_key *k)
+{
+    snprintf(out, cap, "%s/%016llx%016llx.anoc", dir, (unsigned long long)k->hi, (unsigned long long)k->lo);
+}
+
+static bool cache_has(const ano_fs_cache_key *k)
+{
+    ano_fs_cache_blob blob;
+    bool hit = ano_fs_cache_get(k, &blob);
+    ano_fs_cache_release(&blob);
+    return hit;
+}
+
+static void test_cache(void)
+{
+    ano_fs_cache_key a = ano_fs_cache_key_begin("tool", 1), b = ano_fs_cache_key_begin("tool", 1);
+    CHECK(a.lo == b.lo && a.hi == b.hi, "keys are deterministic");
+    ano_fs_cache_key v2 = ano_fs_cache_key_begin("tool", 2), other = ano_fs_cache_key_begin("tool2", 1);
+    CHECK(v2.lo != a.lo && other.lo != a.lo, "tool and version separate keys");
+    ano_fs_cache_key_add(&a, "abc", 3);
+    ano_fs_cache_key_add(&b, "ab", 2);
+    ano_fs_cache_key_add(&b, "c", 1);
+    CHECK(a.lo != b.lo || a.hi != b.hi, "chunking counts: (abc) != (ab, c)");
+
+    static uint8_t payload[4096];
+    for (size_t i = 0; i < sizeof payload; i++)
+        payload[i] = (uint8_t)(i * 131u + 7u);
+    ano_fs_cache_blob blob;
+    CHECK(!ano_fs_cache_get(&a, &blob) && blob.data == NULL, "off until configured: get misses");
+    CHECK(ano_fs_cache_put(&a, payload, sizeof payload) == -1, "off until configured: put refuses");
+
+    ano_fspath base = ano_fs_gamepath();
+    char dir[512], path[640];
+    snprintf(dir, sizeof dir, "%s/anotest_filesystem_cache", base.str);
+    uint64_t entry = sizeof payload + 96u;  // 64-byte header, 32-byte trailer
+    CHECK(ano_fs_cache_configure(dir, 3u * entry + 64u) == 0, "configure a scratch cache");
+
+    CHECK(ano_fs_cache_put(&a, payload, sizeof payload) == 0, "put");
+    CHECK(ano_fs_cache_get(&a, &blob), "get hits after put");
+    CHECK(blob.size == sizeof payload && blob.data && memcmp(blob.data, payload, sizeof payload) == 0,
+          "hit returns the exact payload");
+    CHECK(((uintptr_t)blob.data & 63u) == 0, "payload is 64-byte aligned");
+    ano_fs_cache_release(&blob);
+    CHECK(blob.map == NULL, "release zeroes the blob");
+    CHECK(!cache_has(&b), "an absent key misses");
+
+    ano_fs_cache_writer *w = ano_fs_cache_put_begin(&b);
+    CHECK(w != NULL, "streaming writer opens");
+    CHECK(ano_fs_cache_put_write(w, payload, 1000) == 0 && ano_fs_cache_put_write(w, payload + 1000, sizeof payload - 1000) == 0,
+          "stream in two pieces");
+    CHECK(ano_fs_cache_put_end(w, true) == 0, "commit");
+    CHECK(ano_fs_cache_get(&b, &blob) && blob.size == sizeof payload && memcmp(blob.data, payload, sizeof payload) == 0,
+          "streamed entry reads back whole");
+    ano_fs_cache_release(&blob);
+
+    w = ano_fs_cache_put_begin(&v2);
+    CHECK(w != NULL && ano_fs_cache_put_write(w, payload, 10) == 0, "writer for a discard");
+    CHECK(ano_fs_cache_put_end(w, false) == 0 && !cache_has(&v2), "an uncommitted writer publishes nothing");
+
+    // Damage one payload byte on disk: the checksum rejects it and the entry is dropped.
+    cache_entry(path, sizeof path, dir, &b);
+    size_t size = 0;
+    const uint8_t *map = ano_fs_map_read(path, &size);
+    static uint8_t copy[sizeof payload + 96u];
+    CHECK(map != NULL && size == sizeof copy, "entry file has header + payload + trailer");
+    if (map != NULL && size == sizeof copy) {
+        memcpy(copy, map, size);
+        ano_fs_unmap(map, size);
+        copy[64 + 100] ^= 0x01u;
+        ano_file *f = ano_fs_open_trunc(path);
+        CHECK(f != NULL && ano_fs_write(f, copy, size) == 0 && ano_fs_close(f) == 0, "write the damaged copy");
+        CHECK(!cache_has(&b), "a damaged entry misses");
+        CHECK(ano_fs_map_read(path, &size) == NULL, "and is removed");
+    }
+
+    static uint8_t big[4u * sizeof payload];
+    CHECK(ano_fs_cache_put(&other, big, sizeof big) == -1 && !cache_has(&other), "an entry over the cap is refused");
+
+    // LRU: fill to the cap with a, c, d (a oldest), touch a with a hit, then one more put evicts
+    // down to 7/8 of the cap -- the two least recently used, c and d, not a. The sleeps clear the
+    // filesystem's timestamp granularity. A writer left open across it holds the oldest temporary,
+    // which eviction must leave alone so the writer can still commit.
+    ano_fs_cache_key c = ano_fs_cache_key_begin("lru", 3), d = ano_fs_cache_key_begin("lru", 4),
+                     e = ano_fs_cache_key_begin("lru", 5), f = ano_fs_cache_key_begin("lru", 6);
+    ano_fs_cache_writer *slow = ano_fs_cache_put_begin(&f);
+    CHECK(slow != NULL, "open a slow writer");  // header only: its temporary fits the cap's 64-byte slack
+    ano_sleep(20000);
+    CHECK(ano_fs_cache_put(&c, payload, sizeof payload) == 0, "put c");
+    ano_sleep(20000);
+    CHECK(ano_fs_cache_put(&d, payload, sizeof payload) == 0, "put d");
+    ano_sleep(20000);
+    CHECK(cache_has(&a), "hit a (refreshes it)");
+    ano_sleep(20000);
+    CHECK(ano_fs_cache_put(&e, payload, sizeof payload) == 0, "put e past the cap");
+    CHECK(cache_has(&a) && cache_has(&e), "the recently used entries survive");
+    CHECK(!cache_has(&c) && !cache_has(&d), "the least recently used are evicted");
+    CHECK(ano_fs_cache_put_end(slow, true) == 0 && cache_has(&f), "an in-flight temporary survives eviction");
+
+    const ano_fs_cache_key *all[] = { &a, &b, &c, &d, &e, &f, &v2, &other };
+    for (size_t i = 0; i < sizeof all / sizeof all[0]; i++) {
+        cache_entry(path, sizeof path, dir, all[i]);
+        remove(path);
+    }
+    scratch_remove_dir(dir);
+}
+
 int main(void)
 {
     // Scratch IO first: test_gamepath chdirs away from the launch CWD. test_append_file_api
     // resolves its scratch dir from ano_fs_gamepath() (absolute), so it stays anchored even
     // before that chdir -- run in this order to prove that too.
     test_append_file_api();
+    test_map_replace();
+    test_cache();
     test_userpath();
     test_gamepath();
 
@@ -15,6 +15,9 @@
 //   2. Multi-thread throughput -- P producers hammer enqueue while ONE flusher thread drains
 //      concurrently (the real single-consumer deployment). This is where the lock-free ring should
 //      pull ahead: producers never serialize on a shared mutex.
+//   3. Producer-topology sweep -- the shared ring (one CAS on `tail` per record) vs lanes mode (one
+//      SPSC lane per thread, ano_log_set_mode) from 1 to SWEEP_MAXP threads, reported as wall ns per
+//      record per producer. Flat is the goal: a shared cursor's line bounces harder with every thread.
 
 #include <anoptic_log.h>        // ring logger (ano_log_*)
 #include "log/log_old.h"    // mutex baseline (mtxlog_*)
@@ -50,6 +53,11 @@ static const int TP_THREADS[] = {1, 2, 4, 8, 16};
 #define MIX_SMALL   16          // small-message body for the mixed battery (bytes)
 #define MIX_SEED    0x5E3D17u   // fixed srand seed for the mixed battery
 
+#define SWEEP_MSGS  100000      // messages per producer thread in the topology sweep
+#define SWEEP_MAXP  32          // largest sweep thread count (oversubscribes most hosts on purpose)
+static const int SWEEP_THREADS[] = {1, 2, 4, 8, 16, 24, 32};
+#define SWEEP_POINTS (int)(sizeof SWEEP_THREADS / sizeof SWEEP_THREADS[0])
+
 // The two implementations behind one vtable, in the baseline's 5-tier signature so both keep
 // identical call sites.
 typedef struct {
@@ -85,6 +93,22 @@ static int ring_enqueue(log_types_t level, const char *file, int line, const cha
 static const logger_api RING  = {
     "ring  (lock-free MPSC)", ano_log_init, ring_enqueue, ano_log_flush, ano_log_cleanup, ano_log_output_dir
 };
+// Lanes mode: the same ring logger with one SPSC lane per producer thread. The mode latches at init,
+// so the adapters set it around the lifecycle.
+static int lanes_init(void)
+{
+    ano_log_set_mode(ANO_LOG_LANES);
+    return ano_log_init();
+}
+static int lanes_cleanup(void)
+{
+    int r = ano_log_cleanup();
+    ano_log_set_mode(ANO_LOG_SHARED);
+    return r;
+}
+static const logger_api LANES = {
+    "lanes (per-thread SPSC)", lanes_init, ring_enqueue, ano_log_flush, lanes_cleanup, ano_log_output_dir
+};
 static const logger_api MUTEX = {
     "mutex (baseline)",       mtxlog_init,  mtxlog_enqueue,  mtxlog_flush,  mtxlog_cleanup,  mtxlog_output_dir
 };
@@ -167,6 +191,46 @@ static double run_throughput(const logger_api *api, int producers)
 }
 
 
+/* Producer-topology sweep (wall ns per record per producer) */
+
+// Same one-flusher topology, up to SWEEP_MAXP producers. Each producer's cost is the whole run's wall
+// time over its own message count: with perfect scaling it stays at the single-thread figure.
+static double run_sweep_point(const logger_api *api, int producers)
+{
+    atomic_store(&g_flusher_stop, false);
+    anothread_t fl;
+    flush_arg fa = { api };
+    ano_thread_create(&fl, NULL, flusher, &fa);
+
+    anothread_t prod[SWEEP_MAXP];
+    prod_arg    args[SWEEP_MAXP];
+
+    uint64_t t0 = ano_timestamp_raw();
+    for (int i = 0; i < producers; i++) {
+        args[i] = (prod_arg){ api, SWEEP_MSGS, i };
+        ano_thread_create(&prod[i], NULL, producer, &args[i]);
+    }
+    for (int i = 0; i < producers; i++)
+        ano_thread_join(prod[i], NULL);
+    uint64_t t1 = ano_timestamp_raw();
+
+    atomic_store(&g_flusher_stop, true);
+    ano_thread_join(fl, NULL);
+    api->flush();
+
+    return (double)(t1 - t0) / (double)SWEEP_MSGS;     // ns per record, per producer
+}
+
+static void run_sweep(const logger_api *api, double out[SWEEP_POINTS])
+{
+    api->init();
+    api->output_dir(BENCH_DIR);
+    for (int i = 0; i < SWEEP_POINTS; i++)
+        out[i] = run_sweep_point(api, SWEEP_THREADS[i]);
+    api->cleanup();
+}
+
+
 /* Variable-length throughput (random length 8..1024B, random ASCII content)
    Stresses ring spanning / wrapping / full. Content is built as a NUL-terminated string and logged
    as ("%s", buf) -- the format is a literal, so no varargs/format mismatch is ever possible.
@@ -284,6 +348,10 @@ int main(void)
     result ring  = measure(&RING);
     result mutex = measure(&MUTEX);
 
+    double sweepShared[SWEEP_POINTS], sweepLanes[SWEEP_POINTS];
+    run_sweep(&RING,  sweepShared);
+    run_sweep(&LANES, sweepLanes);
+
     printf("%-26s %14s %14s %10s\n", "metric", "ring", "mutex", "ring/mutex");
     printf("-------------------------------------------------------------------------\n");
     printf("%-26s %12.1f ns %12.1f ns %9.2fx\n", "enqueue latency (1 thread)",
@@ -324,6 +392,18 @@ int main(void)
                ring.mix_throughput[i] / mutex.mix_throughput[i]);
     }
 
+    // Topology sweep: wall ns per record per producer. Flat across the row is perfect scaling.
+    printf("\nproducer topology sweep -- %d msgs/producer, wall ns per record per producer\n", SWEEP_MSGS);
+    printf("-------------------------------------------------------------------------\n");
+    printf("%-26s %14s %14s %10s\n", "threads", "shared", "lanes", "shared/lanes");
+    for (int i = 0; i < SWEEP_POINTS; i++) {
+        char label[40];
+        snprintf(label, sizeof label, "sweep @ %d producer%s", SWEEP_THREADS[i],
+                 SWEEP_THREADS[i] == 1 ? "" : "s");
+        printf("%-26s %11.1f ns %11.1f ns %9.2fx\n", label,
+               sweepShared[i], sweepLanes[i], sweepShared[i] / sweepLanes[i]);   // >1 = lanes cheaper
+    }
+
     printf("\n(ring/mutex > 1.0 means the ring won. Latency column inverts the ratio so >1 is\n");
     printf(" always \"ring better\". Numbers vary run to run; take the trend, not the digits.)\n");
 
@@ -43,17 +43,23 @@ static char *cwd_str(char *b, size_t n) { return getcwd(b, n); }
 #define LOG_DIR      ANO_TEST_OUTDIR "/anolog_test"
 #define LOG_DIR_ALT  ANO_TEST_OUTDIR "/anolog_test_alt"
 #define VIS_DIR      ANO_TEST_OUTDIR "/anolog_visible"
+#define BIN_DIR      ANO_TEST_OUTDIR "/anolog_test_bin"
+#define KV_DIR       ANO_TEST_OUTDIR "/anolog_test_kv"
 
-// Session-stamped log paths (<dir>/<stamp>_ano.log), resolved once in main().
-static char LOG_PATH[96], LOG_PATH_ALT[96], VIS_PATH[96];
+// Session-stamped log paths (<dir>/<stamp>_ano.log, _ano.alog when binary), resolved once in main().
+static char LOG_PATH[96], LOG_PATH_ALT[96], VIS_PATH[96], BIN_PATH[96];
 
 static void resolve_log_paths(void)
 {
     snprintf(LOG_PATH,     sizeof LOG_PATH,     "%s/%s_ano.log", LOG_DIR,     ano_fs_session_stamp());
     snprintf(LOG_PATH_ALT, sizeof LOG_PATH_ALT, "%s/%s_ano.log", LOG_DIR_ALT, ano_fs_session_stamp());
     snprintf(VIS_PATH,     sizeof VIS_PATH,     "%s/%s_ano.log", VIS_DIR,     ano_fs_session_stamp());
+    snprintf(BIN_PATH,     sizeof BIN_PATH,     "%s/%s_ano.alog", BIN_DIR,    ano_fs_session_stamp());
 }
 
+// The binary-file decoder, linked in from tools/anolog_decode.c.
+long anolog_decode(FILE *in, FILE *out);
+
 #define THREAD_COUNT    4
 #define MSGS_PER_THREAD 50
 
@@ -1108,6 +1114,472 @@ static int test_premature_join_half(void)
 }
 
 
+/* Overflow policy — drop-newest with a counter, spill to the second ring */
+
+#define OV_THREADS 6
+#define OV_PER     12000
+
+static _Atomic int g_ov_dropped, g_ov_full;
+
+static void *ov_flooder(void *arg)
+{
+    int id = (int)(intptr_t)arg;
+    for (int i = 0; i < OV_PER; i++) {
+        int rc = ano_log(ANO_INFO, "ov t%d %d", id, i);
+        if (rc == 2) atomic_fetch_add(&g_ov_dropped, 1);
+        if (rc == 1) atomic_fetch_add(&g_ov_full, 1);
+    }
+    return NULL;
+}
+
+// Flood at INFO under the current policy, then drain.
+static void ov_flood(void)
+{
+    atomic_store(&g_ov_dropped, 0);
+    atomic_store(&g_ov_full, 0);
+    anothread_t t[OV_THREADS];
+    for (intptr_t i = 0; i < OV_THREADS; i++)
+        ano_thread_create(&t[i], NULL, ov_flooder, (void *)i);
+    for (int i = 0; i < OV_THREADS; i++)
+        ano_thread_join(t[i], NULL);
+    ano_log_flush();
+}
+
+// Walk every "ov t<id> <i>" line: per-thread order must hold, with gaps only when `gaps`. Sums the
+// "<n> INFO records dropped" summaries into *dropped. Returns the records seen, -1 on an order break.
+static int ov_scan(const char *c, bool gaps, long *dropped)
+{
+    int last[OV_THREADS], seen = 0;
+    for (int t = 0; t < OV_THREADS; t++) last[t] = -1;
+    for (const char *s = c; (s = strstr(s, "ov t")) != NULL; s++) {
+        int id, i;
+        if (sscanf(s, "ov t%d %d", &id, &i) != 2 || id < 0 || id >= OV_THREADS) return -1;
+        if (gaps ? i <= last[id] : i != last[id] + 1) return -1;
+        last[id] = i; seen++;
+    }
+    *dropped = 0;
+    for (const char *s = c; (s = strstr(s, "logger: ")) != NULL; s++) {
+        long n;
+        if (sscanf(s, "logger: %ld INFO records dropped", &n) == 1) *dropped += n;
+    }
+    return seen;
+}
+
+// DROP: a full ring costs the producer a counter bump. Every record is either in the file or counted by
+// a summary line, and the summaries agree with the calls that returned 2. ERROR and FATAL refuse it.
+static int test_overflow_drop(void)
+{
+    g_fail = 0;
+    reset_output();
+    CHECK(ano_log_set_overflow(ANO_ERROR, ANO_LOG_DROP) == -1, "drop: ERROR refuses drop");
+    CHECK(ano_log_set_overflow(ANO_FATAL, ANO_LOG_DROP) == -1, "drop: FATAL refuses drop");
+    CHECK(ano_log_set_overflow((ano_loglevel_t)9, ANO_LOG_BLOCK) == -1, "drop: bad level rejected");
+    CHECK(ano_log_set_overflow(ANO_INFO, (ano_logoverflow_t)9) == -1, "drop: bad policy rejected");
+    CHECK(ano_log_set_overflow(ANO_INFO, ANO_LOG_DROP) == 0, "drop: INFO accepts drop");
+
+    ov_flood();
+    ano_log_set_overflow(ANO_INFO, ANO_LOG_BLOCK);
+    CHECK(atomic_load(&g_ov_full) == 0, "drop: no producer waited");
+    if (atomic_load(&g_ov_dropped) == 0)
+        printf("  NOTE: flood did not saturate the ring this run (consumer kept pace)\n");
+
+    char *c = slurp(LOG_PATH, NULL);
+    CHECK(c != NULL, "drop: file readable");
+    if (c) {
+        long dropped = 0;
+        int seen = ov_scan(c, true, &dropped);
+        CHECK(seen >= 0, "drop: per-thread order holds across the gaps");
+        CHECK(dropped == atomic_load(&g_ov_dropped), "drop: summaries count every dropped record");
+        CHECK(seen + dropped == OV_THREADS * OV_PER, "drop: every record kept or counted");
+        free(c);
+    }
+    return g_fail;
+}
+
+// SPILL: the flood overflows into the second ring instead of waiting. Nothing is lost, and the drain
+// merge keeps each thread's records in order across the two rings.
+static int test_overflow_spill(void)
+{
+    g_fail = 0;
+    reset_output();
+    CHECK(ano_log_set_overflow(ANO_INFO, ANO_LOG_SPILL) == 0, "spill: INFO accepts spill");
+    ov_flood();
+    ano_log_set_overflow(ANO_INFO, ANO_LOG_BLOCK);
+    CHECK(atomic_load(&g_ov_dropped) == 0, "spill: nothing dropped");
+
+    char *c = slurp(LOG_PATH, NULL);
+    CHECK(c != NULL, "spill: file readable");
+    if (c) {
+        long dropped = 0;
+        int seen = ov_scan(c, false, &dropped);
+        if (seen < 0 && atomic_load(&g_ov_full) > 0) {
+            // A call that found the spill ring full too may have hit the wedge fallback, which writes
+            // through out of band (slow sanitizer builds). Order is then not promised, the count still is.
+            printf("  NOTE: spill ring filled this run, order not checked\n");
+            seen = 0;
+            for (const char *s = c; (s = strstr(s, "ov t")) != NULL; s++) seen++;
+        }
+        CHECK(seen == OV_THREADS * OV_PER, "spill: every record, in thread order");
+        free(c);
+    }
+    return g_fail;
+}
+
+
+/* Sampled call sites — ano_log_every_n / ano_log_once / ano_log_ratelimit */
+
+#define SS_THREADS 4
+#define SS_PER     1000
+
+// One shared site: every thread's calls count against the same static state.
+static void ss_every_site(int i)
+{
+    ano_log_every_n(ANO_INFO, 10, "ss every %d", i);
+}
+
+static void *ss_every_worker(void *arg)
+{
+    (void)arg;
+    for (int i = 0; i < SS_PER; i++)
+        ss_every_site(i);
+    return NULL;
+}
+
+static int count_str(const char *hay, const char *needle)
+{
+    int c = 0;
+    for (const char *s = hay; (s = strstr(s, needle)) != NULL; s++) c++;
+    return c;
+}
+
+// Each site admits exactly its budget, concurrent callers included, and the admitted calls log normally.
+static int test_sampled_sites(void)
+{
+    g_fail = 0;
+    reset_output();
+    for (int i = 0; i < 100; i++) {
+        ano_log_once(ANO_WARN, "ss once %d", i);
+        ano_log_ratelimit(ANO_INFO, 5, "ss rate %d", i);
+    }
+    ano_log_once(ANO_WARN, "ss other once");   // a second site has its own state
+    anothread_t t[SS_THREADS];
+    for (intptr_t i = 0; i < SS_THREADS; i++)
+        ano_thread_create(&t[i], NULL, ss_every_worker, (void *)i);
+    for (int i = 0; i < SS_THREADS; i++)
+        ano_thread_join(t[i], NULL);
+    ano_log_flush();
+
+    ano_logsite_t site = { 0 };
+    CHECK(ano_log_gate_every(&site, 0) && ano_log_gate_every(&site, 1), "sampled: n <= 1 always logs");
+    CHECK(!ano_log_gate_rate(&site, 0), "sampled: a zero rate never logs");
+
+    char *c = slurp(LOG_PATH, NULL);
+    CHECK(c != NULL, "sampled: file readable");
+    if (c) {
+        CHECK(count_str(c, "ss once ") == 1 && strstr(c, "ss once 0") != NULL, "sampled: once fires on the first call");
+        CHECK(count_str(c, "ss other once") == 1, "sampled: sites are independent");
+        int rate = count_str(c, "ss rate ");
+        CHECK(rate >= 5 && rate <= 6, "sampled: ratelimit admits its one-second burst");    // 6: a slow loop
+        CHECK(strstr(c, "ss rate 0") != NULL, "sampled: ratelimit admits the first call");
+        CHECK(count_str(c, "ss every ") == SS_THREADS * SS_PER / 10, "sampled: every_n admits 1 in n across threads");
+        free(c);
+    }
+    return g_fail;
+}
+
+/* Lanes mode — per-thread SPSC lanes, merged by timestamp at drain */
+
+#define LM_THREADS 6
+#define LM_PER     400
+
+static void *lm_producer(void *arg)
+{
+    int id = (int)(intptr_t)arg;
+    for (int i = 0; i < LM_PER; i++)
+        ano_log(ANO_INFO, "lm t%d %d", id, i);
+    return NULL;
+}
+
+// Walk every "lm t<id> <i>" line in file order. Per-thread order must hold, and with `serial` the
+// whole file must be in (id, i) order too. Returns the records seen, -1 on an order break.
+static int lm_scan(const char *c, bool serial)
+{
+    int last[LM_THREADS], lastId = -1, seen = 0;
+    for (int t = 0; t < LM_THREADS; t++) last[t] = -1;
+    for (const char *s = c; (s = strstr(s, "lm t")) != NULL; s++) {
+        int id, i;
+        if (sscanf(s, "lm t%d %d", &id, &i) != 2 || id < 0 || id >= LM_THREADS) return -1;
+        if (i != last[id] + 1) return -1;               // lane order: one producer, issue order
+        if (serial && id < lastId) return -1;           // merge order: happens-before across lanes
+        last[id] = i; lastId = id; seen++;
+    }
+    return seen;
+}
+
+// Producers run one after another, each joined before the next starts, with no flush in between. Each
+// lands in its own lane (or adopts a drained one), and the drainer's timestamp merge must still lay the
+// file out in happens-before order. Then a concurrent wave: per-thread order and no loss.
+static int test_lanes_merge_order(void)
+{
+    g_fail = 0;
+    reset_output();
+
+    anothread_t t[LM_THREADS];
+    for (intptr_t i = 0; i < LM_THREADS; i++) {
+        ano_thread_create(&t[i], NULL, lm_producer, (void *)i);
+        ano_thread_join(t[i], NULL);
+    }
+    ano_log_flush();
+
+    char *c = slurp(LOG_PATH, NULL);
+    CHECK(c != NULL, "lanes: file readable");
+    if (c) {
+        CHECK(lm_scan(c, true) == LM_THREADS * LM_PER, "lanes: serial producers merge in happens-before order");
+        free(c);
+    }
+
+    reset_output();
+    for (intptr_t i = 0; i < LM_THREADS; i++)
+        ano_thread_create(&t[i], NULL, lm_producer, (void *)i);
+    for (int i = 0; i < LM_THREADS; i++)
+        ano_thread_join(t[i], NULL);
+    ano_log_flush();
+
+    c = slurp(LOG_PATH, NULL);
+    CHECK(c != NULL, "lanes: file readable (concurrent)");
+    if (c) {
+        CHECK(lm_scan(c, false) == LM_THREADS * LM_PER, "lanes: concurrent producers keep lane order, lose nothing");
+        free(c);
+    }
+    return g_fail;
+}
+
+
+
+/* Binary format — raw capture blobs plus a string table, rendered offline by tools/anolog_decode */
+
+#define BIN_LOOP 40
+
+// One fixed record mix, redirecting once midway: captures (plain, fancy, origin), an eager fallback, a
+// NOW write-through, and a terminal-only record that never reaches the file.
+static void bin_records(const char *dir)
+{
+    for (int i = 0; i < BIN_LOOP; i++)
+        ano_log(ANO_INFO, "bin loop %d of %u", i, (unsigned)BIN_LOOP);
+    ano_olog(ANO_WARN, "bin origin %s|%.3f|%-6d|", "str", 3.14159, -42);
+    ano_log_flush();
+    ano_log_output_dir(dir);                // appends a second head, string ids restart
+    ano_log(ANO_INFO, "bin star [%*d] [%.*s] [%+.2e]", 7, 12, 3, "abcdef", 1234.5);
+    ano_log(ANO_INFO, "bin wide %lld %llx %zu %c %%", -9000000000LL, 0xdeadbeefULL, (size_t)77, 'q');
+    ano_log(ANO_ERROR, "bin eager %Lf", (long double)2.5);      // long double: formatted eagerly
+    ano_rlog(ANO_WARN, ANO_FILE | ANO_NOW, "bin now %d", 5);
+    ano_rlog(ANO_INFO, ANO_TERM, "bin terminal only");
+    ano_olog(ANO_INFO, "bin origin again %s", "x");
+    ano_log_flush();
+}
+
+// Occurrences of needle in the n-byte buffer hay (which may hold NULs).
+static int count_bytes(const char *hay, size_t n, const char *needle)
+{
+    size_t m = strlen(needle);
+    int c = 0;
+    for (size_t i = 0; i + m <= n; i++)
+        if (memcmp(hay + i, needle, m) == 0) c++;
+    return c;
+}
+
+// The same records through a text session and a binary one. The decoded binary file must match the text
+// file line for line past the "HH:MM:SS " prefix, and a repeated format string is stored once per head.
+static int test_binary_roundtrip(void)
+{
+    g_fail = 0;
+    remove(LOG_PATH);
+    if (ano_log_init() != 0) { CHECK(0, "binary: text session init"); return g_fail; }
+    ano_log_output_dir(LOG_DIR);
+    bin_records(LOG_DIR);
+    ano_log_cleanup();
+
+    make_dir(BIN_DIR);
+    remove(BIN_PATH);
+    CHECK(ano_log_set_format((ano_logformat_t)7) == -1, "binary: unknown format rejected");
+    CHECK(ano_log_set_format(ANO_LOG_BINARY) == 0, "binary: format accepted before init");
+    if (ano_log_init() != 0) { CHECK(0, "binary: binary session init"); return g_fail; }
+    CHECK(ano_log_set_format(ANO_LOG_TEXT) == -1, "binary: format latched while live");
+    ano_log_output_dir(BIN_DIR);
+    bin_records(BIN_DIR);
+    ano_log_cleanup();
+    ano_log_set_format(ANO_LOG_TEXT);
+
+    size_t blen = 0;
+    char *bin  = slurp(BIN_PATH, &blen);
+    char *want = slurp(LOG_PATH, NULL);
+    CHECK(bin != NULL && want != NULL, "binary: both files readable");
+    if (bin && want) {
+        CHECK(count_bytes(bin, blen, "bin loop %d of %u") == 1, "binary: format string tabled once");
+        CHECK(count_bytes(bin, blen, "bin loop 7") == 0, "binary: captures not rendered");
+        CHECK(count_bytes(bin, blen, "bin terminal only") == 0, "binary: terminal-only stays off the file");
+        CHECK(count_bytes(bin, blen, "ANOLOGB") == 2, "binary: redirect appends a head");
+
+        FILE *in = fopen(BIN_PATH, "rb"), *out = tmpfile();
+        long n = (in && out) ? anolog_decode(in, out) : -1;
+        CHECK(n == count_lines(want), "binary: decoder renders every file record");
+        char *got = NULL;
+        if (out) {
+            long sz = ftell(out);
+            got = malloc((size_t)(sz > 0 ? sz : 0) + 1);
+            rewind(out);
+            if (got) got[fread(got, 1, (size_t)(sz > 0 ? sz : 0), out)] = '\0';
+        }
+        if (in) fclose(in);
+        if (out) fclose(out);
+
+        // Line by line past the time prefix: the two sessions ran in different seconds.
+        bool same = got != NULL;
+        const char *a = want, *b = got;
+        while (same && *a && *b) {
+            const char *ae = strchr(a, '\n'), *be = strchr(b, '\n');
+            if (!ae || !be || ae - a < 9 || ae - a != be - b || memcmp(a + 9, b + 9, (size_t)(ae - a - 9)) != 0)
+                same = false;
+            a = ae ? ae + 1 : a; b = be ? be + 1 : b;
+        }
+        CHECK(same && *a == '\0' && got && *b == '\0', "binary: decoded text matches the text session");
+        free(got);
+    }
+    free(bin);
+    free(want);
+    remove(BIN_PATH);
+    remove_dir(BIN_DIR);
+    return g_fail;
+}
+
+
+// Append n bytes of v to f, native byte order as the writer lays them.
+static void bin_put(FILE *f, const void *v, size_t n)
+{
+    fwrite(v, 1, n, f);
+}
+
+// One 'D' capture record of format string 1 with the given args.
+static void bin_capture(FILE *f, const void *args, uint16_t argLen)
+{
+    uint8_t  k = 'D', level = ANO_INFO;
+    uint64_t ticks = 0;
+    uint32_t fmtId = 1, fileId = 0;
+    int32_t  line = 0;
+    bin_put(f, &k, 1); bin_put(f, &level, 1); bin_put(f, &ticks, 8);
+    bin_put(f, &fmtId, 4); bin_put(f, &fileId, 4); bin_put(f, &line, 4);
+    bin_put(f, &argLen, 2); bin_put(f, args, argLen);
+}
+
+// A hand-built file (head, one format string, four captures) whose second and third captures
+// overrun their argLen. The decoder renders a marker for each instead of reading past the record, and
+// still renders the well-formed captures around them.
+static int test_binary_malformed(void)
+{
+    g_fail = 0;
+    FILE *in = tmpfile(), *out = tmpfile();
+    if (!in || !out) {
+        CHECK(0, "binary malformed: tmpfiles");
+        if (in) fclose(in);
+        if (out) fclose(out);
+        return g_fail;
+    }
+
+    uint8_t  k = 'H', ver = 1;
+    uint64_t anchorTicks = 0, anchorNs = 0, calTicks = 1, calNs = 1;
+    int32_t  utc = 0;
+    uint32_t msgMax = 256;
+    bin_put(in, &k, 1); bin_put(in, "ANOLOGB", 7); bin_put(in, &ver, 1);
+    bin_put(in, &anchorTicks, 8); bin_put(in, &anchorNs, 8); bin_put(in, &calTicks, 8); bin_put(in, &calNs, 8);
+    bin_put(in, &utc, 4); bin_put(in, &msgMax, 4);
+
+    static const char fmt[] = "mal [%s]";
+    uint8_t  sk = 'S';
+    uint32_t id = 1;
+    uint16_t fl = (uint16_t)(sizeof fmt - 1);
+    bin_put(in, &sk, 1); bin_put(in, &id, 4); bin_put(in, &fl, 2); bin_put(in, fmt, fl);
+
+    char good[2 + 3] = { 2, 0, 'o', 'k', '\0' };
+    char bad[2 + 3]  = { (char)0x00, (char)0x10, 'n', 'o', '\0' };    // claims 4096 bytes in a 5-byte record
+    bin_capture(in, good, sizeof good);
+    bin_capture(in, bad, sizeof bad);
+    bin_capture(in, good, 3);                                          // length prefix and one byte, no NUL
+    bin_capture(in, good, sizeof good);
+    rewind(in);
+
+    long n = anolog_decode(in, out);
+    CHECK(n == 4, "binary malformed: every capture counted, file decodes to the end");
+    long sz = ftell(out);
+    char *got = malloc((size_t)(sz > 0 ? sz : 0) + 1);
+    rewind(out);
+    if (got) got[fread(got, 1, (size_t)(sz > 0 ? sz : 0), out)] = '\0';
+    CHECK(got && count_bytes(got, strlen(got), "mal [ok]") == 2, "binary malformed: good captures rendered");
+    CHECK(got && count_bytes(got, strlen(got), "<malformed capture record") == 2,
+          "binary malformed: overrunning captures marked");
+    CHECK(got && count_bytes(got, strlen(got), "mal [no") == 0, "binary malformed: bad args not formatted");
+    free(got);
+    fclose(in);
+    fclose(out);
+    return g_fail;
+}
+
+
+// Structured records: rendered as text on the level's route, and exported one CSV per event. A record
+// whose keys differ from the event's first stays text-only, so the columns stay rectangular.
+static int test_structured(void)
+{
+    g_fail = 0;
+    char kvLog[128], frameCsv[128], bridgeCsv[128];
+    snprintf(kvLog,     sizeof kvLog,     "%s/%s_ano.log",       KV_DIR, ano_fs_session_stamp());
+    snprintf(frameCsv,  sizeof frameCsv,  "%s/%s_frame_kv.csv",  KV_DIR, ano_fs_session_stamp());
+    snprintf(bridgeCsv, sizeof bridgeCsv, "%s/%s_bridge_kv.csv", KV_DIR, ano_fs_session_stamp());
+    make_dir(KV_DIR);
+
+    CHECK(ano_log_set_columns(true) == 0, "kv: columns accepted before init");
+    if (ano_log_init() != 0) { CHECK(0, "kv: session init"); return g_fail; }
+    CHECK(ano_log_set_columns(false) == -1, "kv: columns latched while live");
+    ano_log_output_dir(KV_DIR);
+
+    anostr_t plain = anostr_lit("idle"), comma = anostr_lit("a,\"b\"");
+    for (int i = 0; i < 10; i++)
+        ano_log_fields(ANO_INFO, "frame", ANO_KV_U("n", i), ANO_KV_F("ms", 16.25 + i),
+                       ANO_KV_SID("id", ANOSTR_SID("player")), ANO_KV_S("state", i == 3 ? comma : plain));
+    ano_log_fields(ANO_INFO, "frame", ANO_KV_U("other", 1));                  // schema mismatch: text only
+    ano_log_fields(ANO_WARN, "bridge", ANO_KV_U("bytes", 4096), ANO_KV_F("ms", 0.1));
+    ano_log_kv(ANO_ERROR, ANO_FILE | ANO_NOW, "bridge",
+               (const ano_logfield_t[]){ ANO_KV_U("bytes", 7), ANO_KV_F("ms", 2.5) }, 2);
+    ano_log_flush();
+    ano_log_cleanup();
+    ano_log_set_columns(false);
+
+    char *log = slurp(kvLog, NULL), *frame = slurp(frameCsv, NULL), *bridge = slurp(bridgeCsv, NULL);
+    CHECK(log && frame && bridge, "kv: log and both column files readable");
+    if (log && frame && bridge) {
+        char want[160];
+        snprintf(want, sizeof want, "INFO  frame n=0 ms=16.25 id=%016llx state=idle",
+                 (unsigned long long)ANOSTR_SID("player"));
+        CHECK(strstr(log, want) != NULL, "kv: text rendering");
+        CHECK(strstr(log, "frame other=1") != NULL, "kv: mismatched record still logs as text");
+        CHECK(strstr(log, "ERROR bridge bytes=7 ms=2.5") != NULL, "kv: NOW route renders");
+
+        CHECK(strncmp(frame, "ts_ns,n,ms,id,state\n", 20) == 0, "kv: header names every key");
+        CHECK(count_lines(frame) == 11, "kv: one row per matching record");
+        CHECK(strstr(frame, "\"a,\"\"b\"\"\"") != NULL, "kv: string with comma and quotes is quoted");
+        CHECK(strstr(frame, "other") == NULL, "kv: mismatched record kept out of the columns");
+        const char *row = strchr(frame, '\n') + 1;
+        unsigned long long ts = 0, n = 9; double ms = 0;
+        CHECK(sscanf(row, "%llu,%llu,%lf", &ts, &n, &ms) == 3 && n == 0 && ms == 16.25 && ts > 0,
+              "kv: first row round-trips");
+        CHECK(strncmp(bridge, "ts_ns,bytes,ms\n", 15) == 0 && count_lines(bridge) == 3,
+              "kv: second event, NOW record included");
+    }
+    free(log); free(frame); free(bridge);
+    remove(kvLog); remove(frameCsv); remove(bridgeCsv);
+    remove_dir(KV_DIR);
+    return g_fail;
+}
+
+
 int main(void)
 {
     int failures = 0;
@@ -1157,6 +1629,9 @@ int main(void)
         { "contention_soak",            test_contention_soak },
         { "premature_join_all",         test_premature_join_all },
         { "premature_join_half",        test_premature_join_half },
+        { "overflow_drop",              test_overflow_drop },
+        { "overflow_spill",             test_overflow_spill },
+        { "sampled_sites",              test_sampled_sites },
         { "abuse_inputs",               test_abuse_inputs },
         { "abuse_config",               test_abuse_config },
         { "abuse_output_dir",           test_abuse_output_dir },
@@ -1178,6 +1653,60 @@ int main(void)
         failures += rc;
     }
 
+    // Lanes mode: a second session over the same surface. The mode is latched while live, and the
+    // producer-topology cases re-run against per-thread lanes.
+    {
+        ano_log_init();
+        int rc = ano_log_set_mode(ANO_LOG_LANES) == -1 ? 0 : 1;
+        ano_log_cleanup();
+        printf("  [%s] %s\n", rc == 0 ? "PASS" : "FAIL", "lanes_mode_latched");
+        failures += rc;
+    }
+    if (ano_log_set_mode(ANO_LOG_LANES) != 0 || ano_log_init() != 0) {
+        fprintf(stderr, "ano_log_init (lanes) failed\n");
+        return 1;
+    }
+    struct { const char *name; int (*fn)(void); } laneCases[] = {
+        { "lanes_roundtrip",            test_roundtrip },
+        { "lanes_merge_order",          test_lanes_merge_order },
+        { "lanes_full_ring",            test_full_ring },
+        { "lanes_immediate_order",      test_immediate_order },
+        { "lanes_concurrent",           test_concurrent },
+        { "lanes_edge_ring_seam",       test_edge_ring_seam },
+        { "lanes_edge_tiny_records",    test_edge_tiny_records },
+        { "lanes_premature_join_all",   test_premature_join_all },
+        { "lanes_premature_join_half",  test_premature_join_half },
+        { "lanes_contention_soak",      test_contention_soak },
+        { "lanes_overflow_drop",        test_overflow_drop },
+        { "lanes_overflow_spill",       test_overflow_spill },
+    };
+    for (size_t i = 0; i < sizeof laneCases / sizeof laneCases[0]; i++) {
+        int rc = laneCases[i].fn();
+        printf("  [%s] %s\n", rc == 0 ? "PASS" : "FAIL", laneCases[i].name);
+        failures += rc;
+    }
+    ano_log_cleanup();
+    ano_log_set_mode(ANO_LOG_SHARED);
+
+    // Binary format: two more sessions, text then binary, compared through the decoder.
+    {
+        int rc = test_binary_roundtrip();
+        printf("  [%s] %s\n", rc == 0 ? "PASS" : "FAIL", "binary_roundtrip");
+        failures += rc;
+    }
+    {
+        int rc = test_binary_malformed();
+        printf("  [%s] %s\n", rc == 0 ? "PASS" : "FAIL", "binary_malformed");
+        failures += rc;
+    }
+
+    // Structured records with column export: one more session.
+    {
+        int rc = test_structured();
+        printf("  [%s] %s\n", rc == 0 ? "PASS" : "FAIL", "structured_kv");
+        failures += rc;
+    }
+
     char cwd[1024];
     if (cwd_str(cwd, sizeof cwd))
         printf("  Showcase log written and verified: %s/%s\n", cwd, VIS_PATH);
@@ -10,9 +10,24 @@
  *   - scope-bound heaps (LOCALHEAPATTR -> ano_heap_release) with aligned, zeroed
  *     allocation and a 128-bit union member (no field tearing);
  *   - plain mi_malloc round-trips;
+ *   - bump arenas: alignment, lazy commit, mark/rewind address reuse, O(1) reset, exhaustion,
+ *     trim, self-rewinding scopes, the ambient scratch pair (conflict avoidance, per thread), and
+ *     ASan poisoning past the bump pointer when built with ASan;
+ *   - huge-page / NUMA arenas: step-aligned reservation, commit in huge steps, the page kind and
+ *     node recorded, trim and recommit, 1 GiB pages only for reservations that can use them;
+ *   - object pools: typed alignment, distinct objects, reuse without new pages, occupancy stats,
+ *     frees on a thread other than the allocating one, concurrent churn, more threads than magazine
+ *     slots, and ASan poisoning of freed objects;
+ *   - memory accounting tags: live/peak/count bookkeeping through every tagged call, the report,
+ *     heap-bound tags rebound after their heap is destroyed, sampled call sites, concurrent churn;
  *   - a best-effort huge-page reservation probe.
  * Exit 0 == pass.
  *
+ * `anotest_memory --bench [ops]` runs the benchmarks instead: alloc/free churn through one shared
+ * ano_pool_t against a per-thread mi_heap_malloc at 1..8 threads, then a random pointer chase over a
+ * normal arena and a huge-page arena, with dTLB read misses from perf where the host allows it.
+ * Registered DISABLED in CTest as anoptic_membench; run it by hand from an -O3 build. Always exits 0.
+ *
  * The original, untouched experiment these checks were distilled from is kept as
  * an easter egg in anotest_chariots.c (built, but DISABLED in ctest). */
 
@@ -20,9 +35,19 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <string.h>
 #include <mimalloc.h>
 
 #include "anoptic_memory.h"
+#include "anoptic_threads.h"
+#include "templates/bench.h"
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 static int failures = 0;
 #define CHECK(cond, msg) do { \
@@ -114,6 +139,453 @@ static void test_basic_malloc(void)
     mi_free(nums);
 }
 
+static void test_arena(void)
+{
+    ano_arena_t a;
+    CHECK(ano_arena_init(&a, 0) == -1, "zero reserve refused");
+    CHECK(ano_arena_init(&a, 3 * ANO_ARENA_COMMIT - 1) == 0, "init");
+    CHECK(a.reserved == 3 * ANO_ARENA_COMMIT && a.committed == 0, "reserve rounded, nothing committed");
+
+    uint8_t *b1 = ano_arena_alloc(&a, 1, 1);
+    double  *d  = ano_arena_new(&a, double, 3);
+    void    *p64 = ano_arena_alloc(&a, 10, 64);
+    CHECK(b1 != NULL && d != NULL && p64 != NULL, "small allocs");
+    CHECK(((uintptr_t)d % _Alignof(double)) == 0 && ((uintptr_t)p64 % 64) == 0, "alignment honored");
+    CHECK(a.committed == ANO_ARENA_COMMIT, "first touch commits one step");
+    d[2] = 1.5;
+
+    size_t mark = ano_arena_mark(&a);
+    uint8_t *big = ano_arena_alloc(&a, ANO_ARENA_COMMIT + 100, 16);
+    CHECK(big != NULL && a.committed == 2 * ANO_ARENA_COMMIT, "commit grows as the bump crosses it");
+    big[ANO_ARENA_COMMIT + 99] = 7;     // must not fault
+    ano_arena_rewind(&a, mark);
+    CHECK(ano_arena_alloc(&a, 16, 16) == big, "rewind hands the same bytes back");
+    CHECK(d[2] == 1.5, "rewind keeps what came before the mark");
+
+    CHECK(ano_arena_alloc(&a, 3 * ANO_ARENA_COMMIT, 1) == NULL, "exhausted reservation returns NULL");
+    uint8_t *z = ano_arena_zalloc(&a, 256, 8);
+    bool zero = z != NULL;
+    for (int i = 0; zero && i < 256; i++) zero = z[i] == 0;
+    CHECK(zero, "zalloc zeroes");
+
+    size_t used = a.used;
+    ano_arena_reset(&a);
+    CHECK(a.used == 0 && a.peak >= used && a.committed == 2 * ANO_ARENA_COMMIT, "reset: empty, commit kept");
+    CHECK(ano_arena_alloc(&a, 1, 1) == b1, "reset restarts at the base");
+    ano_arena_trim(&a, 0);
+    CHECK(a.committed == ANO_ARENA_COMMIT, "trim returns pages past the live bytes");
+    CHECK(ano_arena_alloc(&a, 2 * ANO_ARENA_COMMIT, 1) != NULL, "recommits after trim");
+
+    {
+        ano_arena_scope_t s ANO_ARENA_SCOPE_ATTR = ano_arena_scope(&a);
+        used = a.used;
+        (void)ano_arena_alloc(&a, 4096, 16);
+    }
+    CHECK(a.used == used, "scope rewinds at exit");
+
+#ifdef ANO_ARENA_ASAN
+    mark = ano_arena_mark(&a);
+    uint8_t *gone = ano_arena_alloc(&a, 64, 16);
+    ano_arena_rewind(&a, mark);
+    CHECK(__asan_address_is_poisoned(gone), "rewound bytes poisoned");
+#endif
+    ano_arena_destroy(&a);
+    CHECK(a.base == NULL && ano_arena_alloc(&a, 1, 1) == NULL, "destroyed arena allocates nothing");
+}
+
+static void test_arena_huge(void)
+{
+    ano_arena_t a;
+    size_t reserve = (size_t)5 << 20;
+    CHECK(ano_arena_init_ex(&a, reserve, ANO_ARENA_HUGE | ANO_ARENA_NUMA_LOCAL) == 0, "huge arena init");
+    CHECK(a.step >= ANO_ARENA_COMMIT && (a.step & (a.step - 1u)) == 0, "commit step is a power of two");
+    CHECK(((uintptr_t)a.base & (a.step - 1u)) == 0 && a.reserved % a.step == 0 && a.reserved >= reserve,
+          "reservation aligned to and rounded up to the step");
+    CHECK(a.node >= -1, "node is -1 or a node");
+
+    size_t n = (size_t)3 << 20;
+    uint8_t *p = ano_arena_alloc(&a, n, 64);
+    CHECK(p != NULL, "huge arena allocates");
+    if (p != NULL) {
+        memset(p, 0x5A, n);     // must not fault, whatever pages backed it
+        CHECK(p[n - 1] == 0x5A, "huge arena memory is writable");
+    }
+    CHECK(a.committed % a.step == 0 && a.committed >= n, "commit grows in whole steps");
+    CHECK(a.pages >= ANO_ARENA_PAGES_SMALL && a.pages <= ANO_ARENA_PAGES_1G, "page kind recorded");
+    printf("huge arena: step %zu KiB, pages kind %u, node %d\n", a.step >> 10, a.pages, a.node);
+
+    ano_arena_reset(&a);
+    ano_arena_trim(&a, 0);
+#if !defined(_WIN32)
+    CHECK(a.committed == 0, "trim gives the huge steps back");
+#endif
+    CHECK(ano_arena_alloc(&a, a.step + 1u, 16) != NULL, "recommits after trim");
+    ano_arena_destroy(&a);
+
+    // 1 GiB pages only pay off for a reservation that fills one. Smaller ones take the 2 MiB path.
+    CHECK(ano_arena_init_ex(&a, (size_t)8 << 20, ANO_ARENA_HUGE_1G) == 0, "1G-flagged arena init");
+    CHECK(a.step < ((size_t)1 << 30), "small reservation never uses a 1 GiB step");
+    CHECK(ano_arena_alloc(&a, 100, 8) != NULL, "1G-flagged arena allocates");
+    ano_arena_destroy(&a);
+}
+
+static void *scratch_thread(void *arg)
+{
+    *(ano_arena_t **)arg = ano_scratch(NULL);
+    return NULL;
+}
+
+static void test_scratch(void)
+{
+    ano_arena_t *s0 = ano_scratch(NULL);
+    ano_arena_t *s1 = ano_scratch(s0);
+    CHECK(s0 != NULL && s1 != NULL && s0 != s1, "scratch pair: a conflict gets the other arena");
+    CHECK(ano_scratch(s1) == s0 && ano_scratch(NULL) == s0, "scratch is stable per thread");
+
+    // A callee taking scratch while writing into the caller's scratch must not rewind it.
+    ano_arena_scope_t outer ANO_ARENA_SCOPE_ATTR = ano_arena_scope(s0);
+    int *result = ano_arena_new(s0, int, 4);
+    {
+        ano_arena_scope_t inner ANO_ARENA_SCOPE_ATTR = ano_arena_scope(ano_scratch(s0));
+        int *tmp = ano_arena_new(inner.arena, int, 1024);
+        for (int i = 0; i < 1024; i++) tmp[i] = i;
+        for (int i = 0; i < 4; i++) result[i] = tmp[1023 - i];
+    }
+    CHECK(result[0] == 1023 && result[3] == 1020, "results survive the callee's scratch scope");
+
+    ano_arena_t *other = NULL;
+    anothread_t th;
+    CHECK(ano_thread_create(&th, NULL, scratch_thread, &other) == 0, "spawn");
+    ano_thread_join(th, NULL);
+    CHECK(other != NULL && other != s0 && other != s1, "each thread has its own scratch");
+}
+
+typedef struct {
+    double   pos[3];
+    uint32_t owner;
+    uint32_t seq;
+    _Alignas(32) float tint[4];
+} pool_obj_t;
+
+#define POOL_N 10000u
+
+static void test_pool_single(void)
+{
+    ano_pool_t pool;
+    CHECK(ano_pool_init(&pool, 0, 8) == -1 && ano_pool_init(&pool, 16, 3) == -1, "bad pool args refused");
+    ano_pool_destroy(&pool);    // harmless on a refused pool
+
+    CHECK(ano_pool_init_type(&pool, pool_obj_t) == 0, "typed pool init");
+    pool_obj_t **objs = malloc(POOL_N * sizeof *objs);
+    bool aligned = true, distinct = true;
+    for (uint32_t i = 0; i < POOL_N; i++) {
+        objs[i] = ano_pool_alloc(&pool);
+        aligned &= objs[i] != NULL && ((uintptr_t)objs[i] & (_Alignof(pool_obj_t) - 1u)) == 0;
+        if (objs[i] != NULL) objs[i]->seq = i;
+    }
+    for (uint32_t i = 0; i < POOL_N; i++)
+        distinct &= objs[i] != NULL && objs[i]->seq == i;   // overlap would clobber a neighbour's seq
+    CHECK(aligned, "pool objects honour the type's alignment");
+    CHECK(distinct, "pool objects do not overlap");
+
+    ano_pool_stats_t st;
+    ano_pool_stats(&pool, &st);
+    CHECK(st.stride == sizeof(pool_obj_t), "stride is the type size");
+    CHECK(st.live == POOL_N, "stats: every object live");
+    CHECK(st.capacity >= POOL_N && st.capacity == st.live + st.cached + st.free, "stats add up");
+    size_t pages = st.pages;
+
+    for (uint32_t i = 0; i < POOL_N; i++)
+        ano_pool_free(&pool, objs[i]);
+    ano_pool_free(&pool, NULL);
+    ano_pool_stats(&pool, &st);
+    CHECK(st.live == 0 && st.cached <= ANO_POOL_MAG, "stats: all freed, magazine bounded");
+
+    for (uint32_t i = 0; i < POOL_N; i++)
+        objs[i] = ano_pool_alloc(&pool);
+    ano_pool_stats(&pool, &st);
+    CHECK(st.pages == pages && st.live == POOL_N, "a second round reuses freed objects, no new pages");
+#ifdef ANO_ARENA_ASAN
+    ano_pool_free(&pool, objs[0]);
+    CHECK(__asan_address_is_poisoned(&objs[0]->tint[0]), "freed object body is poisoned");
+    objs[0] = ano_pool_alloc(&pool);
+    CHECK(!__asan_address_is_poisoned(&objs[0]->tint[0]), "reallocated object is clean");
+#endif
+    for (uint32_t i = 0; i < POOL_N; i++)
+        ano_pool_free(&pool, objs[i]);
+    ano_pool_flush(&pool);
+    ano_pool_stats(&pool, &st);
+    CHECK(st.live == 0 && st.cached == 0, "flush empties this thread's magazine");
+    free(objs);
+    ano_pool_destroy(&pool);
+
+    // Objects larger than a slab page get a page each.
+    CHECK(ano_pool_init(&pool, ANO_POOL_PAGE + 1u, 64) == 0, "oversized pool init");
+    void *big = ano_pool_alloc(&pool);
+    CHECK(big != NULL && ((uintptr_t)big & 63u) == 0, "oversized object");
+    ano_pool_free(&pool, big);
+    ano_pool_destroy(&pool);
+}
+
+// Cross-thread: one thread allocates, another frees.
+typedef struct {
+    ano_pool_t  *pool;
+    pool_obj_t **objs;
+    uint32_t     count, owner;
+    bool         ok;
+} pool_job_t;
+
+static void *pool_alloc_thread(void *arg)
+{
+    pool_job_t *j = arg;
+    j->ok = true;
+    for (uint32_t i = 0; i < j->count; i++) {
+        j->objs[i] = ano_pool_alloc(j->pool);
+        j->ok &= j->objs[i] != NULL;
+        if (j->objs[i] != NULL) { j->objs[i]->owner = j->owner; j->objs[i]->seq = i; }
+    }
+    return NULL;
+}
+
+static void *pool_free_thread(void *arg)
+{
+    pool_job_t *j = arg;
+    j->ok = true;
+    for (uint32_t i = 0; i < j->count; i++) {
+        j->ok &= j->objs[i]->owner == j->owner && j->objs[i]->seq == i;
+        ano_pool_free(j->pool, j->objs[i]);
+    }
+    return NULL;
+}
+
+// Churn: a window of live objects, each checked for its tag before it goes back.
+#define CHURN_WINDOW 256u
+#define CHURN_OPS    50000u
+
+static void *pool_churn_thread(void *arg)
+{
+    pool_job_t *j = arg;
+    pool_obj_t *win[CHURN_WINDOW] = { 0 };
+    j->ok = true;
+    for (uint32_t i = 0; i < CHURN_OPS; i++) {
+        uint32_t at = (i * 2654435761u) % CHURN_WINDOW;
+        if (win[at] != NULL) {
+            j->ok &= win[at]->owner == j->owner && win[at]->seq == at;
+            ano_pool_free(j->pool, win[at]);
+        }
+        win[at] = ano_pool_alloc(j->pool);
+        j->ok &= win[at] != NULL;
+        if (win[at] != NULL) { win[at]->owner = j->owner; win[at]->seq = at; }
+    }
+    for (uint32_t i = 0; i < CHURN_WINDOW; i++)
+        ano_pool_free(j->pool, win[i]);
+    return NULL;
+}
+
+// Holds its objects across a barrier, so every thread is alive at once: past ANO_POOL_THREADS, some
+// have no magazine.
+#define CROWD 72u
+typedef struct {
+    pool_job_t           job;
+    anothread_barrier_t *barrier;
+} crowd_job_t;
+
+static void *pool_crowd_thread(void *arg)
+{
+    crowd_job_t *c = arg;
+    pool_obj_t *objs[64];
+    c->job.objs  = objs;
+    c->job.count = 64;
+    pool_alloc_thread(&c->job);
+    bool allocOk = c->job.ok;
+    ano_thread_barrier_wait(c->barrier);
+    pool_free_thread(&c->job);
+    c->job.ok &= allocOk;
+    return NULL;
+}
+
+static void test_pool_threads(void)
+{
+    ano_pool_t pool;
+    CHECK(ano_pool_init_type(&pool, pool_obj_t) == 0, "pool init");
+    ano_pool_stats_t st;
+
+    pool_obj_t **objs = malloc(POOL_N * sizeof *objs);
+    pool_job_t j = { &pool, objs, POOL_N, 7u, false };
+    anothread_t th;
+    ano_thread_create(&th, NULL, pool_alloc_thread, &j);
+    ano_thread_join(th, NULL);
+    CHECK(j.ok, "allocating thread");
+    ano_thread_create(&th, NULL, pool_free_thread, &j);
+    ano_thread_join(th, NULL);
+    CHECK(j.ok, "objects arrive intact on the freeing thread");
+    ano_pool_stats(&pool, &st);
+    CHECK(st.live == 0, "frees from another thread balance the stats");
+    free(objs);
+
+    pool_job_t churn[4];
+    anothread_t cth[4];
+    for (uint32_t i = 0; i < 4; i++) {
+        churn[i] = (pool_job_t){ .pool = &pool, .owner = i };
+        ano_thread_create(&cth[i], NULL, pool_churn_thread, &churn[i]);
+    }
+    bool ok = true;
+    for (uint32_t i = 0; i < 4; i++) {
+        ano_thread_join(cth[i], NULL);
+        ok &= churn[i].ok;
+    }
+    CHECK(ok, "concurrent churn: no object handed to two owners");
+    ano_pool_stats(&pool, &st);
+    CHECK(st.live == 0, "churn leaves nothing live");
+
+    anothread_barrier_t barrier;
+    ano_thread_barrier_init(&barrier, NULL, CROWD);
+    crowd_job_t *crowd = calloc(CROWD, sizeof *crowd);
+    anothread_t *crowdTh = calloc(CROWD, sizeof *crowdTh);
+    for (uint32_t i = 0; i < CROWD; i++) {
+        crowd[i] = (crowd_job_t){ .job = { .pool = &pool, .owner = 100u + i }, .barrier = &barrier };
+        ano_thread_create(&crowdTh[i], NULL, pool_crowd_thread, &crowd[i]);
+    }
+    ok = true;
+    for (uint32_t i = 0; i < CROWD; i++) {
+        ano_thread_join(crowdTh[i], NULL);
+        ok &= crowd[i].job.ok;
+    }
+    ano_thread_barrier_destroy(&barrier);
+    free(crowd);
+    free(crowdTh);
+    CHECK(ok, "more live threads than magazine slots");
+    ano_pool_stats(&pool, &st);
+    CHECK(st.live == 0, "slotless threads balance the stats");
+    ano_pool_destroy(&pool);
+}
+
+static ano_mem_tag_t g_testMem = ANO_MEM_TAG("anotest");
+
+static const ano_mem_report_t *find_report(ano_mem_report_t *all, size_t n, const char *name)
+{
+    for (size_t i = 0; i < n; i++)
+        if (strcmp(all[i].name, name) == 0)
+            return &all[i];
+    return NULL;
+}
+
+#define TAG_THREAD_OPS 20000u
+
+static void *tag_thread(void *arg)
+{
+    (void)arg;
+    for (uint32_t i = 0; i < TAG_THREAD_OPS; i++) {
+        void *p = ano_tmalloc(&g_testMem, 16u + (i & 255u));
+        p = ano_trealloc(&g_testMem, p, 300u + (i & 1023u));
+        ano_tfree(&g_testMem, p);
+    }
+    return NULL;
+}
+
+static const char *g_firstSite;
+
+static void *first_alloc_thread(void *arg)
+{
+    (void)arg;
+    g_firstSite = ANO_MEM_SITE_(__LINE__);
+    ano_tfree(&g_testMem, ano_tmalloc_(&g_testMem, 64, g_firstSite));
+    return NULL;
+}
+
+static void test_mem_tags(void)
+{
+    int64_t used = 0;
+    char *a = ano_tmalloc(&g_testMem, 100);
+    char *b = ano_tzalloc(&g_testMem, 5000);
+    char *c = ano_tcalloc(&g_testMem, 10, 40);
+    CHECK(a && b && c, "tagged allocations");
+    used = (int64_t)(mi_usable_size(a) + mi_usable_size(b) + mi_usable_size(c));
+    CHECK(g_testMem.live == used, "live counts usable bytes");
+    CHECK(g_testMem.allocs == 3 && g_testMem.frees == 0, "allocation count");
+    bool zero = true;
+    for (int i = 0; i < 5000; i++) zero &= b[i] == 0;
+    for (int i = 0; i < 400; i++) zero &= c[i] == 0;
+    CHECK(zero, "zalloc and calloc zero");
+
+    int64_t before = (int64_t)mi_usable_size(a);
+    a = ano_trealloc(&g_testMem, a, 100000);
+    CHECK(a != NULL, "tagged realloc");
+    used += (int64_t)mi_usable_size(a) - before;
+    CHECK(g_testMem.live == used, "realloc moves live by the size change");
+    int64_t peak = g_testMem.peak;
+    CHECK(peak >= used, "peak covers live");
+
+    ano_tfree(&g_testMem, a);
+    ano_tfree(&g_testMem, b);
+    ano_tfree(&g_testMem, c);
+    ano_tfree(&g_testMem, NULL);
+    CHECK(g_testMem.live == 0, "frees return live to zero");
+    CHECK(g_testMem.peak == peak, "peak survives the frees");
+    CHECK(g_testMem.allocs == g_testMem.frees, "every allocation freed, a moving realloc as both");
+
+    ano_mem_report_t all[64];
+    size_t n = ano_memory_report(all, 64);
+    const ano_mem_report_t *r = find_report(all, n < 64 ? n : 64, "anotest");
+    CHECK(r != NULL, "report lists the tag");
+    CHECK(r != NULL && r->peak == peak && r->live == 0, "report carries the counters");
+
+    // A heap-bound tag: blocks on the heap, its own and adopted ones, go away wholesale with it and the
+    // release retires exactly those. Blocks elsewhere stay live across rebinds.
+    static ano_mem_tag_t heapMem = ANO_MEM_TAG("anotest-heap");
+    void *outside = ano_tmalloc(&heapMem, 1000);
+    int64_t outsideLive = (int64_t)mi_usable_size(outside);
+    mi_heap_t *heap = mi_heap_new();
+    ano_mem_tag_bind(&heapMem, heap);
+    CHECK(heapMem.live == outsideLive, "binding keeps what is live elsewhere");
+    for (int i = 0; i < 32; i++)
+        CHECK(ano_tmalloc(&heapMem, 64) != NULL, "allocation from the bound heap");
+    void *lib = mi_heap_malloc(heap, 4096);     // a library's block on the heap
+    ano_tadopt(&heapMem, lib);
+    ano_tadopt(&heapMem, NULL);
+    CHECK(heapMem.live >= outsideLive + 32 * 64 + 4096 && heapMem.allocs == 34, "heap tag live, adopted block included");
+    ano_tfree(&heapMem, ano_tmalloc(&heapMem, 64));
+    mi_heap_destroy(heap);
+    ano_mem_tag_release(&heapMem);
+    CHECK(heapMem.live == outsideLive && heapMem.peak >= 32 * 64 + 4096, "release retires the heap, keeps the rest and peak");
+    CHECK(heapMem.heap == NULL && heapMem.frees == 34, "release unbinds and counts the heap's blocks freed");
+    ano_tfree(&heapMem, outside);
+    CHECK(heapMem.live == 0 && heapMem.allocs == heapMem.frees, "the block from before the bind balances");
+
+    // Sampling every byte records every allocation, keyed by its call site.
+    ano_memory_sample_every(1);
+    for (int i = 0; i < 8; i++)
+        ano_tfree(&g_testMem, ano_tmalloc(&g_testMem, 4096));
+    ano_memory_sample_every(0);
+    ano_mem_site_t sites[ANO_MEM_SITES];
+    size_t ns = ano_memory_sites(sites, ANO_MEM_SITES);
+    bool found = false;
+    for (size_t i = 0; i < ns && i < ANO_MEM_SITES; i++)
+        found |= strstr(sites[i].site, "anotest_memory.c:") != NULL && strcmp(sites[i].tag, "anotest") == 0
+                 && sites[i].samples >= 8 && sites[i].bytes >= 8 * 4096;
+    CHECK(found, "sampled site names this file and line");
+
+    // A fresh thread starts partway into its countdown: its first small allocation is not sampled.
+    ano_memory_sample_every((size_t)1 << 30);
+    anothread_t first;
+    ano_thread_create(&first, NULL, first_alloc_thread, NULL);
+    ano_thread_join(first, NULL);
+    ano_memory_sample_every(0);
+    ns = ano_memory_sites(sites, ANO_MEM_SITES);
+    found = false;
+    for (size_t i = 0; i < ns && i < ANO_MEM_SITES; i++)
+        found |= strcmp(sites[i].site, g_firstSite) == 0;
+    CHECK(!found, "a thread's first allocation is not always sampled");
+
+    anothread_t th[4];
+    for (int i = 0; i < 4; i++)
+        ano_thread_create(&th[i], NULL, tag_thread, NULL);
+    for (int i = 0; i < 4; i++)
+        ano_thread_join(th[i], NULL);
+    CHECK(g_testMem.live == 0, "concurrent tagged churn balances");
+    CHECK(g_testMem.allocs == g_testMem.frees, "concurrent allocs match frees");
+}
+
 static void test_huge_pages_probe(void)
 {
     // Best effort: huge/large OS pages are environment-gated (commonly unavailable
@@ -125,11 +597,186 @@ static void test_huge_pages_probe(void)
     printf("huge-page reservation probe: status=%d (non-zero is acceptable)\n", status);
 }
 
-int main(void)
+/* Pool benchmark (--bench) */
+
+#define BENCH_OBJ    64u     // bytes: a render command
+#define BENCH_WINDOW 1024u   // live objects per thread
+#define BENCH_MAXT   8
+
+typedef struct {
+    ano_pool_t *pool;        // NULL: mi_heap_malloc on a heap of the thread's own
+    uint32_t    ops;
+} churn_arg_t;
+
+static void *bench_churn(void *arg)
+{
+    churn_arg_t *a = arg;
+    void **win = calloc(BENCH_WINDOW, sizeof *win);
+    mi_heap_t *heap = a->pool ? NULL : mi_heap_new();
+    uint32_t at = 0;
+    for (uint32_t i = 0; i < a->ops; i++) {
+        at = (at + 613u) & (BENCH_WINDOW - 1u);     // odd step: visits every slot, not in order
+        if (a->pool) {
+            ano_pool_free(a->pool, win[at]);
+            win[at] = ano_pool_alloc(a->pool);
+        } else {
+            mi_free(win[at]);
+            win[at] = mi_heap_malloc(heap, BENCH_OBJ);
+        }
+        *(volatile uint32_t *)win[at] = i;
+    }
+    for (uint32_t i = 0; i < BENCH_WINDOW; i++) {
+        if (a->pool) ano_pool_free(a->pool, win[i]);
+        else         mi_free(win[i]);
+    }
+    if (heap) mi_heap_delete(heap);
+    free(win);
+    return NULL;
+}
+
+static double bench_point(ano_pool_t *pool, int threads, uint32_t ops)
+{
+    anothread_t th[BENCH_MAXT];
+    churn_arg_t arg = { pool, ops };
+    uint64_t t0 = ano_timestamp_raw();
+    for (int i = 0; i < threads; i++)
+        ano_thread_create(&th[i], NULL, bench_churn, &arg);
+    for (int i = 0; i < threads; i++)
+        ano_thread_join(th[i], NULL);
+    return bench_ops_per_sec((uint64_t)threads * ops, ano_timestamp_raw() - t0) / 1e6;
+}
+
+// Random pointer chase: each cache line holds the index of the next, one cycle through all of them
+// (Sattolo). Nearly every step lands on a page the TLB has not seen lately.
+#define CHASE_BYTES ((size_t)256 << 20)
+#define CHASE_STEPS 8000000u
+#define CHASE_LINE  64u
+
+#if defined(__linux__)
+static int dtlb_open(void)
+{
+    struct perf_event_attr pe;
+    memset(&pe, 0, sizeof pe);
+    pe.type           = PERF_TYPE_HW_CACHE;
+    pe.size           = sizeof pe;
+    pe.config         = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                      | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    pe.disabled       = 1;
+    pe.exclude_kernel = 1;
+    pe.exclude_hv     = 1;
+    return (int)syscall(SYS_perf_event_open, &pe, 0, -1, -1, 0);
+}
+#endif
+
+static void bench_chase(const char *label, uint32_t flags)
 {
+    ano_arena_t a;
+    uint32_t *lines = NULL;
+    if (ano_arena_init_ex(&a, CHASE_BYTES, flags) == 0)
+        lines = ano_arena_alloc(&a, CHASE_BYTES, CHASE_LINE);
+    if (lines == NULL) {
+        printf("%-12s arena unavailable\n", label);
+        ano_arena_destroy(&a);
+        return;
+    }
+    const uint32_t count = (uint32_t)(CHASE_BYTES / CHASE_LINE), stride = CHASE_LINE / sizeof *lines;
+    for (uint32_t i = 0; i < count; i++)
+        lines[(size_t)i * stride] = i;
+    uint64_t rng = 0x9E3779B97F4A7C15ull;
+    for (uint32_t i = count - 1u; i > 0; i--) {
+        rng ^= rng << 13; rng ^= rng >> 7; rng ^= rng << 17;
+        uint32_t j = (uint32_t)(rng % i);
+        uint32_t t = lines[(size_t)i * stride];
+        lines[(size_t)i * stride] = lines[(size_t)j * stride];
+        lines[(size_t)j * stride] = t;
+    }
+
+    long long misses = -1;
+#if defined(__linux__)
+    int fd = dtlb_open();
+    if (fd >= 0) { ioctl(fd, PERF_EVENT_IOC_RESET, 0); ioctl(fd, PERF_EVENT_IOC_ENABLE, 0); }
+#endif
+    uint32_t at = 0;
+    uint64_t t0 = ano_timestamp_raw();
+    for (uint32_t i = 0; i < CHASE_STEPS; i++)
+        at = lines[(size_t)at * stride];
+    uint64_t ns = ano_timestamp_raw() - t0;
+#if defined(__linux__)
+    if (fd >= 0) {
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(fd, &misses, sizeof misses) != (ssize_t)sizeof misses)
+            misses = -1;
+        close(fd);
+    }
+#endif
+    printf("%-12s pages kind %u  %7.2f ns/step  ", label, a.pages, (double)ns / CHASE_STEPS);
+    if (misses >= 0) printf("%8.3f dTLB misses/step", (double)misses / CHASE_STEPS);
+    else             printf("dTLB misses n/a (perf_event_open refused)");
+    printf("  [end %u]\n", at);  // keeps the chase live
+    ano_arena_destroy(&a);
+}
+
+static void bench_tlb(void)
+{
+    printf("\nTLB: random chase over %zu MiB, %u steps\n", CHASE_BYTES >> 20, CHASE_STEPS);
+#if defined(__linux__)
+    FILE *f = fopen("/sys/kernel/mm/transparent_hugepage/enabled", "r");
+    char thp[64] = "unknown";
+    if (f != NULL) {
+        if (fgets(thp, sizeof thp, f) == NULL) strcpy(thp, "unknown");
+        fclose(f);
+        thp[strcspn(thp, "\n")] = '\0';
+    }
+    printf("transparent_hugepage: %s (with [always], the normal arena gets huge pages too)\n", thp);
+#endif
+    bench_chase("normal", 0u);
+    bench_chase("huge", ANO_ARENA_HUGE);
+    bench_chase("huge+numa", ANO_ARENA_HUGE | ANO_ARENA_NUMA_LOCAL);
+    printf("(pages kind: 1 small, 2 transparent huge, 3 explicit 2 MiB, 4 explicit 1 GiB)\n");
+}
+
+static int run_bench(uint32_t ops)
+{
+    ano_pool_t pool;
+    if (ano_pool_init(&pool, BENCH_OBJ, 16) != 0) {
+        fprintf(stderr, "membench: pool init failed\n");
+        return 0;   // benchmark, not a test: never fails the suite
+    }
+    printf("Anoptic object pool benchmark -- %u free+alloc pairs/thread, %u-byte objects, %u live each\n\n",
+           ops, BENCH_OBJ, BENCH_WINDOW);
+    printf("%-8s %16s %16s %8s\n", "threads", "ano_pool Mops/s", "mi_heap Mops/s", "ratio");
+    for (int t = 1; t <= BENCH_MAXT; t *= 2) {
+        double p = bench_point(&pool, t, ops);
+        double m = bench_point(NULL, t, ops);
+        printf("%-8d %16.2f %16.2f %7.2fx\n", t, p, m, m > 0.0 ? p / m : 0.0);
+    }
+    ano_pool_stats_t st;
+    ano_pool_stats(&pool, &st);
+    printf("\npool after: %zu pages, %zu capacity, %zu live, %zu cached, %zu free\n",
+           st.pages, st.capacity, st.live, st.cached, st.free);
+    printf("(The pool is shared by every thread; each mimalloc thread owns its heap. Past the core\n"
+           " count the numbers measure the scheduler. Take the trend, not one run.)\n");
+    ano_pool_destroy(&pool);
+    bench_tlb();
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0) {
+        int v = argc > 2 ? atoi(argv[2]) : 0;
+        return run_bench(v > 0 ? (uint32_t)v : 2000000u);
+    }
+
     test_salloc_and_scope_cleanup();
     test_scoped_heap_aligned();
     test_basic_malloc();
+    test_arena();
+    test_arena_huge();
+    test_scratch();
+    test_pool_single();
+    test_pool_threads();
+    test_mem_tags();
     test_huge_pages_probe();
 
     if (failures == 0) { printf("anotest_memory: all checks passed\n"); return 0; }
@@ -0,0 +1,400 @@
+/* SPDX-FileCopyrightText: 2026 Anoptic Game Engine Authors
+ *
+ * SPDX-License-Identifier: LGPL-3.0 */
+/*  == Anoptic Game Engine v0.0000001 == */
+
+/* Coverage for mesh/ano_meshcook.h (headless; the glTF front end needs a scene, not covered here):
+ *   - cooking a rippled grid: level 0 keeps the source indices, decimated levels shrink and
+ *     are compacted, every level's metadata block tiles meshlets | meshlet vertices |
+ *     triangles | bounds | classic indices, and its sphere holds every vertex;
+ *   - a NULL config cooks level 0 alone; degenerate input cooks nothing;
+ *   - hashing: config hashes normalize what the cook ignores, byte hashes chain;
+ *   - .anomesh round trip: save, map, every level byte-identical, empty chains kept,
+ *     hashes stored; an empty file is valid;
+ *   - damaged files: truncated, wrong magic, an index past the vertex count, a chain
+ *     table out of order, a missing file. All refused;
+ *   - the derived-data cache: a chain put under a key views back from the hit byte-identical,
+ *     and the cache file is identical to ano_mesh_file_save's (scratch cache dir);
+ *   - parallel cooking: with the job pool up, levels cooking as jobs and several chains cooking
+ *     at once from jobs all match the inline cook byte for byte.
+ * Exit 0 == pass; failures print what broke. */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "anoptic_filesystem.h"
+#include "anoptic_jobs.h"
+#include "mesh/ano_meshcook.h"
+#include "templates/scratch.h"
+
+static int failures = 0;
+#define CHECK(cond, msg) do { \
+    if (!(cond)) { printf("FAIL: %s (%s:%d)\n", (msg), __FILE__, __LINE__); failures++; } \
+} while (0)
+
+#define GRID 48u
+
+// A GRID x GRID vertex sheet with a ripple, so the simplifier has curvature to keep.
+static void make_grid(ano_cook_vertex_t *vertices, uint32_t *indices)
+{
+    for (uint32_t y = 0; y < GRID; y++) {
+        for (uint32_t x = 0; x < GRID; x++) {
+            ano_cook_vertex_t *v = &vertices[y * GRID + x];
+            memset(v, 0, sizeof *v);
+            v->position[0] = (float)x;
+            v->position[1] = sinf((float)x * 0.25f) * cosf((float)y * 0.2f) * 2.0f;
+            v->position[2] = (float)y;
+            v->normal[1] = 1.0f;
+            v->tex_coord[0] = (float)x / (GRID - 1);
+            v->tex_coord[1] = (float)y / (GRID - 1);
+        }
+    }
+    uint32_t at = 0;
+    for (uint32_t y = 0; y + 1 < GRID; y++) {
+        for (uint32_t x = 0; x + 1 < GRID; x++) {
+            uint32_t i = y * GRID + x;
+            indices[at++] = i;
+            indices[at++] = i + GRID;
+            indices[at++] = i + 1;
+            indices[at++] = i + 1;
+            indices[at++] = i + GRID;
+            indices[at++] = i + GRID + 1;
+        }
+    }
+}
+
+// The block layout and every index in range, the way the mesh shader walks it.
+static bool level_consistent(const ano_mesh_level_t *lvl)
+{
+    if (lvl->meshlet_count == 0 || lvl->vertex_count == 0)
+        return false;
+    if (lvl->unique_vertices_offset != lvl->meshlet_count * sizeof(ano_meshlet_t) ||
+        lvl->triangles_offset < lvl->unique_vertices_offset || lvl->triangles_offset % 4 != 0 ||
+        lvl->bounds_offset < lvl->triangles_offset || lvl->bounds_offset % 4 != 0 ||
+        lvl->classic_index_offset != lvl->bounds_offset + lvl->meshlet_count * sizeof(ano_meshlet_bounds_gpu_t) ||
+        lvl->metadata_size != lvl->classic_index_offset + lvl->classic_index_count * sizeof(uint32_t))
+        return false;
+    const ano_meshlet_t *meshlets = (const ano_meshlet_t *)lvl->metadata;
+    const uint32_t *unique = (const uint32_t *)(lvl->metadata + lvl->unique_vertices_offset);
+    const uint8_t *tris = lvl->metadata + lvl->triangles_offset;
+    uint32_t triangles = 0;
+    for (uint32_t m = 0; m < lvl->meshlet_count; m++) {
+        const ano_meshlet_t *ml = &meshlets[m];
+        if (ml->vertex_count > ANO_MESHLET_MAX_VERTICES || ml->triangle_count > ANO_MESHLET_MAX_TRIANGLES)
+            return false;
+        for (uint32_t k = 0; k < ml->vertex_count; k++)
+            if (unique[ml->vertex_offset + k] >= lvl->vertex_count)
+                return false;
+        for (uint32_t k = 0; k < ml->triangle_count * 3; k++)
+            if (tris[ml->triangle_offset + k] >= ml->vertex_count)
+                return false;
+        triangles += ml->triangle_count;
+    }
+    const uint32_t *classic = (const uint32_t *)(lvl->metadata + lvl->classic_index_offset);
+    for (uint32_t i = 0; i < lvl->classic_index_count; i++)
+        if (classic[i] >= lvl->vertex_count)
+            return false;
+    return triangles * 3 == lvl->classic_index_count;
+}
+
+static bool sphere_holds(const ano_mesh_level_t *lvl)
+{
+    for (uint32_t i = 0; i < lvl->vertex_count; i++) {
+        float dx = lvl->vertices[i].position[0] - lvl->sphere[0];
+        float dy = lvl->vertices[i].position[1] - lvl->sphere[1];
+        float dz = lvl->vertices[i].position[2] - lvl->sphere[2];
+        if (sqrtf(dx * dx + dy * dy + dz * dz) > lvl->sphere[3] * 1.0001f + 1e-5f)
+            return false;
+    }
+    return true;
+}
+
+static bool levels_equal(const ano_mesh_level_t *a, const ano_mesh_level_t *b)
+{
+    return a->vertex_count == b->vertex_count && a->metadata_size == b->metadata_size &&
+           a->meshlet_count == b->meshlet_count && a->unique_vertices_offset == b->unique_vertices_offset &&
+           a->triangles_offset == b->triangles_offset && a->bounds_offset == b->bounds_offset &&
+           a->classic_index_offset == b->classic_index_offset &&
+           a->classic_index_count == b->classic_index_count &&
+           memcmp(a->sphere, b->sphere, sizeof a->sphere) == 0 &&
+           memcmp(a->vertices, b->vertices, (size_t)a->vertex_count * sizeof(ano_cook_vertex_t)) == 0 &&
+           memcmp(a->metadata, b->metadata, a->metadata_size) == 0;
+}
+
+static void test_cook(const ano_cook_vertex_t *vertices, const uint32_t *indices, uint32_t indexCount)
+{
+    AnoLodConfig cfg = ano_lod_config_default(4);
+    ano_mesh_chain_t chain;
+    uint32_t n = ano_mesh_cook_chain(&chain, vertices, GRID * GRID, indices, indexCount, &cfg);
+    CHECK(n >= 2 && n == chain.level_count, "a rippled grid cooks a LOD chain");
+
+    const ano_mesh_level_t *l0 = &chain.levels[0];
+    CHECK(l0->vertex_count == GRID * GRID &&
+          memcmp(l0->vertices, vertices, sizeof(ano_cook_vertex_t) * GRID * GRID) == 0,
+          "level 0 keeps the source vertices");
+    CHECK(l0->classic_index_count == indexCount &&
+          memcmp(l0->metadata + l0->classic_index_offset, indices, indexCount * sizeof(uint32_t)) == 0,
+          "level 0 keeps the source indices");
+    for (uint32_t i = 0; i < n; i++) {
+        CHECK(level_consistent(&chain.levels[i]), "level block layout and indices");
+        CHECK(sphere_holds(&chain.levels[i]), "level sphere holds its vertices");
+        if (i > 0) {
+            CHECK(chain.levels[i].classic_index_count < chain.levels[i - 1].classic_index_count,
+                  "each level has fewer triangles");
+            CHECK(chain.levels[i].vertex_count < GRID * GRID, "decimated levels are compacted");
+        }
+    }
+    ano_mesh_chain_free(&chain);
+    CHECK(chain.level_count == 0 && chain.owned[0] == NULL, "free empties the chain");
+
+    n = ano_mesh_cook_chain(&chain, vertices, GRID * GRID, indices, indexCount, NULL);
+    CHECK(n == 1 && chain.levels[0].classic_index_count == indexCount, "NULL config cooks level 0 alone");
+    ano_mesh_chain_free(&chain);
+
+    n = ano_mesh_cook_chain(&chain, vertices, GRID * GRID, indices, 0, &cfg);
+    CHECK(n == 0 && chain.level_count == 0, "no triangles cooks nothing");
+    ano_mesh_chain_free(&chain);
+}
+
+static void test_hashes(void)
+{
+    AnoLodConfig a = ano_lod_config_default(4), b = ano_lod_config_default(4);
+    CHECK(ano_lod_config_hash(&a) == ano_lod_config_hash(&b), "equal configs hash equal");
+    b.ratios[7] = 0.9f;
+    CHECK(ano_lod_config_hash(&a) == ano_lod_config_hash(&b), "ratios past lodCount are ignored");
+    b.ratios[2] = 0.3f;
+    CHECK(ano_lod_config_hash(&a) != ano_lod_config_hash(&b), "a used ratio changes the hash");
+    AnoLodConfig two = ano_lod_config_default(2);
+    CHECK(ano_lod_config_hash(&a) != ano_lod_config_hash(&two), "lodCount changes the hash");
+    two = ano_lod_config_default(4);
+    two.uvWeight = 0.0f;
+    CHECK(ano_lod_config_hash(&a) != ano_lod_config_hash(&two), "an attribute weight changes the hash");
+    AnoLodConfig one = ano_lod_config_default(1);
+    one.targetError = 0.5f;
+    one.normalWeight = 2.0f;
+    CHECK(ano_lod_config_hash(NULL) == ano_lod_config_hash(&one), "a single level ignores the budget");
+
+    char text[] = "the quick brown fox jumps over the lazy dog";
+    uint64_t h = ano_mesh_hash_bytes(text, sizeof text - 1, 0);
+    CHECK(h == ano_mesh_hash_bytes(text, sizeof text - 1, 0), "byte hash is stable");
+    text[40] ^= 1;
+    CHECK(h != ano_mesh_hash_bytes(text, sizeof text - 1, 0), "a flipped tail bit changes the hash");
+    text[40] ^= 1;
+    uint64_t chained = ano_mesh_hash_bytes(text + 20, sizeof text - 21, ano_mesh_hash_bytes(text, 20, 0));
+    CHECK(chained != h && chained == ano_mesh_hash_bytes(text + 20, sizeof text - 21, ano_mesh_hash_bytes(text, 20, 0)),
+          "chained hashes are stable and differ from the single range");
+}
+
+static bool file_write(const char *path, const void *bytes, size_t len)
+{
+    FILE *f = fopen(path, "wb");
+    if (f == NULL)
+        return false;
+    bool ok = fwrite(bytes, 1, len, f) == len;
+    return fclose(f) == 0 && ok;
+}
+
+static void test_file(const ano_cook_vertex_t *vertices, const uint32_t *indices, uint32_t indexCount)
+{
+    ano_fspath base = ano_fs_gamepath();
+    char path[MAXPATH + 32], bad[MAXPATH + 32];
+    snprintf(path, sizeof path, "%s/anotest_meshcook.anomesh", base.str);
+    snprintf(bad, sizeof bad, "%s/anotest_meshcook_bad.anomesh", base.str);
+
+    // Three chains: the full chain, an empty (skipped) primitive, and a single level.
+    AnoLodConfig cfg = ano_lod_config_default(4);
+    ano_mesh_chain_t chains[3];
+    ano_mesh_cook_chain(&chains[0], vertices, GRID * GRID, indices, indexCount, &cfg);
+    memset(&chains[1], 0, sizeof chains[1]);
+    ano_mesh_cook_chain(&chains[2], vertices, GRID * GRID, indices, 6 * 5, NULL);
+    uint64_t configHash = ano_lod_config_hash(&cfg);
+    CHECK(ano_mesh_file_save(path, chains, 3, 0x1234, configHash) == 0, "save");
+    CHECK(ano_mesh_file_save(NULL, chains, 3, 0, 0) == -1, "save refuses a NULL path");
+
+    ano_mesh_file_t file;
+    CHECK(ano_mesh_file_map(&file, path), "map");
+    CHECK(file.chain_count == 3 && file.source_hash == 0x1234 && file.config_hash == configHash,
+          "header round-trips");
+    bool same = true;
+    for (uint32_t c = 0; c < 3; c++) {
+        ano_mesh_chain_t view;
+        same = same && ano_mesh_file_chain(&file, c, &view) && view.level_count == chains[c].level_count;
+        for (uint32_t l = 0; same && l < view.level_count; l++)
+            same = levels_equal(&view.levels[l], &chains[c].levels[l]) && view.owned[l] == NULL &&
+                   ((uintptr_t)view.levels[l].vertices % 16) == 0 && ((uintptr_t)view.levels[l].metadata % 16) == 0;
+        ano_mesh_chain_free(&view);
+    }
+    CHECK(same, "every level maps back byte-identical and aligned");
+    ano_mesh_chain_t past;
+    CHECK(!ano_mesh_file_chain(&file, 3, &past) && past.level_count == 0, "chain index past the end refused");
+
+    // Damaged copies, checked in memory.
+    uint8_t *copy = malloc(file.size);
+    CHECK(copy != NULL, "copy the file");
+    if (copy != NULL) {
+        ano_mesh_file_t v;
+        size_t size = file.size;
+        memcpy(copy, file.map, size);
+        CHECK(ano_mesh_file_view(&v, copy, size), "an intact copy views");
+        CHECK(!ano_mesh_file_view(&v, copy, size - 1), "truncated file refused");
+        copy[0] ^= 0xFF;
+        CHECK(!ano_mesh_file_view(&v, copy, size) && v.map == NULL, "wrong magic refused");
+        copy[0] ^= 0xFF;
+
+        // Level 0's record: after the header and the 4 chain starts, rounded to 16.
+        size_t record = (64 + 4 * 4 + 15) & ~(size_t)15;
+        uint64_t metadataAt;
+        uint32_t classicOffset, vertexCount;
+        memcpy(&metadataAt, copy + record + 8, 8);
+        memcpy(&vertexCount, copy + record + 16, 4);
+        memcpy(&classicOffset, copy + record + 40, 4);
+        uint32_t saved;
+        memcpy(&saved, copy + metadataAt + classicOffset, 4);
+        memcpy(copy + metadataAt + classicOffset, &vertexCount, 4);
+        CHECK(!ano_mesh_file_view(&v, copy, size), "classic index past the vertices refused");
+        memcpy(copy + metadataAt + classicOffset, &saved, 4);
+
+        uint32_t start;
+        memcpy(&start, copy + 64 + 4, 4);
+        uint32_t backwards = 0xFFFFu;
+        memcpy(copy + 64 + 4, &backwards, 4);
+        CHECK(!ano_mesh_file_view(&v, copy, size), "chain table out of order refused");
+        memcpy(copy + 64 + 4, &start, 4);
+
+        CHECK(file_write(bad, copy, size - 16) && !ano_mesh_file_map(&v, bad), "truncated file on disk refused");
+        CHECK(ano_mesh_file_view(&v, copy, size), "repairs restore a valid copy");
+        ano_mesh_file_unmap(&v);   // a view: no-op
+        free(copy);
+    }
+    remove(bad);
+    ano_mesh_file_t missing;
+    CHECK(!ano_mesh_file_map(&missing, bad), "missing file refused");
+    ano_mesh_file_unmap(&file);
+    CHECK(file.map == NULL, "unmap empties");
+
+    CHECK(ano_mesh_file_save(path, NULL, 0, 7, 7) == 0 && ano_mesh_file_map(&file, path) &&
+          file.chain_count == 0, "an empty file round-trips");
+    ano_mesh_file_unmap(&file);
+
+    for (uint32_t c = 0; c < 3; c++)
+        ano_mesh_chain_free(&chains[c]);
+    remove(path);
+}
+
+static void test_cache(const ano_cook_vertex_t *vertices, const uint32_t *indices, uint32_t indexCount)
+{
+    ano_fspath base = ano_fs_gamepath();
+    char dir[MAXPATH + 32], path[MAXPATH + 32];
+    snprintf(dir, sizeof dir, "%s/anotest_meshcook_cache", base.str);
+    snprintf(path, sizeof path, "%s/anotest_meshcook_cache.anomesh", base.str);
+    CHECK(ano_fs_cache_configure(dir, 0) == 0, "configure a scratch cache");
+
+    AnoLodConfig cfg = ano_lod_config_default(3);
+    ano_mesh_chain_t chain;
+    ano_mesh_cook_chain(&chain, vertices, GRID * GRID, indices, indexCount, &cfg);
+    ano_fs_cache_key key = ano_fs_cache_key_begin("anotest_meshcook", ANO_MESH_COOK_VERSION);
+    ano_fs_cache_key_add(&key, indices, indexCount * sizeof(uint32_t));
+    CHECK(ano_mesh_file_put_cache(&key, &chain, 1, 5, 6) == 0, "put a chain in the cache");
+
+    ano_fs_cache_blob blob;
+    ano_mesh_file_t file;
+    CHECK(ano_fs_cache_get(&key, &blob), "cache hit");
+    CHECK(ano_mesh_file_view(&file, blob.data, blob.size) && file.chain_count == 1 &&
+          file.source_hash == 5 && file.config_hash == 6, "the hit views as a .anomesh");
+    ano_mesh_chain_t view;
+    bool same = ano_mesh_file_chain(&file, 0, &view) && view.level_count == chain.level_count;
+    for (uint32_t l = 0; same && l < view.level_count; l++)
+        same = levels_equal(&view.levels[l], &chain.levels[l]);
+    CHECK(same, "cached levels are byte-identical");
+
+    ano_mesh_file_t saved;
+    CHECK(ano_mesh_file_save(path, &chain, 1, 5, 6) == 0 && ano_mesh_file_map(&saved, path), "save the same chain");
+    CHECK(saved.size == blob.size && memcmp(saved.map, blob.data, blob.size) == 0,
+          "the cache payload is the saved file's image");
+    ano_mesh_file_unmap(&saved);
+    ano_mesh_file_unmap(&file);
+    ano_fs_cache_release(&blob);
+    ano_mesh_chain_free(&chain);
+
+    CHECK(ano_fs_cache_configure(dir, 1) == 0, "a one-byte cap evicts everything");
+    remove(path);
+    scratch_remove_dir(dir);
+}
+
+#define PARALLEL_CHAINS 8u
+
+typedef struct {
+    const ano_cook_vertex_t *vertices;
+    const uint32_t *indices;
+    uint32_t indexCount;
+    const AnoLodConfig *cfg;
+    ano_mesh_chain_t chains[PARALLEL_CHAINS];
+} parallel_cook_t;
+
+static void cook_range(void *ctx, size_t begin, size_t end)
+{
+    parallel_cook_t *p = ctx;
+    for (size_t i = begin; i < end; i++)
+        ano_mesh_cook_chain(&p->chains[i], p->vertices, GRID * GRID, p->indices, p->indexCount, p->cfg);
+}
+
+static bool chains_equal(const ano_mesh_chain_t *a, const ano_mesh_chain_t *b)
+{
+    if (a->level_count != b->level_count)
+        return false;
+    for (uint32_t i = 0; i < a->level_count; i++) {
+        if (!levels_equal(&a->levels[i], &b->levels[i]))
+            return false;
+    }
+    return true;
+}
+
+static void test_parallel(const ano_cook_vertex_t *vertices, const uint32_t *indices, uint32_t indexCount)
+{
+    AnoLodConfig cfg = ano_lod_config_default(ANO_MAX_LOD);
+    ano_mesh_chain_t serial, pooled;
+    ano_mesh_cook_chain(&serial, vertices, GRID * GRID, indices, indexCount, &cfg);
+    CHECK(serial.level_count >= 2, "the inline cook builds a chain");
+
+    if (ano_jobs_init(4, false) != 0) {
+        CHECK(false, "job pool starts");
+        ano_mesh_chain_free(&serial);
+        return;
+    }
+    ano_mesh_cook_chain(&pooled, vertices, GRID * GRID, indices, indexCount, &cfg);
+    CHECK(chains_equal(&serial, &pooled), "levels cooked as jobs match the inline cook");
+    ano_mesh_chain_free(&pooled);
+
+    static parallel_cook_t p;
+    p = (parallel_cook_t){ vertices, indices, indexCount, &cfg, {{0}} };
+    ano_parallel_for(PARALLEL_CHAINS, 1, cook_range, &p);
+    for (uint32_t i = 0; i < PARALLEL_CHAINS; i++) {
+        CHECK(chains_equal(&serial, &p.chains[i]), "chains cooked from jobs at once match the inline cook");
+        ano_mesh_chain_free(&p.chains[i]);
+    }
+    ano_jobs_cleanup();
+    ano_mesh_chain_free(&serial);
+}
+
+int main(void)
+{
+    uint32_t indexCount = (GRID - 1) * (GRID - 1) * 6;
+    ano_cook_vertex_t *vertices = malloc(sizeof(ano_cook_vertex_t) * GRID * GRID);
+    uint32_t *indices = malloc(sizeof(uint32_t) * indexCount);
+    if (vertices == NULL || indices == NULL) { printf("FAIL: allocation\n"); return 1; }
+    make_grid(vertices, indices);
+
+    test_cook(vertices, indices, indexCount);
+    test_hashes();
+    test_file(vertices, indices, indexCount);
+    test_cache(vertices, indices, indexCount);
+    test_parallel(vertices, indices, indexCount);
+
+    free(vertices);
+    free(indices);
+    if (failures == 0) { printf("anotest_meshcook: all checks passed\n"); return 0; }
+    printf("anotest_meshcook: %d check(s) failed\n", failures);
+    return 1;
+}
@@ -3,6 +3,8 @@
  * SPDX-License-Identifier: LGPL-3.0 */
 
 #include <mesh/ano_meshoptimizer.h>
+#include "anoptic_memory.h"
+#include "templates/bench.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -580,7 +582,299 @@ static void test_simplify_tetra_link() {
     assert(!has_dup_face(out, r));   // link + tetra exclusion: no non-manifold doubled face emitted
 }
 
-int main() {
+// Heap order (ano_simplify_arena, flags 0) keeps every contract and guard the pass order does: the
+// count and error budgets, the bridge and trench caps, and the link + tetra exclusion.
+static void test_simplify_heap_order() {
+    printf("Running test_simplify_heap_order...\n");
+
+    enum { N = 12 };
+    float positions[N*N*3];
+    uint32_t indices[(N-1)*(N-1)*2*3];
+    uint32_t out[(N-1)*(N-1)*2*3];
+    size_t ic = build_grid(N, positions, indices);
+    float extent = ano_simplify_scale(positions, N*N, sizeof(float)*3);
+
+    // Flat grid: the count budget is reached at ~zero error.
+    size_t target = (ic / 2 / 3) * 3;
+    float err = -1.0f;
+    size_t r = ano_simplify_arena(out, indices, ic, positions, N*N, sizeof(float)*3, target, 0.05f, 0.0f,
+                                  0u, NULL, &err);
+    validate_indices(out, r, N*N);
+    assert(r > 0 && r <= target);
+    assert(err >= 0.0f && err < 0.1f);
+
+    // Guard bridge: decimating hard may not span the surface.
+    target = (ic / 8 / 3) * 3;
+    r = ano_simplify_arena(out, indices, ic, positions, N*N, sizeof(float)*3, target, 0.05f,
+                           ANO_SIMPLIFY_EDGE_FACTOR_DEFAULT, 0u, NULL, NULL);
+    validate_indices(out, r, N*N);
+    assert(r > 0 && r < ic);
+    assert(max_edge_len(out, r, positions) < 0.5f * extent);
+
+    // Concave trench.
+    for (uint32_t x = 0; x < N; ++x) positions[((N/2)*N+x)*3+2] = -1.5f;
+    extent = ano_simplify_scale(positions, N*N, sizeof(float)*3);
+    r = ano_simplify_arena(out, indices, ic, positions, N*N, sizeof(float)*3, target, 0.05f, 8.0f,
+                           0u, NULL, NULL);
+    validate_indices(out, r, N*N);
+    assert(r > 0 && r < ic);
+    assert(max_edge_len(out, r, positions) < 0.5f * extent);
+
+    // Bumpy grid: a generous budget reaches the count, a tiny one stops short.
+    for (uint32_t y = 0; y < N; ++y)
+        for (uint32_t x = 0; x < N; ++x)
+            positions[(y*N+x)*3+2] = 0.6f * sinf((float)x * 0.9f) * cosf((float)y * 0.9f);
+    target = (ic / 4 / 3) * 3;
+    size_t rg = ano_simplify_arena(out, indices, ic, positions, N*N, sizeof(float)*3, target, 1.0f, 0.0f,
+                                   0u, NULL, NULL);
+    validate_indices(out, rg, N*N);
+    size_t rs = ano_simplify_arena(out, indices, ic, positions, N*N, sizeof(float)*3, target, 1e-4f, 0.0f,
+                                   0u, NULL, NULL);
+    validate_indices(out, rs, N*N);
+    assert(rg <= target);
+    assert(rs > target && rs < ic);
+
+    // Each collapse is the cheapest one left, so it never needs more error than a pass to hit the count.
+    float err_pass = -1.0f, err_heap = -1.0f;
+    ano_simplify_arena(out, indices, ic, positions, N*N, sizeof(float)*3, target, 1.0f, 0.0f,
+                       ANO_SIMPLIFY_DETERMINISTIC, NULL, &err_pass);
+    ano_simplify_arena(out, indices, ic, positions, N*N, sizeof(float)*3, target, 1.0f, 0.0f,
+                       0u, NULL, &err_heap);
+    assert(err_heap <= err_pass);
+
+    // Tetra: only the link + tetra exclusion stop a doubled face.
+    float tpos[7*3] = {
+        0.0f,0.0f,0.0f,   1.0f,0.0f,0.0f,   0.5f,0.866f,0.0f,   0.5f,0.289f,0.06f,
+        100.0f,0.0f,0.0f, 101.0f,0.0f,0.0f, 100.0f,0.0f,1.0f
+    };
+    uint32_t tidx[5*3] = { 0,1,2,  0,3,1,  1,3,2,  2,3,0,  4,5,6 };
+    uint32_t tout[5*3];
+    r = ano_simplify_arena(tout, tidx, 15, tpos, 7, sizeof(float)*3, 9u, 2.0f, 8.0f, 0u, NULL, NULL);
+    validate_indices(tout, r, 7);
+    assert(!has_dup_face(tout, r));
+}
+
+// A caller arena: both orders give the bytes they give on a private one, ANO_SIMPLIFY_DETERMINISTIC
+// gives ano_simplify_ex's, the arena comes back rewound, and one too small falls back rather than fail.
+static void test_simplify_arena() {
+    printf("Running test_simplify_arena...\n");
+
+    enum { N = 16 };
+    float positions[N*N*3];
+    uint32_t indices[(N-1)*(N-1)*2*3];
+    size_t ic = build_grid(N, positions, indices);
+    for (uint32_t y = 0; y < N; ++y)
+        for (uint32_t x = 0; x < N; ++x)
+            positions[(y*N+x)*3+2] = 0.4f * sinf((float)x * 0.7f) * cosf((float)y * 0.5f);
+    size_t target = (ic / 5 / 3) * 3;
+
+    static uint32_t ref[(N-1)*(N-1)*2*3], got[(N-1)*(N-1)*2*3];
+    const uint32_t modes[2] = { ANO_SIMPLIFY_DETERMINISTIC, 0u };
+    const float factors[2] = { 0.0f, ANO_SIMPLIFY_EDGE_FACTOR_DEFAULT };
+    for (int m = 0; m < 2; ++m)
+        for (int f = 0; f < 2; ++f) {
+            size_t need = ano_simplify_scratch_size(ic, N*N, 0, modes[m]);
+            ano_arena_t arena;
+            assert(ano_arena_init(&arena, need) == 0);
+
+            float e0 = -1.0f, e1 = -1.0f;
+            size_t r0 = ano_simplify_arena(ref, indices, ic, positions, N*N, sizeof(float)*3, target, 0.05f,
+                                           factors[f], modes[m], NULL, &e0);
+            for (int rep = 0; rep < 3; ++rep) {
+                size_t mark = ano_arena_mark(&arena);
+                size_t r1 = ano_simplify_arena(got, indices, ic, positions, N*N, sizeof(float)*3, target,
+                                               0.05f, factors[f], modes[m], &arena, &e1);
+                assert(ano_arena_mark(&arena) == mark);
+                assert(r1 == r0 && memcmp(got, ref, r0 * sizeof(uint32_t)) == 0 && e1 == e0);
+            }
+            if (modes[m] == ANO_SIMPLIFY_DETERMINISTIC) {
+                size_t rx = ano_simplify_ex(got, indices, ic, positions, N*N, sizeof(float)*3, target, 0.05f,
+                                            factors[f], &e1);
+                assert(rx == r0 && memcmp(got, ref, r0 * sizeof(uint32_t)) == 0 && e1 == e0);
+            }
+            ano_arena_destroy(&arena);
+
+            // Too small for the call: a private arena takes over.
+            assert(ano_arena_init(&arena, 4096) == 0);
+            size_t r2 = ano_simplify_arena(got, indices, ic, positions, N*N, sizeof(float)*3, target, 0.05f,
+                                           factors[f], modes[m], &arena, NULL);
+            assert(r2 == r0 && memcmp(got, ref, r0 * sizeof(uint32_t)) == 0);
+            assert(ano_arena_mark(&arena) == 0);
+            ano_arena_destroy(&arena);
+        }
+}
+
+// A flat grid with a uv seam down column S: cells right of it use their own wedges there (u restarts
+// at 0), as an unwrapped cylinder would. Vertex layout is position, normal, uv; returns the index count.
+enum { SEAM_N = 16, SEAM_S = 8, SEAM_VC = SEAM_N*SEAM_N + SEAM_N };
+static size_t build_seam_grid(float* verts, uint32_t* indices) {
+    for (uint32_t i = 0; i < SEAM_VC; ++i) {
+        uint32_t seam = i >= SEAM_N*SEAM_N;
+        uint32_t x = seam ? SEAM_S : i % SEAM_N, y = seam ? i - SEAM_N*SEAM_N : i / SEAM_N;
+        float* v = &verts[i*8];
+        v[0] = (float)x; v[1] = (float)y; v[2] = 0.0f;
+        v[3] = 0.0f; v[4] = 0.0f; v[5] = 1.0f;
+        v[6] = (seam || x > SEAM_S) ? (float)(x - SEAM_S) / (SEAM_N-1 - SEAM_S) : (float)x / SEAM_S;
+        v[7] = (float)y / (SEAM_N-1);
+    }
+    size_t k = 0;
+    for (uint32_t y = 0; y < SEAM_N - 1; ++y)
+        for (uint32_t x = 0; x < SEAM_N - 1; ++x) {
+            uint32_t c[4] = { y*SEAM_N+x, y*SEAM_N+x+1, (y+1)*SEAM_N+x, (y+1)*SEAM_N+x+1 };
+            if (x == SEAM_S) { c[0] = SEAM_N*SEAM_N + y; c[2] = SEAM_N*SEAM_N + y + 1; }
+            indices[k++] = c[0]; indices[k++] = c[1]; indices[k++] = c[3];
+            indices[k++] = c[0]; indices[k++] = c[3]; indices[k++] = c[2];
+        }
+    return k;
+}
+
+// A triangle with a corner from each side of the seam: uvs interpolated across the wrap.
+static int crosses_seam(const uint32_t* idx, size_t r) {
+    for (size_t t = 0; t < r; t += 3) {
+        int left = 0, right = 0;
+        for (int k = 0; k < 3; ++k) {
+            uint32_t o = idx[t+k];
+            if (o >= SEAM_N*SEAM_N || o % SEAM_N > SEAM_S) right = 1;
+            else left = 1;
+        }
+        if (left && right) return 1;
+    }
+    return 0;
+}
+
+// Attribute-aware simplification: without attributes (or at zero weight) it is ano_simplify_arena to
+// the byte; with them seams survive decimation, drift in a curved attribute field is charged against
+// the budget while a linear one is free, and a caller arena sized with the attribute count suffices.
+static void test_simplify_attributes() {
+    printf("Running test_simplify_attributes...\n");
+
+    static float verts[SEAM_VC*8];
+    static uint32_t indices[(SEAM_N-1)*(SEAM_N-1)*6], ref[(SEAM_N-1)*(SEAM_N-1)*6], out[(SEAM_N-1)*(SEAM_N-1)*6];
+    size_t ic = build_seam_grid(verts, indices);
+    const size_t stride = sizeof(float) * 8;
+    const float weights[5] = { 0.5f, 0.5f, 0.5f, 1.0f, 1.0f };
+    const float zero[5] = { 0 };
+    const uint32_t modes[2] = { ANO_SIMPLIFY_DETERMINISTIC, 0u };
+    size_t target = (ic / 4 / 3) * 3;
+
+    for (int m = 0; m < 2; ++m) {
+        float e0 = -1.0f, e1 = -1.0f;
+        size_t r0 = ano_simplify_arena(ref, indices, ic, verts, SEAM_VC, stride, target, 0.05f,
+                                       ANO_SIMPLIFY_EDGE_FACTOR_DEFAULT, modes[m], NULL, &e0);
+        size_t r1 = ano_simplify_with_attributes(out, indices, ic, verts, SEAM_VC, stride, NULL, 0, NULL, 0,
+                                                 target, 0.05f, ANO_SIMPLIFY_EDGE_FACTOR_DEFAULT, modes[m],
+                                                 NULL, &e1);
+        assert(r1 == r0 && memcmp(out, ref, r0 * sizeof(uint32_t)) == 0 && e1 == e0);
+        r1 = ano_simplify_with_attributes(out, indices, ic, verts, SEAM_VC, stride, &verts[3], stride, zero, 5,
+                                          target, 0.05f, ANO_SIMPLIFY_EDGE_FACTOR_DEFAULT, modes[m], NULL, &e1);
+        assert(r1 == r0 && memcmp(out, ref, r0 * sizeof(uint32_t)) == 0 && e1 == e0);
+
+        // Geometry alone snaps collapsed seam corners onto the left wedges; attributes keep each side's.
+        validate_indices(ref, r0, SEAM_VC);
+        assert(r0 < ic && crosses_seam(ref, r0));
+        size_t ra = ano_simplify_with_attributes(out, indices, ic, verts, SEAM_VC, stride, &verts[3], stride,
+                                                 weights, 5, target, 0.05f, ANO_SIMPLIFY_EDGE_FACTOR_DEFAULT,
+                                                 modes[m], NULL, &e1);
+        validate_indices(out, ra, SEAM_VC);
+        assert(ra > 0 && ra < ic && !crosses_seam(out, ra));
+        assert(e1 >= 0.0f && e1 <= 0.05f * (SEAM_N-1));
+
+        // The same call on an arena sized for it: same bytes, arena rewound.
+        ano_arena_t arena;
+        assert(ano_arena_init(&arena, ano_simplify_scratch_size(ic, SEAM_VC, 5, modes[m])) == 0);
+        float e2 = -1.0f;
+        size_t rb = ano_simplify_with_attributes(ref, indices, ic, verts, SEAM_VC, stride, &verts[3], stride,
+                                                 weights, 5, target, 0.05f, ANO_SIMPLIFY_EDGE_FACTOR_DEFAULT,
+                                                 modes[m], &arena, &e2);
+        assert(rb == ra && memcmp(out, ref, ra * sizeof(uint32_t)) == 0 && e2 == e1);
+        assert(ano_arena_mark(&arena) == 0);
+        ano_arena_destroy(&arena);
+    }
+
+    // A flat plain grid: uv linear in position costs nothing to decimate, a bumpy normal field does.
+    enum { N = 16 };
+    static float pv[N*N*8], pos[N*N*3];
+    static uint32_t gidx[(N-1)*(N-1)*6];
+    ic = build_grid(N, pos, gidx);
+    for (uint32_t i = 0; i < N*N; ++i) {
+        float x = pos[i*3+0], y = pos[i*3+1];
+        float nx = 0.5f * sinf(x * 0.8f) * cosf(y * 0.8f);
+        float* v = &pv[i*8];
+        v[0] = x; v[1] = y; v[2] = 0.0f;
+        v[3] = nx; v[4] = 0.0f; v[5] = sqrtf(1.0f - nx*nx);
+        v[6] = x / (N-1); v[7] = y / (N-1);
+    }
+    target = (ic / 4 / 3) * 3;
+    const float uvOnly[5] = { 0.0f, 0.0f, 0.0f, 1.0f, 1.0f };
+    for (int m = 0; m < 2; ++m) {
+        size_t rg = ano_simplify_arena(out, gidx, ic, pv, N*N, sizeof(float)*8, target, 0.05f, 0.0f,
+                                       modes[m], NULL, NULL);
+        size_t ru = ano_simplify_with_attributes(out, gidx, ic, pv, N*N, sizeof(float)*8, &pv[3],
+                                                 sizeof(float)*8, uvOnly, 5, target, 0.05f, 0.0f, modes[m],
+                                                 NULL, NULL);
+        size_t rn = ano_simplify_with_attributes(out, gidx, ic, pv, N*N, sizeof(float)*8, &pv[3],
+                                                 sizeof(float)*8, weights, 5, target, 0.05f, 0.0f, modes[m],
+                                                 NULL, NULL);
+        validate_indices(out, rn, N*N);
+        assert(rg <= target && ru <= target);
+        assert(rn > target && rn < ic);
+    }
+}
+
+// Throughput on million-triangle meshes, pass order against heap order, both through one reused
+// arena: a gently curved grid (error and count budgets both in play) and a noisy one (every collapse
+// costs, so the orders diverge most). Run with --bench; reports input triangles per second, where
+// each order lands, and the pass order's speedup over the heap order (the cook's reason to use it).
+static int bench_simplify(void) {
+    enum { N = 709 };  // 708 x 708 cells, ~1.0M triangles
+    const size_t vc = (size_t)N * N;
+    float* positions = malloc(vc * 3 * sizeof(float));
+    uint32_t* indices = malloc((size_t)(N-1) * (N-1) * 6 * sizeof(uint32_t));
+    uint32_t* out = malloc((size_t)(N-1) * (N-1) * 6 * sizeof(uint32_t));
+    if (!positions || !indices || !out) return 1;
+    size_t ic = build_grid(N, positions, indices);
+
+    ano_arena_t arena;
+    size_t need = ano_simplify_scratch_size(ic, vc, 0, 0u);
+    size_t needPass = ano_simplify_scratch_size(ic, vc, 0, ANO_SIMPLIFY_DETERMINISTIC);
+    if (ano_arena_init(&arena, needPass > need ? needPass : need) != 0) return 1;
+
+    printf("%-10s %-6s %7s %10s %10s %9s %10s\n", "mesh", "order", "guards", "tris in", "tris out", "ms", "Mtri/s");
+    const char* meshes[2] = { "curved", "noisy" };
+    uint32_t seed = 0x9E3779B9u;
+    for (int mesh = 0; mesh < 2; ++mesh) {
+        for (size_t i = 0; i < vc; ++i) {
+            float x = positions[i*3+0], y = positions[i*3+1];
+            positions[i*3+2] = 3.0f * sinf(x * 0.05f) * cosf(y * 0.07f);
+            if (mesh == 1) { seed = seed * 1664525u + 1013904223u; positions[i*3+2] += (float)(seed >> 8) * 0x1p-24f; }
+        }
+        for (int guards = 0; guards < 2; ++guards) {
+            uint64_t orderNs[2];
+            for (int order = 0; order < 2; ++order) {
+                uint32_t flags = order == 0 ? ANO_SIMPLIFY_DETERMINISTIC : 0u;
+                float factor = guards ? ANO_SIMPLIFY_EDGE_FACTOR_DEFAULT : 0.0f;
+                float err = 0.0f;
+                uint64_t t0 = bench_begin();
+                size_t r = ano_simplify_arena(out, indices, ic, positions, vc, sizeof(float)*3, (ic / 10 / 3) * 3,
+                                              0.01f, factor, flags, &arena, &err);
+                uint64_t ns = orderNs[order] = ano_ticks_to_ns(bench_end(t0));
+                printf("%-10s %-6s %7s %10zu %10zu %9.1f %10.2f   err %.4f\n", meshes[mesh],
+                       order == 0 ? "pass" : "heap", guards ? "on" : "off", ic / 3, r / 3, (double)ns / 1e6,
+                       bench_ops_per_sec(ic / 3, ns) / 1e6, err);
+            }
+            printf("%-10s pass order %.2fx heap order\n", meshes[mesh],
+                   (double)orderNs[1] / (double)(orderNs[0] ? orderNs[0] : 1));
+        }
+    }
+    ano_arena_destroy(&arena);
+    free(positions); free(indices); free(out);
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0)
+        return bench_simplify();
+
     test_meshlet_bounds_calculation();
     test_degenerate_triangles();
     test_meshlet_limits();
@@ -597,6 +891,9 @@ int main() {
     test_simplify_concave_trench();
     test_simplify_pillar_silhouette();
     test_simplify_tetra_link();
+    test_simplify_heap_order();
+    test_simplify_arena();
+    test_simplify_attributes();
     printf("All tests passed successfully!\n");
     return 0;
 }
@@ -0,0 +1,275 @@
+/* SPDX-FileCopyrightText: 2026 Anoptic Game Engine Authors
+ *
+ * SPDX-License-Identifier: LGPL-3.0 */
+/*  == Anoptic Game Engine v0.0000001 == */
+
+/* Coverage for anoptic_profiler.h:
+ *   - lifecycle: every entry point is a no-op before init and after cleanup, a second session works
+ *   - trace shape: a closed JSON array, nested scopes and a span on one track, the thread label
+ *   - balance: per track, every begin has its end, including under buffer overflow and thread churn
+ *   - accounting: recorded scopes + ano_profile_dropped == scopes opened
+ *   - cost: ns per event against the 10 ns budget, measured (optimized builds only)
+ * Traces land in the log directory, removed on pass. Exit 0 = pass. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "anoptic_filesystem.h"
+#include "anoptic_profiler.h"
+#include "anoptic_threads.h"
+#include "anoptic_time.h"
+
+static int failures = 0;
+#define CHECK(cond, msg) do { \
+    if (!(cond)) { printf("FAIL: %s (%s:%d)\n", (msg), __FILE__, __LINE__); failures++; } \
+} while (0)
+
+#define MAX_TID 256
+
+static char *slurp(const char *path)
+{
+    FILE *f = fopen(path, "rb");
+    if (f == NULL)
+        return NULL;
+    size_t cap = 1 << 16, len = 0;
+    char *buf = malloc(cap);
+    for (size_t got; buf != NULL && (got = fread(buf + len, 1, cap - len - 1, f)) > 0; ) {
+        len += got;
+        if (len + 1 == cap) {
+            char *nb = realloc(buf, cap *= 2);
+            if (nb == NULL) { free(buf); buf = NULL; }
+            buf = nb;
+        }
+    }
+    fclose(f);
+    if (buf != NULL)
+        buf[len] = '\0';
+    return buf;
+}
+
+typedef struct {
+    uint32_t b[MAX_TID], e[MAX_TID], x[MAX_TID];   // per track
+    uint32_t begins, ends, spans, labels, named;   // named: occurrences of the wanted name
+    bool     ordered;                              // ts never runs backwards within a track
+    bool     closed;                               // starts with "[", ends with "]"
+} trace_t;
+
+// Tally the trace one event per line. want counts lines mentioning that name.
+static bool trace_read(const char *path, const char *want, trace_t *t)
+{
+    memset(t, 0, sizeof *t);
+    t->ordered = true;
+    char *c = slurp(path);
+    if (c == NULL)
+        return false;
+    size_t n = strlen(c);
+    t->closed = n >= 3 && c[0] == '[' && strcmp(c + n - 2, "]\n") == 0;
+    double last[MAX_TID] = {0};
+    for (char *line = strtok(c, "\n"); line != NULL; line = strtok(NULL, "\n")) {
+        const char *tp = strstr(line, "\"tid\":");
+        unsigned tid = tp != NULL ? (unsigned)strtoul(tp + 6, NULL, 10) : 0;
+        if (tid >= MAX_TID)
+            tid = 0;
+        const char *ts = strstr(line, "\"ts\":");
+        double at = ts != NULL ? strtod(ts + 5, NULL) : 0.0;
+        if (want != NULL && strstr(line, want) != NULL)
+            t->named++;
+        if (strstr(line, "\"ph\":\"B\""))      { t->b[tid]++; t->begins++; }
+        else if (strstr(line, "\"ph\":\"E\"")) { t->e[tid]++; t->ends++; }
+        else if (strstr(line, "\"ph\":\"X\"")) { t->x[tid]++; t->spans++; }
+        else if (strstr(line, "thread_name"))   t->labels++;
+        if (ts != NULL && strstr(line, "\"ph\":\"X\"") == NULL) {
+            if (at < last[tid]) t->ordered = false;
+            last[tid] = at;
+        }
+    }
+    free(c);
+    return true;
+}
+
+static bool balanced(const trace_t *t)
+{
+    for (int i = 0; i < MAX_TID; i++)
+        if (t->b[i] != t->e[i]) return false;
+    return true;
+}
+
+static void test_preinit(void)
+{
+    ano_profile_begin("pre");
+    ano_profile_end();
+    ano_profile_end();
+    ano_profile_span("pre", ano_timestamp_ticks());
+    ano_profile_thread_name("pre");
+    CHECK(ano_profile_flush() == 0, "flush before init writes nothing");
+    CHECK(ano_profile_path() == NULL, "no path before init");
+    CHECK(ano_profile_cleanup() != 0, "cleanup before init refuses");
+}
+
+static void nested(int depth)
+{
+    ANO_PROFILE_SCOPE("nested");
+    if (depth > 1)
+        nested(depth - 1);
+}
+
+static void test_shape(void)
+{
+    CHECK(ano_profile_init() == 0, "init");
+    CHECK(ano_profile_init() != 0, "double init refuses");
+    char path[MAXPATH];
+    snprintf(path, sizeof path, "%s", ano_profile_path());
+    CHECK(strstr(path, "_trace.json") != NULL, "trace file name");
+
+    ano_profile_end();                  // stray end: ignored
+    ano_profile_thread_name("main test");
+    {
+        ANO_PROFILE_SCOPE("outer");
+        nested(5);
+        uint64_t t0 = ano_timestamp_ticks();
+        ano_sleep(100);
+        ano_profile_span("span", t0);
+    }
+    CHECK(ano_profile_flush() == 13, "six scopes and one span flushed");
+    CHECK(ano_profile_dropped() == 0, "nothing dropped");
+    CHECK(ano_profile_cleanup() == 0, "cleanup");
+    CHECK(ano_profile_path() == NULL, "no path after cleanup");
+
+    ano_profile_begin("post");          // after cleanup: a no-op on a stale lane
+    ano_profile_end();
+
+    trace_t t;
+    CHECK(trace_read(path, "\"nested\"", &t), "trace readable");
+    CHECK(t.closed, "trace is a closed JSON array");
+    CHECK(t.begins == 6 && t.ends == 6 && t.spans == 1, "event counts");
+    CHECK(t.named == 5, "nested names");
+    CHECK(t.labels == 1, "thread label written once");
+    CHECK(balanced(&t) && t.ordered, "one balanced, ordered track");
+    if (failures == 0)
+        remove(path);
+}
+
+#define CHURN_THREADS 8
+#define CHURN_SCOPES  20000u
+
+static void *churn_main(void *arg)
+{
+    (void)arg;
+    ano_profile_thread_name("churn");
+    for (uint32_t i = 0; i < CHURN_SCOPES; i++) {
+        ANO_PROFILE_SCOPE("work");
+    }
+    return NULL;
+}
+
+// Threads race the flusher and overflow their lanes. Two waves, so the second adopts the first's lanes.
+static void test_threads(void)
+{
+    CHECK(ano_profile_init() == 0, "init");
+    char path[MAXPATH];
+    snprintf(path, sizeof path, "%s", ano_profile_path());
+    for (int wave = 0; wave < 2; wave++) {
+        anothread_t th[CHURN_THREADS];
+        for (int i = 0; i < CHURN_THREADS; i++)
+            CHECK(ano_thread_create(&th[i], NULL, churn_main, NULL) == 0, "spawn");
+        for (int i = 0; i < CHURN_THREADS; i++)
+            ano_thread_join(th[i], NULL);
+        ano_profile_flush();
+    }
+    // A flood on this thread: far past one lane, so some of it drops unless the flusher keeps up.
+    for (uint32_t i = 0; i < 4u * CHURN_SCOPES; i++) {
+        ANO_PROFILE_SCOPE("flood");
+    }
+    uint64_t dropped = ano_profile_dropped();
+    CHECK(ano_profile_cleanup() == 0, "cleanup");
+    CHECK(ano_profile_dropped() == dropped, "dropped count survives cleanup");
+
+    trace_t t;
+    CHECK(trace_read(path, NULL, &t), "trace readable");
+    CHECK(t.closed, "trace is a closed JSON array");
+    CHECK(balanced(&t), "every track balanced");
+    CHECK(t.ordered, "every track ordered");
+    uint64_t opened = 2ull * CHURN_THREADS * CHURN_SCOPES + 4ull * CHURN_SCOPES;
+    CHECK(t.begins + dropped == opened, "recorded + dropped == opened");
+    printf("  threads: %u scopes recorded, %llu dropped, %u tracks labelled\n",
+           t.begins, (unsigned long long)dropped, t.labels);
+    if (failures == 0)
+        remove(path);
+}
+
+#define COST_PAIRS      10000u
+#define COST_REPS       20
+#define COST_BUDGET_NS  10.0     // per event, the profiler's contract
+
+// Timing is only gated in an optimized, uninstrumented build.
+#if defined(RELEASE_BUILD) && !defined(__SANITIZE_ADDRESS__) && !defined(__SANITIZE_THREAD__)
+#  define COST_GATED 1
+#  if defined(__has_feature)
+#    if __has_feature(address_sanitizer) || __has_feature(thread_sanitizer)
+#      undef COST_GATED
+#    endif
+#  endif
+#endif
+
+// ns per event, best of COST_REPS batches the lane never overflows, against the bare timebase read each
+// event pays. The profiler's own share is gated everywhere, the total wherever the clock read itself fits
+// the budget: a VM that traps rdtsc, or a host without an invariant TSC, cannot meet it by construction.
+static void test_cost(void)
+{
+    CHECK(ano_profile_init() == 0, "init");
+    char path[MAXPATH];
+    snprintf(path, sizeof path, "%s", ano_profile_path());
+    uint64_t best = UINT64_MAX, clockBest = UINT64_MAX;
+    for (int rep = 0; rep < COST_REPS; rep++) {
+        uint64_t t0 = ano_timestamp_raw();
+        for (uint32_t i = 0; i < COST_PAIRS; i++) {
+            ano_profile_begin("cost");
+            ano_profile_end();
+        }
+        uint64_t dt = ano_timestamp_raw() - t0;
+        if (dt < best) best = dt;
+        ano_profile_flush();
+
+        volatile uint64_t sink = 0;
+        uint64_t c0 = ano_timestamp_raw();
+        for (uint32_t i = 0; i < 2 * COST_PAIRS; i++)
+            sink += ano_timestamp_ticks();
+        uint64_t dc = ano_timestamp_raw() - c0;
+        if (dc < clockBest) clockBest = dc;
+    }
+    double event = (double)best / (2.0 * COST_PAIRS);
+    double clock = (double)clockBest / (2.0 * COST_PAIRS);
+    double own   = event > clock ? event - clock : 0.0;
+    printf("  cost: %.1f ns per event, %.1f ns of it the clock read, %.1f ns the profiler (budget %.0f ns)\n",
+           event, clock, own, COST_BUDGET_NS);
+    CHECK(ano_profile_dropped() == 0, "batched cost loop never drops");
+#ifdef COST_GATED
+    CHECK(own <= COST_BUDGET_NS, "profiler's own per-event cost within budget");
+    if (clock <= COST_BUDGET_NS / 2)
+        CHECK(event <= COST_BUDGET_NS, "per-event cost within budget");
+    else
+        printf("  cost: timebase read exceeds half the budget on this host, total not gated\n");
+#endif
+    ano_profile_cleanup();
+    remove(path);
+}
+
+int main(void)
+{
+    if (!ano_fs_chdir_gamepath()) {
+        fprintf(stderr, "chdir to gamepath failed\n");
+        return 1;
+    }
+    printf("anotest_profiler: scoped profiler, Chrome trace output\n");
+    test_preinit();
+    test_shape();
+    test_threads();
+    test_cost();
+    if (failures) {
+        printf("anotest_profiler: %d FAILURE(S)\n", failures);
+        return 1;
+    }
+    printf("anotest_profiler: all passed\n");
+    return 0;
+}
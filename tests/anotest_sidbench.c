@@ -22,7 +22,12 @@
  *
  * Bulk keying: the startup cost SID deletes. 20k distinct identifiers pushed through
  * anostr_intern (insert, then re-key warm), reported as ns/key and total ms; the SID column
- * of that table is zero by construction (ids are baked into .rodata at build).
+ * of that table is zero by construction (ids are baked into .rodata at build). Then the
+ * startup path without sids: the table saved once and mapped back (anostr_intern_map), and
+ * lookups through the mapped image.
+ *
+ * Contended interning: anostr_intern_mt against the single-mutator table from 1..8 threads (see
+ * contended_run below).
  *
  * Prints bench.h percentile tables. Built always, DISABLED in ctest; run by hand from a
  * Release (-O3) build (build 7). argv[1] scales the event count. */
@@ -31,8 +36,10 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "anoptic_filesystem.h"
 #include "anoptic_memory.h"
 #include "anoptic_strings.h"
+#include "anoptic_threads.h"
 #include "templates/bench.h"
 #include "templates/rng.h"
 
@@ -344,6 +351,138 @@ static int bulkreads_run(mi_heap_t *heap, uint32_t lookups)
     return 0;
 }
 
+/* Contended interning: N threads each intern a random stream over 50k distinct asset names.
+ *   cold   -- a fresh table, so the early stream inserts while the other threads probe and insert.
+ *             anostr_intern_mt from N threads against the single-mutator table fed the whole N-thread
+ *             stream by one thread. That table's heap is bound to one thread, so funnelling is the
+ *             only way to share it, and one thread with no lock is the ceiling of any such funnel.
+ *   warm   -- every name already present, so anostr_intern only probes. Here the single-mutator table
+ *             is legal from N threads at once (no mutation), so both run on all N.
+ * Throughput is the whole stream over the wall time from a start barrier to the last join.
+ * Oracle: both tables are prefilled in the same order for warm, so the symbol sums must match; cold
+ * must end with exactly the distinct names drawn, each round-tripping. argv[3] scales the per-thread
+ * stream. */
+
+#define CI_NAMES       50000u
+#define CI_OPS_DEFAULT 500000u
+#define CI_MAXT        8u
+
+typedef struct {
+    anostr_intern_mt_t  *mt;          // NULL: the single-mutator table
+    anostr_intern_t     *st;
+    const anostr_t      *names;
+    const uint32_t      *stream;
+    uint32_t             ops;
+    anothread_barrier_t *go;
+    uint64_t             acc;
+} ci_job_t;
+
+static void *ci_thread(void *arg)
+{
+    ci_job_t *j = arg;
+    uint64_t acc = 0;
+    ano_thread_barrier_wait(j->go);
+    if (j->mt != NULL)
+        for (uint32_t i = 0; i < j->ops; i++)
+            acc += anostr_intern_mt(j->mt, j->names[j->stream[i]]);
+    else
+        for (uint32_t i = 0; i < j->ops; i++)
+            acc += anostr_intern(j->st, j->names[j->stream[i]]);
+    j->acc = acc;
+    return NULL;
+}
+
+// threads jobs over consecutive slices of stream. Returns elapsed ns, symbol sum in *acc.
+static uint64_t ci_point(anostr_intern_mt_t *mt, anostr_intern_t *st, const anostr_t *names,
+                         const uint32_t *stream, uint32_t threads, uint32_t ops, uint64_t *acc)
+{
+    ci_job_t            jobs[CI_MAXT];
+    anothread_t         th[CI_MAXT];
+    anothread_barrier_t go;
+    ano_thread_barrier_init(&go, NULL, threads + 1u);
+    for (uint32_t i = 0; i < threads; i++) {
+        jobs[i] = (ci_job_t){ mt, st, names, stream + (size_t)i * ops, ops, &go, 0 };
+        ano_thread_create(&th[i], NULL, ci_thread, &jobs[i]);
+    }
+    ano_thread_barrier_wait(&go);
+    uint64_t t0 = bench_begin();
+    *acc = 0;
+    for (uint32_t i = 0; i < threads; i++) {
+        ano_thread_join(th[i], NULL);
+        *acc += jobs[i].acc;
+    }
+    uint64_t ns = ano_ticks_to_ns(bench_end(t0));
+    ano_thread_barrier_destroy(&go);
+    return ns;
+}
+
+static int contended_run(mi_heap_t *heap, uint32_t ops)
+{
+    anostr_t *names  = mi_heap_malloc(heap, CI_NAMES * sizeof *names);
+    uint32_t *stream = mi_heap_malloc(heap, (size_t)CI_MAXT * ops * sizeof *stream);
+    bool     *drawn  = mi_heap_zalloc(heap, CI_NAMES);
+    if (!names || !stream || !drawn) { printf("alloc failed\n"); return 1; }
+    char nameBuf[64];
+    for (uint32_t i = 0; i < CI_NAMES; i++) {
+        int n = snprintf(nameBuf, sizeof nameBuf, "assets/textures/terrain_%05u_albedo.ktx2", i);
+        names[i] = anostr_from(heap, nameBuf, (size_t)n);
+    }
+    test_rng rng = rng_make(0xC0FFEE11u);
+    for (size_t i = 0; i < (size_t)CI_MAXT * ops; i++)
+        stream[i] = rng_below(&rng, CI_NAMES);
+
+    // Warm tables, filled in name order so both map name i to symbol i.
+    anostr_intern_t    *stWarm = anostr_intern_make(heap);
+    anostr_intern_mt_t *mtWarm = anostr_intern_mt_make(0);
+    if (!stWarm || !mtWarm) { printf("intern table failed\n"); return 1; }
+    for (uint32_t i = 0; i < CI_NAMES; i++)
+        if (anostr_intern(stWarm, names[i]) != i || anostr_intern_mt(mtWarm, names[i]) != i) {
+            printf("intern order broke\n");
+            return 1;
+        }
+
+    printf("\nanotest_sidbench contended intern: %u names, %u interns per thread, Mops/s over all "
+           "threads\n\n", CI_NAMES, ops);
+    printf("  threads    cold: mt   cold: 1-thread st    warm: mt   warm: st\n");
+    for (uint32_t threads = 1; threads <= CI_MAXT; threads *= 2) {
+        uint64_t total = (uint64_t)threads * ops, accMt, accSt, accCold, accFunnel;
+
+        anostr_intern_mt_t *mtCold = anostr_intern_mt_make(0);
+        anostr_intern_t    *stCold = anostr_intern_make(heap);
+        if (!mtCold || !stCold) { printf("intern table failed\n"); return 1; }
+        uint64_t nsCold   = ci_point(mtCold, NULL, names, stream, threads, ops, &accCold);
+        uint64_t nsFunnel = ci_point(NULL, stCold, names, stream, 1u, (uint32_t)total, &accFunnel);
+        uint64_t nsMt     = ci_point(mtWarm, NULL, names, stream, threads, ops, &accMt);
+        uint64_t nsSt     = ci_point(NULL, stWarm, names, stream, threads, ops, &accSt);
+
+        size_t distinct = 0;
+        memset(drawn, 0, CI_NAMES);
+        for (uint64_t i = 0; i < total; i++) {
+            distinct += !drawn[stream[i]];
+            drawn[stream[i]] = true;
+        }
+        bool ok = accMt == accSt && anostr_intern_mt_count(mtCold) == distinct
+                  && anostr_intern_count(stCold) == distinct;
+        for (uint32_t i = 0; ok && i < CI_NAMES; i++)
+            if (drawn[i])
+                ok = anostr_eq(anostr_sym_str_mt(mtCold, anostr_intern_mt_find(mtCold, names[i])),
+                               names[i]);
+        anostr_intern_mt_destroy(mtCold);
+        if (!ok) {
+            printf("ORACLE FAILED: contended intern at %u threads\n", threads);
+            return 1;
+        }
+        g_sink = accCold + accFunnel;
+        printf("  %7u  %10.2f  %18.2f  %10.2f  %9.2f\n", threads,
+               bench_ops_per_sec(total, nsCold) / 1e6, bench_ops_per_sec(total, nsFunnel) / 1e6,
+               bench_ops_per_sec(total, nsMt) / 1e6, bench_ops_per_sec(total, nsSt) / 1e6);
+    }
+    anostr_intern_mt_destroy(mtWarm);
+    printf("note: cold st is one thread carrying every thread's stream, the ceiling of any lock\n"
+           "      around the single-mutator table. Scaling needs as many cores as threads.\n");
+    return 0;
+}
+
 int main(int argc, char **argv)
 {
     uint32_t events = EVENTS_DEFAULT;
@@ -431,9 +570,37 @@ int main(int argc, char **argv)
            bench_ops_per_sec(BULK_KEYS, rekeyNs));
     printf("  comptime ANOSTR_SID:          0.00 ms total,    0.0 ns/key (baked at build)\n");
 
+    // Snapshot: the same table saved once, then mapped the way the next boot would (the file
+    // is still in the page cache here, as it is on every boot after the first).
+    char imagePath[MAXPATH + 32];
+    snprintf(imagePath, sizeof imagePath, "%s/anotest_sidbench_intern.bin", ano_fs_gamepath().str);
+    if (anostr_intern_save(bulkTable, imagePath) != 0) { printf("intern save failed\n"); return 1; }
+    t0 = bench_begin();
+    anostr_intern_t *mapped = anostr_intern_map(heap, imagePath);
+    uint64_t mapNs = ano_ticks_to_ns(bench_end(t0));
+    if (mapped == NULL) { remove(imagePath); printf("intern map failed\n"); return 1; }
+    t0 = bench_begin();
+    acc = 0;
+    for (uint32_t i = 0; i < BULK_KEYS; i++)
+        acc += anostr_intern_find(mapped, bulk[i]);
+    uint64_t mappedNs = ano_ticks_to_ns(bench_end(t0));
+    if (acc != g_sink) { remove(imagePath); printf("ORACLE FAILED: mapped symbols differ\n"); return 1; }
+    printf("  snapshot map (boot):      %8.2f ms total, %6.1f ns/key, %10.0f keys/s\n",
+           (double)mapNs / 1e6, (double)mapNs / BULK_KEYS, bench_ops_per_sec(BULK_KEYS, mapNs));
+    printf("  mapped re-key (find):     %8.2f ms total, %6.1f ns/key, %10.0f keys/s\n",
+           (double)mappedNs / 1e6, (double)mappedNs / BULK_KEYS,
+           bench_ops_per_sec(BULK_KEYS, mappedNs));
+    anostr_intern_unmap(mapped);
+    remove(imagePath);
+
     // Bulk reads: 50k records resolved four ways. argv[2] scales the lookup count.
     uint32_t lookups = LOOKUPS_DEFAULT;
     if (argc > 2) lookups = (uint32_t)strtoul(argv[2], NULL, 10);
     if (bulkreads_run(heap, lookups) != 0) return 1;
+
+    // Contended interning. argv[3] scales the per-thread stream.
+    uint32_t ciOps = CI_OPS_DEFAULT;
+    if (argc > 3) ciOps = (uint32_t)strtoul(argv[3], NULL, 10);
+    if (contended_run(heap, ciOps) != 0) return 1;
     return 0;
 }
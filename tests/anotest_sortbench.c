@@ -12,12 +12,17 @@
  *   - anostr_sort        : prefix keys + radix + tie resolution, keys rebuilt per call
  *   - anostr_sort presrt : the already-sorted early-out (re-click on a sorted list)
  *   - anostr_sort_idx    : permutation only, inventory structs never move
- *   - sym_sort warm      : interned symbols, cached keys -- zero string bytes read
+ *   - sym_sort warm      : interned symbols, kept keys -- no collation table walks
+ *   - sym strings        : the same symbol set through anostr_sort, keys rebuilt per call
  *   - qsort bytes        : anostr_compare byte order, the meaningless-order floor
- * plus one-shot rows (sym_sort cold = cache build) and a throughput section for
- * anostr_collate_prefix, anostr_collate_key, replace_all, cull, and rune_sort.
+ * plus one-shot rows (sym_sort cold = key build, intern with eager keys, collate vs
+ * sym_collate on adjacent pairs) and a throughput section for anostr_collate_prefix,
+ * anostr_collate_key, replace_all, cull, and rune_sort.
+ * Then the anostr_sort_mt scaling curve over 1M and 10M catalog names: serial, crews
+ * of 2 threads up to the core count (at least 4), and the job pool.
  *
- * Deterministic (fixed seeds). argv[1] overrides the item count (default 6000).
+ * Deterministic (fixed seeds). argv[1] overrides the item count (default 6000), argv[2]
+ * caps the curve's set size (default 10M, 0 skips it), argv[3] its thread count.
  * Built always so it cannot rot; DISABLED in ctest -- run by hand from a -O3 build
  * (build.bat 8 / build.sh 8). Prints a table, exits 0 (1 only if results are WRONG:
  * every timed sort is verified against the streaming comparator's order once). */
@@ -26,8 +31,10 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "anoptic_jobs.h"
 #include "anoptic_memory.h"
 #include "anoptic_strings_utf.h"
+#include "anoptic_threads.h"
 #include "templates/bench.h"
 #include "templates/rng.h"
 
@@ -120,6 +127,80 @@ static int verify_sorted(const anostr_t *v, size_t n, const char *what)
     return 0;
 }
 
+// Scaling curve for the _mt sorts: a catalog-sized set of mostly distinct names (the inventory
+// generator plus a serial number). One row per crew size, then the job pool; best of CURVE_REPS
+// each. Every row's output must equal the serial sort's, string for string.
+enum { CURVE_REPS = 3 };
+
+static int curve_row(const char *label, uint32_t threads, anostr_t *work, const anostr_t *items,
+                     const anostr_t *ref, size_t n, uint64_t serialNs, test_rng *rng)
+{
+    uint64_t best = UINT64_MAX;
+    for (int r = 0; r < CURVE_REPS; r++) {
+        memcpy(work, items, n * sizeof *work);
+        shuffle_items(work, n, rng);
+        uint64_t t0 = bench_begin();
+        anostr_sort_mt(work, n, threads);
+        uint64_t ns = ano_ticks_to_ns(bench_end(t0));
+        best = ns < best ? ns : best;
+    }
+    printf("  %-9s %9.1f %8.2fx %12.2f\n", label, (double)best / 1e6,
+           serialNs ? (double)serialNs / (double)best : 1.0, bench_ops_per_sec(n, best) / 1e6);
+    for (size_t k = 0; k < n; k++) {
+        if (!anostr_eq(work[k], ref[k])) {  // duplicates are separate copies: compare bytes
+            printf("WRONG RESULT: anostr_sort_mt (%s) differs from anostr_sort at %zu\n", label, k);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int scaling_curve(size_t n, uint32_t maxThreads)
+{
+    mi_heap_t *heap LOCALHEAPATTR = mi_heap_new();
+    anostr_t *items = heap ? mi_heap_malloc(heap, n * sizeof *items) : NULL;
+    anostr_t *work  = heap ? mi_heap_malloc(heap, n * sizeof *work) : NULL;
+    anostr_t *ref   = heap ? mi_heap_malloc(heap, n * sizeof *ref) : NULL;
+    if (items == NULL || work == NULL || ref == NULL) {
+        printf("\nscaling, %zu names: no memory, skipped\n", n);
+        return 0;
+    }
+    test_rng rng = rng_make(0xCA7A1067u);
+    for (size_t k = 0; k < n; k++) {
+        anostr_t base = make_name(heap, &rng);
+        char buf[128];
+        int len = snprintf(buf, sizeof buf, "%.*s %u", anostr_fmt(base), rng_below(&rng, (uint32_t)n));
+        items[k] = anostr_from(heap, buf, (size_t)len);
+    }
+
+    printf("\nanostr_sort_mt scaling, %zu names, best of %d:\n", n, CURVE_REPS);
+    printf("  threads          ms   speedup  M strings/s\n");
+    uint64_t serialNs = UINT64_MAX;
+    for (int r = 0; r < CURVE_REPS; r++) {
+        memcpy(ref, items, n * sizeof *ref);
+        shuffle_items(ref, n, &rng);
+        uint64_t t0 = bench_begin();
+        anostr_sort(ref, n);
+        uint64_t ns = ano_ticks_to_ns(bench_end(t0));
+        serialNs = ns < serialNs ? ns : serialNs;
+    }
+    printf("  %-9s %9.1f %8.2fx %12.2f\n", "serial", (double)serialNs / 1e6, 1.0,
+           bench_ops_per_sec(n, serialNs) / 1e6);
+
+    int wrong = 0;
+    char label[16];
+    for (uint32_t t = 2; t <= maxThreads; t = t < 4 ? t + 1 : t + t / 2) {
+        snprintf(label, sizeof label, "crew %u", t);
+        wrong += curve_row(label, t, work, items, ref, n, serialNs, &rng);
+    }
+    if (ano_jobs_init(0, false) == 0) {
+        snprintf(label, sizeof label, "pool %u", ano_jobs_worker_count() + 1u);
+        wrong += curve_row(label, 0, work, items, ref, n, serialNs, &rng);
+        ano_jobs_cleanup();
+    }
+    return wrong;
+}
+
 int main(int argc, char **argv)
 {
     size_t count = 6000;
@@ -238,6 +319,21 @@ int main(int argc, char **argv)
     s = bench_lat_stats(&lat);
     bench_lat_row("anostr_sym_sort (warm)", s);
 
+    // The same symbol set without kept keys: its strings through anostr_sort, prefixes and
+    // tie-run keys rebuilt from the collation tables every call.
+    bench_lat_init(&lat, ticks, REPS);
+    for (int r = 0; r < REPS; r++) {
+        shuffle_syms(syms, count, &rng);
+        for (size_t k = 0; k < count; k++)
+            work[k] = anostr_sym_str(tbl, syms[k]);
+        uint64_t t1 = bench_begin();
+        anostr_sort(work, count);
+        bench_lat_add(&lat, bench_end(t1));
+    }
+    wrong += verify_sorted(work, count, "sym strings");
+    s = bench_lat_stats(&lat);
+    bench_lat_row("sym strings, no kept keys", s);
+
     // Byte-order floor: what a sort costs when the order means nothing to a human.
     bench_lat_init(&lat, ticks, REPS);
     for (int r = 0; r < REPS; r++) {
@@ -253,6 +349,38 @@ int main(int argc, char **argv)
     printf("\nanostr_sym_sort (cold, builds key cache): %llu ns once\n",
            (unsigned long long)coldNs);
 
+    // Eager keys move that build to intern time: the per-new-symbol cost it adds there.
+    anostr_intern_t *plain = anostr_intern_make(heap);
+    anostr_intern_t *eager = anostr_intern_make(heap);
+    if (plain == NULL || eager == NULL || anostr_intern_eager_keys(eager) != 0) {
+        printf("FAIL: intern alloc\n");
+        return 1;
+    }
+    t0 = bench_begin();
+    for (size_t k = 0; k < count; k++)
+        (void)anostr_intern(plain, items[k]);
+    uint64_t plainNs = ano_ticks_to_ns(bench_end(t0));
+    t0 = bench_begin();
+    for (size_t k = 0; k < count; k++)
+        (void)anostr_intern(eager, items[k]);
+    uint64_t eagerNs = ano_ticks_to_ns(bench_end(t0));
+    size_t fresh = anostr_intern_count(eager);
+    printf("intern:         %.0f ns/new symbol plain, %.0f with eager keys\n",
+           (double)plainNs / (double)fresh, (double)eagerNs / (double)fresh);
+
+    int csink = 0;
+    t0 = bench_begin();
+    for (size_t k = 1; k < count; k++)
+        csink += anostr_collate(anostr_sym_str(tbl, syms[k - 1]), anostr_sym_str(tbl, syms[k]));
+    uint64_t streamNs = ano_ticks_to_ns(bench_end(t0));
+    t0 = bench_begin();
+    for (size_t k = 1; k < count; k++)
+        csink += anostr_sym_collate(tbl, syms[k - 1], syms[k]);
+    uint64_t keptNs = ano_ticks_to_ns(bench_end(t0));
+    printf("collate pairs:  %.0f ns streaming, %.0f ns on kept keys%s\n",
+           (double)streamNs / (double)(count - 1), (double)keptNs / (double)(count - 1),
+           csink == 42 ? "!" : "");
+
     // Throughput: the per-string primitives and the transforms.
     t0 = bench_begin();
     uint64_t sink = 0;
@@ -294,5 +422,13 @@ int main(int argc, char **argv)
     ns = ano_ticks_to_ns(bench_end(t0));
     printf("rune_sort:      %.0f ns/string\n", (double)ns / (double)count);
 
+    // The _mt scaling curve at 1M and 10M names, up to argv[2] names and argv[3] threads.
+    size_t curveMax = argc > 2 ? strtoul(argv[2], NULL, 10) : 10000000u;
+    uint32_t maxThreads = argc > 3 ? (uint32_t)strtoul(argv[3], NULL, 10) : ano_thread_core_count();
+    if (maxThreads < 4)
+        maxThreads = 4;
+    for (size_t n = 1000000u; n <= curveMax; n *= 10u)
+        wrong += scaling_curve(n, maxThreads);
+
     return wrong == 0 ? 0 : 1;
 }
@@ -18,18 +18,25 @@
  *     semantics for long pieces;
  *   - intern/dedupe: symbol stability across variants and allocations, find-without-insert,
  *     sym_str round-trip, bit-identical dedupe, growth past the initial slot table;
+ *   - intern snapshots: save/map round-trip keeps every symbol, new interns continue in the
+ *     overlay, a mapped table saves again with keys intact, damaged and missing files refused;
+ *   - concurrent intern: the same contract single-threaded, then threads interning overlapping
+ *     name sets at once -- one symbol per name across threads, dense symbols, round-trips;
  *   - ANOSTR_SID / ANOSTR_SID32: published FNV-1a vectors as static_asserts, ICE contexts
  *     (case label, enum, static initializer, array size), runtime-twin agreement with
  *     anostr_hash/anostr_hash32 (embedded NUL and the 128-byte cap included);
  *   - a randomized round-trip soak (fixed seed; argv[1] scales iterations).
  * Exit 0 == pass; failures print what broke. */
 
+#include <stdatomic.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#include "anoptic_filesystem.h"
 #include "anoptic_memory.h"
-#include "anoptic_strings.h"
+#include "anoptic_strings_utf.h"
+#include "anoptic_threads.h"
 #include "templates/rng.h"
 
 static int failures = 0;
@@ -353,6 +360,248 @@ static void test_intern(mi_heap_t *heap)
     CHECK(anostr_intern_find(t, anostr_lit("hull")) == a, "early symbol survives growth");
 }
 
+// Snapshot round-trip: a mapped table answers exactly like the saved one, takes new symbols in
+// its overlay, saves again with both tiers, and refuses files it cannot trust.
+static int image_name(char *buf, size_t cap, int i)
+{
+    switch (i % 4) {
+    case 0:  return snprintf(buf, cap, "n%d", i);                                   // inline
+    case 1:  return snprintf(buf, cap, "assets/props/entity_%05d.gltf", i);         // long
+    case 2:  return snprintf(buf, cap, "\xC3\x89p\xC3\xA9""e de Gu\xC3\xA9rin %d", i);
+    default: return snprintf(buf, cap, "%d", i * 7919);
+    }
+}
+
+static bool image_file_write(const char *path, const void *bytes, size_t len)
+{
+    FILE *f = fopen(path, "wb");
+    if (f == NULL)
+        return false;
+    bool ok = fwrite(bytes, 1, len, f) == len;
+    return fclose(f) == 0 && ok;
+}
+
+static void test_intern_image(mi_heap_t *heap)
+{
+    ano_fspath base = ano_fs_gamepath();
+    char path[MAXPATH + 32], path2[MAXPATH + 32], bad[MAXPATH + 32];
+    snprintf(path, sizeof path, "%s/anotest_strings_image.bin", base.str);
+    snprintf(path2, sizeof path2, "%s/anotest_strings_image2.bin", base.str);
+    snprintf(bad, sizeof bad, "%s/anotest_strings_image_bad.bin", base.str);
+
+    enum { SAVED = 500, LATER = 300 };
+    char nameBuf[64];
+    anostr_intern_t *t = anostr_intern_make(heap);
+    CHECK(t != NULL, "image: source table");
+    if (t == NULL)
+        return;
+    CHECK(anostr_intern(t, anostr_empty()) == 0, "the empty string is a symbol too");
+    for (int i = 1; i < SAVED; i++) {
+        int n = image_name(nameBuf, sizeof nameBuf, i);
+        CHECK(anostr_intern(t, anostr_view(nameBuf, (size_t)n)) == (anostr_sym)i, "dense source symbols");
+    }
+    CHECK(anostr_intern_save(t, path) == 0, "save");
+    CHECK(anostr_intern_save(NULL, path) == -1 && anostr_intern_save(t, NULL) == -1, "save refuses NULL");
+
+    anostr_intern_t *m = anostr_intern_map(heap, path);
+    CHECK(m != NULL, "map the saved table");
+    if (m == NULL)
+        return;
+    CHECK(anostr_intern_count(m) == SAVED, "mapped count");
+    bool same = true;
+    for (int i = 0; i < SAVED; i++) {
+        anostr_t want = anostr_sym_str(t, (anostr_sym)i);
+        anostr_t got = anostr_sym_str(m, (anostr_sym)i);
+        same = same && anostr_eq(want, got) && anostr_intern_find(m, want) == (anostr_sym)i;
+        if (anostr_len(got) > ANOSTR_INLINE_CAP)
+            same = same && got.ptr != want.ptr;     // read from the file, not the source heap
+    }
+    CHECK(same, "every saved symbol maps to the same number and string");
+
+    // Overlay: new strings continue the numbering, saved ones keep theirs.
+    for (int i = SAVED; i < SAVED + LATER; i++) {
+        int n = image_name(nameBuf, sizeof nameBuf, i);
+        CHECK(anostr_intern(m, anostr_from(heap, nameBuf, (size_t)n)) == (anostr_sym)i,
+              "overlay symbols continue after the image");
+    }
+    int n = image_name(nameBuf, sizeof nameBuf, 1);
+    anostr_t d1 = anostr_dedupe(m, anostr_from(heap, nameBuf, (size_t)n));
+    anostr_t d2 = anostr_dedupe(m, anostr_view(nameBuf, (size_t)n));
+    CHECK(memcmp(&d1, &d2, sizeof d1) == 0 && anostr_intern_count(m) == SAVED + LATER,
+          "dedupe of an image string is bit-identical and inserts nothing");
+    CHECK(anostr_intern_find(m, anostr_lit("never interned")) == ANOSTR_SYM_NONE, "find misses");
+
+    // Both tiers save into one image, keys included.
+    CHECK(anostr_intern_save(m, path2) == 0, "save a mapped table");
+    anostr_intern_t *m2 = anostr_intern_map(heap, path2);
+    CHECK(m2 != NULL && anostr_intern_count(m2) == SAVED + LATER, "map the two-tier save");
+    if (m2 != NULL) {
+        same = true;
+        for (anostr_sym sym = 0; sym < SAVED + LATER; sym++) {
+            anostr_t s = anostr_sym_str(m, sym);
+            same = same && anostr_eq(anostr_sym_str(m2, sym), s) && anostr_intern_find(m2, s) == sym &&
+                   anostr_eq(anostr_sym_collate_key(m2, sym), anostr_collate_key(heap, s));
+        }
+        CHECK(same, "symbols and collation keys survive a second round-trip");
+    }
+
+    // Damaged files: truncated, wrong magic, an offset past the bytes. All refused.
+    size_t size = 0;
+    const uint8_t *raw = ano_fs_map_read(path, &size);
+    uint8_t *copy = raw != NULL ? mi_heap_malloc(heap, size) : NULL;
+    CHECK(copy != NULL, "read the image back");
+    if (copy != NULL) {
+        memcpy(copy, raw, size);
+        CHECK(image_file_write(bad, copy, size - 1) && anostr_intern_map(heap, bad) == NULL,
+              "truncated image refused");
+        copy[0] ^= 0xFF;
+        CHECK(image_file_write(bad, copy, size) && anostr_intern_map(heap, bad) == NULL,
+              "wrong magic refused");
+        copy[0] ^= 0xFF;
+        uint32_t count, slotMask;
+        memcpy(&count, copy + 12, 4);
+        memcpy(&slotMask, copy + 16, 4);
+        size_t strStart = 64 + (size_t)count * 8 + ((size_t)slotMask + 1) * 4;
+        uint32_t past = UINT32_MAX;
+        memcpy(copy + strStart + 4, &past, 4);
+        CHECK(image_file_write(bad, copy, size) && anostr_intern_map(heap, bad) == NULL,
+              "out-of-bounds offset refused");
+        ano_fs_unmap(raw, size);
+    }
+    remove(bad);
+    CHECK(anostr_intern_map(heap, bad) == NULL, "missing file refused");
+
+    anostr_intern_unmap(m2);
+    anostr_intern_unmap(m);
+    anostr_intern_unmap(t);     // plain table: no-op
+    remove(path);
+    remove(path2);
+}
+
+#define MT_THREADS 4
+#define MT_NAMES   6000     // per thread; neighbours overlap by half
+
+typedef struct {
+    anostr_intern_mt_t *table;
+    int                 first;      // names first .. first + MT_NAMES - 1
+    anostr_sym          syms[MT_NAMES];
+    bool                ok;
+} mt_job_t;
+
+static int mt_name(char *buf, size_t cap, int i)
+{
+    return snprintf(buf, cap, "assets/meshes/prop_%05d.anomesh", i);
+}
+
+static void *intern_mt_thread(void *arg)
+{
+    mt_job_t *j = arg;
+    char nameBuf[48];
+    j->ok = true;
+    for (int pass = 0; pass < 2; pass++) {      // insert, then hit the lock-free path
+        for (int i = 0; i < MT_NAMES; i++) {
+            int n = mt_name(nameBuf, sizeof nameBuf, j->first + i);
+            anostr_sym sym = anostr_intern_mt(j->table, anostr_view(nameBuf, (size_t)n));
+            if (sym == ANOSTR_SYM_NONE || (pass == 1 && sym != j->syms[i]))
+                j->ok = false;
+            j->syms[i] = sym;
+            anostr_t back = anostr_sym_str_mt(j->table, sym);
+            if (!str_equals_mem(back, nameBuf, (size_t)n))
+                j->ok = false;
+        }
+    }
+    return NULL;
+}
+
+typedef struct {
+    anostr_intern_mt_t *table;
+    atomic_bool         stop;
+    bool                ok;
+} mt_reader_t;
+
+// Looks up the newest symbols while the writers are still claiming them: each must read back empty
+// or as the string that finds it, never torn.
+static void *intern_mt_reader(void *arg)
+{
+    mt_reader_t *r = arg;
+    r->ok = true;
+    while (!atomic_load_explicit(&r->stop, memory_order_relaxed)) {
+        anostr_sym n = (anostr_sym)anostr_intern_mt_count(r->table);
+        for (anostr_sym s = n > 8 ? n - 8 : 0; s < n + 8; s++) {
+            anostr_t back = anostr_sym_str_mt(r->table, s);
+            if (!anostr_is_empty(back) && anostr_intern_mt_find(r->table, back) != s)
+                r->ok = false;
+        }
+    }
+    return NULL;
+}
+
+static void test_intern_mt(mi_heap_t *heap)
+{
+    anostr_intern_mt_t *t = anostr_intern_mt_make(0);
+    CHECK(t != NULL, "concurrent intern table created");
+    if (t == NULL)
+        return;
+
+    // The single-mutator contract, unchanged.
+    anostr_sym a = anostr_intern_mt(t, anostr_lit("hull"));
+    CHECK(a == 0, "first symbol is 0");
+    CHECK(anostr_intern_mt(t, anostr_from(heap, "hull", 4)) == a, "equal strings share one symbol");
+    const char *lp = "vulkan_backend/instance/pipelines/flat";
+    anostr_sym d = anostr_intern_mt(t, anostr_from(heap, lp, strlen(lp)));
+    CHECK(d == 1 && anostr_intern_mt(t, anostr_view(lp, strlen(lp))) == d, "long strings dedupe");
+    CHECK(anostr_intern_mt_find(t, anostr_lit("nope")) == ANOSTR_SYM_NONE, "find never inserts");
+    CHECK(anostr_intern_mt_count(t) == 2, "two distinct strings");
+    CHECK(anostr_is_empty(anostr_sym_str_mt(t, ANOSTR_SYM_NONE)), "sym_str on NONE is empty");
+    anostr_t d1 = anostr_dedupe_mt(t, anostr_from(heap, lp, strlen(lp)));
+    anostr_t d2 = anostr_dedupe_mt(t, anostr_view(lp, strlen(lp)));
+    CHECK(memcmp(&d1, &d2, sizeof(anostr_t)) == 0, "deduped values are bit-identical");
+    CHECK(anostr_sym_str_mt(t, d).ptr != lp, "canonical bytes are the table's own copy");
+
+    // Threads racing on overlapping names, each slot table growing under the readers.
+    static mt_job_t jobs[MT_THREADS];
+    anothread_t th[MT_THREADS], rth;
+    static mt_reader_t reader;
+    reader.table = t;
+    atomic_init(&reader.stop, false);
+    ano_thread_create(&rth, NULL, intern_mt_reader, &reader);
+    for (int i = 0; i < MT_THREADS; i++) {
+        jobs[i] = (mt_job_t){ .table = t, .first = i * (MT_NAMES / 2) };
+        ano_thread_create(&th[i], NULL, intern_mt_thread, &jobs[i]);
+    }
+    bool ok = true;
+    for (int i = 0; i < MT_THREADS; i++) {
+        ano_thread_join(th[i], NULL);
+        ok &= jobs[i].ok;
+    }
+    atomic_store_explicit(&reader.stop, true, memory_order_relaxed);
+    ano_thread_join(rth, NULL);
+    CHECK(ok, "every thread's symbols stable and round-tripping");
+    CHECK(reader.ok, "symbols mid-insert read back empty, never torn");
+    bool agree = true;
+    for (int i = 0; i + 1 < MT_THREADS; i++)
+        for (int k = 0; k < MT_NAMES / 2; k++)
+            agree &= jobs[i].syms[MT_NAMES / 2 + k] == jobs[i + 1].syms[k];
+    CHECK(agree, "threads that interned the same name got the same symbol");
+    size_t distinct = 2 + (size_t)(MT_THREADS + 1) * (MT_NAMES / 2);
+    CHECK(anostr_intern_mt_count(t) == distinct, "one entry per distinct name");
+    bool *seen = calloc(distinct, 1);
+    bool dense = seen != NULL;
+    for (int i = 0; dense && i < MT_THREADS; i++)
+        for (int k = 0; k < MT_NAMES; k++) {
+            if (jobs[i].syms[k] < 2 || jobs[i].syms[k] >= distinct)
+                dense = false;
+            else
+                seen[jobs[i].syms[k]] = true;
+        }
+    for (size_t k = 2; dense && k < distinct; k++)
+        dense = seen[k];
+    free(seen);
+    CHECK(dense, "symbols dense across shards");
+    CHECK(anostr_intern_mt_find(t, anostr_lit("hull")) == a, "early symbol survives growth");
+    anostr_intern_mt_destroy(t);
+}
+
 // Published FNV-1a test vectors (Noll's reference set): the hash itself, at compile time.
 static_assert(ANOSTR_SID("") == UINT64_C(0xcbf29ce484222325), "SID: FNV-1a 64 offset basis");
 static_assert(ANOSTR_SID("a") == UINT64_C(0xaf63dc4c8601ec8c), "SID: FNV-1a 64 'a'");
@@ -468,6 +717,8 @@ int main(int argc, char **argv)
     test_find_concat_join(heap);
     test_split(heap);
     test_intern(heap);
+    test_intern_image(heap);
+    test_intern_mt(heap);
     test_sid();
 
     uint32_t iterations = 2000;
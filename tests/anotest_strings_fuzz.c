@@ -15,6 +15,9 @@
  * empty, embedded-NUL) is eq + hash-equal + compare/collate-identical and yields equal
  * results from find/replace/slice/split/sort. Each property names its oracle inline.
  *
+ * The SIMD tiers behind find/rune_count/utf8_valid are forced one by one and checked against the
+ * scalar tier on random and hand-placed input, so the scalar kernels stay the single oracle.
+ *
  * ANOSTR_SID/SID32 are a COMPILE-TIME hash cross-check on LITERAL inputs only, never an
  * operand of sort/split/etc. There is NO anostr_splice: "splice" here is anostr_slice +
  * anostr_concat checked against a naive byte oracle.
@@ -788,6 +791,101 @@ static void test_directed(mi_heap_t *h)
           "unpaired UTF-16 surrogate -> U+FFFD");
 }
 
+// ---------------------------------------------------------------------------------------------
+// SIMD tiers: every tier this CPU runs must match the scalar tier byte for byte.
+
+static const anostr_simd_t kTiers[] = { ANOSTR_SIMD_SSE2, ANOSTR_SIMD_AVX2, ANOSTR_SIMD_NEON };
+
+// find / rune_count / utf8_valid on one input, scalar first (checked against naive_find), then
+// under each other tier.
+static void tier_case(const char *buf, size_t n, const char *nd, size_t nn, size_t from, const char *what)
+{
+    anostr_t s = anostr_view(buf, n), needle = anostr_view(nd, nn);
+    anostr_simd_force(ANOSTR_SIMD_SCALAR);
+    size_t found = anostr_find(s, needle, from), runes = anostr_rune_count(s);
+    bool   valid = anostr_utf8_valid(s);
+    CHECK(found == naive_find(buf, n, nd, nn, from), what);
+    for (size_t t = 0; t < sizeof kTiers / sizeof kTiers[0]; t++) {
+        if (anostr_simd_force(kTiers[t]) != kTiers[t])
+            continue;
+        CHECK(anostr_find(s, needle, from) == found, what);
+        CHECK(anostr_rune_count(s) == runes, what);
+        CHECK(anostr_utf8_valid(s) == valid, what);
+    }
+}
+
+static void test_simd_tiers(mi_heap_t *h)
+{
+    anostr_simd_t best = anostr_simd();
+    CHECK(anostr_simd_force((anostr_simd_t)99) == best, "unknown tier leaves the active one");
+    CHECK(anostr_simd_force(ANOSTR_SIMD_SCALAR) == ANOSTR_SIMD_SCALAR, "scalar tier always available");
+
+    // Sequences placed at every offset across two 32-byte vectors, with 0..3 bytes after them:
+    // errors must be caught wherever they land, valid ones must pass wherever they straddle.
+    static const char *const seqs[] = {
+        "\xC0\x80", "\xC1\xBF", "\xE0\x80\x80", "\xE0\x9F\xBF", "\xF0\x80\x80\x80", "\xF0\x8F\xBF\xBF",
+        "\xED\xA0\x80", "\xED\xBF\xBF", "\xF4\x90\x80\x80", "\xF5\x80\x80\x80", "\xFF", "\x80",
+        "\xBF\xBF", "\xC3", "\xE2\x82", "\xF0\x9F\x98", "\xC3\xA9\xA9", "\xE2\x82\xAC\x80",
+        "\xC3\xA9", "\xE2\x82\xAC", "\xED\x9F\xBF", "\xEE\x80\x80", "\xEF\xBF\xBF", "\xF0\x9F\x98\x80",
+        "\xF4\x8F\xBF\xBF", "\xF0\x90\x80\x80",
+    };
+    char buf[96];
+    for (size_t q = 0; q < sizeof seqs / sizeof seqs[0]; q++) {
+        size_t sl = strlen(seqs[q]);
+        for (size_t at = 0; at <= 70; at++) {
+            for (size_t pad = 0; pad <= 3; pad++) {
+                memset(buf, 'a', at);
+                memcpy(buf + at, seqs[q], sl);
+                memset(buf + at + sl, 'b', pad);
+                tier_case(buf, at + sl + pad, "ab", 2, 0, "tiers: placed sequence");
+            }
+        }
+    }
+
+    // Random inputs up to a few hundred bytes: valid text, valid text with one byte broken or cut
+    // short, arbitrary bytes, and ASCII with one stray high byte. Needles are mostly taken from the
+    // haystack, so finds hit at every offset; from runs past the end too.
+    test_rng rng = rng_make(0x51D0C0DEu);
+    char hay[512];
+    for (uint32_t it = 0; it < 3000; it++) {
+        size_t n;
+        switch (it % 4u) {
+        case 0: case 1: {
+            anostr_t v = rng_str(&rng, h, 100);
+            n = anostr_len(v);
+            memcpy(hay, anostr_bytes(&v), n);
+            if (it % 4u == 1u && n > 0) {
+                if (rng_below(&rng, 2) == 0)
+                    hay[rng_below(&rng, (uint32_t)n)] = (char)rng_next(&rng);
+                else
+                    n = rng_below(&rng, (uint32_t)n);
+            }
+            break;
+        }
+        case 2:
+            n = rng_bytes(&rng, hay, 300);
+            break;
+        default:
+            n = rng_below(&rng, 301);
+            for (size_t k = 0; k < n; k++) hay[k] = (char)('a' + rng_below(&rng, 3));
+            if (n > 0) hay[rng_below(&rng, (uint32_t)n)] = (char)(0x80 | rng_next(&rng));
+            break;
+        }
+        char nd[40];
+        size_t nn = 2 + rng_below(&rng, 38);
+        if (n >= nn && rng_below(&rng, 4) != 0) {
+            memcpy(nd, hay + rng_below(&rng, (uint32_t)(n - nn + 1)), nn);
+        } else {
+            nn = 2 + rng_below(&rng, 3);
+            for (size_t k = 0; k < nn; k++) nd[k] = (char)('a' + rng_below(&rng, 3));
+        }
+        size_t from = rng_below(&rng, (uint32_t)n + 2);
+        tier_case(hay, n, nd, nn, from, "tiers: random input");
+    }
+
+    CHECK(anostr_simd_force(best) == best, "best tier restored");
+}
+
 // ---------------------------------------------------------------------------------------------
 // The randomized property soak. Per-iteration scratch heap keeps memory bounded.
 
@@ -942,6 +1040,7 @@ int main(int argc, char **argv)
     test_sym_sort(heap);
     test_tie_family(heap);
     test_directed(heap);
+    test_simd_tiers(heap);
 
     uint32_t iterations = 200;
     if (argc > 1) iterations = (uint32_t)strtoul(argv[1], NULL, 10);
@@ -0,0 +1,338 @@
+/* SPDX-FileCopyrightText: 2026 Anoptic Game Engine Authors
+ *
+ * SPDX-License-Identifier: LGPL-3.0 */
+/*  == Anoptic Game Engine v0.0000001 == */
+
+/* Coverage for anoptic_strings_rope.h:
+ *   - the empty rope: zero length, one line, line/rune lookups at the edges, NULL args;
+ *   - a randomized edit soak against a flat byte-buffer model: inserts (copied and
+ *     borrowed, ASCII / 2-, 3-, 4-byte runes / newlines) and deletes at random offsets,
+ *     offsets inside runes snapping back to the rune start; after every step the length,
+ *     rune and line counts, the chunk walk, rune_offset, line_offset, rune_next and
+ *     slice all agree with the model;
+ *   - typing: a run of one-byte inserts at the end coalesces into few pieces, and
+ *     deleting behind the cursor then typing on still matches;
+ *   - big inserts split into pieces at rune starts (every chunk valid UTF-8);
+ *   - zero copy: insert_ref slices point into the caller's bytes, single-piece slices
+ *     borrow, cross-piece slices copy once;
+ *   - log trimming: appending past many blocks while deleting the head keeps content right.
+ * Run under ASan for the block and node lifetimes. argv[1] scales the soak.
+ * Exit 0 == pass; failures print what broke. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "anoptic_memory.h"
+#include "anoptic_strings_rope.h"
+#include "templates/rng.h"
+
+static int failures = 0;
+#define CHECK(cond, msg) do { \
+    if (!(cond)) { printf("FAIL: %s (%s:%d)\n", (msg), __FILE__, __LINE__); failures++; } \
+} while (0)
+
+// The model: one flat buffer, edited the slow way.
+
+typedef struct {
+    char  *bytes;
+    size_t len, cap;
+} model_t;
+
+static bool is_cont(char c) { return ((uint8_t)c & 0xC0u) == 0x80u; }
+
+static size_t model_snap(const model_t *m, size_t pos)
+{
+    for (int back = 0; back < 3 && pos > 0 && pos < m->len && is_cont(m->bytes[pos]); back++)
+        pos--;
+    return pos;
+}
+
+static void model_insert(model_t *m, size_t at, const char *s, size_t n)
+{
+    if (m->len + n > m->cap) {
+        m->cap = (m->len + n) * 2u;
+        m->bytes = realloc(m->bytes, m->cap);
+    }
+    memmove(m->bytes + at + n, m->bytes + at, m->len - at);
+    memcpy(m->bytes + at, s, n);
+    m->len += n;
+}
+
+static void model_delete(model_t *m, size_t from, size_t to)
+{
+    memmove(m->bytes + from, m->bytes + to, m->len - to);
+    m->len -= to - from;
+}
+
+static size_t model_runes(const model_t *m)
+{
+    size_t runes = 0;
+    for (size_t i = 0; i < m->len; i++)
+        runes += !is_cont(m->bytes[i]);
+    return runes;
+}
+
+// Random UTF-8 text: ASCII, newlines, and 2/3/4-byte runes. Returns the byte length.
+static size_t random_text(test_rng *rng, char *buf, size_t maxRunes)
+{
+    static const char *const runes[] = {
+        "a", "Z", " ", "\n", "\xC3\xA9", "\xD0\x96", "\xE3\x81\x82", "\xE1\x9A\xA0",
+        "\xF0\x9F\x99\x82",
+    };
+    size_t n = 0, count = 1u + rng_below(rng, (uint32_t)maxRunes);
+    for (size_t i = 0; i < count; i++) {
+        const char *r = runes[rng_below(rng, sizeof runes / sizeof *runes)];
+        size_t k = strlen(r);
+        memcpy(buf + n, r, k);
+        n += k;
+    }
+    return n;
+}
+
+// Everything the rope reports, against the model.
+static bool rope_matches(const anostr_rope_t *r, const model_t *m, test_rng *rng, mi_heap_t *heap)
+{
+    bool ok = anostr_rope_len(r) == m->len && anostr_rope_runes(r) == model_runes(m);
+    size_t lines = 1;
+    for (size_t i = 0; i < m->len; i++)
+        lines += m->bytes[i] == '\n';
+    ok &= anostr_rope_lines(r) == lines;
+
+    size_t at = 0;
+    anostr_rope_iter_t it = anostr_rope_chunks(r, 0, anostr_rope_len(r));
+    for (anostr_t c; anostr_rope_next_chunk(&it, &c); at += c.len)
+        ok &= c.len > 0 && at + c.len <= m->len && memcmp(anostr_bytes(&c), m->bytes + at, c.len) == 0;
+    ok &= at == m->len;
+
+    for (int probe = 0; probe < 8; probe++) {
+        size_t runes = anostr_rope_runes(r);
+        size_t want = rng_below(rng, (uint32_t)runes + 2u), off = 0;
+        for (size_t seen = 0; off < m->len; off++)
+            if (!is_cont(m->bytes[off]) && seen++ == want)
+                break;
+        ok &= anostr_rope_rune_offset(r, want) == off;
+
+        size_t line = rng_below(rng, (uint32_t)lines + 1u), start = line == 0 ? 0 : ANOSTR_NPOS;
+        for (size_t i = 0, nl = 0; line > 0 && i < m->len; i++)
+            if (m->bytes[i] == '\n' && ++nl == line) {
+                start = i + 1;
+                break;
+            }
+        ok &= anostr_rope_line_offset(r, line) == start;
+
+        if (m->len > 0) {
+            size_t i = model_snap(m, rng_below(rng, (uint32_t)m->len)), j = i;
+            anorune_t got = anostr_rope_rune_next(r, &i);
+            anorune_t want_rune = anostr_rune_next(anostr_view(m->bytes, m->len), &j);
+            ok &= got == want_rune && i == j;
+
+            size_t from = rng_below(rng, (uint32_t)m->len + 1u);
+            size_t to = from + rng_below(rng, (uint32_t)(m->len - from) + 1u);
+            anostr_t s = anostr_rope_slice(heap, r, from, to);
+            ok &= s.len == to - from && memcmp(anostr_bytes(&s), m->bytes + from, s.len) == 0;
+        }
+    }
+    return ok;
+}
+
+static void test_empty(mi_heap_t *heap)
+{
+    anostr_rope_t *r = anostr_rope_make(heap);
+    CHECK(r != NULL, "make");
+    CHECK(anostr_rope_make(NULL) == NULL, "NULL heap rejected");
+    CHECK(anostr_rope_len(r) == 0 && anostr_rope_runes(r) == 0 && anostr_rope_lines(r) == 1,
+          "empty rope: zero bytes and runes, one line");
+    CHECK(anostr_rope_line_offset(r, 0) == 0 && anostr_rope_line_offset(r, 1) == ANOSTR_NPOS,
+          "empty rope: line 0 at 0, line 1 absent");
+    CHECK(anostr_rope_rune_offset(r, 0) == 0 && anostr_rope_rune_offset(r, 5) == 0,
+          "empty rope: rune offsets clamp to the length");
+    size_t i = 3;
+    CHECK(anostr_rope_rune_next(r, &i) == ANORUNE_REPLACEMENT && i == 0,
+          "rune_next past the end: U+FFFD, clamped");
+    CHECK(anostr_len(anostr_rope_slice(heap, r, 0, 10)) == 0, "empty slice");
+    anostr_rope_iter_t it = anostr_rope_chunks(r, 0, 10);
+    anostr_t c;
+    CHECK(!anostr_rope_next_chunk(&it, &c), "no chunks");
+    CHECK(anostr_rope_delete(r, 0, 10) == 0 && anostr_rope_insert(r, 7, anostr_empty()) == 0,
+          "no-op edits succeed");
+    CHECK(anostr_rope_insert(NULL, 0, anostr_lit("x")) == -1 && anostr_rope_delete(NULL, 0, 1) == -1,
+          "NULL rope rejected");
+    CHECK(anostr_rope_len(NULL) == 0 && anostr_rope_lines(NULL) == 1, "NULL rope reads as empty");
+
+    CHECK(anostr_rope_append(r, anostr_lit("ab\ncd\n")) == 0, "append");
+    CHECK(anostr_rope_lines(r) == 3 && anostr_rope_line_offset(r, 1) == 3
+              && anostr_rope_line_offset(r, 2) == 6 && anostr_rope_line_offset(r, 3) == ANOSTR_NPOS,
+          "a trailing newline starts an empty last line");
+    anostr_rope_destroy(r);
+    anostr_rope_destroy(NULL);
+}
+
+static void test_soak(mi_heap_t *heap, uint32_t steps)
+{
+    test_rng rng = rng_make(0x5EEDu);
+    static char borrowed[1u << 16];     // insert_ref sources: must outlive the rope
+    size_t borrowedAt = 0;
+    model_t m = {0};
+    anostr_rope_t *r = anostr_rope_make(heap);
+    char buf[4096 * 4];
+    bool ok = true;
+    for (uint32_t step = 0; step < steps && ok; step++) {
+        uint32_t op = rng_below(&rng, 10);
+        size_t at = model_snap(&m, rng_below(&rng, (uint32_t)m.len + 1u));
+        if (op < 5) {
+            size_t n = random_text(&rng, buf, rng_below(&rng, 32) == 0 ? 4096 : 12);
+            ok &= anostr_rope_insert(r, at, anostr_view(buf, n)) == 0;
+            model_insert(&m, at, buf, n);
+        } else if (op < 7 && borrowedAt + sizeof buf <= sizeof borrowed) {
+            size_t n = random_text(&rng, borrowed + borrowedAt, 200);
+            ok &= anostr_rope_insert_ref(r, at, anostr_view(borrowed + borrowedAt, n)) == 0;
+            model_insert(&m, at, borrowed + borrowedAt, n);
+            borrowedAt += n;
+        } else {
+            size_t from = rng_below(&rng, (uint32_t)m.len + 1u);
+            size_t to = from + rng_below(&rng, 64);
+            to = model_snap(&m, to < m.len ? to : m.len);
+            from = model_snap(&m, from < to ? from : to);
+            ok &= anostr_rope_delete(r, from, to) == 0;
+            model_delete(&m, from, to);
+        }
+        // Offsets inside a rune snap back, like the model.
+        size_t mid = 0;
+        while (mid < m.len && !is_cont(m.bytes[mid]))
+            mid++;
+        if (mid < m.len && rng_below(&rng, 4) == 0) {
+            ok &= anostr_rope_insert(r, mid, anostr_lit("|")) == 0;
+            model_insert(&m, model_snap(&m, mid), "|", 1);
+        }
+        ok &= rope_matches(r, &m, &rng, heap);
+    }
+    CHECK(ok, "randomized edits match the flat model");
+    anostr_rope_destroy(r);
+    free(m.bytes);
+}
+
+static size_t chunk_count(const anostr_rope_t *r)
+{
+    size_t n = 0;
+    anostr_rope_iter_t it = anostr_rope_chunks(r, 0, anostr_rope_len(r));
+    for (anostr_t c; anostr_rope_next_chunk(&it, &c); )
+        n++;
+    return n;
+}
+
+static void test_typing(mi_heap_t *heap)
+{
+    test_rng rng = rng_make(7);
+    model_t m = {0};
+    anostr_rope_t *r = anostr_rope_make(heap);
+    CHECK(anostr_rope_insert(r, 0, anostr_lit("header line\nfooter line\n")) == 0, "seed text");
+    model_insert(&m, 0, "header line\nfooter line\n", 24);
+
+    size_t cursor = 12;
+    for (int k = 0; k < 5000; k++) {
+        char c = (k % 60 == 59) ? '\n' : rng_printable(&rng);
+        CHECK(anostr_rope_insert(r, cursor, anostr_view(&c, 1)) == 0, "keystroke");
+        model_insert(&m, cursor, &c, 1);
+        cursor++;
+    }
+    CHECK(chunk_count(r) <= 5000 / 2048 + 4, "typing coalesces into a handful of pieces");
+    CHECK(rope_matches(r, &m, &rng, heap), "typed text matches");
+
+    // Backspace then keep typing: the old tail is gone, typing starts a fresh piece.
+    CHECK(anostr_rope_delete(r, cursor - 3, cursor) == 0, "backspace x3");
+    model_delete(&m, cursor - 3, cursor);
+    cursor -= 3;
+    for (int k = 0; k < 100; k++) {
+        CHECK(anostr_rope_insert(r, cursor, anostr_lit("\xC3\xA9")) == 0, "multi-byte keystroke");
+        model_insert(&m, cursor, "\xC3\xA9", 2);
+        cursor += 2;
+    }
+    CHECK(rope_matches(r, &m, &rng, heap), "backspace + retype matches");
+    anostr_rope_destroy(r);
+    free(m.bytes);
+}
+
+static void test_big_insert(mi_heap_t *heap)
+{
+    size_t n = 3 * 10007;     // 3-byte runes: piece cuts land mid-rune unless backed off
+    char *text = malloc(n);
+    for (size_t i = 0; i < n; i += 3)
+        memcpy(text + i, "\xE3\x81\x82", 3);
+    anostr_rope_t *r = anostr_rope_make(heap);
+    CHECK(anostr_rope_insert(r, 0, anostr_view(text, n)) == 0, "big insert");
+    CHECK(anostr_rope_insert(r, n / 2, anostr_view(text, n)) == 0, "big insert in the middle");
+    bool valid = true;
+    anostr_rope_iter_t it = anostr_rope_chunks(r, 0, anostr_rope_len(r));
+    for (anostr_t c; anostr_rope_next_chunk(&it, &c); )
+        valid &= anostr_utf8_valid(c);
+    CHECK(valid, "pieces split at rune starts");
+    CHECK(chunk_count(r) > 2, "big inserts split into pieces");
+    CHECK(anostr_rope_runes(r) == 2 * 10007, "rune count");
+    CHECK(anostr_rope_rune_offset(r, 12345) == 3u * 12345u, "rune offset across pieces");
+    anostr_rope_destroy(r);
+    free(text);
+}
+
+static void test_zero_copy(mi_heap_t *heap)
+{
+    static const char doc[] = "The quick brown fox jumps over the lazy dog, twice over.";
+    size_t n = sizeof doc - 1;
+    anostr_rope_t *r = anostr_rope_make(heap);
+    CHECK(anostr_rope_insert_ref(r, 0, anostr_view(doc, n)) == 0, "insert_ref");
+    anostr_t s = anostr_rope_slice(heap, r, 4, 40);
+    CHECK(anostr_bytes(&s) == doc + 4, "a single-piece slice borrows the caller's bytes");
+    anostr_rope_iter_t it = anostr_rope_chunks(r, 10, 30);
+    anostr_t c;
+    CHECK(anostr_rope_next_chunk(&it, &c) && anostr_bytes(&c) == doc + 10 && c.len == 20,
+          "chunks borrow too");
+
+    CHECK(anostr_rope_insert(r, 20, anostr_lit("[inserted]")) == 0, "copied insert");
+    s = anostr_rope_slice(heap, r, 0, anostr_rope_len(r));
+    CHECK(s.len == n + 10 && memcmp(anostr_bytes(&s), "The quick brown fox [inserted]jumps", 35) == 0,
+          "a cross-piece slice copies once");
+    s = anostr_rope_slice(heap, r, 30, 50);
+    CHECK(anostr_bytes(&s) == doc + 20, "the piece after a split still borrows");
+    anostr_rope_destroy(r);
+}
+
+static void test_log_trim(mi_heap_t *heap)
+{
+    anostr_rope_t *r = anostr_rope_make(heap);
+    char line[64];
+    size_t first = 0, last = 0;     // line numbers kept: [first, last)
+    for (int round = 0; round < 40000; round++) {
+        int n = snprintf(line, sizeof line, "log line %zu: some payload text\n", last++);
+        CHECK(anostr_rope_append(r, anostr_view(line, (size_t)n)) == 0, "append");
+        if (anostr_rope_lines(r) > 2001) {     // keep 2000 lines: drop the oldest
+            CHECK(anostr_rope_delete(r, 0, anostr_rope_line_offset(r, 1)) == 0, "trim head");
+            first++;
+        }
+    }
+    CHECK(anostr_rope_lines(r) == 2001, "window holds 2000 lines");
+    anostr_t head = anostr_rope_slice(heap, r, 0, anostr_rope_line_offset(r, 1));
+    int n = snprintf(line, sizeof line, "log line %zu: some payload text\n", first);
+    CHECK(anostr_len(head) == (size_t)n && memcmp(anostr_bytes(&head), line, (size_t)n) == 0,
+          "the oldest kept line is the right one");
+    anostr_rope_destroy(r);
+}
+
+int main(int argc, char **argv)
+{
+    mi_heap_t *heap LOCALHEAPATTR = mi_heap_new();
+    if (heap == NULL) { printf("FAIL: mi_heap_new\n"); return 1; }
+
+    uint32_t steps = 1500;
+    if (argc > 1) steps = (uint32_t)strtoul(argv[1], NULL, 10);
+
+    test_empty(heap);
+    test_soak(heap, steps);
+    test_typing(heap);
+    test_big_insert(heap);
+    test_zero_copy(heap);
+    test_log_trim(heap);
+
+    if (failures == 0) { printf("anotest_strings_rope: all checks passed\n"); return 0; }
+    printf("anotest_strings_rope: %d check(s) failed\n", failures);
+    return 1;
+}
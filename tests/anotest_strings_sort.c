@@ -17,8 +17,14 @@
  *     elementwise; order is a valid permutation; equal strings keep input order
  *     (stability, observed through sort_idx); the presorted early-out returns the
  *     same result; a large "Potion of ..." tie family forces the bulk-key tie path;
+ *   - anostr_sort_mt / anostr_sort_idx_mt: identical to the serial sorts on 150k
+ *     strings, on crews of 1/2/3/7 threads and on the job pool, presorted input,
+ *     one key-equal run spanning every lane;
  *   - anostr_sym_sort: matches the oracle cold (cache build) and warm (pure cached
  *     keys), out-of-range symbols sort first as the empty string;
+ *   - kept keys: anostr_sym_collate_key equals anostr_collate_key for every symbol,
+ *     lazy and eager tables alike, never moves as the table grows; anostr_sym_collate
+ *     agrees with anostr_collate; sym_sort over a tie family matches the oracle;
  *   - anostr_replace_all: grow/shrink/same-size, non-overlapping matches, UTF-8
  *     needles, no-match returns the same backing without allocation, empty-needle
  *     identity, results shrinking to inline, randomized against a naive rebuild;
@@ -35,6 +41,7 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "anoptic_jobs.h"
 #include "anoptic_memory.h"
 #include "anoptic_strings_utf.h"
 #include "templates/rng.h"
@@ -377,6 +384,89 @@ static void test_tie_family(mi_heap_t *heap)
     check_against_oracle(items, N, "tie family", heap);
 }
 
+// The _mt sorts against the serial ones, element for element: crew sizes that split unevenly, the
+// job pool, presorted input, and one key-equal run spanning every lane (cuts snap to run starts).
+static bool sort_mt_matches(const anostr_t *items, size_t n, uint32_t threads, mi_heap_t *heap)
+{
+    anostr_t *ref = mi_heap_malloc(heap, n * sizeof *ref);
+    anostr_t *mine = mi_heap_malloc(heap, n * sizeof *mine);
+    uint32_t *refOrder = mi_heap_malloc(heap, n * sizeof *refOrder);
+    uint32_t *order = mi_heap_malloc(heap, n * sizeof *order);
+    if (ref == NULL || mine == NULL || refOrder == NULL || order == NULL)
+        return false;
+    memcpy(ref, items, n * sizeof *ref);
+    memcpy(mine, items, n * sizeof *mine);
+    anostr_sort(ref, n);
+    anostr_sort_mt(mine, n, threads);
+    anostr_sort_idx(items, n, refOrder);
+    anostr_sort_idx_mt(items, n, order, threads);
+    bool ok = memcmp(ref, mine, n * sizeof *ref) == 0 && memcmp(refOrder, order, n * sizeof *order) == 0;
+    anostr_sort_mt(mine, n, threads);     // presorted: the early-out leaves it as is
+    ok = ok && memcmp(ref, mine, n * sizeof *ref) == 0;
+    mi_free(ref);
+    mi_free(mine);
+    mi_free(refOrder);
+    mi_free(order);
+    return ok;
+}
+
+static void test_sort_mt(mi_heap_t *heap)
+{
+    enum { N = 150000 };
+    anostr_t *items = mi_heap_malloc(heap, N * sizeof *items);
+    anostr_t *family = mi_heap_malloc(heap, N * sizeof *family);
+    if (items == NULL || family == NULL) {
+        printf("FAIL: sort_mt scratch alloc\n");
+        failures++;
+        return;
+    }
+    // Short random strings (plenty of duplicates), tie families, and corpus entries.
+    test_rng rng = rng_make(0x5011D5EEu);
+    for (size_t k = 0; k < N; k++) {
+        switch (rng_below(&rng, 4)) {
+        case 0: {
+            char name[24];
+            int len = snprintf(name, sizeof name, "Potion of %c%c", 'A' + (char)rng_below(&rng, 26),
+                               'a' + (char)rng_below(&rng, 26));
+            items[k] = anostr_from(heap, name, (size_t)len);
+            break;
+        }
+        case 1:
+            items[k] = corpus[rng_below(&rng, CORPUS_N)];
+            break;
+        default:
+            items[k] = rng_str(&rng, heap, 6);
+            break;
+        }
+    }
+    // One prefix key across the whole set, so a single run covers every lane.
+    for (size_t k = 0; k < N; k++) {
+        char name[24];
+        int len = snprintf(name, sizeof name, "Potion of %u", rng_below(&rng, 5000));
+        family[k] = anostr_from(heap, name, (size_t)len);
+    }
+
+    static const uint32_t crews[] = { 1, 2, 3, 7 };
+    for (size_t c = 0; c < sizeof crews / sizeof crews[0]; c++) {
+        CHECK(sort_mt_matches(items, N, crews[c], heap), "sort_mt crew matches the serial sort");
+        CHECK(sort_mt_matches(family, N, crews[c], heap), "sort_mt one run across lanes");
+    }
+    CHECK(sort_mt_matches(items, N, 0, heap), "sort_mt, pool stopped: serial");
+    CHECK(ano_jobs_init(3, false) == 0, "jobs init");
+    CHECK(sort_mt_matches(items, N, 0, heap), "sort_mt on the job pool");
+    CHECK(sort_mt_matches(family, N, 0, heap), "sort_mt on the job pool, one run");
+    ano_jobs_cleanup();
+
+    // Small sets take the serial path.
+    anostr_t small[CORPUS_N];
+    memcpy(small, corpus, sizeof small);
+    CHECK(sort_mt_matches(small, CORPUS_N, 4, heap), "sort_mt below the threshold");
+    anostr_sort_mt(NULL, 5, 4);
+    anostr_sort_idx_mt(small, 3, NULL, 4);
+    mi_free(items);
+    mi_free(family);
+}
+
 static void test_sym_sort(mi_heap_t *heap)
 {
     anostr_intern_t *t = anostr_intern_make(heap);
@@ -425,6 +515,93 @@ static void test_sym_sort(mi_heap_t *heap)
     CHECK(trio[1] == mid && trio[2] == late, "apple then zzz");
 }
 
+// Kept full keys: byte-identical to anostr_collate_key whether built lazily or on intern,
+// stable once handed out, and enough on their own to order symbols (sym_collate, sym_sort).
+static bool sym_keys_match(anostr_intern_t *t, mi_heap_t *heap, const char *what)
+{
+    for (anostr_sym sym = 0; sym < anostr_intern_count(t); sym++) {
+        anostr_t kept = anostr_sym_collate_key(t, sym);
+        anostr_t ref = anostr_collate_key(heap, anostr_sym_str(t, sym));
+        if (!anostr_eq(kept, ref)) {
+            printf("FAIL: %s: kept key of \"%.*s\" differs from anostr_collate_key\n",
+                   what, anostr_fmt(anostr_sym_str(t, sym)));
+            failures++;
+            return false;
+        }
+    }
+    return true;
+}
+
+static void test_sym_keys(mi_heap_t *heap)
+{
+    anostr_intern_t *lazy = anostr_intern_make(heap);
+    anostr_intern_t *eager = anostr_intern_make(heap);
+    CHECK(lazy != NULL && eager != NULL, "intern tables");
+    if (lazy == NULL || eager == NULL)
+        return;
+    CHECK(anostr_intern_eager_keys(eager) == 0, "eager keys on an empty table");
+
+    // Corpus, random multi-script strings, and a "Potion of ..." family whose shared prefix key
+    // makes one big run for the kept-key tie path.
+    enum { N = 600 };
+    anostr_sym syms[N];
+    test_rng rng = rng_make(0xC0DEC0DEu);
+    for (size_t k = 0; k < N; k++) {
+        anostr_t s;
+        char name[32];
+        if (k < CORPUS_N) {
+            s = corpus[k];
+        } else if (k % 3 == 0) {
+            snprintf(name, sizeof name, "Potion of %c%c", 'A' + (char)rng_below(&rng, 26),
+                     'a' + (char)rng_below(&rng, 26));
+            s = anostr_from_cstr(heap, name);
+        } else {
+            s = rng_str(&rng, heap, 12);
+        }
+        syms[k] = anostr_intern(lazy, s);
+        CHECK(anostr_intern(eager, s) == syms[k], "both tables assign the same symbols");
+    }
+    anostr_t first = anostr_sym_collate_key(lazy, 0);
+    sym_keys_match(lazy, heap, "lazy");
+    sym_keys_match(eager, heap, "eager");
+
+    // Keys outlive later growth.
+    for (size_t k = 0; k < 200; k++)
+        (void)anostr_intern(lazy, rng_str(&rng, heap, 8));
+    anostr_t again = anostr_sym_collate_key(lazy, 0);
+    CHECK(anostr_eq(first, again) && (first.len <= ANOSTR_INLINE_CAP || first.ptr == again.ptr),
+          "a kept key never moves");
+    sym_keys_match(lazy, heap, "lazy after growth");
+
+    CHECK(anostr_eq(anostr_sym_collate_key(lazy, 0x7FFFFFFF),
+                    anostr_collate_key(heap, anostr_empty())),
+          "out-of-range symbols key as the empty string");
+    for (size_t a = 0; a < N; a += 7) {
+        for (size_t b = 0; b < N; b += 5) {
+            int want = sign(anostr_collate(anostr_sym_str(lazy, syms[a]), anostr_sym_str(lazy, syms[b])));
+            if (sign(anostr_sym_collate(lazy, syms[a], syms[b])) != want) {
+                printf("FAIL: sym_collate disagrees with collate at %zu/%zu\n", a, b);
+                failures++;
+                return;
+            }
+        }
+    }
+
+    // sym_sort on kept keys against the oracle, elementwise.
+    anostr_t ref[N];
+    for (size_t k = 0; k < N; k++)
+        ref[k] = anostr_sym_str(eager, syms[k]);
+    qsort(ref, N, sizeof ref[0], oracle_cmp);
+    anostr_sym_sort(eager, syms, N);
+    for (size_t k = 0; k < N; k++) {
+        if (!anostr_eq(anostr_sym_str(eager, syms[k]), ref[k])) {
+            printf("FAIL: sym_sort on kept keys diverges from the oracle at %zu\n", k);
+            failures++;
+            return;
+        }
+    }
+}
+
 static void test_replace_all(mi_heap_t *heap)
 {
     // Non-overlapping, left to right: "aaa" has ONE "aa" match.
@@ -656,7 +833,9 @@ int main(int argc, char **argv)
     test_mixed_scripts();
     test_sort_corpus(heap);
     test_tie_family(heap);
+    test_sort_mt(heap);
     test_sym_sort(heap);
+    test_sym_keys(heap);
     test_replace_all(heap);
     test_cull(heap);
     test_rune_sort(heap);
@@ -12,7 +12,12 @@
  *     delete-all-spaces, UTF-8 needle (é -> e), and the no-match identity (count
  *     pass only, zero allocation);
  *   cull whitespace+punct and the no-op clean-document case (scan only, no copy);
- *   rune_sort on a 4 KiB single string and per-item on short names.
+ *   rune_sort on a 4 KiB single string and per-item on short names;
+ *   the SIMD-tiered kernels (find miss and common first byte, utf8_valid, rune_count over the 4 MiB
+ *     document) once per tier this CPU runs, scalar first as the baseline;
+ *   the rope over a 10 MiB log: load by reference, per-edit latency for typing at a cursor,
+ *     keystrokes and deletes at random offsets, line and rune lookups, against the flat
+ *     baseline of rebuilding the whole string per keystroke.
  * Every timed result is sanity-checked (lengths, spot bytes), so the table cannot
  * quietly benchmark wrong behavior; a broken check exits nonzero.
  * Deterministic (fixed seeds). argv[1] scales reps. Built so it cannot rot, DISABLED
@@ -23,11 +28,12 @@
 #include <string.h>
 
 #include "anoptic_memory.h"
-#include "anoptic_strings_utf.h"
+#include "anoptic_strings_rope.h"
 #include "templates/bench.h"
 #include "templates/rng.h"
 
-enum { DOC_FIND = 4u << 20, DOC_REPL = 1u << 20, REPS_DEFAULT = 30 };
+enum { DOC_FIND = 4u << 20, DOC_REPL = 1u << 20, DOC_ROPE = 10u << 20, REPS_DEFAULT = 30,
+       ROPE_EDITS = 20000 };
 
 static int g_reps = REPS_DEFAULT;
 static int g_wrong = 0;
@@ -198,6 +204,69 @@ static size_t op_rune_sort_4k(mi_heap_t *h, const void *ctx)
     return out.len;
 }
 
+/* SIMD-tiered kernels over the 4 MiB doc; the tier is forced around each series. */
+
+static size_t op_utf8_valid(mi_heap_t *h, const void *ctx)
+{
+    (void)h; (void)ctx;
+    if (!anostr_utf8_valid(g_docFind)) WRONG("utf8_valid rejected a valid document");
+    return 1;
+}
+
+static size_t op_rune_count(mi_heap_t *h, const void *ctx)
+{
+    (void)h;
+    size_t n = anostr_rune_count(g_docFind);
+    if (n != *(const size_t *)ctx) WRONG("rune_count disagrees with the scalar tier");
+    return n;
+}
+
+/* Rope edits over the 10 MiB log. Each series times ROPE_EDITS single edits. */
+
+static anostr_t g_docRope;
+
+// The flat way: a keystroke rebuilds the whole string around the new byte.
+static size_t op_flat_keystroke(mi_heap_t *h, const void *ctx)
+{
+    (void)ctx;
+    size_t at = g_docRope.len / 2;
+    anostr_builder_t b = anostr_builder_make(h, (uint32_t)g_docRope.len + 1u);
+    anostr_builder_append_str(&b, anostr_slice(g_docRope, 0, at));
+    anostr_builder_append(&b, "x", 1);
+    anostr_builder_append_str(&b, anostr_slice(g_docRope, at, g_docRope.len));
+    anostr_t out = anostr_freeze(&b);
+    if (out.len != g_docRope.len + 1) WRONG("flat keystroke length");
+    return out.len;
+}
+
+typedef enum { EDIT_TYPE, EDIT_INSERT, EDIT_DELETE, EDIT_LINE, EDIT_RUNE } rope_edit_t;
+
+static void rope_series(const char *label, anostr_rope_t *r, rope_edit_t kind, test_rng *rng,
+                        uint64_t *ticks)
+{
+    bench_lat lat;
+    bench_lat_init(&lat, ticks, ROPE_EDITS);
+    size_t cursor = anostr_rope_len(r) / 3, sink = 0;
+    size_t lines = anostr_rope_lines(r), runes = anostr_rope_runes(r);
+    for (int k = 0; k < ROPE_EDITS; k++) {
+        size_t at = rng_below(rng, (uint32_t)anostr_rope_len(r));
+        size_t line = rng_below(rng, (uint32_t)lines), rune = rng_below(rng, (uint32_t)runes);
+        char c = (char)('a' + k % 26);
+        uint64_t t0 = bench_begin();
+        switch (kind) {
+        case EDIT_TYPE:   sink += (size_t)anostr_rope_insert(r, cursor++, anostr_view(&c, 1)); break;
+        case EDIT_INSERT: sink += (size_t)anostr_rope_insert(r, at, anostr_view(&c, 1)); break;
+        case EDIT_DELETE: sink += (size_t)anostr_rope_delete(r, at, at + 1); break;
+        case EDIT_LINE:   sink += anostr_rope_line_offset(r, line); break;
+        case EDIT_RUNE:   sink += anostr_rope_rune_offset(r, rune); break;
+        }
+        bench_lat_add(&lat, bench_end(t0));
+    }
+    bench_lat_row(label, bench_lat_stats(&lat));
+    if (sink == 1)
+        printf("!");
+}
+
 int main(int argc, char **argv)
 {
     if (argc > 1) {
@@ -264,6 +333,64 @@ int main(int argc, char **argv)
     printf("%-28s %.2f GB/s (scan only, same backing out)\n", "", gbps);
     run_series("rune_sort: 4 KiB mixed page", g_page4k.len, op_rune_sort_4k, NULL, ticks);
 
+    static const struct { anostr_simd_t tier; const char *name; } tiers[] = {
+        { ANOSTR_SIMD_SCALAR, "scalar" }, { ANOSTR_SIMD_SSE2, "sse2" },
+        { ANOSTR_SIMD_AVX2, "avx2" },     { ANOSTR_SIMD_NEON, "neon" },
+    };
+    anostr_simd_t best = anostr_simd();
+    anostr_simd_force(ANOSTR_SIMD_SCALAR);
+    size_t runes = anostr_rune_count(g_docFind);
+    for (size_t t = 0; t < sizeof tiers / sizeof tiers[0]; t++) {
+        if (anostr_simd_force(tiers[t].tier) != tiers[t].tier)
+            continue;
+        char label[40];
+        printf("\n");
+        snprintf(label, sizeof label, "%s: find miss", tiers[t].name);
+        gbps = run_series(label, g_docFind.len, op_find_miss, NULL, ticks);
+        printf("%-28s %.2f GB/s\n", "", gbps);
+        snprintf(label, sizeof label, "%s: find common first", tiers[t].name);
+        gbps = run_series(label, g_docFind.len, op_find_common_first, NULL, ticks);
+        printf("%-28s %.2f GB/s\n", "", gbps);
+        snprintf(label, sizeof label, "%s: utf8_valid", tiers[t].name);
+        gbps = run_series(label, g_docFind.len, op_utf8_valid, NULL, ticks);
+        printf("%-28s %.2f GB/s\n", "", gbps);
+        snprintf(label, sizeof label, "%s: rune_count", tiers[t].name);
+        gbps = run_series(label, g_docFind.len, op_rune_count, &runes, ticks);
+        printf("%-28s %.2f GB/s\n", "", gbps);
+    }
+    anostr_simd_force(best);
+
+    // The rope: a 10 MiB log loaded by reference, then edited one keystroke at a time.
+    {
+        anostr_builder_t b = anostr_builder_make(heap, DOC_ROPE + 128);
+        for (uint32_t line = 0; b.len < DOC_ROPE; line++) {
+            char stamp[32];
+            int n = snprintf(stamp, sizeof stamp, "[%08u] ", line);
+            anostr_builder_append(&b, stamp, (size_t)n);
+            anostr_builder_append_str(&b, make_doc(heap, 40 + rng_below(&rng, 80), &rng));
+            anostr_builder_append(&b, "\n", 1);
+        }
+        g_docRope = anostr_freeze(&b);
+    }
+    printf("\nrope over a %u MiB log, %d edits/series\n", DOC_ROPE >> 20, ROPE_EDITS);
+    bench_lat_header();
+    run_series("flat: keystroke (rebuild)", g_docRope.len, op_flat_keystroke, NULL, ticks);
+    {
+        uint64_t *editTicks = mi_heap_malloc(heap, ROPE_EDITS * sizeof *editTicks);
+        anostr_rope_t *r = anostr_rope_make(heap);
+        if (editTicks == NULL || r == NULL) { printf("FAIL: rope setup\n"); return 1; }
+        uint64_t t0 = bench_begin();
+        if (anostr_rope_insert_ref(r, 0, g_docRope) != 0) WRONG("rope load");
+        printf("%-28s %.1f us\n", "rope: load by reference", (double)ano_ticks_to_ns(bench_end(t0)) / 1e3);
+        rope_series("rope: typing at a cursor", r, EDIT_TYPE, &rng, editTicks);
+        rope_series("rope: keystroke, random pos", r, EDIT_INSERT, &rng, editTicks);
+        rope_series("rope: delete, random pos", r, EDIT_DELETE, &rng, editTicks);
+        rope_series("rope: line_offset", r, EDIT_LINE, &rng, editTicks);
+        rope_series("rope: rune_offset", r, EDIT_RUNE, &rng, editTicks);
+        if (anostr_rope_lines(r) < 2 || anostr_rope_len(r) < g_docRope.len) WRONG("rope after edits");
+        anostr_rope_destroy(r);
+    }
+
     if (g_wrong != 0) {
         printf("\n%d wrong result(s)\n", g_wrong);
         return 1;
@@ -8,8 +8,9 @@
  * stream-grammar decoder and the audit oracles, the CPU reference
  * rasterizer against FreeType ground truth (including the unclamped-peak oracle and
  * the ghost-pixel sweep), the shaper's golden layout and penOut continuation, the
- * multi-face Runic range bake, color/style runs, and the GPOS PairPos reader (a
- * synthetic table plus the Geist kern oracle).
+ * multi-face Runic range bake, color/style runs, shaping from a rope, and the GPOS
+ * PairPos reader (a synthetic table plus the Geist kern oracle), and bakes served from the
+ * derived-data cache (a scratch cache dir) matching a fresh bake bit for bit.
  * Requires the fonts staged next to the binary (tests/CMakeLists.txt).
  * Exit 0 == pass. Failures print what broke. */
 
@@ -22,6 +23,7 @@
 #include "anoptic_memory.h"
 #include "anoptic_text.h"
 #include "text/text_internal.h"
+#include "templates/scratch.h"
 
 static int failures = 0;
 #define CHECK(cond, msg) do { \
@@ -818,6 +820,63 @@ static void test_shaper_runs(const AnoFontBake *b)
     CHECK(w == 0.0f && h == 0.0f, "empty runs measure zero");
 }
 
+// Shaping straight from a rope: pieces cut inside kerning pairs and inside a UTF-8
+// sequence still give the flat shape's instances and pen, bit for bit.
+
+static bool same_instances(const AnoGlyphInstance *a, const AnoGlyphInstance *b, uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++)
+        if (a[i].origin[0] != b[i].origin[0] || a[i].origin[1] != b[i].origin[1]
+            || a[i].glyphID != b[i].glyphID || a[i].inv[0] != b[i].inv[0])
+            return false;
+    return true;
+}
+
+static void test_shaper_rope(const AnoFontBake *b, mi_heap_t *heap)
+{
+    const float S = 24.0f;
+    const float org[2] = { 10.0f, 40.0f };
+    const float white[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+    AnoGlyphInstance flat[64], roped[64];
+    float penA[2], penB[2];
+
+    // "AV LT" built out of order, so no two pieces coalesce: A | V L | T.
+    anostr_rope_t *r = anostr_rope_make(heap);
+    CHECK(anostr_rope_insert(r, 0, anostr_lit("T")) == 0 && anostr_rope_insert(r, 0, anostr_lit("A")) == 0
+              && anostr_rope_insert(r, 1, anostr_lit("V L")) == 0,
+          "rope pieces");
+    uint32_t n = ano_text_shape_lit(b, "AV LT", S, org, white, flat, 64, penA);
+    CHECK(ano_text_shape_rope(b, r, 0, anostr_rope_len(r), S, org, white, roped, 64, penB) == n
+              && same_instances(flat, roped, n) && penA[0] == penB[0] && penA[1] == penB[1],
+          "kerning bridges rope pieces");
+    anostr_rope_destroy(r);
+
+    // A rune split across pieces (borrowed lead byte, copied tail) and newlines.
+    static const char head[] = "Wave\nA\xC3";
+    r = anostr_rope_make(heap);
+    CHECK(anostr_rope_insert_ref(r, 0, anostr_view(head, sizeof head - 1)) == 0
+              && anostr_rope_append(r, anostr_lit("\xA9" "AVA\nTo")) == 0,
+          "straddling pieces");
+    n = ano_text_shape_lit(b, "Wave\nA\xC3\xA9" "AVA\nTo", S, org, white, flat, 64, penA);
+    CHECK(ano_text_shape_rope(b, r, 0, anostr_rope_len(r), S, org, white, roped, 64, penB) == n
+              && same_instances(flat, roped, n) && penA[0] == penB[0] && penA[1] == penB[1],
+          "a rune straddling pieces decodes as in the flat string");
+
+    // A sub-range shapes like the same slice as a string; measure agrees with ano_text_measure.
+    n = ano_text_shape_lit(b, "e\nA\xC3\xA9" "AVA\n", S, org, white, flat, 64, penA);
+    CHECK(ano_text_shape_rope(b, r, 3, 12, S, org, white, roped, 64, penB) == n
+              && same_instances(flat, roped, n) && penA[0] == penB[0] && penA[1] == penB[1],
+          "a sub-range shapes like its slice");
+    float w = -1.0f, h = -1.0f, w2 = -1.0f, h2 = -1.0f;
+    ano_text_measure_rope(b, r, 0, SIZE_MAX, S, &w, &h);
+    ano_text_measure_lit(b, "Wave\nA\xC3\xA9" "AVA\nTo", S, &w2, &h2);
+    CHECK(w == w2 && h == h2, "measure_rope matches ano_text_measure");
+    CHECK(ano_text_shape_rope(b, NULL, 0, 5, S, org, white, roped, 64, NULL) == 0
+              && ano_text_shape_rope(b, r, 0, 5, 0.0f, org, white, roped, 64, NULL) == 0,
+          "NULL rope and zero size reject");
+    anostr_rope_destroy(r);
+}
+
 // Multi-range multi-face bake: Geist ASCII + Noto Sans Runic in one directory.
 // Slot bases chain in range order, kerning never crosses faces, and the argument
 // contract rejects unsorted/overlapping range lists.
@@ -881,6 +940,52 @@ static void test_runic_bake(AnoFontId geist, AnoFontId runic, mi_heap_t *heap)
 }
 
 
+static bool bakes_equal(const AnoFontBake *a, const AnoFontBake *b)
+{
+    return a->pointCount == b->pointCount && a->glyphCount == b->glyphCount
+        && a->rangeCount == b->rangeCount && a->kernCount == b->kernCount
+        && memcmp(a->points, b->points, a->pointCount * 4u) == 0
+        && memcmp(a->glyphs, b->glyphs, a->glyphCount * sizeof(AnoGlyphEntry)) == 0
+        && memcmp(a->ranges, b->ranges, a->rangeCount * sizeof(AnoGlyphRange)) == 0
+        && (a->kernCount == 0 || memcmp(a->kerns, b->kerns, a->kernCount * sizeof(AnoKernPair)) == 0)
+        && a->ascender == b->ascender && a->descender == b->descender
+        && a->lineHeight == b->lineHeight && a->upem == b->upem;
+}
+
+// The first bake under a configured cache stores, the second is served from it; both must equal
+// the uncached reference. A one-byte cap at the end evicts every entry before the dir is removed.
+static void test_bake_cache(AnoFontId geist, AnoFontId runic, const AnoFontBake *reference)
+{
+    ano_fspath base = ano_fs_gamepath();
+    char dir[512];
+    snprintf(dir, sizeof dir, "%s/anotest_text_cache", base.str);
+    CHECK(ano_fs_cache_configure(dir, 0) == 0, "configure a scratch cache");
+
+    mi_heap_t *heap LOCALHEAPATTR = mi_heap_new();
+    AnoFontBake stored = { 0 }, served = { 0 };
+    CHECK(ano_text_font_bake(geist, 32, 126, heap, &stored) == 0, "bake on a cache miss");
+    CHECK(ano_text_font_bake(geist, 32, 126, heap, &served) == 0, "bake from the cache");
+    CHECK(bakes_equal(&stored, reference) && bakes_equal(&served, reference),
+          "cached bakes are bit-identical to the uncached one");
+    CHECK(served.glyphs != stored.glyphs, "a cached bake still lands in the caller's heap");
+
+    AnoBakeRange ranges[2] = { { .font = geist, .first = 0x20, .last = 0x7E },
+                               { .font = runic, .first = 0x16A0, .last = 0x16F8 } };
+    AnoFontBake twoA = { 0 }, twoB = { 0 };
+    CHECK(ano_text_font_bake_ranges(ranges, 2, heap, &twoA) == 0
+              && ano_text_font_bake_ranges(ranges, 2, heap, &twoB) == 0,
+          "two-face bake, stored then served");
+    CHECK(bakes_equal(&twoA, &twoB), "served two-face bake matches the stored one");
+    ranges[1].last = 0x16F0;
+    AnoFontBake narrower = { 0 };
+    CHECK(ano_text_font_bake_ranges(ranges, 2, heap, &narrower) == 0
+              && narrower.glyphCount == twoA.glyphCount - 8u,
+          "a different range is a different entry");
+
+    CHECK(ano_fs_cache_configure(dir, 1) == 0, "a one-byte cap evicts everything");
+    scratch_remove_dir(dir);
+}
+
 int main(void)
 {
     test_lifecycle();
@@ -916,6 +1021,7 @@ int main(void)
     test_ghost_pixels(geist, &bake);
     test_shaper(&bake);
     test_shaper_runs(&bake);
+    test_shaper_rope(&bake, heapA);
     test_runic_bake(geist, runic, heapA);
 
     // Determinism: a second bake is bit-identical (double math, fixed iteration order).
@@ -935,6 +1041,8 @@ int main(void)
               "kern tables are bit-identical");
     }
 
+    test_bake_cache(geist, runic, &bake);
+
     ano_text_shutdown();
 
     if (failures == 0)
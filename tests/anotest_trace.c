@@ -0,0 +1,319 @@
+/* SPDX-FileCopyrightText: 2026 Anoptic Game Engine Authors
+ *
+ * SPDX-License-Identifier: LGPL-3.0 */
+/*  == Anoptic Game Engine v0.0000001 == */
+
+/* Coverage for the crash trace ring (anoptic_log_crash.h) and its reader (tools/anotrace_dump.c):
+ *   - lifecycle: ano_trace is a no-op before init and after cleanup, double init refuses
+ *   - round trip: deferred captures (ints, strings, a %.*s slice) and an eager fallback render exactly
+ *   - wrap: far past capacity, the dump holds only the newest records, contiguous and in order
+ *   - threads: concurrent producers, every record survives and each thread's stay in order
+ *   - SIGKILL: a child traces, prints its path and kills itself with no cleanup, the dump still ends
+ *     on its last record and reports the file never closed
+ *   - cost: ns per ano_trace against a deferred ano_log enqueue, printed for the record
+ * No args = parent mode, argv[1] = "kill" child. Traces land in the log directory, removed on pass.
+ * Exit 0 = pass. */
+
+#include <anoptic_log.h>
+#include <anoptic_log_crash.h>
+#include <anoptic_filesystem.h>
+#include <anoptic_threads.h>
+#include <anoptic_time.h>
+
+#include "templates/scratch.h"
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#define popen  _popen
+#define pclose _pclose
+#else
+#include <sys/wait.h>
+#endif
+
+long anotrace_dump(const char *path, FILE *out);   // tools/anotrace_dump.c
+
+static int failures = 0;
+#define CHECK(cond, msg) do { \
+    if (!(cond)) { printf("FAIL: %s (%s:%d)\n", (msg), __FILE__, __LINE__); failures++; } \
+} while (0)
+
+#define KILL_RECORDS 5000u
+
+static char g_exe[MAXPATH + 32];
+
+// Dump `path` into a malloc'd string. *records gets the dump's count, -1 on a bad file.
+static char *dump(const char *path, long *records)
+{
+    FILE *tmp = tmpfile();
+    if (tmp == NULL)
+        return NULL;
+    *records = anotrace_dump(path, tmp);
+    long n = ftell(tmp);
+    char *s = n >= 0 ? malloc((size_t)n + 1) : NULL;
+    rewind(tmp);
+    if (s != NULL)
+        s[fread(s, 1, (size_t)n, tmp)] = '\0';
+    fclose(tmp);
+    return s;
+}
+
+// The message of each dumped record, in order: the text after "+s.us tN ".
+static int messages(char *d, char **msg, int cap)
+{
+    int n = 0;
+    for (char *line = strtok(d, "\n"); line != NULL; line = strtok(NULL, "\n")) {
+        if (line[0] != '+' || n == cap)
+            continue;
+        char *t = strstr(line, " t");
+        char *m = t != NULL ? strchr(t + 2, ' ') : NULL;
+        while (m != NULL && *m == ' ') m++;
+        msg[n++] = m != NULL ? m : line;
+    }
+    return n;
+}
+
+static void test_preinit(void)
+{
+    CHECK(ano_trace_path() == NULL, "no path before init");
+    CHECK(ano_trace_cleanup() != 0, "cleanup before init refuses");
+    static ano_tracesite_t site;
+    CHECK(ano_trace_write(&site, "pre %d", 1) != 0, "trace before init refuses");
+}
+
+static void test_roundtrip(void)
+{
+    CHECK(ano_trace_init() == 0, "init");
+    CHECK(ano_trace_init() != 0, "double init refuses");
+    char path[MAXPATH];
+    snprintf(path, sizeof path, "%s", ano_trace_path());
+    CHECK(strstr(path, "_trace.ring") != NULL, "trace file name");
+
+    const char *slice = "sliced-off";
+    for (int i = 0; i < 3; i++)
+        ano_trace("frame %d begins, %s", i, "ok");
+    ano_trace("slice %.*s|%llu|%x", 6, slice, 1234567890123ull, 0xbeefu);
+    ano_trace("eager %Lf", (long double)2.5);
+    CHECK(ano_trace_cleanup() == 0, "cleanup");
+    static ano_tracesite_t late;
+    CHECK(ano_trace_write(&late, "post") != 0, "trace after cleanup refuses");
+
+    long recs;
+    char *d = dump(path, &recs);
+    CHECK(d != NULL && recs == 5, "five records");
+    if (d != NULL) {
+        CHECK(strstr(d, "closed cleanly") != NULL, "head says closed");
+        char *msg[8];
+        int n = messages(d, msg, 8);
+        CHECK(n == 5, "five record lines");
+        if (n == 5) {
+            CHECK(strcmp(msg[0], "frame 0 begins, ok") == 0, "deferred int + string");
+            CHECK(strcmp(msg[2], "frame 2 begins, ok") == 0, "same site, same format");
+            CHECK(strcmp(msg[3], "slice sliced|1234567890123|beef") == 0, "slice, long long, hex");
+            CHECK(strcmp(msg[4], "eager 2.500000") == 0, "unsupported spec falls back to text");
+        }
+        free(d);
+    }
+    if (failures == 0)
+        remove(path);
+}
+
+#define WRAP_RECORDS 200000u
+
+static void test_wrap(void)
+{
+    CHECK(ano_trace_init() == 0, "init");
+    char path[MAXPATH];
+    snprintf(path, sizeof path, "%s", ano_trace_path());
+    for (uint32_t i = 0; i < WRAP_RECORDS; i++)
+        ano_trace("seq %u pad %s", i, i % 7 == 0 ? "a longer record that spans a second line" : "x");
+    ano_trace_cleanup();
+
+    long recs;
+    char *d = dump(path, &recs);
+    CHECK(d != NULL && recs > 1000 && recs < (long)WRAP_RECORDS, "wrapped: only the newest survive");
+    if (d != NULL) {
+        static char *msg[WRAP_RECORDS];
+        int n = messages(d, msg, (int)WRAP_RECORDS);
+        bool contiguous = n > 0;
+        for (int i = 0; i < n && contiguous; i++)
+            contiguous = strtoul(msg[i] + 4, NULL, 10) == WRAP_RECORDS - (uint32_t)n + (uint32_t)i;
+        CHECK(contiguous, "survivors are the last n, contiguous and in order");
+        printf("  wrap: %d of %u records survive\n", n, WRAP_RECORDS);
+        free(d);
+    }
+    if (failures == 0)
+        remove(path);
+}
+
+#define THREADS        6
+#define THREAD_RECORDS 2000u
+
+static void *producer_main(void *arg)
+{
+    uintptr_t id = (uintptr_t)arg;
+    for (uint32_t i = 0; i < THREAD_RECORDS; i++)
+        ano_trace("p%u %u", (unsigned)id, i);
+    return NULL;
+}
+
+static void test_threads(void)
+{
+    CHECK(ano_trace_init() == 0, "init");
+    char path[MAXPATH];
+    snprintf(path, sizeof path, "%s", ano_trace_path());
+    anothread_t th[THREADS];
+    for (uintptr_t i = 0; i < THREADS; i++)
+        CHECK(ano_thread_create(&th[i], NULL, producer_main, (void *)i) == 0, "spawn");
+    for (int i = 0; i < THREADS; i++)
+        ano_thread_join(th[i], NULL);
+    ano_trace_cleanup();
+
+    long recs;
+    char *d = dump(path, &recs);
+    CHECK(recs == (long)THREADS * THREAD_RECORDS, "every record survives");
+    if (d != NULL) {
+        static char *msg[THREADS * THREAD_RECORDS];
+        int n = messages(d, msg, THREADS * THREAD_RECORDS);
+        uint32_t next[THREADS] = {0};
+        bool ordered = true;
+        for (int i = 0; i < n; i++) {
+            unsigned p = 0, s = 0;
+            if (sscanf(msg[i], "p%u %u", &p, &s) != 2 || p >= THREADS || s != next[p]) { ordered = false; break; }
+            next[p]++;
+        }
+        CHECK(ordered, "each producer's records in order");
+        free(d);
+    }
+    if (failures == 0)
+        remove(path);
+}
+
+// Child: trace, report the path, die with no cleanup and no handler.
+static int child_kill(void)
+{
+    if (ano_trace_init() != 0)
+        return 3;
+    printf("%s\n", ano_trace_path());
+    fflush(stdout);
+    for (uint32_t i = 0; i < KILL_RECORDS; i++)
+        ano_trace("last words %u", i);
+#if defined(_WIN32)
+    TerminateProcess(GetCurrentProcess(), 9);
+#else
+    raise(SIGKILL);
+#endif
+    return 0;
+}
+
+static void test_kill(void)
+{
+    char cmd[MAXPATH + 64], path[MAXPATH] = "";
+#if defined(_WIN32)
+    snprintf(cmd, sizeof cmd, "\"%s\" kill", g_exe);
+#else
+    snprintf(cmd, sizeof cmd, "exec \"%s\" kill", g_exe);   // exec: the status is the child's, not sh's
+#endif
+    FILE *p = popen(cmd, "r");
+    CHECK(p != NULL, "spawn the kill child");
+    if (p == NULL)
+        return;
+    if (fgets(path, sizeof path, p) != NULL)
+        path[strcspn(path, "\r\n")] = '\0';
+    int status = pclose(p);
+#if defined(_WIN32)
+    CHECK(status == 9, "child terminated");
+#else
+    CHECK(status != -1 && WIFSIGNALED(status) && WTERMSIG(status) == SIGKILL, "child SIGKILLed");
+#endif
+    CHECK(path[0] != '\0', "child reported its trace path");
+
+    long recs;
+    char *d = dump(path, &recs);
+    CHECK(recs > 0, "killed session's trace readable");
+    if (d != NULL) {
+        CHECK(strstr(d, "never closed") != NULL, "head says never closed");
+        static char *msg[KILL_RECORDS];
+        int n = messages(d, msg, (int)KILL_RECORDS);
+        char want[32];
+        snprintf(want, sizeof want, "last words %u", KILL_RECORDS - 1);
+        CHECK(n > 0 && strcmp(msg[n - 1], want) == 0, "the final record before the kill survives");
+        free(d);
+    }
+    if (failures == 0)
+        remove(path);
+}
+
+#define COST_N 10000u
+
+// ns per record, best of 20 batches. The log side is a deferred, file-only ano_log into a scratch dir,
+// flushed between batches so neither ring ever waits. Printed, not gated.
+static void test_cost(void)
+{
+    CHECK(ano_trace_init() == 0, "init");
+    char path[MAXPATH];
+    snprintf(path, sizeof path, "%s", ano_trace_path());
+    scratch_make_dir("anotest_trace_scratch");
+    ano_log_init();
+    ano_log_output_dir("anotest_trace_scratch");
+
+    uint64_t bestTrace = UINT64_MAX, bestLog = UINT64_MAX;
+    for (int rep = 0; rep < 20; rep++) {
+        uint64_t t0 = ano_timestamp_raw();
+        for (uint32_t i = 0; i < COST_N; i++)
+            ano_trace("cost %u %d", i, rep);
+        uint64_t t1 = ano_timestamp_raw();
+        for (uint32_t i = 0; i < COST_N; i++)
+            ano_rlog(ANO_INFO, ANO_FILE, "cost %u %d", i, rep);
+        uint64_t t2 = ano_timestamp_raw();
+        ano_log_flush();
+        if (t1 - t0 < bestTrace) bestTrace = t1 - t0;
+        if (t2 - t1 < bestLog)   bestLog   = t2 - t1;
+    }
+    printf("  cost: %.1f ns per ano_trace, %.1f ns per deferred ano_log\n",
+           (double)bestTrace / COST_N, (double)bestLog / COST_N);
+
+    ano_log_cleanup();
+    ano_trace_cleanup();
+    char logPath[MAXPATH];
+    snprintf(logPath, sizeof logPath, "anotest_trace_scratch/%s_ano.log", ano_fs_session_stamp());
+    remove(logPath);
+    scratch_remove_dir("anotest_trace_scratch");
+    remove(path);
+}
+
+int main(int argc, char **argv)
+{
+    if (!scratch_anchor_to_exe()) {
+        printf("FAIL: cannot anchor to the exe directory\n");
+        return 1;
+    }
+    if (argc > 1)
+        return strcmp(argv[1], "kill") == 0 ? child_kill() : 2;
+
+    ano_fspath gp = ano_fs_gamepath();
+#if defined(_WIN32)
+    snprintf(g_exe, sizeof g_exe, "%s\\anotest_trace.exe", gp.str);
+#else
+    snprintf(g_exe, sizeof g_exe, "%s/anotest_trace", gp.str);
+#endif
+
+    printf("anotest_trace: crash trace ring, offline dump\n");
+    test_preinit();
+    test_roundtrip();
+    test_wrap();
+    test_threads();
+    test_kill();
+    test_cost();
+    if (failures) {
+        printf("anotest_trace: %d FAILURE(S)\n", failures);
+        return 1;
+    }
+    printf("anotest_trace: all passed\n");
+    return 0;
+}
@@ -0,0 +1,241 @@
+/* SPDX-FileCopyrightText: 2026 Anoptic Game Engine Authors
+ *
+ * SPDX-License-Identifier: LGPL-3.0 */
+/*  == Anoptic Game Engine v0.0000001 == */
+
+// Renders a binary session log (<stamp>_ano.alog, ano_log_set_format(ANO_LOG_BINARY)) to the text the
+// logger would have written to <stamp>_ano.log. Standalone offline tool, not part of the engine build.
+// Decode on the architecture that wrote the file: captures hold host-order values.
+//
+// Usage (from the repository root):
+//     gcc -O2 -Iinclude -Isrc -o anolog_decode tools/anolog_decode.c
+//     ./anolog_decode logs/<stamp>_ano.alog > <stamp>_ano.log
+//
+// Captures render through the logger's own format_deferred (src/log/log_format.h): the blob is rebuilt
+// with pointers to this tool's copies of the format and file strings, then rendered unchanged.
+// anotest_logging links this file with ANOLOG_DECODE_NO_MAIN to round-trip a live session.
+
+#include "log/log_format.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Decoder state for one head's span: the time base and the string table, ids from 1.
+typedef struct {
+    uint64_t anchorTicks, anchorUnixNs;
+    uint64_t calTicks, calNs;
+    int32_t  utcOffset;
+    uint32_t msgMax;
+    char   **str;
+    uint32_t strCap;
+    bool     haveHead;
+} decoder_t;
+
+// Read exactly n bytes. False at EOF or a short read.
+static bool read_n(FILE *in, void *dst, size_t n)
+{
+    return n == 0 || fread(dst, 1, n, in) == n;
+}
+
+// "HH:MM:SS" for raw ticks: anchor, tick rate, then the head's local offset.
+static void render_time(const decoder_t *d, uint64_t ticks, char *out8)
+{
+    uint64_t dt = ticks - d->anchorTicks;
+    uint64_t ns = d->anchorUnixNs + (dt / d->calTicks) * d->calNs
+                + (uint64_t)((unsigned __int128)(dt % d->calTicks) * d->calNs / d->calTicks);
+    int64_t  s  = ((int64_t)(ns / 1000000000ull) + d->utcOffset) % 86400;
+    if (s < 0) s += 86400;
+    int v[3] = { (int)(s / 3600), (int)(s / 60 % 60), (int)(s % 60) };
+    for (int i = 0; i < 3; i++) {
+        out8[i * 3]     = (char)('0' + v[i] / 10);
+        out8[i * 3 + 1] = (char)('0' + v[i] % 10);
+        if (i < 2) out8[i * 3 + 2] = ':';
+    }
+}
+
+static void emit(FILE *out, const char *hms, const char *text, size_t len)
+{
+    fwrite(hms, 1, 8, out);
+    fputc(' ', out);
+    fwrite(text, 1, len, out);
+    fputc('\n', out);
+}
+
+// Walks fmt the way format_deferred consumes a capture and checks that every value it would read lies
+// in the args' n bytes, each %s string with its NUL. False for a malformed record: a short or corrupt
+// file must not send the renderer past the record.
+static bool capture_args_fit(const char *fmt, const char *args, size_t n)
+{
+    size_t at = 0;
+#define ARGS_NEED(k) do { if ((size_t)(k) > n - at) return false; } while (0)
+    for (const char *f = fmt; *f; ++f) {
+        if (*f != '%') continue;
+        ++f;
+        if (*f == '%') continue;
+        while (*f=='-'||*f=='+'||*f==' '||*f=='#'||*f=='0') ++f;
+        if (*f == '*') { ARGS_NEED(4); at += 4; ++f; }
+        else while (*f >= '0' && *f <= '9') ++f;
+        if (*f == '.') {
+            ++f;
+            if (*f == '*') { ARGS_NEED(4); at += 4; ++f; }
+            else while (*f >= '0' && *f <= '9') ++f;
+        }
+        int lng = 0;
+        while (*f == 'l') { ++lng; ++f; }
+        if (*f == 'z' || *f == 't' || *f == 'j') { lng = 2; ++f; }
+        while (*f == 'h') ++f;
+        switch (*f) {
+        case 'd': case 'i': case 'u': case 'o': case 'x': case 'X':
+            ARGS_NEED(lng ? 8 : 4); at += lng ? 8 : 4; break;
+        case 'e': case 'E': case 'f': case 'F': case 'g': case 'G': case 'a': case 'A': case 'p':
+            ARGS_NEED(8); at += 8; break;
+        case 'c':
+            ARGS_NEED(4); at += 4; break;
+        case 's': {
+            uint16_t sl;
+            ARGS_NEED(2); memcpy(&sl, args + at, 2); at += 2;
+            ARGS_NEED((size_t)sl + 1);
+            if (args[at + sl] != '\0') return false;
+            at += (size_t)sl + 1;
+            break;
+        }
+        case '\0':
+            return false;   // a dangling '%' would walk the renderer off the format
+        default:
+            break;
+        }
+    }
+#undef ARGS_NEED
+    return true;
+}
+
+static void drop_strings(decoder_t *d)
+{
+    if (d->str == NULL)
+        return;
+    for (uint32_t i = 0; i < d->strCap; i++)
+        free(d->str[i]);
+    memset(d->str, 0, (size_t)d->strCap * sizeof *d->str);
+}
+
+// Decode the whole stream. Returns records rendered, or -1 on a malformed or truncated file (records up to
+// the fault are already written). A capture whose args do not fit its argLen renders as a marker line.
+long anolog_decode(FILE *in, FILE *out)
+{
+    decoder_t d = { 0 };
+    long  n = -1, count = 0;
+    char *blob = NULL, *text = NULL;
+    int   kind;
+    while ((kind = fgetc(in)) != EOF) {
+        if (kind == ANO_LOGBIN_HEAD) {
+            char magic[7]; uint8_t ver;
+            if (!read_n(in, magic, 7) || memcmp(magic, ANO_LOGBIN_MAGIC, 7) != 0
+                || !read_n(in, &ver, 1) || ver != ANO_LOGBIN_VERSION
+                || !read_n(in, &d.anchorTicks, 8) || !read_n(in, &d.anchorUnixNs, 8)
+                || !read_n(in, &d.calTicks, 8)    || !read_n(in, &d.calNs, 8)
+                || !read_n(in, &d.utcOffset, 4)   || !read_n(in, &d.msgMax, 4)
+                || d.calTicks == 0 || d.msgMax == 0)
+                goto done;
+            char *nb = realloc(blob, (size_t)d.msgMax + 32), *nt = realloc(text, d.msgMax);
+            if (nb) blob = nb;
+            if (nt) text = nt;
+            if (!nb || !nt) goto done;
+            drop_strings(&d);
+            d.haveHead = true;
+            continue;
+        }
+        if (!d.haveHead)
+            goto done;  // every file opens with a head
+
+        if (kind == ANO_LOGBIN_STRING) {
+            uint32_t id; uint16_t len;
+            if (!read_n(in, &id, 4) || !read_n(in, &len, 2) || id == 0 || id == UINT32_MAX)
+                goto done;
+            if (id >= d.strCap) {
+                uint32_t ncap = d.strCap ? d.strCap : 256;
+                while (ncap <= id) ncap *= 2;
+                char **ns = realloc(d.str, (size_t)ncap * sizeof *ns);
+                if (ns == NULL) goto done;
+                memset(ns + d.strCap, 0, (size_t)(ncap - d.strCap) * sizeof *ns);
+                d.str = ns; d.strCap = ncap;
+            }
+            char *s = malloc((size_t)len + 1);
+            if (s == NULL || !read_n(in, s, len)) { free(s); goto done; }
+            s[len] = '\0';
+            free(d.str[id]);
+            d.str[id] = s;
+        }
+        else if (kind == ANO_LOGBIN_CAPTURE) {
+            uint8_t level; uint64_t ticks; uint32_t fmtId, fileId; int32_t line; uint16_t argLen;
+            if (!read_n(in, &level, 1) || !read_n(in, &ticks, 8) || !read_n(in, &fmtId, 4)
+                || !read_n(in, &fileId, 4) || !read_n(in, &line, 4) || !read_n(in, &argLen, 2))
+                goto done;
+            if (fmtId >= d.strCap || d.str[fmtId] == NULL || argLen > d.msgMax
+                || (fileId != 0 && (fileId >= d.strCap || d.str[fileId] == NULL)))
+                goto done;
+            // Rebuild [file][line if file][fmt][args] around this process's strings.
+            const char *file = fileId ? d.str[fileId] : NULL, *fmt = d.str[fmtId];
+            char *b = blob;
+            b = logbin_put(b, &file, sizeof file);
+            if (file != NULL) b = logbin_put(b, &line, sizeof line);
+            b = logbin_put(b, &fmt, sizeof fmt);
+            if (!read_n(in, b, argLen)) goto done;
+            char hms[8];
+            render_time(&d, ticks, hms);
+            if (capture_args_fit(fmt, b, argLen)) {
+                int tn = format_deferred(text, (int)d.msgMax, (ano_loglevel_t)level, blob);
+                emit(out, hms, text, (size_t)tn);
+            } else {
+                static const char bad[] = "<malformed capture record: args overrun argLen>";
+                emit(out, hms, bad, sizeof bad - 1);
+            }
+            count++;
+        }
+        else if (kind == ANO_LOGBIN_TEXT) {
+            uint8_t level; uint64_t ticks; uint16_t len;
+            if (!read_n(in, &level, 1) || !read_n(in, &ticks, 8) || !read_n(in, &len, 2)
+                || len > d.msgMax || !read_n(in, text, len))
+                goto done;
+            char hms[8];
+            render_time(&d, ticks, hms);
+            emit(out, hms, text, len);
+            count++;
+        }
+        else {
+            goto done;  // unknown kind: corrupt or a newer version
+        }
+    }
+    n = count;
+done:
+    drop_strings(&d);
+    free(d.str);
+    free(blob);
+    free(text);
+    return n;
+}
+
+#ifndef ANOLOG_DECODE_NO_MAIN
+int main(int argc, char **argv)
+{
+    if (argc < 2 || argc > 3) {
+        fprintf(stderr, "usage: %s <session.alog> [out.log]\n", argv[0]);
+        return 2;
+    }
+    FILE *in = fopen(argv[1], "rb");
+    if (in == NULL) { perror(argv[1]); return 1; }
+    FILE *out = argc == 3 ? fopen(argv[2], "wb") : stdout;
+    if (out == NULL) { perror(argv[2]); fclose(in); return 1; }
+
+    long n = anolog_decode(in, out);
+    fclose(in);
+    if (out != stdout) fclose(out);
+    if (n < 0) {
+        fprintf(stderr, "%s: malformed or truncated, output stops at the fault\n", argv[1]);
+        return 1;
+    }
+    return 0;
+}
+#endif
@@ -0,0 +1,79 @@
+/* SPDX-FileCopyrightText: 2026 Anoptic Game Engine Authors
+ *
+ * SPDX-License-Identifier: LGPL-3.0 */
+/*  == Anoptic Game Engine v0.0000001 == */
+
+// Cooks a glTF's geometry offline: every primitive's LOD chain, vertex-cache order, meshlets and
+// bounds, written as one .anomesh (src/mesh/ano_meshcook.h). Primitives and their levels cook in
+// parallel on a job pool of one worker per core. parseGltf maps "<source>.anomesh" and
+// uploads it as is when it matches the source bytes and the LOD config, skipping all the CPU work.
+// Headless; built with the engine as the anomesh_cook target.
+//
+// Usage:
+//     ./anomesh_cook assets/scene.gltf                      writes assets/scene.gltf.anomesh
+//     ./anomesh_cook assets/scene.gltf out.anomesh --lods 4
+//
+// The loader only accepts files cooked with its own config, ano_lod_config_default(ANO_DEFAULT_LOD_COUNT):
+// --lods other than ANO_DEFAULT_LOD_COUNT cooks for a renderer configured to match.
+
+#include "anoptic_filesystem.h"
+#include "anoptic_jobs.h"
+#include "anoptic_log.h"
+#include "mesh/ano_meshcook_gltf.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int usage(void)
+{
+    fprintf(stderr, "usage: anomesh_cook <source.gltf|.glb> [out.anomesh] [--lods N]\n");
+    return EXIT_FAILURE;
+}
+
+int main(int argc, char **argv)
+{
+    const char *source = NULL, *out = NULL;
+    uint32_t lods = ANO_DEFAULT_LOD_COUNT;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--lods") == 0 && i + 1 < argc) {
+            lods = (uint32_t)strtoul(argv[++i], NULL, 10);
+            if (lods < 1 || lods > ANO_MAX_LOD)
+                return usage();
+        } else if (source == NULL) {
+            source = argv[i];
+        } else if (out == NULL) {
+            out = argv[i];
+        } else {
+            return usage();
+        }
+    }
+    if (source == NULL)
+        return usage();
+
+    char defaultOut[MAXPATH + 8];
+    if (out == NULL) {
+        if (snprintf(defaultOut, sizeof defaultOut, "%s.anomesh", source) >= (int)sizeof defaultOut)
+            return usage();
+        out = defaultOut;
+    }
+
+    int logAlive ANO_LOG_SCOPE_ATTR = ano_log_init();
+    if (logAlive != 0) {
+        fprintf(stderr, "anomesh_cook: logger initialization failed\n");
+        return EXIT_FAILURE;
+    }
+
+    // Started after the logger so it stops first: cook jobs log.
+    int jobsAlive ANO_JOBS_SCOPE_ATTR = ano_jobs_init(0, true);
+    if (jobsAlive != 0)
+        fprintf(stderr, "anomesh_cook: job pool failed to start; cooking on one thread\n");
+
+    AnoLodConfig config = ano_lod_config_default(lods);
+    if (ano_mesh_cook_gltf(source, out, &config) != 0) {
+        fprintf(stderr, "anomesh_cook: cooking %s failed (details in the session log)\n", source);
+        return EXIT_FAILURE;
+    }
+    printf("%s -> %s (%u LOD levels)\n", source, out, lods);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,162 @@
+/* SPDX-FileCopyrightText: 2026 Anoptic Game Engine Authors
+ *
+ * SPDX-License-Identifier: LGPL-3.0 */
+/*  == Anoptic Game Engine v0.0000001 == */
+
+// Dumps a crash trace ring (<stamp>_trace.ring, anoptic_log_crash.h) oldest record first. The file is
+// readable whether the process closed it, crashed, or was killed outright. Standalone offline tool, not
+// part of the engine build. Read on the architecture that wrote the file: captures hold host-order values.
+//
+// Usage (from the repository root):
+//     gcc -O2 -Iinclude -Isrc -o anotrace_dump tools/anotrace_dump.c
+//     ./anotrace_dump logs/<stamp>_trace.ring
+//
+// Layout and validity rules in src/log/log_trace.h. Deferred records render through the logger's own
+// format_deferred, as in anolog_decode.c. anotest_trace links this file with ANOTRACE_DUMP_NO_MAIN.
+
+#include "log/log_format.h"
+#include "log/log_trace.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Nanoseconds from the session anchor to `ticks`.
+static uint64_t trace_ns(const anotrace_head_t *h, uint64_t ticks)
+{
+    uint64_t dt = ticks - h->anchorTicks;
+    return (dt / h->calTicks) * h->calNs + (uint64_t)((unsigned __int128)(dt % h->calTicks) * h->calNs / h->calTicks);
+}
+
+// Dump every surviving record. Returns records written, or -1 when the file is not a trace ring.
+long anotrace_dump(const char *path, FILE *out)
+{
+    FILE *in = fopen(path, "rb");
+    if (in == NULL)
+        return -1;
+    fseek(in, 0, SEEK_END);
+    long size = ftell(in);
+    fseek(in, 0, SEEK_SET);
+    char *file = size >= (long)ANOTRACE_HEAD_BYTES ? malloc((size_t)size) : NULL;
+    bool  ok   = file != NULL && fread(file, 1, (size_t)size, in) == (size_t)size;
+    fclose(in);
+
+    const anotrace_head_t *h = (const anotrace_head_t *)file;
+    ok = ok && memcmp(h->magic, ANOTRACE_MAGIC, sizeof h->magic) == 0 && h->version == ANOTRACE_VERSION
+            && h->lineBytes >= ANOTRACE_MARKER && (h->lineBytes & (h->lineBytes - 1)) == 0
+            && h->lines >= 2 && (h->lines & (h->lines - 1)) == 0 && h->calTicks != 0
+            && (uint64_t)size >= ANOTRACE_HEAD_BYTES + (uint64_t)h->strBytes + h->lines * h->lineBytes;
+    if (!ok) {
+        free(file);
+        return -1;
+    }
+
+    const char *strs  = file + ANOTRACE_HEAD_BYTES;
+    char       *lines = file + ANOTRACE_HEAD_BYTES + h->strBytes;
+    uint64_t    bytes = h->lines * h->lineBytes;
+    uint32_t    shift = (uint32_t)__builtin_ctzll(h->lines);
+    uint32_t    used  = atomic_load_explicit(&((anotrace_head_t *)file)->strUsed, memory_order_relaxed);
+    uint64_t    tail  = atomic_load_explicit(&((anotrace_head_t *)file)->tail, memory_order_relaxed);
+    uint32_t    state = atomic_load_explicit(&((anotrace_head_t *)file)->state, memory_order_relaxed);
+    int32_t     fault = atomic_load_explicit(&((anotrace_head_t *)file)->fault, memory_order_relaxed);
+    if (used > h->strBytes)
+        used = h->strBytes;
+
+    time_t    start = (time_t)(h->anchorUnixNs / 1000000000ull);
+    struct tm tm;
+#ifdef _WIN32
+    gmtime_s(&tm, &start);
+#else
+    gmtime_r(&start, &tm);
+#endif
+    char when[32];
+    strftime(when, sizeof when, "%Y-%m-%d %H:%M:%S UTC", &tm);
+    fprintf(out, "# anotrace: pid %d, started %s, %s", (int)h->pid, when,
+            state == ANOTRACE_CLOSED ? "closed cleanly" : "never closed (crash, kill or still running)");
+    if (fault != 0)
+        fprintf(out, ", fault %d (0x%08x)", (int)fault, (unsigned)fault);
+    fprintf(out, ", %llu records written\n", (unsigned long long)tail);
+
+    // The window [tail - lines, tail) holds nothing a later reserve could have overwritten. A head line
+    // counts only with this layout's byte, the committed bit and its own lap, anything else is a body
+    // line, an in-flight record or a lap-old leftover: step one line.
+    char     scratch[ANOTRACE_BODY_MAX], blob[ANOTRACE_BODY_MAX + 2 * sizeof(void *)], text[ANOTRACE_BODY_MAX + 64];
+    long     count = 0;
+    uint64_t pos   = tail > h->lines ? tail - h->lines : 0;
+    while (pos < tail) {
+        char *m = lines + (pos & (h->lines - 1)) * h->lineBytes;
+        anotrace_word_t v;
+        uint64_t ticks;
+        memcpy(&v.w, m, 8);
+        memcpy(&ticks, m + 8, 8);
+        uint64_t span = anotrace_span(h->lineBytes, v.len);
+        if (v.tag != ANOTRACE_TAG || !(v.flags & ANOTRACE_COMMITTED) || v.cycle != (uint32_t)(pos >> shift)
+            || v.len < 4 || v.len > ANOTRACE_BODY_MAX || pos + span > tail) {
+            pos++;
+            continue;
+        }
+
+        // Gather the body across the seam.
+        const char *body  = m + ANOTRACE_MARKER;
+        size_t      toend = (size_t)(bytes - (uint64_t)(body - lines));
+        if (v.len > toend) {
+            memcpy(scratch, body, toend);
+            memcpy(scratch + toend, lines, v.len - toend);
+            body = scratch;
+        }
+        uint32_t tid;
+        memcpy(&tid, body, 4);
+        const char *msg = body + 4;
+        int         n   = v.len - 4;
+
+        if (v.flags & ANOTRACE_DEFERRED) {
+            uint32_t id;
+            memcpy(&id, body + 4, 4);
+            const char *fmt = NULL;
+            if (id != 0 && id + 2 < used) {
+                uint16_t fl;
+                memcpy(&fl, strs + id - 1, 2);
+                if (id - 1 + 2 + (uint32_t)fl < used && strs[id - 1 + 2 + fl] == '\0')
+                    fmt = strs + id - 1 + 2;
+            }
+            if (fmt != NULL) {
+                // Rebuild [file = NULL][fmt][args] around the file's own format copy, skip the level pad.
+                const char *nofile = NULL;
+                char *b = logbin_put(blob, &nofile, sizeof nofile);
+                b = logbin_put(b, &fmt, sizeof fmt);
+                memcpy(b, body + 8, (size_t)v.len - 8);
+                n   = format_deferred(text, (int)sizeof text, ANO_INFO, blob) - 6;
+                msg = text + 6;
+            } else {
+                n   = snprintf(text, sizeof text, "(format %u lost, %u arg bytes)", id, (unsigned)v.len - 8u);
+                msg = text;
+            }
+        }
+
+        uint64_t ns = trace_ns(h, ticks);
+        fprintf(out, "+%llu.%06llu t%-3u %.*s\n", (unsigned long long)(ns / 1000000000ull),
+                (unsigned long long)(ns / 1000ull % 1000000ull), tid, n < 0 ? 0 : n, msg);
+        count++;
+        pos += span;
+    }
+    free(file);
+    return count;
+}
+
+#ifndef ANOTRACE_DUMP_NO_MAIN
+int main(int argc, char **argv)
+{
+    if (argc != 2) {
+        fprintf(stderr, "usage: %s <session_trace.ring>\n", argv[0]);
+        return 2;
+    }
+    if (anotrace_dump(argv[1], stdout) < 0) {
+        fprintf(stderr, "%s: not a trace ring\n", argv[1]);
+        return 1;
+    }
+    return 0;
+}
+#endif